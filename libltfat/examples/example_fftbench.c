@@ -0,0 +1,73 @@
+/* Times the complex and the real FFT of the backend libltfat was compiled
+ * with for a few lengths common in LTFAT: powers of two, lengths with
+ * factors 3, 5 and 7 coming from lcm(a,M) and audio sampling rates, and
+ * lengths with a large prime factor.
+ *
+ * Build libltfat once with NOFFTW=ON and once with NOFFTW=OFF and compare
+ * the output to see how the bundled KISS FFT does against FFTW.
+ *
+ * Usage: example_fftbench
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ltfat.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+static double
+now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/* Average time of one call in us */
+#define TIMEIT(res, expr) do{ \
+    int reps = 0; double t0 = now(), t1; \
+    do { expr; reps++; t1 = now(); } while (t1 - t0 < 0.2); \
+    res = 1e6 * (t1 - t0) / reps; }while(0)
+
+int main(void)
+{
+    ltfat_int Ls[] = { 1024, 4096, 65536, 1048576,
+                       2880, 44100, 48000, 96000,
+                       4099, 10007, 2 * 7919, 2 * 3 * 1009 };
+
+    printf("%8s %14s %14s %14s\n", "L", "fft [us]", "fftreal [us]", "ifftreal [us]");
+
+    for (size_t li = 0; li < sizeof Ls / sizeof * Ls; li++)
+    {
+        ltfat_int L = Ls[li];
+        ltfat_complex_d* fc = ltfat_malloc_dc(L);
+        ltfat_complex_d* c = ltfat_malloc_dc(L);
+        double* f = ltfat_malloc_d(L);
+        ltfat_fft_plan_d* pfft = NULL;
+        ltfat_fftreal_plan_d* pfftr = NULL;
+        ltfat_ifftreal_plan_d* pifftr = NULL;
+        double tfft, tfftr, tifftr;
+
+        for (ltfat_int l = 0; l < L; l++)
+        {
+            f[l] = ((double)rand()) / RAND_MAX;
+            fc[l] = f[l];
+        }
+
+        ltfat_fft_init_d(L, 1, fc, c, FFTW_MEASURE, &pfft);
+        ltfat_fftreal_init_d(L, 1, f, c, FFTW_MEASURE, &pfftr);
+        ltfat_ifftreal_init_d(L, 1, c, f, FFTW_MEASURE, &pifftr);
+
+        TIMEIT(tfft, ltfat_fft_execute_d(pfft));
+        TIMEIT(tfftr, ltfat_fftreal_execute_d(pfftr));
+        TIMEIT(tifftr, ltfat_ifftreal_execute_d(pifftr));
+
+        printf("%8ld %14.1f %14.1f %14.1f\n", (long) L, tfft, tfftr, tifftr);
+
+        ltfat_fft_done_d(&pfft);
+        ltfat_fftreal_done_d(&pfftr);
+        ltfat_ifftreal_done_d(&pifftr);
+        ltfat_free(fc); ltfat_free(c); ltfat_free(f);
+    }
+
+    return 0;
+}
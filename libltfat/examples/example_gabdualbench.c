@@ -0,0 +1,69 @@
+/* Times the steps of the long canonical dual window computation
+ *
+ *   gf = wfac(g), gdf = gabdual_fac(gf), gd = iwfac(gdf)
+ *
+ * The c*d factor blocks and the c*p*q FFTs of the Walnut factorization are
+ * independent and they are split among the OpenMP threads. Run the program
+ * with OMP_NUM_THREADS=1,2,4,... to see the scaling. It requires libltfat
+ * compiled with USEOPENMP to use more than one thread.
+ *
+ * Usage: example_gabdualbench [log2(L)]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "ltfat.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+static double
+now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+int main(int argc, char* argv[])
+{
+    ltfat_int L = (ltfat_int) 1 << (argc > 1 ? atoi(argv[1]) : 20);
+    // Redundancy 4 and 8 with a few different block sizes p x q
+    ltfat_int as[] = { 256, 512, 1024 };
+    ltfat_int Ms[] = { 1024, 4096, 8192 };
+    double* g = ltfat_malloc_d(L);
+    double* gd = ltfat_malloc_d(L);
+    ltfat_complex_d* gf = ltfat_malloc_dc(L);
+    ltfat_complex_d* gdf = ltfat_malloc_dc(L);
+
+    printf("%10s %6s %6s %12s %12s %12s %12s\n",
+           "L", "a", "M", "wfac [ms]", "fac [ms]", "iwfac [ms]", "total [ms]");
+
+    for (size_t ii = 0; ii < sizeof as / sizeof * as; ii++)
+    {
+        ltfat_int a = as[ii], M = Ms[ii];
+        double t0, t1, t2, t3, t4;
+
+        // Gaussian matched to the lattice
+        ltfat_pgauss_d(L, ((double) a) * M / L, 0.0, g);
+
+        t0 = now();
+        ltfat_wfacreal_d(g, L, 1, a, M, gf);
+        t1 = now();
+        ltfat_gabdualreal_fac_d(gf, L, 1, a, M, gdf);
+        t2 = now();
+        ltfat_iwfacreal_d(gdf, L, 1, a, M, gd);
+        t3 = now();
+        ltfat_gabdual_long_d(g, L, a, M, gd);
+        t4 = now();
+
+        printf("%10ld %6ld %6ld %12.1f %12.1f %12.1f %12.1f\n",
+               (long) L, (long) a, (long) M, 1e3 * (t1 - t0), 1e3 * (t2 - t1),
+               1e3 * (t3 - t2), 1e3 * (t4 - t3));
+    }
+
+    ltfat_free(g);
+    ltfat_free(gd);
+    ltfat_free(gf);
+    ltfat_free(gdf);
+    return 0;
+}
@@ -0,0 +1,95 @@
+/* Compares the cost of evaluating K frequency bins of a real signal of length
+ * L using the Goertzel algorithm (gga), the chirped Z-transform (chzt) and
+ * a full FFT (fftreal).
+ *
+ * Goertzel costs O(KL), the chirped Z-transform and the FFT cost
+ * O(L log L) regardless of K, so there is a K above which Goertzel stops
+ * paying off. The program prints the timings and the crossover K for a few
+ * signal lengths.
+ *
+ * Usage: example_ggabench [nthreads]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ltfat.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+static double
+now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/* Average time of one call in ms */
+#define TIMEIT(res, expr) do{ \
+    int reps = 0; double t0 = now(), t1; \
+    do { expr; reps++; t1 = now(); } while (t1 - t0 < 0.2); \
+    res = 1e3 * (t1 - t0) / reps; }while(0)
+
+int main(int argc, char* argv[])
+{
+    ltfat_int nthreads = argc > 1 ? atoi(argv[1]) : 1;
+    ltfat_int Ls[] = { 4096, 65536, 1048576 };
+    ltfat_int Ks[] = { 1, 4, 16, 64, 256, 1024 };
+
+    printf("%8s %6s %12s %12s %12s\n", "L", "K", "gga [ms]", "chzt [ms]", "fft [ms]");
+
+    for (size_t li = 0; li < sizeof Ls / sizeof * Ls; li++)
+    {
+        ltfat_int L = Ls[li];
+        ltfat_int Kcross = -1;
+        double* f = ltfat_malloc_d(L);
+        ltfat_complex_d* c = ltfat_malloc_dc(L);
+        ltfat_fftreal_plan_d* pfft = NULL;
+        double tfft;
+
+        for (ltfat_int l = 0; l < L; l++)
+            f[l] = ((double)rand()) / RAND_MAX;
+
+        ltfat_fftreal_init_d(L, 1, f, c, FFTW_ESTIMATE, &pfft);
+        TIMEIT(tfft, ltfat_fftreal_execute_d(pfft));
+        ltfat_fftreal_done_d(&pfft);
+
+        for (size_t ki = 0; ki < sizeof Ks / sizeof * Ks; ki++)
+        {
+            ltfat_int K = Ks[ki];
+            double* ind = ltfat_malloc_d(K);
+            double tgga, tchzt;
+
+            // K bins spread over the band of interest
+            for (ltfat_int k = 0; k < K; k++)
+                ind[k] = 100.0 + 0.37 * k;
+
+            ltfat_gga_plan_d pgga = ltfat_gga_init_d(ind, K, L);
+            ltfat_gga_set_nthreads_d(pgga, nthreads);
+            TIMEIT(tgga, ltfat_gga_execute_d(pgga, f, 1, c));
+            ltfat_gga_done_d(pgga);
+
+            ltfat_chzt_plan_d pchzt = ltfat_chzt_init_d(K, L, 0.37 * 2.0 * M_PI / L,
+                                      100.0 * 2.0 * M_PI / L,
+                                      FFTW_ESTIMATE, CZT_NEXTFASTFFT);
+            TIMEIT(tchzt, ltfat_chzt_execute_d(pchzt, f, 1, c));
+            ltfat_chzt_done_d(pchzt);
+
+            printf("%8ld %6ld %12.3f %12.3f %12.3f\n", (long) L, (long) K, tgga, tchzt, tfft);
+
+            if (Kcross < 0 && tgga > (tchzt < tfft ? tchzt : tfft))
+                Kcross = K;
+
+            ltfat_free(ind);
+        }
+
+        if (Kcross > 0)
+            printf("L=%ld: Goertzel is slower than chzt/fft from K=%ld bins\n\n", (long) L, (long) Kcross);
+        else
+            printf("L=%ld: Goertzel is faster for all K tested\n\n", (long) L);
+
+        ltfat_free(f);
+        ltfat_free(c);
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/* Times the inverse filterbank with an ERB-like bank of band-limited filters
+ *
+ * The filters are Hann windows centered at ERB-spaced frequencies with the
+ * bandwidths proportional to the ERB. Each channel is critically sampled
+ * with respect to its filter support, i.e. the hop factors are fractional.
+ * The per-channel ifilterbank_fftbl_execute followed by an inverse FFT is
+ * compared with the ifilterbank plan using 1 and more threads.
+ *
+ * Usage: example_ifilterbankbench [M] [L] [W] [nthreads]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "ltfat.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+static double
+now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static double
+crand(void)
+{
+    return rand() / (double) RAND_MAX - 0.5;
+}
+
+static double
+freqtoerb(double f)
+{
+    return 9.2645 * log(1 + f * 0.00437);
+}
+
+static double
+erbtofreq(double erb)
+{
+    return (exp(erb / 9.2645) - 1) / 0.00437;
+}
+
+static double
+reldiff(const ltfat_complex_d* x, const ltfat_complex_d* y, ltfat_int L)
+{
+    double num = 0.0, den = 0.0;
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        num += pow(cabs(x[l] - y[l]), 2);
+        den += pow(cabs(y[l]), 2);
+    }
+    return sqrt(num / den);
+}
+
+int main(int argc, char* argv[])
+{
+    ltfat_int M = argc > 1 ? atoi(argv[1]) : 240;
+    ltfat_int L = argc > 2 ? atoi(argv[2]) : 44100;
+    ltfat_int W = argc > 3 ? atoi(argv[3]) : 1;
+    ltfat_int nthreads = argc > 4 ? atoi(argv[4]) : 4;
+    double fs = 44100.0;
+    ltfat_int* Gl = malloc(M * sizeof * Gl);
+    ltfat_int* foff = malloc(M * sizeof * foff);
+    int* realonly = malloc(M * sizeof * realonly);
+    double* a = malloc(M * sizeof * a);
+    ltfat_complex_d** G = malloc(M * sizeof * G);
+    ltfat_complex_d** c = malloc(M * sizeof * c);
+    ltfat_upconv_fftbl_plan_d* up = malloc(M * sizeof * up);
+    ltfat_complex_d* F = ltfat_malloc_dc(L * W);
+    ltfat_complex_d* fref = ltfat_malloc_dc(L * W);
+    ltfat_complex_d* f = ltfat_malloc_dc(L * W);
+    ltfat_ifilterbank_plan_d* p = NULL;
+    double t0, t1, erbmax = freqtoerb(fs / 2), ctot = 0;
+    int nrep = 10;
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        double fc = erbtofreq(erbmax * m / (M - 1));
+        double erb = 24.7 + fc / 9.265;
+        ltfat_int N;
+
+        Gl[m] = ltfat_imax(4, (ltfat_int) (4.0 * erb * L / fs));
+        foff[m] = (ltfat_int) floor(fc * L / fs + 0.5) - Gl[m] / 2;
+        realonly[m] = 1;
+        N = Gl[m];
+        a[m] = (double) L / N;
+        ctot += N;
+
+        G[m] = ltfat_malloc_dc(Gl[m]);
+        for (ltfat_int k = 0; k < Gl[m]; k++)
+            G[m][k] = 0.5 - 0.5 * cos(2.0 * M_PI * (k + 1) / (Gl[m] + 1));
+
+        c[m] = ltfat_malloc_dc(N * W);
+        for (ltfat_int n = 0; n < N * W; n++)
+            c[m][n] = crand() + I * crand();
+
+        up[m] = ltfat_upconv_fftbl_init_d(L, Gl[m], W, a[m]);
+    }
+
+    printf("M = %ld, L = %ld, W = %ld, redundancy %.2f\n",
+           (long) M, (long) L, (long) W, ctot / L);
+
+    // Reference, one channel after another
+    t0 = now();
+    for (int r = 0; r < nrep; r++)
+    {
+        ltfat_ifilterbank_fftbl_execute_d(up, (const ltfat_complex_d**) c,
+                                          (const ltfat_complex_d**) G, M, foff,
+                                          realonly, F);
+        ltfat_ifft_d(F, L, W, fref);
+    }
+    t1 = now();
+    for (ltfat_int l = 0; l < L * W; l++)
+        fref[l] /= L;
+    printf("ifilterbank_fftbl + ifft   : %10.3f ms\n", 1e3 * (t1 - t0) / nrep);
+
+    ltfat_ifilterbank_init_d((const ltfat_complex_d**) G, Gl, foff, realonly,
+                             a, M, L, W, FFTW_ESTIMATE, &p);
+
+    for (ltfat_int nt = 1; nt <= nthreads; nt *= 2)
+    {
+        ltfat_ifilterbank_set_nthreads_d(p, nt);
+        ltfat_ifilterbank_execute_d(p, (const ltfat_complex_d**) c, f);
+        t0 = now();
+        for (int r = 0; r < nrep; r++)
+            ltfat_ifilterbank_execute_d(p, (const ltfat_complex_d**) c, f);
+        t1 = now();
+        printf("ifilterbank plan, %2ld threads: %10.3f ms, error %.3g\n",
+               (long) nt, 1e3 * (t1 - t0) / nrep, reldiff(f, fref, L * W));
+    }
+
+    ltfat_ifilterbank_done_d(&p);
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        ltfat_upconv_fftbl_done_d(up[m]);
+        ltfat_free(G[m]); ltfat_free(c[m]);
+    }
+    free(Gl); free(foff); free(realonly); free(a); free(G); free(c); free(up);
+    ltfat_free(F); ltfat_free(fref); ltfat_free(f);
+    return 0;
+}
@@ -0,0 +1,147 @@
+/* Times the pfilt plan and finds the crossover between the direct form and
+ * the FFT convolution
+ *
+ * For each filter length gl and signal length L, the direct form
+ * (ltfat_pfilt_direct), the FFT convolution (ltfat_pfilt_fft), the
+ * partitioned FFT convolution (ltfat_pfilt_fftpart) and pfilt_fir_rr are
+ * timed and checked against pfilt_fir_rr. The FFT lengths of the two FFT
+ * methods are in the fftlen columns and the last column is the method
+ * chosen by ltfat_pfilt_auto. The direct methods are not timed for
+ * gl > 4096, the FFT convolution is the reference then.
+ *
+ * Usage: example_pfiltbench [W] [a]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "ltfat.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+static double
+now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static double
+crand(void)
+{
+    return rand() / (double) RAND_MAX - 0.5;
+}
+
+static double
+reldiff(const double* x, const double* y, ltfat_int L)
+{
+    double num = 0.0, den = 0.0;
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        num += pow(x[l] - y[l], 2);
+        den += pow(y[l], 2);
+    }
+    return sqrt(num / den);
+}
+
+/* Time of one execution in ms, averaged over at least 0.1 s */
+static double
+timeplan(ltfat_pfilt_plan_d* p, const double* f, double* c)
+{
+    int nrep = 0;
+    double t0 = now(), t1;
+    do
+    {
+        ltfat_pfilt_execute_d(p, f, c);
+        nrep++;
+    }
+    while ((t1 = now()) - t0 < 0.1);
+    return 1e3 * (t1 - t0) / nrep;
+}
+
+int main(int argc, char* argv[])
+{
+    ltfat_int W = argc > 1 ? atoi(argv[1]) : 1;
+    ltfat_int a = argc > 2 ? atoi(argv[2]) : 1;
+    ltfat_int Ls[] = {1024, 16384, 262144};
+    ltfat_int gls[] = {4, 8, 16, 32, 64, 128, 256, 512, 1024, 4096, 16384, 65536};
+    const char* names[] = {"auto", "direct", "fft", "fftpart"};
+
+    printf("W = %ld, a = %ld\n", (long) W, (long) a);
+    printf("%8s %6s %12s %12s %12s %12s %8s %8s %10s %8s\n", "L", "gl",
+           "direct [ms]", "fft [ms]", "fftpart [ms]", "fir_rr [ms]", "fftlen",
+           "partlen", "error", "auto");
+
+    for (size_t li = 0; li < sizeof Ls / sizeof * Ls; li++)
+    {
+        ltfat_int L = Ls[li] / a * a, N = L / a;
+        double* f = ltfat_malloc_d(L * W);
+        double* cref = ltfat_malloc_d(N * W);
+        double* c = ltfat_malloc_d(N * W);
+
+        for (ltfat_int l = 0; l < L * W; l++)
+            f[l] = crand();
+
+        for (size_t gi = 0; gi < sizeof gls / sizeof * gls; gi++)
+        {
+            ltfat_int gl = gls[gi];
+            double* g = ltfat_malloc_d(gl);
+            ltfat_pfilt_plan_d* pd = NULL, *pf = NULL, *pp = NULL, *pa = NULL;
+            double td = NAN, tf, tp, tr = NAN, err, t0;
+            int nrep = 0, timedirect = gl <= 4096;
+
+            if (gl > L) { ltfat_free(g); continue; }
+
+            for (ltfat_int l = 0; l < gl; l++)
+                g[l] = crand();
+
+            ltfat_pfilt_init_d(g, gl, L, W, a, ltfat_pfilt_direct,
+                               FFTW_MEASURE, &pd);
+            ltfat_pfilt_init_d(g, gl, L, W, a, ltfat_pfilt_fft,
+                               FFTW_MEASURE, &pf);
+            ltfat_pfilt_init_d(g, gl, L, W, a, ltfat_pfilt_fftpart,
+                               FFTW_MEASURE, &pp);
+            ltfat_pfilt_init_d(g, gl, L, W, a, ltfat_pfilt_auto,
+                               FFTW_ESTIMATE, &pa);
+
+            if (timedirect)
+            {
+                t0 = now();
+                do
+                {
+                    ltfat_pfilt_fir_rr_d(f, g, L, gl, W, a, cref);
+                    nrep++;
+                }
+                while (now() - t0 < 0.1);
+                tr = 1e3 * (now() - t0) / nrep;
+
+                td = timeplan(pd, f, c);
+                err = reldiff(c, cref, N * W);
+                tf = timeplan(pf, f, c);
+                err = fmax(err, reldiff(c, cref, N * W));
+            }
+            else
+            {
+                tf = timeplan(pf, f, cref);
+                err = 0.0;
+            }
+            tp = timeplan(pp, f, c);
+            err = fmax(err, reldiff(c, cref, N * W));
+
+            printf("%8ld %6ld %12.4f %12.4f %12.4f %12.4f %8ld %8ld %10.2g %8s\n",
+                   (long) L, (long) gl, td, tf, tp, tr,
+                   (long) ltfat_pfilt_get_fftlen_d(pf),
+                   (long) ltfat_pfilt_get_fftlen_d(pp), err,
+                   names[ltfat_pfilt_get_method_d(pa)]);
+
+            ltfat_pfilt_done_d(&pd);
+            ltfat_pfilt_done_d(&pf);
+            ltfat_pfilt_done_d(&pp);
+            ltfat_pfilt_done_d(&pa);
+            ltfat_free(g);
+        }
+
+        ltfat_free(f); ltfat_free(cref); ltfat_free(c);
+    }
+    return 0;
+}
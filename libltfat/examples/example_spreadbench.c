@@ -0,0 +1,176 @@
+/* Times the spreading operator routines, cf. timing/time_spreadadj.m
+ *
+ * A random L x L spreading function with 10% nonzero elements is used both
+ * as a dense and as a sparse matrix. The adjoint spreading functions are
+ * checked against the direct definition (ref_spreadadj_2.m) and the
+ * operator, its adjoint and its inverse are checked against each other.
+ * The operator is also checked against its direct definition.
+ *
+ * Usage: example_spreadbench [L] [W]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "ltfat.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+static double
+now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static double
+crand(void)
+{
+    return rand() / (double) RAND_MAX - 0.5;
+}
+
+static double
+reldiff(const ltfat_complex_d* x, const ltfat_complex_d* y, ltfat_int L)
+{
+    double num = 0.0, den = 0.0;
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        num += pow(cabs(x[l] - y[l]), 2);
+        den += pow(cabs(y[l]), 2);
+    }
+    return sqrt(num / den);
+}
+
+int main(int argc, char* argv[])
+{
+    ltfat_int L = argc > 1 ? atoi(argv[1]) : 300;
+    ltfat_int W = argc > 2 ? atoi(argv[2]) : 4;
+    ltfat_int nnz = 0;
+    ltfat_complex_d* coef = ltfat_calloc_dc(L * L);
+    ltfat_complex_d* cadj = ltfat_malloc_dc(L * L);
+    ltfat_complex_d* cref = ltfat_malloc_dc(L * L);
+    ltfat_int* row = ltfat_malloc(L * L * sizeof * row);
+    ltfat_int* col = ltfat_malloc(L * L * sizeof * col);
+    ltfat_complex_d* val = ltfat_malloc_dc(L * L);
+    ltfat_complex_d* f = ltfat_malloc_dc(L * W);
+    ltfat_complex_d* g = ltfat_malloc_dc(L * W);
+    ltfat_complex_d* h = ltfat_malloc_dc(L * W);
+    ltfat_complex_d* h2 = ltfat_malloc_dc(L * W);
+    ltfat_complex_d* f2 = ltfat_malloc_dc(L * W);
+    ltfat_spreadop_plan_d* pd = NULL, *ps = NULL;
+    double t0, t1, t2, t3, t4;
+    ltfat_complex_d fh = 0.0, gh = 0.0;
+
+    for (ltfat_int n = 0; n < L; n++)
+        for (ltfat_int m = 0; m < L; m++)
+            if (rand() % 10 == 0)
+            {
+                coef[m + n * L] = crand() + I * crand();
+                row[nnz] = m; col[nnz] = n; val[nnz] = coef[m + n * L];
+                nnz++;
+            }
+
+    for (ltfat_int l = 0; l < L * W; l++)
+    {
+        f[l] = crand() + I * crand();
+        g[l] = crand() + I * crand();
+    }
+
+    // Direct definition of the adjoint spreading function
+    for (ltfat_int ii = 0; ii < L; ii++)
+        for (ltfat_int jj = 0; jj < L; jj++)
+            cref[ii + jj * L] =
+                conj(coef[(L - ii) % L + (L - jj) % L * L]) *
+                cexp(-2.0 * M_PI * I * (double) ii * jj / L);
+
+    printf("L = %ld, W = %ld, nnz = %ld\n", (long) L, (long) W, (long) nnz);
+
+    t0 = now();
+    ltfat_spreadadj_d(coef, L, cadj);
+    t1 = now();
+    printf("spreadadj        dense : %10.3f ms, error %.3g\n", 1e3 * (t1 - t0),
+           reldiff(cadj, cref, L * L));
+
+    t0 = now();
+    ltfat_spreadadj_sparse_d(row, col, val, nnz, L, row, col, val);
+    t1 = now();
+    ltfat_clear_array_dc(cadj, L * L);
+    for (ltfat_int k = 0; k < nnz; k++)
+        cadj[row[k] + col[k] * L] = val[k];
+    printf("spreadadj       sparse : %10.3f ms, error %.3g\n", 1e3 * (t1 - t0),
+           reldiff(cadj, cref, L * L));
+    // Back to the original spreading function
+    ltfat_spreadadj_sparse_d(row, col, val, nnz, L, row, col, val);
+
+    ltfat_spreadop_init_d(L, FFTW_ESTIMATE, &pd);
+    ltfat_spreadop_init_d(L, FFTW_ESTIMATE, &ps);
+
+    t0 = now();
+    ltfat_spreadop_set_coef_d(pd, coef);
+    t1 = now();
+    ltfat_spreadop_execute_d(pd, f, W, h);
+    t2 = now();
+    ltfat_spreadop_execute_adj_d(pd, g, W, h2);
+    t3 = now();
+    printf("spreadop         dense : set %10.3f ms, apply %10.3f ms, adjoint %10.3f ms\n",
+           1e3 * (t1 - t0), 1e3 * (t2 - t1), 1e3 * (t3 - t2));
+
+    // <Tf, g> = <f, T*g>
+    for (ltfat_int l = 0; l < L * W; l++)
+    {
+        fh += h[l] * conj(g[l]);
+        gh += f[l] * conj(h2[l]);
+    }
+    printf("adjoint check            : %.3g\n", cabs(fh - gh) / cabs(fh));
+
+    // The operator with the adjoint spreading function is the adjoint
+    ltfat_spreadadj_d(coef, L, cadj);
+    ltfat_spreadop_set_coef_d(ps, cadj);
+    ltfat_spreadop_execute_d(ps, g, W, h2);
+    ltfat_spreadop_execute_adj_d(pd, g, W, f2);
+    printf("spreadadj check          : %.3g\n", reldiff(h2, f2, L * W));
+
+    t0 = now();
+    ltfat_spreadop_set_coef_sparse_d(ps, row, col, val, nnz);
+    t1 = now();
+    ltfat_spreadop_execute_d(ps, f, W, h2);
+    t2 = now();
+    printf("spreadop        sparse : set %10.3f ms, apply %10.3f ms, error %.3g\n",
+           1e3 * (t1 - t0), 1e3 * (t2 - t1), reldiff(h2, h, L * W));
+
+    // h(l) = sum_{m,n} coef(m,n) exp(2*pi*i*m*l/L) f(l-n)
+    ltfat_clear_array_dc(f2, L * W);
+    for (ltfat_int k = 0; k < nnz; k++)
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int l = 0; l < L; l++)
+                f2[l + w * L] += val[k] *
+                                 cexp(2.0 * M_PI * I * (double) ((row[k] * l) % L) / L) *
+                                 f[(l - col[k] + L) % L + w * L];
+    printf("spreadop check           : %.3g\n", reldiff(h, f2, L * W));
+
+    t0 = now();
+    if (ltfat_spreadop_prepare_inv_d(pd) == LTFATERR_SUCCESS)
+    {
+        t1 = now();
+        ltfat_spreadop_execute_inv_d(pd, h, W, h2);
+        t2 = now();
+        printf("spreadinv        dense : LU  %10.3f ms, solve %10.3f ms, error %.3g\n",
+               1e3 * (t1 - t0), 1e3 * (t2 - t1), reldiff(h2, f, L * W));
+    }
+
+    t3 = now();
+    if (ltfat_spreadop_prepare_inv_d(ps) == LTFATERR_SUCCESS)
+    {
+        t4 = now();
+        ltfat_spreadop_execute_inv_d(ps, h, W, h2);
+        printf("spreadinv       sparse : LU  %10.3f ms, solve %10.3f ms, error %.3g\n",
+               1e3 * (t4 - t3), 1e3 * (now() - t4), reldiff(h2, f, L * W));
+    }
+
+    ltfat_spreadop_done_d(&pd);
+    ltfat_spreadop_done_d(&ps);
+    ltfat_free(coef); ltfat_free(cadj); ltfat_free(cref);
+    ltfat_free(row); ltfat_free(col); ltfat_free(val);
+    ltfat_free(f); ltfat_free(g); ltfat_free(h); ltfat_free(h2); ltfat_free(f2);
+    return 0;
+}
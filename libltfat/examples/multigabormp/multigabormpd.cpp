@@ -22,6 +22,7 @@ int main(int argc, char* argv[])
     size_t maxit = 0, maxat = 0;
     double seglen = 0.0;
     double kernthr = 1e-4;
+    size_t errresync = 0;
     vector<tuple<string,int,int,int,int>> dicts;
     size_t numSamples = 0;
     int numChannels = 0;
@@ -61,6 +62,8 @@ int main(int argc, char* argv[])
         ("alg", "MP algorithm. Available: mp(default),cyclicmp,selfprojmp", cxxopts::value<string>() )
         ("kernthr", "Kernel truncation threshold",
          cxxopts::value<double>()->default_value(to_string(kernthr)))
+        ("errresync", "Recompute the exact residual energy every errresync iterations. 0 disables.",
+         cxxopts::value<size_t>()->default_value(to_string(errresync)))
         ("seglen", "Segment length in seconds. 0 disables the segmentation.",
          cxxopts::value<double>()->default_value(to_string(seglen)) )
         ("pedanticsearch", "Enables pedantic search. Pedantic search is always enabled for cyclic MP.",
@@ -221,6 +224,9 @@ int main(int argc, char* argv[])
         {
             kernthr = result["kernthr"].as<double>();
         }
+
+        if (result.count("errresync"))
+            errresync = result["errresync"].as<size_t>();
     }
     catch (const cxxopts::OptionException& e)
     {
@@ -254,6 +260,7 @@ int main(int argc, char* argv[])
         LTFAT_NAME(dgtrealmp_setparbuf_atprodreltoldb)(pbuf, atprodreltoldb);
         LTFAT_NAME(dgtrealmp_setparbuf_snrdb)(pbuf, targetsnrdb);
         LTFAT_NAME(dgtrealmp_setparbuf_kernrelthr)(pbuf, kernthr);
+        LTFAT_NAME(dgtrealmp_setparbuf_errresync)(pbuf, errresync);
         LTFAT_NAME(dgtrealmp_setparbuf_maxatoms)(pbuf, maxat);
         LTFAT_NAME(dgtrealmp_setparbuf_maxit)(pbuf, maxit);
         LTFAT_NAME(dgtrealmp_setparbuf_iterstep)(pbuf, L);
@@ -304,8 +311,10 @@ int main(int argc, char* argv[])
             size_t atoms; LTFAT_NAME(dgtrealmp_get_numatoms)(plan, &atoms);
             size_t iters; LTFAT_NAME(dgtrealmp_get_numiters)(plan, &iters);
             LTFAT_REAL snr; LTFAT_NAME(snr)(f[nCh].data(), fout[nCh].data(), L, &snr);
+            double errdb; LTFAT_NAME(dgtrealmp_get_errdb)(plan, &errdb);
 
             cout << "atoms=" << atoms << ", iters=" << iters << ", SNR=" << snr << " dB"
+                 << ", estimated SNR=" << -errdb << " dB"
                  << ", perit=" << 1000.0 * dur / ((double)iters) << "us, exit code=" << status <<endl;
 
         }
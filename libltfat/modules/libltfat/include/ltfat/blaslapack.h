@@ -3,6 +3,10 @@
 #include "ltfat.h"
 #include "ltfat/types.h"
 #include "ltfat/thirdparty/cblas.h"
+#endif /* _ltfat_blaslapack */
+
+// The prototypes are outside of the guard so that the header can be
+// included once for each type
 
 #ifdef __cplusplus
 extern "C"
@@ -37,5 +41,3 @@ LTFAT_NAME(gemm)(const enum CBLAS_TRANSPOSE TransA,
 #ifdef __cplusplus
 }
 #endif
-
-#endif
@@ -0,0 +1,182 @@
+#ifndef _LTFAT_CI_PFILT_H
+#define _LTFAT_CI_PFILT_H
+
+/** \addtogroup pfilt
+ * @{ */
+typedef enum
+{
+    ltfat_pfilt_auto,   //!< Choose the cheaper one of the following
+    ltfat_pfilt_direct, //!< Direct form
+    ltfat_pfilt_fft,    //!< FFT based, overlap-save or full length
+    ltfat_pfilt_fftpart //!< FFT based, uniformly partitioned overlap-save
+} ltfat_pfilt_hint;
+/** @} */
+
+#endif /* _LTFAT_CI_PFILT_H */
+
+typedef struct LTFAT_NAME(pfilt_plan) LTFAT_NAME(pfilt_plan);
+
+/** \defgroup pfilt Periodic FIR filtering
+ *  \addtogroup pfilt
+ * @{
+ *
+ * Computes
+ *
+ * c(n) = sum_k f(n*a + k) conj(g(k)),  n = 0, ..., L/a - 1
+ *
+ * with periodic boundary conditions, where the FIR filter g of length gl
+ * is stored with its center at index 0, i.e. g(k) for k < 0 is at
+ * g[gl + k]. For real signals and filters, this is what pfilt_fir_rr
+ * computes.
+ *
+ * The plan uses either the direct form or FFT convolution:
+ *
+ * - Direct form computes blocks of outputs at once. Each filter tap is
+ *   applied to the whole block, so that the inner loop is free of
+ *   dependencies and vectorizes. With a > 1, each output is a dot product
+ *   instead, avoiding strided access.
+ * - FFT convolution is either overlap-save with a power of two FFT length
+ *   or a single length L cyclic convolution, whichever is cheaper. The
+ *   blocks of all channels are transformed by batched FFTs. For real
+ *   signals, two blocks are packed into the real and imaginary parts of
+ *   one complex FFT.
+ * - Uniformly partitioned overlap-save splits the filter into partitions
+ *   of length hop and uses FFTs of length 2*hop only, accumulating the
+ *   products of the partition spectra with a delay line of past frame
+ *   spectra. It needs more FFTs and multiplications, but it keeps the
+ *   FFTs short. On the machine it was measured on (kissfft, L = 262144),
+ *   it is 1.5 to 2 times slower than plain overlap-save for W = 1, a = 1.
+ *   It is only faster when plain overlap-save needs FFTs longer than
+ *   2^14, which no longer fit into the cache, e.g. for gl >= 16384 with
+ *   W = 2, a = 4.
+ *
+ * With ltfat_pfilt_auto, the method with the lower estimated cost is
+ * chosen. The estimate accounts for the higher cost per flop of the long
+ * FFTs.
+ */
+
+/** Initialize the plan
+ *
+ * \param[in]      g   Filter, size gl
+ * \param[in]     gl   Filter length
+ * \param[in]      L   Signal length
+ * \param[in]      W   Number of channels
+ * \param[in]      a   Subsampling factor
+ * \param[in]   hint   Method
+ * \param[in]  flags   FFTW planning flag
+ * \param[out]     p   Plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_pfilt_init_d(const double g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                    ltfat_int a, ltfat_pfilt_hint hint, unsigned flags,
+ *                    ltfat_pfilt_plan_d** p);
+ *
+ * ltfat_pfilt_init_s(const float g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                    ltfat_int a, ltfat_pfilt_hint hint, unsigned flags,
+ *                    ltfat_pfilt_plan_s** p);
+ *
+ * ltfat_pfilt_init_dc(const ltfat_complex_d g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                     ltfat_int a, ltfat_pfilt_hint hint, unsigned flags,
+ *                     ltfat_pfilt_plan_dc** p);
+ *
+ * ltfat_pfilt_init_sc(const ltfat_complex_s g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                     ltfat_int a, ltfat_pfilt_hint hint, unsigned flags,
+ *                     ltfat_pfilt_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a p was NULL
+ * LTFATERR_BADSIZE         | \a gl was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a W or \a a was less or equal to 0
+ * LTFATERR_BADTRALEN       | \a L is not divisible by \a a or it is shorter than \a gl
+ * LTFATERR_CANNOTHAPPEN    | \a hint is not a valid value from ltfat_pfilt_hint
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(pfilt_init)(const LTFAT_TYPE g[], ltfat_int gl, ltfat_int L,
+                       ltfat_int W, ltfat_int a, ltfat_pfilt_hint hint,
+                       unsigned flags, LTFAT_NAME(pfilt_plan)** p);
+
+/** Filter and subsample
+ *
+ * \param[in]     p   Plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[out]    c   Output, size L/a x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_pfilt_execute_d(ltfat_pfilt_plan_d* p, const double f[], double c[]);
+ *
+ * ltfat_pfilt_execute_s(ltfat_pfilt_plan_s* p, const float f[], float c[]);
+ *
+ * ltfat_pfilt_execute_dc(ltfat_pfilt_plan_dc* p, const ltfat_complex_d f[],
+ *                        ltfat_complex_d c[]);
+ *
+ * ltfat_pfilt_execute_sc(ltfat_pfilt_plan_sc* p, const ltfat_complex_s f[],
+ *                        ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a f or \a c was NULL
+ * LTFATERR_BADARG          | \a f and \a c were the same array
+ */
+LTFAT_API int
+LTFAT_NAME(pfilt_execute)(LTFAT_NAME(pfilt_plan)* p, const LTFAT_TYPE f[],
+                          LTFAT_TYPE c[]);
+
+/** Get the method the plan uses
+ *
+ * \returns ltfat_pfilt_direct or ltfat_pfilt_fft, or a negative status
+ * code if \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(pfilt_get_method)(LTFAT_NAME(pfilt_plan)* p);
+
+/** Get the FFT length
+ *
+ * \returns The FFT length used by ltfat_pfilt_fft, L for the full
+ * length cyclic convolution, 0 for ltfat_pfilt_direct or a negative
+ * status code if \a p was NULL
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(pfilt_get_fftlen)(LTFAT_NAME(pfilt_plan)* p);
+
+/** Destroy the plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(pfilt_done)(LTFAT_NAME(pfilt_plan)** p);
+
+/** Filter and subsample in one go
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_pfilt_d(const double f[], const double g[], ltfat_int gl, ltfat_int L,
+ *               ltfat_int W, ltfat_int a, double c[]);
+ *
+ * ltfat_pfilt_s(const float f[], const float g[], ltfat_int gl, ltfat_int L,
+ *               ltfat_int W, ltfat_int a, float c[]);
+ *
+ * ltfat_pfilt_dc(const ltfat_complex_d f[], const ltfat_complex_d g[], ltfat_int gl,
+ *                ltfat_int L, ltfat_int W, ltfat_int a, ltfat_complex_d c[]);
+ *
+ * ltfat_pfilt_sc(const ltfat_complex_s f[], const ltfat_complex_s g[], ltfat_int gl,
+ *                ltfat_int L, ltfat_int W, ltfat_int a, ltfat_complex_s c[]);
+ * </tt>
+ * \returns Status code, see pfilt_init and pfilt_execute
+ */
+LTFAT_API int
+LTFAT_NAME(pfilt)(const LTFAT_TYPE f[], const LTFAT_TYPE g[], ltfat_int gl,
+                  ltfat_int L, ltfat_int W, ltfat_int a, LTFAT_TYPE c[]);
+
+/** @} */
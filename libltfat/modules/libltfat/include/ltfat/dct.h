@@ -10,18 +10,157 @@ typedef enum
 
 typedef struct LTFAT_NAME(dct_plan) LTFAT_NAME(dct_plan);
 
-LTFAT_API LTFAT_NAME(dct_plan)*
-LTFAT_NAME(dct_init)( ltfat_int L, ltfat_int W, LTFAT_TYPE *cout,
-                      const dct_kind kind);
+/**
+ *  \addtogroup dct
+ * @{
+ */
 
-LTFAT_API void
-LTFAT_NAME(dct)(const LTFAT_TYPE *f, ltfat_int L, ltfat_int W,
-                LTFAT_TYPE *cout, const dct_kind kind);
+/** \name Orthonormal DCT of types I-IV
+ *
+ * The transforms are computed using FFTs of roughly the same length as
+ * the signal, so they work with any FFT backend.
+ * Complex inputs are transformed by transforming the real and the imaginary
+ * parts separately.
+ *
+ * With w_k = 1/sqrt(2) for k = 0 and w_k = 1 otherwise:
+ *
+ * \f[ \text{DCTI:}\quad c(k) = \sqrt{\frac{2}{L-1}}\, v_k \sum_{l=0}^{L-1} v_l f(l) \cos\left(\frac{\pi lk}{L-1}\right) \f]
+ * where v_l = 1/sqrt(2) for l = 0, L-1 and v_l = 1 otherwise,
+ * \f[ \text{DCTII:}\quad c(k) = \sqrt{\frac{2}{L}}\, w_k \sum_{l=0}^{L-1} f(l) \cos\left(\frac{\pi(l+1/2)k}{L}\right) \f]
+ * \f[ \text{DCTIII:}\quad c(k) = \sqrt{\frac{2}{L}} \sum_{l=0}^{L-1} w_l f(l) \cos\left(\frac{\pi l(k+1/2)}{L}\right) \f]
+ * \f[ \text{DCTIV:}\quad c(k) = \sqrt{\frac{2}{L}} \sum_{l=0}^{L-1} f(l) \cos\left(\frac{\pi (l+1/2)(k+1/2)}{L}\right) \f]
+ *
+ * @{ */
 
-LTFAT_API void
-LTFAT_NAME(dct_execute)(const LTFAT_NAME(dct_plan)* p, const LTFAT_TYPE *f,
-                        ltfat_int L, ltfat_int W,
-                        LTFAT_TYPE *cout, const dct_kind kind);
+/** Compute DCT of a multichannel signal
+ *
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    c   Output coefficients, size L x W
+ * \param[in]  kind   DCT type
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dct_d(const double f[], ltfat_int L, ltfat_int W,
+ *             double c[], const dct_kind kind);
+ *
+ * ltfat_dct_s(const float f[], ltfat_int L, ltfat_int W,
+ *             float c[], const dct_kind kind);
+ *
+ * ltfat_dct_dc(const ltfat_complex_d f[], ltfat_int L, ltfat_int W,
+ *              ltfat_complex_d c[], const dct_kind kind);
+ *
+ * ltfat_dct_sc(const ltfat_complex_s f[], ltfat_int L, ltfat_int W,
+ *              ltfat_complex_s c[], const dct_kind kind);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a c
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ * LTFATERR_CANNOTHAPPEN    | \a kind is not a valid value from the dct_kind enum
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dct)(const LTFAT_TYPE f[], ltfat_int L, ltfat_int W,
+                LTFAT_TYPE c[], const dct_kind kind);
 
-LTFAT_API void
-LTFAT_NAME(dct_done)( LTFAT_NAME(dct_plan)* p);
+/** Initialize DCT plan
+ *
+ * The plan does not keep any reference to the arrays, it can be executed
+ * on any number of different arrays.
+ *
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]  kind   DCT type
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   DCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dct_init_d(ltfat_int L, ltfat_int W, const dct_kind kind,
+ *                  unsigned flags, ltfat_dct_plan_d** p);
+ *
+ * ltfat_dct_init_s(ltfat_int L, ltfat_int W, const dct_kind kind,
+ *                  unsigned flags, ltfat_dct_plan_s** p);
+ *
+ * ltfat_dct_init_dc(ltfat_int L, ltfat_int W, const dct_kind kind,
+ *                   unsigned flags, ltfat_dct_plan_dc** p);
+ *
+ * ltfat_dct_init_sc(ltfat_int L, ltfat_int W, const dct_kind kind,
+ *                   unsigned flags, ltfat_dct_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ * LTFATERR_CANNOTHAPPEN    | \a kind is not a valid value from the dct_kind enum
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dct_init)(ltfat_int L, ltfat_int W, const dct_kind kind,
+                     unsigned flags, LTFAT_NAME(dct_plan)** p);
+
+/** Execute DCT plan
+ *
+ * The function does not allocate memory. \a f and \a c can be equal.
+ *
+ * \param[in]     p   DCT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[out]    c   Output coefficients, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dct_execute_d(ltfat_dct_plan_d* p, const double f[], double c[]);
+ *
+ * ltfat_dct_execute_s(ltfat_dct_plan_s* p, const float f[], float c[]);
+ *
+ * ltfat_dct_execute_dc(ltfat_dct_plan_dc* p, const ltfat_complex_d f[],
+ *                      ltfat_complex_d c[]);
+ *
+ * ltfat_dct_execute_sc(ltfat_dct_plan_sc* p, const ltfat_complex_s f[],
+ *                      ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dct_execute)(LTFAT_NAME(dct_plan)* p, const LTFAT_TYPE f[],
+                        LTFAT_TYPE c[]);
+
+/** Destroy DCT plan
+ *
+ * \param[in]     p   DCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dct_done_d(ltfat_dct_plan_d** p);
+ *
+ * ltfat_dct_done_s(ltfat_dct_plan_s** p);
+ *
+ * ltfat_dct_done_dc(ltfat_dct_plan_dc** p);
+ *
+ * ltfat_dct_done_sc(ltfat_dct_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dct_done)(LTFAT_NAME(dct_plan)** p);
+
+/** @} */
+/** @} */
@@ -53,3 +53,186 @@ LTFAT_NAME(dgt_shear)(const LTFAT_COMPLEX *f, const LTFAT_COMPLEX *g,
 
 LTFAT_API void
 LTFAT_NAME(pchirp)(const long long L, const long long n, LTFAT_COMPLEX *g);
+
+typedef struct LTFAT_NAME(dgtreal_shear_plan) LTFAT_NAME(dgtreal_shear_plan);
+
+/** \addtogroup dgt
+ * @{
+ */
+
+/** \name DGT of real signals on a non-separable lattice
+ *
+ * The lattice is obtained by shearing the rectangular lattice given by a
+ * and M. The sheared DGT is computed using a rectangular DGT with hop
+ * factor a*b/br and br frequency channels (b = L/M) in the time domain
+ * when s0 == 0 and in the frequency domain otherwise.
+ *
+ * A sheared lattice is in general not symmetric with respect to
+ * frequency reflection so, unlike in dgtreal_long, all M frequency
+ * channels are returned.
+ * @{ */
+
+/** Computes DGT of a real signal on a non-separable lattice
+ *
+ * \param[in]      f  Multi-channel input signal, size L x W
+ * \param[in]      g  Window, size L
+ * \param[in]      L  Signal length
+ * \param[in]      W  Number of channels
+ * \param[in]      a  Hop factor
+ * \param[in]      M  Number of frequency channels
+ * \param[in]     s0  Frequency shear (chirp applied in the frequency domain)
+ * \param[in]     s1  Time shear (chirp applied in the time domain)
+ * \param[in]     br  Frequency hop factor of the rectangular lattice, divides L/M
+ * \param[out]     c  Output DGT coefficients, size M x N x W
+ *
+ * \returns Status code
+ *
+ *  Function versions
+ *  -----------------
+ *
+ *  <tt>
+ *  ltfat_dgtreal_shear_d(const double f[], const double g[], ltfat_int L,
+ *                        ltfat_int W, ltfat_int a, ltfat_int M,
+ *                        ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                        ltfat_complex_d c[]);
+ *
+ *  ltfat_dgtreal_shear_s(const float f[], const float g[], ltfat_int L,
+ *                        ltfat_int W, ltfat_int a, ltfat_int M,
+ *                        ltfat_int s0, ltfat_int s1, ltfat_int br,
+ *                        ltfat_complex_s c[]);
+ *  </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                          ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                          ltfat_int s0, ltfat_int s1, ltfat_int br,
+                          LTFAT_COMPLEX c[]);
+
+/** Initialization of the sheared DGT plan
+ *
+ * The chirps, the transformed window, the FFT and rectangular DGT plans
+ * and the coefficient permutation are all precomputed so that execute
+ * does no allocations.
+ *
+ * \param[in]      g  Window, size L
+ * \param[in]      L  Signal length
+ * \param[in]      W  Number of channels
+ * \param[in]      a  Hop factor
+ * \param[in]      M  Number of frequency channels
+ * \param[in]     s0  Frequency shear
+ * \param[in]     s1  Time shear
+ * \param[in]     br  Frequency hop factor of the rectangular lattice
+ * \param[in]      f  Input signal, size L x W, can be NULL
+ * \param[in]      c  Output DGT coefficients, size M x N x W, can be NULL
+ * \param[in]  flags  FFTW planning flag
+ * \param[out]     p  Sheared DGT plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was not positive
+ * LTFATERR_NOTPOSARG       | One of \a W, \a a, \a M, \a br was not positive
+ * LTFATERR_BADTRALEN       | \a L is not divisible by both \a a and \a M
+ * LTFATERR_BADARG          | \a br does not divide b = L/M or L is not divisible by a*b/br
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ *
+ *  Function versions
+ *  -----------------
+ *
+ *  <tt>
+ *  ltfat_dgtreal_shear_init_d(const double g[], ltfat_int L, ltfat_int W,
+ *                             ltfat_int a, ltfat_int M, ltfat_int s0,
+ *                             ltfat_int s1, ltfat_int br, const double f[],
+ *                             ltfat_complex_d c[], unsigned flags,
+ *                             ltfat_dgtreal_shear_plan_d** p);
+ *
+ *  ltfat_dgtreal_shear_init_s(const float g[], ltfat_int L, ltfat_int W,
+ *                             ltfat_int a, ltfat_int M, ltfat_int s0,
+ *                             ltfat_int s1, ltfat_int br, const float f[],
+ *                             ltfat_complex_s c[], unsigned flags,
+ *                             ltfat_dgtreal_shear_plan_s** p);
+ *  </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_init)(const LTFAT_REAL g[], ltfat_int L, ltfat_int W,
+                               ltfat_int a, ltfat_int M, ltfat_int s0,
+                               ltfat_int s1, ltfat_int br,
+                               const LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                               unsigned flags,
+                               LTFAT_NAME(dgtreal_shear_plan)** p);
+
+/** Execute the sheared DGT plan
+ *
+ * \param[in]  p  Sheared DGT plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or the plan was created without \a f or \a c
+ *
+ *  Function versions
+ *  -----------------
+ *
+ *  <tt>
+ *  ltfat_dgtreal_shear_execute_d(ltfat_dgtreal_shear_plan_d* p);
+ *
+ *  ltfat_dgtreal_shear_execute_s(ltfat_dgtreal_shear_plan_s* p);
+ *  </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute)(LTFAT_NAME(dgtreal_shear_plan)* p);
+
+/** Execute the sheared DGT plan on new arrays
+ *
+ * \param[in]  p  Sheared DGT plan
+ * \param[in]  f  Input signal, size L x W
+ * \param[out] c  Output DGT coefficients, size M x N x W
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arguments was NULL
+ *
+ *  Function versions
+ *  -----------------
+ *
+ *  <tt>
+ *  ltfat_dgtreal_shear_execute_newarray_d(ltfat_dgtreal_shear_plan_d* p,
+ *                                         const double f[], ltfat_complex_d c[]);
+ *
+ *  ltfat_dgtreal_shear_execute_newarray_s(ltfat_dgtreal_shear_plan_s* p,
+ *                                         const float f[], ltfat_complex_s c[]);
+ *  </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute_newarray)(LTFAT_NAME(dgtreal_shear_plan)* p,
+        const LTFAT_REAL f[], LTFAT_COMPLEX c[]);
+
+/** Destroy the sheared DGT plan
+ *
+ * \param[in]  p  Sheared DGT plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ *
+ *  Function versions
+ *  -----------------
+ *
+ *  <tt>
+ *  ltfat_dgtreal_shear_done_d(ltfat_dgtreal_shear_plan_d** p);
+ *
+ *  ltfat_dgtreal_shear_done_s(ltfat_dgtreal_shear_plan_s** p);
+ *  </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_done)(LTFAT_NAME(dgtreal_shear_plan)** p);
+
+/** @} */
+/** @} */
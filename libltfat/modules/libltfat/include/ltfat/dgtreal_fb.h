@@ -119,6 +119,45 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
                                const LTFAT_REAL f[], ltfat_int L,
                                ltfat_int W, LTFAT_COMPLEX c[]);
 
+/** Execute plan for Discrete Gabor Transform for real signals using the filter bank algorithm on strided arrays
+ *
+ * \param[in]     plan   DGT plan
+ * \param[in]        f   Input signal
+ * \param[in]  flayout   Layout of \a f, see ltfat_dgt_layout
+ * \param[in]        L   Signal length
+ * \param[in]        W   Number of channels of the signal
+ * \param[out]       c   DGT coefficients
+ * \param[in]  clayout   Layout of \a c, \a clayout.stride must be at least M2
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_fb_execute_strided_d(ltfat_dgtreal_fb_plan_d* plan,
+ *                                    const double f[], ltfat_dgt_layout flayout,
+ *                                    ltfat_int L, ltfat_int W,
+ *                                    ltfat_complex_d c[], ltfat_dgt_layout clayout);
+ *
+ * ltfat_dgtreal_fb_execute_strided_s(ltfat_dgtreal_fb_plan_s* plan,
+ *                                    const float f[], ltfat_dgt_layout flayout,
+ *                                    ltfat_int L, ltfat_int W,
+ *                                    ltfat_complex_s c[], ltfat_dgt_layout clayout);
+ * </tt>
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a c, \a plan
+ * LTFATERR_BADSIZE         | Length of the signal \a L was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L must be bigger of equal to \a gl and must be divisible by \a a
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ * LTFATERR_BADARG          | Invalid layout
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute_strided)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                       const LTFAT_REAL f[], ltfat_dgt_layout flayout,
+                                       ltfat_int L, ltfat_int W,
+                                       LTFAT_COMPLEX c[], ltfat_dgt_layout clayout);
+
 /** Destroy the plan
  *
  * \param[in]  plan   DGT plan
@@ -0,0 +1,224 @@
+#ifndef _LTFAT_DGTREAL_LASSO_H
+#define _LTFAT_DGTREAL_LASSO_H
+
+typedef enum
+{
+    LTFAT_LASSO,            //!< Elementwise soft thresholding (franalasso)
+    LTFAT_GROUPLASSO_TIME,  //!< Groups are the time frames (franagrouplasso, 'time')
+    LTFAT_GROUPLASSO_FREQ   //!< Groups are the frequency channels (franagrouplasso, 'freq')
+} ltfat_lasso_type;
+
+typedef enum
+{
+    LTFAT_ISTA,
+    LTFAT_FISTA
+} ltfat_lasso_alg;
+
+#endif /* _LTFAT_DGTREAL_LASSO_H */
+
+typedef struct LTFAT_NAME(dgtreal_lasso_plan) LTFAT_NAME(dgtreal_lasso_plan);
+
+/** \defgroup dgtreal_lasso Sparse DGTREAL coefficients
+ *  \addtogroup dgtreal_lasso
+ * @{
+ *
+ * Iterative shrinkage/thresholding of the DGTREAL coefficients minimizing
+ *
+ * \f[ \frac{1}{2}\|f - Dc\|_2^2 + \lambda \|c\|_p \f]
+ *
+ * where D is the synthesis operator with the analysis window and
+ * \f$\|c\|_p\f$ is the l1 norm (LTFAT_LASSO) or the mixed l21 norm with
+ * groups being the time frames (LTFAT_GROUPLASSO_TIME) or the frequency
+ * channels (LTFAT_GROUPLASSO_FREQ) of the M/2+1 stored channels.
+ * This is the C counterpart of franalasso and franagrouplasso without the
+ * debiasing step.
+ *
+ * Each iteration does one synthesis and one analysis on the underlying
+ * dgtreal_plan and a single pass over the coefficients which does
+ * the gradient step, the thresholding, the FISTA extrapolation and the
+ * computation of the relative change. The execute function does not
+ * allocate.
+ */
+
+/** Status callback
+ *
+ * Called after every iteration.
+ *
+ * \param[in]      p   DGTREAL plan used by the solver
+ * \param[in]  userdata   User defined data
+ * \param[in]      c   Current coefficients, size M2 x N x W
+ * \param[in]      L   Signal length
+ * \param[in]      W   Number of channels
+ * \param[in]      a   Hop factor
+ * \param[in]      M   Number of frequency channels
+ * \param[in,out] lambda   Regularization parameter, can be changed
+ * \param[in] relres   Relative change of the coefficients in the last iteration
+ * \param[in]   iter   Iteration number
+ *
+ * \returns Status code. Positive value stops the iterations, negative
+ * value is treated as an error.
+ */
+typedef int LTFAT_NAME(dgtreal_lasso_callback_status)(LTFAT_NAME(dgtreal_plan)* p,
+        void* userdata, LTFAT_COMPLEX c[], ltfat_int L, ltfat_int W,
+        ltfat_int a, ltfat_int M, double* lambda, double relres, ltfat_int iter);
+
+/** Initialize the LASSO plan
+ *
+ * The step size of the iterations is 1/C where C must be an upper frame
+ * bound. If \a C is less or equal to 0, it is computed from the window.
+ * In the painless case (\a gl <= \a M) it is the maximum of the frame
+ * operator diagonal. Otherwise it is the power iteration estimate of the
+ * largest eigenvalue of the frame operator multiplied by 1.05 because
+ * the estimate approaches the bound from below.
+ *
+ * \param[in]      g   Window, size gl x 1
+ * \param[in]     gl   Window length
+ * \param[in]      L   Signal length
+ * \param[in]      W   Number of channels
+ * \param[in]      a   Hop factor
+ * \param[in]      M   Number of frequency channels
+ * \param[in]   type   LASSO type
+ * \param[in]    alg   Algorithm
+ * \param[in]      C   Upper frame bound or 0
+ * \param[in] params   Optional parameters of the dgtreal_plan, can be NULL
+ * \param[out]     p   LASSO plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_dgtreal_lasso_init_d(const double g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                            ltfat_int a, ltfat_int M, ltfat_lasso_type type,
+ *                            ltfat_lasso_alg alg, double C, ltfat_dgt_params* params,
+ *                            ltfat_dgtreal_lasso_plan_d** p);
+ *
+ * ltfat_dgtreal_lasso_init_s(const float g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                            ltfat_int a, ltfat_int M, ltfat_lasso_type type,
+ *                            ltfat_lasso_alg alg, double C, ltfat_dgt_params* params,
+ *                            ltfat_dgtreal_lasso_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a g or \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a W, \a a or \a M was less or equal to 0
+ * LTFATERR_BADARG          | \a type or \a alg was not a valid value
+ * LTFATERR_NOTAFRAME       | The frame operator is zero
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ *
+ * Other status codes are passed from dgtreal_init_gen.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_init)(const LTFAT_REAL g[], ltfat_int gl,
+                               ltfat_int L, ltfat_int W, ltfat_int a,
+                               ltfat_int M, ltfat_lasso_type type,
+                               ltfat_lasso_alg alg, double C,
+                               ltfat_dgt_params* params,
+                               LTFAT_NAME(dgtreal_lasso_plan)** p);
+
+/** Run the iterations
+ *
+ * The iterations start from the analysis coefficients of \a f and stop
+ * after \a maxit iterations, when the relative change of the coefficients
+ * drops below \a tol or when the status callback returns a positive value.
+ *
+ * \param[in]      p   LASSO plan
+ * \param[in]      f   Input signal, size L x W
+ * \param[in] lambda   Regularization parameter
+ * \param[in]  maxit   Maximum number of iterations
+ * \param[in]    tol   Relative tolerance
+ * \param[out]     c   Sparse coefficients, size M2 x N x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_dgtreal_lasso_execute_d(ltfat_dgtreal_lasso_plan_d* p, const double f[],
+ *                               double lambda, ltfat_int maxit, double tol,
+ *                               ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_lasso_execute_s(ltfat_dgtreal_lasso_plan_s* p, const float f[],
+ *                               double lambda, ltfat_int maxit, double tol,
+ *                               ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a f or \a c was NULL
+ * LTFATERR_BADARG          | \a lambda was negative
+ * LTFATERR_NOTPOSARG       | \a maxit was less or equal to 0
+ *
+ * Negative values returned from the status callback are passed through.
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_execute)(LTFAT_NAME(dgtreal_lasso_plan)* p,
+                                  const LTFAT_REAL f[], double lambda,
+                                  ltfat_int maxit, double tol,
+                                  LTFAT_COMPLEX c[]);
+
+/** Set the status callback
+ *
+ * \param[in]        p   LASSO plan
+ * \param[in] callback   Status callback
+ * \param[in] userdata   User defined data passed to the callback
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a callback was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_set_status_callback)(
+    LTFAT_NAME(dgtreal_lasso_plan)* p,
+    LTFAT_NAME(dgtreal_lasso_callback_status)* callback, void* userdata);
+
+/** Number of iterations done in the last call to execute */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_lasso_get_iter)(LTFAT_NAME(dgtreal_lasso_plan)* p);
+
+/** Relative change of the coefficients in the last iteration */
+LTFAT_API double
+LTFAT_NAME(dgtreal_lasso_get_relres)(LTFAT_NAME(dgtreal_lasso_plan)* p);
+
+/** Upper frame bound used for the step size */
+LTFAT_API double
+LTFAT_NAME(dgtreal_lasso_get_C)(LTFAT_NAME(dgtreal_lasso_plan)* p);
+
+/** Destroy the LASSO plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_done)(LTFAT_NAME(dgtreal_lasso_plan)** p);
+
+/** Compute the sparse coefficients in one go
+ *
+ * The frame bound is estimated and the default dgtreal_plan parameters
+ * are used.
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_dgtreal_lasso_d(const double f[], const double g[], ltfat_int gl, ltfat_int L,
+ *                       ltfat_int W, ltfat_int a, ltfat_int M, ltfat_lasso_type type,
+ *                       ltfat_lasso_alg alg, double lambda, ltfat_int maxit,
+ *                       double tol, ltfat_complex_d c[]);
+ *
+ * ltfat_dgtreal_lasso_s(const float f[], const float g[], ltfat_int gl, ltfat_int L,
+ *                       ltfat_int W, ltfat_int a, ltfat_int M, ltfat_lasso_type type,
+ *                       ltfat_lasso_alg alg, double lambda, ltfat_int maxit,
+ *                       double tol, ltfat_complex_s c[]);
+ * </tt>
+ * \returns Status code, see dgtreal_lasso_init and dgtreal_lasso_execute
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                          ltfat_int gl, ltfat_int L, ltfat_int W,
+                          ltfat_int a, ltfat_int M, ltfat_lasso_type type,
+                          ltfat_lasso_alg alg, double lambda, ltfat_int maxit,
+                          double tol, LTFAT_COMPLEX c[]);
+
+/** @} */
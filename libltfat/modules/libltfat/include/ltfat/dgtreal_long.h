@@ -142,6 +142,36 @@ LTFAT_API int
 LTFAT_NAME(dgtreal_long_execute_newarray)(LTFAT_NAME(dgtreal_long_plan)* plan,
         const LTFAT_REAL* f, LTFAT_COMPLEX* c);
 
+/** Execute plan for Discrete Gabor Transform for real signals using the factorization algorithm on strided arrays
+ *
+ * \param[in]     plan   DGT plan
+ * \param[in]        f   Input signal
+ * \param[in]  flayout   Layout of \a f, see ltfat_dgt_layout
+ * \param[out]       c   Coefficients
+ * \param[in]  clayout   Layout of \a c, \a clayout.stride must be at least M2
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_long_execute_strided_d(ltfat_dgtreal_long_plan_d* plan,
+ *                                      const double f[], ltfat_dgt_layout flayout,
+ *                                      ltfat_complex_d c[], ltfat_dgt_layout clayout);
+ *
+ * ltfat_dgtreal_long_execute_strided_s(ltfat_dgtreal_long_plan_s* plan,
+ *                                      const float f[], ltfat_dgt_layout flayout,
+ *                                      ltfat_complex_s c[], ltfat_dgt_layout clayout);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | Al least one of the arguments was NULL.
+ * LTFATERR_BADARG          | Invalid layout
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_long_execute_strided)(LTFAT_NAME(dgtreal_long_plan)* plan,
+        const LTFAT_REAL* f, ltfat_dgt_layout flayout,
+        LTFAT_COMPLEX* c, ltfat_dgt_layout clayout);
+
 /** Destroy the plan
  *
  * \param[in]  plan   DGT plan
@@ -0,0 +1,399 @@
+typedef struct LTFAT_NAME(dgtreal_olastream_state) LTFAT_NAME(dgtreal_olastream_state);
+typedef struct LTFAT_NAME(idgtreal_olastream_state) LTFAT_NAME(idgtreal_olastream_state);
+
+/**
+ *  \addtogroup dgt
+ * @{
+ */
+
+/** \name Streaming DGTREAL using overlap-add
+ *
+ * The streaming state accepts the signal in chunks of arbitrary length and
+ * returns the coefficient columns as soon as no future input can change them.
+ * Internally, the signal is cut into blocks of length \a bl, each block is
+ * zero-extended to length Lext >= bl + gl and transformed using the
+ * \a dgtreal_long plan, and the contributions of the neighbouring blocks are
+ * added together.
+ *
+ * The result is the DGT of the signal extended by zeros on both sides,
+ * i.e. the coefficients are exactly the first ceil(L/a) columns of a
+ * \a dgtreal_long of the signal zero-padded by at least \a gl samples.
+ * Columns with time positions before the first sample are not produced. The memory
+ * footprint depends only on \a bl, \a gl and \a W, never on the signal length.
+ *
+ * The inverse state does the opposite. It accepts coefficient columns in chunks
+ * of arbitrary length and returns the synthesized samples.
+ * When the windows are dual, the full round trip reconstructs the signal exactly,
+ * except for the first and the last gl/2 samples. To reconstruct those too, prepend and
+ * append gl/2 zeros to the signal.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.c}
+ * ltfat_dgtreal_olastream_state_d* p = NULL;
+ * ltfat_dgtreal_olastream_init_d(g, gl, W, a, M, bl, LTFAT_FREQINV, FFTW_ESTIMATE, &p);
+ *
+ * while( (Lin = read_samples(f)) > 0 )
+ * {
+ *     ltfat_int N = ltfat_dgtreal_olastream_get_outcols_d(p, Lin);
+ *     // c must hold M2 x N x W coefficients
+ *     ltfat_dgtreal_olastream_execute_d(p, f, Lin, c, NULL);
+ *     consume_columns(c, N);
+ * }
+ * ltfat_int N = ltfat_dgtreal_olastream_get_flushcols_d(p);
+ * ltfat_dgtreal_olastream_flush_d(p, c, NULL);
+ * consume_columns(c, N);
+ *
+ * ltfat_dgtreal_olastream_done_d(&p);
+ * ~~~~~~~~~~~~~~~
+ * @{ */
+
+/** Initialize streaming DGTREAL state
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    bl   Block length, must be divisible by \a a
+ * \param[in] ptype   Phase convention
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   Streaming DGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_init_d(const double g[], ltfat_int gl, ltfat_int W,
+ *                                ltfat_int a, ltfat_int M, ltfat_int bl,
+ *                                const ltfat_phaseconvention ptype, unsigned flags,
+ *                                ltfat_dgtreal_olastream_state_d** p);
+ *
+ * ltfat_dgtreal_olastream_init_s(const float g[], ltfat_int gl, ltfat_int W,
+ *                                ltfat_int a, ltfat_int M, ltfat_int bl,
+ *                                const ltfat_phaseconvention ptype, unsigned flags,
+ *                                ltfat_dgtreal_olastream_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | \a gl was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a bl
+ * LTFATERR_BADARG          | \a bl is not divisible by \a a
+ * LTFATERR_CANNOTHAPPEN    | \a ptype does not have a valid value from the ltfat_phaseconvention enum
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                   ltfat_int W, ltfat_int a, ltfat_int M,
+                                   ltfat_int bl, const ltfat_phaseconvention ptype,
+                                   unsigned flags,
+                                   LTFAT_NAME(dgtreal_olastream_state)** p);
+
+/** Number of coefficient columns the next execute call will produce
+ *
+ * \param[in]     p   Streaming DGTREAL state
+ * \param[in]   Lin   Length of the chunk to be pushed
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_get_outcols_d(ltfat_dgtreal_olastream_state_d* p, ltfat_int Lin);
+ *
+ * ltfat_dgtreal_olastream_get_outcols_s(ltfat_dgtreal_olastream_state_s* p, ltfat_int Lin);
+ * </tt>
+ * \returns Number of columns or a negative number if \a p is NULL or \a Lin is negative
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_olastream_get_outcols)(LTFAT_NAME(dgtreal_olastream_state)* p,
+        ltfat_int Lin);
+
+/** Number of coefficient columns the flush function will produce
+ *
+ * \param[in]     p   Streaming DGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_get_flushcols_d(ltfat_dgtreal_olastream_state_d* p);
+ *
+ * ltfat_dgtreal_olastream_get_flushcols_s(ltfat_dgtreal_olastream_state_s* p);
+ * </tt>
+ * \returns Number of columns or a negative number if \a p is NULL
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_olastream_get_flushcols)(LTFAT_NAME(dgtreal_olastream_state)* p);
+
+/** Push a chunk of the signal
+ *
+ * The chunk can have any length, including 0.
+ * Exactly dgtreal_olastream_get_outcols(p, Lin) columns are written to \a c.
+ *
+ * \param[in]     p   Streaming DGTREAL state
+ * \param[in]     f   Input chunk, size Lin x W
+ * \param[in]   Lin   Length of the chunk
+ * \param[out]    c   Completed coefficient columns, size M2 x N x W
+ * \param[out]    N   Number of columns written to \a c, can be NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_execute_d(ltfat_dgtreal_olastream_state_d* p,
+ *                                   const double f[], ltfat_int Lin,
+ *                                   ltfat_complex_d c[], ltfat_int* N);
+ *
+ * ltfat_dgtreal_olastream_execute_s(ltfat_dgtreal_olastream_state_s* p,
+ *                                   const float f[], ltfat_int Lin,
+ *                                   ltfat_complex_s c[], ltfat_int* N);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or \a f or \a c was NULL when needed
+ * LTFATERR_BADSIZE         | \a Lin was negative
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_execute)(LTFAT_NAME(dgtreal_olastream_state)* p,
+                                      const LTFAT_REAL f[], ltfat_int Lin,
+                                      LTFAT_COMPLEX c[], ltfat_int* N);
+
+/** Finish the stream
+ *
+ * Writes the remaining columns such that the total number of columns
+ * produced is ceil(L/a), where L is the total number of samples pushed.
+ * Exactly dgtreal_olastream_get_flushcols(p) columns are written.
+ * The state is reset afterwards and can be used for another stream.
+ *
+ * \param[in]     p   Streaming DGTREAL state
+ * \param[out]    c   Remaining coefficient columns, size M2 x N x W
+ * \param[out]    N   Number of columns written to \a c, can be NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_flush_d(ltfat_dgtreal_olastream_state_d* p,
+ *                                 ltfat_complex_d c[], ltfat_int* N);
+ *
+ * ltfat_dgtreal_olastream_flush_s(ltfat_dgtreal_olastream_state_s* p,
+ *                                 ltfat_complex_s c[], ltfat_int* N);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or \a c was NULL when needed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_flush)(LTFAT_NAME(dgtreal_olastream_state)* p,
+                                    LTFAT_COMPLEX c[], ltfat_int* N);
+
+/** Discard all buffered data and start a new stream
+ *
+ * \param[in]     p   Streaming DGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_reset_d(ltfat_dgtreal_olastream_state_d* p);
+ *
+ * ltfat_dgtreal_olastream_reset_s(ltfat_dgtreal_olastream_state_s* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_reset)(LTFAT_NAME(dgtreal_olastream_state)* p);
+
+/** Destroy streaming DGTREAL state
+ *
+ * \param[in]     p   Streaming DGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_olastream_done_d(ltfat_dgtreal_olastream_state_d** p);
+ *
+ * ltfat_dgtreal_olastream_done_s(ltfat_dgtreal_olastream_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_done)(LTFAT_NAME(dgtreal_olastream_state)** p);
+
+/** Initialize streaming IDGTREAL state
+ *
+ * \param[in]     g   Synthesis window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     a   Time hop factor
+ * \param[in]     M   Number of frequency channels
+ * \param[in]    bl   Block length, must be divisible by \a a
+ * \param[in] ptype   Phase convention
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   Streaming IDGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_init_d(const double g[], ltfat_int gl, ltfat_int W,
+ *                                 ltfat_int a, ltfat_int M, ltfat_int bl,
+ *                                 const ltfat_phaseconvention ptype, unsigned flags,
+ *                                 ltfat_idgtreal_olastream_state_d** p);
+ *
+ * ltfat_idgtreal_olastream_init_s(const float g[], ltfat_int gl, ltfat_int W,
+ *                                 ltfat_int a, ltfat_int M, ltfat_int bl,
+ *                                 const ltfat_phaseconvention ptype, unsigned flags,
+ *                                 ltfat_idgtreal_olastream_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | \a gl was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of the following was less or equal to zero: \a W, \a a, \a M, \a bl
+ * LTFATERR_BADARG          | \a bl is not divisible by \a a
+ * LTFATERR_CANNOTHAPPEN    | \a ptype does not have a valid value from the ltfat_phaseconvention enum
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                    ltfat_int W, ltfat_int a, ltfat_int M,
+                                    ltfat_int bl, const ltfat_phaseconvention ptype,
+                                    unsigned flags,
+                                    LTFAT_NAME(idgtreal_olastream_state)** p);
+
+/** Number of samples the next execute call will produce
+ *
+ * \param[in]     p   Streaming IDGTREAL state
+ * \param[in]   Nin   Number of columns to be pushed
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_get_outlen_d(ltfat_idgtreal_olastream_state_d* p, ltfat_int Nin);
+ *
+ * ltfat_idgtreal_olastream_get_outlen_s(ltfat_idgtreal_olastream_state_s* p, ltfat_int Nin);
+ * </tt>
+ * \returns Number of samples or a negative number if \a p is NULL or \a Nin is negative
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(idgtreal_olastream_get_outlen)(LTFAT_NAME(idgtreal_olastream_state)* p,
+        ltfat_int Nin);
+
+/** Number of samples the flush function will produce
+ *
+ * \param[in]     p   Streaming IDGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_get_flushlen_d(ltfat_idgtreal_olastream_state_d* p);
+ *
+ * ltfat_idgtreal_olastream_get_flushlen_s(ltfat_idgtreal_olastream_state_s* p);
+ * </tt>
+ * \returns Number of samples or a negative number if \a p is NULL
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(idgtreal_olastream_get_flushlen)(LTFAT_NAME(idgtreal_olastream_state)* p);
+
+/** Push a chunk of coefficient columns
+ *
+ * Exactly idgtreal_olastream_get_outlen(p, Nin) samples are written to \a f.
+ *
+ * \param[in]     p   Streaming IDGTREAL state
+ * \param[in]     c   Coefficient columns, size M2 x Nin x W
+ * \param[in]   Nin   Number of columns
+ * \param[out]    f   Completed samples, size Lout x W
+ * \param[out] Lout   Number of samples written to \a f, can be NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_execute_d(ltfat_idgtreal_olastream_state_d* p,
+ *                                    const ltfat_complex_d c[], ltfat_int Nin,
+ *                                    double f[], ltfat_int* Lout);
+ *
+ * ltfat_idgtreal_olastream_execute_s(ltfat_idgtreal_olastream_state_s* p,
+ *                                    const ltfat_complex_s c[], ltfat_int Nin,
+ *                                    float f[], ltfat_int* Lout);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or \a c or \a f was NULL when needed
+ * LTFATERR_BADSIZE         | \a Nin was negative
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_execute)(LTFAT_NAME(idgtreal_olastream_state)* p,
+                                       const LTFAT_COMPLEX c[], ltfat_int Nin,
+                                       LTFAT_REAL f[], ltfat_int* Lout);
+
+/** Finish the stream
+ *
+ * Writes the remaining samples such that the total number of samples
+ * produced is N*a, where N is the total number of columns pushed.
+ * The state is reset afterwards.
+ *
+ * \param[in]     p   Streaming IDGTREAL state
+ * \param[out]    f   Remaining samples, size Lout x W
+ * \param[out] Lout   Number of samples written to \a f, can be NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_flush_d(ltfat_idgtreal_olastream_state_d* p,
+ *                                  double f[], ltfat_int* Lout);
+ *
+ * ltfat_idgtreal_olastream_flush_s(ltfat_idgtreal_olastream_state_s* p,
+ *                                  float f[], ltfat_int* Lout);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or \a f was NULL when needed
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_flush)(LTFAT_NAME(idgtreal_olastream_state)* p,
+                                     LTFAT_REAL f[], ltfat_int* Lout);
+
+/** Discard all buffered data and start a new stream
+ *
+ * \param[in]     p   Streaming IDGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_reset_d(ltfat_idgtreal_olastream_state_d* p);
+ *
+ * ltfat_idgtreal_olastream_reset_s(ltfat_idgtreal_olastream_state_s* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_reset)(LTFAT_NAME(idgtreal_olastream_state)* p);
+
+/** Destroy streaming IDGTREAL state
+ *
+ * \param[in]     p   Streaming IDGTREAL state
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idgtreal_olastream_done_d(ltfat_idgtreal_olastream_state_d** p);
+ *
+ * ltfat_idgtreal_olastream_done_s(ltfat_idgtreal_olastream_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_done)(LTFAT_NAME(idgtreal_olastream_state)** p);
+
+/** @} */
+/** @} */
@@ -4,6 +4,8 @@
  * */
 typedef struct LTFAT_NAME(dgtrealmp_state) LTFAT_NAME(dgtrealmp_state);
 typedef struct LTFAT_NAME(dgtrealmp_parbuf) LTFAT_NAME(dgtrealmp_parbuf);
+typedef struct LTFAT_NAME(dgtrealmp_atoms) LTFAT_NAME(dgtrealmp_atoms);
+typedef struct LTFAT_NAME(dgtrealmp_kernbank) LTFAT_NAME(dgtrealmp_kernbank);
 
 #ifndef _LTFAT_DGTREALMP_H
 #define _LTFAT_DGTREALMP_H
@@ -88,9 +90,9 @@ LTFAT_API int
 ltfat_dgtmp_setpar_cycles(
         ltfat_dgtmp_params* params, size_t cycles);
 
-// LTFAT_API int
-// ltfat_dgtmp_setpar_checkerreverynit(
-//     ltfat_dgtmp_params* p, ltfat_int itstep, double errtoldb);
+LTFAT_API int
+ltfat_dgtmp_setpar_errresync(
+        ltfat_dgtmp_params* params, size_t errresync);
 
 int
 ltfat_dgtmp_params_defaults(ltfat_dgtmp_params* params);
@@ -308,6 +310,488 @@ LTFAT_NAME(dgtrealmp_execute_synthesize)(
 
 /***********************************************************************/
 
+/** \name Sparse atom output
+ *
+ * Instead of the dense coefficient arrays, the selected atoms can be
+ * collected in a list of (dictionary id, m, n, coefficient) entries.
+ * Each MP step appends one entry, each revert step (cyclic MP) appends
+ * the negated value. The list can be synthesized directly using
+ * the FIR windows and it can be stored in a compact binary format.
+ */
+/**@{*/
+
+/** Create an empty atom list
+ *
+ * \param[in]   capacity  Initial capacity (number of atoms), 0 means default
+ * \param[out]     atoms  Atom list
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_init_d( size_t capacity, ltfat_dgtrealmp_atoms_d** atoms);
+ *
+ * ltfat_dgtrealmp_atoms_init_s( size_t capacity, ltfat_dgtrealmp_atoms_s** atoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms is NULL
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_init)(
+    size_t capacity, LTFAT_NAME(dgtrealmp_atoms)** atoms);
+
+/** Remove all atoms from the list, keeping the allocated memory
+ *
+ * \param[in]   atoms  Atom list
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_reset_d( ltfat_dgtrealmp_atoms_d* atoms);
+ *
+ * ltfat_dgtrealmp_atoms_reset_s( ltfat_dgtrealmp_atoms_s* atoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_reset)(LTFAT_NAME(dgtrealmp_atoms)* atoms);
+
+/** Delete the atom list
+ *
+ * \param[in]   atoms  Atom list
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_done_d( ltfat_dgtrealmp_atoms_d** atoms);
+ *
+ * ltfat_dgtrealmp_atoms_done_s( ltfat_dgtrealmp_atoms_s** atoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms or \a *atoms is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_done)(LTFAT_NAME(dgtrealmp_atoms)** atoms);
+
+/** Get number of entries in the list
+ *
+ * \param[in]   atoms  Atom list
+ * \param[out]  atNo   Number of entries
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_get_count_d( const ltfat_dgtrealmp_atoms_d* atoms, size_t* atNo);
+ *
+ * ltfat_dgtrealmp_atoms_get_count_s( const ltfat_dgtrealmp_atoms_s* atoms, size_t* atNo);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms or \a atNo is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_get_count)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t* atNo);
+
+/** Get entry idx from the list
+ *
+ * \param[in]   atoms  Atom list
+ * \param[in]     idx  Index of the entry
+ * \param[out] dictid  Dictionary id
+ * \param[out]      m  Frequency index
+ * \param[out]      n  Time index
+ * \param[out]      c  Coefficient
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_get_d( const ltfat_dgtrealmp_atoms_d* atoms, size_t idx,
+ *                              ltfat_int* dictid, ltfat_int* m, ltfat_int* n,
+ *                              ltfat_complex_d* c);
+ *
+ * ltfat_dgtrealmp_atoms_get_s( const ltfat_dgtrealmp_atoms_s* atoms, size_t idx,
+ *                              ltfat_int* dictid, ltfat_int* m, ltfat_int* n,
+ *                              ltfat_complex_s* c);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the pointers was NULL
+ * LTFATERR_NOTINRANGE      | \a idx is out of range
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_get)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t idx,
+    ltfat_int* dictid, ltfat_int* m, ltfat_int* n, LTFAT_COMPLEX* c);
+
+/** Merge entries with equal position and remove zero entries
+ *
+ * The entries are sorted by dictionary id, time and frequency index.
+ *
+ * \param[in]   atoms  Atom list
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_compact_d( ltfat_dgtrealmp_atoms_d* atoms);
+ *
+ * ltfat_dgtrealmp_atoms_compact_s( ltfat_dgtrealmp_atoms_s* atoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_compact)(LTFAT_NAME(dgtrealmp_atoms)* atoms);
+
+/** Get size of the serialized atom list in bytes
+ *
+ * The format is: 8 byte magic "LTFATMPA", uint16 version, uint16 size of
+ * the real type in bytes, uint32 reserved, uint64 number of atoms followed
+ * by the atoms stored as uint32 dictid, uint32 m, uint32 n, real part,
+ * imaginary part. All fields are little-endian.
+ *
+ * \param[in]   atoms  Atom list
+ * \param[out]   size  Size in bytes
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_get_serializedsize_d( const ltfat_dgtrealmp_atoms_d* atoms, size_t* size);
+ *
+ * ltfat_dgtrealmp_atoms_get_serializedsize_s( const ltfat_dgtrealmp_atoms_s* atoms, size_t* size);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms or \a size is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_get_serializedsize)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t* size);
+
+/** Write the atom list to a byte buffer
+ *
+ * \param[in]   atoms  Atom list
+ * \param[in]  buflen  Length of the buffer
+ * \param[out]    buf  Buffer
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_serialize_d( const ltfat_dgtrealmp_atoms_d* atoms,
+ *                                    size_t buflen, unsigned char buf[]);
+ *
+ * ltfat_dgtrealmp_atoms_serialize_s( const ltfat_dgtrealmp_atoms_s* atoms,
+ *                                    size_t buflen, unsigned char buf[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms or \a buf is NULL
+ * LTFATERR_BADREQSIZE      | \a buflen is too small
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_serialize)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t buflen, unsigned char buf[]);
+
+/** Read the atom list from a byte buffer
+ *
+ * The previous content of \a atoms is discarded. Buffers written
+ * with the other precision are converted.
+ *
+ * \param[in]   atoms  Atom list
+ * \param[in]  buflen  Length of the buffer
+ * \param[in]     buf  Buffer
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_atoms_deserialize_d( ltfat_dgtrealmp_atoms_d* atoms,
+ *                                      size_t buflen, const unsigned char buf[]);
+ *
+ * ltfat_dgtrealmp_atoms_deserialize_s( ltfat_dgtrealmp_atoms_s* atoms,
+ *                                      size_t buflen, const unsigned char buf[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a atoms or \a buf is NULL
+ * LTFATERR_BADARG          | The buffer does not contain a valid atom list
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+    LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t buflen, const unsigned char buf[]);
+
+/** Register an atom list to be appended to in dgtrealmp_execute_niters()
+ *
+ * When an atom list is registered, dgtrealmp_execute_niters() accepts NULL
+ * in place of the dense coefficient arrays unless the algorithm is
+ * ltfat_dgtmp_alg_loccyclicmp.
+ *
+ * \param[in]   p      DGTREALMP state
+ * \param[in]   atoms  Atom list or NULL to unregister
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_set_atomsink_d( ltfat_dgtrealmp_state_d* p, ltfat_dgtrealmp_atoms_d* atoms);
+ *
+ * ltfat_dgtrealmp_set_atomsink_s( ltfat_dgtrealmp_state_s* p, ltfat_dgtrealmp_atoms_s* atoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_set_atomsink)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_NAME(dgtrealmp_atoms)* atoms);
+
+/** Perform DGTREAL Matching Pursuit decomposition into an atom list
+ *
+ * The list is reset first. The iterstep callback is called with
+ * \a c equal to NULL.
+ *
+ * \param[in,out]    p DGTREALMP state
+ * \param[in]        f Input signal, length L
+ * \param[out]   atoms Atom list
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_decompose_atoms_d( ltfat_dgtrealmp_state_d* p,
+ *                                            const double f[], ltfat_dgtrealmp_atoms_d* atoms);
+ *
+ * ltfat_dgtrealmp_execute_decompose_atoms_s( ltfat_dgtrealmp_state_s* p,
+ *                                            const float f[], ltfat_dgtrealmp_atoms_s* atoms);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a f, \a atoms
+ * LTFATERR_NOTSUPPORTED    | The algorithm is ltfat_dgtmp_alg_loccyclicmp
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[],
+    LTFAT_NAME(dgtrealmp_atoms)* atoms);
+
+/** Synthesize signal from an atom list
+ *
+ * The atoms are added directly using the FIR windows. The cost is
+ * proportional to the number of atoms times the window lengths.
+ *
+ * \param[in]        p DGTREALMP state
+ * \param[in]    atoms Atom list
+ * \param[in] dict_mask Dictionary mask. NULL or array of length equal to the number of dictionaries.
+ * \param[out]       f Output signal, length L
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_execute_synthesize_atoms_d( ltfat_dgtrealmp_state_d* p,
+ *                                             const ltfat_dgtrealmp_atoms_d* atoms,
+ *                                             int dict_mask[], double f[]);
+ *
+ * ltfat_dgtrealmp_execute_synthesize_atoms_s( ltfat_dgtrealmp_state_s* p,
+ *                                             const ltfat_dgtrealmp_atoms_s* atoms,
+ *                                             int dict_mask[], float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a atoms, \a f
+ * LTFATERR_NOTINRANGE      | An atom is out of range of the dictionaries
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_NAME(dgtrealmp_atoms)* atoms,
+    int dict_mask[], LTFAT_REAL f[]);
+
+/** @}*/
+
+/***********************************************************************/
+
+/** \name Shared Gram kernels
+ *
+ * Computing the P x P Gram kernels is the most expensive part of
+ * dgtrealmp_init(). A kernel bank holds the kernels for a fixed set of
+ * windows, hop sizes, numbers of channels, signal length, kernel threshold
+ * and phase convention. The bank is read-only and reference counted, so
+ * any number of states (possibly used from different threads) can share
+ * a single copy.
+ */
+/**@{*/
+
+/** Compute a Gram kernel bank
+ *
+ * \param[in]        g  Windows, array of P pointers
+ * \param[in]       gl  Window lengths, array of length P
+ * \param[in]        L  Signal length
+ * \param[in]        P  Number of dictionaries
+ * \param[in]        a  Hop factors, array of length P
+ * \param[in]        M  Numbers of channels, array of length P
+ * \param[in]   params  MP parameters (only kernrelthr and ptype are used), can be NULL
+ * \param[out]      kb  Kernel bank with reference count 1
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernbank_init_d( const double* g[], ltfat_int gl[], ltfat_int L,
+ *                                  ltfat_int P, ltfat_int a[], ltfat_int M[],
+ *                                  ltfat_dgtmp_params* params,
+ *                                  ltfat_dgtrealmp_kernbank_d** kb);
+ *
+ * ltfat_dgtrealmp_kernbank_init_s( const float* g[], ltfat_int gl[], ltfat_int L,
+ *                                  ltfat_int P, ltfat_int a[], ltfat_int M[],
+ *                                  ltfat_dgtmp_params* params,
+ *                                  ltfat_dgtrealmp_kernbank_s** kb);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a gl, \a a, \a M, \a kb
+ * LTFATERR_NOTPOSARG       | \a L, \a P or one of \a gl, \a a, \a M was not positive
+ * LTFATERR_BADTRALEN       | \a L is not compatible with the dictionaries
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernbank_init)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], ltfat_dgtmp_params* params,
+    LTFAT_NAME(dgtrealmp_kernbank)** kb);
+
+/** Load a Gram kernel bank from an on-disk cache or compute and store it
+ *
+ * The cache file name in \a cachedir is derived from a hash of all
+ * parameters the kernels depend on. The parameters are also stored in the
+ * file and compared on load. When the file is missing or does not
+ * match, the kernels are computed and the file is (re)written.
+ * Failing to write the file is not an error.
+ *
+ * \param[in]  cachedir  Existing directory for the cache files
+ *
+ * The remaining parameters are the same as in dgtrealmp_kernbank_init().
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernbank_init_cached_d( const double* g[], ltfat_int gl[], ltfat_int L,
+ *                                         ltfat_int P, ltfat_int a[], ltfat_int M[],
+ *                                         ltfat_dgtmp_params* params, const char* cachedir,
+ *                                         ltfat_dgtrealmp_kernbank_d** kb);
+ *
+ * ltfat_dgtrealmp_kernbank_init_cached_s( const float* g[], ltfat_int gl[], ltfat_int L,
+ *                                         ltfat_int P, ltfat_int a[], ltfat_int M[],
+ *                                         ltfat_dgtmp_params* params, const char* cachedir,
+ *                                         ltfat_dgtrealmp_kernbank_s** kb);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a gl, \a a, \a M, \a cachedir, \a kb
+ * LTFATERR_NOTPOSARG       | \a L, \a P or one of \a gl, \a a, \a M was not positive
+ * LTFATERR_BADTRALEN       | \a L is not compatible with the dictionaries
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernbank_init_cached)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], ltfat_dgtmp_params* params,
+    const char* cachedir, LTFAT_NAME(dgtrealmp_kernbank)** kb);
+
+/** Release a reference to a Gram kernel bank
+ *
+ * The bank is destroyed when the last reference is released.
+ * \a kb is set to NULL.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_kernbank_done_d( ltfat_dgtrealmp_kernbank_d** kb);
+ *
+ * ltfat_dgtrealmp_kernbank_done_s( ltfat_dgtrealmp_kernbank_s** kb);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a kb or \a *kb is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernbank_done)(LTFAT_NAME(dgtrealmp_kernbank)** kb);
+
+/** Initialize the DGTREAL Matching Pursuit state using a kernel bank
+ *
+ * Same as dgtrealmp_init_gen(), but the Gram kernels are taken from
+ * \a kb instead of being computed. The state holds a reference to the
+ * bank. If \a kb is NULL, the state computes its own bank.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_init_gen_kernbank_d( const double* g[], ltfat_int gl[], ltfat_int L,
+ *                                      ltfat_int P, ltfat_int a[], ltfat_int M[],
+ *                                      ltfat_dgtmp_params* params,
+ *                                      ltfat_dgtrealmp_kernbank_d* kb,
+ *                                      ltfat_dgtrealmp_state_d** p);
+ *
+ * ltfat_dgtrealmp_init_gen_kernbank_s( const float* g[], ltfat_int gl[], ltfat_int L,
+ *                                      ltfat_int P, ltfat_int a[], ltfat_int M[],
+ *                                      ltfat_dgtmp_params* params,
+ *                                      ltfat_dgtrealmp_kernbank_s* kb,
+ *                                      ltfat_dgtrealmp_state_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a gl, \a a, \a M, \a p
+ * LTFATERR_BADARG          | \a kb was computed for different parameters
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_init_gen_kernbank)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], ltfat_dgtmp_params* params,
+    LTFAT_NAME(dgtrealmp_kernbank)* kb, LTFAT_NAME(dgtrealmp_state)** p);
+
+/** Get the kernel bank used by the state
+ *
+ * A new reference is added, it must be released by dgtrealmp_kernbank_done().
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_get_kernbank_d( ltfat_dgtrealmp_state_d* p,
+ *                                 ltfat_dgtrealmp_kernbank_d** kb);
+ *
+ * ltfat_dgtrealmp_get_kernbank_s( ltfat_dgtrealmp_state_s* p,
+ *                                 ltfat_dgtrealmp_kernbank_s** kb);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a kb is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_get_kernbank)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_NAME(dgtrealmp_kernbank)** kb);
+
+/** @}*/
+
+/***********************************************************************/
+
 /** \name Parameter setup struct */
 /**@{*/
 
@@ -703,6 +1187,37 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_setparbuf_kernrelthr)(
     LTFAT_NAME(dgtrealmp_parbuf)* parbuf, double thr);
 
+/** Set how often the residual energy is recomputed exactly
+ *
+ * The residual energy is tracked by subtracting the energy of each
+ * selected atom. In single precision, the rounding errors of the residual
+ * coefficients make the estimate drift, which affects the
+ * stopping criteria. Every \a errresync iterations, the approximation is
+ * synthesized and the residual energy is recomputed from the signal
+ * with long double accumulation.
+ * The cost of one recomputation is roughly that of P DGT syntheses.
+ *
+ * \param[in]     parbuf  DGTREALMP parameter buffer
+ * \param[in]  errresync  Number of iterations, 0 disables the recomputation (default)
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_errresync_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                        size_t errresync);
+ *
+ * ltfat_dgtrealmp_setparbuf_errresync_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                        size_t errresync);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_errresync)(
+    LTFAT_NAME(dgtrealmp_parbuf)* parbuf, size_t errresync);
+
 
 /** Make the most recently added dictionary tight. 
  *
@@ -776,6 +1291,29 @@ LTFAT_NAME(dgtrealmp_setparbuf_iterstepcallback)(
     LTFAT_NAME(dgtrealmp_iterstep_callback)* callback,
     void* userdata);
 
+/** Use a precomputed kernel bank in dgtrealmp_init()
+ *
+ * The parameter buffer holds a reference to \a kb. Passing NULL
+ * releases a previously set bank.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtrealmp_setparbuf_kernbank_d( ltfat_dgtrealmp_parbuf_d* p,
+ *                                       ltfat_dgtrealmp_kernbank_d* kb);
+ *
+ * ltfat_dgtrealmp_setparbuf_kernbank_s( ltfat_dgtrealmp_parbuf_s* p,
+ *                                       ltfat_dgtrealmp_kernbank_s* kb);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p is NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_kernbank)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, LTFAT_NAME(dgtrealmp_kernbank)* kb);
+
 /** Enable/disable pedantic search
  * 
  * \param[in]       parbuf  DGTREALMP parameter buffer 
@@ -121,6 +121,41 @@ LTFAT_NAME(dgtreal_execute_ana_newarray)(LTFAT_NAME(dgtreal_plan)* p,
 LTFAT_API int
 LTFAT_NAME(dgtreal_execute_ana)(LTFAT_NAME(dgtreal_plan)* p);
 
+/** Perform DGTREAL analysis on strided or interleaved arrays
+ *
+ * The signal is read and the coefficients are written directly using
+ * the given layouts, no intermediate copies are made.
+ * dgtreal_execute_ana_newarray() is equal to this function with
+ * \a flayout = {1, L} and \a clayout = {M2, M2*N}.
+ *
+ * \param[in]        p  Transform plan
+ * \param[in]        f  Input signal
+ * \param[in]  flayout  Layout of \a f
+ * \param[out]       c  Coefficients
+ * \param[in]  clayout  Layout of \a c, \a clayout.stride must be at least M2
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dgtreal_execute_ana_strided_d(ltfat_dgtreal_plan_d* p,
+ *                                     const double f[], ltfat_dgt_layout flayout,
+ *                                     ltfat_complex_d c[], ltfat_dgt_layout clayout);
+ *
+ * ltfat_dgtreal_execute_ana_strided_s(ltfat_dgtreal_plan_s* p,
+ *                                     const float f[], ltfat_dgt_layout flayout,
+ *                                     ltfat_complex_s c[], ltfat_dgt_layout clayout);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a p, \a f, \a c
+ * LTFATERR_BADARG          | Invalid layout
+ */
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_ana_strided)(LTFAT_NAME(dgtreal_plan)* p,
+        const LTFAT_REAL f[], ltfat_dgt_layout flayout,
+        LTFAT_COMPLEX c[], ltfat_dgt_layout clayout);
+
 /** Destroy transform plan
  *
  * \param[in]   p  Transform plan
@@ -171,6 +206,16 @@ int
 LTFAT_NAME(dgtreal_fb_execute_wrapper)(void* plan, const LTFAT_REAL* f, ltfat_int L, ltfat_int W,
         LTFAT_COMPLEX* c);
 
+int
+LTFAT_NAME(dgtreal_long_execute_strided_wrapper)(void* plan,
+        const LTFAT_REAL* f, ltfat_dgt_layout flayout, ltfat_int L, ltfat_int W,
+        LTFAT_COMPLEX* c, ltfat_dgt_layout clayout);
+
+int
+LTFAT_NAME(dgtreal_fb_execute_strided_wrapper)(void* plan,
+        const LTFAT_REAL* f, ltfat_dgt_layout flayout, ltfat_int L, ltfat_int W,
+        LTFAT_COMPLEX* c, ltfat_dgt_layout clayout);
+
 int
 LTFAT_NAME(idgtreal_long_done_wrapper)(void** plan);
 
@@ -14,6 +14,24 @@ typedef enum
     ltfat_dgt_fb
 } ltfat_dgt_hint;
 
+/** Memory layout of a multi-channel array
+ *
+ * Signals: sample \a l of channel \a w is at index
+ * <tt>l*stride + w*chanstride</tt>.
+ * The default layout of a signal of length L is {1, L}, an interleaved
+ * signal with W channels has layout {W, 1}.
+ *
+ * Coefficients: coefficient (\a m, \a n) of channel \a w is at index
+ * <tt>m + n*stride + w*chanstride</tt>, i.e. the frequency index is always
+ * contiguous. The default layout of DGTREAL coefficients is
+ * {M2, M2*N}, channel-interleaved coefficients have layout {M2*W, M2}.
+ */
+typedef struct
+{
+    ltfat_int stride;
+    ltfat_int chanstride;
+} ltfat_dgt_layout;
+
 /** \name Parameter setup struct
  * @{ */
 
@@ -10,18 +10,156 @@ typedef enum
 
 typedef struct LTFAT_NAME(dst_plan) LTFAT_NAME(dst_plan);
 
-LTFAT_API LTFAT_NAME(dst_plan)*
-LTFAT_NAME(dst_init)( ltfat_int L, ltfat_int W, LTFAT_TYPE *cout,
-                      const dst_kind kind);
+/**
+ *  \addtogroup dst
+ * @{
+ */
 
-LTFAT_API void
-LTFAT_NAME(dst)(const LTFAT_TYPE *f, ltfat_int L, ltfat_int W,
-                LTFAT_TYPE *cout, const dst_kind kind);
+/** \name Orthonormal DST of types I-IV
+ *
+ * The transforms are computed using FFTs of roughly the same length as
+ * the signal, so they work with any FFT backend.
+ * Complex inputs are transformed by transforming the real and the imaginary
+ * parts separately.
+ *
+ * With w_k = 1/sqrt(2) for k = L-1 and w_k = 1 otherwise:
+ *
+ * \f[ \text{DSTI:}\quad c(k) = \sqrt{\frac{2}{L+1}} \sum_{l=0}^{L-1} f(l) \sin\left(\frac{\pi (l+1)(k+1)}{L+1}\right) \f]
+ * \f[ \text{DSTII:}\quad c(k) = \sqrt{\frac{2}{L}}\, w_k \sum_{l=0}^{L-1} f(l) \sin\left(\frac{\pi(l+1/2)(k+1)}{L}\right) \f]
+ * \f[ \text{DSTIII:}\quad c(k) = \sqrt{\frac{2}{L}} \sum_{l=0}^{L-1} w_l f(l) \sin\left(\frac{\pi (l+1)(k+1/2)}{L}\right) \f]
+ * \f[ \text{DSTIV:}\quad c(k) = \sqrt{\frac{2}{L}} \sum_{l=0}^{L-1} f(l) \sin\left(\frac{\pi (l+1/2)(k+1/2)}{L}\right) \f]
+ *
+ * @{ */
 
-LTFAT_API void
-LTFAT_NAME(dst_execute)(LTFAT_NAME(dst_plan)* p, const LTFAT_TYPE *f,
-                        ltfat_int L, ltfat_int W, LTFAT_TYPE *cout,
-                        const dst_kind kind);
+/** Compute DST of a multichannel signal
+ *
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[out]    c   Output coefficients, size L x W
+ * \param[in]  kind   DST type
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dst_d(const double f[], ltfat_int L, ltfat_int W,
+ *             double c[], const dst_kind kind);
+ *
+ * ltfat_dst_s(const float f[], ltfat_int L, ltfat_int W,
+ *             float c[], const dst_kind kind);
+ *
+ * ltfat_dst_dc(const ltfat_complex_d f[], ltfat_int L, ltfat_int W,
+ *              ltfat_complex_d c[], const dst_kind kind);
+ *
+ * ltfat_dst_sc(const ltfat_complex_s f[], ltfat_int L, ltfat_int W,
+ *              ltfat_complex_s c[], const dst_kind kind);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a f, \a c
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ * LTFATERR_CANNOTHAPPEN    | \a kind is not a valid value from the dst_kind enum
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dst)(const LTFAT_TYPE f[], ltfat_int L, ltfat_int W,
+                LTFAT_TYPE c[], const dst_kind kind);
 
-LTFAT_API void
-LTFAT_NAME(dst_done)( LTFAT_NAME(dst_plan)* p);
+/** Initialize DST plan
+ *
+ * The plan does not keep any reference to the arrays, it can be executed
+ * on any number of different arrays.
+ *
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]  kind   DST type
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   DST plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dst_init_d(ltfat_int L, ltfat_int W, const dst_kind kind,
+ *                  unsigned flags, ltfat_dst_plan_d** p);
+ *
+ * ltfat_dst_init_s(ltfat_int L, ltfat_int W, const dst_kind kind,
+ *                  unsigned flags, ltfat_dst_plan_s** p);
+ *
+ * ltfat_dst_init_dc(ltfat_int L, ltfat_int W, const dst_kind kind,
+ *                   unsigned flags, ltfat_dst_plan_dc** p);
+ *
+ * ltfat_dst_init_sc(ltfat_int L, ltfat_int W, const dst_kind kind,
+ *                   unsigned flags, ltfat_dst_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0.
+ * LTFATERR_CANNOTHAPPEN    | \a kind is not a valid value from the dst_kind enum
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dst_init)(ltfat_int L, ltfat_int W, const dst_kind kind,
+                     unsigned flags, LTFAT_NAME(dst_plan)** p);
+
+/** Execute DST plan
+ *
+ * The function does not allocate memory. \a f and \a c can be equal.
+ *
+ * \param[in]     p   DST plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[out]    c   Output coefficients, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dst_execute_d(ltfat_dst_plan_d* p, const double f[], double c[]);
+ *
+ * ltfat_dst_execute_s(ltfat_dst_plan_s* p, const float f[], float c[]);
+ *
+ * ltfat_dst_execute_dc(ltfat_dst_plan_dc* p, const ltfat_complex_d f[],
+ *                      ltfat_complex_d c[]);
+ *
+ * ltfat_dst_execute_sc(ltfat_dst_plan_sc* p, const ltfat_complex_s f[],
+ *                      ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dst_execute)(LTFAT_NAME(dst_plan)* p, const LTFAT_TYPE f[],
+                        LTFAT_TYPE c[]);
+
+/** Destroy DST plan
+ *
+ * \param[in]     p   DST plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dst_done_d(ltfat_dst_plan_d** p);
+ *
+ * ltfat_dst_done_s(ltfat_dst_plan_s** p);
+ *
+ * ltfat_dst_done_dc(ltfat_dst_plan_dc** p);
+ *
+ * ltfat_dst_done_sc(ltfat_dst_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dst_done)(LTFAT_NAME(dst_plan)** p);
+
+/** @} */
+/** @} */
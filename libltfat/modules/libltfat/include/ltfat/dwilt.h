@@ -0,0 +1,329 @@
+typedef struct LTFAT_NAME(dwilt_plan) LTFAT_NAME(dwilt_plan);
+typedef struct LTFAT_NAME(idwilt_plan) LTFAT_NAME(idwilt_plan);
+typedef struct LTFAT_NAME(wmdct_plan) LTFAT_NAME(wmdct_plan);
+typedef struct LTFAT_NAME(iwmdct_plan) LTFAT_NAME(iwmdct_plan);
+
+/**
+ *  \addtogroup dgt
+ * @{
+ */
+
+/** \name Wilson and WMDCT bases of real signals
+ *
+ * The plans compute the same coefficients as dwilt_fb/dwiltiii_fb
+ * (and the inverses the same signals as idwilt_fb/idwiltiii_fb), but
+ * directly from the windowed and folded signal. The redundant 2M-channel DGT is not computed.
+ * Every pair of Wilson coefficient columns costs one M-point complex FFT,
+ * and every WMDCT column costs one M-point real FFT. The execute functions do not
+ * allocate memory.
+ *
+ * The cost of the windowing is O(gl) per column, so the plans are intended for
+ * FIR windows. Passing gl == L works, but it is slower than dwilt_long.
+ * @{ */
+
+/** Initialize plan for Discrete Wilson Transform of real signals
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   DWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dwilt_init_d(const double g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                    ltfat_int M, unsigned flags, ltfat_dwilt_plan_d** p);
+ *
+ * ltfat_dwilt_init_s(const float g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                    ltfat_int M, unsigned flags, ltfat_dwilt_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | \a gl or \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W or \a M was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L is not divisible by 2M
+ * LTFATERR_BADREQSIZE      | \a gl is greater than \a L
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(dwilt_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                       ltfat_int W, ltfat_int M, unsigned flags,
+                       LTFAT_NAME(dwilt_plan)** p);
+
+/** Execute DWILT plan
+ *
+ * \param[in]     p   DWILT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[out]    c   Coefficients, size M x N x W, N = L/M
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dwilt_execute_d(ltfat_dwilt_plan_d* p, const double f[], double c[]);
+ *
+ * ltfat_dwilt_execute_s(ltfat_dwilt_plan_s* p, const float f[], float c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dwilt_execute)(LTFAT_NAME(dwilt_plan)* p, const LTFAT_REAL f[],
+                          LTFAT_REAL c[]);
+
+/** Destroy DWILT plan
+ *
+ * \param[in]     p   DWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_dwilt_done_d(ltfat_dwilt_plan_d** p);
+ *
+ * ltfat_dwilt_done_s(ltfat_dwilt_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(dwilt_done)(LTFAT_NAME(dwilt_plan)** p);
+
+/** Initialize plan for Inverse Discrete Wilson Transform of real signals
+ *
+ * \param[in]     g   Synthesis window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   IDWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idwilt_init_d(const double g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                     ltfat_int M, unsigned flags, ltfat_idwilt_plan_d** p);
+ *
+ * ltfat_idwilt_init_s(const float g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                     ltfat_int M, unsigned flags, ltfat_idwilt_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | \a gl or \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W or \a M was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L is not divisible by 2M
+ * LTFATERR_BADREQSIZE      | \a gl is greater than \a L
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(idwilt_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                        ltfat_int W, ltfat_int M, unsigned flags,
+                        LTFAT_NAME(idwilt_plan)** p);
+
+/** Execute IDWILT plan
+ *
+ * \param[in]     p   IDWILT plan
+ * \param[in]     c   Coefficients, size M x N x W, N = L/M
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idwilt_execute_d(ltfat_idwilt_plan_d* p, const double c[], double f[]);
+ *
+ * ltfat_idwilt_execute_s(ltfat_idwilt_plan_s* p, const float c[], float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(idwilt_execute)(LTFAT_NAME(idwilt_plan)* p, const LTFAT_REAL c[],
+                           LTFAT_REAL f[]);
+
+/** Destroy IDWILT plan
+ *
+ * \param[in]     p   IDWILT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_idwilt_done_d(ltfat_idwilt_plan_d** p);
+ *
+ * ltfat_idwilt_done_s(ltfat_idwilt_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(idwilt_done)(LTFAT_NAME(idwilt_plan)** p);
+
+/** Initialize plan for Windowed MDCT (Wilson type III) of real signals
+ *
+ * \param[in]     g   Window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   WMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wmdct_init_d(const double g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                    ltfat_int M, unsigned flags, ltfat_wmdct_plan_d** p);
+ *
+ * ltfat_wmdct_init_s(const float g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                    ltfat_int M, unsigned flags, ltfat_wmdct_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | \a gl or \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W or \a M was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L is not divisible by 2M
+ * LTFATERR_BADREQSIZE      | \a gl is greater than \a L
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(wmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                       ltfat_int W, ltfat_int M, unsigned flags,
+                       LTFAT_NAME(wmdct_plan)** p);
+
+/** Execute WMDCT plan
+ *
+ * \param[in]     p   WMDCT plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[out]    c   Coefficients, size M x N x W, N = L/M
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wmdct_execute_d(ltfat_wmdct_plan_d* p, const double f[], double c[]);
+ *
+ * ltfat_wmdct_execute_s(ltfat_wmdct_plan_s* p, const float f[], float c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wmdct_execute)(LTFAT_NAME(wmdct_plan)* p, const LTFAT_REAL f[],
+                          LTFAT_REAL c[]);
+
+/** Destroy WMDCT plan
+ *
+ * \param[in]     p   WMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wmdct_done_d(ltfat_wmdct_plan_d** p);
+ *
+ * ltfat_wmdct_done_s(ltfat_wmdct_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wmdct_done)(LTFAT_NAME(wmdct_plan)** p);
+
+/** Initialize plan for Inverse Windowed MDCT of real signals
+ *
+ * \param[in]     g   Synthesis window, size gl x 1
+ * \param[in]    gl   Window length
+ * \param[in]     L   Signal length
+ * \param[in]     W   Number of channels of the signal
+ * \param[in]     M   Number of channels
+ * \param[in] flags   FFTW plan flags
+ * \param[out]    p   IWMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwmdct_init_d(const double g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                     ltfat_int M, unsigned flags, ltfat_iwmdct_plan_d** p);
+ *
+ * ltfat_iwmdct_init_s(const float g[], ltfat_int gl, ltfat_int L, ltfat_int W,
+ *                     ltfat_int M, unsigned flags, ltfat_iwmdct_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a g, \a p
+ * LTFATERR_BADSIZE         | \a gl or \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a W or \a M was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L is not divisible by 2M
+ * LTFATERR_BADREQSIZE      | \a gl is greater than \a L
+ * LTFATERR_INITFAILED      | FFTW plan creation failed
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(iwmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                        ltfat_int W, ltfat_int M, unsigned flags,
+                        LTFAT_NAME(iwmdct_plan)** p);
+
+/** Execute IWMDCT plan
+ *
+ * \param[in]     p   IWMDCT plan
+ * \param[in]     c   Coefficients, size M x N x W, N = L/M
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwmdct_execute_d(ltfat_iwmdct_plan_d* p, const double c[], double f[]);
+ *
+ * ltfat_iwmdct_execute_s(ltfat_iwmdct_plan_s* p, const float c[], float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(iwmdct_execute)(LTFAT_NAME(iwmdct_plan)* p, const LTFAT_REAL c[],
+                           LTFAT_REAL f[]);
+
+/** Destroy IWMDCT plan
+ *
+ * \param[in]     p   IWMDCT plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwmdct_done_d(ltfat_iwmdct_plan_d** p);
+ *
+ * ltfat_iwmdct_done_s(ltfat_iwmdct_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(iwmdct_done)(LTFAT_NAME(iwmdct_plan)** p);
+
+/** @} */
+/** @} */
@@ -0,0 +1,258 @@
+typedef struct LTFAT_NAME(fwt_processor_state) LTFAT_NAME(fwt_processor_state);
+
+/** \defgroup fwtprocessor Streaming wavelet transform processor
+ *  \addtogroup fwtprocessor
+ * @{
+ *
+ * The processor computes a J-level M-band discrete wavelet transform of a
+ * stream of data supplied in chunks of arbitrary length. Each level
+ * keeps a delay line of the last max(gl)-1 samples of its input for every
+ * channel, and the subband samples are emitted as soon as all input
+ * samples they depend on are available. The first filter of each level
+ * is the lowpass, which is iterated.
+ *
+ * There are J*(M-1)+1 outputs in the same order as in fwt:
+ * c[0] is the approximation and then the details go from the coarsest
+ * level J to level 1.
+ *
+ * The concatenation of the outputs of all execute calls equals the
+ * output of wfbt with zero boundary extension restricted to the samples
+ * the input seen so far determines. Output n of subband k becomes
+ * available once input sample n*a_k + delay[k] was processed, where a_k is
+ * the total subsampling of the subband and delay is obtained from
+ * fwt_processor_getdelay.
+ *
+ * Example:
+ * ~~~~~~~~~~~~~~~{.c}
+ * // Setup, 5 level DWT of a stereo stream
+ * const double* g[2] = {h0, h1};
+ * ltfat_int gl[2] = {8, 8}, a[2] = {2, 2}, offset[2] = {0, 0};
+ * ltfat_fwt_processor_init_d(g, gl, a, offset, 2, 5, 2, 1024, &procstate);
+ * ltfat_fwt_processor_setcallback_d(procstate, consume, userdata);
+ *
+ * // In the audio loop
+ * ltfat_fwt_processor_execute_d(procstate, data, dataLen, chanNo);
+ *
+ * // Teardown
+ * ltfat_fwt_processor_done_d(&procstate);
+ * ~~~~~~~~~~~~~~~
+ */
+
+/** Processor callback signature
+ *
+ * The callback is called once per execute call with the subband samples
+ * produced by that call. It is called even if some subbands did not
+ * produce any sample.
+ *
+ * \param[in]  userdata   User defined data
+ * \param[in]         c   Subband samples, c[k] is a clen[k] x W array
+ * \param[in]      clen   Number of new samples in each subband
+ * \param[in]      nout   Number of subbands, J*(M-1)+1
+ * \param[in]         W   Number of channels
+ *
+ *  #### Function versions #
+ *  <tt>
+ *  typedef void ltfat_fwt_processor_callback_d(void* userdata, const double* c[],
+ *                                              const ltfat_int clen[], int nout, int W);
+ *
+ *  typedef void ltfat_fwt_processor_callback_s(void* userdata, const float* c[],
+ *                                              const ltfat_int clen[], int nout, int W);
+ *  </tt>
+ */
+typedef void LTFAT_NAME(fwt_processor_callback)(void* userdata,
+        const LTFAT_REAL* c[], const ltfat_int clen[], int nout, int W);
+
+/** Create streaming wavelet transform processor state struct
+ *
+ * All buffers are allocated here, execute does no allocations.
+ *
+ * \param[in]           g   Filters, size M
+ * \param[in]          gl   Filter lengths, size M
+ * \param[in]           a   Subsampling factors, size M
+ * \param[in]      offset   Filter offsets, -gl[m] < offset[m] <= 0, size M
+ * \param[in]           M   Number of filters per level
+ * \param[in]           J   Number of levels
+ * \param[in]        Wmax   Maximum number of channels
+ * \param[in]   bufLenMax   Maximum buffer length expected in execute
+ * \param[out]          p   Processor state
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_fwt_processor_init_d(const double* g[], const ltfat_int gl[],
+ *                            const ltfat_int a[], const ltfat_int offset[],
+ *                            ltfat_int M, ltfat_int J, ltfat_int Wmax,
+ *                            ltfat_int bufLenMax, ltfat_fwt_processor_state_d** p);
+ *
+ * ltfat_fwt_processor_init_s(const float* g[], const ltfat_int gl[],
+ *                            const ltfat_int a[], const ltfat_int offset[],
+ *                            ltfat_int M, ltfat_int J, ltfat_int Wmax,
+ *                            ltfat_int bufLenMax, ltfat_fwt_processor_state_s** p);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  One of the arrays or \a p was NULL
+ * LTFATERR_BADSIZE      |  One of \a gl was less or equal to 0
+ * LTFATERR_NOTPOSARG    |  One of \a a, \a J, \a Wmax, \a bufLenMax was not positive or \a M was less than 2
+ * LTFATERR_BADARG       |  One of \a offset was out of range
+ * LTFATERR_NOMEM        |  Heap memory allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                               const ltfat_int a[], const ltfat_int offset[],
+                               ltfat_int M, ltfat_int J, ltfat_int Wmax,
+                               ltfat_int bufLenMax,
+                               LTFAT_NAME(fwt_processor_state)** p);
+
+/** Process samples
+ *
+ * Feeds \a len new samples of each channel through all levels and calls
+ * the callback with the subband samples which became available.
+ *
+ * \param[in]    p   Processor state
+ * \param[in]   in   Input channels, in[w] has length \a len
+ * \param[in]  len   Number of samples in each channel
+ * \param[in] chanNo Number of channels
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_fwt_processor_execute_d(ltfat_fwt_processor_state_d* p, const double* in[],
+ *                               ltfat_int len, ltfat_int chanNo);
+ *
+ * ltfat_fwt_processor_execute_s(ltfat_fwt_processor_state_s* p, const float* in[],
+ *                               ltfat_int len, ltfat_int chanNo);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  \a p or \a in were NULL
+ * LTFATERR_BADSIZE      |  \a len or \a chanNo were negative
+ * LTFATERR_OVERFLOW     |  \a len or \a chanNo were bigger than \a bufLenMax or \a Wmax, only the first samples/channels were processed
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_execute)(LTFAT_NAME(fwt_processor_state)* p,
+                                  const LTFAT_REAL* in[], ltfat_int len,
+                                  ltfat_int chanNo);
+
+/** Process samples -- compact version
+ *
+ * The channels are stored one after the other in a single array.
+ *
+ * \param[in]    p   Processor state
+ * \param[in]   in   Input channels, size len x chanNo
+ * \param[in]  len   Number of samples in each channel
+ * \param[in] chanNo Number of channels
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_fwt_processor_execute_compact_d(ltfat_fwt_processor_state_d* p, const double in[],
+ *                                       ltfat_int len, ltfat_int chanNo);
+ *
+ * ltfat_fwt_processor_execute_compact_s(ltfat_fwt_processor_state_s* p, const float in[],
+ *                                       ltfat_int len, ltfat_int chanNo);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  \a p or \a in were NULL
+ * LTFATERR_BADSIZE      |  \a len or \a chanNo were negative
+ * LTFATERR_OVERFLOW     |  \a len or \a chanNo were bigger than \a bufLenMax or \a Wmax, only the first samples/channels were processed
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_execute_compact)(LTFAT_NAME(fwt_processor_state)* p,
+        const LTFAT_REAL in[], ltfat_int len, ltfat_int chanNo);
+
+/** Reset processor state
+ *
+ * Clears the delay lines of all levels. Whenever there is a break in the
+ * continuity of the input stream, the state should be reset before
+ * feeding new data.
+ *
+ * \param[in]    p   Processor state
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_fwt_processor_reset_d(ltfat_fwt_processor_state_d* p);
+ *
+ * ltfat_fwt_processor_reset_s(ltfat_fwt_processor_state_s* p);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_reset)(LTFAT_NAME(fwt_processor_state)* p);
+
+/** Set processor callback
+ *
+ * \param[in]        p   Processor state
+ * \param[in] callback   Callback, can be NULL
+ * \param[in] userdata   User defined data passed to the callback
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_fwt_processor_setcallback_d(ltfat_fwt_processor_state_d* p,
+ *                                   ltfat_fwt_processor_callback_d* callback,
+ *                                   void* userdata);
+ *
+ * ltfat_fwt_processor_setcallback_s(ltfat_fwt_processor_state_s* p,
+ *                                   ltfat_fwt_processor_callback_s* callback,
+ *                                   void* userdata);
+ * </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_setcallback)(LTFAT_NAME(fwt_processor_state)* p,
+                                      LTFAT_NAME(fwt_processor_callback)* callback,
+                                      void* userdata);
+
+/** Number of subbands
+ *
+ * \returns J*(M-1)+1 or a negative status code
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(fwt_processor_getnout)(LTFAT_NAME(fwt_processor_state)* p);
+
+/** Delay of the subbands in input samples
+ *
+ * Output n of subband k depends on input samples up to n*a_k + delay[k],
+ * a_k being the total subsampling of the subband.
+ *
+ * \param[in]      p   Processor state
+ * \param[out] delay   Delays, size fwt_processor_getnout(p)
+ *
+ * \returns Status code
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_getdelay)(LTFAT_NAME(fwt_processor_state)* p,
+                                   ltfat_int delay[]);
+
+/** Destroy processor state
+ *
+ * \param[in]  p   Processor state
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_fwt_processor_done_d(ltfat_fwt_processor_state_d** p);
+ *
+ * ltfat_fwt_processor_done_s(ltfat_fwt_processor_state_s** p);
+ * </tt>
+ *
+ * \returns
+ * Status code           |  Description
+ * ----------------------|----------------------
+ * LTFATERR_SUCCESS      |  No error occured
+ * LTFATERR_NULLPOINTER  |  \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(fwt_processor_done)(LTFAT_NAME(fwt_processor_state)** p);
+
+/** @} */
@@ -29,9 +29,6 @@ LTFAT_NAME(gabframediag)(const LTFAT_TYPE* g, ltfat_int gl,
  */
 
 /** Compute canonical dual window for Gabor system
- *
- * \warning This function is not available if libltfat has been compiled with
- * NOBLASLAPACK.
  *
  * \param[in]   g    Original window(s), size L x R
  * \param[in]   L    Length of the system
@@ -76,9 +73,6 @@ LTFAT_NAME(multiwingabdual_long)(
 
 /** Compute canonical tight window for Gabor system
  *
- * \warning This function is not available if libltfat has been compiled with
- * NOBLASLAPACK.
- * 
  * \see fir2long long2fir
  *
  * \param[in]   g    Original window(s), size L x R
@@ -190,6 +184,88 @@ LTFAT_NAME(gabdual_painless)(const LTFAT_TYPE g[], ltfat_int gl, ltfat_int a,
 LTFAT_API int
 LTFAT_NAME(gabtight_painless)(const LTFAT_TYPE g[], ltfat_int gl, ltfat_int a,
                               ltfat_int M, LTFAT_TYPE gt[]);
+
+/** Compute canonical dual windows for a batch of Gabor systems
+ *
+ * Request k asks for the canonical dual of window \a g[k] of length \a gl[k]
+ * (in the fir2long convention) in the Gabor system with parameters
+ * \a L[k], \a a[k] and \a M[k].
+ * Painless requests use the frame diagonal, the rest use the factorization
+ * algorithm. Requests with the same parameters and window samples are
+ * computed only once and the unique requests are processed in parallel
+ * (if compiled with OpenMP).
+ *
+ * \param[in]   g    Original windows, g[k] has gl[k] samples
+ * \param[in]  gl    Window lengths, size K
+ * \param[in]   L    System lengths, size K
+ * \param[in]   a    Hop factors, size K
+ * \param[in]   M    Numbers of channels, size K
+ * \param[in]   K    Number of requests
+ * \param[out] gd    Canonical dual windows, gd[k] has L[k] samples
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gabdual_batch_d(const double* const g[], const ltfat_int gl[],
+ *                       const ltfat_int L[], const ltfat_int a[],
+ *                       const ltfat_int M[], ltfat_int K, double* gd[]);
+ *
+ * ltfat_gabdual_batch_s(const float* const g[], const ltfat_int gl[],
+ *                       const ltfat_int L[], const ltfat_int a[],
+ *                       const ltfat_int M[], ltfat_int K, float* gd[]);
+ *
+ * ltfat_gabdual_batch_dc(const ltfat_complex_d* const g[], const ltfat_int gl[],
+ *                        const ltfat_int L[], const ltfat_int a[],
+ *                        const ltfat_int M[], ltfat_int K, ltfat_complex_d* gd[]);
+ *
+ * ltfat_gabdual_batch_sc(const ltfat_complex_s* const g[], const ltfat_int gl[],
+ *                        const ltfat_int L[], const ltfat_int a[],
+ *                        const ltfat_int M[], ltfat_int K, ltfat_complex_s* gd[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | Either of the arrays is NULL
+ * LTFATERR_BADSIZE         | One of \a gl is less or equal to 0.
+ * LTFATERR_BADREQSIZE      | L[k] < gl[k] for some k.
+ * LTFATERR_BADTRALEN       | L[k] is not divisible by lcm(a[k],M[k]) for some k.
+ * LTFATERR_NOTPOSARG       | \a K or one of \a a, \a M is less or equal to 0.
+ * LTFATERR_NOTAFRAME       | One of the systems does not form a frame
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(gabdual_batch)(const LTFAT_TYPE* const g[], const ltfat_int gl[],
+                          const ltfat_int L[], const ltfat_int a[],
+                          const ltfat_int M[], ltfat_int K, LTFAT_TYPE* gd[]);
+
+/** Compute canonical tight windows for a batch of Gabor systems
+ *
+ * Same as gabdual_batch, but computes the canonical tight windows.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gabtight_batch_d(const double* const g[], const ltfat_int gl[],
+ *                        const ltfat_int L[], const ltfat_int a[],
+ *                        const ltfat_int M[], ltfat_int K, double* gt[]);
+ *
+ * ltfat_gabtight_batch_s(const float* const g[], const ltfat_int gl[],
+ *                        const ltfat_int L[], const ltfat_int a[],
+ *                        const ltfat_int M[], ltfat_int K, float* gt[]);
+ *
+ * ltfat_gabtight_batch_dc(const ltfat_complex_d* const g[], const ltfat_int gl[],
+ *                         const ltfat_int L[], const ltfat_int a[],
+ *                         const ltfat_int M[], ltfat_int K, ltfat_complex_d* gt[]);
+ *
+ * ltfat_gabtight_batch_sc(const ltfat_complex_s* const g[], const ltfat_int gl[],
+ *                         const ltfat_int L[], const ltfat_int a[],
+ *                         const ltfat_int M[], ltfat_int K, ltfat_complex_s* gt[]);
+ * </tt>
+ * \returns Status code, see gabdual_batch
+ */
+LTFAT_API int
+LTFAT_NAME(gabtight_batch)(const LTFAT_TYPE* const g[], const ltfat_int gl[],
+                           const ltfat_int L[], const ltfat_int a[],
+                           const ltfat_int M[], ltfat_int K, LTFAT_TYPE* gt[]);
 /** @} */
 /** @} */
 
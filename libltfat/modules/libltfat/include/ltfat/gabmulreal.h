@@ -0,0 +1,233 @@
+typedef struct LTFAT_NAME(gabmulreal_plan) LTFAT_NAME(gabmulreal_plan);
+
+/** \defgroup gabmulreal Gabor multiplier for real signals
+ *  \addtogroup gabmulreal
+ * @{
+ *
+ * Applies the Gabor multiplier
+ *
+ * out = idgtreal(s .* dgtreal(f, ga, a, M), gs, a, M)
+ *
+ * with a real symbol s of size M2 x N where M2 = M/2 + 1 and N = L/a.
+ * The transform is computed frame by frame and the frames whose symbol
+ * column is all zero are skipped altogether, i.e. the cost is
+ * proportional to the number of nonzero columns of the symbol.
+ *
+ * The symbol can be passed either as a dense array which is scanned for
+ * zero columns or as a list of the nonzero columns.
+ *
+ * The number of computed and skipped frames is counted so that the work
+ * saved with respect to the dense path can be reported.
+ */
+
+/** Initialize the Gabor multiplier plan
+ *
+ * The symbol is initially all zero.
+ *
+ * \param[in]     ga   Analysis window
+ * \param[in]    gal   Analysis window length
+ * \param[in]     gs   Synthesis window
+ * \param[in]    gsl   Synthesis window length
+ * \param[in]      L   Signal length
+ * \param[in]      a   Hop factor
+ * \param[in]      M   Number of frequency channels
+ * \param[in]  flags   FFTW planning flag
+ * \param[out]     p   Gabor multiplier plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_gabmulreal_init_d(const double ga[], ltfat_int gal, const double gs[], ltfat_int gsl,
+ *                         ltfat_int L, ltfat_int a, ltfat_int M, unsigned flags,
+ *                         ltfat_gabmulreal_plan_d** p);
+ *
+ * ltfat_gabmulreal_init_s(const float ga[], ltfat_int gal, const float gs[], ltfat_int gsl,
+ *                         ltfat_int L, ltfat_int a, ltfat_int M, unsigned flags,
+ *                         ltfat_gabmulreal_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a ga, \a gs or \a p was NULL
+ * LTFATERR_BADSIZE         | \a gal or \a gsl was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a a or \a M was less or equal to 0
+ * LTFATERR_BADTRALEN       | \a L is not divisible by \a a or it is shorter than one of the windows
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_init)(const LTFAT_REAL ga[], ltfat_int gal,
+                            const LTFAT_REAL gs[], ltfat_int gsl,
+                            ltfat_int L, ltfat_int a, ltfat_int M,
+                            unsigned flags, LTFAT_NAME(gabmulreal_plan)** p);
+
+/** Set a dense symbol
+ *
+ * Columns which are all zero are marked inactive. The frame statistics
+ * are reset.
+ *
+ * \param[in]   p   Gabor multiplier plan
+ * \param[in]   s   Symbol, size M2 x N
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_gabmulreal_set_symbol_d(ltfat_gabmulreal_plan_d* p, const double s[]);
+ *
+ * ltfat_gabmulreal_set_symbol_s(ltfat_gabmulreal_plan_s* p, const float s[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a s was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_set_symbol)(LTFAT_NAME(gabmulreal_plan)* p,
+                                  const LTFAT_REAL s[]);
+
+/** Set a symbol given by its nonzero columns
+ *
+ * Only the listed columns are active, all other columns are zero.
+ * The frame statistics are reset.
+ *
+ * \param[in]     p   Gabor multiplier plan
+ * \param[in]     s   Symbol columns, size M2 x ncols
+ * \param[in]  cols   Indices of the columns in range [0, N), size ncols
+ * \param[in] ncols   Number of the columns
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_gabmulreal_set_symbol_sparse_d(ltfat_gabmulreal_plan_d* p, const double s[],
+ *                                      const ltfat_int cols[], ltfat_int ncols);
+ *
+ * ltfat_gabmulreal_set_symbol_sparse_s(ltfat_gabmulreal_plan_s* p, const float s[],
+ *                                      const ltfat_int cols[], ltfat_int ncols);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or \a s or \a cols was NULL and \a ncols was positive
+ * LTFATERR_BADSIZE         | \a ncols was negative or greater than N
+ * LTFATERR_BADARG          | An index in \a cols was out of range
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_set_symbol_sparse)(LTFAT_NAME(gabmulreal_plan)* p,
+        const LTFAT_REAL s[], const ltfat_int cols[], ltfat_int ncols);
+
+/** Apply the multiplier
+ *
+ * \param[in]     p   Gabor multiplier plan
+ * \param[in]     f   Input signal, size L x W
+ * \param[in]     W   Number of channels
+ * \param[out]  out   Output signal, size L x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_gabmulreal_execute_d(ltfat_gabmulreal_plan_d* p, const double f[], ltfat_int W,
+ *                            double out[]);
+ *
+ * ltfat_gabmulreal_execute_s(ltfat_gabmulreal_plan_s* p, const float f[], ltfat_int W,
+ *                            float out[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a f or \a out was NULL
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0
+ * LTFATERR_BADARG          | \a f and \a out were the same array
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_execute)(LTFAT_NAME(gabmulreal_plan)* p,
+                               const LTFAT_REAL f[], ltfat_int W,
+                               LTFAT_REAL out[]);
+
+/** Use the plan symbol in a DGTREAL processor
+ *
+ * Sets the processor callback and the frame activity callback of \a proc
+ * such that the streamed frames are multiplied by the symbol columns
+ * 0, 1, ..., N-1, 0, 1, ... and the frames falling on the inactive
+ * columns are not transformed at all. Setting a new symbol restarts the
+ * column sequence.
+ *
+ * The processor must use the same \a a and \a M as the plan and the plan
+ * must outlive it.
+ *
+ * \param[in]     p   Gabor multiplier plan
+ * \param[in]  proc   DGTREAL processor state
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_gabmulreal_attach_processor_d(ltfat_gabmulreal_plan_d* p,
+ *                                     ltfat_rtdgtreal_processor_state_d* proc);
+ *
+ * ltfat_gabmulreal_attach_processor_s(ltfat_gabmulreal_plan_s* p,
+ *                                     ltfat_rtdgtreal_processor_state_s* proc);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a proc was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_attach_processor)(LTFAT_NAME(gabmulreal_plan)* p,
+                                        LTFAT_NAME(rtdgtreal_processor_state)* proc);
+
+/** Get the number of computed and skipped frames
+ *
+ * The counts include all channels of all execute calls and all frames
+ * streamed through an attached processor since the symbol was last set.
+ * As the cost of a frame is fixed, skipped/(computed + skipped) is the
+ * fraction of the work saved with respect to the dense path.
+ *
+ * \param[in]         p   Gabor multiplier plan
+ * \param[out] computed   Number of computed frames, can be NULL
+ * \param[out]  skipped   Number of skipped frames, can be NULL
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_get_framestats)(LTFAT_NAME(gabmulreal_plan)* p,
+                                      ltfat_int* computed, ltfat_int* skipped);
+
+/** Number of active (nonzero) symbol columns */
+LTFAT_API ltfat_int
+LTFAT_NAME(gabmulreal_get_nactive)(LTFAT_NAME(gabmulreal_plan)* p);
+
+/** Destroy the Gabor multiplier plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal_done)(LTFAT_NAME(gabmulreal_plan)** p);
+
+/** Apply the multiplier with a dense symbol in one go
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_gabmulreal_d(const double f[], const double ga[], ltfat_int gal,
+ *                    const double gs[], ltfat_int gsl, const double s[],
+ *                    ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M, double out[]);
+ *
+ * ltfat_gabmulreal_s(const float f[], const float ga[], ltfat_int gal,
+ *                    const float gs[], ltfat_int gsl, const float s[],
+ *                    ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M, float out[]);
+ * </tt>
+ * \returns Status code, see gabmulreal_init and gabmulreal_execute
+ */
+LTFAT_API int
+LTFAT_NAME(gabmulreal)(const LTFAT_REAL f[], const LTFAT_REAL ga[],
+                       ltfat_int gal, const LTFAT_REAL gs[], ltfat_int gsl,
+                       const LTFAT_REAL s[], ltfat_int L, ltfat_int W,
+                       ltfat_int a, ltfat_int M, LTFAT_REAL out[]);
+
+/** @} */
@@ -23,12 +23,63 @@ LTFAT_NAME(gga_init)(const LTFAT_REAL *indVecPtr,
 LTFAT_API void
 LTFAT_NAME(gga_done)(LTFAT_NAME(gga_plan) plan);
 
+/** Set number of threads used by gga_execute
+ *
+ * The frequency bins are split among the threads. It has no effect if
+ * libltfat was compiled without OpenMP.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gga_set_nthreads_d(ltfat_gga_plan_d p, ltfat_int nthreads);
+ *
+ * ltfat_gga_set_nthreads_s(ltfat_gga_plan_s p, ltfat_int nthreads);
+ *
+ * ltfat_gga_set_nthreads_dc(ltfat_gga_plan_dc p, ltfat_int nthreads);
+ *
+ * ltfat_gga_set_nthreads_sc(ltfat_gga_plan_sc p, ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(gga_set_nthreads)(LTFAT_NAME(gga_plan) p, ltfat_int nthreads);
+
 
 LTFAT_API
 void LTFAT_NAME(gga)(const LTFAT_TYPE *fPtr, const LTFAT_REAL *indVecPtr,
                      ltfat_int L, ltfat_int W, ltfat_int M,
                      LTFAT_COMPLEX *cPtr);
 
+/** Execute Goertzel plan
+ *
+ * The recursion state is kept in the plan, so a plan must not be executed
+ * from several threads at the same time. Use one plan per thread or let
+ * a single plan use several threads, see gga_set_nthreads.
+ *
+ * \param[in]      p   Goertzel plan
+ * \param[in]   fPtr   Input signal, size L x W
+ * \param[in]      W   Number of channels
+ * \param[out]  cPtr   Output coefficients, size M x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gga_execute_d(ltfat_gga_plan_d p, const double fPtr[], ltfat_int W,
+ *                     ltfat_complex_d cPtr[]);
+ *
+ * ltfat_gga_execute_s(ltfat_gga_plan_s p, const float fPtr[], ltfat_int W,
+ *                     ltfat_complex_s cPtr[]);
+ *
+ * ltfat_gga_execute_dc(ltfat_gga_plan_dc p, const ltfat_complex_d fPtr[],
+ *                      ltfat_int W, ltfat_complex_d cPtr[]);
+ *
+ * ltfat_gga_execute_sc(ltfat_gga_plan_sc p, const ltfat_complex_s fPtr[],
+ *                      ltfat_int W, ltfat_complex_s cPtr[]);
+ * </tt>
+ */
 LTFAT_API void
 LTFAT_NAME(gga_execute)(LTFAT_NAME(gga_plan) p,
                         const LTFAT_TYPE *fPtr,
@@ -57,6 +108,64 @@ LTFAT_NAME(chzt_init)(ltfat_int K, ltfat_int L,
                       const LTFAT_REAL deltao, const LTFAT_REAL o,
                       const unsigned fftw_flags, czt_ffthint hint);
 
+/** Create a chirped Z-transform plan for W channels
+ *
+ * The plan computes c(k,w) = sum_l f(l,w) exp(-i*(o + k*deltao)*l) for
+ * k=0,...,K-1 using the Bluestein algorithm with one forward and one inverse
+ * FFT of length at least L+K-1 per channel.
+ *
+ * The FFTs of all W channels are done by a single call of the FFT backend.
+ * The plan can be executed repeatedly with any number of channels, it is
+ * processed in batches of W channels. The execute function does not
+ * allocate any memory.
+ *
+ * \param[in]          K   Number of frequency samples
+ * \param[in]          L   Signal length
+ * \param[in]          W   Number of channels processed at once
+ * \param[in]     deltao   Frequency step
+ * \param[in]          o   Starting frequency
+ * \param[in] fftw_flags   FFTW planning flags
+ * \param[in]       hint   How to choose the length of the internal FFT
+ * \param[out]         p   Initialized plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_chzt_init_batch_d(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                         const double deltao, const double o,
+ *                         unsigned fftw_flags, czt_ffthint hint,
+ *                         ltfat_chzt_plan_d* p);
+ *
+ * ltfat_chzt_init_batch_s(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                         const float deltao, const float o,
+ *                         unsigned fftw_flags, czt_ffthint hint,
+ *                         ltfat_chzt_plan_s* p);
+ *
+ * ltfat_chzt_init_batch_dc(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                          const double deltao, const double o,
+ *                          unsigned fftw_flags, czt_ffthint hint,
+ *                          ltfat_chzt_plan_dc* p);
+ *
+ * ltfat_chzt_init_batch_sc(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                          const float deltao, const float o,
+ *                          unsigned fftw_flags, czt_ffthint hint,
+ *                          ltfat_chzt_plan_sc* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a K or \a W was less or equal to 0.
+ * LTFATERR_INITFAILED      | The FFT plan creation failed.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(chzt_init_batch)(ltfat_int K, ltfat_int L, ltfat_int W,
+                            const LTFAT_REAL deltao, const LTFAT_REAL o,
+                            const unsigned fftw_flags, czt_ffthint hint,
+                            LTFAT_NAME(chzt_plan)* p);
+
 LTFAT_API
 void LTFAT_NAME(chzt_done)(LTFAT_NAME(chzt_plan) p);
 
@@ -77,3 +186,61 @@ LTFAT_API LTFAT_NAME(chzt_plan)
 LTFAT_NAME(chzt_fac_init)(ltfat_int K, ltfat_int L,
                           const LTFAT_REAL deltao, const LTFAT_REAL o,
                           const unsigned fftw_flags, czt_ffthint hint);
+
+/** Create a chirped Z-transform plan for W channels
+ *
+ * Same as chzt_init_batch, but the signal is split into q=ceil(L/K)
+ * subsequences and the plan uses q FFTs of length at least 2K-1 per channel
+ * instead. This is cheaper when K is much smaller than L.
+ *
+ * The FFTs of all W channels are done by a single call of the FFT backend.
+ * The plan can be executed repeatedly with any number of channels, it is
+ * processed in batches of W channels. The execute function does not
+ * allocate any memory.
+ *
+ * \param[in]          K   Number of frequency samples
+ * \param[in]          L   Signal length
+ * \param[in]          W   Number of channels processed at once
+ * \param[in]     deltao   Frequency step
+ * \param[in]          o   Starting frequency
+ * \param[in] fftw_flags   FFTW planning flags
+ * \param[in]       hint   How to choose the length of the internal FFT
+ * \param[out]         p   Initialized plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_chzt_fac_init_batch_d(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                             const double deltao, const double o,
+ *                             unsigned fftw_flags, czt_ffthint hint,
+ *                             ltfat_chzt_plan_d* p);
+ *
+ * ltfat_chzt_fac_init_batch_s(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                             const float deltao, const float o,
+ *                             unsigned fftw_flags, czt_ffthint hint,
+ *                             ltfat_chzt_plan_s* p);
+ *
+ * ltfat_chzt_fac_init_batch_dc(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                              const double deltao, const double o,
+ *                              unsigned fftw_flags, czt_ffthint hint,
+ *                              ltfat_chzt_plan_dc* p);
+ *
+ * ltfat_chzt_fac_init_batch_sc(ltfat_int K, ltfat_int L, ltfat_int W,
+ *                              const float deltao, const float o,
+ *                              unsigned fftw_flags, czt_ffthint hint,
+ *                              ltfat_chzt_plan_sc* p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a K or \a W was less or equal to 0.
+ * LTFATERR_INITFAILED      | The FFT plan creation failed.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(chzt_fac_init_batch)(ltfat_int K, ltfat_int L, ltfat_int W,
+                                const LTFAT_REAL deltao, const LTFAT_REAL o,
+                                const unsigned fftw_flags, czt_ffthint hint,
+                                LTFAT_NAME(chzt_plan)* p);
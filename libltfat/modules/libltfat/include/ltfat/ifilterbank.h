@@ -0,0 +1,140 @@
+typedef struct LTFAT_NAME(ifilterbank_plan) LTFAT_NAME(ifilterbank_plan);
+
+/** \defgroup ifilterbank Inverse filterbank plan
+ *  \addtogroup ifilterbank
+ * @{
+ *
+ * Computes
+ *
+ * f = ifft(ifilterbank_fftbl(c, G, L, Gl, W, a, M, foff, realonly))
+ *
+ * i.e. the time domain output of comp_ifilterbank.m for frequency domain
+ * filters. A full length filter is a filter with Gl = L and foff = 0.
+ *
+ * The channels with the same number of coefficients are transformed by
+ * one batched FFT. The channels are then split among the threads, each
+ * thread accumulates its channels into its own copy of the output spectrum
+ * and the copies are summed pairwise. The inverse FFT is done once at the
+ * end.
+ */
+
+/** Initialize the inverse filterbank plan
+ *
+ * The filters are copied to the plan.
+ *
+ * \param[in]         G   Frequency responses of the filters, M arrays of lengths Gl[m]
+ * \param[in]        Gl   Filter lengths, size M
+ * \param[in]      foff   Frequency offsets of the filters, size M
+ * \param[in]  realonly   Filters which should also be applied to the negative frequencies, size M
+ * \param[in]         a   Hop factors, size M. Channel m has round(L/a[m]) coefficients.
+ * \param[in]         M   Number of channels
+ * \param[in]         L   Signal length
+ * \param[in]         W   Number of signal channels
+ * \param[in]     flags   FFTW planning flag
+ * \param[out]        p   Inverse filterbank plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_ifilterbank_init_d(const ltfat_complex_d* G[], const ltfat_int Gl[],
+ *                          const ltfat_int foff[], const int realonly[], const double a[],
+ *                          ltfat_int M, ltfat_int L, ltfat_int W, unsigned flags,
+ *                          ltfat_ifilterbank_plan_d** p);
+ *
+ * ltfat_ifilterbank_init_s(const ltfat_complex_s* G[], const ltfat_int Gl[],
+ *                          const ltfat_int foff[], const int realonly[], const double a[],
+ *                          ltfat_int M, ltfat_int L, ltfat_int W, unsigned flags,
+ *                          ltfat_ifilterbank_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arrays or \a p was NULL
+ * LTFATERR_BADTRALEN       | \a L was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a M, \a W or some of \a a was less or equal to 0
+ * LTFATERR_BADSIZE         | Some of \a Gl was negative or greater than \a L or some channel would have no coefficients
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(ifilterbank_init)(const LTFAT_COMPLEX* G[], const ltfat_int Gl[],
+                             const ltfat_int foff[], const int realonly[],
+                             const double a[], ltfat_int M, ltfat_int L,
+                             ltfat_int W, unsigned flags,
+                             LTFAT_NAME(ifilterbank_plan)** p);
+
+/** Synthesize the signal from the filterbank coefficients
+ *
+ * \param[in]     p   Inverse filterbank plan
+ * \param[in]     c   Coefficients, M arrays of size round(L/a[m]) x W
+ * \param[out]    f   Output signal, size L x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_ifilterbank_execute_d(ltfat_ifilterbank_plan_d* p, const ltfat_complex_d* c[],
+ *                             ltfat_complex_d f[]);
+ *
+ * ltfat_ifilterbank_execute_s(ltfat_ifilterbank_plan_s* p, const ltfat_complex_s* c[],
+ *                             ltfat_complex_s f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a c or \a f was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(ifilterbank_execute)(LTFAT_NAME(ifilterbank_plan)* p,
+                                const LTFAT_COMPLEX* c[], LTFAT_COMPLEX f[]);
+
+/** Set number of threads used by ifilterbank_execute
+ *
+ * Each thread except the first one needs an L x W buffer. Without
+ * OpenMP, this has no effect. The default is 1. The result can differ
+ * in the order of the rounding errors for a different number of threads.
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(ifilterbank_set_nthreads)(LTFAT_NAME(ifilterbank_plan)* p,
+                                     ltfat_int nthreads);
+
+/** Destroy the inverse filterbank plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(ifilterbank_done)(LTFAT_NAME(ifilterbank_plan)** p);
+
+/** Synthesize the signal in one go
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_ifilterbank_d(const ltfat_complex_d* c[], const ltfat_complex_d* G[],
+ *                     const ltfat_int Gl[], const ltfat_int foff[], const int realonly[],
+ *                     const double a[], ltfat_int M, ltfat_int L, ltfat_int W,
+ *                     ltfat_complex_d f[]);
+ *
+ * ltfat_ifilterbank_s(const ltfat_complex_s* c[], const ltfat_complex_s* G[],
+ *                     const ltfat_int Gl[], const ltfat_int foff[], const int realonly[],
+ *                     const double a[], ltfat_int M, ltfat_int L, ltfat_int W,
+ *                     ltfat_complex_s f[]);
+ * </tt>
+ * \returns Status code, see ifilterbank_init and ifilterbank_execute
+ */
+LTFAT_API int
+LTFAT_NAME(ifilterbank)(const LTFAT_COMPLEX* c[], const LTFAT_COMPLEX* G[],
+                        const ltfat_int Gl[], const ltfat_int foff[],
+                        const int realonly[], const double a[], ltfat_int M,
+                        ltfat_int L, ltfat_int W, LTFAT_COMPLEX f[]);
+
+/** @} */
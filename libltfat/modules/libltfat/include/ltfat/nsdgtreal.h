@@ -0,0 +1,322 @@
+typedef struct LTFAT_NAME(nsdgtreal_plan) LTFAT_NAME(nsdgtreal_plan);
+// The inverse plan is the same
+typedef LTFAT_NAME(nsdgtreal_plan) LTFAT_NAME(insdgtreal_plan);
+
+/** \defgroup nsdgt Non-stationary Gabor transform
+ *  \addtogroup nsdgt
+ * @{
+ *
+ * Frame n has window g[n] of length gl[n], M[n] frequency channels and
+ * it is centered at sample timepos[n] = a[1] + ... + a[n], i.e.
+ * cumsum(a)-a(1) as in nsdgt.m. The signal length is
+ * L = a[0] + ... + a[N-1]. The windows are stored with their
+ * center at index 0 as in the rest of the library, i.e. the first
+ * ceil(gl/2) samples are the center and the right half and the last
+ * floor(gl/2) samples are the left half.
+ *
+ * The coefficients of all frames are stored one after the other in a
+ * single array. Frame n is a (M[n]/2+1) x W array and it starts at index
+ * W*sum_{k<n}(M[k]/2+1).
+ *
+ * The plans group frames by M and compute the FFTs of all frames of a
+ * group and all channels by a single FFT plan. The execute functions do
+ * not allocate.
+ */
+
+/** Initialize the non-stationary DGTREAL plan
+ *
+ * \param[in]      g   Windows, size N
+ * \param[in]     gl   Window lengths, size N
+ * \param[in]      a   Time shifts, size N
+ * \param[in]      M   Numbers of frequency channels, size N
+ * \param[in]      N   Number of frames
+ * \param[in]      W   Number of signal channels
+ * \param[in]  flags   FFTW planning flag
+ * \param[out]     p   Non-stationary DGTREAL plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_nsdgtreal_init_d(const double* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int M[],
+ *                        ltfat_int N, ltfat_int W, unsigned flags,
+ *                        ltfat_nsdgtreal_plan_d** p);
+ *
+ * ltfat_nsdgtreal_init_s(const float* g[], const ltfat_int gl[],
+ *                        const ltfat_int a[], const ltfat_int M[],
+ *                        ltfat_int N, ltfat_int W, unsigned flags,
+ *                        ltfat_nsdgtreal_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arrays or \a p was NULL
+ * LTFATERR_BADSIZE         | One of \a gl was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a N, \a W or one of \a a, \a M was less or equal to 0
+ * LTFATERR_BADREQSIZE      | One of the windows is longer than L
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[],
+                           ltfat_int N, ltfat_int W, unsigned flags,
+                           LTFAT_NAME(nsdgtreal_plan)** p);
+
+/** Execute the non-stationary DGTREAL plan
+ *
+ * \param[in]   p   Non-stationary DGTREAL plan
+ * \param[in]   f   Input signal, size L x W
+ * \param[out]  c   Coefficients, size nsdgtreal_get_coeflen(p)
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_nsdgtreal_execute_d(ltfat_nsdgtreal_plan_d* p, const double f[],
+ *                           ltfat_complex_d c[]);
+ *
+ * ltfat_nsdgtreal_execute_s(ltfat_nsdgtreal_plan_s* p, const float f[],
+ *                           ltfat_complex_s c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arguments was NULL
+ * LTFATERR_BADARG          | \a p is an inverse plan
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_execute)(LTFAT_NAME(nsdgtreal_plan)* p,
+                              const LTFAT_REAL f[], LTFAT_COMPLEX c[]);
+
+/** Compute the non-stationary DGTREAL
+ *
+ * \param[in]   f   Input signal, size L x W
+ * \param[in]   g   Windows, size N
+ * \param[in]  gl   Window lengths, size N
+ * \param[in]   a   Time shifts, size N
+ * \param[in]   M   Numbers of frequency channels, size N
+ * \param[in]   N   Number of frames
+ * \param[in]   W   Number of signal channels
+ * \param[out]  c   Coefficients
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_nsdgtreal_d(const double f[], const double* g[], const ltfat_int gl[],
+ *                   const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                   ltfat_int W, ltfat_complex_d c[]);
+ *
+ * ltfat_nsdgtreal_s(const float f[], const float* g[], const ltfat_int gl[],
+ *                   const ltfat_int a[], const ltfat_int M[], ltfat_int N,
+ *                   ltfat_int W, ltfat_complex_s c[]);
+ * </tt>
+ * \returns Status code, see nsdgtreal_init
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal)(const LTFAT_REAL f[], const LTFAT_REAL* g[],
+                      const ltfat_int gl[], const ltfat_int a[],
+                      const ltfat_int M[], ltfat_int N, ltfat_int W,
+                      LTFAT_COMPLEX c[]);
+
+/** Initialize the inverse non-stationary DGTREAL plan
+ *
+ * \param[in]     gd   Synthesis windows, size N
+ * \param[in]     gl   Window lengths, size N
+ * \param[in]      a   Time shifts, size N
+ * \param[in]      M   Numbers of frequency channels, size N
+ * \param[in]      N   Number of frames
+ * \param[in]      W   Number of signal channels
+ * \param[in]  flags   FFTW planning flag
+ * \param[out]     p   Inverse non-stationary DGTREAL plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_insdgtreal_init_d(const double* gd[], const ltfat_int gl[],
+ *                         const ltfat_int a[], const ltfat_int M[],
+ *                         ltfat_int N, ltfat_int W, unsigned flags,
+ *                         ltfat_insdgtreal_plan_d** p);
+ *
+ * ltfat_insdgtreal_init_s(const float* gd[], const ltfat_int gl[],
+ *                         const ltfat_int a[], const ltfat_int M[],
+ *                         ltfat_int N, ltfat_int W, unsigned flags,
+ *                         ltfat_insdgtreal_plan_s** p);
+ * </tt>
+ * \returns Status code, see nsdgtreal_init
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal_init)(const LTFAT_REAL* gd[], const ltfat_int gl[],
+                            const ltfat_int a[], const ltfat_int M[],
+                            ltfat_int N, ltfat_int W, unsigned flags,
+                            LTFAT_NAME(insdgtreal_plan)** p);
+
+/** Execute the inverse non-stationary DGTREAL plan
+ *
+ * \param[in]   p   Inverse non-stationary DGTREAL plan
+ * \param[in]   c   Coefficients, size nsdgtreal_get_coeflen(p)
+ * \param[out]  f   Output signal, size L x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_insdgtreal_execute_d(ltfat_insdgtreal_plan_d* p, const ltfat_complex_d c[],
+ *                            double f[]);
+ *
+ * ltfat_insdgtreal_execute_s(ltfat_insdgtreal_plan_s* p, const ltfat_complex_s c[],
+ *                            float f[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arguments was NULL
+ * LTFATERR_BADARG          | \a p is a forward plan
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal_execute)(LTFAT_NAME(insdgtreal_plan)* p,
+                               const LTFAT_COMPLEX c[], LTFAT_REAL f[]);
+
+/** Compute the inverse non-stationary DGTREAL
+ *
+ * \param[in]   c   Coefficients
+ * \param[in]  gd   Synthesis windows, size N
+ * \param[in]  gl   Window lengths, size N
+ * \param[in]   a   Time shifts, size N
+ * \param[in]   M   Numbers of frequency channels, size N
+ * \param[in]   N   Number of frames
+ * \param[in]   W   Number of signal channels
+ * \param[out]  f   Output signal, size L x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_insdgtreal_d(const ltfat_complex_d c[], const double* gd[],
+ *                    const ltfat_int gl[], const ltfat_int a[],
+ *                    const ltfat_int M[], ltfat_int N, ltfat_int W, double f[]);
+ *
+ * ltfat_insdgtreal_s(const ltfat_complex_s c[], const float* gd[],
+ *                    const ltfat_int gl[], const ltfat_int a[],
+ *                    const ltfat_int M[], ltfat_int N, ltfat_int W, float f[]);
+ * </tt>
+ * \returns Status code, see nsdgtreal_init
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal)(const LTFAT_COMPLEX c[], const LTFAT_REAL* gd[],
+                       const ltfat_int gl[], const ltfat_int a[],
+                       const ltfat_int M[], ltfat_int N, ltfat_int W,
+                       LTFAT_REAL f[]);
+
+/** Set number of threads used by the execute functions
+ *
+ * Frames and channels are processed in parallel if libltfat was compiled
+ * with OpenMP. It has no effect otherwise. The default is 1.
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_set_nthreads)(LTFAT_NAME(nsdgtreal_plan)* p,
+                                   ltfat_int nthreads);
+
+/** Signal length L = sum(a)
+ *
+ * \returns Signal length or a negative status code
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(nsdgtreal_get_L)(LTFAT_NAME(nsdgtreal_plan)* p);
+
+/** Total length of the coefficient array
+ *
+ * \returns W*sum(M/2+1) or a negative status code
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(nsdgtreal_get_coeflen)(LTFAT_NAME(nsdgtreal_plan)* p);
+
+/** Destroy the non-stationary DGTREAL plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_nsdgtreal_done_d(ltfat_nsdgtreal_plan_d** p);
+ *
+ * ltfat_nsdgtreal_done_s(ltfat_nsdgtreal_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_done)(LTFAT_NAME(nsdgtreal_plan)** p);
+
+/** Destroy the inverse non-stationary DGTREAL plan
+ *
+ * \returns Status code, see nsdgtreal_done
+ */
+LTFAT_API int
+LTFAT_NAME(insdgtreal_done)(LTFAT_NAME(insdgtreal_plan)** p);
+
+/** Canonical dual windows in the painless case
+ *
+ * The painless case means M[n] >= gl[n] for all n. The frame operator
+ * is then a multiplication by d(x) = sum_n M[n]*|g_n(x - timepos[n])|^2.
+ *
+ * \param[in]   g   Windows, size N
+ * \param[in]  gl   Window lengths, size N
+ * \param[in]   a   Time shifts, size N
+ * \param[in]   M   Numbers of frequency channels, size N
+ * \param[in]   N   Number of frames
+ * \param[out] gd   Dual windows, gd[n] has length gl[n]
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_nsgabdual_painless_d(const double* g[], const ltfat_int gl[],
+ *                            const ltfat_int a[], const ltfat_int M[],
+ *                            ltfat_int N, double* gd[]);
+ *
+ * ltfat_nsgabdual_painless_s(const float* g[], const ltfat_int gl[],
+ *                            const ltfat_int a[], const ltfat_int M[],
+ *                            ltfat_int N, float* gd[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arrays was NULL
+ * LTFATERR_BADSIZE         | One of \a gl was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a N or one of \a a was less or equal to 0
+ * LTFATERR_NOTPAINLESS     | M[n] < gl[n] for some n
+ * LTFATERR_NOTAFRAME       | The windows do not cover the whole signal
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(nsgabdual_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                               const ltfat_int a[], const ltfat_int M[],
+                               ltfat_int N, LTFAT_REAL* gd[]);
+
+/** Canonical tight windows in the painless case
+ *
+ * \param[in]   g   Windows, size N
+ * \param[in]  gl   Window lengths, size N
+ * \param[in]   a   Time shifts, size N
+ * \param[in]   M   Numbers of frequency channels, size N
+ * \param[in]   N   Number of frames
+ * \param[out] gt   Tight windows, gt[n] has length gl[n]
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_nsgabtight_painless_d(const double* g[], const ltfat_int gl[],
+ *                             const ltfat_int a[], const ltfat_int M[],
+ *                             ltfat_int N, double* gt[]);
+ *
+ * ltfat_nsgabtight_painless_s(const float* g[], const ltfat_int gl[],
+ *                             const ltfat_int a[], const ltfat_int M[],
+ *                             ltfat_int N, float* gt[]);
+ * </tt>
+ * \returns Status code, see nsgabdual_painless
+ */
+LTFAT_API int
+LTFAT_NAME(nsgabtight_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                                const ltfat_int a[], const ltfat_int M[],
+                                ltfat_int N, LTFAT_REAL* gt[]);
+
+/** @} */
@@ -0,0 +1,210 @@
+#ifndef _LTFAT_QUADTFDIST_H
+#define _LTFAT_QUADTFDIST_H
+
+typedef enum
+{
+    LTFAT_WIGNERVILLE,
+    LTFAT_RIHACZEK,
+    LTFAT_AMBIGUITY
+} ltfat_quadtfdist_type;
+
+#endif /* _LTFAT_QUADTFDIST_H */
+
+typedef struct LTFAT_NAME(quadtfdist_plan) LTFAT_NAME(quadtfdist_plan);
+
+/** \defgroup quadtfdist Quadratic time-frequency distributions
+ *  \addtogroup quadtfdist
+ * @{
+ *
+ * The distributions are L x L arrays computed one slice at a time so that
+ * only a tile of slices is held in memory. Each tile is passed to the
+ * callback which can e.g. write it to disk.
+ *
+ * Type                | Slice      | Definition
+ * --------------------|------------|-----------------------------------------
+ * LTFAT_WIGNERVILLE   | time l     | DFT over the lags of the instantaneous correlation at time l (wignervilledist)
+ * LTFAT_RIHACZEK      | time n     | f(n)*conj(fft(g)(m))*exp(-2*pi*i*m*n/L) (drihaczekdist)
+ * LTFAT_AMBIGUITY     | lag row i  | row i of fftshift(fft2(fft(R))) (ambiguityfunction)
+ *
+ * The Wigner-Ville and Rihaczek slices are the columns of the distribution
+ * (frequency is the fast index). The ambiguity function slices are its
+ * rows, i.e. the tiles hold the transposed ambiguity function with the
+ * Doppler shift as the fast index.
+ */
+
+/** Tile callback
+ *
+ * \param[in]  userdata   User defined data
+ * \param[in]      tile   Slices start, ..., start + len - 1, size L x len
+ * \param[in]         L   Length of the slices
+ * \param[in]     start   Index of the first slice
+ * \param[in]       len   Number of slices in the tile
+ *
+ *  #### Function versions #
+ *  <tt>
+ *  typedef void ltfat_quadtfdist_callback_d(void* userdata, const ltfat_complex_d tile[],
+ *                                           ltfat_int L, ltfat_int start, ltfat_int len);
+ *
+ *  typedef void ltfat_quadtfdist_callback_s(void* userdata, const ltfat_complex_s tile[],
+ *                                           ltfat_int L, ltfat_int start, ltfat_int len);
+ *  </tt>
+ */
+typedef void LTFAT_NAME(quadtfdist_callback)(void* userdata,
+        const LTFAT_COMPLEX tile[], ltfat_int L, ltfat_int start, ltfat_int len);
+
+/** Initialize the quadratic time-frequency distribution plan
+ *
+ * The memory used by the plan is O(L*tilelen).
+ *
+ * \param[in]        L   Signal length
+ * \param[in]     type   Distribution type
+ * \param[in]  tilelen   Number of slices per tile
+ * \param[in]    flags   FFTW planning flag
+ * \param[out]       p   Distribution plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_quadtfdist_init_d(ltfat_int L, ltfat_quadtfdist_type type, ltfat_int tilelen,
+ *                         unsigned flags, ltfat_quadtfdist_plan_d** p);
+ *
+ * ltfat_quadtfdist_init_s(ltfat_int L, ltfat_quadtfdist_type type, ltfat_int tilelen,
+ *                         unsigned flags, ltfat_quadtfdist_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a tilelen was less or equal to 0
+ * LTFATERR_BADARG          | \a type was not a valid value
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist_init)(ltfat_int L, ltfat_quadtfdist_type type,
+                            ltfat_int tilelen, unsigned flags,
+                            LTFAT_NAME(quadtfdist_plan)** p);
+
+/** Set the tile callback
+ *
+ * \param[in]        p   Distribution plan
+ * \param[in] callback   Callback, can be NULL
+ * \param[in] userdata   User defined data passed to the callback
+ *
+ * \returns Status code
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist_setcallback)(LTFAT_NAME(quadtfdist_plan)* p,
+                                   LTFAT_NAME(quadtfdist_callback)* callback,
+                                   void* userdata);
+
+/** Set number of threads used for computing the slices of a tile
+ *
+ * Every thread gets its own FFT plan and scratch buffers so this function
+ * allocates. It has no effect if libltfat was compiled without OpenMP.
+ * The default is 1.
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist_set_nthreads)(LTFAT_NAME(quadtfdist_plan)* p,
+                                    ltfat_int nthreads);
+
+/** Compute the distribution of complex signals
+ *
+ * If \a g is NULL, the auto-distribution of \a f is computed, otherwise
+ * the cross-distribution of \a f and \a g. The auto Wigner-Ville
+ * distribution is real.
+ *
+ * \param[in]   p   Distribution plan
+ * \param[in]   f   Signal, size L
+ * \param[in]   g   Second signal, size L, or NULL
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_quadtfdist_execute_d(ltfat_quadtfdist_plan_d* p, const ltfat_complex_d f[],
+ *                            const ltfat_complex_d g[]);
+ *
+ * ltfat_quadtfdist_execute_s(ltfat_quadtfdist_plan_s* p, const ltfat_complex_s f[],
+ *                            const ltfat_complex_s g[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a f was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist_execute)(LTFAT_NAME(quadtfdist_plan)* p,
+                               const LTFAT_COMPLEX f[], const LTFAT_COMPLEX g[]);
+
+/** Compute the distribution of real signals
+ *
+ * As in wignervilledist and ambiguityfunction, the Wigner-Ville
+ * distribution and the ambiguity function are computed from the analytic
+ * signals. The Rihaczek distribution uses the signals directly as
+ * drihaczekdist does.
+ *
+ * \param[in]   p   Distribution plan
+ * \param[in]   f   Signal, size L
+ * \param[in]   g   Second signal, size L, or NULL
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_quadtfdist_execute_real_d(ltfat_quadtfdist_plan_d* p, const double f[],
+ *                                 const double g[]);
+ *
+ * ltfat_quadtfdist_execute_real_s(ltfat_quadtfdist_plan_s* p, const float f[],
+ *                                 const float g[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a f was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist_execute_real)(LTFAT_NAME(quadtfdist_plan)* p,
+                                    const LTFAT_REAL f[], const LTFAT_REAL g[]);
+
+/** Destroy the distribution plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist_done)(LTFAT_NAME(quadtfdist_plan)** p);
+
+/** Compute the whole distribution
+ *
+ * \param[in]     f   Signal, size L
+ * \param[in]     g   Second signal, size L, or NULL
+ * \param[in]     L   Signal length
+ * \param[in]  type   Distribution type
+ * \param[out]  out   Slices of the distribution, size L x L
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_quadtfdist_d(const ltfat_complex_d f[], const ltfat_complex_d g[], ltfat_int L,
+ *                    ltfat_quadtfdist_type type, ltfat_complex_d out[]);
+ *
+ * ltfat_quadtfdist_s(const ltfat_complex_s f[], const ltfat_complex_s g[], ltfat_int L,
+ *                    ltfat_quadtfdist_type type, ltfat_complex_s out[]);
+ * </tt>
+ * \returns Status code, see quadtfdist_init
+ */
+LTFAT_API int
+LTFAT_NAME(quadtfdist)(const LTFAT_COMPLEX f[], const LTFAT_COMPLEX g[],
+                       ltfat_int L, ltfat_quadtfdist_type type,
+                       LTFAT_COMPLEX out[]);
+
+/** @} */
@@ -6,7 +6,8 @@
 typedef enum
 {
     REASS_DEFAULT          = 0,
-    REASS_NOTIMEWRAPAROUND = 1
+    REASS_NOTIMEWRAPAROUND = 1,
+    REASS_KEEPREPOS        = 2  //!< filterbankphasereassign only, keep repos
 } fbreassHints;
 
 typedef struct {
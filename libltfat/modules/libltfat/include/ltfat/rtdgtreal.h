@@ -155,6 +155,23 @@ typedef struct LTFAT_NAME(rtdgtreal_processor_state) LTFAT_NAME(rtdgtreal_proces
 typedef void LTFAT_NAME(rtdgtreal_processor_callback)(void* userdata,
         const LTFAT_COMPLEX in[], int M2, int W, LTFAT_COMPLEX out[]);
 
+/** Frame activity callback signature
+ *
+ * The callback is called with the processor userdata before every frame.
+ * If it returns 0, the frame is neither transformed nor passed to the
+ * processor callback and it contributes zeros to the output.
+ *
+ * \param[in]  userdata   User defined data, the same as for the processor callback
+ *
+ *  #### Function versions #
+ *  <tt>
+ *  typedef int ltfat_rtdgtreal_processor_activity_d(void* userdata);
+ *
+ *  typedef int ltfat_rtdgtreal_processor_activity_s(void* userdata);
+ *  </tt>
+ */
+typedef int LTFAT_NAME(rtdgtreal_processor_activity)(void* userdata);
+
 /** Create DGTREAL processor state struct
  *
  * The processor wraps DGTREAL analysis-modify-synthesis loop suitable for
@@ -389,6 +406,29 @@ LTFAT_NAME(rtdgtreal_processor_setcallback)(LTFAT_NAME(rtdgtreal_processor_state
         LTFAT_NAME(rtdgtreal_processor_callback)* callback,
         void* userdata);
 
+/** Set DGTREAL processor frame activity callback
+ *
+ * The activity callback gets the userdata passed to
+ * rtdgtreal_processor_setcallback. Pass NULL to process all frames.
+ * This is not thread safe, see rtdgtreal_processor_setcallback.
+ *
+ * \param[in]            p   DGTREAL processor state
+ * \param[in]     activity   Frame activity callback or NULL
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_rtdgtreal_processor_setactivitycallback_d(ltfat_rtdgtreal_processor_state_d* p,
+ *                                                 ltfat_rtdgtreal_processor_activity_d* activity);
+ *
+ * ltfat_rtdgtreal_processor_setactivitycallback_s(ltfat_rtdgtreal_processor_state_s* p,
+ *                                                 ltfat_rtdgtreal_processor_activity_s* activity);
+ * </tt>
+ */
+LTFAT_API int
+LTFAT_NAME(rtdgtreal_processor_setactivitycallback)(
+    LTFAT_NAME(rtdgtreal_processor_state)* p,
+    LTFAT_NAME(rtdgtreal_processor_activity)* activity);
+
 /** Default processor callback
  *
  * The callback just copies data from input to the output.
@@ -0,0 +1,257 @@
+typedef struct LTFAT_NAME(spreadop_plan) LTFAT_NAME(spreadop_plan);
+
+/** \defgroup spreadop Spreading operators
+ *  \addtogroup spreadop
+ * @{
+ *
+ * The spreading operator with the L x L spreading function coef is
+ *
+ * h(l) = sum_{m,n} coef(m,n) exp(2*pi*i*m*l/L) f(l-n)
+ *
+ * i.e. the row index m is the modulation and the column index n is the
+ * translation, as in spreadop.m. The plan keeps either the dense form
+ * L*ifft(coef), which is what spreadop.m computes column by column, or
+ * the list of the nonzero elements. Both forms are applied directly in
+ * O(L^2 W) and O(nnz L W) operations respectively and all channels are
+ * processed while a column of the spreading function is in cache.
+ *
+ * The adjoint operator is applied by the same plan without forming its
+ * spreading function. spreadadj and spreadadj_sparse compute the
+ * spreading function of the adjoint explicitly using the closed formula
+ * of spreadadj.m.
+ */
+
+/** Initialize the spreading operator plan
+ *
+ * The spreading function is initially zero.
+ *
+ * \param[in]      L   Signal length
+ * \param[in]  flags   FFTW planning flag
+ * \param[out]     p   Spreading operator plan
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_spreadop_init_d(ltfat_int L, unsigned flags, ltfat_spreadop_plan_d** p);
+ *
+ * ltfat_spreadop_init_s(ltfat_int L, unsigned flags, ltfat_spreadop_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_init)(ltfat_int L, unsigned flags,
+                          LTFAT_NAME(spreadop_plan)** p);
+
+/** Set a dense spreading function
+ *
+ * As in spreadop.m, the sparse form is used if the number of the nonzero
+ * elements is less than L. Otherwise L*ifft(coef) is computed using an
+ * FFT plan which is created on the first call and reused afterwards.
+ *
+ * \param[in]      p   Spreading operator plan
+ * \param[in]   coef   Spreading function, size L x L
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_spreadop_set_coef_d(ltfat_spreadop_plan_d* p, const ltfat_complex_d coef[]);
+ *
+ * ltfat_spreadop_set_coef_s(ltfat_spreadop_plan_s* p, const ltfat_complex_s coef[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a coef was NULL
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_set_coef)(LTFAT_NAME(spreadop_plan)* p,
+                              const LTFAT_COMPLEX coef[]);
+
+/** Set a sparse spreading function
+ *
+ * Element k is coef(row[k], col[k]) = val[k], indices are zero-based.
+ * Repeated indices are summed. As in spreadop.m, the dense form is used
+ * if \a nnz is not less than L.
+ *
+ * \param[in]      p   Spreading operator plan
+ * \param[in]    row   Row (modulation) indices, size nnz
+ * \param[in]    col   Column (translation) indices, size nnz
+ * \param[in]    val   Values, size nnz
+ * \param[in]    nnz   Number of the elements
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_spreadop_set_coef_sparse_d(ltfat_spreadop_plan_d* p, const ltfat_int row[],
+ *                                  const ltfat_int col[], const ltfat_complex_d val[],
+ *                                  ltfat_int nnz);
+ *
+ * ltfat_spreadop_set_coef_sparse_s(ltfat_spreadop_plan_s* p, const ltfat_int row[],
+ *                                  const ltfat_int col[], const ltfat_complex_s val[],
+ *                                  ltfat_int nnz);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL or one of the arrays was NULL and \a nnz was positive
+ * LTFATERR_BADSIZE         | \a nnz was negative
+ * LTFATERR_NOTINRANGE      | An index was out of range [0, L)
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_set_coef_sparse)(LTFAT_NAME(spreadop_plan)* p,
+                                     const ltfat_int row[], const ltfat_int col[],
+                                     const LTFAT_COMPLEX val[], ltfat_int nnz);
+
+/** Apply the operator
+ *
+ * \param[in]      p   Spreading operator plan
+ * \param[in]      f   Input signal, size L x W
+ * \param[in]      W   Number of channels
+ * \param[out]     h   Output signal, size L x W
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_spreadop_execute_d(ltfat_spreadop_plan_d* p, const ltfat_complex_d f[],
+ *                          ltfat_int W, ltfat_complex_d h[]);
+ *
+ * ltfat_spreadop_execute_s(ltfat_spreadop_plan_s* p, const ltfat_complex_s f[],
+ *                          ltfat_int W, ltfat_complex_s h[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a f or \a h was NULL
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0
+ * LTFATERR_BADARG          | \a f and \a h were the same array
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_execute)(LTFAT_NAME(spreadop_plan)* p,
+                             const LTFAT_COMPLEX f[], ltfat_int W,
+                             LTFAT_COMPLEX h[]);
+
+/** Apply the adjoint operator
+ *
+ * \returns Status code, see spreadop_execute
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_execute_adj)(LTFAT_NAME(spreadop_plan)* p,
+                                 const LTFAT_COMPLEX f[], ltfat_int W,
+                                 LTFAT_COMPLEX h[]);
+
+/** Factorize the operator for spreadop_execute_inv
+ *
+ * Forms the L x L operator matrix and computes its LU factorization
+ * with partial pivoting. This is O(L^3) and it must be called again
+ * whenever the spreading function changes.
+ *
+ * \param[in]      p   Spreading operator plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTAFRAME       | The operator is singular
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_prepare_inv)(LTFAT_NAME(spreadop_plan)* p);
+
+/** Apply the inverse operator
+ *
+ * This is spreadinv(f, coef). Each channel costs O(L^2). The function
+ * can run inplace.
+ *
+ * \param[in]      p   Spreading operator plan
+ * \param[in]      f   Input signal, size L x W
+ * \param[in]      W   Number of channels
+ * \param[out]     h   Output signal, size L x W
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p, \a f or \a h was NULL
+ * LTFATERR_NOTPOSARG       | \a W was less or equal to 0
+ * LTFATERR_BADARG          | spreadop_prepare_inv was not called for the current spreading function
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_execute_inv)(LTFAT_NAME(spreadop_plan)* p,
+                                 const LTFAT_COMPLEX f[], ltfat_int W,
+                                 LTFAT_COMPLEX h[]);
+
+/** Destroy the spreading operator plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(spreadop_done)(LTFAT_NAME(spreadop_plan)** p);
+
+/** Spreading function of the adjoint operator
+ *
+ * cadj(ii,jj) = conj(coef(-ii,-jj)) exp(-2*pi*i*ii*jj/L)
+ *
+ * \param[in]     coef   Spreading function, size L x L
+ * \param[in]        L   Signal length
+ * \param[out]    cadj   Spreading function of the adjoint, size L x L
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_spreadadj_d(const ltfat_complex_d coef[], ltfat_int L, ltfat_complex_d cadj[]);
+ *
+ * ltfat_spreadadj_s(const ltfat_complex_s coef[], ltfat_int L, ltfat_complex_s cadj[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a coef or \a cadj was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0
+ * LTFATERR_BADARG          | \a coef and \a cadj were the same array
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(spreadadj)(const LTFAT_COMPLEX coef[], ltfat_int L,
+                      LTFAT_COMPLEX cadj[]);
+
+/** Spreading function of the adjoint operator in the sparse form
+ *
+ * Maps every element of the sparse spreading function separately, the
+ * output arrays can be the same as the input arrays.
+ *
+ * #### Function versions #
+ * <tt>
+ * ltfat_spreadadj_sparse_d(const ltfat_int row[], const ltfat_int col[],
+ *                          const ltfat_complex_d val[], ltfat_int nnz, ltfat_int L,
+ *                          ltfat_int rowadj[], ltfat_int coladj[], ltfat_complex_d valadj[]);
+ *
+ * ltfat_spreadadj_sparse_s(const ltfat_int row[], const ltfat_int col[],
+ *                          const ltfat_complex_s val[], ltfat_int nnz, ltfat_int L,
+ *                          ltfat_int rowadj[], ltfat_int coladj[], ltfat_complex_s valadj[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arrays was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0 or \a nnz was negative
+ */
+LTFAT_API int
+LTFAT_NAME(spreadadj_sparse)(const ltfat_int row[], const ltfat_int col[],
+                             const LTFAT_COMPLEX val[], ltfat_int nnz,
+                             ltfat_int L, ltfat_int rowadj[],
+                             ltfat_int coladj[], LTFAT_COMPLEX valadj[]);
+
+/** @} */
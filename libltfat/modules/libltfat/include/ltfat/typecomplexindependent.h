@@ -5,6 +5,7 @@
 #include "dgt_fb.h"
 #include "idgt_fb.h"
 #include "wavelets.h"
+#include "wfbt.h"
 #include "goertzel.h"
 #include "ciutils.h"
 #include "gabdual_painless.h"
@@ -13,6 +14,7 @@
 #include "dst.h"
 #include "ci_memalloc.h"
 #include "dgtwrapper.h"
+#include "ci_pfilt.h"
 
 /*   Walnut factorization    */
 
@@ -30,6 +32,37 @@ LTFAT_API int
 LTFAT_NAME(wfac_execute)(LTFAT_NAME(wfac_plan)* plan, const LTFAT_TYPE *g,
                          ltfat_int R, LTFAT_COMPLEX *gf);
 
+/** Set number of threads used by wfac_execute
+ *
+ * The c*p*q*R independent length d FFTs are split among the threads.
+ * Every thread gets its own FFT plan and buffer, so this function
+ * reallocates them whenever \a nthreads changes. It has no effect if
+ * libltfat was compiled without OpenMP.
+ *
+ * The one-shot wfac uses the default number of OpenMP threads.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfac_set_nthreads_d(ltfat_wfac_plan_d* p, ltfat_int nthreads);
+ *
+ * ltfat_wfac_set_nthreads_s(ltfat_wfac_plan_s* p, ltfat_int nthreads);
+ *
+ * ltfat_wfac_set_nthreads_dc(ltfat_wfac_plan_dc* p, ltfat_int nthreads);
+ *
+ * ltfat_wfac_set_nthreads_sc(ltfat_wfac_plan_sc* p, ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_INITFAILED      | The FFT plan creation failed.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(wfac_set_nthreads)(LTFAT_NAME(wfac_plan)* p, ltfat_int nthreads);
+
 LTFAT_API int
 LTFAT_NAME(wfac_done)(LTFAT_NAME(wfac_plan)** plan);
 
@@ -49,6 +82,37 @@ LTFAT_API int
 LTFAT_NAME(iwfac_execute)(LTFAT_NAME(iwfac_plan)* plan, const LTFAT_COMPLEX* gf,
                           ltfat_int R, LTFAT_TYPE* g);
 
+/** Set number of threads used by iwfac_execute
+ *
+ * The c*p*q*R independent length d inverse FFTs are split among the
+ * threads. Every thread gets its own FFT plan and buffer, so this
+ * function reallocates them whenever \a nthreads changes. It has no
+ * effect if libltfat was compiled without OpenMP.
+ *
+ * The one-shot iwfac uses the default number of OpenMP threads.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_iwfac_set_nthreads_d(ltfat_iwfac_plan_d* p, ltfat_int nthreads);
+ *
+ * ltfat_iwfac_set_nthreads_s(ltfat_iwfac_plan_s* p, ltfat_int nthreads);
+ *
+ * ltfat_iwfac_set_nthreads_dc(ltfat_iwfac_plan_dc* p, ltfat_int nthreads);
+ *
+ * ltfat_iwfac_set_nthreads_sc(ltfat_iwfac_plan_sc* p, ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ * LTFATERR_INITFAILED      | The FFT plan creation failed.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(iwfac_set_nthreads)(LTFAT_NAME(iwfac_plan)* p, ltfat_int nthreads);
+
 LTFAT_API int
 LTFAT_NAME(iwfac_done)(LTFAT_NAME(iwfac_plan)** plan);
 
@@ -63,9 +127,6 @@ LTFAT_NAME(col2diag)(const LTFAT_TYPE *cin, ltfat_int L,
  * might no longer be exact canonical dual window if gdl is smaller than the
  * length of the support of the window.
  *
- * \warning This function is not available if libltfat has been compiled with
- * NOBLASLAPACK.
- *
  * \param[in]    g    Original window
  * \param[in]   gl    Length of the window
  * \param[in]    L    Length of the system
@@ -115,9 +176,6 @@ LTFAT_NAME(gabdual_fir)(const LTFAT_TYPE g[], ltfat_int gl,
  * might no longer be exact canonical tight window if gdl is smaller than the
  * length of the support of the window.
  *
- * \warning This function is not available if libltfat has been compiled with
- * NOBLASLAPACK.
- *
  * \param[in]    g    Original window, size gl x 1
  * \param[in]   gl    Length of the window
  * \param[in]    L    Length of the system
@@ -261,3 +319,198 @@ LTFAT_NAME(filterbankreassign)(const LTFAT_TYPE*     s[],
                                LTFAT_TYPE*          sr[],
                                fbreassHints        hints,
                                fbreassOptOut*      repos);
+
+typedef struct LTFAT_NAME(gabreassign_plan) LTFAT_NAME(gabreassign_plan);
+typedef struct LTFAT_NAME(filterbankreassign_plan) LTFAT_NAME(filterbankreassign_plan);
+
+/** Initialize plan for reassignment of Gabor coefficients
+ *
+ * The plan precomputes the index tables and, if \a nthreads > 1 and the
+ * library was compiled with OpenMP, distributes the coefficient columns among
+ * the threads. Each thread accumulates into its own output tile and the tiles
+ * are summed at the end. Without OpenMP, \a nthreads is ignored.
+ *
+ * \param[in]        L   Signal length
+ * \param[in]        W   Number of channels
+ * \param[in]        a   Hop factor
+ * \param[in]        M   Number of frequency channels
+ * \param[in] nthreads   Number of threads
+ * \param[out]       p   Reassignment plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gabreassign_init_d(ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                          ltfat_int nthreads, ltfat_gabreassign_plan_d** p);
+ *
+ * ltfat_gabreassign_init_s(ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                          ltfat_int nthreads, ltfat_gabreassign_plan_s** p);
+ *
+ * ltfat_gabreassign_init_dc(ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                           ltfat_int nthreads, ltfat_gabreassign_plan_dc** p);
+ *
+ * ltfat_gabreassign_init_sc(ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+ *                           ltfat_int nthreads, ltfat_gabreassign_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_BADSIZE         | \a L was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | At least one of \a W, \a a, \a M, \a nthreads was less or equal to 0.
+ * LTFATERR_BADTRALEN       | \a L is not divisible by both \a a and \a M
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(gabreassign_init)(ltfat_int L, ltfat_int W, ltfat_int a,
+                             ltfat_int M, ltfat_int nthreads,
+                             LTFAT_NAME(gabreassign_plan)** p);
+
+/** Execute reassignment plan
+ *
+ * \param[in]         p   Reassignment plan
+ * \param[in]         s   Coefficients to be reassigned, size M x N x W
+ * \param[in]     tgrad   Time gradient (relative instantaneous frequency), size M x N x W
+ * \param[in]     fgrad   Frequency gradient (local group delay), size M x N x W
+ * \param[out]       sr   Reassigned coefficients, size M x N x W
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gabreassign_execute_d(ltfat_gabreassign_plan_d* p, const double s[],
+ *                             const double tgrad[], const double fgrad[],
+ *                             double sr[]);
+ *
+ * ltfat_gabreassign_execute_s(ltfat_gabreassign_plan_s* p, const float s[],
+ *                             const float tgrad[], const float fgrad[],
+ *                             float sr[]);
+ *
+ * ltfat_gabreassign_execute_dc(ltfat_gabreassign_plan_dc* p, const ltfat_complex_d s[],
+ *                              const double tgrad[], const double fgrad[],
+ *                              ltfat_complex_d sr[]);
+ *
+ * ltfat_gabreassign_execute_sc(ltfat_gabreassign_plan_sc* p, const ltfat_complex_s s[],
+ *                              const float tgrad[], const float fgrad[],
+ *                              ltfat_complex_s sr[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ * LTFATERR_NOMEM           | Growing the output tiles failed
+ */
+LTFAT_API int
+LTFAT_NAME(gabreassign_execute)(LTFAT_NAME(gabreassign_plan)* p,
+                                const LTFAT_TYPE s[], const LTFAT_REAL tgrad[],
+                                const LTFAT_REAL fgrad[], LTFAT_TYPE sr[]);
+
+/** Destroy reassignment plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_gabreassign_done_d(ltfat_gabreassign_plan_d** p);
+ *
+ * ltfat_gabreassign_done_s(ltfat_gabreassign_plan_s** p);
+ *
+ * ltfat_gabreassign_done_dc(ltfat_gabreassign_plan_dc** p);
+ *
+ * ltfat_gabreassign_done_sc(ltfat_gabreassign_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(gabreassign_done)(LTFAT_NAME(gabreassign_plan)** p);
+
+/** Initialize plan for reassignment of filterbank coefficients
+ *
+ * The target channel and position of every coefficient is computed
+ * for all channels at once, in parallel over channels if \a nthreads > 1
+ * and the library was compiled with OpenMP. The accumulation is serial,
+ * so the output does not depend on \a nthreads.
+ *
+ * \param[in]        N   Number of coefficients in each channel, size M
+ * \param[in]        a   Hop factors, size M
+ * \param[in]    cfreq   Center frequencies normalized to the Nyquist rate, size M
+ * \param[in]        M   Number of channels
+ * \param[in]    hints   Reassignment hints
+ * \param[in] nthreads   Number of threads
+ * \param[out]       p   Reassignment plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_filterbankreassign_init_d(const ltfat_int N[], const double a[],
+ *                                 const double cfreq[], ltfat_int M,
+ *                                 fbreassHints hints, ltfat_int nthreads,
+ *                                 ltfat_filterbankreassign_plan_d** p);
+ *
+ * ltfat_filterbankreassign_init_s(const ltfat_int N[], const double a[],
+ *                                 const double cfreq[], ltfat_int M,
+ *                                 fbreassHints hints, ltfat_int nthreads,
+ *                                 ltfat_filterbankreassign_plan_s** p);
+ * </tt>
+ * (and the complex versions with _dc and _sc suffixes)
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a N, \a a, \a cfreq, \a p
+ * LTFATERR_BADSIZE         | Some of \a N was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a M, \a nthreads or some of \a a was less or equal to 0.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankreassign_init)(const ltfat_int N[], const double a[],
+                                    const double cfreq[], ltfat_int M,
+                                    fbreassHints hints, ltfat_int nthreads,
+                                    LTFAT_NAME(filterbankreassign_plan)** p);
+
+/** Execute filterbank reassignment plan
+ *
+ * \param[in]         p   Reassignment plan
+ * \param[in]         s   Coefficients to be reassigned, M arrays of lengths N[m]
+ * \param[in]     tgrad   Time gradient, M arrays of lengths N[m]
+ * \param[in]     fgrad   Frequency gradient, M arrays of lengths N[m]
+ * \param[out]       sr   Reassigned coefficients, M arrays of lengths N[m]
+ * \param[out]    repos   Optional reassignment positions, can be NULL
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_filterbankreassign_execute_d(ltfat_filterbankreassign_plan_d* p,
+ *                                    const double* s[], const double* tgrad[],
+ *                                    const double* fgrad[], double* sr[],
+ *                                    fbreassOptOut* repos);
+ *
+ * ltfat_filterbankreassign_execute_s(ltfat_filterbankreassign_plan_s* p,
+ *                                    const float* s[], const float* tgrad[],
+ *                                    const float* fgrad[], float* sr[],
+ *                                    fbreassOptOut* repos);
+ * </tt>
+ * (and the complex versions with _dc and _sc suffixes)
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments except \a repos was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankreassign_execute)(LTFAT_NAME(filterbankreassign_plan)* p,
+                                       const LTFAT_TYPE* s[],
+                                       const LTFAT_REAL* tgrad[],
+                                       const LTFAT_REAL* fgrad[],
+                                       LTFAT_TYPE* sr[],
+                                       fbreassOptOut* repos);
+
+/** Destroy filterbank reassignment plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankreassign_done)(LTFAT_NAME(filterbankreassign_plan)** p);
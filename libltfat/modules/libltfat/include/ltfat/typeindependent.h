@@ -7,12 +7,21 @@
 #include "idgtreal_fb.h"
 #include "dgt_multi.h"
 #include "dgt_shear.h"
+#include "dgtreal_olastream.h"
+#include "dwilt.h"
 #include "tiutils.h"
 #include "circularbuf.h"
 #include "slicingbuf.h"
 #include "rtdgtreal.h"
+#include "fwt_processor.h"
+#include "nsdgtreal.h"
+#include "quadtfdist.h"
+#include "gabmulreal.h"
+#include "spreadop.h"
+#include "ifilterbank.h"
 #include "heap.h"
 #include "dgtrealwrapper.h"
+#include "dgtreal_lasso.h"
 #include "dgtrealmp.h"
 #include "slidgtrealmp.h"
 #include "linalg.h"
@@ -67,6 +76,11 @@ LTFAT_NAME(iwfacreal)(const LTFAT_COMPLEX *gf, ltfat_int L, ltfat_int R,
 
 /* --------- dual windows etc. --------------- */
 
+/* The factorizations consist of independent blocks which are split among
+ * the default number of OpenMP threads if libltfat was compiled with OpenMP.
+ * This also holds for wfacreal and iwfacreal. gabtight_fac and
+ * gabtightreal_fac return LTFATERR_FAILED if the SVD of a block fails. */
+
 LTFAT_API void
 LTFAT_NAME(gabdual_fac)(const LTFAT_COMPLEX *g, ltfat_int L, ltfat_int R,
                         ltfat_int a, ltfat_int M, LTFAT_COMPLEX *gdualf);
@@ -75,12 +89,12 @@ LTFAT_API void
 LTFAT_NAME(gabdualreal_fac)(const LTFAT_COMPLEX *g, ltfat_int L, ltfat_int R,
                             ltfat_int a, ltfat_int M, LTFAT_COMPLEX *gdualf);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(gabtight_fac)(const LTFAT_COMPLEX *gf, ltfat_int L, ltfat_int R,
                          ltfat_int a, ltfat_int M,
                          LTFAT_COMPLEX *gtightf);
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(gabtightreal_fac)(const LTFAT_COMPLEX *gf, ltfat_int L, ltfat_int R,
                              ltfat_int a, ltfat_int M,
                              LTFAT_COMPLEX *gtightf);
@@ -444,6 +458,148 @@ LTFAT_NAME(filterbankphasegrad)(const LTFAT_COMPLEX* c [],
                                 LTFAT_REAL*        fgrad[],
                                 LTFAT_REAL*           cs[]);
 
+typedef struct LTFAT_NAME(filterbankphasereassign_plan) LTFAT_NAME(filterbankphasereassign_plan);
+
+/** Initialize plan for the filterbank phase gradient and reassignment
+ *
+ * The plan computes the phase gradient (as filterbankphasegrad) from the
+ * coefficients c, ch and cd and reassigns the spectrogram (as
+ * filterbankreassign) in one go. The gradients, the spectrogram and the
+ * index tables are kept by the plan. If \a nthreads > 1 and the library was
+ * compiled with OpenMP, the channels are processed in parallel. The output
+ * does not depend on \a nthreads.
+ *
+ * With REASS_KEEPREPOS in \a hints, the plan also keeps the reassignment
+ * positions, see filterbankphasereassign_get_repos. All the memory is
+ * allocated here.
+ *
+ * \param[in]        N   Number of coefficients in each channel, size M
+ * \param[in]        a   Hop factors, size M
+ * \param[in]    cfreq   Center frequencies normalized to the Nyquist rate, size M
+ * \param[in]        M   Number of channels
+ * \param[in]        L   Signal length
+ * \param[in]   minlvl   Spectrogram floor relative to its maximum
+ * \param[in]    hints   Reassignment hints
+ * \param[in] nthreads   Number of threads
+ * \param[out]       p   Plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_filterbankphasereassign_init_d(const ltfat_int N[], const double a[],
+ *                                      const double cfreq[], ltfat_int M, ltfat_int L,
+ *                                      double minlvl, fbreassHints hints, ltfat_int nthreads,
+ *                                      ltfat_filterbankphasereassign_plan_d** p);
+ *
+ * ltfat_filterbankphasereassign_init_s(const ltfat_int N[], const double a[],
+ *                                      const double cfreq[], ltfat_int M, ltfat_int L,
+ *                                      double minlvl, fbreassHints hints, ltfat_int nthreads,
+ *                                      ltfat_filterbankphasereassign_plan_s** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the following was NULL: \a N, \a a, \a cfreq, \a p
+ * LTFATERR_BADTRALEN       | \a L was less or equal to 0
+ * LTFATERR_BADARG          | \a minlvl was not in range [0,1)
+ * LTFATERR_BADSIZE         | Some of \a N was less or equal to 0.
+ * LTFATERR_NOTPOSARG       | \a M, \a nthreads or some of \a a was less or equal to 0.
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_init)(const ltfat_int N[], const double a[],
+        const double cfreq[], ltfat_int M, ltfat_int L, double minlvl,
+        fbreassHints hints, ltfat_int nthreads,
+        LTFAT_NAME(filterbankphasereassign_plan)** p);
+
+/** Compute the phase gradient and the reassigned spectrogram
+ *
+ * \param[in]     p   Plan
+ * \param[in]     c   Coefficients, M arrays of lengths N[m]
+ * \param[in]    ch   Coefficients using the time-weighted filters, M arrays of lengths N[m]
+ * \param[in]    cd   Coefficients using the derivative filters, M arrays of lengths N[m]
+ * \param[out]   sr   Reassigned spectrogram, M arrays of lengths N[m]
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_filterbankphasereassign_execute_d(ltfat_filterbankphasereassign_plan_d* p,
+ *                                         const ltfat_complex_d* c[],
+ *                                         const ltfat_complex_d* ch[],
+ *                                         const ltfat_complex_d* cd[], double* sr[]);
+ *
+ * ltfat_filterbankphasereassign_execute_s(ltfat_filterbankphasereassign_plan_s* p,
+ *                                         const ltfat_complex_s* c[],
+ *                                         const ltfat_complex_s* ch[],
+ *                                         const ltfat_complex_s* cd[], float* sr[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_execute)(
+    LTFAT_NAME(filterbankphasereassign_plan)* p,
+    const LTFAT_COMPLEX* c[], const LTFAT_COMPLEX* ch[],
+    const LTFAT_COMPLEX* cd[], LTFAT_REAL* sr[]);
+
+/** Get the phase gradient and the spectrogram from the last execute
+ *
+ * Fills M pointers to the arrays owned by the plan. They stay valid until
+ * the plan is destroyed and they are overwritten by the next execute.
+ *
+ * \param[in]      p   Plan
+ * \param[out] tgrad   Time gradient, M pointers, can be NULL
+ * \param[out] fgrad   Frequency gradient, M pointers, can be NULL
+ * \param[out]    cs   Spectrogram with the floor applied, M pointers, can be NULL
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_get_phasegrad)(
+    LTFAT_NAME(filterbankphasereassign_plan)* p,
+    const LTFAT_REAL* tgrad[], const LTFAT_REAL* fgrad[], const LTFAT_REAL* cs[]);
+
+/** Get the reassignment positions from the last execute
+ *
+ * The coefficients are indexed consecutively over all channels, i.e.
+ * coefficient n in channel m has index sum(N[0..m-1]) + n. The coefficients
+ * moved to position k are repos[reposstart[k]], ..., repos[reposstart[k+1]-1]
+ * in the same order as in the fbreassOptOut output of filterbankreassign.
+ *
+ * \param[in]           p   Plan
+ * \param[out] reposstart   Start of each list, sum(N) + 1
+ * \param[out]      repos   Lists of the coefficient indices, sum(N)
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | At least one of the arguments was NULL
+ * LTFATERR_BADARG          | The plan was not initialized with REASS_KEEPREPOS
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_get_repos)(
+    LTFAT_NAME(filterbankphasereassign_plan)* p,
+    const ltfat_int** reposstart, const ltfat_int** repos);
+
+/** Destroy the plan
+ *
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_done)(
+    LTFAT_NAME(filterbankphasereassign_plan)** p);
+
 
 /* ----- internal routines for calling BLAS and LAPACK ----- */
 
@@ -0,0 +1,186 @@
+typedef struct LTFAT_NAME(wfbt_plan) LTFAT_NAME(wfbt_plan);
+
+/** \defgroup wfbt Wavelet filterbank tree
+ *  \addtogroup wfbt
+ * @{
+ *
+ * The tree is described by arrays of nodes and filters. Node k has M[k]
+ * filters and the filters of all nodes are stored one after the other,
+ * node 0 (the root) first. Each filter is a time-domain convolution
+ * followed by subsampling (see convsub_td). Its output either feeds another
+ * node (\a child[m] >= 0), goes to the output (\a outidx[m] >= 0) or both
+ * (wavelet packets). A child must have a higher index than its parent.
+ *
+ * Example: 2-level DWT with lowpass h and highpass g
+ * <tt>
+ * nodes  = 2, M = {2, 2}
+ * g      = {h, g, h, g}
+ * child  = {1, -1, -1, -1}
+ * outidx = {-1, 2, 0, 1}  // c = {a2, d2, d1}
+ * </tt>
+ */
+
+/** Initialize a wavelet filterbank tree plan
+ *
+ * All node filters, buffer sizes and the output lengths are computed
+ * here. The plan owns a single arena holding the input of every node for
+ * every channel. Node outputs are written directly to the input of the
+ * child nodes and no allocation is done in wfbt_execute.
+ *
+ * \param[in]   nodes  Number of nodes
+ * \param[in]       M  Number of filters of each node, size nodes
+ * \param[in]       g  Filters, size sum(M)
+ * \param[in]      gl  Filter lengths, size sum(M)
+ * \param[in]       a  Subsampling factors, size sum(M)
+ * \param[in]  offset  Filter offsets, -gl[m] < offset[m] <= 0, size sum(M)
+ * \param[in]   child  Node the filter output is passed to or -1, size sum(M)
+ * \param[in]  outidx  Output the filter output is written to or -1, size sum(M)
+ * \param[in]       L  Signal length
+ * \param[in]       W  Number of channels
+ * \param[in]     ext  Boundary extension type
+ * \param[out]      p  Wavelet filterbank tree plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_init_d(ltfat_int nodes, const ltfat_int M[], const double* g[],
+ *                   const ltfat_int gl[], const ltfat_int a[],
+ *                   const ltfat_int offset[], const ltfat_int child[],
+ *                   const ltfat_int outidx[], ltfat_int L, ltfat_int W,
+ *                   ltfatExtType ext, ltfat_wfbt_plan_d** p);
+ *
+ * ltfat_wfbt_init_s(ltfat_int nodes, const ltfat_int M[], const float* g[],
+ *                   const ltfat_int gl[], const ltfat_int a[],
+ *                   const ltfat_int offset[], const ltfat_int child[],
+ *                   const ltfat_int outidx[], ltfat_int L, ltfat_int W,
+ *                   ltfatExtType ext, ltfat_wfbt_plan_s** p);
+ *
+ * ltfat_wfbt_init_dc(ltfat_int nodes, const ltfat_int M[],
+ *                    const ltfat_complex_d* g[], const ltfat_int gl[],
+ *                    const ltfat_int a[], const ltfat_int offset[],
+ *                    const ltfat_int child[], const ltfat_int outidx[],
+ *                    ltfat_int L, ltfat_int W, ltfatExtType ext,
+ *                    ltfat_wfbt_plan_dc** p);
+ *
+ * ltfat_wfbt_init_sc(ltfat_int nodes, const ltfat_int M[],
+ *                    const ltfat_complex_s* g[], const ltfat_int gl[],
+ *                    const ltfat_int a[], const ltfat_int offset[],
+ *                    const ltfat_int child[], const ltfat_int outidx[],
+ *                    ltfat_int L, ltfat_int W, ltfatExtType ext,
+ *                    ltfat_wfbt_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arrays was NULL
+ * LTFATERR_BADSIZE         | \a L or one of \a gl was less or equal to 0
+ * LTFATERR_NOTPOSARG       | \a nodes, \a W or one of \a M, \a a was less or equal to 0
+ * LTFATERR_BADARG          | Invalid offset, extension type or tree structure
+ * LTFATERR_BADREQSIZE      | A filter would produce no output
+ * LTFATERR_NOMEM           | Indicates that heap allocation failed
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_init)(ltfat_int nodes, const ltfat_int M[],
+                      const LTFAT_TYPE* g[], const ltfat_int gl[],
+                      const ltfat_int a[], const ltfat_int offset[],
+                      const ltfat_int child[], const ltfat_int outidx[],
+                      ltfat_int L, ltfat_int W, ltfatExtType ext,
+                      LTFAT_NAME(wfbt_plan)** p);
+
+/** Execute the wavelet filterbank tree
+ *
+ * Nodes at the same depth and the channels are processed in parallel
+ * if libltfat was compiled with OpenMP, see wfbt_set_nthreads.
+ *
+ * \param[in]   p  Wavelet filterbank tree plan
+ * \param[in]   f  Input signal, size L x W
+ * \param[out]  c  Output subbands, c[k] has size Lc[k] x W, see wfbt_get_outlens
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_execute_d(ltfat_wfbt_plan_d* p, const double f[], double* c[]);
+ *
+ * ltfat_wfbt_execute_s(ltfat_wfbt_plan_s* p, const float f[], float* c[]);
+ *
+ * ltfat_wfbt_execute_dc(ltfat_wfbt_plan_dc* p, const ltfat_complex_d f[],
+ *                       ltfat_complex_d* c[]);
+ *
+ * ltfat_wfbt_execute_sc(ltfat_wfbt_plan_sc* p, const ltfat_complex_s f[],
+ *                       ltfat_complex_s* c[]);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | One of the arguments was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_execute)(LTFAT_NAME(wfbt_plan)* p, const LTFAT_TYPE f[],
+                         LTFAT_TYPE* c[]);
+
+/** Set number of threads used by wfbt_execute
+ *
+ * It has no effect if libltfat was compiled without OpenMP. The default
+ * is 1.
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_set_nthreads_d(ltfat_wfbt_plan_d* p, ltfat_int nthreads);
+ *
+ * ltfat_wfbt_set_nthreads_s(ltfat_wfbt_plan_s* p, ltfat_int nthreads);
+ *
+ * ltfat_wfbt_set_nthreads_dc(ltfat_wfbt_plan_dc* p, ltfat_int nthreads);
+ *
+ * ltfat_wfbt_set_nthreads_sc(ltfat_wfbt_plan_sc* p, ltfat_int nthreads);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p was NULL
+ * LTFATERR_NOTPOSARG       | \a nthreads was less or equal to 0.
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_set_nthreads)(LTFAT_NAME(wfbt_plan)* p, ltfat_int nthreads);
+
+/** Number of outputs of the tree
+ *
+ * \returns Number of outputs or a negative status code
+ */
+LTFAT_API ltfat_int
+LTFAT_NAME(wfbt_get_nout)(LTFAT_NAME(wfbt_plan)* p);
+
+/** Lengths of the outputs of the tree
+ *
+ * \param[in]   p  Wavelet filterbank tree plan
+ * \param[out] Lc  Output lengths, size wfbt_get_nout(p)
+ *
+ * \returns Status code
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_get_outlens)(LTFAT_NAME(wfbt_plan)* p, ltfat_int Lc[]);
+
+/** Destroy the wavelet filterbank tree plan
+ *
+ * \param[in]  p  Wavelet filterbank tree plan
+ *
+ * #### Versions #
+ * <tt>
+ * ltfat_wfbt_done_d(ltfat_wfbt_plan_d** p);
+ *
+ * ltfat_wfbt_done_s(ltfat_wfbt_plan_s** p);
+ *
+ * ltfat_wfbt_done_dc(ltfat_wfbt_plan_dc** p);
+ *
+ * ltfat_wfbt_done_sc(ltfat_wfbt_plan_sc** p);
+ * </tt>
+ * \returns
+ * Status code              | Description
+ * -------------------------|--------------------------------------------
+ * LTFATERR_SUCCESS         | Indicates no error
+ * LTFATERR_NULLPOINTER     | \a p or \a *p was NULL
+ */
+LTFAT_API int
+LTFAT_NAME(wfbt_done)(LTFAT_NAME(wfbt_plan)** p);
+
+/** @} */
@@ -0,0 +1,540 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include "ltfat/thirdparty/fftw3.h"
+
+/* Number of outputs computed at once by the direct form */
+#define PFILT_BLOCK 256
+/* Maximum number of FFT columns transformed by one FFT call */
+#define PFILT_BATCH 8
+
+/* The FFT based filtering works with segments of nfft input samples. The
+ * segment of output block b of channel w starts at j0 - shift (modulo L)
+ * where j0 = b*hop and the outputs j0, ..., j0 + hop - 1 are samples
+ * shift, ..., shift + hop - 1 of the cyclic convolution of the segment with
+ * the kernel. For the full length convolution nfft = hop = L and shift = 0.
+ *
+ * In the real case, segments 2q and 2q + 1 are the real and imaginary part
+ * of FFT column q. The kernel is real, so the parts do not mix.
+ *
+ * The uniformly partitioned overlap-save splits the causal kernel
+ * h(u) = conj(g(shift - u)), u = 0, ..., gl - 1, into npart partitions of
+ * length hop and uses nfft = 2*hop. Frame q is the input
+ * shift + (q - 1)*hop, ..., shift + (q + 1)*hop - 1 and the outputs
+ * b*hop, ..., (b + 1)*hop - 1 are the second half of
+ * ifft(sum_k kern_k .* fft(frame b - k)). The spectra of the last npart
+ * frames are kept in fdl. In the real case, channels 2q and 2q + 1 share
+ * the frames.
+ * */
+struct LTFAT_NAME(pfilt_plan)
+{
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int gl;
+    ltfat_pfilt_hint method;
+    LTFAT_TYPE* gw;        //!< Conjugated filter with the center at gl/2
+    LTFAT_TYPE* fext;      //!< Periodically extended channel, L + gl
+    LTFAT_TYPE* acc;       //!< Output block of the direct form
+    ltfat_int nfft;
+    ltfat_int hop;
+    ltfat_int shift;
+    ltfat_int nblocks;     //!< Blocks per channel
+    ltfat_int nbatch;      //!< FFT columns per batch
+    ltfat_int npart;       //!< Kernel partitions, 1 if not partitioned
+    LTFAT_COMPLEX* kern;   //!< FFT of the kernel (partitions) divided by nfft
+    LTFAT_COMPLEX* buf;    //!< nfft x nbatch
+    LTFAT_COMPLEX* fdl;    //!< Spectra of the last npart frames, nfft x npart
+    LTFAT_NAME_REAL(fft_plan)* fwd;
+    LTFAT_NAME_REAL(ifft_plan)* inv;
+};
+
+#ifdef LTFAT_COMPLEXTYPE
+#define PFILT_SEGPERCOL 1
+#define PFILT_MACCOST 8.0
+#define PFILT_CONJ(x) conj(x)
+#else
+#define PFILT_SEGPERCOL 2
+#define PFILT_MACCOST 2.0
+#define PFILT_CONJ(x) (x)
+#endif
+
+/* Flop estimate of one FFT. The long FFTs no longer fit into the cache
+ * and the time per flop measured for lengths up to 2^14, up to 2^17 and
+ * longer is roughly 1 : 1.4 : 2.6. */
+static double
+LTFAT_NAME(pfilt_fftflops)(ltfat_int nfft)
+{
+    double flops = 5.0 * nfft * log2((double) nfft);
+    if (nfft > 131072)
+        return 2.6 * flops;
+    return nfft > 16384 ? 1.4 * flops : flops;
+}
+
+/* Flop estimate of the FFT based filtering */
+static double
+LTFAT_NAME(pfilt_fftcost)(ltfat_int nfft, ltfat_int nsegments)
+{
+    ltfat_int ncol = (nsegments + PFILT_SEGPERCOL - 1) / PFILT_SEGPERCOL;
+    return ncol * (2.0 * LTFAT_NAME(pfilt_fftflops)(nfft) + 12.0 * nfft);
+}
+
+/* Flop estimate of the partitioned overlap-save, one forward FFT per frame,
+ * one inverse FFT per block and npart spectrum products per block */
+static double
+LTFAT_NAME(pfilt_fftpartcost)(ltfat_int nfft, ltfat_int nblocks,
+                              ltfat_int npart, ltfat_int W)
+{
+    ltfat_int nlanes = (W + PFILT_SEGPERCOL - 1) / PFILT_SEGPERCOL;
+    return nlanes * ((2.0 * nblocks + npart - 1) * LTFAT_NAME(pfilt_fftflops)(nfft) +
+                     nblocks * (npart * 8.0 * nfft + 4.0 * nfft));
+}
+
+/* out[i] = f[(start + i) mod L], i = 0, ..., len - 1 */
+static void
+LTFAT_NAME(pfilt_periodic_copy)(const LTFAT_TYPE* f, ltfat_int L,
+                                ltfat_int start, ltfat_int len,
+                                LTFAT_TYPE* out)
+{
+    ltfat_int l = ltfat_positiverem(start, L);
+
+    while (len > 0)
+    {
+        ltfat_int chunk = ltfat_imin(len, L - l);
+        memcpy(out, f + l, chunk * sizeof * out);
+        out += chunk; len -= chunk; l = 0;
+    }
+}
+
+static int
+LTFAT_NAME(pfilt_done_priv)(LTFAT_NAME(pfilt_plan)* p)
+{
+    if (p->fwd) LTFAT_NAME_REAL(fft_done)(&p->fwd);
+    if (p->inv) LTFAT_NAME_REAL(ifft_done)(&p->inv);
+    LTFAT_SAFEFREEALL(p->gw, p->fext, p->acc, p->kern, p->buf, p->fdl);
+    ltfat_free(p);
+    return LTFATERR_SUCCESS;
+}
+
+LTFAT_API int
+LTFAT_NAME(pfilt_init)(const LTFAT_TYPE g[], ltfat_int gl, ltfat_int L,
+                       ltfat_int W, ltfat_int a, ltfat_pfilt_hint hint,
+                       unsigned flags, LTFAT_NAME(pfilt_plan)** pout)
+{
+    LTFAT_NAME(pfilt_plan)* p = NULL;
+    ltfat_int glh, N, nseg, parthop = 1, partnblocks = L;
+    double directcost, fftcost, fftpartcost;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive.", gl);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a (passed %td) must be positive.", a);
+    CHECK(LTFATERR_BADTRALEN, L >= gl && L % a == 0,
+          "L (passed %td) must be divisible by a (passed %td) and not shorter than gl (passed %td).",
+          L, a, gl);
+    CHECK(LTFATERR_CANNOTHAPPEN, hint == ltfat_pfilt_auto ||
+          hint == ltfat_pfilt_direct || hint == ltfat_pfilt_fft ||
+          hint == ltfat_pfilt_fftpart, "No such pfilt hint.");
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(pfilt_plan)) );
+    p->L = L; p->W = W; p->a = a; p->gl = gl; p->npart = 1;
+    glh = gl / 2;
+    N = L / a;
+
+    // Full length cyclic convolution
+    p->nfft = L; p->hop = L; p->shift = 0; p->nblocks = 1;
+    fftcost = LTFAT_NAME(pfilt_fftcost)(L, W);
+
+    // Overlap-save with power of two FFT lengths shorter than L
+    for (ltfat_int nfft = ltfat_nextpow2(2 * gl); nfft < L; nfft *= 2)
+    {
+        ltfat_int hop = nfft - gl + 1;
+        ltfat_int nblocks = (L + hop - 1) / hop;
+        double cost = LTFAT_NAME(pfilt_fftcost)(nfft, nblocks * W);
+        if (cost < fftcost)
+        {
+            fftcost = cost;
+            p->nfft = nfft; p->hop = hop; p->shift = glh; p->nblocks = nblocks;
+        }
+    }
+
+    // Partitioned overlap-save with power of two partition lengths
+    fftpartcost = HUGE_VAL;
+    for (ltfat_int hop = ltfat_nextpow2(gl); hop >= 1; hop /= 2)
+    {
+        ltfat_int nblocks = (L + hop - 1) / hop;
+        double cost = LTFAT_NAME(pfilt_fftpartcost)(2 * hop, nblocks,
+                      (gl + hop - 1) / hop, W);
+        if (cost < fftpartcost)
+        {
+            fftpartcost = cost;
+            parthop = hop; partnblocks = nblocks;
+        }
+    }
+
+    directcost = PFILT_MACCOST * gl * N * W;
+
+    if (hint == ltfat_pfilt_auto)
+    {
+        p->method = directcost <= fftcost ? ltfat_pfilt_direct : ltfat_pfilt_fft;
+        if (fftpartcost < fmin(directcost, fftcost))
+            p->method = ltfat_pfilt_fftpart;
+    }
+    else
+        p->method = hint;
+
+    if (p->method == ltfat_pfilt_fftpart)
+    {
+        p->hop = parthop; p->nfft = 2 * parthop; p->shift = gl - glh - 1;
+        p->nblocks = partnblocks; p->npart = (gl + parthop - 1) / parthop;
+    }
+
+    if (p->method == ltfat_pfilt_direct)
+    {
+        CHECKMEM( p->gw = LTFAT_NAME(malloc)(gl) );
+        CHECKMEM( p->fext = LTFAT_NAME(malloc)(L + gl) );
+        CHECKMEM( p->acc = LTFAT_NAME(malloc)(PFILT_BLOCK) );
+
+        // fftshift and conjugate, as in pfilt_fir_rr
+        for (ltfat_int l = 0; l < gl; l++)
+            p->gw[l] = PFILT_CONJ(g[ltfat_positiverem(l - glh, gl)]);
+    }
+    else if (p->method == ltfat_pfilt_fftpart)
+    {
+        ltfat_int nfft = p->nfft, hop = p->hop;
+
+        CHECKMEM( p->kern = LTFAT_NAME_COMPLEX(calloc)(nfft * p->npart) );
+        CHECKMEM( p->fdl = LTFAT_NAME_COMPLEX(malloc)(nfft * p->npart) );
+        CHECKMEM( p->buf = LTFAT_NAME_COMPLEX(malloc)(nfft) );
+
+        // Partition k holds h(k*hop), ..., h(k*hop + hop - 1) / nfft
+        for (ltfat_int u = 0; u < gl; u++)
+            p->kern[(u / hop) * nfft + u % hop] =
+                PFILT_CONJ(g[ltfat_positiverem(p->shift - u, gl)]) / ((LTFAT_REAL) nfft);
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft)(p->kern, nfft, p->npart, p->kern));
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft_init)(nfft, 1, p->buf, p->fdl, flags, &p->fwd));
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(ifft_init)(nfft, 1, p->buf, p->buf, flags, &p->inv));
+    }
+    else
+    {
+        ltfat_int nfft = p->nfft;
+        nseg = p->nblocks * W;
+        p->nbatch = ltfat_imin(PFILT_BATCH, (nseg + PFILT_SEGPERCOL - 1) / PFILT_SEGPERCOL);
+
+        CHECKMEM( p->kern = LTFAT_NAME_COMPLEX(calloc)(nfft) );
+        CHECKMEM( p->buf = LTFAT_NAME_COMPLEX(malloc)(nfft * p->nbatch) );
+
+        // kern(-k) = conj(g(k)) / nfft
+        for (ltfat_int l = 0; l < gl; l++)
+        {
+            ltfat_int k = l < gl - glh ? l : l - gl;
+            p->kern[ltfat_positiverem(-k, nfft)] = PFILT_CONJ(g[l]) / ((LTFAT_REAL) nfft);
+        }
+
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft)(p->kern, nfft, 1, p->kern));
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft_init)(nfft, p->nbatch, p->buf, p->buf, flags,
+                                      &p->fwd));
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(ifft_init)(nfft, p->nbatch, p->buf, p->buf, flags,
+                                       &p->inv));
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(pfilt_done_priv)(p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+static void
+LTFAT_NAME(pfilt_execute_direct)(LTFAT_NAME(pfilt_plan)* p,
+                                 const LTFAT_TYPE f[], LTFAT_TYPE c[])
+{
+    ltfat_int L = p->L, a = p->a, gl = p->gl, N = L / a;
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        LTFAT_NAME(pfilt_periodic_copy)(f + w * L, L, -(gl / 2), L + gl - 1,
+                                        p->fext);
+
+        for (ltfat_int n0 = 0; n0 < N; n0 += PFILT_BLOCK)
+        {
+            ltfat_int nb = ltfat_imin(PFILT_BLOCK, N - n0);
+            LTFAT_TYPE* acc = p->acc;
+
+            if (a == 1)
+            {
+                // One tap for the whole block, the inner loop vectorizes
+                LTFAT_NAME(clear_array)(acc, nb);
+
+                for (ltfat_int l = 0; l < gl; l++)
+                {
+                    const LTFAT_TYPE gv = p->gw[l];
+                    const LTFAT_TYPE* fp = p->fext + n0 + l;
+
+                    for (ltfat_int i = 0; i < nb; i++)
+                        acc[i] += gv * fp[i];
+                }
+            }
+            else
+            {
+                // Strided access would defeat the above, use dot products
+                for (ltfat_int i = 0; i < nb; i++)
+                {
+                    const LTFAT_TYPE* fp = p->fext + (n0 + i) * a;
+                    LTFAT_TYPE sum = 0.0;
+
+                    for (ltfat_int l = 0; l < gl; l++)
+                        sum += p->gw[l] * fp[l];
+
+                    acc[i] = sum;
+                }
+            }
+
+            memcpy(c + w * N + n0, acc, nb * sizeof * c);
+        }
+    }
+}
+
+static void
+LTFAT_NAME(pfilt_execute_fft)(LTFAT_NAME(pfilt_plan)* p,
+                              const LTFAT_TYPE f[], LTFAT_TYPE c[])
+{
+    ltfat_int L = p->L, a = p->a, N = L / a, nfft = p->nfft;
+    ltfat_int nseg = p->nblocks * p->W;
+    ltfat_int ncol = (nseg + PFILT_SEGPERCOL - 1) / PFILT_SEGPERCOL;
+
+    for (ltfat_int col0 = 0; col0 < ncol; col0 += p->nbatch)
+    {
+        ltfat_int nb = ltfat_imin(p->nbatch, ncol - col0);
+
+        // Read the segments, the unused columns are zero
+        for (ltfat_int q = 0; q < p->nbatch; q++)
+        {
+            LTFAT_COMPLEX* col = p->buf + q * nfft;
+
+            for (ltfat_int part = 0; part < PFILT_SEGPERCOL; part++)
+            {
+                ltfat_int s = (col0 + q) * PFILT_SEGPERCOL + part;
+                ltfat_int w = s / p->nblocks, b = s % p->nblocks;
+#ifdef LTFAT_COMPLEXTYPE
+                if (q < nb)
+                    LTFAT_NAME(pfilt_periodic_copy)(f + w * L, L,
+                                                    b * p->hop - p->shift,
+                                                    nfft, col);
+                else
+                    LTFAT_NAME(clear_array)(col, nfft);
+#else
+                LTFAT_REAL* colr = (LTFAT_REAL*) col;
+                ltfat_int l = ltfat_positiverem(b * p->hop - p->shift, L);
+
+                if (q < nb && s < nseg)
+                {
+                    const LTFAT_REAL* fw = f + w * L;
+                    for (ltfat_int i = 0; i < nfft; i++)
+                    {
+                        colr[2 * i + part] = fw[l];
+                        if (++l == L) l = 0;
+                    }
+                }
+                else
+                    for (ltfat_int i = 0; i < nfft; i++)
+                        colr[2 * i + part] = 0.0;
+#endif
+            }
+        }
+
+        LTFAT_NAME_REAL(fft_execute)(p->fwd);
+
+        for (ltfat_int q = 0; q < nb; q++)
+        {
+            LTFAT_COMPLEX* col = p->buf + q * nfft;
+            for (ltfat_int i = 0; i < nfft; i++)
+                col[i] *= p->kern[i];
+        }
+
+        LTFAT_NAME_REAL(ifft_execute)(p->inv);
+
+        // Store every a-th output of the valid part
+        for (ltfat_int q = 0; q < nb; q++)
+        {
+            const LTFAT_COMPLEX* col = p->buf + q * nfft;
+
+            for (ltfat_int part = 0; part < PFILT_SEGPERCOL; part++)
+            {
+                ltfat_int s = (col0 + q) * PFILT_SEGPERCOL + part;
+                ltfat_int w = s / p->nblocks, b = s % p->nblocks;
+                ltfat_int j0 = b * p->hop;
+                ltfat_int jend = ltfat_imin(j0 + p->hop, L);
+                ltfat_int j = ((j0 + a - 1) / a) * a;
+                LTFAT_TYPE* cw = c + w * N;
+
+                if (s >= nseg) break;
+
+                for (; j < jend; j += a)
+                {
+#ifdef LTFAT_COMPLEXTYPE
+                    cw[j / a] = col[j - j0 + p->shift];
+#else
+                    cw[j / a] = ((const LTFAT_REAL*) col)[2 * (j - j0 + p->shift) + part];
+#endif
+                }
+            }
+        }
+    }
+}
+
+static void
+LTFAT_NAME(pfilt_execute_fftpart)(LTFAT_NAME(pfilt_plan)* p,
+                                  const LTFAT_TYPE f[], LTFAT_TYPE c[])
+{
+    ltfat_int L = p->L, a = p->a, N = L / a, nfft = p->nfft, hop = p->hop;
+    ltfat_int npart = p->npart;
+    ltfat_int nlanes = (p->W + PFILT_SEGPERCOL - 1) / PFILT_SEGPERCOL;
+
+    for (ltfat_int lane = 0; lane < nlanes; lane++)
+    {
+        // The first block needs the frames 1 - npart, ..., 0
+        for (ltfat_int q = 1 - npart; q < p->nblocks; q++)
+        {
+            ltfat_int start = p->shift + (q - 1) * hop;
+            ltfat_int j0 = q * hop, jend = ltfat_imin(j0 + hop, L);
+            LTFAT_COMPLEX* buf = p->buf;
+
+#ifdef LTFAT_COMPLEXTYPE
+            LTFAT_NAME(pfilt_periodic_copy)(f + lane * L, L, start, nfft, buf);
+#else
+            for (ltfat_int part = 0; part < PFILT_SEGPERCOL; part++)
+            {
+                LTFAT_REAL* bufr = (LTFAT_REAL*) buf;
+                ltfat_int w = lane * PFILT_SEGPERCOL + part;
+                ltfat_int l = ltfat_positiverem(start, L);
+
+                if (w < p->W)
+                {
+                    const LTFAT_REAL* fw = f + w * L;
+                    for (ltfat_int i = 0; i < nfft; i++)
+                    {
+                        bufr[2 * i + part] = fw[l];
+                        if (++l == L) l = 0;
+                    }
+                }
+                else
+                    for (ltfat_int i = 0; i < nfft; i++)
+                        bufr[2 * i + part] = 0.0;
+            }
+#endif
+            LTFAT_NAME_REAL(fft_execute_newarray)(p->fwd, buf,
+                                                  p->fdl + ltfat_positiverem(q, npart) * nfft);
+            if (q < 0) continue;
+
+            LTFAT_NAME_COMPLEX(clear_array)(buf, nfft);
+            for (ltfat_int k = 0; k < npart; k++)
+            {
+                const LTFAT_COMPLEX* X = p->fdl + ltfat_positiverem(q - k, npart) * nfft;
+                const LTFAT_COMPLEX* K = p->kern + k * nfft;
+                for (ltfat_int i = 0; i < nfft; i++)
+                    buf[i] += K[i] * X[i];
+            }
+
+            LTFAT_NAME_REAL(ifft_execute)(p->inv);
+
+            // Store every a-th output of the second half
+            for (ltfat_int part = 0; part < PFILT_SEGPERCOL; part++)
+            {
+                ltfat_int w = lane * PFILT_SEGPERCOL + part;
+                LTFAT_TYPE* cw = c + w * N;
+
+                if (w >= p->W) break;
+
+                for (ltfat_int j = ((j0 + a - 1) / a) * a; j < jend; j += a)
+                {
+#ifdef LTFAT_COMPLEXTYPE
+                    cw[j / a] = buf[hop + j - j0];
+#else
+                    cw[j / a] = ((const LTFAT_REAL*) buf)[2 * (hop + j - j0) + part];
+#endif
+                }
+            }
+        }
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(pfilt_execute)(LTFAT_NAME(pfilt_plan)* p, const LTFAT_TYPE f[],
+                          LTFAT_TYPE c[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADARG, (const void*) f != (void*) c,
+          "f and c must not be the same array.");
+
+    if (p->method == ltfat_pfilt_direct)
+        LTFAT_NAME(pfilt_execute_direct)(p, f, c);
+    else if (p->method == ltfat_pfilt_fftpart)
+        LTFAT_NAME(pfilt_execute_fftpart)(p, f, c);
+    else
+        LTFAT_NAME(pfilt_execute_fft)(p, f, c);
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(pfilt_get_method)(LTFAT_NAME(pfilt_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->method;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(pfilt_get_fftlen)(LTFAT_NAME(pfilt_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->method == ltfat_pfilt_direct ? 0 : p->nfft;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(pfilt_done)(LTFAT_NAME(pfilt_plan)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    LTFAT_NAME(pfilt_done_priv)(*p);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(pfilt)(const LTFAT_TYPE f[], const LTFAT_TYPE g[], ltfat_int gl,
+                  ltfat_int L, ltfat_int W, ltfat_int a, LTFAT_TYPE c[])
+{
+    LTFAT_NAME(pfilt_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(pfilt_init)(g, gl, L, W, a, ltfat_pfilt_auto,
+                                        FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(pfilt_execute)(p, f, c));
+
+error:
+    if (p) LTFAT_NAME(pfilt_done)(&p);
+    return status;
+}
+
+#undef PFILT_SEGPERCOL
+#undef PFILT_MACCOST
+#undef PFILT_CONJ
@@ -3,148 +3,114 @@
 #include "ltfat/macros.h"
 
 #include "ltfat/thirdparty/fftw3.h"
+#include "dctdst_private.h"
 
-/* typedef LTFAT_NAME(dct_plan) LTFAT_FFTW(plan); */
-
-/* typedef enum */
-/* { */
-/*     DCTI = FFTW_REDFT00, DCTIII = FFTW_REDFT01, */
-/*     DCTII = FFTW_REDFT10, DCTIV = FFTW_REDFT11 */
-/* } dct_kind; */
-
-LTFAT_API LTFAT_NAME(dct_plan)*
-LTFAT_NAME(dct_init)( ltfat_int L, ltfat_int W, LTFAT_TYPE* cout,
-                      const dct_kind kind)
+struct LTFAT_NAME(dct_plan)
 {
-    LTFAT_FFTW(iodim64) dims, howmanydims;
-    LTFAT_FFTW(plan) p;
-
-#ifdef LTFAT_COMPLEXTYPE
-    dims.n = L;
-    dims.is = 2;
-    dims.os = 2;
-
-    howmanydims.n = W;
-    howmanydims.is = 2 * L;
-    howmanydims.os = 2 * L;
-
-    // We want to use the plan for the unaligned imaginary part of the array
-    unsigned flag = FFTW_ESTIMATE | FFTW_UNALIGNED;
-#else
-    dims.n = L;
-    dims.is = 1;
-    dims.os = 1;
-
-    howmanydims.n = W;
-    howmanydims.is = L;
-    howmanydims.os = L;
-
-    unsigned flag = FFTW_ESTIMATE;
-#endif
-
-    LTFAT_FFTW(r2r_kind) kindFftw = FFTW_REDFT00;
-
-    switch (kind)
-    {
-        case DCTI:   kindFftw = FFTW_REDFT00; break;
-        case DCTII:  kindFftw = FFTW_REDFT10; break;
-        case DCTIII: kindFftw = FFTW_REDFT01; break;
-        case DCTIV:  kindFftw = FFTW_REDFT11; break;
-    };
-
-    p = LTFAT_FFTW(plan_guru64_r2r)(1, &dims,
-                                    1, &howmanydims,
-                                    (LTFAT_REAL*)cout, (LTFAT_REAL*)cout,
-                                    &kindFftw, flag);
-
-    return (LTFAT_NAME(dct_plan)*) p;
-}
-
-
-// f and cout cannot be equal, because creating plan can tamper with the array
-LTFAT_API void
-LTFAT_NAME(dct)(const LTFAT_TYPE* f, ltfat_int L, ltfat_int W,
-                LTFAT_TYPE* cout, const dct_kind kind)
+    LTFAT_NAME(r2r_engine) e;
+    ltfat_int L;
+    ltfat_int W;
+};
+
+LTFAT_API int
+LTFAT_NAME(dct)(const LTFAT_TYPE f[], ltfat_int L, ltfat_int W,
+                LTFAT_TYPE c[], const dct_kind kind)
 {
-    LTFAT_NAME(dct_plan)* p = LTFAT_NAME(dct_init)( L, W, cout, kind);
+    LTFAT_NAME(dct_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    LTFAT_NAME(dct_execute)(p, f,  L,  W,  cout, kind);
+    CHECKSTATUS( LTFAT_NAME(dct_init)(L, W, kind, FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(dct_execute)(p, f, c));
 
-    LTFAT_NAME(dct_done)(p);
+error:
+    if (p) LTFAT_NAME(dct_done)(&p);
+    return status;
 }
 
-LTFAT_API void
-LTFAT_NAME(dct_done)( LTFAT_NAME(dct_plan)* p)
+LTFAT_API int
+LTFAT_NAME(dct_init)(ltfat_int L, ltfat_int W, const dct_kind kind,
+                     unsigned flags, LTFAT_NAME(dct_plan)** pout)
 {
-    LTFAT_FFTW(destroy_plan)((LTFAT_FFTW(plan))p);
-}
-
-// f and cout can be equal, provided plan was already created
-LTFAT_API
-void LTFAT_NAME(dct_execute)(const LTFAT_NAME(dct_plan)* p, const LTFAT_TYPE* f,
-                             ltfat_int L, ltfat_int W,
-                             LTFAT_TYPE* cout, const dct_kind kind)
-{
-    // Copy input to the output
-    if (cout != f)
-        memcpy(cout, f, L * W * sizeof * f);
+    LTFAT_NAME(dct_plan)* p = NULL;
+    ltfat_r2r_kind r2rkind = LTFAT_REDFT00;
+    double sqrt2 = sqrt(2.0);
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
 
-    if (L == 1)
-        return;
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dct_plan)) );
+    p->L = L; p->W = W;
+    p->e.pre0 = 1.0; p->e.pre1 = 1.0; p->e.post0 = 1.0; p->e.post1 = 1.0;
+    p->e.scale = (LTFAT_REAL) ( 1.0 / sqrt(2.0 * L) );
 
-    ltfat_int N = 2 * L;
-    LTFAT_REAL sqrt2 = (LTFAT_REAL) sqrt(2.0);
-    LTFAT_REAL postScale = (LTFAT_REAL) 1.0 / sqrt2;
-    LTFAT_REAL scale = (LTFAT_REAL) ( sqrt2 * (1.0 / (double)N) * sqrt((double)L) );
+    p->e.inrev = 0; p->e.insign = 0; p->e.outrev = 0; p->e.outsign = 0;
 
-    if (kind == DCTI || kind == DCTIII)
+    switch (kind)
     {
-        for (ltfat_int ii = 0; ii < W; ii++)
-        {
-            cout[ii * L] *= sqrt2;
-        }
+    case DCTI:
+        r2rkind = LTFAT_REDFT00;
+        p->e.pre0 = sqrt2; p->e.pre1 = sqrt2;
+        p->e.post0 = 1.0 / sqrt2; p->e.post1 = 1.0 / sqrt2;
+        if (L > 1) p->e.scale = (LTFAT_REAL) ( 1.0 / sqrt(2.0 * (L - 1)) );
+        break;
+    case DCTII:
+        r2rkind = LTFAT_REDFT10;
+        p->e.post0 = 1.0 / sqrt2;
+        break;
+    case DCTIII:
+        r2rkind = LTFAT_REDFT01;
+        p->e.pre0 = sqrt2;
+        break;
+    case DCTIV:
+        r2rkind = LTFAT_REDFT11;
+        break;
+    default:
+        CHECKCANTHAPPEN("Unknown dct_kind");
     }
 
-    if (kind == DCTI)
-    {
-        N -= 2;
-        for (ltfat_int ii = 0; ii < W; ii++)
-        {
-            cout[(ii + 1)*L - 1] *= sqrt2;
-        }
+    CHECKSTATUS( LTFAT_NAME(r2r_engine_init)(L, r2rkind, flags, &p->e));
 
-        scale = (LTFAT_REAL) ( sqrt2 * (1.0 / ((double)N)) * sqrt((double)L - 1) );
-    }
+    *pout = p;
+    return status;
+error:
+    ltfat_safefree(p);
+    return status;
+}
 
-    LTFAT_REAL* c_r = (LTFAT_REAL*)cout;
+LTFAT_API int
+LTFAT_NAME(dct_execute)(LTFAT_NAME(dct_plan)* p, const LTFAT_TYPE f[],
+                        LTFAT_TYPE c[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
 
-    LTFAT_FFTW(execute_r2r)((LTFAT_FFTW(plan))p, c_r, c_r);
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        const LTFAT_REAL* fw = (const LTFAT_REAL*) (f + w * p->L);
+        LTFAT_REAL* cw = (LTFAT_REAL*) (c + w * p->L);
 #ifdef LTFAT_COMPLEXTYPE
-    LTFAT_REAL* c_i = c_r + 1;
-    LTFAT_FFTW(execute_r2r)((LTFAT_FFTW(plan))p, c_i, c_i);
+        LTFAT_NAME(r2r_engine_execute)(&p->e, fw, 2, cw, 2);
+        LTFAT_NAME(r2r_engine_execute)(&p->e, fw + 1, 2, cw + 1, 2);
+#else
+        LTFAT_NAME(r2r_engine_execute)(&p->e, fw, 1, cw, 1);
 #endif
-
-    // Post-scaling
-    for (ltfat_int ii = 0; ii < L * W; ii++)
-    {
-        cout[ii] *= scale;
     }
 
-    if (kind == DCTI || kind == DCTII)
-    {
-        // Scale DC component(s)
-        for (ltfat_int ii = 0; ii < W; ii++)
-        {
-            cout[ii * L] *= postScale;
-        }
-    }
+error:
+    return status;
+}
 
-    if (kind == DCTI)
-    {
-        // Scale AC component
-        for (ltfat_int ii = 0; ii < W; ii++)
-        {
-            cout[(ii + 1)*L - 1] *= postScale;
-        }
-    }
+LTFAT_API int
+LTFAT_NAME(dct_done)(LTFAT_NAME(dct_plan)** p)
+{
+    LTFAT_NAME(dct_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_NAME(r2r_engine_done)(&pp->e);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
 }
@@ -0,0 +1,263 @@
+/* Shared by the DCT and DST plans.
+ *
+ * FFT based real-to-real transforms using the unnormalized FFTW definitions
+ * of REDFT00, REDFT10, REDFT01, REDFT11 and RODFT00. The remaining DSTs are
+ * obtained from the DCTs by reversing and alternating the signs of the input
+ * and/or output. Only the ltfat FFT wrappers are used, so this works with
+ * any FFT backend.
+ * */
+#ifndef _LTFAT_DCTDST_PRIVATE_H
+#define _LTFAT_DCTDST_PRIVATE_H
+
+typedef enum
+{
+    LTFAT_REDFT00, LTFAT_REDFT10, LTFAT_REDFT01, LTFAT_REDFT11, LTFAT_RODFT00
+} ltfat_r2r_kind;
+
+#endif
+
+typedef struct
+{
+    ltfat_r2r_kind kind;
+    ltfat_int L;
+    ltfat_int Lfft;
+    LTFAT_REAL* xbuf;    //!< One column, length L
+    LTFAT_REAL* rbuf;    //!< Real FFT buffer, length Lfft
+    LTFAT_COMPLEX* cbuf; //!< Complex FFT buffer
+    LTFAT_COMPLEX* twid; //!< Pre- and post-twiddle factors
+    LTFAT_NAME_REAL(fftreal_plan)* pfr;
+    LTFAT_NAME_REAL(ifftreal_plan)* pifr;
+    LTFAT_NAME_REAL(fft_plan)* pf;
+    int inrev;   //!< Reverse the input
+    int insign;  //!< Negate odd input samples
+    int outrev;  //!< Reverse the output
+    int outsign; //!< Negate odd output samples
+    LTFAT_REAL pre0;  //!< Scaling of the first input sample
+    LTFAT_REAL pre1;  //!< Scaling of the last input sample
+    LTFAT_REAL scale;
+    LTFAT_REAL post0; //!< Scaling of the first output sample
+    LTFAT_REAL post1; //!< Scaling of the last output sample
+} LTFAT_NAME(r2r_engine);
+
+static inline void
+LTFAT_NAME(r2r_engine_done)(LTFAT_NAME(r2r_engine)* e)
+{
+    if (e->pfr) LTFAT_NAME_REAL(fftreal_done)(&e->pfr);
+    if (e->pifr) LTFAT_NAME_REAL(ifftreal_done)(&e->pifr);
+    if (e->pf) LTFAT_NAME_REAL(fft_done)(&e->pf);
+    LTFAT_SAFEFREEALL(e->xbuf, e->rbuf, e->cbuf, e->twid);
+    e->xbuf = NULL; e->rbuf = NULL; e->cbuf = NULL; e->twid = NULL;
+}
+
+/* The scaling factors and the reversal flags are expected to be set by the
+ * caller. */
+static inline int
+LTFAT_NAME(r2r_engine_init)(ltfat_int L, ltfat_r2r_kind kind, unsigned flags,
+                            LTFAT_NAME(r2r_engine)* e)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int Lfft = L;
+
+    e->kind = kind; e->L = L;
+    e->xbuf = NULL; e->rbuf = NULL; e->cbuf = NULL; e->twid = NULL;
+    e->pfr = NULL; e->pifr = NULL; e->pf = NULL;
+
+    CHECKMEM( e->xbuf = LTFAT_NAME_REAL(malloc)(L) );
+
+    // Nothing to plan, the length 1 transforms are just scalings
+    if (L == 1)
+        return status;
+
+    switch (kind)
+    {
+    case LTFAT_REDFT00:
+        Lfft = 2 * (L - 1);
+        CHECKMEM( e->rbuf = LTFAT_NAME_REAL(malloc)(Lfft) );
+        CHECKMEM( e->cbuf = LTFAT_NAME_COMPLEX(malloc)(Lfft / 2 + 1) );
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fftreal_init)(Lfft, 1, e->rbuf, e->cbuf, flags, &e->pfr));
+        break;
+    case LTFAT_RODFT00:
+        Lfft = 2 * (L + 1);
+        CHECKMEM( e->rbuf = LTFAT_NAME_REAL(malloc)(Lfft) );
+        CHECKMEM( e->cbuf = LTFAT_NAME_COMPLEX(malloc)(Lfft / 2 + 1) );
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fftreal_init)(Lfft, 1, e->rbuf, e->cbuf, flags, &e->pfr));
+        break;
+    case LTFAT_REDFT10:
+    case LTFAT_REDFT01:
+        // Makhoul's algorithm, twid[k] = exp(-i*pi*k/(2L))
+        CHECKMEM( e->rbuf = LTFAT_NAME_REAL(malloc)(L) );
+        CHECKMEM( e->cbuf = LTFAT_NAME_COMPLEX(malloc)(L / 2 + 1) );
+        CHECKMEM( e->twid = LTFAT_NAME_COMPLEX(malloc)(L) );
+        for (ltfat_int k = 0; k < L; k++)
+            e->twid[k] = exp(-I * (LTFAT_REAL) (M_PI * k / (2.0 * L)));
+
+        if (kind == LTFAT_REDFT10)
+            CHECKSTATUS(
+                LTFAT_NAME_REAL(fftreal_init)(L, 1, e->rbuf, e->cbuf, flags, &e->pfr));
+        else
+            CHECKSTATUS(
+                LTFAT_NAME_REAL(ifftreal_init)(L, 1, e->cbuf, e->rbuf, flags, &e->pifr));
+        break;
+    case LTFAT_REDFT11:
+        if (L % 2)
+        {
+            // Zero-padded FFT of length 2L
+            // twid[j] = exp(-i*pi*j/(2L)), twid[L+k] = exp(-i*pi*(k+1/2)/(2L))
+            Lfft = 2 * L;
+            CHECKMEM( e->cbuf = LTFAT_NAME_COMPLEX(malloc)(Lfft) );
+            CHECKMEM( e->twid = LTFAT_NAME_COMPLEX(malloc)(2 * L) );
+            for (ltfat_int k = 0; k < L; k++)
+            {
+                double ph = M_PI * k / (2.0 * L), phk = M_PI * (k + 0.5) / (2.0 * L);
+                e->twid[k] = exp(-I * (LTFAT_REAL) ph);
+                e->twid[L + k] = exp(-I * (LTFAT_REAL) phk);
+            }
+        }
+        else
+        {
+            // Complex FFT of length L/2 on x(2n) + i*x(L-1-2n)
+            // twid[n] = exp(-i*pi*n/L), twid[L/2+q] = exp(-i*pi*(4q+1)/(4L))
+            Lfft = L / 2;
+            CHECKMEM( e->cbuf = LTFAT_NAME_COMPLEX(malloc)(Lfft) );
+            CHECKMEM( e->twid = LTFAT_NAME_COMPLEX(malloc)(L) );
+            for (ltfat_int k = 0; k < Lfft; k++)
+            {
+                double ph = M_PI * k / L, phq = M_PI * (4 * k + 1) / (4.0 * L);
+                e->twid[k] = exp(-I * (LTFAT_REAL) ph);
+                e->twid[Lfft + k] = exp(-I * (LTFAT_REAL) phq);
+            }
+        }
+        CHECKSTATUS(
+            LTFAT_NAME_REAL(fft_init)(Lfft, 1, e->cbuf, e->cbuf, flags, &e->pf));
+        break;
+    }
+
+    e->Lfft = Lfft;
+    return status;
+error:
+    LTFAT_NAME(r2r_engine_done)(e);
+    return status;
+}
+
+/* Transforms one column. in and out can be equal. */
+static inline void
+LTFAT_NAME(r2r_engine_execute)(LTFAT_NAME(r2r_engine)* e,
+                               const LTFAT_REAL in[], ltfat_int is,
+                               LTFAT_REAL out[], ltfat_int os)
+{
+    ltfat_int L = e->L, Lfft = e->Lfft;
+    LTFAT_REAL* x = e->xbuf;
+
+    if (L == 1)
+    {
+        out[0] = in[0];
+        return;
+    }
+
+    for (ltfat_int j = 0; j < L; j++)
+        x[j] = in[j * is];
+
+    x[0] *= e->pre0;
+    x[L - 1] *= e->pre1;
+
+    if (e->inrev)
+        LTFAT_NAME_REAL(reverse_array)(x, L, x);
+
+    if (e->insign)
+        for (ltfat_int j = 1; j < L; j += 2)
+            x[j] = -x[j];
+
+    // The raw transform overwrites x
+    switch (e->kind)
+    {
+    case LTFAT_REDFT00:
+        for (ltfat_int j = 0; j < L; j++)
+            e->rbuf[j] = x[j];
+        for (ltfat_int j = 1; j < L - 1; j++)
+            e->rbuf[Lfft - j] = x[j];
+
+        LTFAT_NAME_REAL(fftreal_execute)(e->pfr);
+
+        for (ltfat_int k = 0; k < L; k++)
+            x[k] = ltfat_real(e->cbuf[k]);
+        break;
+    case LTFAT_RODFT00:
+        e->rbuf[0] = 0.0; e->rbuf[L + 1] = 0.0;
+        for (ltfat_int j = 0; j < L; j++)
+        {
+            e->rbuf[j + 1] = x[j];
+            e->rbuf[Lfft - 1 - j] = -x[j];
+        }
+
+        LTFAT_NAME_REAL(fftreal_execute)(e->pfr);
+
+        for (ltfat_int k = 0; k < L; k++)
+            x[k] = -ltfat_imag(e->cbuf[k + 1]);
+        break;
+    case LTFAT_REDFT10:
+        for (ltfat_int j = 0; 2 * j < L; j++)
+            e->rbuf[j] = x[2 * j];
+        for (ltfat_int j = 0; 2 * j + 1 < L; j++)
+            e->rbuf[L - 1 - j] = x[2 * j + 1];
+
+        LTFAT_NAME_REAL(fftreal_execute)(e->pfr);
+
+        for (ltfat_int k = 0; k < L; k++)
+        {
+            LTFAT_COMPLEX V = 2 * k <= L ? e->cbuf[k] : conj(e->cbuf[L - k]);
+            x[k] = 2.0 * ltfat_real(e->twid[k] * V);
+        }
+        break;
+    case LTFAT_REDFT01:
+        // Hermitian part of r(k)*exp(i*pi*k/(2L)), r(0) = x(0), r(k) = 2x(k)
+        e->cbuf[0] = x[0];
+        for (ltfat_int k = 1; 2 * k <= L; k++)
+            e->cbuf[k] = x[k] * conj(e->twid[k]) + x[L - k] * e->twid[L - k];
+
+        LTFAT_NAME_REAL(ifftreal_execute)(e->pifr);
+
+        for (ltfat_int m = 0; 2 * m < L; m++)
+            x[2 * m] = e->rbuf[m];
+        for (ltfat_int m = 0; 2 * m + 1 < L; m++)
+            x[2 * m + 1] = e->rbuf[L - 1 - m];
+        break;
+    case LTFAT_REDFT11:
+        if (L % 2)
+        {
+            for (ltfat_int j = 0; j < L; j++)
+                e->cbuf[j] = x[j] * e->twid[j];
+            LTFAT_NAME_COMPLEX(clear_array)(e->cbuf + L, L);
+
+            LTFAT_NAME_REAL(fft_execute)(e->pf);
+
+            for (ltfat_int k = 0; k < L; k++)
+                x[k] = 2.0 * ltfat_real(e->twid[L + k] * e->cbuf[k]);
+        }
+        else
+        {
+            for (ltfat_int n = 0; n < Lfft; n++)
+                e->cbuf[n] = (x[2 * n] + I * x[L - 1 - 2 * n]) * e->twid[n];
+
+            LTFAT_NAME_REAL(fft_execute)(e->pf);
+
+            for (ltfat_int q = 0; q < Lfft; q++)
+            {
+                LTFAT_COMPLEX t = e->twid[Lfft + q] * e->cbuf[q];
+                x[2 * q] = 2.0 * ltfat_real(t);
+                x[L - 1 - 2 * q] = -2.0 * ltfat_imag(t);
+            }
+        }
+        break;
+    }
+
+    for (ltfat_int k = 0; k < L; k++)
+    {
+        LTFAT_REAL v = e->scale * x[e->outrev ? L - 1 - k : k];
+        out[k * os] = e->outsign && (k % 2) ? -v : v;
+    }
+
+    out[0] *= e->post0;
+    out[(L - 1) * os] *= e->post1;
+}
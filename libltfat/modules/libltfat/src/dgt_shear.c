@@ -48,6 +48,7 @@ LTFAT_NAME(dgt_shear_init)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
                            unsigned flags)
 {
     LTFAT_NAME(dgt_shear_plan) plan;
+    memset(&plan, 0, sizeof plan);
 
     plan.a = a;
     plan.M = M;
@@ -286,10 +287,14 @@ LTFAT_API void
 LTFAT_NAME(dgt_shear_done)(LTFAT_NAME(dgt_shear_plan) plan)
 {
     LTFAT_NAME_COMPLEX(dgt_long_done)(&plan.rect_plan);
-    LTFAT_NAME_REAL(fft_done)(&plan.f_plan);
-    LTFAT_NAME_REAL(fft_done)(&plan.g_plan);
-    LTFAT_SAFEFREEALL(plan.finalmod, plan.c_rect, plan.fwork, plan.gwork, plan.p0,
-                      plan.p1);
+    if (plan.f_plan) LTFAT_NAME_REAL(fft_done)(&plan.f_plan);
+    if (plan.g_plan) LTFAT_NAME_REAL(fft_done)(&plan.g_plan);
+
+    /* fwork and gwork alias the input arrays on a rectangular lattice */
+    if (plan.s0 || plan.s1)
+        LTFAT_SAFEFREEALL(plan.fwork, plan.gwork);
+
+    LTFAT_SAFEFREEALL(plan.finalmod, plan.c_rect, plan.p0, plan.p1);
 }
 
 
@@ -308,3 +313,302 @@ LTFAT_NAME(dgt_shear)(const LTFAT_COMPLEX* f, const LTFAT_COMPLEX* g,
     LTFAT_NAME(dgt_shear_done)(plan);
 
 }
+
+/* ----- DGT of real signals on a non-separable lattice ----- */
+struct LTFAT_NAME(dgtreal_shear_plan)
+{
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int s0;
+    ltfat_int s1;
+    ltfat_int br;
+    LTFAT_COMPLEX* p0;     //!< Frequency chirp, NULL if s0 == 0
+    LTFAT_COMPLEX* p1;     //!< Time chirp, NULL if s1 == 0
+    LTFAT_COMPLEX* fwork;  //!< Sheared signal, L x W
+    LTFAT_COMPLEX* c_rect; //!< Coefficients on the rectangular lattice
+    ltfat_int* outidx;     //!< Index of c_rect[i] in the output
+    LTFAT_COMPLEX* phase;  //!< Phase factor of c_rect[i]
+    LTFAT_NAME_REAL(fftreal_plan)* fr_plan; //!< Used if s0 != 0 and s1 == 0
+    LTFAT_NAME_REAL(fft_plan)* fc_plan;     //!< Used if s0 != 0 and s1 != 0
+    LTFAT_NAME(dgt_long_plan)* rect_real;   //!< Used if s0 == s1 == 0
+    LTFAT_NAME_COMPLEX(dgt_long_plan)* rect_plan;
+    const LTFAT_REAL* f;
+    LTFAT_COMPLEX* c;
+};
+
+/* Fills outidx and phase such that c[outidx[i]] = phase[i]*c_rect[i] */
+static void
+LTFAT_NAME(dgtreal_shear_perm)(LTFAT_NAME(dgtreal_shear_plan)* p,
+                               const LTFAT_COMPLEX* finalmod)
+{
+    ltfat_int a = p->a, M = p->M, L = p->L, br = p->br;
+    ltfat_int b = L / M, N = L / a, twoN = 2 * N;
+    ltfat_int ar = a * b / br, Mr = L / br, Nr = L / ar;
+    const long long s0 = p->s0, s1 = p->s1;
+
+    if (s0 == 0)
+    {
+        const long long cc3 = ltfat_positiverem_long(s1 * (L + 1), twoN);
+        const long long tmp1 = ltfat_positiverem_long(cc3 * a, twoN);
+
+        for (ltfat_int k = 0; k < N; k++)
+        {
+            long long phsidx = ltfat_positiverem_long((tmp1 * k) % twoN * k, twoN);
+            const long long part1 = ltfat_positiverem_long(-s1 * k * a, L);
+            for (ltfat_int m = 0; m < M; m++)
+            {
+                ltfat_int idx2 = ((part1 + b * m) % L) / b;
+                p->outidx[m + k * M] = idx2 + k * M;
+                p->phase[m + k * M] = finalmod[phsidx];
+            }
+        }
+    }
+    else
+    {
+        const long long cc1 = ar / a;
+        const long long cc2 = ltfat_positiverem_long(-s0 * br / a, twoN);
+        const long long cc3 = ltfat_positiverem_long(a * s1 * (L + 1), twoN);
+        const long long cc4 = ltfat_positiverem_long(cc2 * br * (L + 1), twoN);
+        const long long cc5 = ltfat_positiverem_long(2 * cc1 * br, twoN);
+        const long long cc6 = ltfat_positiverem_long((s0 * s1 + 1) * br, L);
+
+        for (ltfat_int k = 0; k < Nr; k++)
+        {
+            const long long part1 = ltfat_positiverem_long(-s1 * k * ar, L);
+            for (ltfat_int m = 0; m < Mr; m++)
+            {
+                const long long sq1 = k * cc1 + cc2 * m;
+                long long phsidx = ltfat_positiverem_long(
+                                       (cc3 * sq1 * sq1) % twoN - (m * (cc4 * m + k * cc5)) % twoN, twoN);
+                ltfat_int idx2 = ((part1 + cc6 * m) % L) / b;
+                ltfat_int inidx = ltfat_positiverem(-k, Nr) + m * Nr;
+
+                p->outidx[inidx] = idx2 + (sq1 % N) * M;
+                p->phase[inidx] = finalmod[phsidx];
+            }
+        }
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_init)(const LTFAT_REAL g[], ltfat_int L, ltfat_int W,
+                               ltfat_int a, ltfat_int M, ltfat_int s0,
+                               ltfat_int s1, ltfat_int br,
+                               const LTFAT_REAL f[], LTFAT_COMPLEX c[],
+                               unsigned flags,
+                               LTFAT_NAME(dgtreal_shear_plan)** pout)
+{
+    LTFAT_NAME(dgtreal_shear_plan)* p = NULL;
+    LTFAT_COMPLEX* gwork = NULL;
+    LTFAT_COMPLEX* finalmod = NULL;
+    ltfat_int b, N, ar;
+
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a (passed %td) must be positive.", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_NOTPOSARG, br > 0, "br (passed %td) must be positive.", br);
+    CHECK(LTFATERR_BADTRALEN, !(L % a) && !(L % M),
+          "L (passed %td) must be divisible by both a=%td and M=%td.", L, a, M);
+
+    b = L / M; N = L / a;
+    CHECK(LTFATERR_BADARG, !(b % br) && !(L % (a * (b / br))),
+          "br (passed %td) must divide b=L/M=%td and L/(a*b/br) must be an integer.",
+          br, b);
+    ar = a * b / br;
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_shear_plan)) );
+    p->L = L; p->W = W; p->a = a; p->M = M;
+    p->s0 = s0; p->s1 = s1; p->br = br; p->f = f; p->c = c;
+
+    if (s0 == 0 && s1 == 0)
+    {
+        // Rectangular lattice, the real DGT writes directly to c
+        CHECKSTATUS(
+            LTFAT_NAME(dgt_long_init)(g, L, W, a, M, f, c, LTFAT_FREQINV,
+                                      flags, &p->rect_real));
+        *pout = p;
+        return status;
+    }
+
+    CHECKMEM( gwork = LTFAT_NAME_COMPLEX(malloc)(L) );
+    CHECKMEM( finalmod = LTFAT_NAME_COMPLEX(malloc)(2 * N) );
+    CHECKMEM( p->fwork = LTFAT_NAME_COMPLEX(malloc)(L * W) );
+    CHECKMEM( p->c_rect = LTFAT_NAME_COMPLEX(malloc)(M * N * W) );
+    CHECKMEM( p->outidx = LTFAT_NEWARRAY(ltfat_int, M * N) );
+    CHECKMEM( p->phase = LTFAT_NAME_COMPLEX(malloc)(M * N) );
+
+    for (ltfat_int l = 0; l < L; l++)
+        gwork[l] = g[l];
+
+    if (s1)
+    {
+        CHECKMEM( p->p1 = LTFAT_NAME_COMPLEX(malloc)(L) );
+        LTFAT_NAME(pchirp)(L, s1, p->p1);
+
+        for (ltfat_int l = 0; l < L; l++)
+            gwork[l] *= p->p1[l];
+    }
+
+    if (s0 == 0)
+    {
+        CHECKSTATUS(
+            LTFAT_NAME_COMPLEX(dgt_long_init)(gwork, L, W, ar, L / br, p->fwork,
+                                              p->c_rect, LTFAT_FREQINV, flags,
+                                              &p->rect_plan));
+    }
+    else
+    {
+        CHECKMEM( p->p0 = LTFAT_NAME_COMPLEX(malloc)(L) );
+        LTFAT_NAME(pchirp)(L, -s0, p->p0);
+
+        if (s1)
+            CHECKSTATUS(
+                LTFAT_NAME_REAL(fft_init)(L, W, p->fwork, p->fwork, flags,
+                                          &p->fc_plan));
+        else
+            // The FFT of the real signal is done column by column into
+            // the first L/2+1 elements of the columns of fwork
+            CHECKSTATUS(
+                LTFAT_NAME_REAL(fftreal_init)(L, 1, (LTFAT_REAL*) p->c_rect,
+                                              p->fwork, flags, &p->fr_plan));
+
+        CHECKSTATUS( LTFAT_NAME_REAL(fft)(gwork, L, 1, gwork));
+
+        for (ltfat_int l = 0; l < L; l++)
+            gwork[l] *= p->p0[l] / ((LTFAT_REAL) L);
+
+        CHECKSTATUS(
+            LTFAT_NAME_COMPLEX(dgt_long_init)(gwork, L, W, br, L / ar, p->fwork,
+                                              p->c_rect, LTFAT_FREQINV, flags,
+                                              &p->rect_plan));
+    }
+
+    for (ltfat_int n = 0; n < 2 * N; n++)
+        finalmod[n] = exp(I * (LTFAT_REAL) M_PI * (LTFAT_REAL)n / ((LTFAT_REAL) N));
+
+    LTFAT_NAME(dgtreal_shear_perm)(p, finalmod);
+
+    LTFAT_SAFEFREEALL(gwork, finalmod);
+    *pout = p;
+    return status;
+error:
+    LTFAT_SAFEFREEALL(gwork, finalmod);
+    if (p) LTFAT_NAME(dgtreal_shear_done)(&p);
+    *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute)(LTFAT_NAME(dgtreal_shear_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECKNULL(p->f); CHECKNULL(p->c);
+    return LTFAT_NAME(dgtreal_shear_execute_newarray)(p, p->f, p->c);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_execute_newarray)(LTFAT_NAME(dgtreal_shear_plan)* p,
+        const LTFAT_REAL f[], LTFAT_COMPLEX c[])
+{
+    ltfat_int L, W, MN;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    L = p->L; W = p->W; MN = p->M * (L / p->a);
+
+    if (p->rect_real)
+        return LTFAT_NAME(dgt_long_execute_newarray)(p->rect_real, f, c);
+
+    if (p->s1)
+    {
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int l = 0; l < L; l++)
+                p->fwork[l + w * L] = f[l + w * L] * p->p1[l];
+
+        if (p->s0)
+            LTFAT_NAME_REAL(fft_execute)(p->fc_plan);
+    }
+    else if (p->s0)
+    {
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            LTFAT_COMPLEX* fw = p->fwork + w * L;
+            LTFAT_NAME_REAL(fftreal_execute_newarray)(p->fr_plan, f + w * L, fw);
+
+            // Hermitian symmetry
+            for (ltfat_int l = L / 2 + 1; l < L; l++)
+                fw[l] = conj(fw[L - l]);
+        }
+    }
+    else
+    {
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int l = 0; l < L; l++)
+                p->fwork[l + w * L] = f[l + w * L];
+    }
+
+    if (p->s0)
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int l = 0; l < L; l++)
+                p->fwork[l + w * L] *= p->p0[l];
+
+    LTFAT_NAME_COMPLEX(dgt_long_execute)(p->rect_plan);
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        const LTFAT_COMPLEX* cr = p->c_rect + w * MN;
+        LTFAT_COMPLEX* cw = c + w * MN;
+
+        for (ltfat_int i = 0; i < MN; i++)
+            cw[p->outidx[i]] = cr[i] * p->phase[i];
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear_done)(LTFAT_NAME(dgtreal_shear_plan)** p)
+{
+    LTFAT_NAME(dgtreal_shear_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->rect_real) LTFAT_NAME(dgt_long_done)(&pp->rect_real);
+    if (pp->rect_plan) LTFAT_NAME_COMPLEX(dgt_long_done)(&pp->rect_plan);
+    if (pp->fr_plan) LTFAT_NAME_REAL(fftreal_done)(&pp->fr_plan);
+    if (pp->fc_plan) LTFAT_NAME_REAL(fft_done)(&pp->fc_plan);
+    LTFAT_SAFEFREEALL(pp->p0, pp->p1, pp->fwork, pp->c_rect, pp->outidx,
+                      pp->phase);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_shear)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                          ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                          ltfat_int s0, ltfat_int s1, ltfat_int br,
+                          LTFAT_COMPLEX c[])
+{
+    LTFAT_NAME(dgtreal_shear_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_shear_init)(g, L, W, a, M, s0, s1, br, f, c,
+                                       FFTW_ESTIMATE, &p));
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_shear_execute)(p));
+error:
+    if (p) LTFAT_NAME(dgtreal_shear_done)(&p);
+    return status;
+}
@@ -122,7 +122,7 @@ error:
 #define THE_SUM_REAL { \
 LTFAT_NAME(fold_array)(fw,gl,plan->ptype==LTFAT_TIMEINV?-glh:n*a-glh,M,sbuf); \
 LTFAT_NAME_REAL(fftreal_execute)(plan->p_small); \
-memcpy(cout+(n*M2+w*M2*N),cbuf,M2*sizeof*cbuf); \
+memcpy(cout + n * cs + w * cws, cbuf, M2 * sizeof * cbuf); \
 }
 
 LTFAT_API int
@@ -131,7 +131,27 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
                                ltfat_int L, ltfat_int W,
                                LTFAT_COMPLEX* cout)
 {
-    ltfat_int a, M, M2, N, gl, glh, glh_d_a;
+    int status = LTFATERR_SUCCESS;
+    ltfat_dgt_layout flayout, clayout;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L must be positive");
+
+    flayout.stride = 1; flayout.chanstride = L;
+    clayout.stride = plan->M / 2 + 1; clayout.chanstride = (L / plan->a) * clayout.stride;
+
+    return LTFAT_NAME(dgtreal_fb_execute_strided)(plan, f, flayout, L, W,
+            cout, clayout);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_fb_execute_strided)(LTFAT_NAME(dgtreal_fb_plan)* plan,
+                                       const LTFAT_REAL* f, ltfat_dgt_layout flayout,
+                                       ltfat_int L, ltfat_int W,
+                                       LTFAT_COMPLEX* cout, ltfat_dgt_layout clayout)
+{
+    ltfat_int a, M, M2, N, gl, glh, glh_d_a, fs, fcs, cs, cws;
     LTFAT_REAL* sbuf, *fw;
     const LTFAT_REAL* fbd;
     LTFAT_COMPLEX* cbuf;
@@ -142,6 +162,10 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
           "L (passed %td) must be greater or equal to gl and divisible by a (passed %td).",
           L, plan->a);
     CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_BADARG, flayout.stride > 0 && flayout.chanstride >= 0,
+          "Invalid input layout {%td, %td}", flayout.stride, flayout.chanstride);
+    CHECK(LTFATERR_BADARG, clayout.stride >= plan->M / 2 + 1 && clayout.chanstride >= 0,
+          "Invalid coefficient layout {%td, %td}", clayout.stride, clayout.chanstride);
 
     /*  --------- initial declarations -------------- */
     a = plan->a;
@@ -153,6 +177,9 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
     cbuf = plan->cbuf;
     fw = plan->fw;
 
+    fs = flayout.stride; fcs = flayout.chanstride;
+    cs = clayout.stride; cws = clayout.chanstride;
+
     /* These are floor operations. */
     glh = plan->gl / 2;
     M2 = M / 2 + 1;
@@ -167,13 +194,13 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
     {
         for (ltfat_int w = 0; w < W; w++)
         {
-            fbd = f + L - (glh - n * a) + L * w;
+            fbd = f + (L - (glh - n * a)) * fs + fcs * w;
             for (ltfat_int l = 0; l < glh - n * a; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+                fw[l]  = fbd[l * fs] * plan->gw[l];
 
-            fbd = f - (glh - n * a) + L * w;
+            fbd = f - (glh - n * a) * fs + fcs * w;
             for (ltfat_int l = glh - n * a; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+                fw[l]  = fbd[l * fs] * plan->gw[l];
 
             THE_SUM_REAL
         }
@@ -184,9 +211,13 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
     {
         for (ltfat_int w = 0; w < W; w++)
         {
-            fbd = f + (n * a - glh + L * w);
-            for (ltfat_int l = 0; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+            fbd = f + (n * a - glh) * fs + fcs * w;
+            if (fs == 1)
+                for (ltfat_int l = 0; l < gl; l++)
+                    fw[l]  = fbd[l] * plan->gw[l];
+            else
+                for (ltfat_int l = 0; l < gl; l++)
+                    fw[l]  = fbd[l * fs] * plan->gw[l];
 
             THE_SUM_REAL
         }
@@ -198,13 +229,13 @@ LTFAT_NAME(dgtreal_fb_execute)(LTFAT_NAME(dgtreal_fb_plan)* plan,
     {
         for (ltfat_int w = 0; w < W; w++)
         {
-            fbd = f + (n * a - glh + L * w);
+            fbd = f + (n * a - glh) * fs + fcs * w;
             for (ltfat_int l = 0; l < L - n * a + glh; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+                fw[l]  = fbd[l * fs] * plan->gw[l];
 
-            fbd = f - (L - n * a + glh) + L * w;
+            fbd = f - (L - n * a + glh) * fs + fcs * w;
             for (ltfat_int l = L - n * a + glh; l < gl; l++)
-                fw[l]  = fbd[l] * plan->gw[l];
+                fw[l]  = fbd[l * fs] * plan->gw[l];
 
             THE_SUM_REAL
         }
@@ -0,0 +1,405 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+struct LTFAT_NAME(dgtreal_lasso_plan)
+{
+    LTFAT_NAME(dgtreal_plan)* p;
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_lasso_type type;
+    ltfat_lasso_alg alg;
+    double C;
+    LTFAT_REAL* f;
+    LTFAT_COMPLEX* c0;       //!< Analysis coefficients of the signal
+    LTFAT_COMPLEX* r;        //!< Analysis of the synthesis of the iterate
+    LTFAT_COMPLEX* z;        //!< FISTA momentum point
+    LTFAT_REAL* gnorm;       //!< Group norms (and then group gains)
+    ltfat_int iter;
+    double relres;
+    LTFAT_NAME(dgtreal_lasso_callback_status)* status_callback;
+    void* status_callback_userdata;
+};
+
+/* The power iteration approaches the upper frame bound from below */
+#define LASSO_FRAMEBOUND_SAFETY 1.05
+
+/* Upper frame bound. In the painless case (gl <= M) the frame operator is
+ * diagonal and the bound is the maximum of the diagonal. Otherwise it is
+ * estimated by the power iteration on the frame operator. */
+static int
+LTFAT_NAME(dgtreal_lasso_framebound)(LTFAT_NAME(dgtreal_lasso_plan)* p,
+                                     const LTFAT_REAL g[], ltfat_int gl,
+                                     double* C)
+{
+    ltfat_int LW = p->L * p->W;
+    double lambda = 0.0;
+    int status = LTFATERR_SUCCESS;
+
+    if (gl <= p->M)
+    {
+        // p->f is not used yet and the diagonal is a-periodic
+        CHECKSTATUS( LTFAT_NAME(gabframediag)(g, gl, p->a, p->M, p->a, p->f));
+        for (ltfat_int l = 0; l < p->a; l++)
+            lambda = fmax(lambda, p->f[l]);
+        CHECK(LTFATERR_NOTAFRAME, lambda > 0, "The frame operator is zero.");
+        *C = lambda;
+        return status;
+    }
+
+    // Deterministic but not too regular starting vector
+    for (ltfat_int l = 0; l < LW; l++)
+        p->f[l] = (LTFAT_REAL) (1.0 + 0.5 * sin(1.234567 * (double) l));
+
+    for (ltfat_int it = 0; it < 200; it++)
+    {
+        double nrm = 0.0, lambdaold = lambda;
+
+        for (ltfat_int l = 0; l < LW; l++)
+            nrm += p->f[l] * p->f[l];
+        nrm = sqrt(nrm);
+        CHECK(LTFATERR_NOTAFRAME, nrm > 0, "The frame operator is zero.");
+
+        for (ltfat_int l = 0; l < LW; l++)
+            p->f[l] = (LTFAT_REAL) (p->f[l] / nrm);
+
+        CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, p->f, p->c0));
+        CHECKSTATUS( LTFAT_NAME(dgtreal_execute_syn_newarray)(p->p, p->c0, p->f));
+
+        // ||Sf|| of the unit norm f, a lower bound of the largest eigenvalue
+        lambda = 0.0;
+        for (ltfat_int l = 0; l < LW; l++)
+            lambda += p->f[l] * p->f[l];
+        lambda = sqrt(lambda);
+
+        if (fabs(lambda - lambdaold) <= 1e-8 * lambda)
+            break;
+    }
+
+    *C = LASSO_FRAMEBOUND_SAFETY * lambda;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_init)(const LTFAT_REAL g[], ltfat_int gl,
+                               ltfat_int L, ltfat_int W, ltfat_int a,
+                               ltfat_int M, ltfat_lasso_type type,
+                               ltfat_lasso_alg alg, double C,
+                               ltfat_dgt_params* params,
+                               LTFAT_NAME(dgtreal_lasso_plan)** pout)
+{
+    LTFAT_NAME(dgtreal_lasso_plan)* p = NULL;
+    ltfat_int M2, N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0 && a > 0 && M > 0,
+          "W, a and M must be positive (passed %td, %td, %td).", W, a, M);
+    CHECK(LTFATERR_BADARG, type == LTFAT_LASSO || type == LTFAT_GROUPLASSO_TIME ||
+          type == LTFAT_GROUPLASSO_FREQ, "Unknown LASSO type.");
+    CHECK(LTFATERR_BADARG, alg == LTFAT_ISTA || alg == LTFAT_FISTA,
+          "Unknown algorithm.");
+
+    M2 = M / 2 + 1; N = L / a;
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_lasso_plan)) );
+    p->L = L; p->W = W; p->a = a; p->M = M; p->type = type; p->alg = alg;
+
+    CHECKMEM( p->f = LTFAT_NAME_REAL(malloc)(L * W) );
+    CHECKMEM( p->c0 = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W) );
+    CHECKMEM( p->r = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W) );
+
+    if (alg == LTFAT_FISTA)
+        CHECKMEM( p->z = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W) );
+
+    if (type == LTFAT_GROUPLASSO_TIME)
+        CHECKMEM( p->gnorm = LTFAT_NAME_REAL(malloc)(N * W) );
+    else if (type == LTFAT_GROUPLASSO_FREQ)
+        CHECKMEM( p->gnorm = LTFAT_NAME_REAL(malloc)(M2 * W) );
+
+    // Synthesis with the same window is the adjoint of the analysis
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_init_gen)(g, gl, g, gl, L, W, a, M, p->f, p->c0,
+                                     params, &p->p));
+
+    if (C > 0.0)
+        p->C = C;
+    else
+        CHECKSTATUS( LTFAT_NAME(dgtreal_lasso_framebound)(p, g, gl, &p->C));
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(dgtreal_lasso_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_done)(LTFAT_NAME(dgtreal_lasso_plan)** p)
+{
+    LTFAT_NAME(dgtreal_lasso_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->p) LTFAT_NAME(dgtreal_done)(&pp->p);
+    LTFAT_SAFEFREEALL(pp->f, pp->c0, pp->r, pp->z, pp->gnorm);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_set_status_callback)(
+    LTFAT_NAME(dgtreal_lasso_plan)* p,
+    LTFAT_NAME(dgtreal_lasso_callback_status)* callback, void* userdata)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(callback);
+    p->status_callback = callback;
+    p->status_callback_userdata = userdata;
+error:
+    return status;
+}
+
+/* Gradient step, soft thresholding, FISTA momentum and the convergence
+ * measure in a single pass.
+ * v = x + (c0 - r)/C, cnew = soft(v, thr), z = cnew + beta*(cnew - c) */
+static void
+LTFAT_NAME(dgtreal_lasso_kernel)(const LTFAT_COMPLEX x[], const LTFAT_COMPLEX c0[],
+                                 const LTFAT_COMPLEX r[], ltfat_int n,
+                                 LTFAT_REAL invC, LTFAT_REAL thr, LTFAT_REAL beta,
+                                 LTFAT_COMPLEX c[], LTFAT_COMPLEX z[],
+                                 double* dnorm, double* cnorm)
+{
+    double dn = 0.0, cn = 0.0;
+
+    for (ltfat_int ii = 0; ii < n; ii++)
+    {
+        LTFAT_COMPLEX v = x[ii] + (c0[ii] - r[ii]) * invC;
+        LTFAT_REAL mag = sqrt(ltfat_energy(v));
+        LTFAT_COMPLEX cnew = mag > thr ? v * (1 - thr / mag) : 0;
+        LTFAT_COMPLEX d = cnew - c[ii];
+
+        dn += ltfat_energy(d);
+        cn += ltfat_energy(c[ii]);
+
+        if (z) z[ii] = cnew + beta * d;
+        c[ii] = cnew;
+    }
+
+    *dnorm += dn; *cnorm += cn;
+}
+
+/* The same for the group thresholding. v is stored in r, gnorm holds the
+ * gain of each group. */
+static void
+LTFAT_NAME(dgtreal_lasso_groupkernel)(LTFAT_COMPLEX r[], ltfat_int n,
+                                      LTFAT_REAL gain, LTFAT_REAL beta,
+                                      LTFAT_COMPLEX c[], LTFAT_COMPLEX z[],
+                                      double* dnorm, double* cnorm)
+{
+    double dn = 0.0, cn = 0.0;
+
+    for (ltfat_int ii = 0; ii < n; ii++)
+    {
+        LTFAT_COMPLEX cnew = r[ii] * gain;
+        LTFAT_COMPLEX d = cnew - c[ii];
+
+        dn += ltfat_energy(d);
+        cn += ltfat_energy(c[ii]);
+
+        if (z) z[ii] = cnew + beta * d;
+        c[ii] = cnew;
+    }
+
+    *dnorm += dn; *cnorm += cn;
+}
+
+static void
+LTFAT_NAME(dgtreal_lasso_groupstep)(LTFAT_NAME(dgtreal_lasso_plan)* p,
+                                    const LTFAT_COMPLEX x[], LTFAT_REAL invC,
+                                    LTFAT_REAL thr, LTFAT_REAL beta,
+                                    LTFAT_COMPLEX c[], double* dnorm, double* cnorm)
+{
+    ltfat_int M2 = p->M / 2 + 1, N = p->L / p->a;
+    ltfat_int ngroups = p->type == LTFAT_GROUPLASSO_TIME ? N * p->W : M2 * p->W;
+    LTFAT_COMPLEX* r = p->r;
+
+    for (ltfat_int k = 0; k < ngroups; k++)
+        p->gnorm[k] = 0;
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            ltfat_int off = w * M2 * N + n * M2;
+            LTFAT_REAL* gn = p->type == LTFAT_GROUPLASSO_TIME ?
+                             p->gnorm + w * N + n : p->gnorm + w * M2;
+
+            for (ltfat_int m = 0; m < M2; m++)
+            {
+                LTFAT_COMPLEX v = x[off + m] + (p->c0[off + m] - r[off + m]) * invC;
+                r[off + m] = v;
+                if (p->type == LTFAT_GROUPLASSO_TIME)
+                    gn[0] += ltfat_energy(v);
+                else
+                    gn[m] += ltfat_energy(v);
+            }
+        }
+    }
+
+    // Group soft thresholding: scale by max(0, 1 - thr/||group||)
+    for (ltfat_int k = 0; k < ngroups; k++)
+    {
+        LTFAT_REAL nrm = sqrt(p->gnorm[k]);
+        p->gnorm[k] = nrm > thr ? 1 - thr / nrm : 0;
+    }
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            ltfat_int off = w * M2 * N + n * M2;
+            LTFAT_COMPLEX* z = p->z ? p->z + off : NULL;
+
+            if (p->type == LTFAT_GROUPLASSO_TIME)
+            {
+                LTFAT_NAME(dgtreal_lasso_groupkernel)(r + off, M2,
+                                                      p->gnorm[w * N + n], beta,
+                                                      c + off, z, dnorm, cnorm);
+            }
+            else
+            {
+                for (ltfat_int m = 0; m < M2; m++)
+                    LTFAT_NAME(dgtreal_lasso_groupkernel)(r + off + m, 1,
+                                                          p->gnorm[w * M2 + m], beta,
+                                                          c + off + m, z ? z + m : NULL,
+                                                          dnorm, cnorm);
+            }
+        }
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso_execute)(LTFAT_NAME(dgtreal_lasso_plan)* p,
+                                  const LTFAT_REAL f[], double lambda,
+                                  ltfat_int maxit, double tol,
+                                  LTFAT_COMPLEX c[])
+{
+    ltfat_int M2, N, ncoef;
+    double tau0 = 1.0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADARG, lambda >= 0.0, "lambda cannot be negative");
+    CHECK(LTFATERR_NOTPOSARG, maxit > 0, "maxit (passed %td) must be positive.", maxit);
+
+    M2 = p->M / 2 + 1; N = p->L / p->a; ncoef = M2 * N * p->W;
+    p->iter = 0; p->relres = 1e16;
+
+    CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, f, p->c0));
+    memcpy(c, p->c0, ncoef * sizeof * c);
+    if (p->z)
+        memcpy(p->z, p->c0, ncoef * sizeof * c);
+
+    while (p->iter < maxit && p->relres >= tol)
+    {
+        const LTFAT_COMPLEX* x = p->z ? p->z : c;
+        LTFAT_REAL invC = (LTFAT_REAL) (1.0 / p->C);
+        LTFAT_REAL thr = (LTFAT_REAL) (lambda / p->C);
+        LTFAT_REAL beta = 0;
+        double dnorm = 0.0, cnorm = 0.0;
+
+        if (p->alg == LTFAT_FISTA)
+        {
+            double tau = 0.5 * (1.0 + sqrt(1.0 + 4.0 * tau0 * tau0));
+            beta = (LTFAT_REAL) ((tau0 - 1.0) / tau);
+            tau0 = tau;
+        }
+
+        CHECKSTATUS( LTFAT_NAME(dgtreal_execute_syn_newarray)(p->p, x, p->f));
+        CHECKSTATUS( LTFAT_NAME(dgtreal_execute_ana_newarray)(p->p, p->f, p->r));
+
+        if (p->type == LTFAT_LASSO)
+            LTFAT_NAME(dgtreal_lasso_kernel)(x, p->c0, p->r, ncoef, invC, thr,
+                                             beta, c, p->z, &dnorm, &cnorm);
+        else
+            LTFAT_NAME(dgtreal_lasso_groupstep)(p, x, invC, thr, beta, c,
+                                                &dnorm, &cnorm);
+
+        p->relres = cnorm > 0.0 ? sqrt(dnorm / cnorm) : (dnorm > 0.0 ? 1e16 : 0.0);
+        p->iter++;
+
+        if (p->status_callback)
+        {
+            int retstatus = p->status_callback(p->p, p->status_callback_userdata,
+                                               c, p->L, p->W, p->a, p->M,
+                                               &lambda, p->relres, p->iter);
+            if (retstatus > 0)
+                break;
+            else
+                CHECKSTATUS(retstatus);
+
+            CHECK(LTFATERR_BADARG, lambda >= 0.0, "lambda cannot be negative");
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_lasso_get_iter)(LTFAT_NAME(dgtreal_lasso_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->iter;
+error:
+    return status;
+}
+
+LTFAT_API double
+LTFAT_NAME(dgtreal_lasso_get_relres)(LTFAT_NAME(dgtreal_lasso_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->relres;
+error:
+    return status;
+}
+
+LTFAT_API double
+LTFAT_NAME(dgtreal_lasso_get_C)(LTFAT_NAME(dgtreal_lasso_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->C;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_lasso)(const LTFAT_REAL f[], const LTFAT_REAL g[],
+                          ltfat_int gl, ltfat_int L, ltfat_int W,
+                          ltfat_int a, ltfat_int M, ltfat_lasso_type type,
+                          ltfat_lasso_alg alg, double lambda, ltfat_int maxit,
+                          double tol, LTFAT_COMPLEX c[])
+{
+    LTFAT_NAME(dgtreal_lasso_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_lasso_init)(g, gl, L, W, a, M, type, alg, 0.0,
+                                       NULL, &p));
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_lasso_execute)(p, f, lambda, maxit, tol, c));
+
+error:
+    if (p) LTFAT_NAME(dgtreal_lasso_done)(&p);
+    return status;
+}
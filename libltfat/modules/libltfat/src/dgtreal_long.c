@@ -73,6 +73,8 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
 
     plan->cout = cout;
     plan->f    = f;
+    plan->flayout.stride = 1; plan->flayout.chanstride = L;
+    plan->clayout.stride = M / 2 + 1; plan->clayout.chanstride = N * (M / 2 + 1);
     CHECKMEM( plan->sbuf = LTFAT_NAME_REAL(malloc)( d ));
     CHECKMEM( plan->cbuf = LTFAT_NAME_COMPLEX(malloc)(d2));
     CHECKMEM( plan->ff = LTFAT_NAME_REAL(malloc)(2 * d2 * p * q * W));
@@ -89,6 +91,12 @@ LTFAT_NAME(dgtreal_long_init)( const LTFAT_REAL* g,
         LTFAT_NAME(fftreal_init)(M, N * W,
                                  (LTFAT_REAL*) cout, cout, flags, &plan->p_veryend));
 
+    // Columns of a strided coefficient array need not be aligned
+    CHECKSTATUS(
+        LTFAT_NAME(fftreal_init)(M, 1,
+                                 (LTFAT_REAL*) cout, cout, flags | FFTW_UNALIGNED,
+                                 &plan->p_column));
+
     CHECKSTATUS(
         LTFAT_NAME(fftreal_init)(d, 1, plan->sbuf, plan->cbuf, flags, &plan->p_before));
 
@@ -110,6 +118,7 @@ LTFAT_NAME(dgtreal_long_done)(LTFAT_NAME(dgtreal_long_plan)** plan)
     CHECKNULL(plan); CHECKNULL(*plan);
     pp = *plan;
     if (pp->p_veryend) LTFAT_NAME(fftreal_done)(&pp->p_veryend);
+    if (pp->p_column)  LTFAT_NAME(fftreal_done)(&pp->p_column);
     if (pp->p_before)  LTFAT_NAME(fftreal_done)(&pp->p_before);
     if (pp->p_after)   LTFAT_NAME(ifftreal_done)(&pp->p_after);
     LTFAT_SAFEFREEALL(pp->sbuf, pp->cbuf,// pp->cwork,
@@ -144,33 +153,73 @@ error:
 LTFAT_API int
 LTFAT_NAME(dgtreal_long_execute_newarray)(LTFAT_NAME(dgtreal_long_plan)* plan,
         const LTFAT_REAL* f, LTFAT_COMPLEX* c)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+
+    return LTFAT_NAME(dgtreal_long_execute_strided)(plan, f, plan->flayout,
+            c, plan->clayout);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_long_execute_strided)(LTFAT_NAME(dgtreal_long_plan)* plan,
+        const LTFAT_REAL* f, ltfat_dgt_layout flayout,
+        LTFAT_COMPLEX* c, ltfat_dgt_layout clayout)
 {
     int status = LTFATERR_SUCCESS;
     LTFAT_NAME(dgtreal_long_plan) plan2;
-    ltfat_int M2;
+    ltfat_int M2, N;
 
     CHECKNULL(plan); CHECKNULL(f); CHECKNULL(c);
     M2 = plan->M / 2 + 1;
+    N = plan->L / plan->a;
+    CHECK(LTFATERR_BADARG, flayout.stride > 0 && flayout.chanstride >= 0,
+          "Invalid input layout {%td, %td}", flayout.stride, flayout.chanstride);
+    CHECK(LTFATERR_BADARG, clayout.stride >= M2 && clayout.chanstride >= 0,
+          "Invalid coefficient layout {%td, %td}", clayout.stride, clayout.chanstride);
 
-    // Make a shallow copy of the plan and overwrite f
+    // Make a shallow copy of the plan and overwrite f, c and the layouts
     plan2 = *plan;
     plan2.f = f;
     plan2.cout = c;
+    plan2.flayout = flayout;
+    plan2.clayout = clayout;
 
     LTFAT_NAME(dgtreal_walnut_plan)(&plan2);
 
-    if (plan->ptype == LTFAT_TIMEINV)
-        LTFAT_NAME_REAL(dgtphaselockhelper)((LTFAT_REAL*)c, plan->L, plan->W, plan->a,
-                                            2 * M2, plan->M, (LTFAT_REAL*) c);
+    if (clayout.stride == M2 && clayout.chanstride == N * M2)
+    {
+        if (plan->ptype == LTFAT_TIMEINV)
+            LTFAT_NAME_REAL(dgtphaselockhelper)((LTFAT_REAL*)c, plan->L, plan->W, plan->a,
+                                                2 * M2, plan->M, (LTFAT_REAL*) c);
+
+        LTFAT_NAME(fftreal_execute_newarray)(plan->p_veryend, (LTFAT_REAL*)c, c);
+    }
+    else
+    {
+        // p_veryend assumes the default layout, transform the columns one by one
+        for (ltfat_int w = 0; w < plan->W; w++)
+        {
+            for (ltfat_int n = 0; n < N; n++)
+            {
+                LTFAT_COMPLEX* ccol = c + n * clayout.stride + w * clayout.chanstride;
 
-    /* FFTW new array execute function */
-    LTFAT_NAME(fftreal_execute_newarray)(plan->p_veryend, (LTFAT_REAL*)c, c);
+                if (plan->ptype == LTFAT_TIMEINV)
+                    LTFAT_NAME_REAL(circshift)((LTFAT_REAL*) ccol, plan->M,
+                                               -plan->a * n, (LTFAT_REAL*) ccol);
+
+                LTFAT_NAME(fftreal_execute_newarray)(plan->p_column,
+                                                     (LTFAT_REAL*) ccol, ccol);
+            }
+        }
+    }
 
 error:
     return status;
 }
 
-
 /*  This routine computes the DGT factorization using strided FFTs so
     the memory layout is optimized for the matrix product. Compared to
     dgt_fac_1, it moves the r-loop to be the outermost loop to
@@ -198,7 +247,6 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
     ltfat_int p = a / c;
     ltfat_int q = M / c;
     ltfat_int d = N / q;
-    ltfat_int M2 = M / 2 + 1;
 
 
     /* This is a floor operation. */
@@ -214,6 +262,9 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
 
     LTFAT_REAL* cout = (LTFAT_REAL*) plan->cout;
 
+    ltfat_int fs = plan->flayout.stride;
+    ltfat_int fcs = plan->flayout.chanstride;
+
 
     LTFAT_REAL* gbase, *fbase, *cbase;
 
@@ -236,7 +287,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
     {
         /*  ---------- compute signal factorization ----------- */
         ffp = plan->ff;
-        fp = f + r;
+        fp = f + r * fs;
         if (p == 1)
         {
             /* Integer oversampling case */
@@ -246,7 +297,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                 {
                     for (ltfat_int s = 0; s < d; s++)
                     {
-                        sbuf[s]   = fp[(s * M + l * a) % L];
+                        sbuf[s]   = fp[((s * M + l * a) % L) * fs];
                     }
 
                     LTFAT_NAME(fftreal_execute)(plan->p_before);
@@ -258,7 +309,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                     }
                     ffp += 2;
                 }
-                fp += L;
+                fp += fcs;
             }
             /* fp -= 2 * L * W; */
         }
@@ -274,7 +325,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                     {
                         for (ltfat_int s = 0; s < d; s++)
                         {
-                            sbuf[s]   = fp[ ltfat_positiverem(k * M + s * p * M - l * h_a * a, L) ];
+                            sbuf[s]   = fp[ ltfat_positiverem(k * M + s * p * M - l * h_a * a, L) * fs ];
                         }
 
                         LTFAT_NAME(fftreal_execute)(plan->p_before);
@@ -287,7 +338,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                         ffp += 2;
                     }
                 }
-                fp += L;
+                fp += fcs;
             }
             /* fp -= 2 * L * W; */
         }
@@ -361,7 +412,8 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
 
         /*  -------  compute inverse coefficient factorization ------- */
         LTFAT_REAL* cfp = plan->cf;
-        ltfat_int ld5c = 2 * M2 * N;
+        ltfat_int ld5c = 2 * plan->clayout.chanstride;
+        ltfat_int ldc = 2 * plan->clayout.stride;
 
         /* Cover both integer and rational sampling case */
         for (ltfat_int w = 0; w < W; w++)
@@ -385,7 +437,7 @@ LTFAT_NAME(dgtreal_walnut_plan)(LTFAT_NAME(dgtreal_long_plan)* plan)
                     for (ltfat_int s = 0; s < d; s++)
                     {
                         cout[ r + l * c + ltfat_positiverem(u + s * q - l * h_a,
-                                                            N) * 2 * M2 + w * ld5c ] = sbuf[s];
+                                                            N) * ldc + w * ld5c ] = sbuf[s];
                     }
                 }
             }
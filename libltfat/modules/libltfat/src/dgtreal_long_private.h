@@ -16,6 +16,7 @@ struct LTFAT_NAME(dgtreal_long_plan)
     LTFAT_NAME(fftreal_plan)* p_before;
     LTFAT_NAME(ifftreal_plan)* p_after;
     LTFAT_NAME(fftreal_plan)* p_veryend;
+    LTFAT_NAME(fftreal_plan)* p_column; // Single in-place column FFT
     LTFAT_REAL* sbuf;
     LTFAT_COMPLEX* cbuf;
     const LTFAT_REAL* f;
@@ -23,4 +24,6 @@ struct LTFAT_NAME(dgtreal_long_plan)
     LTFAT_REAL* cwork;
     LTFAT_COMPLEX* cout;
     LTFAT_REAL* ff, *cf;
+    ltfat_dgt_layout flayout;
+    ltfat_dgt_layout clayout;
 };
@@ -0,0 +1,509 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "ltfat/thirdparty/fftw3.h"
+#include "dgtreal_olastream_private.h"
+
+/* Smallest multiple of lcm(a,M) which can hold a block and a window */
+static ltfat_int
+LTFAT_NAME(olastream_extlen)(ltfat_int bl, ltfat_int gl, ltfat_int a, ltfat_int M)
+{
+    ltfat_int minL = ltfat_lcm(a, M);
+    return ltfat_idivceil(bl + gl, minL) * minL;
+}
+
+static int
+LTFAT_NAME(olastream_twiddles)(ltfat_int M, LTFAT_REAL sgn, LTFAT_COMPLEX** twid)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKMEM( *twid = LTFAT_NAME_COMPLEX(malloc)(M) );
+
+    for (ltfat_int q = 0; q < M; q++)
+    {
+        LTFAT_REAL arg = sgn * 2.0 * M_PI * q / M;
+        (*twid)[q] = exp(I * arg);
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                   ltfat_int W, ltfat_int a, ltfat_int M,
+                                   ltfat_int bl, const ltfat_phaseconvention ptype,
+                                   unsigned flags,
+                                   LTFAT_NAME(dgtreal_olastream_state)** pout)
+{
+    LTFAT_NAME(dgtreal_olastream_state)* p = NULL;
+    LTFAT_REAL* gext = NULL;
+    ltfat_int kfwd;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive", gl);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a (passed %td) must be positive.", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_NOTPOSARG, bl > 0, "bl (passed %td) must be positive.", bl);
+    CHECK(LTFATERR_BADARG, !(bl % a),
+          "bl (passed %td) must be divisible by a (passed %td).", bl, a);
+    CHECK(LTFATERR_CANNOTHAPPEN, ltfat_phaseconvention_is_valid(ptype),
+          "Invalid ltfat_phaseconvention enum value." );
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dgtreal_olastream_state)) );
+    p->a = a; p->M = M; p->M2 = M / 2 + 1; p->W = W; p->bl = bl;
+    p->ptype = ptype;
+    p->Lext = LTFAT_NAME(olastream_extlen)(bl, gl, a, M);
+    p->Nblock = bl / a;
+    p->Nblocke = p->Lext / a;
+
+    /* Block columns whose window still reaches into the block directly,
+     * the remaining ones wrap around and belong to the previous block. */
+    kfwd = ltfat_idivceil(bl + gl / 2, a);
+    p->nback = p->Nblocke - kfwd;
+
+    CHECKMEM( gext = LTFAT_NAME_REAL(malloc)(p->Lext) );
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(calloc)(p->Lext * W) );
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(p->M2 * p->Nblocke * W) );
+    CHECKMEM( p->acc = LTFAT_NAME_COMPLEX(calloc)(p->M2 * p->Nblocke * W) );
+
+    if (ptype == LTFAT_FREQINV)
+        CHECKSTATUS( LTFAT_NAME(olastream_twiddles)(M, -1.0, &p->twid));
+
+    LTFAT_NAME(fir2long)(g, gl, p->Lext, gext);
+
+    /* The block plan works with the local time. Since Lext is divisible by M,
+     * the time invariant phase is the same for the wrapped columns. */
+    CHECKSTATUS(
+        LTFAT_NAME(dgtreal_long_init)(gext, p->Lext, W, a, M, p->buf, p->cbuf,
+                                      LTFAT_TIMEINV, flags, &p->plan));
+
+    ltfat_free(gext);
+    *pout = p;
+    return status;
+error:
+    ltfat_safefree(gext);
+    if (p) LTFAT_NAME(dgtreal_olastream_done)(&p);
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_olastream_get_outcols)(LTFAT_NAME(dgtreal_olastream_state)* p,
+        ltfat_int Lin)
+{
+    ltfat_int nblocks2;
+    if (!p || Lin < 0) return -1;
+
+    nblocks2 = p->nblocks + (p->bufpos + Lin) / p->bl;
+    return ltfat_imax(0, nblocks2 * p->Nblock - p->nback) -
+           ltfat_imax(0, p->nblocks * p->Nblock - p->nback);
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(dgtreal_olastream_get_flushcols)(LTFAT_NAME(dgtreal_olastream_state)* p)
+{
+    if (!p) return -1;
+
+    return ltfat_idivceil(p->nblocks * p->bl + p->bufpos, p->a) -
+           ltfat_imax(0, p->nblocks * p->Nblock - p->nback);
+}
+
+static void
+LTFAT_NAME(dgtreal_olastream_addblock)(LTFAT_NAME(dgtreal_olastream_state)* p)
+{
+    ltfat_int M2 = p->M2, Nblocke = p->Nblocke, nback = p->nback;
+
+    LTFAT_NAME(dgtreal_long_execute)(p->plan);
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        LTFAT_COMPLEX* accw = p->acc + w * M2 * Nblocke;
+        LTFAT_COMPLEX* cw = p->cbuf + w * M2 * Nblocke;
+
+        /* Columns belonging to this block */
+        for (ltfat_int ii = 0; ii < M2 * (Nblocke - nback); ii++)
+            accw[M2 * nback + ii] += cw[ii];
+
+        /* Columns wrapped from the previous block */
+        for (ltfat_int ii = 0; ii < M2 * nback; ii++)
+            accw[ii] += cw[M2 * (Nblocke - nback) + ii];
+    }
+}
+
+/* Copies pending columns [0,ncols) with nonnegative time index to c */
+static void
+LTFAT_NAME(dgtreal_olastream_emit)(LTFAT_NAME(dgtreal_olastream_state)* p,
+                                   ltfat_int ncols, LTFAT_COMPLEX c[],
+                                   ltfat_int N, ltfat_int* cpos)
+{
+    ltfat_int M = p->M, M2 = p->M2, Nblocke = p->Nblocke;
+    ltfat_int nstart = p->nblocks * p->Nblock - p->nback;
+    ltfat_int jstart = ltfat_imax(0, -nstart);
+
+    for (ltfat_int j = jstart; j < ncols; j++)
+    {
+        ltfat_int nmod = ((nstart + j) * p->a) % M;
+
+        for (ltfat_int w = 0; w < p->W; w++)
+        {
+            const LTFAT_COMPLEX* accp = p->acc + j * M2 + w * M2 * Nblocke;
+            LTFAT_COMPLEX* cp = c + *cpos * M2 + w * M2 * N;
+
+            if (p->twid)
+                for (ltfat_int m = 0; m < M2; m++)
+                    cp[m] = accp[m] * p->twid[(m * nmod) % M];
+            else
+                memcpy(cp, accp, M2 * sizeof * cp);
+        }
+        (*cpos)++;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_execute)(LTFAT_NAME(dgtreal_olastream_state)* p,
+                                      const LTFAT_REAL f[], ltfat_int Lin,
+                                      LTFAT_COMPLEX c[], ltfat_int* Nout)
+{
+    ltfat_int N, pos = 0, cpos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, Lin >= 0, "Lin (passed %td) must be nonnegative.", Lin);
+    if (Lin > 0) CHECKNULL(f);
+
+    N = LTFAT_NAME(dgtreal_olastream_get_outcols)(p, Lin);
+    if (N > 0) CHECKNULL(c);
+
+    while (pos < Lin)
+    {
+        ltfat_int chunk = ltfat_imin(p->bl - p->bufpos, Lin - pos);
+        ltfat_int M2 = p->M2, Nblocke = p->Nblocke, Nblock = p->Nblock;
+
+        for (ltfat_int w = 0; w < p->W; w++)
+            memcpy(p->buf + w * p->Lext + p->bufpos, f + pos + w * Lin,
+                   chunk * sizeof * f);
+
+        p->bufpos += chunk;
+        pos += chunk;
+
+        if (p->bufpos == p->bl)
+        {
+            LTFAT_NAME(dgtreal_olastream_addblock)(p);
+            LTFAT_NAME(dgtreal_olastream_emit)(p, Nblock, c, N, &cpos);
+
+            for (ltfat_int w = 0; w < p->W; w++)
+            {
+                LTFAT_COMPLEX* accw = p->acc + w * M2 * Nblocke;
+                memmove(accw, accw + M2 * Nblock,
+                        M2 * (Nblocke - Nblock) * sizeof * accw);
+                LTFAT_NAME_COMPLEX(clear_array)(accw + M2 * (Nblocke - Nblock),
+                                                M2 * Nblock);
+            }
+
+            p->bufpos = 0;
+            p->nblocks++;
+        }
+    }
+
+    if (Nout) *Nout = N;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_flush)(LTFAT_NAME(dgtreal_olastream_state)* p,
+                                    LTFAT_COMPLEX c[], ltfat_int* Nout)
+{
+    ltfat_int N, Ntot, cpos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    N = LTFAT_NAME(dgtreal_olastream_get_flushcols)(p);
+    if (N > 0) CHECKNULL(c);
+
+    Ntot = ltfat_idivceil(p->nblocks * p->bl + p->bufpos, p->a);
+
+    if (p->bufpos > 0)
+    {
+        for (ltfat_int w = 0; w < p->W; w++)
+            memset(p->buf + w * p->Lext + p->bufpos, 0,
+                   (p->bl - p->bufpos) * sizeof * p->buf);
+
+        LTFAT_NAME(dgtreal_olastream_addblock)(p);
+    }
+
+    LTFAT_NAME(dgtreal_olastream_emit)(p,
+                                       Ntot - (p->nblocks * p->Nblock - p->nback),
+                                       c, N, &cpos);
+
+    LTFAT_NAME(dgtreal_olastream_reset)(p);
+    if (Nout) *Nout = N;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_reset)(LTFAT_NAME(dgtreal_olastream_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    LTFAT_NAME_COMPLEX(clear_array)(p->acc, p->M2 * p->Nblocke * p->W);
+    p->bufpos = 0;
+    p->nblocks = 0;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtreal_olastream_done)(LTFAT_NAME(dgtreal_olastream_state)** p)
+{
+    LTFAT_NAME(dgtreal_olastream_state)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->plan) LTFAT_NAME(dgtreal_long_done)(&pp->plan);
+    LTFAT_SAFEFREEALL(pp->buf, pp->cbuf, pp->acc, pp->twid);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_init)(const LTFAT_REAL g[], ltfat_int gl,
+                                    ltfat_int W, ltfat_int a, ltfat_int M,
+                                    ltfat_int bl, const ltfat_phaseconvention ptype,
+                                    unsigned flags,
+                                    LTFAT_NAME(idgtreal_olastream_state)** pout)
+{
+    LTFAT_NAME(idgtreal_olastream_state)* p = NULL;
+    LTFAT_REAL* gext = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKNULL(g); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive", gl);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a (passed %td) must be positive.", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_NOTPOSARG, bl > 0, "bl (passed %td) must be positive.", bl);
+    CHECK(LTFATERR_BADARG, !(bl % a),
+          "bl (passed %td) must be divisible by a (passed %td).", bl, a);
+    CHECK(LTFATERR_CANNOTHAPPEN, ltfat_phaseconvention_is_valid(ptype),
+          "Invalid ltfat_phaseconvention enum value." );
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(idgtreal_olastream_state)) );
+    p->a = a; p->M = M; p->M2 = M / 2 + 1; p->W = W; p->bl = bl;
+    p->ptype = ptype;
+    p->Lext = LTFAT_NAME(olastream_extlen)(bl, gl, a, M);
+    p->Nblock = bl / a;
+    p->Nblocke = p->Lext / a;
+    p->gneg = gl / 2;
+
+    CHECKMEM( gext = LTFAT_NAME_REAL(malloc)(p->Lext) );
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(calloc)(p->M2 * p->Nblocke * W) );
+    CHECKMEM( p->buf = LTFAT_NAME_REAL(malloc)(p->Lext * W) );
+    CHECKMEM( p->acc = LTFAT_NAME_REAL(calloc)(p->Lext * W) );
+
+    if (ptype == LTFAT_FREQINV)
+        CHECKSTATUS( LTFAT_NAME(olastream_twiddles)(M, 1.0, &p->twid));
+
+    LTFAT_NAME(fir2long)(g, gl, p->Lext, gext);
+
+    /* The unused columns of cbuf must stay zero */
+    CHECKSTATUS(
+        LTFAT_NAME(idgtreal_long_init)(gext, p->Lext, W, a, M, p->cbuf, p->buf,
+                                       LTFAT_TIMEINV, flags & ~FFTW_DESTROY_INPUT,
+                                       &p->plan));
+
+    ltfat_free(gext);
+    *pout = p;
+    return status;
+error:
+    ltfat_safefree(gext);
+    if (p) LTFAT_NAME(idgtreal_olastream_done)(&p);
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(idgtreal_olastream_get_outlen)(LTFAT_NAME(idgtreal_olastream_state)* p,
+        ltfat_int Nin)
+{
+    ltfat_int nblocks2;
+    if (!p || Nin < 0) return -1;
+
+    nblocks2 = p->nblocks + (p->bufpos + Nin) / p->Nblock;
+    return ltfat_imax(0, nblocks2 * p->bl - p->gneg) -
+           ltfat_imax(0, p->nblocks * p->bl - p->gneg);
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(idgtreal_olastream_get_flushlen)(LTFAT_NAME(idgtreal_olastream_state)* p)
+{
+    if (!p) return -1;
+
+    return (p->nblocks * p->Nblock + p->bufpos) * p->a -
+           ltfat_imax(0, p->nblocks * p->bl - p->gneg);
+}
+
+static void
+LTFAT_NAME(idgtreal_olastream_addblock)(LTFAT_NAME(idgtreal_olastream_state)* p)
+{
+    ltfat_int Lext = p->Lext, gneg = p->gneg;
+
+    LTFAT_NAME(idgtreal_long_execute)(p->plan);
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        LTFAT_REAL* accw = p->acc + w * Lext;
+        LTFAT_REAL* fw = p->buf + w * Lext;
+
+        /* Samples wrapped from the end of the block belong to the previous one */
+        for (ltfat_int ii = 0; ii < gneg; ii++)
+            accw[ii] += fw[Lext - gneg + ii];
+
+        for (ltfat_int ii = 0; ii < Lext - gneg; ii++)
+            accw[gneg + ii] += fw[ii];
+    }
+}
+
+/* Copies pending samples [0,len) with nonnegative time index to f */
+static void
+LTFAT_NAME(idgtreal_olastream_emit)(LTFAT_NAME(idgtreal_olastream_state)* p,
+                                    ltfat_int len, LTFAT_REAL f[],
+                                    ltfat_int L, ltfat_int* fpos)
+{
+    ltfat_int lstart = p->nblocks * p->bl - p->gneg;
+    ltfat_int jstart = ltfat_imax(0, -lstart);
+
+    if (len <= jstart) return;
+
+    for (ltfat_int w = 0; w < p->W; w++)
+        memcpy(f + *fpos + w * L, p->acc + jstart + w * p->Lext,
+               (len - jstart) * sizeof * f);
+
+    *fpos += len - jstart;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_execute)(LTFAT_NAME(idgtreal_olastream_state)* p,
+                                       const LTFAT_COMPLEX c[], ltfat_int Nin,
+                                       LTFAT_REAL f[], ltfat_int* Lout)
+{
+    ltfat_int L, pos = 0, fpos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, Nin >= 0, "Nin (passed %td) must be nonnegative.", Nin);
+    if (Nin > 0) CHECKNULL(c);
+
+    L = LTFAT_NAME(idgtreal_olastream_get_outlen)(p, Nin);
+    if (L > 0) CHECKNULL(f);
+
+    while (pos < Nin)
+    {
+        ltfat_int chunk = ltfat_imin(p->Nblock - p->bufpos, Nin - pos);
+        ltfat_int M = p->M, M2 = p->M2, Lext = p->Lext, bl = p->bl;
+
+        for (ltfat_int w = 0; w < p->W; w++)
+        {
+            const LTFAT_COMPLEX* cw = c + pos * M2 + w * M2 * Nin;
+            LTFAT_COMPLEX* cbufw = p->cbuf + p->bufpos * M2 + w * M2 * p->Nblocke;
+
+            if (p->twid)
+            {
+                for (ltfat_int n = 0; n < chunk; n++)
+                {
+                    ltfat_int nmod =
+                        ((p->nblocks * p->Nblock + p->bufpos + n) * p->a) % M;
+                    for (ltfat_int m = 0; m < M2; m++)
+                        cbufw[m + n * M2] = cw[m + n * M2] * p->twid[(m * nmod) % M];
+                }
+            }
+            else
+                memcpy(cbufw, cw, M2 * chunk * sizeof * cw);
+        }
+
+        p->bufpos += chunk;
+        pos += chunk;
+
+        if (p->bufpos == p->Nblock)
+        {
+            LTFAT_NAME(idgtreal_olastream_addblock)(p);
+            LTFAT_NAME(idgtreal_olastream_emit)(p, bl, f, L, &fpos);
+
+            for (ltfat_int w = 0; w < p->W; w++)
+            {
+                LTFAT_REAL* accw = p->acc + w * Lext;
+                memmove(accw, accw + bl, (Lext - bl) * sizeof * accw);
+                memset(accw + Lext - bl, 0, bl * sizeof * accw);
+            }
+
+            p->bufpos = 0;
+            p->nblocks++;
+        }
+    }
+
+    if (Lout) *Lout = L;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_flush)(LTFAT_NAME(idgtreal_olastream_state)* p,
+                                     LTFAT_REAL f[], ltfat_int* Lout)
+{
+    ltfat_int L, Ltot, fpos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    L = LTFAT_NAME(idgtreal_olastream_get_flushlen)(p);
+    if (L > 0) CHECKNULL(f);
+
+    Ltot = (p->nblocks * p->Nblock + p->bufpos) * p->a;
+
+    if (p->bufpos > 0)
+    {
+        for (ltfat_int w = 0; w < p->W; w++)
+            LTFAT_NAME_COMPLEX(clear_array)(p->cbuf + p->M2 * (p->bufpos + w * p->Nblocke),
+                                            p->M2 * (p->Nblock - p->bufpos));
+
+        LTFAT_NAME(idgtreal_olastream_addblock)(p);
+    }
+
+    LTFAT_NAME(idgtreal_olastream_emit)(p, Ltot - (p->nblocks * p->bl - p->gneg),
+                                        f, L, &fpos);
+
+    LTFAT_NAME(idgtreal_olastream_reset)(p);
+    if (Lout) *Lout = L;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_reset)(LTFAT_NAME(idgtreal_olastream_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    memset(p->acc, 0, p->Lext * p->W * sizeof * p->acc);
+    p->bufpos = 0;
+    p->nblocks = 0;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idgtreal_olastream_done)(LTFAT_NAME(idgtreal_olastream_state)** p)
+{
+    LTFAT_NAME(idgtreal_olastream_state)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->plan) LTFAT_NAME(idgtreal_long_done)(&pp->plan);
+    LTFAT_SAFEFREEALL(pp->cbuf, pp->buf, pp->acc, pp->twid);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
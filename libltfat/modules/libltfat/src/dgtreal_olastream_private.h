@@ -0,0 +1,41 @@
+struct LTFAT_NAME(dgtreal_olastream_state)
+{
+    LTFAT_NAME(dgtreal_long_plan)* plan; //!< Block DGT plan working on buf and cbuf
+    LTFAT_REAL* buf;     //!< Input block, Lext x W, samples past bl are always zero
+    LTFAT_COMPLEX* cbuf; //!< Block coefficients, M2 x Nblocke x W
+    LTFAT_COMPLEX* acc;  //!< Pending columns, M2 x Nblocke x W
+    LTFAT_COMPLEX* twid; //!< exp(-2*pi*i*q/M), only for LTFAT_FREQINV
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int M2;
+    ltfat_int W;
+    ltfat_int bl;
+    ltfat_int Lext;
+    ltfat_int Nblock;  //!< bl/a
+    ltfat_int Nblocke; //!< Lext/a
+    ltfat_int nback;   //!< Block columns which wrap to the previous block
+    ltfat_int bufpos;  //!< Samples in the current block
+    ltfat_int nblocks; //!< Blocks processed so far
+    ltfat_phaseconvention ptype;
+};
+
+struct LTFAT_NAME(idgtreal_olastream_state)
+{
+    LTFAT_NAME(idgtreal_long_plan)* plan; //!< Block IDGT plan working on cbuf and buf
+    LTFAT_COMPLEX* cbuf; //!< Input block, M2 x Nblocke x W, columns past Nblock are always zero
+    LTFAT_REAL* buf;     //!< Block output, Lext x W
+    LTFAT_REAL* acc;     //!< Pending samples, Lext x W
+    LTFAT_COMPLEX* twid; //!< exp(2*pi*i*q/M), only for LTFAT_FREQINV
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int M2;
+    ltfat_int W;
+    ltfat_int bl;
+    ltfat_int Lext;
+    ltfat_int Nblock;
+    ltfat_int Nblocke;
+    ltfat_int gneg;    //!< Samples the window reaches to the left, floor(gl/2)
+    ltfat_int bufpos;  //!< Columns in the current block
+    ltfat_int nblocks; //!< Blocks processed so far
+    ltfat_phaseconvention ptype;
+};
@@ -26,9 +26,9 @@ LTFAT_NAME(dgtrealmp_init)(
           L > 0 , "Signal length L must be positive (passed %td)", L);
     CHECK(LTFATERR_BADARG, pb->P > 0 , "No Gabor system set in the plan");
 
-    CHECKSTATUS( LTFAT_NAME(dgtrealmp_init_gen)(
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_init_gen_kernbank)(
                (const LTFAT_REAL**)pb->g, pb->gl, L, pb->P, pb->a, pb->M,
-               pb->params, pout));
+               pb->params, pb->kernbank, pout));
 
     LTFAT_NAME(dgtrealmp_set_iterstepcallback)( *pout,
         pb->iterstepcallback, pb->iterstepcallbackdata);
@@ -43,10 +43,19 @@ LTFAT_API int
 LTFAT_NAME(dgtrealmp_init_gen)(
     const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P, ltfat_int a[],
     ltfat_int M[], ltfat_dgtmp_params* params, LTFAT_NAME(dgtrealmp_state)** pout)
+{
+    return LTFAT_NAME(dgtrealmp_init_gen_kernbank)(
+               g, gl, L, P, a, M, params, NULL, pout);
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_init_gen_kernbank)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P, ltfat_int a[],
+    ltfat_int M[], ltfat_dgtmp_params* params,
+    LTFAT_NAME(dgtrealmp_kernbank)* kernbank,
+    LTFAT_NAME(dgtrealmp_state)** pout)
 {
     int status = LTFATERR_FAILED;
-    const LTFAT_REAL* gtmp[2]; ltfat_int gltmp[2]; ltfat_int atmp[2];
-    ltfat_int Mtmp[2];
     ltfat_int nextL;
     ltfat_int amax = 0, Mmax = 0;
     LTFAT_NAME(dgtrealmp_state)* p = NULL;
@@ -117,22 +126,18 @@ LTFAT_NAME(dgtrealmp_init_gen)(
     if (p->params->iterstep == 0)
         p->params->iterstep = p->params->maxit;
 
-#ifdef NOBLASLAPACK
-    CHECK( LTFATERR_NOBLASLAPACK,
-           p->params->alg != ltfat_dgtmp_alg_locomp,
-           "LocOMP requires LAPACK, but libltfat was compiled without it.");
-#endif
-
     p->params->initwasrun = 1;
 
     CHECKMEM( p->dgtplans  = LTFAT_NEWARRAY( LTFAT_NAME(dgtreal_plan)*, P) );
-    CHECKMEM( p->gramkerns = LTFAT_NEWARRAY( LTFAT_NAME(kerns)*, P * P) );
     CHECKMEM( p->a  = LTFAT_NEWARRAY( ltfat_int, P));
     CHECKMEM( p->M  = LTFAT_NEWARRAY( ltfat_int, P));
     CHECKMEM( p->M2 = LTFAT_NEWARRAY( ltfat_int, P));
     CHECKMEM( p->N  = LTFAT_NEWARRAY( ltfat_int, P));
     CHECKMEM( p->chanmask  = LTFAT_NEWARRAY( int, P));
     CHECKMEM( p->couttmp = LTFAT_NEWARRAY( LTFAT_COMPLEX*, P));
+    CHECKMEM( p->gl = LTFAT_NEWARRAY( ltfat_int, P));
+    CHECKMEM( p->gfir = LTFAT_NEWARRAY( LTFAT_REAL*, P));
+    CHECKMEM( p->twids = LTFAT_NEWARRAY( LTFAT_COMPLEX*, P));
 
     for (ltfat_int k = 0; k < P; k++)
     {
@@ -143,6 +148,23 @@ LTFAT_NAME(dgtrealmp_init_gen)(
 
     p->P = P; p->L = L;
 
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        p->gl[k] = gl[k];
+        CHECKMEM( p->gfir[k] = LTFAT_NAME_REAL(malloc)(gl[k]));
+        memcpy(p->gfir[k], g[k], gl[k] * sizeof * p->gfir[k]);
+
+        CHECKMEM( p->twids[k] = LTFAT_NAME_COMPLEX(malloc)(M[k]));
+        for (ltfat_int m = 0; m < M[k]; m++)
+            p->twids[k][m] = exp( I * (LTFAT_REAL) (2.0 * M_PI * m / M[k]));
+    }
+
+    if (p->params->errresync > 0)
+    {
+        CHECKMEM( p->fref = LTFAT_NAME_REAL(malloc)(L));
+        CHECKMEM( p->fsyn = LTFAT_NAME_REAL(malloc)(L));
+    }
+
     CHECKMEM( dgtparams = ltfat_dgt_params_allocdef());
     ltfat_dgt_setpar_phaseconv(dgtparams, p->params->ptype);
     ltfat_dgt_setpar_synoverwrites(dgtparams, 0);
@@ -156,22 +178,24 @@ LTFAT_NAME(dgtrealmp_init_gen)(
     }
     ltfat_dgt_params_free(dgtparams); dgtparams = NULL;
 
-    for (ltfat_int k1 = 0; k1 < P; k1++)
+    if (kernbank)
     {
-        for (ltfat_int k2 = 0; k2 < P; k2++)
-        {
-            gtmp[0] = g[k1]; gtmp[1] = g[k2];
-            atmp[0] = p->a[k1]; atmp[1] = p->a[k2];
-            Mtmp[0] = p->M[k1]; Mtmp[1] = p->M[k2];
-            gltmp[0] = gl[k1]; gltmp[1] = gl[k2];
-
-            CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernel_init)( gtmp, gltmp,
-                         atmp, Mtmp, L, (LTFAT_REAL) p->params->kernrelthr,
-                         p->params->ptype,
-                         &p->gramkerns[k1 + k2 * P]));
-        }
+        CHECK(LTFATERR_BADARG,
+              LTFAT_NAME(dgtrealmp_kernbank_iscompatible)(
+                  kernbank, g, gl, L, P, a, M, p->params),
+              "The kernel bank was computed for a different setup");
+
+        LTFAT_NAME(dgtrealmp_kernbank_acquire)(kernbank);
+        p->kernbank = kernbank;
+    }
+    else
+    {
+        CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernbank_init)(
+                         g, gl, L, P, a, M, p->params, &p->kernbank));
     }
 
+    p->gramkerns = p->kernbank->kerns;
+
 #ifndef NDEBUG
     /* for(ltfat_int kNo=0;kNo<P;kNo++) */
     /* { */
@@ -301,7 +325,10 @@ LTFAT_NAME(dgtrealmp_reset)(LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL* f)
     istate->err = 0.0;
 
     for (ltfat_int l = 0; l < p->L; l++)
-        istate->err += f[l] * f[l];
+        istate->err += (long double) f[l] * f[l];
+
+    if (p->fref)
+        memcpy(p->fref, f, p->L * sizeof * f);
 
     istate->fnorm2 = istate->err;
     p->params->errtoladj = powl((long double)10.0,
@@ -352,6 +379,10 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
     if (s->fnorm2 == 0.0)
         return LTFAT_DGTREALMP_STATUS_EMPTY;
 
+    // Dense coefficients can be omitted only if there is an atom sink
+    if (!cout && (!p->atomsink || p->params->alg == ltfat_dgtmp_alg_loccyclicmp))
+        return LTFATERR_NULLPOINTER;
+
     for (size_t iter = 0;
          iter < itno && status == LTFAT_DGTREALMP_STATUS_CANCONTINUE;
          iter++)
@@ -389,6 +420,15 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
             break;
         }
 
+        if (p->atomsink && p->atomsink->status < 0)
+            return p->atomsink->status;
+
+        if (p->fref && s->currit % p->params->errresync == 0)
+        {
+            int resyncstatus = LTFAT_NAME(dgtrealmp_execute_errresync)(p, cout);
+            if (resyncstatus < 0) return resyncstatus;
+        }
+
         if (s->err < 0)
             return LTFAT_DGTREALMP_STATUS_STALLED;
 
@@ -406,6 +446,37 @@ LTFAT_NAME(dgtrealmp_execute_niters)(
     return status;
 }
 
+int
+LTFAT_NAME(dgtrealmp_execute_errresync)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX** cout)
+{
+    int status = LTFATERR_SUCCESS;
+    long double err = 0.0;
+
+    if (cout)
+    {
+        CHECKSTATUS(
+            LTFAT_NAME(dgtrealmp_execute_synthesize)(
+                p, (const LTFAT_COMPLEX**) cout, NULL, p->fsyn));
+    }
+    else
+    {
+        CHECKSTATUS(
+            LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+                p, p->atomsink, NULL, p->fsyn));
+    }
+
+    for (ltfat_int l = 0; l < p->L; l++)
+    {
+        long double r = (long double) p->fref[l] - p->fsyn[l];
+        err += r * r;
+    }
+
+    p->iterstate->err = err;
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtrealmp_revert)(
     LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX** cout)
@@ -514,7 +585,16 @@ LTFAT_NAME(dgtrealmp_done)( LTFAT_NAME(dgtrealmp_state)** p)
     CHECKNULL(p); CHECKNULL(*p);
     pp = *p;
 
-    LTFAT_SAFEFREEALL(pp->a,pp->M,pp->M2,pp->N,pp->chanmask,pp->couttmp);
+    if (pp->gfir)
+        for (ltfat_int k = 0; k < pp->P; k++)
+            ltfat_safefree(pp->gfir[k]);
+
+    if (pp->twids)
+        for (ltfat_int k = 0; k < pp->P; k++)
+            ltfat_safefree(pp->twids[k]);
+
+    LTFAT_SAFEFREEALL(pp->a,pp->M,pp->M2,pp->N,pp->chanmask,pp->couttmp,
+                      pp->gl,pp->gfir,pp->twids,pp->fref,pp->fsyn);
 
 
     if (pp->params)
@@ -538,16 +618,10 @@ LTFAT_NAME(dgtrealmp_done)( LTFAT_NAME(dgtrealmp_state)** p)
         pp->dgtplans = NULL;
     }
 
-    if (pp->gramkerns)
-    {
-        for (ltfat_int k = 0; k < pp->P * pp->P; k++)
-        {
-                LTFAT_NAME(dgtrealmp_kernel_done)( &pp->gramkerns[k]);
-        }
+    if (pp->kernbank)
+        LTFAT_NAME(dgtrealmp_kernbank_done)(&pp->kernbank);
 
-        ltfat_free(pp->gramkerns);
-        pp->gramkerns = NULL;
-    }
+    pp->gramkerns = NULL;
 
     if (pp->iterstate)
         LTFAT_NAME(dgtrealmpiter_done)(&pp->iterstate);
@@ -0,0 +1,425 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "dgtrealmp_private.h"
+
+#define DGTREALMP_ATOMS_DEFCAP 1024
+#define DGTREALMP_ATOMS_HEADERLEN 24
+#define DGTREALMP_ATOMS_VERSION 1
+
+static const char dgtrealmp_atoms_magic[8] = {'L', 'T', 'F', 'A', 'T', 'M', 'P', 'A'};
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_init)(
+    size_t capacity, LTFAT_NAME(dgtrealmp_atoms)** atoms)
+{
+    LTFAT_NAME(dgtrealmp_atoms)* a = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms);
+
+    if (capacity == 0) capacity = DGTREALMP_ATOMS_DEFCAP;
+
+    CHECKMEM( a = LTFAT_NEW( LTFAT_NAME(dgtrealmp_atoms) ));
+    CHECKMEM( a->at = LTFAT_NEWARRAY( LTFAT_NAME(dgtrealmp_atom), capacity ));
+    a->atCap = capacity;
+
+    *atoms = a;
+    return status;
+error:
+    if (a) LTFAT_NAME(dgtrealmp_atoms_done)(&a);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_reset)(LTFAT_NAME(dgtrealmp_atoms)* atoms)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms);
+    atoms->atNo = 0;
+    atoms->status = LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_done)(LTFAT_NAME(dgtrealmp_atoms)** atoms)
+{
+    LTFAT_NAME(dgtrealmp_atoms)* a;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms); CHECKNULL(*atoms);
+    a = *atoms;
+
+    ltfat_safefree(a->at);
+    ltfat_free(a);
+    *atoms = NULL;
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_atoms_reserve)(
+    LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t atCap)
+{
+    LTFAT_NAME(dgtrealmp_atom)* newat;
+
+    if (atCap <= atoms->atCap)
+        return LTFATERR_SUCCESS;
+
+    newat = (LTFAT_NAME(dgtrealmp_atom)*) ltfat_realloc(
+                (void*) atoms->at, atoms->atCap * sizeof * atoms->at,
+                atCap * sizeof * atoms->at);
+
+    if (!newat)
+        return LTFATERR_NOMEM;
+
+    atoms->at = newat;
+    atoms->atCap = atCap;
+    return LTFATERR_SUCCESS;
+}
+
+int
+LTFAT_NAME(dgtrealmp_atoms_append)(
+    LTFAT_NAME(dgtrealmp_atoms)* atoms, kpoint pos, LTFAT_COMPLEX cval)
+{
+    LTFAT_NAME(dgtrealmp_atom)* at;
+
+    if (atoms->atNo == atoms->atCap)
+    {
+        int status = LTFAT_NAME(dgtrealmp_atoms_reserve)(
+                         atoms, dgtrealmp_atoms_EXPANDRAT * atoms->atCap);
+        if (status != LTFATERR_SUCCESS)
+        {
+            // Remembered and reported by dgtrealmp_execute_niters
+            atoms->status = status;
+            return status;
+        }
+    }
+
+    at = &atoms->at[atoms->atNo++];
+    at->w = pos.w; at->m = pos.m; at->n = pos.n; at->c = cval;
+    return LTFATERR_SUCCESS;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_get_count)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t* atNo)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms); CHECKNULL(atNo);
+    *atNo = atoms->atNo;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_get)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t idx,
+    ltfat_int* dictid, ltfat_int* m, ltfat_int* n, LTFAT_COMPLEX* c)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms); CHECKNULL(dictid); CHECKNULL(m); CHECKNULL(n); CHECKNULL(c);
+    CHECK(LTFATERR_NOTINRANGE, idx < atoms->atNo,
+          "idx must be smaller than %zu (passed %zu)", atoms->atNo, idx);
+
+    *dictid = atoms->at[idx].w;
+    *m      = atoms->at[idx].m;
+    *n      = atoms->at[idx].n;
+    *c      = atoms->at[idx].c;
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_atoms_cmp)(const void* a1, const void* a2)
+{
+    const LTFAT_NAME(dgtrealmp_atom)* at1 = (const LTFAT_NAME(dgtrealmp_atom)*) a1;
+    const LTFAT_NAME(dgtrealmp_atom)* at2 = (const LTFAT_NAME(dgtrealmp_atom)*) a2;
+
+    if (at1->w != at2->w) return at1->w < at2->w ? -1 : 1;
+    if (at1->n != at2->n) return at1->n < at2->n ? -1 : 1;
+    if (at1->m != at2->m) return at1->m < at2->m ? -1 : 1;
+    return 0;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_compact)(LTFAT_NAME(dgtrealmp_atoms)* atoms)
+{
+    size_t outNo = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms);
+
+    if (atoms->atNo == 0)
+        return status;
+
+    qsort(atoms->at, atoms->atNo, sizeof * atoms->at,
+          LTFAT_NAME(dgtrealmp_atoms_cmp));
+
+    for (size_t ii = 0; ii < atoms->atNo; ii++)
+    {
+        if (outNo > 0 &&
+            LTFAT_NAME(dgtrealmp_atoms_cmp)(&atoms->at[outNo - 1], &atoms->at[ii]) == 0)
+        {
+            atoms->at[outNo - 1].c += atoms->at[ii].c;
+            continue;
+        }
+
+        if (outNo > 0 && ltfat_norm(atoms->at[outNo - 1].c) == 0.0)
+            outNo--;
+
+        atoms->at[outNo++] = atoms->at[ii];
+    }
+
+    if (ltfat_norm(atoms->at[outNo - 1].c) == 0.0)
+        outNo--;
+
+    atoms->atNo = outNo;
+error:
+    return status;
+}
+
+/* Serialization helpers. All fields are stored as little-endian. */
+static void
+dgtrealmp_atoms_putuint(unsigned char* buf, unsigned long long val, size_t bytes)
+{
+    for (size_t ii = 0; ii < bytes; ii++)
+        buf[ii] = (unsigned char) ((val >> (8 * ii)) & 0xFF);
+}
+
+static unsigned long long
+dgtrealmp_atoms_getuint(const unsigned char* buf, size_t bytes)
+{
+    unsigned long long val = 0;
+    for (size_t ii = 0; ii < bytes; ii++)
+        val |= ((unsigned long long) buf[ii]) << (8 * ii);
+    return val;
+}
+
+static void
+LTFAT_NAME(dgtrealmp_atoms_putreal)(unsigned char* buf, LTFAT_REAL val)
+{
+#ifdef LTFAT_DOUBLE
+    unsigned long long bits;
+#else
+    unsigned int bits;
+#endif
+    memcpy(&bits, &val, sizeof val);
+    dgtrealmp_atoms_putuint(buf, bits, sizeof val);
+}
+
+static LTFAT_REAL
+LTFAT_NAME(dgtrealmp_atoms_getreal)(const unsigned char* buf, size_t realbytes)
+{
+    if (realbytes == sizeof(double))
+    {
+        unsigned long long bits = dgtrealmp_atoms_getuint(buf, realbytes);
+        double val; memcpy(&val, &bits, sizeof val);
+        return (LTFAT_REAL) val;
+    }
+    else
+    {
+        unsigned int bits = (unsigned int) dgtrealmp_atoms_getuint(buf, realbytes);
+        float val; memcpy(&val, &bits, sizeof val);
+        return (LTFAT_REAL) val;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_get_serializedsize)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t* size)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms); CHECKNULL(size);
+
+    *size = DGTREALMP_ATOMS_HEADERLEN +
+            atoms->atNo * (3 * 4 + 2 * sizeof(LTFAT_REAL));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_serialize)(
+    const LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t buflen, unsigned char buf[])
+{
+    size_t reqlen = 0;
+    unsigned char* bufPtr = buf;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms); CHECKNULL(buf);
+
+    LTFAT_NAME(dgtrealmp_atoms_get_serializedsize)(atoms, &reqlen);
+    CHECK(LTFATERR_BADREQSIZE, buflen >= reqlen,
+          "Buffer is too small. Required %zu bytes (passed %zu)", reqlen, buflen);
+
+    memcpy(bufPtr, dgtrealmp_atoms_magic, 8);
+    dgtrealmp_atoms_putuint(bufPtr + 8, DGTREALMP_ATOMS_VERSION, 2);
+    dgtrealmp_atoms_putuint(bufPtr + 10, sizeof(LTFAT_REAL), 2);
+    dgtrealmp_atoms_putuint(bufPtr + 12, 0, 4);
+    dgtrealmp_atoms_putuint(bufPtr + 16, atoms->atNo, 8);
+    bufPtr += DGTREALMP_ATOMS_HEADERLEN;
+
+    for (size_t ii = 0; ii < atoms->atNo; ii++)
+    {
+        const LTFAT_NAME(dgtrealmp_atom)* at = &atoms->at[ii];
+        dgtrealmp_atoms_putuint(bufPtr, (unsigned long long) at->w, 4);
+        dgtrealmp_atoms_putuint(bufPtr + 4, (unsigned long long) at->m, 4);
+        dgtrealmp_atoms_putuint(bufPtr + 8, (unsigned long long) at->n, 4);
+        bufPtr += 12;
+        LTFAT_NAME(dgtrealmp_atoms_putreal)(bufPtr, ltfat_real(at->c));
+        bufPtr += sizeof(LTFAT_REAL);
+        LTFAT_NAME(dgtrealmp_atoms_putreal)(bufPtr, ltfat_imag(at->c));
+        bufPtr += sizeof(LTFAT_REAL);
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_atoms_deserialize)(
+    LTFAT_NAME(dgtrealmp_atoms)* atoms, size_t buflen, const unsigned char buf[])
+{
+    size_t atNo, realbytes, reclen;
+    const unsigned char* bufPtr = buf;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(atoms); CHECKNULL(buf);
+    CHECK(LTFATERR_BADARG, buflen >= DGTREALMP_ATOMS_HEADERLEN &&
+          memcmp(buf, dgtrealmp_atoms_magic, 8) == 0,
+          "Buffer does not contain an atom list");
+    CHECK(LTFATERR_BADARG,
+          dgtrealmp_atoms_getuint(buf + 8, 2) == DGTREALMP_ATOMS_VERSION,
+          "Unsupported atom list version %llu",
+          dgtrealmp_atoms_getuint(buf + 8, 2));
+
+    realbytes = (size_t) dgtrealmp_atoms_getuint(buf + 10, 2);
+    CHECK(LTFATERR_BADARG,
+          realbytes == sizeof(double) || realbytes == sizeof(float),
+          "Unsupported real type size %zu", realbytes);
+
+    atNo = (size_t) dgtrealmp_atoms_getuint(buf + 16, 8);
+    reclen = 3 * 4 + 2 * realbytes;
+    CHECK(LTFATERR_BADARG,
+          (buflen - DGTREALMP_ATOMS_HEADERLEN) / reclen >= atNo,
+          "Buffer is truncated");
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_atoms_reserve)(atoms, atNo));
+    bufPtr += DGTREALMP_ATOMS_HEADERLEN;
+
+    for (size_t ii = 0; ii < atNo; ii++)
+    {
+        LTFAT_NAME(dgtrealmp_atom)* at = &atoms->at[ii];
+        at->w = (ltfat_int) dgtrealmp_atoms_getuint(bufPtr, 4);
+        at->m = (ltfat_int) dgtrealmp_atoms_getuint(bufPtr + 4, 4);
+        at->n = (ltfat_int) dgtrealmp_atoms_getuint(bufPtr + 8, 4);
+        bufPtr += 12;
+        LTFAT_REAL re = LTFAT_NAME(dgtrealmp_atoms_getreal)(bufPtr, realbytes);
+        bufPtr += realbytes;
+        LTFAT_REAL im = LTFAT_NAME(dgtrealmp_atoms_getreal)(bufPtr, realbytes);
+        bufPtr += realbytes;
+        at->c = re + I * im;
+    }
+
+    atoms->atNo = atNo;
+    atoms->status = LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_set_atomsink)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_NAME(dgtrealmp_atoms)* atoms)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    p->atomsink = atoms;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_REAL f[],
+    LTFAT_NAME(dgtrealmp_atoms)* atoms)
+{
+    LTFAT_NAME(dgtrealmp_atoms)* oldsink = NULL;
+    int status = LTFATERR_SUCCESS;
+    int status2 = LTFATERR_SUCCESS;
+    int statuscallback = LTFATERR_SUCCESS;
+
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(atoms);
+    CHECK(LTFATERR_NOTSUPPORTED, p->params->alg != ltfat_dgtmp_alg_loccyclicmp,
+          "Cyclic MP needs the dense coefficients.");
+
+    oldsink = p->atomsink;
+    p->atomsink = atoms;
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_atoms_reset)( atoms));
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_reset)( p, f));
+
+    while ( LTFAT_DGTREALMP_STATUS_CANCONTINUE ==
+            ( status2 = LTFAT_NAME(dgtrealmp_execute_niters)(
+                            p, p->params->iterstep, NULL)))
+    {
+        if (p->callback)
+        {
+            statuscallback = p->callback(p->userdata, p, NULL);
+            CHECKSTATUS(statuscallback);
+            if (statuscallback > 0) break;
+        }
+    }
+
+    CHECKSTATUS(status2);
+
+    p->atomsink = oldsink;
+    return status2;
+error:
+    if (p) p->atomsink = oldsink;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(
+    LTFAT_NAME(dgtrealmp_state)* p, const LTFAT_NAME(dgtrealmp_atoms)* atoms,
+    int dict_mask[], LTFAT_REAL f[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(atoms); CHECKNULL(f);
+
+    memset(f, 0, p->L * sizeof * f);
+
+    for (size_t ii = 0; ii < atoms->atNo; ii++)
+    {
+        const LTFAT_NAME(dgtrealmp_atom)* at = &atoms->at[ii];
+        ltfat_int w = at->w;
+
+        CHECK(LTFATERR_NOTINRANGE, w >= 0 && w < p->P,
+              "Atom %zu: dictid %td out of range", ii, w);
+
+        if (dict_mask && !dict_mask[w]) continue;
+
+        ltfat_int M = p->M[w], gl = p->gl[w], glh = gl / 2;
+        ltfat_int m = at->m, n = at->n;
+
+        CHECK(LTFATERR_NOTINRANGE, m >= 0 && m < p->M2[w] && n >= 0 && n < p->N[w],
+              "Atom %zu: m=%td, n=%td out of range", ii, m, n);
+
+        const LTFAT_REAL* g = p->gfir[w];
+        const LTFAT_COMPLEX* twid = p->twids[w];
+        int do_conj = !( m == 0 || (2 * m == M));
+        LTFAT_COMPLEX cval = do_conj ? (LTFAT_REAL) 2.0 * at->c : at->c;
+        ltfat_int na = n * p->a[w];
+
+        // Phase at the first sample of the window
+        ltfat_int ph = p->params->ptype == LTFAT_FREQINV ? na - glh : -glh;
+        ph = (ltfat_int) ((m * (long long) ltfat_positiverem(ph, M)) % M);
+        ltfat_int l = ltfat_positiverem(na - glh, p->L);
+
+        for (ltfat_int j = -glh; j < gl - glh; j++)
+        {
+            f[l] += g[ltfat_positiverem(j, gl)] * ltfat_real(cval * twid[ph]);
+
+            if (++l == p->L) l = 0;
+            ph += m; if (ph >= M) ph -= M;
+        }
+    }
+
+error:
+    return status;
+}
@@ -171,9 +171,9 @@ LTFAT_NAME(dgtrealmp_execute_locomp)(
                 LTFAT_NAME(kerns)* k =
                     p->gramkerns[cvalPos.w + s->P * cvalPos2.w];
 
-                /* LTFAT_COMPLEX* kvals = */
-                /*     LTFAT_NAME(dgtrealmp_execute_pickkernel)( */
-                /*         k, cvalPos.m, cvalPos.n, p->params->ptype); */
+                LTFAT_COMPLEX* kexp =
+                    LTFAT_NAME(dgtrealmp_execute_pickmod)(
+                        k, cvalPos.m, cvalPos.n, p->params->ptype);
 
                 ltfat_int m2start, n2start;
                 ksize   kdim2; kanchor kmid2; kpoint kstart2;
@@ -187,9 +187,13 @@ LTFAT_NAME(dgtrealmp_execute_locomp)(
 
                 if ( muse >= 0 && muse < kdim2.height &&
                      nuse >= 0 && nuse < kdim2.width )
-                    gramBufCol[cidx2] =
-                        (k->kval[k->size.height * (kstart2.n + k->astep * nuse) +
-                                 k->Mstep * muse + kstart2.m]);
+                {
+                    // Same modulation as in LTFAT_DGTREALMP_APPLYKERNEL
+                    ltfat_int kmidx = kstart2.m + k->Mstep * muse;
+                    ltfat_int knidx = kstart2.n + k->astep * nuse;
+                    gramBufCol[cidx2] = k->kval[k->size.height * knidx + kmidx] *
+                        (p->params->ptype == LTFAT_TIMEINV ? kexp[knidx] : kexp[kmidx]);
+                }
                 else
                     gramBufCol[cidx2] = 0;
             }
@@ -385,7 +389,8 @@ LTFAT_NAME(dgtrealmp_execute_mp)(
     LTFAT_NAME(dgtrealmp_execute_updateresiduum)( p, pos, cvaldual, 1);
 
     p->iterstate->suppind[PTOI(pos)]++;
-    cout[PTOI(pos)] += cvaldual;
+    if (cout) cout[PTOI(pos)] += cvaldual;
+    if (p->atomsink) LTFAT_NAME(dgtrealmp_atoms_append)(p->atomsink, pos, cvaldual);
     return projenergy;
 }
 
@@ -401,6 +406,7 @@ LTFAT_NAME(dgtrealmp_execute_invmp)(
                                     && uniquenyquest));
     LTFAT_COMPLEX coutval = cout[PTOI(pos)];
     cout[PTOI(pos)] = LTFAT_COMPLEX(0.0, 0.0);
+    if (p->atomsink) LTFAT_NAME(dgtrealmp_atoms_append)(p->atomsink, pos, -coutval);
     LTFAT_COMPLEX cresval = s->c[PTOI(pos)];
 
     LTFAT_COMPLEX atinprod;
@@ -600,6 +606,9 @@ LTFAT_NAME(dgtrealmp_execute_indices)(
 
     pos->n    = (ltfat_int) ltfat_round( origpos.n / k->arat);
     pos->m    = (ltfat_int) ltfat_round( origpos.m / k->Mrat);
+    // Time index without the modulo N, it is used to tell apart atoms
+    // which are N frames apart when building the LocOMP Gram matrix
+    pos->n2   = (ltfat_int) ltfat_round( origpos.n2 / k->arat);
 
     ltfat_int n2off = origpos.n - (ltfat_int)(pos->n * k->arat);
     ltfat_int m2off = origpos.m - (ltfat_int)(pos->m * k->Mrat);
@@ -664,6 +673,7 @@ LTFAT_NAME(dgtrealmp_execute_findmaxatom)(
         if ( valTmp > val )
         {
             val = valTmp; pos->m = s->maxcolspos[k][nTmp]; pos->n = nTmp; pos->w = k;
+            pos->n2 = nTmp;
             retval = LTFATERR_SUCCESS;
         }
     }
@@ -712,21 +722,3 @@ LTFAT_NAME(dgtrealmp_execute_findneighbors)(
 
     return 0;
 }
-
-#ifdef NOBLASLAPACK
-
-LTFAT_API int
-LTFAT_NAME_COMPLEX(hermsystemsolver_init)(ltfat_int UNUSED(M),
-        LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** UNUSED(p)) {return 0;}
-
-
-LTFAT_API int
-LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(
-    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* UNUSED(p),
-    const LTFAT_COMPLEX* UNUSED(A), ltfat_int UNUSED(M),
-    LTFAT_COMPLEX* UNUSED(b)) {return 0;}
-
-LTFAT_API int
-LTFAT_NAME_COMPLEX(hermsystemsolver_done)(
-    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** UNUSED(p)) {return 0;}
-#endif
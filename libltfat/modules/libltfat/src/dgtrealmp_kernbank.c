@@ -0,0 +1,476 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "dgtrealmp_private.h"
+
+#define DGTREALMP_KERNBANK_VERSION 2
+
+static const char dgtrealmp_kernbank_magic[8] = {'L', 'T', 'F', 'A', 'T', 'M', 'P', 'K'};
+
+/* The reference counter is updated atomically, so the bank can be
+ * acquired and released from several threads. */
+#if defined(__GNUC__)
+static long
+dgtrealmp_kernbank_refadd(long* refcount, long val)
+{
+    return __atomic_add_fetch(refcount, val, __ATOMIC_ACQ_REL);
+}
+#elif defined(_MSC_VER)
+#include <intrin.h>
+static long
+dgtrealmp_kernbank_refadd(long* refcount, long val)
+{
+    return _InterlockedExchangeAdd((volatile long*) refcount, val) + val;
+}
+#else
+#error "Atomic reference counting of the kernel bank is not implemented for this compiler"
+#endif
+
+int
+LTFAT_NAME(dgtrealmp_kernbank_acquire)(LTFAT_NAME(dgtrealmp_kernbank)* kb)
+{
+    return (int) dgtrealmp_kernbank_refadd(&kb->refcount, 1);
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernbank_alloc)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], const ltfat_dgtmp_params* params,
+    LTFAT_NAME(dgtrealmp_kernbank)** kbout)
+{
+    LTFAT_NAME(dgtrealmp_kernbank)* kb = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECK(LTFATERR_NOTPOSARG, P > 0, "P must be positive (passed %td)", P);
+    CHECK(LTFATERR_NOTPOSARG, L > 0, "L must be positive (passed %td)", L);
+    CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a); CHECKNULL(M);
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        CHECKNULL(g[k]);
+        CHECK(LTFATERR_NOTPOSARG, gl[k] > 0 && a[k] > 0 && M[k] > 0,
+              "gl[%td], a[%td] and M[%td] must be positive", k, k, k);
+    }
+
+    CHECK(LTFATERR_BADTRALEN, L == ltfat_dgtlengthmulti(L, P, a, M),
+          "L=%td is not compatible with the dictionaries", L);
+
+    CHECKMEM( kb = LTFAT_NEW( LTFAT_NAME(dgtrealmp_kernbank)) );
+    CHECKMEM( kb->kerns = LTFAT_NEWARRAY( LTFAT_NAME(kerns)*, P * P));
+    CHECKMEM( kb->g  = LTFAT_NEWARRAY( LTFAT_REAL*, P));
+    CHECKMEM( kb->gl = LTFAT_NEWARRAY( ltfat_int, P));
+    CHECKMEM( kb->a  = LTFAT_NEWARRAY( ltfat_int, P));
+    CHECKMEM( kb->M  = LTFAT_NEWARRAY( ltfat_int, P));
+    kb->P = P; kb->L = L; kb->refcount = 1;
+    kb->kernrelthr = params->kernrelthr;
+    kb->ptype = params->ptype;
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        kb->gl[k] = gl[k]; kb->a[k] = a[k]; kb->M[k] = M[k];
+        CHECKMEM( kb->g[k] = LTFAT_NAME_REAL(malloc)(gl[k]));
+        memcpy(kb->g[k], g[k], gl[k] * sizeof * kb->g[k]);
+    }
+
+    *kbout = kb;
+    return status;
+error:
+    if (kb) LTFAT_NAME(dgtrealmp_kernbank_done)(&kb);
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernbank_compute)(LTFAT_NAME(dgtrealmp_kernbank)* kb)
+{
+    const LTFAT_REAL* gtmp[2]; ltfat_int gltmp[2]; ltfat_int atmp[2];
+    ltfat_int Mtmp[2];
+    ltfat_int P = kb->P;
+    int status = LTFATERR_SUCCESS;
+
+    for (ltfat_int k1 = 0; k1 < P; k1++)
+    {
+        for (ltfat_int k2 = 0; k2 < P; k2++)
+        {
+            gtmp[0] = kb->g[k1]; gtmp[1] = kb->g[k2];
+            atmp[0] = kb->a[k1]; atmp[1] = kb->a[k2];
+            Mtmp[0] = kb->M[k1]; Mtmp[1] = kb->M[k2];
+            gltmp[0] = kb->gl[k1]; gltmp[1] = kb->gl[k2];
+
+            CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernel_init)( gtmp, gltmp,
+                         atmp, Mtmp, kb->L, (LTFAT_REAL) kb->kernrelthr,
+                         kb->ptype, &kb->kerns[k1 + k2 * P]));
+        }
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernbank_init)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], ltfat_dgtmp_params* params,
+    LTFAT_NAME(dgtrealmp_kernbank)** kbout)
+{
+    LTFAT_NAME(dgtrealmp_kernbank)* kb = NULL;
+    ltfat_dgtmp_params* defparams = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(kbout);
+
+    if (!params)
+        CHECKMEM( params = defparams = ltfat_dgtmp_params_allocdef());
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtrealmp_kernbank_alloc)(g, gl, L, P, a, M, params, &kb));
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernbank_compute)(kb));
+
+    if (defparams) ltfat_dgtmp_params_free(defparams);
+    *kbout = kb;
+    return status;
+error:
+    if (defparams) ltfat_dgtmp_params_free(defparams);
+    if (kb) LTFAT_NAME(dgtrealmp_kernbank_done)(&kb);
+    if (kbout) *kbout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernbank_done)(LTFAT_NAME(dgtrealmp_kernbank)** kb)
+{
+    LTFAT_NAME(dgtrealmp_kernbank)* kk;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(kb); CHECKNULL(*kb);
+    kk = *kb;
+    *kb = NULL;
+
+    if (dgtrealmp_kernbank_refadd(&kk->refcount, -1) > 0)
+        return status;
+
+    if (kk->kerns)
+    {
+        for (ltfat_int k = 0; k < kk->P * kk->P; k++)
+            if (kk->kerns[k])
+                LTFAT_NAME(dgtrealmp_kernel_done)( &kk->kerns[k]);
+
+        ltfat_free(kk->kerns);
+    }
+
+    if (kk->g)
+        for (ltfat_int k = 0; k < kk->P; k++)
+            ltfat_safefree(kk->g[k]);
+
+    LTFAT_SAFEFREEALL(kk->g, kk->gl, kk->a, kk->M);
+    ltfat_free(kk);
+error:
+    return status;
+}
+
+int
+LTFAT_NAME(dgtrealmp_kernbank_iscompatible)(
+    const LTFAT_NAME(dgtrealmp_kernbank)* kb,
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], const ltfat_dgtmp_params* params)
+{
+    if (kb->P != P || kb->L != L || kb->ptype != params->ptype ||
+        kb->kernrelthr != params->kernrelthr)
+        return 0;
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        if (kb->gl[k] != gl[k] || kb->a[k] != a[k] || kb->M[k] != M[k])
+            return 0;
+
+        if (memcmp(kb->g[k], g[k], gl[k] * sizeof * g[k]))
+            return 0;
+    }
+
+    return 1;
+}
+
+/* FNV-1a hash of the parameters the kernels depend on */
+static unsigned long long
+dgtrealmp_kernbank_hash(unsigned long long h, const void* data, size_t len)
+{
+    const unsigned char* d = (const unsigned char*) data;
+    for (size_t ii = 0; ii < len; ii++)
+    {
+        h ^= d[ii];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static unsigned long long
+LTFAT_NAME(dgtrealmp_kernbank_key)(const LTFAT_NAME(dgtrealmp_kernbank)* kb)
+{
+    unsigned long long h = 14695981039346656037ULL;
+    size_t realsize = sizeof(LTFAT_REAL);
+    int ptype = (int) kb->ptype;
+
+    h = dgtrealmp_kernbank_hash(h, &realsize, sizeof realsize);
+    h = dgtrealmp_kernbank_hash(h, &kb->P, sizeof kb->P);
+    h = dgtrealmp_kernbank_hash(h, &kb->L, sizeof kb->L);
+    h = dgtrealmp_kernbank_hash(h, &ptype, sizeof ptype);
+    h = dgtrealmp_kernbank_hash(h, &kb->kernrelthr, sizeof kb->kernrelthr);
+    h = dgtrealmp_kernbank_hash(h, kb->gl, kb->P * sizeof * kb->gl);
+    h = dgtrealmp_kernbank_hash(h, kb->a, kb->P * sizeof * kb->a);
+    h = dgtrealmp_kernbank_hash(h, kb->M, kb->P * sizeof * kb->M);
+
+    for (ltfat_int k = 0; k < kb->P; k++)
+        h = dgtrealmp_kernbank_hash(h, kb->g[k], kb->gl[k] * sizeof * kb->g[k]);
+
+    return h;
+}
+
+#define KBWRITE(ptr, n) \
+    CHECK(LTFATERR_FAILED, fwrite((ptr), sizeof *(ptr), (n), file) == (size_t)(n), \
+          "Writing the kernel cache failed")
+
+#define KBREAD(ptr, n) \
+    CHECK(LTFATERR_FAILED, fread((ptr), sizeof *(ptr), (n), file) == (size_t)(n), \
+          "Reading the kernel cache failed")
+
+/* The hash only names the file, the parameters themselves are stored in
+ * the file and compared on load. */
+static int
+LTFAT_NAME(dgtrealmp_kernbank_savekey)(
+    const LTFAT_NAME(dgtrealmp_kernbank)* kb, FILE* file)
+{
+    int realsize = (int) sizeof(LTFAT_REAL);
+    int ptype = (int) kb->ptype;
+    int status = LTFATERR_SUCCESS;
+
+    KBWRITE(&realsize, 1); KBWRITE(&kb->P, 1); KBWRITE(&kb->L, 1);
+    KBWRITE(&ptype, 1); KBWRITE(&kb->kernrelthr, 1);
+    KBWRITE(kb->gl, kb->P); KBWRITE(kb->a, kb->P); KBWRITE(kb->M, kb->P);
+
+    for (ltfat_int k = 0; k < kb->P; k++)
+        KBWRITE(kb->g[k], kb->gl[k]);
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernbank_checkkey)(
+    const LTFAT_NAME(dgtrealmp_kernbank)* kb, FILE* file)
+{
+    int realsize, ptype;
+    ltfat_int P, L;
+    double kernrelthr;
+    ltfat_int* ibuf = NULL;
+    LTFAT_REAL* gbuf = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    KBREAD(&realsize, 1); KBREAD(&P, 1); KBREAD(&L, 1);
+    KBREAD(&ptype, 1); KBREAD(&kernrelthr, 1);
+
+    CHECK(LTFATERR_BADARG, realsize == (int) sizeof(LTFAT_REAL) &&
+          P == kb->P && L == kb->L && ptype == (int) kb->ptype &&
+          kernrelthr == kb->kernrelthr, "Kernel cache does not match");
+
+    CHECKMEM( ibuf = LTFAT_NEWARRAY(ltfat_int, 3 * P));
+    KBREAD(ibuf, 3 * P);
+    CHECK(LTFATERR_BADARG,
+          !memcmp(ibuf, kb->gl, P * sizeof * ibuf) &&
+          !memcmp(ibuf + P, kb->a, P * sizeof * ibuf) &&
+          !memcmp(ibuf + 2 * P, kb->M, P * sizeof * ibuf),
+          "Kernel cache does not match");
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        CHECKMEM( gbuf = LTFAT_NAME_REAL(malloc)(kb->gl[k]));
+        KBREAD(gbuf, kb->gl[k]);
+        CHECK(LTFATERR_BADARG, !memcmp(gbuf, kb->g[k], kb->gl[k] * sizeof * gbuf),
+              "Kernel cache does not match");
+        ltfat_free(gbuf); gbuf = NULL;
+    }
+
+error:
+    ltfat_safefree(ibuf);
+    ltfat_safefree(gbuf);
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernbank_save)(
+    const LTFAT_NAME(dgtrealmp_kernbank)* kb, unsigned long long key,
+    FILE* file)
+{
+    int version = DGTREALMP_KERNBANK_VERSION;
+    int status = LTFATERR_SUCCESS;
+
+    KBWRITE(dgtrealmp_kernbank_magic, 8);
+    KBWRITE(&version, 1);
+    KBWRITE(&key, 1);
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernbank_savekey)(kb, file));
+
+    for (ltfat_int k = 0; k < kb->P * kb->P; k++)
+    {
+        const LTFAT_NAME(kerns)* ke = kb->kerns[k];
+        ltfat_int modlen = ke->ptype == LTFAT_FREQINV ? ke->size.height : ke->size.width;
+        ltfat_int atprodsLen = ltfat_idivceil( ke->size.height, 2);
+
+        KBWRITE(&ke->size, 1); KBWRITE(&ke->mid, 1);
+        KBWRITE(&ke->kNo, 1); KBWRITE(&ke->kSkip, 1);
+        KBWRITE(&ke->absthr, 1); KBWRITE(&ke->Mrat, 1); KBWRITE(&ke->arat, 1);
+        KBWRITE(&ke->Mstep, 1); KBWRITE(&ke->astep, 1);
+        KBWRITE(&ke->atprodsNo, 1);
+        KBWRITE(ke->kval, ke->size.height * ke->size.width);
+        KBWRITE(ke->range, ke->size.width);
+        KBWRITE(ke->srange, ke->size.width);
+        KBWRITE(ke->atprods, atprodsLen);
+        KBWRITE(ke->oneover1minatprodnorms, atprodsLen);
+
+        for (ltfat_int kIdx = 0; kIdx < ke->kNo; kIdx++)
+            KBWRITE(ke->mods[kIdx], modlen);
+    }
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(dgtrealmp_kernbank_load)(
+    LTFAT_NAME(dgtrealmp_kernbank)* kb, unsigned long long key,
+    FILE* file)
+{
+    char magic[8];
+    int version;
+    unsigned long long filekey;
+    int status = LTFATERR_SUCCESS;
+
+    KBREAD(magic, 8);
+    KBREAD(&version, 1);
+    KBREAD(&filekey, 1);
+
+    CHECK(LTFATERR_BADARG,
+          !memcmp(magic, dgtrealmp_kernbank_magic, 8) &&
+          version == DGTREALMP_KERNBANK_VERSION && filekey == key,
+          "Kernel cache does not match");
+
+    CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernbank_checkkey)(kb, file));
+
+    for (ltfat_int k = 0; k < kb->P * kb->P; k++)
+    {
+        LTFAT_NAME(kerns)* ke = NULL;
+        CHECKMEM( ke = kb->kerns[k] = LTFAT_NEW(LTFAT_NAME(kerns)));
+        ke->ptype = kb->ptype;
+
+        KBREAD(&ke->size, 1); KBREAD(&ke->mid, 1);
+        KBREAD(&ke->kNo, 1); KBREAD(&ke->kSkip, 1);
+        KBREAD(&ke->absthr, 1); KBREAD(&ke->Mrat, 1); KBREAD(&ke->arat, 1);
+        KBREAD(&ke->Mstep, 1); KBREAD(&ke->astep, 1);
+        KBREAD(&ke->atprodsNo, 1);
+
+        CHECK(LTFATERR_BADARG, ke->size.height > 0 && ke->size.width > 0 &&
+              ke->kNo > 0, "Kernel cache is corrupted");
+
+        ltfat_int modlen = ke->ptype == LTFAT_FREQINV ? ke->size.height : ke->size.width;
+        ltfat_int atprodsLen = ltfat_idivceil( ke->size.height, 2);
+
+        CHECKMEM( ke->kval =
+                      LTFAT_NAME_COMPLEX(malloc)( ke->size.height * ke->size.width));
+        CHECKMEM( ke->range  = LTFAT_NEWARRAY(krange, ke->size.width) );
+        CHECKMEM( ke->srange = LTFAT_NEWARRAY(krange, ke->size.width) );
+        CHECKMEM( ke->atprods = LTFAT_NAME_COMPLEX(calloc)( atprodsLen ));
+        CHECKMEM( ke->oneover1minatprodnorms = LTFAT_NAME_REAL(calloc)( atprodsLen ));
+        CHECKMEM( ke->mods = LTFAT_NEWARRAY(LTFAT_COMPLEX*, ke->kNo));
+
+        KBREAD(ke->kval, ke->size.height * ke->size.width);
+        KBREAD(ke->range, ke->size.width);
+        KBREAD(ke->srange, ke->size.width);
+        KBREAD(ke->atprods, atprodsLen);
+        KBREAD(ke->oneover1minatprodnorms, atprodsLen);
+
+        for (ltfat_int kIdx = 0; kIdx < ke->kNo; kIdx++)
+        {
+            CHECKMEM( ke->mods[kIdx] = LTFAT_NAME_COMPLEX(malloc)(modlen));
+            KBREAD(ke->mods[kIdx], modlen);
+        }
+    }
+error:
+    return status;
+}
+
+#undef KBWRITE
+#undef KBREAD
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_kernbank_init_cached)(
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], ltfat_dgtmp_params* params,
+    const char* cachedir, LTFAT_NAME(dgtrealmp_kernbank)** kbout)
+{
+    LTFAT_NAME(dgtrealmp_kernbank)* kb = NULL;
+    ltfat_dgtmp_params* defparams = NULL;
+    FILE* file = NULL;
+    char* path = NULL;
+    size_t pathlen;
+    unsigned long long key;
+    int loaded = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(cachedir); CHECKNULL(kbout);
+
+    if (!params)
+        CHECKMEM( params = defparams = ltfat_dgtmp_params_allocdef());
+
+    CHECKSTATUS(
+        LTFAT_NAME(dgtrealmp_kernbank_alloc)(g, gl, L, P, a, M, params, &kb));
+
+    key = LTFAT_NAME(dgtrealmp_kernbank_key)(kb);
+    pathlen = strlen(cachedir) + 64;
+    CHECKMEM( path = LTFAT_NEWARRAY(char, pathlen));
+    snprintf(path, pathlen, "%s/ltfat_mpkern_%016llx.bin", cachedir, key);
+
+    if ((file = fopen(path, "rb")))
+    {
+        // The error handler is not interested in a stale cache
+        ltfat_error_handler_t* oldhandler = ltfat_set_error_handler_off();
+        loaded = LTFAT_NAME(dgtrealmp_kernbank_load)(kb, key, file) == LTFATERR_SUCCESS;
+        ltfat_set_error_handler(oldhandler);
+        fclose(file); file = NULL;
+
+        if (!loaded)
+        {
+            for (ltfat_int k = 0; k < P * P; k++)
+                if (kb->kerns[k])
+                    LTFAT_NAME(dgtrealmp_kernel_done)( &kb->kerns[k]);
+        }
+    }
+
+    if (!loaded)
+    {
+        CHECKSTATUS( LTFAT_NAME(dgtrealmp_kernbank_compute)(kb));
+
+        // Failing to write the cache is not an error
+        if ((file = fopen(path, "wb")))
+        {
+            int savestatus = LTFAT_NAME(dgtrealmp_kernbank_save)(kb, key, file);
+            fclose(file); file = NULL;
+            if (savestatus != LTFATERR_SUCCESS) remove(path);
+        }
+    }
+
+    ltfat_free(path);
+    if (defparams) ltfat_dgtmp_params_free(defparams);
+    *kbout = kb;
+    return status;
+error:
+    if (file) fclose(file);
+    ltfat_safefree(path);
+    if (defparams) ltfat_dgtmp_params_free(defparams);
+    if (kb) LTFAT_NAME(dgtrealmp_kernbank_done)(&kb);
+    if (kbout) *kbout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_get_kernbank)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_NAME(dgtrealmp_kernbank)** kb)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(kb); CHECKNULL(p->kernbank);
+
+    LTFAT_NAME(dgtrealmp_kernbank_acquire)(p->kernbank);
+    *kb = p->kernbank;
+error:
+    return status;
+}
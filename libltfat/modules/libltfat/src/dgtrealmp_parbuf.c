@@ -105,6 +105,9 @@ LTFAT_NAME(dgtrealmp_parbuf_done)(LTFAT_NAME(dgtrealmp_parbuf)** p)
 
     LTFAT_SAFEFREEALL(pp->g, pp->gl, pp->a, pp->M, pp->chanmask);
 
+    if (pp->kernbank)
+        LTFAT_NAME(dgtrealmp_kernbank_done)(&pp->kernbank);
+
     ltfat_free(pp);
     *p = NULL;
 error:
@@ -314,6 +317,16 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_errresync)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, size_t errresync)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return ltfat_dgtmp_setpar_errresync(p->params, errresync);
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtrealmp_setparbuf_iterstep)(
     LTFAT_NAME(dgtrealmp_parbuf)* p, size_t iterstep)
@@ -337,6 +350,20 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dgtrealmp_setparbuf_kernbank)(
+    LTFAT_NAME(dgtrealmp_parbuf)* p, LTFAT_NAME(dgtrealmp_kernbank)* kb)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+
+    if (kb) LTFAT_NAME(dgtrealmp_kernbank_acquire)(kb);
+    if (p->kernbank) LTFAT_NAME(dgtrealmp_kernbank_done)(&p->kernbank);
+    p->kernbank = kb;
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtrealmp_setparbuf_alg)(
     LTFAT_NAME(dgtrealmp_parbuf)* p, ltfat_dgtmp_alg alg)
@@ -15,6 +15,7 @@ struct LTFAT_NAME(dgtrealmp_parbuf)
     ltfat_dgtmp_params* params;
     LTFAT_NAME(dgtrealmp_iterstep_callback)* iterstepcallback;
     void*                        iterstepcallbackdata;
+    LTFAT_NAME(dgtrealmp_kernbank)* kernbank;
 //    LTFAT_REAL          chirprate;
 //    LTFAT_REAL          shiftby;
 };
@@ -35,6 +36,7 @@ struct ltfat_dgtmp_params
     int                   initwasrun;
     int                   treelevels;
     size_t                cycles;
+    size_t                errresync;
     ltfat_phaseconvention ptype;
     int                   do_pedantic;
 };
@@ -93,6 +95,20 @@ typedef struct
 } LTFAT_NAME(kerns);
 
 
+struct LTFAT_NAME(dgtrealmp_kernbank)
+{
+    LTFAT_NAME(kerns)**  kerns; // PxP kernels, read-only once computed
+    LTFAT_REAL**             g;
+    ltfat_int*              gl;
+    ltfat_int*               a;
+    ltfat_int*               M;
+    ltfat_int                P;
+    ltfat_int                L;
+    double          kernrelthr;
+    ltfat_phaseconvention ptype;
+    long              refcount;
+};
+
 typedef struct
 {
     LTFAT_COMPLEX**        c;
@@ -128,10 +144,29 @@ typedef struct
     LTFAT_NAME(dgtrealmp_state)* state;
 } LTFAT_NAME(dgtrealmp_state_closure);
 
+typedef struct
+{
+    ltfat_int     w;
+    ltfat_int     m;
+    ltfat_int     n;
+    LTFAT_COMPLEX c;
+} LTFAT_NAME(dgtrealmp_atom);
+
+struct LTFAT_NAME(dgtrealmp_atoms)
+{
+    LTFAT_NAME(dgtrealmp_atom)* at;
+    size_t                   atNo;
+    size_t                  atCap;
+    int                    status; // Sticky, set when append fails
+};
+
+#define dgtrealmp_atoms_EXPANDRAT 2
+
 struct LTFAT_NAME(dgtrealmp_state)
 {
     LTFAT_NAME(dgtrealmpiter_state)* iterstate;
-    LTFAT_NAME(kerns)**             gramkerns; // PxP plans
+    LTFAT_NAME(kerns)**             gramkerns; // PxP plans, owned by kernbank
+    LTFAT_NAME(dgtrealmp_kernbank)*  kernbank;
     LTFAT_NAME(dgtreal_plan)**       dgtplans;  // P plans
     ltfat_int*        a;
     ltfat_int*        M;
@@ -145,6 +180,14 @@ struct LTFAT_NAME(dgtrealmp_state)
     LTFAT_NAME(dgtrealmp_state_closure)** closures;
     LTFAT_NAME(dgtrealmp_iterstep_callback)* callback;
     void* userdata;
+    // Sparse output
+    LTFAT_NAME(dgtrealmp_atoms)* atomsink;
+    LTFAT_REAL**      gfir;  // P windows used for the sparse synthesis
+    ltfat_int*          gl;
+    LTFAT_COMPLEX**  twids;  // P tables of M roots of unity
+    // Exact residual energy recomputation
+    LTFAT_REAL*       fref;  // Copy of the signal being decomposed
+    LTFAT_REAL*       fsyn;  // Approximation buffer
 };
 
 static inline LTFAT_REAL
@@ -314,6 +357,23 @@ LTFAT_NAME(dgtrealmp_execute_realatenergy)(
     LTFAT_NAME(dgtrealmp_state)* p,
     kpoint pos, LTFAT_COMPLEX cval);
 
+int
+LTFAT_NAME(dgtrealmp_execute_errresync)(
+    LTFAT_NAME(dgtrealmp_state)* p, LTFAT_COMPLEX** cout);
+
+int
+LTFAT_NAME(dgtrealmp_kernbank_acquire)(LTFAT_NAME(dgtrealmp_kernbank)* kb);
+
+int
+LTFAT_NAME(dgtrealmp_kernbank_iscompatible)(
+    const LTFAT_NAME(dgtrealmp_kernbank)* kb,
+    const LTFAT_REAL* g[], ltfat_int gl[], ltfat_int L, ltfat_int P,
+    ltfat_int a[], ltfat_int M[], const ltfat_dgtmp_params* params);
+
+int
+LTFAT_NAME(dgtrealmp_atoms_append)(
+    LTFAT_NAME(dgtrealmp_atoms)* atoms, kpoint pos, LTFAT_COMPLEX cval);
+
 LTFAT_REAL
 LTFAT_NAME(pedantic_callback)(void* userdata,
                               LTFAT_COMPLEX cval, ltfat_int pos);
@@ -18,6 +18,7 @@ ltfat_dgtmp_params_defaults(ltfat_dgtmp_params* params)
     params->iterstep = 0;
     params->treelevels = 10;
     params->cycles = 1;
+    params->errresync = 0;
     params->atprodreltoldb = -80.0;
     params->ptype = LTFAT_TIMEINV;
 error:
@@ -144,6 +145,17 @@ error:
     return status;
 }
 
+LTFAT_API int
+ltfat_dgtmp_setpar_errresync(
+    ltfat_dgtmp_params* params, size_t errresync)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(params);
+    params->errresync = errresync;
+error:
+    return status;
+}
+
 LTFAT_API int
 ltfat_dgtmp_setpar_errtoldb(
     ltfat_dgtmp_params* params, double errtoldb)
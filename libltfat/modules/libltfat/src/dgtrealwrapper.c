@@ -54,6 +54,15 @@ LTFAT_NAME(dgtreal_long_execute_wrapper)(void* plan,
                (LTFAT_NAME(dgtreal_long_plan)*) plan, f, c);
 }
 
+int
+LTFAT_NAME(dgtreal_long_execute_strided_wrapper)(void* plan,
+        const LTFAT_REAL* f, ltfat_dgt_layout flayout, ltfat_int UNUSED(L), ltfat_int UNUSED(W),
+        LTFAT_COMPLEX* c, ltfat_dgt_layout clayout)
+{
+    return LTFAT_NAME(dgtreal_long_execute_strided)(
+               (LTFAT_NAME(dgtreal_long_plan)*) plan, f, flayout, c, clayout);
+}
+
 int
 LTFAT_NAME(idgtreal_fb_execute_wrapper)(void* plan,
                                         const LTFAT_COMPLEX* c, ltfat_int L, ltfat_int W, LTFAT_REAL* f)
@@ -70,6 +79,15 @@ LTFAT_NAME(dgtreal_fb_execute_wrapper)(void* plan,
                (LTFAT_NAME(dgtreal_fb_plan)*) plan, f, L, W, c);
 }
 
+int
+LTFAT_NAME(dgtreal_fb_execute_strided_wrapper)(void* plan,
+        const LTFAT_REAL* f, ltfat_dgt_layout flayout, ltfat_int L, ltfat_int W,
+        LTFAT_COMPLEX* c, ltfat_dgt_layout clayout)
+{
+    return LTFAT_NAME(dgtreal_fb_execute_strided)(
+               (LTFAT_NAME(dgtreal_fb_plan)*) plan, f, flayout, L, W, c, clayout);
+}
+
 int
 LTFAT_NAME(idgtreal_long_done_wrapper)(void** plan)
 {
@@ -145,6 +163,17 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dgtreal_execute_ana_strided)(
+    LTFAT_NAME(dgtreal_plan)* p, const LTFAT_REAL f[], ltfat_dgt_layout flayout,
+    LTFAT_COMPLEX c[], ltfat_dgt_layout clayout)
+{
+    int status = LTFATERR_FAILED; CHECKNULL(p);
+    return p->fwdtra_strided(p->fwdtra_userdata, f, flayout, p->L, p->W, c, clayout);
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(dgtreal_execute_ana)(LTFAT_NAME(dgtreal_plan)* p)
 {
@@ -201,14 +230,10 @@ LTFAT_NAME(dgtreal_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
     }
     else
     {
-#ifndef NOBLASLAPACK
         g2l = L;
         CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L));
         LTFAT_NAME(fir2long)(g, gl, L, g2);
-        CHECKSTATUS( LTFAT_NAME(gabdual_long)(g, L, a, M, g2));
-#else
-        CHECK( LTFATERR_NOTSUPPORTED, 0, "Non-painless support was not compiled.");
-#endif
+        CHECKSTATUS( LTFAT_NAME(gabdual_long)(g2, L, a, M, g2));
     }
 
     CHECKSTATUS(
@@ -268,6 +293,7 @@ LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
         p->backtra_userdata = (void*) backtra_tmp;
 
         p->fwdtra = &LTFAT_NAME(dgtreal_long_execute_wrapper);
+        p->fwdtra_strided = &LTFAT_NAME(dgtreal_long_execute_strided_wrapper);
         p->fwddonefunc = &LTFAT_NAME(dgtreal_long_done_wrapper);
 
         // Ensure the original window is long enough
@@ -297,6 +323,7 @@ LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
         p->backtra_userdata = (void*) backtra_tmp;
 
         p->fwdtra = &LTFAT_NAME(dgtreal_fb_execute_wrapper);
+        p->fwdtra_strided = &LTFAT_NAME(dgtreal_fb_execute_strided_wrapper);
         p->fwddonefunc = &LTFAT_NAME(dgtreal_fb_done_wrapper);
 
         CHECKSTATUS(
@@ -344,6 +371,7 @@ LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
         if (gal < L)
         {
             p->fwdtra = &LTFAT_NAME(dgtreal_fb_execute_wrapper);
+            p->fwdtra_strided = &LTFAT_NAME(dgtreal_fb_execute_strided_wrapper);
             p->fwddonefunc = &LTFAT_NAME(dgtreal_fb_done_wrapper);
 
             LTFAT_NAME(dgtreal_fb_init)(ga, gal, a, M, paramsLoc.ptype,
@@ -354,6 +382,7 @@ LTFAT_NAME(dgtreal_init_gen)(const LTFAT_REAL ga[], ltfat_int gal,
         else
         {
             p->fwdtra = &LTFAT_NAME(dgtreal_long_execute_wrapper);
+            p->fwdtra_strided = &LTFAT_NAME(dgtreal_long_execute_strided_wrapper);
             p->fwddonefunc = &LTFAT_NAME(dgtreal_long_done_wrapper);
 
             CHECKMEM( g2 = LTFAT_NAME_REAL(malloc)(L) );
@@ -4,6 +4,7 @@
 
 typedef int LTFAT_NAME(complextorealtransform)(void* userdata, const LTFAT_COMPLEX* c, ltfat_int L, ltfat_int W, LTFAT_REAL* f);
 typedef int LTFAT_NAME(realtocomplextransform)(void* userdata, const LTFAT_REAL* f, ltfat_int L, ltfat_int W, LTFAT_COMPLEX* c);
+typedef int LTFAT_NAME(realtocomplextransform_strided)(void* userdata, const LTFAT_REAL* f, ltfat_dgt_layout flayout, ltfat_int L, ltfat_int W, LTFAT_COMPLEX* c, ltfat_dgt_layout clayout);
 
 struct LTFAT_NAME(dgtreal_plan)
 {
@@ -18,6 +19,7 @@ struct LTFAT_NAME(dgtreal_plan)
     void* backtra_userdata;
     LTFAT_NAME(donefunc)* backdonefunc;
     LTFAT_NAME(realtocomplextransform)* fwdtra;
+    LTFAT_NAME(realtocomplextransform_strided)* fwdtra_strided;
     void* fwdtra_userdata;
     LTFAT_NAME(donefunc)* fwddonefunc;
 };
@@ -207,14 +207,10 @@ LTFAT_NAME(dgt_init)(const LTFAT_TYPE g[], ltfat_int gl, ltfat_int L,
     }
     else
     {
-#ifndef NOBLASLAPACK
         g2l = L;
         CHECKMEM( g2 = LTFAT_NAME(malloc)(L));
         LTFAT_NAME(fir2long)(g, gl, L, g2);
-        CHECKSTATUS( LTFAT_NAME(gabdual_long)(g, L, a, M, g2));
-#else
-        CHECK( LTFATERR_NOTSUPPORTED, 0, "Non-painless support was not compiled.");
-#endif
+        CHECKSTATUS( LTFAT_NAME(gabdual_long)(g2, L, a, M, g2));
     }
 
     CHECKSTATUS(
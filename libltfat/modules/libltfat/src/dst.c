@@ -3,132 +3,116 @@
 #include "ltfat/macros.h"
 
 #include "ltfat/thirdparty/fftw3.h"
+#include "dctdst_private.h"
 
-/* typedef enum */
-/* { */
-/*     DSTI = FFTW_RODFT00, DSTIII = FFTW_RODFT01, */
-/*     DSTII = FFTW_RODFT10, DSTIV = FFTW_RODFT11 */
-/* } dst_kind; */
-
-LTFAT_API LTFAT_NAME(dst_plan)*
-LTFAT_NAME(dst_init)( ltfat_int L, ltfat_int W, LTFAT_TYPE *cout,
-                      const dst_kind kind)
+struct LTFAT_NAME(dst_plan)
 {
-    LTFAT_FFTW(iodim64) dims, howmanydims;
-    LTFAT_FFTW(plan) p;
-
-#ifdef LTFAT_COMPLEXTYPE
-    dims.n = L;
-    dims.is = 2;
-    dims.os = 2;
-
-    howmanydims.n = W;
-    howmanydims.is = 2*L;
-    howmanydims.os = 2*L;
-
-    unsigned flag = FFTW_ESTIMATE | FFTW_UNALIGNED;
-#else
-    dims.n = L;
-    dims.is = 1;
-    dims.os = 1;
-
-    howmanydims.n = W;
-    howmanydims.is = L;
-    howmanydims.os = L;
-
-    unsigned flag = FFTW_ESTIMATE;
-#endif
-
-    LTFAT_FFTW(r2r_kind) kindFftw = FFTW_RODFT00;
-    
-    switch (kind)
-    {
-        case DSTI:  kindFftw = FFTW_RODFT00; break;
-        case DSTII: kindFftw = FFTW_RODFT10; break;
-        case DSTIII: kindFftw = FFTW_RODFT01; break;
-        case DSTIV: kindFftw = FFTW_RODFT11; break;
-    };
+    LTFAT_NAME(r2r_engine) e;
+    ltfat_int L;
+    ltfat_int W;
+};
+
+LTFAT_API int
+LTFAT_NAME(dst)(const LTFAT_TYPE f[], ltfat_int L, ltfat_int W,
+                LTFAT_TYPE c[], const dst_kind kind)
+{
+    LTFAT_NAME(dst_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
 
-    p = LTFAT_FFTW(plan_guru64_r2r)(1, &dims,
-                                  1, &howmanydims,
-                                  (LTFAT_REAL*)cout, (LTFAT_REAL*)cout,
-                                  &kindFftw, flag);
+    CHECKSTATUS( LTFAT_NAME(dst_init)(L, W, kind, FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(dst_execute)(p, f, c));
 
-    return (LTFAT_NAME(dst_plan)*)p;
+error:
+    if (p) LTFAT_NAME(dst_done)(&p);
+    return status;
 }
 
-
-// f and cout cannot be equal, because creating plan can tamper with the array
-LTFAT_API void
-LTFAT_NAME(dst)(const LTFAT_TYPE *f, ltfat_int L, ltfat_int W,
-                LTFAT_TYPE *cout, const dst_kind kind)
+LTFAT_API int
+LTFAT_NAME(dst_init)(ltfat_int L, ltfat_int W, const dst_kind kind,
+                     unsigned flags, LTFAT_NAME(dst_plan)** pout)
 {
-    LTFAT_NAME(dst_plan)* p = LTFAT_NAME(dst_init)( L, W, cout, kind);
+    LTFAT_NAME(dst_plan)* p = NULL;
+    ltfat_r2r_kind r2rkind = LTFAT_RODFT00;
+    double sqrt2 = sqrt(2.0);
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dst_plan)) );
+    p->L = L; p->W = W;
+    p->e.pre0 = 1.0; p->e.pre1 = 1.0; p->e.post0 = 1.0; p->e.post1 = 1.0;
+    p->e.scale = (LTFAT_REAL) ( 1.0 / sqrt(2.0 * L) );
+
+    p->e.inrev = 0; p->e.insign = 0; p->e.outrev = 0; p->e.outsign = 0;
+
+    // DSTII-IV are DCTs of reversed or sign-alternated sequences
+    switch (kind)
+    {
+    case DSTI:
+        r2rkind = LTFAT_RODFT00;
+        p->e.scale = (LTFAT_REAL) ( 1.0 / sqrt(2.0 * (L + 1)) );
+        break;
+    case DSTII:
+        r2rkind = LTFAT_REDFT10;
+        p->e.insign = 1; p->e.outrev = 1;
+        p->e.post1 = 1.0 / sqrt2;
+        break;
+    case DSTIII:
+        r2rkind = LTFAT_REDFT01;
+        p->e.inrev = 1; p->e.outsign = 1;
+        p->e.pre1 = sqrt2;
+        break;
+    case DSTIV:
+        r2rkind = LTFAT_REDFT11;
+        p->e.insign = 1; p->e.outrev = 1;
+        break;
+    default:
+        CHECKCANTHAPPEN("Unknown dst_kind");
+    }
 
-    LTFAT_NAME(dst_execute)(p, f,  L,  W, cout, kind);
+    CHECKSTATUS( LTFAT_NAME(r2r_engine_init)(L, r2rkind, flags, &p->e));
 
-    LTFAT_NAME(dst_done)(p);
+    *pout = p;
+    return status;
+error:
+    ltfat_safefree(p);
+    return status;
 }
 
-LTFAT_API void
-LTFAT_NAME(dst_done)( LTFAT_NAME(dst_plan)* p)
+LTFAT_API int
+LTFAT_NAME(dst_execute)(LTFAT_NAME(dst_plan)* p, const LTFAT_TYPE f[],
+                        LTFAT_TYPE c[])
 {
-    LTFAT_FFTW(destroy_plan)((LTFAT_FFTW(plan)) p);
-}
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
 
-// f and cout can be equal, provided plan was already created
-LTFAT_API void
-LTFAT_NAME(dst_execute)(LTFAT_NAME(dst_plan)* p, const LTFAT_TYPE *f,
-                        ltfat_int L, ltfat_int W, LTFAT_TYPE *cout,
-                        const dst_kind kind)
-{
-    // Copy input to the output
-    if(cout!=f)
-        memcpy(cout,f,L*W*sizeof*f);
-
-    if(L==1)
-        return;
-
-    ltfat_int N = 2*L;
-    LTFAT_REAL sqrt2 = (LTFAT_REAL) sqrt(2.0);
-    LTFAT_REAL postScale = (LTFAT_REAL) 1.0/sqrt2;
-    LTFAT_REAL scale = (LTFAT_REAL) ( sqrt2*(1.0/(double)N)*sqrt((double)L) );
-
-    if(kind==DSTIII)
+    for (ltfat_int w = 0; w < p->W; w++)
     {
-        for(ltfat_int ii=0; ii<W; ii++)
-        {
-            cout[(ii+1)*L-1] *= sqrt2;
-        }
-    }
-
-    if(kind==DSTI)
-    {
-        N += 2;
-        scale = (LTFAT_REAL) ( sqrt2*(1.0/((double)N))*sqrt((double)L+1.0) );
-    }
-
-    LTFAT_REAL* c_r = (LTFAT_REAL*)cout;
-
-    LTFAT_FFTW(execute_r2r)((LTFAT_FFTW(plan))p,c_r,c_r);
+        const LTFAT_REAL* fw = (const LTFAT_REAL*) (f + w * p->L);
+        LTFAT_REAL* cw = (LTFAT_REAL*) (c + w * p->L);
 #ifdef LTFAT_COMPLEXTYPE
-    LTFAT_REAL* c_i = c_r+1;
-    LTFAT_FFTW(execute_r2r)((LTFAT_FFTW(plan))p,c_i,c_i);
+        LTFAT_NAME(r2r_engine_execute)(&p->e, fw, 2, cw, 2);
+        LTFAT_NAME(r2r_engine_execute)(&p->e, fw + 1, 2, cw + 1, 2);
+#else
+        LTFAT_NAME(r2r_engine_execute)(&p->e, fw, 1, cw, 1);
 #endif
-
-    // Post-scaling
-    for(ltfat_int ii=0; ii<L*W; ii++)
-    {
-        cout[ii] *= scale;
     }
 
-    if(kind==DSTII)
-    {
-        // Scale AC component
-        for(ltfat_int ii=0; ii<W; ii++)
-        {
-            cout[(ii+1)*L-1] *= postScale;
-        }
-    }
+error:
+    return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(dst_done)(LTFAT_NAME(dst_plan)** p)
+{
+    LTFAT_NAME(dst_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_NAME(r2r_engine_done)(&pp->e);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -153,3 +153,134 @@ LTFAT_NAME_REAL(dwilt_fb)(const LTFAT_REAL* f, const LTFAT_REAL* g,
 #undef CH
 #undef POSTPROC_REAL
 #undef POSTPROC_COMPLEX
+
+#include "dwilt_private.h"
+
+struct LTFAT_NAME(dwilt_plan)
+{
+    LTFAT_NAME(wilson_fold) fo;
+    LTFAT_NAME(fft_plan)* p_fft;
+    LTFAT_REAL* y;     //!< Two folded columns, 2M x 2
+    LTFAT_COMPLEX* s;  //!< FFT input, M
+    LTFAT_COMPLEX* G;  //!< FFT output, M
+    LTFAT_COMPLEX* tw; //!< exp(-i*pi*k/M)
+};
+
+LTFAT_API int
+LTFAT_NAME(dwilt_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                       ltfat_int W, ltfat_int M, unsigned flags,
+                       LTFAT_NAME(dwilt_plan)** pout)
+{
+    LTFAT_NAME(dwilt_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(dwilt_plan)) );
+    CHECKSTATUS( LTFAT_NAME(wilson_fold_init)(g, gl, L, W, M, 0, &p->fo));
+
+    CHECKMEM( p->y  = LTFAT_NAME_REAL(malloc)(4 * M) );
+    CHECKMEM( p->s  = LTFAT_NAME_COMPLEX(malloc)(M) );
+    CHECKMEM( p->G  = LTFAT_NAME_COMPLEX(malloc)(M) );
+    CHECKMEM( p->tw = LTFAT_NAME_COMPLEX(malloc)(M) );
+
+    for (ltfat_int k = 0; k < M; k++)
+        p->tw[k] = exp(-I * (LTFAT_REAL) (M_PI * k / M));
+
+    CHECKSTATUS( LTFAT_NAME(fft_init)(M, 1, p->s, p->G, flags, &p->p_fft));
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(dwilt_done)(&p);
+    return status;
+}
+
+/*
+ * Columns n (even) and n+1 are computed together. With y folded to 2M and
+ * Y(m) = sum_k y(k) exp(-i*pi*m*k/M), column n needs Re Y(2p) and Im Y(2p+1)
+ * and column n+1 needs Re Y(2p+1) and Im Y(2p). Symmetrizing the folded
+ * columns around 0 makes each of these the real or imaginary part of an
+ * M-point DFT, and they are packed into a single complex FFT.
+ * */
+LTFAT_API int
+LTFAT_NAME(dwilt_execute)(LTFAT_NAME(dwilt_plan)* p, const LTFAT_REAL f[],
+                          LTFAT_REAL c[])
+{
+    ltfat_int M, L, N;
+    const LTFAT_REAL sqrt2h = (LTFAT_REAL) (sqrt(2.0) / 2.0);
+    const LTFAT_REAL half = (LTFAT_REAL) 0.5;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    M = p->fo.M; L = p->fo.L; N = p->fo.N;
+
+    for (ltfat_int w = 0; w < p->fo.W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n += 2)
+        {
+            const LTFAT_REAL* y0 = p->y;
+            const LTFAT_REAL* y1 = p->y + 2 * M;
+            LTFAT_REAL* c0 = c + n * M + w * M * N;
+            LTFAT_REAL* c1 = c0 + M;
+            const LTFAT_COMPLEX* G = p->G;
+
+            LTFAT_NAME(wilson_fold_execute)(&p->fo, f + w * L, n, p->y);
+            LTFAT_NAME(wilson_fold_execute)(&p->fo, f + w * L, n + 1, p->y + 2 * M);
+
+            p->s[0] = y0[0] + y0[M] + I * (y1[0] - y1[M]);
+            for (ltfat_int k = 1; k < M; k++)
+            {
+                ltfat_int km = M - k;
+                LTFAT_REAL a0 = y0[k] + y0[k + M], a0m = y0[km] + y0[km + M];
+                LTFAT_REAL d0 = y0[k] - y0[k + M], d0m = y0[km] - y0[km + M];
+                LTFAT_REAL a1 = y1[k] + y1[k + M], a1m = y1[km] + y1[km + M];
+                LTFAT_REAL d1 = y1[k] - y1[k + M], d1m = y1[km] - y1[km + M];
+
+                p->s[k] = half * ((a0 + a0m) + (d0 + d0m) * p->tw[k] +
+                                  I * ((d1 - d1m) * p->tw[k] + (a1 - a1m)));
+            }
+
+            LTFAT_NAME(fft_execute)(p->p_fft);
+
+            c0[0] = ltfat_real(G[0]);
+
+            if (M % 2)
+                c1[0] = -ltfat_imag(G[(M - 1) / 2]);
+            else
+                c1[0] = ltfat_real(G[M / 2]);
+
+            for (ltfat_int m = 1; m < M; m += 2)
+            {
+                ltfat_int pp = m / 2;
+                c0[m] = -sqrt2h * (ltfat_imag(G[pp]) - ltfat_imag(G[M - 1 - pp]));
+                c1[m] = -sqrt2h * (ltfat_imag(G[pp]) + ltfat_imag(G[M - 1 - pp]));
+            }
+
+            for (ltfat_int m = 2; m < M; m += 2)
+            {
+                ltfat_int pp = m / 2;
+                c0[m] = sqrt2h * (ltfat_real(G[pp]) + ltfat_real(G[M - pp]));
+                c1[m] = sqrt2h * (ltfat_real(G[pp]) - ltfat_real(G[M - pp]));
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(dwilt_done)(LTFAT_NAME(dwilt_plan)** p)
+{
+    LTFAT_NAME(dwilt_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->p_fft) LTFAT_NAME(fft_done)(&pp->p_fft);
+    LTFAT_NAME(wilson_fold_done)(&pp->fo);
+    LTFAT_SAFEFREEALL(pp->y, pp->s, pp->G, pp->tw);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -0,0 +1,118 @@
+/* Shared by the Wilson and WMDCT plans.
+ *
+ * Column n of the coefficients only depends on the window applied at nM and
+ * folded into a 2M periodic buffer. For WMDCT, every other 2M long segment
+ * enters with a negative sign.
+ * */
+typedef struct
+{
+    LTFAT_REAL* g;  //!< Window, circularly shifted to start at -floor(gl/2)
+    ltfat_int gl;
+    ltfat_int gneg; //!< floor(gl/2)
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int M;
+    ltfat_int N;
+    int doflip;
+    int dowrapflip; //!< The WMDCT modulation is not L-periodic if L/(2M) is odd
+} LTFAT_NAME(wilson_fold);
+
+static inline int
+LTFAT_NAME(wilson_fold_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                             ltfat_int W, ltfat_int M, int doflip,
+                             LTFAT_NAME(wilson_fold)* fo)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g);
+    CHECK(LTFATERR_BADSIZE, gl > 0, "gl (passed %td) must be positive", gl);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_BADTRALEN, !(L % (2 * M)),
+          "L (passed %td) must be divisible by 2M=%td.", L, 2 * M);
+    CHECK(LTFATERR_BADREQSIZE, gl <= L,
+          "gl (passed %td) must not be greater than L (passed %td).", gl, L);
+
+    fo->gl = gl; fo->gneg = gl / 2; fo->L = L; fo->W = W; fo->M = M;
+    fo->N = L / M; fo->doflip = doflip;
+    fo->dowrapflip = doflip && ((L / (2 * M)) % 2);
+    CHECKMEM( fo->g = LTFAT_NAME_REAL(malloc)(gl) );
+    LTFAT_NAME_REAL(circshift)(g, gl, fo->gneg, fo->g);
+error:
+    return status;
+}
+
+/* y[k], k=0,...,2M-1 = sum_r (+-1)^r g(j) f(nM + j), j = k + 2Mr
+ *
+ * For WMDCT, the sign also flips whenever nM + j wraps around L and L/(2M) is odd. */
+static inline void
+LTFAT_NAME(wilson_fold_execute)(const LTFAT_NAME(wilson_fold)* fo,
+                                const LTFAT_REAL f[], ltfat_int n, LTFAT_REAL y[])
+{
+    ltfat_int M2 = 2 * fo->M, L = fo->L;
+    ltfat_int l = ltfat_positiverem(n * fo->M - fo->gneg, L);
+    ltfat_int k = ltfat_positiverem(-fo->gneg, M2);
+    LTFAT_REAL sgn = 1.0;
+
+    if (fo->doflip && (((k + fo->gneg) / M2) % 2))
+        sgn = -sgn;
+
+    if (fo->dowrapflip && n * fo->M < fo->gneg)
+        sgn = -sgn;
+
+    memset(y, 0, M2 * sizeof * y);
+
+    for (ltfat_int t = 0; t < fo->gl; t++)
+    {
+        y[k] += sgn * fo->g[t] * f[l];
+        if (++l == L)
+        {
+            l = 0;
+            if (fo->dowrapflip) sgn = -sgn;
+        }
+        if (++k == M2)
+        {
+            k = 0;
+            if (fo->doflip) sgn = -sgn;
+        }
+    }
+}
+
+/* Transpose of wilson_fold_execute, adds to f */
+static inline void
+LTFAT_NAME(wilson_unfold_execute)(const LTFAT_NAME(wilson_fold)* fo,
+                                  const LTFAT_REAL y[], ltfat_int n, LTFAT_REAL f[])
+{
+    ltfat_int M2 = 2 * fo->M, L = fo->L;
+    ltfat_int l = ltfat_positiverem(n * fo->M - fo->gneg, L);
+    ltfat_int k = ltfat_positiverem(-fo->gneg, M2);
+    LTFAT_REAL sgn = 1.0;
+
+    if (fo->doflip && (((k + fo->gneg) / M2) % 2))
+        sgn = -sgn;
+
+    if (fo->dowrapflip && n * fo->M < fo->gneg)
+        sgn = -sgn;
+
+    for (ltfat_int t = 0; t < fo->gl; t++)
+    {
+        f[l] += sgn * fo->g[t] * y[k];
+        if (++l == L)
+        {
+            l = 0;
+            if (fo->dowrapflip) sgn = -sgn;
+        }
+        if (++k == M2)
+        {
+            k = 0;
+            if (fo->doflip) sgn = -sgn;
+        }
+    }
+}
+
+static inline void
+LTFAT_NAME(wilson_fold_done)(LTFAT_NAME(wilson_fold)* fo)
+{
+    ltfat_safefree(fo->g);
+    fo->g = NULL;
+}
@@ -0,0 +1,314 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+struct LTFAT_NAME(fwt_processor_state)
+{
+    ltfat_int J;         //!< Number of levels
+    ltfat_int M;         //!< Number of filters, filter 0 is iterated
+    ltfat_int Wmax;
+    ltfat_int bufLenMax;
+    ltfat_int T;         //!< Length of the delay lines, max(gl) - 1
+    LTFAT_REAL* grev;    //!< Reversed filters, M x (T + 1), aligned to the end
+    ltfat_int* gl;
+    ltfat_int* a;
+    ltfat_int* offset;
+    ltfat_int* wait;     //!< Samples to go until the next output, J x M
+    LTFAT_REAL* tail;    //!< Delay lines, T x Wmax x J
+    LTFAT_REAL* work;    //!< Delay line followed by the new samples
+    ltfat_int* cap;      //!< Capacity of each output per channel
+    LTFAT_REAL** c;      //!< Outputs, c[0] is the approximation
+    ltfat_int* clen;
+    LTFAT_REAL** low;    //!< Lowpass outputs feeding the next level
+    const LTFAT_REAL** inTmp;
+    LTFAT_NAME(fwt_processor_callback)* callback;
+    void* userdata;
+};
+
+/* Index of the output fed by filter m at level j (0-based) */
+static ltfat_int
+LTFAT_NAME(fwt_processor_outidx)(const LTFAT_NAME(fwt_processor_state)* p,
+                                 ltfat_int j, ltfat_int m)
+{
+    if (m == 0) return 0;
+    return 1 + (p->J - 1 - j) * (p->M - 1) + (m - 1);
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                               const ltfat_int a[], const ltfat_int offset[],
+                               ltfat_int M, ltfat_int J, ltfat_int Wmax,
+                               ltfat_int bufLenMax,
+                               LTFAT_NAME(fwt_processor_state)** pout)
+{
+    LTFAT_NAME(fwt_processor_state)* p = NULL;
+    ltfat_int nout, nj;
+
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a); CHECKNULL(offset);
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, M > 1, "M (passed %td) must be at least 2.", M);
+    CHECK(LTFATERR_NOTPOSARG, J > 0, "J (passed %td) must be positive.", J);
+    CHECK(LTFATERR_NOTPOSARG, Wmax > 0, "Wmax (passed %td) must be positive.", Wmax);
+    CHECK(LTFATERR_NOTPOSARG, bufLenMax > 0, "bufLenMax (passed %td) must be positive.", bufLenMax);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(fwt_processor_state)) );
+    p->J = J; p->M = M; p->Wmax = Wmax; p->bufLenMax = bufLenMax;
+    nout = J * (M - 1) + 1;
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        CHECKNULL(g[m]);
+        CHECK(LTFATERR_BADSIZE, gl[m] > 0, "gl[%td] (passed %td) must be positive.", m, gl[m]);
+        CHECK(LTFATERR_NOTPOSARG, a[m] > 0, "a[%td] (passed %td) must be positive.", m, a[m]);
+        CHECK(LTFATERR_BADARG, offset[m] <= 0 && offset[m] > -gl[m],
+              "offset[%td] (passed %td) must be in range [%td,0].", m, offset[m], -gl[m] + 1);
+        p->T = ltfat_imax(p->T, gl[m] - 1);
+    }
+
+    CHECKMEM( p->gl = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->a = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->offset = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->grev = LTFAT_NAME_REAL(calloc)(M * (p->T + 1)) );
+    CHECKMEM( p->wait = LTFAT_NEWARRAY(ltfat_int, J * M) );
+    CHECKMEM( p->tail = LTFAT_NAME_REAL(calloc)(p->T * Wmax * J + 1) );
+    CHECKMEM( p->work = LTFAT_NAME_REAL(malloc)(p->T + bufLenMax) );
+    CHECKMEM( p->cap = LTFAT_NEWARRAY(ltfat_int, nout) );
+    CHECKMEM( p->clen = LTFAT_NEWARRAY(ltfat_int, nout) );
+    CHECKMEM( p->c = LTFAT_NEWARRAY(LTFAT_REAL*, nout) );
+    CHECKMEM( p->low = LTFAT_NEWARRAY(LTFAT_REAL*, J) );
+    CHECKMEM( p->inTmp = LTFAT_NEWARRAY(const LTFAT_REAL*, Wmax) );
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        p->gl[m] = gl[m]; p->a[m] = a[m]; p->offset[m] = offset[m];
+        // Zero padded at the front so that all filters have length T + 1
+        LTFAT_NAME_REAL(reverse_array)(g[m], gl[m],
+                                       p->grev + m * (p->T + 1) + p->T + 1 - gl[m]);
+    }
+
+    // Most samples a level can receive in one call
+    LTFAT_NAME(fwt_processor_reset)(p);
+
+    nj = bufLenMax;
+    for (ltfat_int j = 0; j < J; j++)
+    {
+        for (ltfat_int m = 0; m < M; m++)
+        {
+            ltfat_int capm = (nj + a[m] - 1) / a[m];
+            if (m == 0 && j < J - 1)
+            {
+                CHECKMEM( p->low[j] = LTFAT_NAME_REAL(malloc)(capm * Wmax) );
+                continue;
+            }
+
+            ltfat_int o = LTFAT_NAME(fwt_processor_outidx)(p, j, m);
+            p->cap[o] = capm;
+            CHECKMEM( p->c[o] = LTFAT_NAME_REAL(malloc)(capm * Wmax) );
+            if (m == 0) p->low[j] = p->c[o];
+        }
+        nj = (nj + a[0] - 1) / a[0];
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(fwt_processor_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_reset)(LTFAT_NAME(fwt_processor_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    memset(p->tail, 0, (p->T * p->Wmax * p->J) * sizeof * p->tail);
+
+    // Output n of filter m is due when sample n*a[m] - offset[m] arrives
+    for (ltfat_int j = 0; j < p->J; j++)
+        for (ltfat_int m = 0; m < p->M; m++)
+            p->wait[j * p->M + m] = -p->offset[m];
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_setcallback)(LTFAT_NAME(fwt_processor_state)* p,
+                                      LTFAT_NAME(fwt_processor_callback)* callback,
+                                      void* userdata)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    p->callback = callback;
+    p->userdata = userdata;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(fwt_processor_getnout)(LTFAT_NAME(fwt_processor_state)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->J * (p->M - 1) + 1;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_getdelay)(LTFAT_NAME(fwt_processor_state)* p,
+                                   ltfat_int delay[])
+{
+    ltfat_int rate = 1, lowdelay = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(delay);
+
+    for (ltfat_int j = 0; j < p->J; j++)
+    {
+        for (ltfat_int m = 1; m < p->M; m++)
+            delay[LTFAT_NAME(fwt_processor_outidx)(p, j, m)] =
+                lowdelay - rate * p->offset[m];
+
+        lowdelay -= rate * p->offset[0];
+        rate *= p->a[0];
+    }
+    delay[0] = lowdelay;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_execute)(LTFAT_NAME(fwt_processor_state)* p,
+                                  const LTFAT_REAL* in[], ltfat_int len,
+                                  ltfat_int chanNo)
+{
+    ltfat_int T, M, nin;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(in);
+    CHECK(LTFATERR_BADSIZE, len >= 0, "len must be positive or zero (passed %td)", len);
+    CHECK(LTFATERR_BADSIZE, chanNo >= 0,
+          "chanNo must be positive or zero (passed %td)", chanNo);
+
+    if (chanNo == 0 || len == 0) return LTFATERR_SUCCESS;
+
+    if (chanNo > p->Wmax)
+    {
+        DEBUG("Channel overflow (passed %td, max %td)", chanNo, p->Wmax);
+        status = LTFATERR_OVERFLOW;
+        chanNo = p->Wmax;
+    }
+
+    if (len > p->bufLenMax)
+    {
+        DEBUG("Buffer overflow (passed %td, max %td)", len, p->bufLenMax);
+        status = LTFATERR_OVERFLOW;
+        len = p->bufLenMax;
+    }
+
+    T = p->T; M = p->M; nin = len;
+
+    for (ltfat_int j = 0; j < p->J; j++)
+    {
+        ltfat_int* wait = p->wait + j * M;
+        ltfat_int nlow = 0;
+
+        for (ltfat_int w = 0; w < chanNo; w++)
+        {
+            LTFAT_REAL* tail = p->tail + (j * p->Wmax + w) * T;
+            const LTFAT_REAL* x = j == 0 ? in[w] : p->low[j - 1] + w * nin;
+
+            memcpy(p->work, tail, T * sizeof * p->work);
+            memcpy(p->work + T, x, nin * sizeof * p->work);
+
+            for (ltfat_int m = 0; m < M; m++)
+            {
+                const LTFAT_REAL* grev = p->grev + m * (T + 1);
+                ltfat_int am = p->a[m];
+                ltfat_int i0 = wait[m];
+                ltfat_int nout = i0 < nin ? (nin - 1 - i0) / am + 1 : 0;
+                LTFAT_REAL* out;
+
+                if (m == 0 && j < p->J - 1)
+                    out = p->low[j] + w * nout;
+                else
+                    out = p->c[LTFAT_NAME(fwt_processor_outidx)(p, j, m)] + w * nout;
+
+                for (ltfat_int n = 0; n < nout; n++)
+                {
+                    const LTFAT_REAL* xn = p->work + i0 + n * am;
+                    LTFAT_REAL acc = 0;
+
+                    for (ltfat_int l = 0; l <= T; l++)
+                        acc += xn[l] * grev[l];
+
+                    out[n] = acc;
+                }
+
+                if (m == 0) nlow = nout;
+                if (m > 0 || j == p->J - 1)
+                    p->clen[LTFAT_NAME(fwt_processor_outidx)(p, j, m)] = nout;
+            }
+
+            memcpy(tail, p->work + nin, T * sizeof * p->work);
+        }
+
+        for (ltfat_int m = 0; m < M; m++)
+        {
+            if (wait[m] >= nin)
+                wait[m] -= nin;
+            else
+                wait[m] = wait[m] + ((nin - 1 - wait[m]) / p->a[m] + 1) * p->a[m] - nin;
+        }
+
+        nin = nlow;
+    }
+
+    if (p->callback)
+        p->callback(p->userdata, (const LTFAT_REAL**) p->c, p->clen,
+                    (int) (p->J * (M - 1) + 1), (int) chanNo);
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_execute_compact)(LTFAT_NAME(fwt_processor_state)* p,
+        const LTFAT_REAL in[], ltfat_int len, ltfat_int chanNo)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(in);
+
+    for (ltfat_int w = 0; w < ltfat_imin(chanNo, p->Wmax); w++)
+        p->inTmp[w] = in + w * len;
+
+    return LTFAT_NAME(fwt_processor_execute)(p, p->inTmp, len, chanNo);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(fwt_processor_done)(LTFAT_NAME(fwt_processor_state)** p)
+{
+    LTFAT_NAME(fwt_processor_state)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->c)
+        for (ltfat_int o = 0; o < pp->J * (pp->M - 1) + 1; o++)
+            ltfat_safefree(pp->c[o]);
+
+    // The last level writes the lowpass directly to c[0]
+    if (pp->low)
+        for (ltfat_int j = 0; j < pp->J - 1; j++)
+            ltfat_safefree(pp->low[j]);
+
+    LTFAT_SAFEFREEALL(pp->grev, pp->gl, pp->a, pp->offset, pp->wait,
+                      pp->tail, pp->work, pp->cap, pp->c, pp->clen, pp->low,
+                      pp->inTmp);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
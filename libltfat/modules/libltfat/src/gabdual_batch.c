@@ -0,0 +1,147 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Request k repeats request j if it has the same parameters and the same
+ * window samples. */
+static int
+LTFAT_NAME(gabbatch_samereq)(const LTFAT_TYPE* const g[], const ltfat_int gl[],
+                             const ltfat_int L[], const ltfat_int a[],
+                             const ltfat_int M[], ltfat_int k, ltfat_int j)
+{
+    if (gl[k] != gl[j] || L[k] != L[j] || a[k] != a[j] || M[k] != M[j])
+        return 0;
+
+    return g[k] == g[j] || !memcmp(g[k], g[j], gl[k] * sizeof * g[k]);
+}
+
+static int
+LTFAT_NAME(gabbatch_one)(const LTFAT_TYPE g[], ltfat_int gl, ltfat_int L,
+                         ltfat_int a, ltfat_int M, int tight, LTFAT_TYPE gd[])
+{
+    int status = LTFATERR_SUCCESS;
+
+    if (M > a && gl >= a && M >= gl)
+    {
+        // Painless case, only the frame diagonal is needed
+        LTFAT_TYPE* gdfir = NULL;
+        CHECKMEM( gdfir = LTFAT_NAME(malloc)(gl) );
+
+        if (tight)
+            status = LTFAT_NAME(gabtight_painless)(g, gl, a, M, gdfir);
+        else
+            status = LTFAT_NAME(gabdual_painless)(g, gl, a, M, gdfir);
+
+        if (!status)
+            status = LTFAT_NAME(fir2long)(gdfir, gl, L, gd);
+
+        ltfat_free(gdfir);
+    }
+    else
+    {
+        CHECKSTATUS( LTFAT_NAME(fir2long)(g, gl, L, gd) );
+
+        if (tight)
+            status = LTFAT_NAME(gabtight_long)(gd, L, a, M, gd);
+        else
+            status = LTFAT_NAME(gabdual_long)(gd, L, a, M, gd);
+    }
+
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(gabbatch)(const LTFAT_TYPE* const g[], const ltfat_int gl[],
+                     const ltfat_int L[], const ltfat_int a[],
+                     const ltfat_int M[], ltfat_int K, int tight,
+                     LTFAT_TYPE* gd[])
+{
+    ltfat_int* first = NULL;
+    ltfat_int* uniq = NULL;
+    ltfat_int U = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(gl); CHECKNULL(L); CHECKNULL(a); CHECKNULL(M);
+    CHECKNULL(gd);
+    CHECK(LTFATERR_NOTPOSARG, K > 0, "K (passed %td) must be positive.", K);
+
+    for (ltfat_int k = 0; k < K; k++)
+    {
+        CHECKNULL(g[k]); CHECKNULL(gd[k]);
+        CHECK(LTFATERR_BADSIZE, gl[k] > 0,
+              "gl[%td] (passed %td) must be positive.", k, gl[k]);
+        CHECK(LTFATERR_BADREQSIZE, L[k] >= gl[k],
+              "L[%td]>=gl[%td] must hold. Passed L=%td, gl=%td", k, k, L[k], gl[k]);
+        CHECK(LTFATERR_NOTPOSARG, a[k] > 0 && M[k] > 0,
+              "a[%td] and M[%td] must be positive.", k, k);
+        CHECK(LTFATERR_BADTRALEN, !(L[k] % ltfat_lcm(a[k], M[k])),
+              "L[%td] must be divisible by lcm(a,M)=%td.", k, ltfat_lcm(a[k], M[k]));
+    }
+
+    CHECKMEM( first = LTFAT_NEWARRAY(ltfat_int, K) );
+    CHECKMEM( uniq = LTFAT_NEWARRAY(ltfat_int, K) );
+
+    for (ltfat_int k = 0; k < K; k++)
+    {
+        first[k] = k;
+        for (ltfat_int u = 0; u < U; u++)
+        {
+            if (LTFAT_NAME(gabbatch_samereq)(g, gl, L, a, M, k, uniq[u]))
+            {
+                first[k] = uniq[u];
+                break;
+            }
+        }
+
+        if (first[k] == k)
+            uniq[U++] = k;
+    }
+
+    // The expensive part, one request per thread
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(ltfat_imin(omp_get_max_threads(), U))
+#endif
+    for (ltfat_int u = 0; u < U; u++)
+    {
+        ltfat_int k = uniq[u];
+        int kstatus = LTFAT_NAME(gabbatch_one)(g[k], gl[k], L[k], a[k], M[k],
+                                               tight, gd[k]);
+        if (kstatus)
+        {
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            status = kstatus;
+        }
+    }
+
+    CHECKSTATUS(status);
+
+    for (ltfat_int k = 0; k < K; k++)
+        if (first[k] != k)
+            memcpy(gd[k], gd[first[k]], L[k] * sizeof * gd[k]);
+
+error:
+    LTFAT_SAFEFREEALL(first, uniq);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(gabdual_batch)(const LTFAT_TYPE* const g[], const ltfat_int gl[],
+                          const ltfat_int L[], const ltfat_int a[],
+                          const ltfat_int M[], ltfat_int K, LTFAT_TYPE* gd[])
+{
+    return LTFAT_NAME(gabbatch)(g, gl, L, a, M, K, 0, gd);
+}
+
+LTFAT_API int
+LTFAT_NAME(gabtight_batch)(const LTFAT_TYPE* const g[], const ltfat_int gl[],
+                           const ltfat_int L[], const ltfat_int a[],
+                           const ltfat_int M[], ltfat_int K, LTFAT_TYPE* gt[])
+{
+    return LTFAT_NAME(gabbatch)(g, gl, L, a, M, K, 1, gt);
+}
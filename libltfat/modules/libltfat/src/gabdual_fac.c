@@ -3,50 +3,78 @@
 #include "ltfat/macros.h"
 #include "ltfat/blaslapack.h"
 
-LTFAT_API void
-LTFAT_NAME(gabdual_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
-                        ltfat_int R,
-                        ltfat_int a, ltfat_int M, LTFAT_COMPLEX* gdualf)
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Solves the nblocks independent p x p systems. Every thread has its own
+ * work-array and does a contiguous range of the blocks. */
+static void
+LTFAT_NAME(gabdual_fac_blocks)(const LTFAT_COMPLEX* gf, ltfat_int nblocks,
+                               ltfat_int p, ltfat_int qR, LTFAT_COMPLEX* gdualf)
 {
-
-    ltfat_int h_a, h_m;
-
     LTFAT_COMPLEX* Sf;
 
     const LTFAT_COMPLEX zzero = (LTFAT_COMPLEX) 0.0;//{0.0, 0.0 };
     const LTFAT_COMPLEX alpha = (LTFAT_COMPLEX) 1.0; //{1.0, 0.0 };
 
-    ltfat_int N = L / a;
+#ifdef _OPENMP
+    ltfat_int T = ltfat_imin(omp_get_max_threads(), nblocks);
+#else
+    ltfat_int T = 1;
+#endif
 
-    ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
-    ltfat_int p = a / c;
-    ltfat_int q = M / c;
-    ltfat_int d = N / q;
+    Sf = LTFAT_NAME_COMPLEX(malloc)(p * p * T);
+    if (!Sf) return;
 
-    Sf = LTFAT_NAME_COMPLEX(malloc)(p * p);
-
-    /* Copy the contents of gf to gdualf because LAPACK overwrites it input
-     * argument
-     */
-    memcpy(gdualf, gf, L * R * sizeof * gdualf);
-
-    for (ltfat_int rs = 0; rs < c * d; rs++)
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(T)
+#endif
+    for (ltfat_int t = 0; t < T; t++)
     {
-        LTFAT_NAME(gemm)(CblasNoTrans, CblasConjTrans, p, p, q * R,
-                               &alpha,
-                               gf + rs * p * q * R, p,
-                               gf + rs * p * q * R, p,
-                               &zzero, Sf, p);
-
-        LTFAT_NAME(posv)(p, q * R, Sf, p,
-                               gdualf + rs * p * q * R, p);
-
+        LTFAT_COMPLEX* SfTmp = Sf + t * p * p;
+
+        for (ltfat_int rs = t * nblocks / T; rs < (t + 1) * nblocks / T; rs++)
+        {
+            const LTFAT_COMPLEX* gfTmp = gf + rs * p * qR;
+            LTFAT_COMPLEX* gdualfTmp = gdualf + rs * p * qR;
+
+            /* Copy the block of gf to gdualf because LAPACK overwrites its
+             * input argument
+             */
+            memcpy(gdualfTmp, gfTmp, p * qR * sizeof * gdualfTmp);
+
+            LTFAT_NAME(gemm)(CblasNoTrans, CblasConjTrans, p, p, qR,
+                                   &alpha,
+                                   gfTmp, p,
+                                   gfTmp, p,
+                                   &zzero, SfTmp, p);
+
+            LTFAT_NAME(posv)(p, qR, SfTmp, p,
+                                   gdualfTmp, p);
+        }
     }
 
     /* Clear the work-array. */
     ltfat_free(Sf);
+}
+
+LTFAT_API void
+LTFAT_NAME(gabdual_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
+                        ltfat_int R,
+                        ltfat_int a, ltfat_int M, LTFAT_COMPLEX* gdualf)
+{
 
+    ltfat_int h_a, h_m;
+
+    ltfat_int N = L / a;
+
+    ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
+    ltfat_int p = a / c;
+    ltfat_int q = M / c;
+    ltfat_int d = N / q;
 
+    LTFAT_NAME(gabdual_fac_blocks)(gf, c * d, p, q * R, gdualf);
 }
 
 
@@ -59,11 +87,6 @@ LTFAT_NAME(gabdualreal_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
 
     ltfat_int h_a, h_m;
 
-    LTFAT_COMPLEX* Sf;
-
-    const LTFAT_COMPLEX zzero = (LTFAT_COMPLEX) 0.0;
-    const LTFAT_COMPLEX alpha = (LTFAT_COMPLEX) 1.0; //{1.0, 0.0 };
-
     ltfat_int N = L / a;
 
     ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
@@ -74,28 +97,5 @@ LTFAT_NAME(gabdualreal_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
     /* This is a floor operation. */
     ltfat_int d2 = d / 2 + 1;
 
-    Sf = LTFAT_NAME_COMPLEX(malloc)(p * p);
-
-    /* Copy the contents of gf to gdualf because LAPACK overwrites it input
-     * argument
-     */
-    memcpy(gdualf, gf, sizeof(LTFAT_COMPLEX)*L * R);
-
-    for (ltfat_int rs = 0; rs < c * d2; rs++)
-    {
-        LTFAT_NAME(gemm)(CblasNoTrans, CblasConjTrans, p, p, q * R,
-                               &alpha,
-                               gf + rs * p * q * R, p,
-                               gf + rs * p * q * R, p,
-                               &zzero, Sf, p);
-
-        LTFAT_NAME(posv)(p, q * R, Sf, p,
-                               gdualf + rs * p * q * R, p);
-
-    }
-
-    /* Clear the work-array. */
-    ltfat_free(Sf);
-
-
+    LTFAT_NAME(gabdual_fac_blocks)(gf, c * d2, p, q * R, gdualf);
 }
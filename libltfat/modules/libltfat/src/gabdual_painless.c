@@ -2,15 +2,25 @@
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
 
+/* The frame diagonal index of sample ii is ii mod a in the first half of
+ * the window and (ii - gl) mod a in the second half. The loops below walk
+ * the window in chunks of contiguous diagonal indices so that the inner
+ * loops have unit stride. */
 #define GABDIAGAPPLY(gg) do{ \
-    for (ltfat_int ii = 0; ii < domod.quot + domod.rem; ii++) \
-        (gg)[ii] = g[ii] * d[ii % a]; \
-\
-    for (ltfat_int ii = gl - 1, jj = a - 1; ii >= domod.quot + domod.rem; ii--, jj--)\
-    {\
-        if(jj<0) jj=a-1;\
-        (gg)[ii] = g[ii] * d[jj];\
-    }\
+    ltfat_int half = domod.quot + domod.rem; \
+    for (ltfat_int ii = 0; ii < half; ii += a) \
+    { \
+        ltfat_int n = ltfat_imin(a, half - ii); \
+        for (ltfat_int jj = 0; jj < n; jj++) \
+            (gg)[ii + jj] = g[ii + jj] * d[jj]; \
+    } \
+    for (ltfat_int ii = half, j0 = ltfat_positiverem(half - gl, a); ii < gl; j0 = 0) \
+    { \
+        ltfat_int n = ltfat_imin(a - j0, gl - ii); \
+        for (ltfat_int jj = 0; jj < n; jj++) \
+            (gg)[ii + jj] = g[ii + jj] * d[j0 + jj]; \
+        ii += n; \
+    } \
 }while(0)
 
 #define CHECKGABPAINLESS do{ \
@@ -22,13 +32,27 @@
 }while(0)
 
 
+// d[jj] += |g[jj]|^2 for jj < n
+static inline void
+LTFAT_NAME(gabframediag_accum)(const LTFAT_TYPE* g, ltfat_int n, LTFAT_REAL* d)
+{
+    for (ltfat_int jj = 0; jj < n; jj++)
+    {
+#ifdef LTFAT_COMPLEXTYPE
+        d[jj] += (LTFAT_REAL) ltfat_energy(g[jj]);
+#else
+        d[jj] += g[jj] * g[jj];
+#endif
+    }
+}
+
 // Return first dl entries of the frame diagonal.
 LTFAT_API int
 LTFAT_NAME(gabframediag)(const LTFAT_TYPE* g, ltfat_int gl,
                          ltfat_int a, ltfat_int M, ltfat_int dl, LTFAT_REAL* d)
 {
     ltfat_div_t domod;
-    ltfat_int amax;
+    ltfat_int amax, half;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(g); CHECKNULL(d);
     CHECK(LTFATERR_NOTPOSARG, gl > 0, "gl must be positive");
@@ -41,33 +65,19 @@ LTFAT_NAME(gabframediag)(const LTFAT_TYPE* g, ltfat_int gl,
     memset(d, 0, dl * sizeof * d);
 
     domod = ltfat_idiv(gl, 2);
+    half = domod.quot + domod.rem;
 
     // First half
-    for (ltfat_int aIdx = 0; aIdx < amax; aIdx++)
-    {
-        for (ltfat_int ii = aIdx; ii < domod.quot + domod.rem; ii += a)
-        {
-#ifdef LTFAT_COMPLEXTYPE
-            LTFAT_REAL gabs = ltfat_abs(g[ii]);
-#else
-            LTFAT_REAL gabs = g[ii];
-#endif
-            d[aIdx] += gabs * gabs;
-        }
-    }
+    for (ltfat_int ii = 0; ii < half; ii += a)
+        LTFAT_NAME(gabframediag_accum)(g + ii, ltfat_imin(amax, half - ii), d);
 
-    // Second half from the back
-    for (ltfat_int aIdx = amax - 1; aIdx >= 0; aIdx--)
+    // Second half, the sample gl-1 belongs to d[a-1]
+    for (ltfat_int ii = half, j0 = ltfat_positiverem(half - gl, a); ii < gl; j0 = 0)
     {
-        for (ltfat_int ii = gl - (a - aIdx); ii >= domod.quot + domod.rem; ii -= a)
-        {
-#ifdef LTFAT_COMPLEXTYPE
-            LTFAT_REAL gabs = ltfat_abs(g[ii]);
-#else
-            LTFAT_REAL gabs = g[ii];
-#endif
-            d[aIdx] += gabs * gabs;
-        }
+        ltfat_int n = ltfat_imin(a - j0, gl - ii);
+        if (j0 < amax)
+            LTFAT_NAME(gabframediag_accum)(g + ii, ltfat_imin(n, amax - j0), d + j0);
+        ii += n;
     }
 
     for (ltfat_int aIdx = 0; aIdx < amax; aIdx++)
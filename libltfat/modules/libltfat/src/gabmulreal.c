@@ -0,0 +1,305 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "ltfat/thirdparty/fftw3.h"
+
+struct LTFAT_NAME(gabmulreal_plan)
+{
+    ltfat_int L;
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int N;
+    ltfat_int gal;
+    ltfat_int gsl;
+    LTFAT_REAL* gaw;          //!< fftshifted analysis window
+    LTFAT_REAL* gsw;          //!< fftshifted synthesis window
+    LTFAT_REAL* fw;           //!< Windowed signal segment
+    LTFAT_REAL* sbuf;         //!< Folded frame, length M
+    LTFAT_COMPLEX* cbuf;      //!< Coefficients of one frame, length M2
+    LTFAT_NAME_REAL(fftreal_plan)* fftplan;
+    LTFAT_NAME_REAL(ifftreal_plan)* ifftplan;
+    LTFAT_REAL* sym;          //!< Symbol, M2 x N
+    ltfat_int* active;        //!< Indices of the nonzero symbol columns
+    unsigned char* isactive;  //!< The same as a mask of length N
+    ltfat_int nactive;
+    ltfat_int computed;
+    ltfat_int skipped;
+    ltfat_int rtframe;        //!< Symbol column of the next streamed frame
+    ltfat_int rtcur;          //!< Symbol column of the current streamed frame
+};
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_init)(const LTFAT_REAL ga[], ltfat_int gal,
+                            const LTFAT_REAL gs[], ltfat_int gsl,
+                            ltfat_int L, ltfat_int a, ltfat_int M,
+                            unsigned flags, LTFAT_NAME(gabmulreal_plan)** pout)
+{
+    LTFAT_NAME(gabmulreal_plan)* p = NULL;
+    ltfat_int M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(ga); CHECKNULL(gs); CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, gal > 0 && gsl > 0,
+          "Window lengths must be positive (passed %td and %td).", gal, gsl);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a must be positive");
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M must be positive");
+    CHECK(LTFATERR_BADTRALEN, L >= gal && L >= gsl && !(L % a),
+          "L (passed %td) must be greater or equal to the window lengths and divisible by a (passed %td).",
+          L, a);
+
+    M2 = M / 2 + 1;
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(gabmulreal_plan)) );
+    p->L = L; p->a = a; p->M = M; p->N = L / a; p->gal = gal; p->gsl = gsl;
+
+    CHECKMEM( p->gaw = LTFAT_NAME_REAL(malloc)(gal) );
+    CHECKMEM( p->gsw = LTFAT_NAME_REAL(malloc)(gsl) );
+    CHECKMEM( p->fw = LTFAT_NAME_REAL(malloc)(gal) );
+    CHECKMEM( p->sbuf = LTFAT_NAME_REAL(malloc)(M) );
+    CHECKMEM( p->cbuf = LTFAT_NAME_COMPLEX(malloc)(M2) );
+    CHECKMEM( p->sym = LTFAT_NAME_REAL(calloc)(M2 * p->N) );
+    CHECKMEM( p->active = LTFAT_NEWARRAY(ltfat_int, p->N) );
+    CHECKMEM( p->isactive = LTFAT_NEWARRAY(unsigned char, p->N) );
+
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(fftreal_init)(M, 1, p->sbuf, p->cbuf, flags, &p->fftplan));
+    CHECKSTATUS(
+        LTFAT_NAME_REAL(ifftreal_init)(M, 1, p->cbuf, p->sbuf, flags, &p->ifftplan));
+
+    LTFAT_NAME(fftshift)(ga, gal, p->gaw);
+    LTFAT_NAME(fftshift)(gs, gsl, p->gsw);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(gabmulreal_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_done)(LTFAT_NAME(gabmulreal_plan)** p)
+{
+    LTFAT_NAME(gabmulreal_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->fftplan) LTFAT_NAME_REAL(fftreal_done)(&pp->fftplan);
+    if (pp->ifftplan) LTFAT_NAME_REAL(ifftreal_done)(&pp->ifftplan);
+    LTFAT_SAFEFREEALL(pp->gaw, pp->gsw, pp->fw, pp->sbuf, pp->cbuf, pp->sym,
+                      pp->active, pp->isactive);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+static void
+LTFAT_NAME(gabmulreal_resetstats)(LTFAT_NAME(gabmulreal_plan)* p)
+{
+    p->nactive = 0;
+    for (ltfat_int n = 0; n < p->N; n++)
+        if (p->isactive[n])
+            p->active[p->nactive++] = n;
+
+    p->computed = 0; p->skipped = 0;
+    p->rtframe = 0; p->rtcur = 0;
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_set_symbol)(LTFAT_NAME(gabmulreal_plan)* p,
+                                  const LTFAT_REAL s[])
+{
+    ltfat_int M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(s);
+    M2 = p->M / 2 + 1;
+
+    memcpy(p->sym, s, M2 * p->N * sizeof * s);
+
+    for (ltfat_int n = 0; n < p->N; n++)
+    {
+        const LTFAT_REAL* scol = s + n * M2;
+        ltfat_int m = 0;
+        while (m < M2 && scol[m] == 0) m++;
+        p->isactive[n] = m < M2;
+    }
+
+    LTFAT_NAME(gabmulreal_resetstats)(p);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_set_symbol_sparse)(LTFAT_NAME(gabmulreal_plan)* p,
+        const LTFAT_REAL s[], const ltfat_int cols[], ltfat_int ncols)
+{
+    ltfat_int M2;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, ncols >= 0 && ncols <= p->N,
+          "ncols (passed %td) must be in range [0, %td].", ncols, p->N);
+    if (ncols > 0) { CHECKNULL(s); CHECKNULL(cols); }
+    M2 = p->M / 2 + 1;
+
+    for (ltfat_int k = 0; k < ncols; k++)
+        CHECK(LTFATERR_BADARG, cols[k] >= 0 && cols[k] < p->N,
+              "cols[%td] (passed %td) must be in range [0, %td).", k, cols[k], p->N);
+
+    memset(p->isactive, 0, p->N * sizeof * p->isactive);
+    LTFAT_NAME(clear_array)(p->sym, M2 * p->N);
+
+    for (ltfat_int k = 0; k < ncols; k++)
+    {
+        memcpy(p->sym + cols[k] * M2, s + k * M2, M2 * sizeof * s);
+        p->isactive[cols[k]] = 1;
+    }
+
+    LTFAT_NAME(gabmulreal_resetstats)(p);
+error:
+    return status;
+}
+
+/* Analysis, multiplication and synthesis of a single frame */
+static void
+LTFAT_NAME(gabmulreal_frame)(LTFAT_NAME(gabmulreal_plan)* p,
+                             const LTFAT_REAL f[], ltfat_int n, LTFAT_REAL out[])
+{
+    ltfat_int L = p->L, M2 = p->M / 2 + 1;
+    ltfat_int gah = p->gal / 2, gsh = p->gsl / 2;
+    ltfat_int fidx = ltfat_positiverem(n * p->a - gah, L);
+    const LTFAT_REAL* scol = p->sym + n * M2;
+
+    for (ltfat_int l = 0; l < p->gal; l++)
+    {
+        p->fw[l] = f[fidx] * p->gaw[l];
+        if (++fidx == L) fidx = 0;
+    }
+
+    LTFAT_NAME(fold_array)(p->fw, p->gal, -gah, p->M, p->sbuf);
+    LTFAT_NAME_REAL(fftreal_execute)(p->fftplan);
+
+    for (ltfat_int m = 0; m < M2; m++)
+        p->cbuf[m] *= scol[m];
+
+    LTFAT_NAME_REAL(ifftreal_execute)(p->ifftplan);
+
+    fidx = ltfat_positiverem(n * p->a - gsh, L);
+    for (ltfat_int l = 0, sidx = ltfat_positiverem(-gsh, p->M); l < p->gsl; l++)
+    {
+        out[fidx] += p->gsw[l] * p->sbuf[sidx];
+        if (++fidx == L) fidx = 0;
+        if (++sidx == p->M) sidx = 0;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_execute)(LTFAT_NAME(gabmulreal_plan)* p,
+                               const LTFAT_REAL f[], ltfat_int W,
+                               LTFAT_REAL out[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(out);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_BADARG, f != out, "The operator cannot work inplace.");
+
+    LTFAT_NAME(clear_array)(out, p->L * W);
+
+    for (ltfat_int w = 0; w < W; w++)
+        for (ltfat_int k = 0; k < p->nactive; k++)
+            LTFAT_NAME(gabmulreal_frame)(p, f + w * p->L, p->active[k],
+                                         out + w * p->L);
+
+    p->computed += p->nactive * W;
+    p->skipped += (p->N - p->nactive) * W;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_get_framestats)(LTFAT_NAME(gabmulreal_plan)* p,
+                                      ltfat_int* computed, ltfat_int* skipped)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    if (computed) *computed = p->computed;
+    if (skipped) *skipped = p->skipped;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(gabmulreal_get_nactive)(LTFAT_NAME(gabmulreal_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->nactive;
+error:
+    return status;
+}
+
+/* Streaming: the symbol columns are applied cyclically to the frames */
+static int
+LTFAT_NAME(gabmulreal_rtactivity)(void* userdata)
+{
+    LTFAT_NAME(gabmulreal_plan)* p = (LTFAT_NAME(gabmulreal_plan)*) userdata;
+
+    p->rtcur = p->rtframe;
+    if (++p->rtframe == p->N) p->rtframe = 0;
+
+    if (p->isactive[p->rtcur])
+    {
+        p->computed++;
+        return 1;
+    }
+
+    p->skipped++;
+    return 0;
+}
+
+static void
+LTFAT_NAME(gabmulreal_rtcallback)(void* userdata, const LTFAT_COMPLEX in[],
+                                  int M2, int W, LTFAT_COMPLEX out[])
+{
+    LTFAT_NAME(gabmulreal_plan)* p = (LTFAT_NAME(gabmulreal_plan)*) userdata;
+    const LTFAT_REAL* scol = p->sym + p->rtcur * M2;
+
+    for (int w = 0; w < W; w++)
+        for (int m = 0; m < M2; m++)
+            out[m + w * M2] = in[m + w * M2] * scol[m];
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal_attach_processor)(LTFAT_NAME(gabmulreal_plan)* p,
+                                        LTFAT_NAME(rtdgtreal_processor_state)* proc)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(proc);
+
+    CHECKSTATUS(
+        LTFAT_NAME(rtdgtreal_processor_setcallback)(proc,
+                &LTFAT_NAME(gabmulreal_rtcallback), p));
+    CHECKSTATUS(
+        LTFAT_NAME(rtdgtreal_processor_setactivitycallback)(proc,
+                &LTFAT_NAME(gabmulreal_rtactivity)));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(gabmulreal)(const LTFAT_REAL f[], const LTFAT_REAL ga[],
+                       ltfat_int gal, const LTFAT_REAL gs[], ltfat_int gsl,
+                       const LTFAT_REAL s[], ltfat_int L, ltfat_int W,
+                       ltfat_int a, ltfat_int M, LTFAT_REAL out[])
+{
+    LTFAT_NAME(gabmulreal_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS(
+        LTFAT_NAME(gabmulreal_init)(ga, gal, gs, gsl, L, a, M, FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(gabmulreal_set_symbol)(p, s));
+    CHECKSTATUS( LTFAT_NAME(gabmulreal_execute)(p, f, W, out));
+
+error:
+    if (p) LTFAT_NAME(gabmulreal_done)(&p);
+    return status;
+}
@@ -30,13 +30,13 @@ LTFAT_NAME(multiwingabtight_long)(const LTFAT_TYPE g[],
 #ifdef LTFAT_COMPLEXTYPE
 
     CHECKSTATUS( LTFAT_NAME(wfac)(g, L, R, a, M, gf));
-    LTFAT_NAME_REAL(gabtight_fac)(gf, L, R, a, M, gtf);
+    CHECKSTATUS( LTFAT_NAME_REAL(gabtight_fac)(gf, L, R, a, M, gtf));
     CHECKSTATUS( LTFAT_NAME(iwfac)(gtf, L, R, a, M, gt));
 
 #else
 
     LTFAT_NAME_REAL(wfacreal)(g, L, R, a, M, gf);
-    LTFAT_NAME_REAL(gabtightreal_fac)(gf, L, R, a, M, gtf);
+    CHECKSTATUS( LTFAT_NAME_REAL(gabtightreal_fac)(gf, L, R, a, M, gtf));
     LTFAT_NAME_REAL(iwfacreal)(gtf, L, R, a, M, gt);
 
 #endif
@@ -71,7 +71,7 @@ LTFAT_NAME(gabtight_fir)(const LTFAT_TYPE* g, ltfat_int gl,
     CHECKMEM( tmpLong = LTFAT_NAME(malloc)(L));
 
     LTFAT_NAME(fir2long)(g, gl, L, tmpLong);
-    LTFAT_NAME(gabtight_long)(tmpLong, L, a, M, tmpLong);
+    CHECKSTATUS( LTFAT_NAME(gabtight_long)(tmpLong, L, a, M, tmpLong));
     LTFAT_NAME(long2fir)(tmpLong, L, gtl, gt);
 
 error:
@@ -3,7 +3,75 @@
 #include "ltfat/macros.h"
 #include "ltfat/blaslapack.h"
 
-LTFAT_API void
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Computes U*VT of the thin SVD of the nblocks independent p x qR blocks.
+ * Every thread has its own work-arrays and does a contiguous range of the
+ * blocks. */
+static int
+LTFAT_NAME(gabtight_fac_blocks)(const LTFAT_COMPLEX* gf, ltfat_int nblocks,
+                                ltfat_int p, ltfat_int qR, LTFAT_COMPLEX* gtightf)
+{
+    LTFAT_COMPLEX* U = NULL, *VT = NULL, *gfwork = NULL;
+    LTFAT_REAL* S = NULL;
+    int svdfailed = 0;
+    int status = LTFATERR_SUCCESS;
+
+    const LTFAT_COMPLEX zzero = (LTFAT_COMPLEX) 0.0;//{0.0, 0.0 };
+    const LTFAT_COMPLEX alpha = (LTFAT_COMPLEX) 1.0; //{1.0, 0.0 };
+
+#ifdef _OPENMP
+    ltfat_int T = ltfat_imin(omp_get_max_threads(), nblocks);
+#else
+    ltfat_int T = 1;
+#endif
+
+    CHECKMEM( S  = LTFAT_NAME_REAL(malloc)(p * T) );
+    CHECKMEM( U  = LTFAT_NAME_COMPLEX(malloc)(p * p * T) );
+    CHECKMEM( VT = LTFAT_NAME_COMPLEX(malloc)(p * qR * T) );
+    CHECKMEM( gfwork = LTFAT_NAME_COMPLEX(malloc)(p * qR * T) );
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(T) reduction(|:svdfailed)
+#endif
+    for (ltfat_int t = 0; t < T; t++)
+    {
+        LTFAT_REAL* STmp = S + t * p;
+        LTFAT_COMPLEX* UTmp = U + t * p * p;
+        LTFAT_COMPLEX* VTTmp = VT + t * p * qR;
+        LTFAT_COMPLEX* gfworkTmp = gfwork + t * p * qR;
+
+        for (ltfat_int rs = t * nblocks / T; rs < (t + 1) * nblocks / T; rs++)
+        {
+            /* Copy the block of gf to gfwork because LAPACK overwrites
+             * the input.
+             */
+            memcpy(gfworkTmp, gf + rs * p * qR, p * qR * sizeof * gfworkTmp);
+
+            /* Compute the thin SVD */
+            if (LTFAT_NAME(gesvd)(p, qR, gfworkTmp, p,
+                                  STmp, UTmp, p, VTTmp, p))
+                svdfailed = 1;
+
+            /* Combine U and V. */
+            LTFAT_NAME(gemm)(CblasNoTrans, CblasNoTrans, p, qR, p,
+                                   &alpha, (const LTFAT_COMPLEX*)UTmp, p,
+                                   (const LTFAT_COMPLEX*)VTTmp, p,
+                                   &zzero, gtightf + rs * p * qR, p);
+        }
+    }
+
+    CHECK(LTFATERR_FAILED, !svdfailed,
+          "The SVD of a block of the factorization failed.");
+
+error:
+    LTFAT_SAFEFREEALL(gfwork, S, U, VT);
+    return status;
+}
+
+LTFAT_API int
 LTFAT_NAME(gabtight_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
                          ltfat_int R,
                          ltfat_int a, ltfat_int M,
@@ -12,12 +80,6 @@ LTFAT_NAME(gabtight_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
 
     ltfat_int h_a, h_m;
 
-    LTFAT_COMPLEX* Sf, *U, *VT, *gfwork;
-    LTFAT_REAL* S;
-
-    const LTFAT_COMPLEX zzero = (LTFAT_COMPLEX) 0.0;//{0.0, 0.0 };
-    const LTFAT_COMPLEX alpha = (LTFAT_COMPLEX) 1.0; //{1.0, 0.0 };
-
     ltfat_int N = L / a;
 
     ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
@@ -25,38 +87,11 @@ LTFAT_NAME(gabtight_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
     ltfat_int q = M / c;
     ltfat_int d = N / q;
 
-    S  = LTFAT_NAME_REAL(malloc)(p);
-    Sf = LTFAT_NAME_COMPLEX(malloc)(p * p);
-    U  = LTFAT_NAME_COMPLEX(malloc)(p * p);
-    VT = LTFAT_NAME_COMPLEX(malloc)(p * q * R);
-    gfwork = LTFAT_NAME_COMPLEX(malloc)(L * R);
-
-    /* Copy the contents of gf to gfwork because LAPACK overwrites
-     * the input.
-     */
-    memcpy(gfwork, gf, L * R * sizeof * gfwork);
-
-    for (ltfat_int rs = 0; rs < c * d; rs++)
-    {
-        /* Compute the thin SVD */
-        LTFAT_NAME(gesvd)(p, q * R, gfwork + rs * p * q * R, p,
-                                S, U, p, VT, p);
-
-        /* Combine U and V. */
-        LTFAT_NAME(gemm)(CblasNoTrans, CblasNoTrans, p, q * R, p,
-                               &alpha, (const LTFAT_COMPLEX*)U, p,
-                               (const LTFAT_COMPLEX*)VT, p,
-                               &zzero, gtightf + rs * p * q * R, p);
-
-
-    }
-
-    LTFAT_SAFEFREEALL(gfwork, Sf, S, U, VT);
-
+    return LTFAT_NAME(gabtight_fac_blocks)(gf, c * d, p, q * R, gtightf);
 }
 
 
-LTFAT_API void
+LTFAT_API int
 LTFAT_NAME(gabtightreal_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
                              ltfat_int R,
                              ltfat_int a, ltfat_int M,
@@ -65,12 +100,6 @@ LTFAT_NAME(gabtightreal_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
 
     ltfat_int h_a, h_m;
 
-    LTFAT_COMPLEX* Sf, *U, *VT, *gfwork;
-    LTFAT_REAL* S;
-
-    const LTFAT_COMPLEX zzero = (LTFAT_COMPLEX) 0.0;
-    const LTFAT_COMPLEX alpha = (LTFAT_COMPLEX) 1.0; //{1.0, 0.0 };
-
     ltfat_int N = L / a;
 
     ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
@@ -81,29 +110,5 @@ LTFAT_NAME(gabtightreal_fac)(const LTFAT_COMPLEX* gf, ltfat_int L,
     /* This is a floor operation. */
     ltfat_int d2 = d / 2 + 1;
 
-    S  = LTFAT_NAME_REAL(malloc)(p);
-    Sf = LTFAT_NAME_COMPLEX(malloc)(p * p);
-    U  = LTFAT_NAME_COMPLEX(malloc)(p * p);
-    VT = LTFAT_NAME_COMPLEX(malloc)(p * q * R);
-    gfwork = LTFAT_NAME_COMPLEX(malloc)(L * R);
-
-    /* Copy the contents of gf to gfwork because LAPACK overwrites
-     * the input.
-     */
-    memcpy(gfwork, gf, L * R * sizeof * gfwork);
-
-    for (ltfat_int rs = 0; rs < c * d2; rs++)
-    {
-        /* Compute the thin SVD */
-        LTFAT_NAME(gesvd)(p, q * R, gfwork + rs * p * q * R, p,
-                                S, U, p, VT, p);
-
-        /* Combine U and V. */
-        LTFAT_NAME(gemm)(CblasNoTrans, CblasNoTrans, p, q * R, p,
-                               &alpha, (const LTFAT_COMPLEX*)U, p,
-                               (const LTFAT_COMPLEX*)VT, p,
-                               &zzero, gtightf + rs * p * q * R, p);
-    }
-
-    LTFAT_SAFEFREEALL(gfwork, Sf, S, U, VT);
+    return LTFAT_NAME(gabtight_fac_blocks)(gf, c * d2, p, q * R, gtightf);
 }
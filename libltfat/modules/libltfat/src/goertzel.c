@@ -4,32 +4,46 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+/* Number of bins processed together. The recursions of the bins are
+ * independent, so the inner loop over them maps onto SIMD lanes. */
 #ifndef GGA_UNROLL
-#   define GGA_UNROLL 8
+#   define GGA_UNROLL 32
+#endif
+
+/* Number of samples processed by all bins of a thread before moving on, so
+ * that the signal is read from the cache rather than from the memory. */
+#ifndef GGA_CHUNK
+#   define GGA_CHUNK 2048
 #endif
 
 struct LTFAT_NAME(gga_plan_struct)
 {
-    LTFAT_REAL* cos_term;
+    LTFAT_REAL* cos_term; //!< Zero padded to Mpad
     LTFAT_COMPLEX* cc_term;
     LTFAT_COMPLEX* cc2_term;
+    LTFAT_REAL* s1; //!< Recursion state, Mpad (twice for complex input)
+    LTFAT_REAL* s2;
     ltfat_int M;
+    ltfat_int Mpad;
     ltfat_int L;
+    ltfat_int nthreads;
 };
 
 struct LTFAT_NAME(chzt_plan_struct)
 {
-    LTFAT_COMPLEX* fbuffer;
+    LTFAT_COMPLEX* fbuffer; //!< Wbatch channels of q columns of length Lfft
     LTFAT_COMPLEX* W2;
     LTFAT_COMPLEX* Wo;
     LTFAT_COMPLEX* chirpF;
-    /* LTFAT_FFTW(plan) plan; */
-    /* LTFAT_FFTW(plan) plan2; */
-    LTFAT_NAME_REAL(fft_plan)* plan;
+    LTFAT_NAME_REAL(fft_plan)* plan;    //!< All Wbatch channels at once
     LTFAT_NAME_REAL(ifft_plan)* plan2;
+    LTFAT_NAME_REAL(fft_plan)* plan1;   //!< Single channel, NULL if Wbatch == 1
+    LTFAT_NAME_REAL(ifft_plan)* plan21;
     ltfat_int L;
     ltfat_int K;
     ltfat_int Lfft;
+    ltfat_int q;      //!< Number of columns per channel, 1 for chzt
+    ltfat_int Wbatch;
 };
 
 
@@ -37,44 +51,99 @@ LTFAT_API LTFAT_NAME(gga_plan)
 LTFAT_NAME(gga_init)(const LTFAT_REAL* indVecPtr, ltfat_int M,
                      ltfat_int L)
 {
-    LTFAT_REAL* cos_term = LTFAT_NAME_REAL(malloc)(M);
-    LTFAT_COMPLEX* cc_term = LTFAT_NAME_COMPLEX(malloc)(M);
-    LTFAT_COMPLEX* cc2_term = LTFAT_NAME_COMPLEX(malloc)(M);
-
-    LTFAT_REAL pik_term_pre = (LTFAT_REAL) (2.0 * M_PI / ((double) L));
-    LTFAT_COMPLEX cc2_pre = -I * (LTFAT_REAL)(L - 1);
-    LTFAT_COMPLEX cc_pre =  -I * (LTFAT_REAL)(L);
+    LTFAT_NAME(gga_plan) plan = NULL;
+    ltfat_int Mpad = ltfat_idivceil(M, GGA_UNROLL) * GGA_UNROLL;
+#ifdef LTFAT_COMPLEXTYPE
+    ltfat_int nstate = 2 * Mpad;
+#else
+    ltfat_int nstate = Mpad;
+#endif
+    LTFAT_REAL pik_term_pre;
+    LTFAT_COMPLEX cc2_pre, cc_pre;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(indVecPtr);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+
+    CHECKMEM( plan = LTFAT_NEW(struct LTFAT_NAME(gga_plan_struct)) );
+    plan->M = M; plan->Mpad = Mpad; plan->L = L; plan->nthreads = 1;
+
+    CHECKMEM( plan->cos_term = LTFAT_NAME_REAL(calloc)(Mpad) );
+    CHECKMEM( plan->cc_term = LTFAT_NAME_COMPLEX(malloc)(M) );
+    CHECKMEM( plan->cc2_term = LTFAT_NAME_COMPLEX(malloc)(M) );
+    CHECKMEM( plan->s1 = LTFAT_NAME_REAL(malloc)(nstate) );
+    CHECKMEM( plan->s2 = LTFAT_NAME_REAL(malloc)(nstate) );
+
+    pik_term_pre = (LTFAT_REAL) (2.0 * M_PI / ((double) L));
+    cc2_pre = -I * (LTFAT_REAL)(L - 1);
+    cc_pre =  -I * (LTFAT_REAL)(L);
 
     for (ltfat_int m = 0; m < M; m++)
     {
         LTFAT_REAL pik_term = pik_term_pre * indVecPtr[m];
-        cos_term[m] = (LTFAT_REAL) ( cos(pik_term) * 2.0 );
-        cc_term[m] = (LTFAT_COMPLEX) exp(cc_pre * pik_term);
-        cc2_term[m] = (LTFAT_COMPLEX) exp(cc2_pre * pik_term);
+        plan->cos_term[m] = (LTFAT_REAL) ( cos(pik_term) * 2.0 );
+        plan->cc_term[m] = (LTFAT_COMPLEX) exp(cc_pre * pik_term);
+        plan->cc2_term[m] = (LTFAT_COMPLEX) exp(cc2_pre * pik_term);
     }
 
-    // This is workaround for defining constant elements of the struct.
-    /* struct LTFAT_NAME(gga_plan_struct) plan_tmp = */
-    /* {.cos_term = cos_term, .cc_term = cc_term, .cc2_term = cc2_term, .M = M, .L = L}; */
-
-    LTFAT_NAME(gga_plan) plan = (LTFAT_NAME(gga_plan)) ltfat_malloc(sizeof * plan);
-    plan->cos_term = cos_term; plan->cc_term = cc_term;
-    plan->cc2_term = cc2_term; plan->M = M; plan->L = L;
-
-    /* memcpy(plan, &plan_tmp, sizeof * plan); */
-
     return plan;
+error:
+    if (plan) LTFAT_NAME(gga_done)(plan);
+    return NULL;
+}
+
+LTFAT_API int
+LTFAT_NAME(gga_set_nthreads)(LTFAT_NAME(gga_plan) p, ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+#ifdef _OPENMP
+    p->nthreads = nthreads;
+#endif
+error:
+    return status;
 }
 
 LTFAT_API
 void LTFAT_NAME(gga_done)(LTFAT_NAME(gga_plan) plan)
 {
-    LTFAT_SAFEFREEALL((void*)plan->cos_term,
-                      (void*)plan->cc_term,
-                      (void*)plan->cc2_term);
+    LTFAT_SAFEFREEALL(plan->cos_term, plan->cc_term, plan->cc2_term,
+                      plan->s1, plan->s2);
     ltfat_free(plan);
 }
 
+/* Advances the recursion of GGA_UNROLL bins by Lc samples of a real sequence
+ * f with stride fstride. */
+static inline void
+LTFAT_NAME(gga_kernel)(const LTFAT_REAL* f, ltfat_int Lc, ltfat_int fstride,
+                       const LTFAT_REAL* cos_term, LTFAT_REAL* s1out,
+                       LTFAT_REAL* s2out)
+{
+    LTFAT_REAL c[GGA_UNROLL], s1[GGA_UNROLL], s2[GGA_UNROLL];
+
+    for (ltfat_int un = 0; un < GGA_UNROLL; un++)
+    {
+        c[un] = cos_term[un]; s1[un] = s1out[un]; s2[un] = s2out[un];
+    }
+
+    for (ltfat_int ii = 0; ii < Lc; ii++)
+    {
+        LTFAT_REAL x = f[ii * fstride];
+        for (ltfat_int un = 0; un < GGA_UNROLL; un++)
+        {
+            LTFAT_REAL s0 = x + c[un] * s1[un] - s2[un];
+            s2[un] = s1[un];
+            s1[un] = s0;
+        }
+    }
+
+    for (ltfat_int un = 0; un < GGA_UNROLL; un++)
+    {
+        s1out[un] = s1[un]; s2out[un] = s2[un];
+    }
+}
 
 LTFAT_API
 void LTFAT_NAME(gga_execute)(LTFAT_NAME(gga_plan) p,
@@ -82,110 +151,77 @@ void LTFAT_NAME(gga_execute)(LTFAT_NAME(gga_plan) p,
                              ltfat_int W,
                              LTFAT_COMPLEX* cPtr)
 {
-#ifndef GGA_UNROLL
+    ltfat_int L = p->L, M = p->M, Mpad = p->Mpad;
+    ltfat_int nblocks = Mpad / GGA_UNROLL;
+#ifdef LTFAT_COMPLEXTYPE
+    // The real and the imaginary parts run as separate real recursions
+    ltfat_int fstride = 2;
+#else
+    ltfat_int fstride = 1;
+#endif
 
     for (ltfat_int w = 0; w < W; w++)
     {
-        LTFAT_COMPLEX* cPtrTmp = (LTFAT_COMPLEX*) cPtr + w * p.M;
+        const LTFAT_REAL* fw = (const LTFAT_REAL*) (fPtr + w * L);
+        LTFAT_COMPLEX* cw = cPtr + w * M;
 
-        for (ltfat_int m = 0; m < p.M; m++)
+        // Every thread runs through the signal once for its own bins
+#ifdef _OPENMP
+        #pragma omp parallel num_threads(p->nthreads)
+#endif
         {
-            LTFAT_TYPE s0 =  0.0;
-            LTFAT_TYPE s1 =  0.0;
-            LTFAT_TYPE s2 =  0.0;
-            LTFAT_TYPE* fPtrTmp = (LTFAT_TYPE*) fPtr + w * p.L;
-
-            for (ltfat_int ii = 0; ii < p.L - 1; ii++)
+#ifdef _OPENMP
+            #pragma omp for schedule(static)
+#endif
+            for (ltfat_int b = 0; b < nblocks; b++)
             {
-                s0 = *fPtrTmp++ + p.cos_term[m] * s1 - s2;
-                s2 = s1;
-                s1 = s0;
+                ltfat_int m = b * GGA_UNROLL;
+                memset(p->s1 + m, 0, GGA_UNROLL * sizeof * p->s1);
+                memset(p->s2 + m, 0, GGA_UNROLL * sizeof * p->s2);
+#ifdef LTFAT_COMPLEXTYPE
+                memset(p->s1 + Mpad + m, 0, GGA_UNROLL * sizeof * p->s1);
+                memset(p->s2 + Mpad + m, 0, GGA_UNROLL * sizeof * p->s2);
+#endif
             }
-            s0 = *fPtrTmp + p.cos_term[m] * s1 - s2;
 
-            *cPtrTmp++ = (s0 * p.cc2_term[m] - s1 * p.cc_term[m]);
-        }
-    }
-#else
-    for (ltfat_int w = 0; w < W; w++)
-    {
-        LTFAT_COMPLEX* cPtrTmp = (LTFAT_COMPLEX*) cPtr + w * p->M;
-        ltfat_int unrollRem = p->M % GGA_UNROLL;
-
-        const LTFAT_REAL* cos_term = p->cos_term;
-        const LTFAT_COMPLEX* cc_term = p->cc_term;
-        const LTFAT_COMPLEX* cc2_term = p->cc2_term;
-//#pragma omp parallel for
-        for (ltfat_int m = 0; m < p->M - unrollRem; m += GGA_UNROLL)
-        {
-            LTFAT_TYPE s0[GGA_UNROLL] = {0};
-            LTFAT_TYPE s1[GGA_UNROLL] = {0};
-            LTFAT_TYPE s2[GGA_UNROLL] = {0};
-
-            /* for (ltfat_int un = 0; un < GGA_UNROLL; un++) */
-            /* { */
-            /*     s0[un] = 0.0; */
-            /*     s1[un] = 0.0; */
-            /*     s2[un] = 0.0; */
-            /* } */
-
-            LTFAT_TYPE* fPtrTmp = (LTFAT_TYPE*) fPtr + w * p->L;
-
-            for (ltfat_int ii = 0; ii < p->L - 1; ii++)
+            for (ltfat_int l = 0; l < L - 1; l += GGA_CHUNK)
             {
-                for (ltfat_int un = 0; un < GGA_UNROLL; un++)
+                ltfat_int Lc = ltfat_imin(GGA_CHUNK, L - 1 - l);
+#ifdef _OPENMP
+                #pragma omp for schedule(static) nowait
+#endif
+                for (ltfat_int b = 0; b < nblocks; b++)
                 {
-                    s0[un] = *fPtrTmp + cos_term[un] * s1[un] - s2[un];
-                    s2[un] = s1[un];
-                    s1[un] = s0[un];
+                    ltfat_int m = b * GGA_UNROLL;
+                    LTFAT_NAME(gga_kernel)(fw + l * fstride, Lc, fstride,
+                                           p->cos_term + m, p->s1 + m, p->s2 + m);
+#ifdef LTFAT_COMPLEXTYPE
+                    LTFAT_NAME(gga_kernel)(fw + l * fstride + 1, Lc, fstride,
+                                           p->cos_term + m, p->s1 + Mpad + m,
+                                           p->s2 + Mpad + m);
+#endif
                 }
-                fPtrTmp++;
             }
-            for (ltfat_int un = 0; un < GGA_UNROLL; un++)
-            {
-                s0[un] = *fPtrTmp + cos_term[un] * s1[un] - s2[un];
-                cPtrTmp[m + un] = (s0[un] * cc2_term[un] - s1[un] * cc_term[un]);
-            }
-            cos_term += GGA_UNROLL;
-            cc_term += GGA_UNROLL;
-            cc2_term += GGA_UNROLL;
         }
 
-        ltfat_int m = p->M - unrollRem;
-
-
-        LTFAT_TYPE s0[GGA_UNROLL] = {0};
-        LTFAT_TYPE s1[GGA_UNROLL] = {0};
-        LTFAT_TYPE s2[GGA_UNROLL] = {0};
-
-        /* for (ltfat_int un = 0; un < unrollRem; un++) */
-        /* { */
-        /*     s0[un] = 0.0; */
-        /*     s1[un] = 0.0; */
-        /*     s2[un] = 0.0; */
-        /* } */
-
-        LTFAT_TYPE* fPtrTmp = (LTFAT_TYPE*) fPtr + w * p->L;
-
-        for (ltfat_int ii = 0; ii < p->L - 1; ii++)
+        // The last sample and the phase correction
         {
-            for (ltfat_int un = 0; un < unrollRem; un++)
+            const LTFAT_TYPE flast = fPtr[w * L + L - 1];
+
+            for (ltfat_int m = 0; m < M; m++)
             {
-                s0[un] = *fPtrTmp + cos_term[un] * s1[un] - s2[un];
-                s2[un] = s1[un];
-                s1[un] = s0[un];
+#ifdef LTFAT_COMPLEXTYPE
+                LTFAT_COMPLEX s1 = p->s1[m] + I * p->s1[Mpad + m];
+                LTFAT_COMPLEX s2 = p->s2[m] + I * p->s2[Mpad + m];
+#else
+                LTFAT_REAL s1 = p->s1[m];
+                LTFAT_REAL s2 = p->s2[m];
+#endif
+                LTFAT_TYPE s0 = flast + p->cos_term[m] * s1 - s2;
+                cw[m] = s0 * p->cc2_term[m] - s1 * p->cc_term[m];
             }
-            fPtrTmp++;
         }
-
-        for (ltfat_int un = 0; un < unrollRem; un++)
-        {
-            s0[un] = *fPtrTmp + cos_term[un] * s1[un] - s2[un];
-            cPtrTmp[m + un] = (s0[un] * cc2_term[un] - s1[un] * cc_term[un]);
-        }
-
     }
-#endif
 }
 
 
@@ -195,6 +231,7 @@ void LTFAT_NAME(gga)(const LTFAT_TYPE* fPtr, const LTFAT_REAL* indVecPtr,
                      ltfat_int L, ltfat_int W, ltfat_int M, LTFAT_COMPLEX* cPtr)
 {
     LTFAT_NAME(gga_plan) p = LTFAT_NAME(gga_init)(indVecPtr, M, L);
+    if (!p) return;
     LTFAT_NAME(gga_execute)(p, fPtr, W, cPtr);
     LTFAT_NAME(gga_done)(p);
 }
@@ -206,74 +243,116 @@ LTFAT_NAME(chzt)(const LTFAT_TYPE* fPtr, ltfat_int L, ltfat_int W,
                  ltfat_int K, const LTFAT_REAL deltao, const LTFAT_REAL o,
                  LTFAT_COMPLEX* cPtr)
 {
-    LTFAT_NAME(chzt_plan) p = LTFAT_NAME(chzt_init)(K, L, deltao, o,
-                              FFTW_ESTIMATE,
-                              CZT_NEXTFASTFFT);
+    LTFAT_NAME(chzt_plan) p = NULL;
+
+    if (LTFAT_NAME(chzt_init_batch)(K, L, W, deltao, o, FFTW_ESTIMATE,
+                                    CZT_NEXTFASTFFT, &p))
+        return;
 
     LTFAT_NAME(chzt_execute)(p, fPtr, W, cPtr);
 
     LTFAT_NAME(chzt_done)(p);
 }
 
+/* Allocates fbuffer for Wbatch channels, each consisting of q columns of
+ * length Lfft, and the FFT plans working on it in-place. */
+static int
+LTFAT_NAME(chzt_fftplans_init)(LTFAT_NAME(chzt_plan) p, const unsigned fftw_flags)
+{
+    int status = LTFATERR_SUCCESS;
+    ltfat_int ncols = p->q * p->Wbatch;
+
+    CHECKMEM( p->fbuffer = LTFAT_NAME_COMPLEX(malloc)(ncols * p->Lfft) );
+
+    CHECKSTATUS( LTFAT_NAME_REAL(fft_init)(p->Lfft, ncols, p->fbuffer,
+                                           p->fbuffer, fftw_flags, &p->plan));
+    CHECKSTATUS( LTFAT_NAME_REAL(ifft_init)(p->Lfft, ncols, p->fbuffer,
+                                            p->fbuffer, fftw_flags, &p->plan2));
+
+    // Used when fewer than Wbatch channels remain
+    if (p->Wbatch > 1)
+    {
+        CHECKSTATUS( LTFAT_NAME_REAL(fft_init)(p->Lfft, p->q, p->fbuffer,
+                                               p->fbuffer, fftw_flags, &p->plan1));
+        CHECKSTATUS( LTFAT_NAME_REAL(ifft_init)(p->Lfft, p->q, p->fbuffer,
+                                                p->fbuffer, fftw_flags, &p->plan21));
+    }
+error:
+    return status;
+}
+
+/* Forward (dir = 1) or inverse FFT of the first Wb channels in fbuffer */
+static void
+LTFAT_NAME(chzt_fftplans_execute)(LTFAT_NAME(chzt_plan) p, ltfat_int Wb, int dir)
+{
+    if (Wb == p->Wbatch)
+    {
+        if (dir > 0) LTFAT_NAME_REAL(fft_execute)(p->plan);
+        else         LTFAT_NAME_REAL(ifft_execute)(p->plan2);
+        return;
+    }
+
+    for (ltfat_int w = 0; w < Wb; w++)
+    {
+        LTFAT_COMPLEX* fbufTmp = p->fbuffer + w * p->q * p->Lfft;
+        if (dir > 0)
+            LTFAT_NAME_REAL(fft_execute_newarray)(p->plan1, fbufTmp, fbufTmp);
+        else
+            LTFAT_NAME_REAL(ifft_execute_newarray)(p->plan21, fbufTmp, fbufTmp);
+    }
+}
 
 LTFAT_API void
 LTFAT_NAME(chzt_execute)(LTFAT_NAME(chzt_plan) p, const LTFAT_TYPE* fPtr,
                          ltfat_int W, LTFAT_COMPLEX* cPtr)
 {
-
     ltfat_int L = p->L;
     ltfat_int K = p->K;
     ltfat_int Lfft = p->Lfft;
-    LTFAT_COMPLEX* fbuffer = p->fbuffer;
-    /* LTFAT_FFTW(plan) plan_f = p->plan; */
-    /* LTFAT_FFTW(plan) plan_fi = p->plan2; */
-    LTFAT_NAME_REAL(fft_plan)*   plan_f = p->plan;
-    LTFAT_NAME_REAL(ifft_plan)* plan_fi = p->plan2;
     LTFAT_COMPLEX* W2 = p->W2;
     LTFAT_COMPLEX* Wo = p->Wo;
     LTFAT_COMPLEX* chirpF = p->chirpF;
 
-    for (ltfat_int w = 0; w < W; w++)
+    for (ltfat_int w0 = 0; w0 < W; w0 += p->Wbatch)
     {
-        LTFAT_NAME_COMPLEX(clear_array)( fbuffer, Lfft);
-        //memset(fbuffer, 0, Lfft * sizeof * fbuffer);
-#ifdef LTFAT_COMPLEXTYPE
-        memcpy(fbuffer, fPtr + w * L, L * sizeof * fbuffer);
-#else
-        LTFAT_NAME_REAL(real2complex_array)(fPtr + w * L, L, fbuffer);
-#endif
-        //1) Premultiply by a chirp
+        ltfat_int Wb = ltfat_imin(p->Wbatch, W - w0);
 
-        for (ltfat_int ii = 0; ii < L; ii++)
+        // 1) Premultiply by a chirp and zero-pad.
+        // Real input is multiplied directly, without a complex copy.
+        for (ltfat_int w = 0; w < Wb; w++)
         {
-            fbuffer[ii] *= Wo[ii];
+            const LTFAT_TYPE* fPtrTmp = fPtr + (w0 + w) * L;
+            LTFAT_COMPLEX* fbufTmp = p->fbuffer + w * Lfft;
+
+            for (ltfat_int ii = 0; ii < L; ii++)
+                fbufTmp[ii] = fPtrTmp[ii] * Wo[ii];
+
+            LTFAT_NAME_COMPLEX(clear_array)( fbufTmp + L, Lfft - L);
         }
 
-        // 2) FFT of input
-        /* LTFAT_FFTW(execute)(plan_f); */
-        LTFAT_NAME_REAL(fft_execute)(plan_f);
+        // 2) FFT of all channels
+        LTFAT_NAME(chzt_fftplans_execute)(p, Wb, 1);
 
         // Frequency domain filtering
-        for (ltfat_int ii = 0; ii < Lfft; ii++)
+        for (ltfat_int w = 0; w < Wb; w++)
         {
-            fbuffer[ii] *= chirpF[ii];
+            LTFAT_COMPLEX* fbufTmp = p->fbuffer + w * Lfft;
+            for (ltfat_int ii = 0; ii < Lfft; ii++)
+                fbufTmp[ii] *= chirpF[ii];
         }
 
-
         // Inverse FFT
-        LTFAT_COMPLEX* fPtrTmp = fbuffer;
-        /* LTFAT_FFTW(execute)(plan_fi); */
-        LTFAT_NAME_REAL(ifft_execute)(plan_fi);
+        LTFAT_NAME(chzt_fftplans_execute)(p, Wb, -1);
 
         // Final chirp multiplication and normalization
-        LTFAT_COMPLEX* cPtrTmp = cPtr + w * K;
-        for (ltfat_int ii = 0; ii < K; ii++)
+        for (ltfat_int w = 0; w < Wb; w++)
         {
-            cPtrTmp[ii] = fPtrTmp[ii] * W2[ii];
+            LTFAT_COMPLEX* fbufTmp = p->fbuffer + w * Lfft;
+            LTFAT_COMPLEX* cPtrTmp = cPtr + (w0 + w) * K;
+            for (ltfat_int ii = 0; ii < K; ii++)
+                cPtrTmp[ii] = fbufTmp[ii] * W2[ii];
         }
-
     }
-
 }
 
 LTFAT_API LTFAT_NAME(chzt_plan)
@@ -281,93 +360,88 @@ LTFAT_NAME(chzt_init)(ltfat_int K, ltfat_int L, const LTFAT_REAL deltao,
                       const LTFAT_REAL o, const unsigned fftw_flags,
                       czt_ffthint hint)
 {
-    ltfat_int Lfft = L + K - 1;
+    LTFAT_NAME(chzt_plan) p = NULL;
+    LTFAT_NAME(chzt_init_batch)(K, L, 1, deltao, o, fftw_flags, hint, &p);
+    return p;
+}
+
+LTFAT_API int
+LTFAT_NAME(chzt_init_batch)(ltfat_int K, ltfat_int L, ltfat_int W,
+                            const LTFAT_REAL deltao, const LTFAT_REAL o,
+                            const unsigned fftw_flags, czt_ffthint hint,
+                            LTFAT_NAME(chzt_plan)* pout)
+{
+    LTFAT_NAME(chzt_plan) p = NULL;
+    ltfat_int Lfft, N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, K > 0, "K (passed %td) must be positive.", K);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    Lfft = L + K - 1;
 
     if (hint == CZT_NEXTPOW2)
         Lfft = ltfat_nextpow2(Lfft);
     else
         Lfft = ltfat_nextfastfft(Lfft);
 
-    LTFAT_COMPLEX* fbuffer = LTFAT_NAME_COMPLEX(malloc)(Lfft);
-    /* int Lfftint = (int) Lfft; */
-    /* LTFAT_FFTW(plan) plan_f =  LTFAT_FFTW(plan_dft_1d)(Lfftint, */
-    /*                            (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                            (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                            FFTW_FORWARD, fftw_flags); */
-    /* LTFAT_FFTW(plan) plan_fi =  LTFAT_FFTW(plan_dft_1d)(Lfftint, */
-    /*                             (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                             (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                             FFTW_BACKWARD, fftw_flags); */
-
-    LTFAT_NAME_REAL(fft_plan)*   plan_f;
-    LTFAT_NAME_REAL(ifft_plan)* plan_fi;
-    LTFAT_NAME_REAL(fft_init)( Lfft, 1, fbuffer, fbuffer, fftw_flags, &plan_f);
-    LTFAT_NAME_REAL(ifft_init)(Lfft, 1, fbuffer, fbuffer, fftw_flags, &plan_fi);
+    CHECKMEM( p = LTFAT_NEW(struct LTFAT_NAME(chzt_plan_struct)) );
+    p->L = L; p->K = K; p->Lfft = Lfft; p->q = 1; p->Wbatch = W;
 
-    // Pre and post chirp
-    ltfat_int N = L > K ? L : K;
-    LTFAT_COMPLEX* W2 = LTFAT_NAME_COMPLEX(malloc)(Lfft);
-    LTFAT_COMPLEX* chirpF = LTFAT_NAME_COMPLEX(malloc)(Lfft);
-    LTFAT_COMPLEX* Wo = LTFAT_NAME_COMPLEX(malloc)(L);
+    CHECKSTATUS( LTFAT_NAME(chzt_fftplans_init)(p, fftw_flags));
 
+    // Pre and post chirp
+    N = L > K ? L : K;
+    CHECKMEM( p->W2 = LTFAT_NAME_COMPLEX(malloc)(N) );
+    CHECKMEM( p->chirpF = LTFAT_NAME_COMPLEX(malloc)(Lfft) );
+    CHECKMEM( p->Wo = LTFAT_NAME_COMPLEX(malloc)(L) );
 
     for (ltfat_int ii = 0; ii < N; ii++)
     {
-        W2[ii] = exp(-I * (LTFAT_REAL)( deltao * ii * ii / 2.0));
+        p->W2[ii] = exp(-I * (LTFAT_REAL)( deltao * ii * ii / 2.0));
     }
 
     for (ltfat_int ii = 0; ii < L; ii++)
     {
-        Wo[ii] = exp(-I * (LTFAT_REAL)( o * ii )) * W2[ii];
+        p->Wo[ii] = exp(-I * (LTFAT_REAL)( o * ii )) * p->W2[ii];
     }
-    // Set the rest to zero
-    /* memset(W2 + N, 0, (Lfft - N)*sizeof * W2); */
-    LTFAT_NAME_COMPLEX(clear_array)( W2 + N, Lfft - N);
 
-    LTFAT_NAME_COMPLEX(conjugate_array)(W2, K, chirpF);
-    LTFAT_NAME_COMPLEX(conjugate_array)(W2 + 1, L - 1, chirpF + Lfft - L + 1);
-    LTFAT_NAME_COMPLEX(reverse_array)(chirpF + Lfft - L + 1, L - 1,
-                                      chirpF + Lfft - L + 1);
+    LTFAT_NAME_COMPLEX(conjugate_array)(p->W2, K, p->chirpF);
+    if (L > 1)
+    {
+        LTFAT_NAME_COMPLEX(conjugate_array)(p->W2 + 1, L - 1,
+                                            p->chirpF + Lfft - L + 1);
+        LTFAT_NAME_COMPLEX(reverse_array)(p->chirpF + Lfft - L + 1, L - 1,
+                                          p->chirpF + Lfft - L + 1);
+    }
 
-    LTFAT_NAME_COMPLEX(clear_array)( chirpF + K, Lfft - (L + K - 1));
-    /* memset(chirpF + K, 0, (Lfft - (L + K - 1))*sizeof * chirpF); */
+    LTFAT_NAME_COMPLEX(clear_array)( p->chirpF + K, Lfft - (L + K - 1));
 
-    /* LTFAT_FFTW(execute_dft)(plan_f, (LTFAT_FFTW(complex)*) chirpF, */
-    /*                         (LTFAT_FFTW(complex)*) chirpF); */
-    LTFAT_NAME_REAL(fft_execute_newarray)(plan_f, chirpF, chirpF);
+    CHECKSTATUS( LTFAT_NAME_REAL(fft)(p->chirpF, Lfft, 1, p->chirpF));
 
     for (ltfat_int ii = 0; ii < K; ii++)
     {
-        W2[ii] = exp(-I * (LTFAT_REAL)(deltao * ii * ii / 2.0))
-                 / (( LTFAT_REAL) Lfft);
+        p->W2[ii] = exp(-I * (LTFAT_REAL)(deltao * ii * ii / 2.0))
+                    / (( LTFAT_REAL) Lfft);
     }
 
-    /*
-    We could have shrinked the W2 to length K here.
-    */
-    /* struct LTFAT_NAME(chzt_plan_struct) p_struct = */
-    /* { */
-    /*     .fbuffer = fbuffer, .plan = plan_f, .plan2 = plan_fi, .L = L, .K = K, .W2 = W2, */
-    /*     .Wo = Wo, .chirpF = chirpF, .Lfft = Lfft */
-    /* }; */
-
-    LTFAT_NAME(chzt_plan) p = (LTFAT_NAME(chzt_plan)) ltfat_malloc(sizeof * p);
-    p->fbuffer = fbuffer; p->plan = plan_f; p->plan2 = plan_fi; p->L = L;
-    p->K = K; p->W2 = W2; p->Wo = Wo; p->chirpF = chirpF; p->Lfft = Lfft;
-
-    /* memcpy(p, &p_struct, sizeof * p); */
-
-    return  p;
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(chzt_done)(p);
+    return status;
 }
 
 LTFAT_API
 void LTFAT_NAME(chzt_done)(LTFAT_NAME(chzt_plan) p)
 {
+    if (!p) return;
     LTFAT_SAFEFREEALL(p->fbuffer, p->W2, p->Wo, p->chirpF);
-    /* LTFAT_FFTW(destroy_plan)(p->plan); */
-    /* LTFAT_FFTW(destroy_plan)(p->plan2); */
-    LTFAT_NAME_REAL(fft_done)(&p->plan);
-    LTFAT_NAME_REAL(ifft_done)(&p->plan2);
+    if (p->plan) LTFAT_NAME_REAL(fft_done)(&p->plan);
+    if (p->plan2) LTFAT_NAME_REAL(ifft_done)(&p->plan2);
+    if (p->plan1) LTFAT_NAME_REAL(fft_done)(&p->plan1);
+    if (p->plan21) LTFAT_NAME_REAL(ifft_done)(&p->plan21);
     ltfat_free(p);
 }
 
@@ -377,8 +451,11 @@ LTFAT_NAME(chzt_fac)(const LTFAT_TYPE* fPtr, ltfat_int L,
                      ltfat_int W, ltfat_int K, const LTFAT_REAL deltao,
                      const LTFAT_REAL o, LTFAT_COMPLEX* cPtr)
 {
-    LTFAT_NAME(chzt_plan) p = LTFAT_NAME(chzt_fac_init)(K, L, deltao, o,
-                              FFTW_ESTIMATE, CZT_NEXTFASTFFT);
+    LTFAT_NAME(chzt_plan) p = NULL;
+
+    if (LTFAT_NAME(chzt_fac_init_batch)(K, L, W, deltao, o, FFTW_ESTIMATE,
+                                        CZT_NEXTFASTFFT, &p))
+        return;
 
     LTFAT_NAME(chzt_fac_execute)(p, fPtr, W, cPtr);
 
@@ -392,118 +469,86 @@ LTFAT_NAME(chzt_fac_execute)(LTFAT_NAME(chzt_plan) p, const LTFAT_TYPE* fPtr,
     ltfat_int L = p->L;
     ltfat_int K = p->K;
     ltfat_int Lfft = p->Lfft;
-    LTFAT_COMPLEX* fbuffer = p->fbuffer;
-    /* LTFAT_FFTW(plan) plan_f = p->plan; */
-    /* LTFAT_FFTW(plan) plan_fi = p->plan2; */
-    LTFAT_NAME_REAL(fft_plan)*   plan_f = p->plan;
-    LTFAT_NAME_REAL(ifft_plan)* plan_fi = p->plan2;
+    ltfat_int q = p->q;
     LTFAT_COMPLEX* W2 = p->W2;
     LTFAT_COMPLEX* Wo = p->Wo;
     LTFAT_COMPLEX* chirpF = p->chirpF;
 
-    LTFAT_COMPLEX* fBufTmp;
-    ltfat_int q = (ltfat_int) ceil(((double)L) / ((double)K));
-
     ltfat_int lastK = (L / q);
 
-    for (ltfat_int w = 0; w < W; w++)
+    for (ltfat_int w0 = 0; w0 < W; w0 += p->Wbatch)
     {
-        // *********************************
-        // 1) Read and reorganize input data
-        // *********************************
-        LTFAT_NAME_COMPLEX(clear_array)( fbuffer, q * Lfft);
-        /* memset(fbuffer, 0, q * Lfft * sizeof * fbuffer); */
-        LTFAT_TYPE* fPtrTmp = ((LTFAT_TYPE*)fPtr) + w * L;
+        ltfat_int Wb = ltfat_imin(p->Wbatch, W - w0);
 
-        for (ltfat_int k = 0; k < lastK; k++)
+        for (ltfat_int w = 0; w < Wb; w++)
         {
-            LTFAT_TYPE* fTmp = fPtrTmp + k * q;
-            fBufTmp = fbuffer + k;
-            for (ltfat_int jj = 0; jj < q; jj++)
-            {
-                *fBufTmp = (LTFAT_COMPLEX) fTmp[jj];
-                fBufTmp += Lfft;
-            }
-        }
+            LTFAT_COMPLEX* fbuffer = p->fbuffer + w * q * Lfft;
+            const LTFAT_TYPE* fPtrTmp = fPtr + (w0 + w) * L;
 
-        LTFAT_TYPE* fTmp = fPtrTmp + lastK * q;
-        fBufTmp = fbuffer + lastK;
-        for (ltfat_int jj = 0; jj < L - lastK * q; jj++)
-        {
-            *fBufTmp = (LTFAT_COMPLEX) fTmp[jj];
-            fBufTmp += Lfft;
-        }
+            // *********************************
+            // 1) Read and reorganize input data and premultiply
+            // *********************************
+            LTFAT_NAME_COMPLEX(clear_array)( fbuffer, q * Lfft);
 
-        // *********************************
-        // 2) Premultiply
-        // *********************************
+            for (ltfat_int k = 0; k < lastK; k++)
+            {
+                const LTFAT_TYPE* fTmp = fPtrTmp + k * q;
+                LTFAT_COMPLEX* fBufTmp = fbuffer + k;
+                for (ltfat_int jj = 0; jj < q; jj++)
+                {
+                    *fBufTmp = fTmp[jj] * W2[k];
+                    fBufTmp += Lfft;
+                }
+            }
 
-        fBufTmp = fbuffer;
-        for (ltfat_int jj = 0; jj < q; jj++)
-        {
-            for (ltfat_int k = 0; k < K; k++)
+            const LTFAT_TYPE* fTmp = fPtrTmp + lastK * q;
+            LTFAT_COMPLEX* fBufTmp = fbuffer + lastK;
+            for (ltfat_int jj = 0; jj < L - lastK * q; jj++)
             {
-                fBufTmp[k] *= W2[k];
+                *fBufTmp = fTmp[jj] * W2[lastK];
+                fBufTmp += Lfft;
             }
-            fBufTmp += Lfft;
         }
 
         // *********************************
-        // 3) q ffts of length Lfft
+        // 2) q ffts of length Lfft per channel
         // *********************************
-        /* LTFAT_FFTW(execute)(plan_f); */
-        LTFAT_NAME_REAL(fft_execute)(plan_f);
+        LTFAT_NAME(chzt_fftplans_execute)(p, Wb, 1);
 
         // *********************************
-        // 4) Filter
+        // 3) Filter
         // *********************************
-        fBufTmp = fbuffer;
-        // Frequency domain filtering
-        for (ltfat_int jj = 0; jj < q; jj++)
+        for (ltfat_int jj = 0; jj < q * Wb; jj++)
         {
+            LTFAT_COMPLEX* fBufTmp = p->fbuffer + jj * Lfft;
             for (ltfat_int ii = 0; ii < Lfft; ii++)
-            {
                 fBufTmp[ii] *= chirpF[ii];
-            }
-            fBufTmp += Lfft;
         }
 
         // *********************************
-        // 5) q iffts of length Lfft
+        // 4) q iffts of length Lfft per channel
         // *********************************
-        /* LTFAT_FFTW(execute)(plan_fi); */
-        LTFAT_NAME_REAL(ifft_execute)(plan_fi);
+        LTFAT_NAME(chzt_fftplans_execute)(p, Wb, -1);
 
         // *********************************
-        // 6) Postmultiply
+        // 5) Postmultiply and sum cols
         // *********************************
-        fBufTmp = fbuffer;
-        LTFAT_COMPLEX* Wotmp = Wo;
-        for (ltfat_int jj = 0; jj < q; jj++)
+        for (ltfat_int w = 0; w < Wb; w++)
         {
+            LTFAT_COMPLEX* fbuffer = p->fbuffer + w * q * Lfft;
+            LTFAT_COMPLEX* cPtrTmp = cPtr + (w0 + w) * K;
+
             for (ltfat_int k = 0; k < K; k++)
-            {
-                fBufTmp[k] *= Wotmp[k];
-            }
-            fBufTmp += Lfft;
-            Wotmp += K;
-        }
+                cPtrTmp[k] = fbuffer[k] * Wo[k];
 
-        // *********************************
-        // 7) Sum cols
-        // *********************************
-        LTFAT_COMPLEX* cPtrTmp = cPtr + w * K;
-        for (ltfat_int k = 0; k < K; k++)
-        {
-            fBufTmp = fbuffer + k;
-            cPtrTmp[k] = (LTFAT_COMPLEX) 0.0;
-            for (ltfat_int jj = 0; jj < q; jj++)
+            for (ltfat_int jj = 1; jj < q; jj++)
             {
-                cPtrTmp[k] += *fBufTmp;
-                fBufTmp += Lfft;
+                LTFAT_COMPLEX* fBufTmp = fbuffer + jj * Lfft;
+                LTFAT_COMPLEX* Wotmp = Wo + jj * K;
+                for (ltfat_int k = 0; k < K; k++)
+                    cPtrTmp[k] += fBufTmp[k] * Wotmp[k];
             }
         }
-
     }
 }
 
@@ -512,91 +557,81 @@ LTFAT_NAME(chzt_fac_init)(ltfat_int K, ltfat_int L,
                           const LTFAT_REAL deltao, const LTFAT_REAL o,
                           const unsigned fftw_flags, czt_ffthint hint)
 {
+    LTFAT_NAME(chzt_plan) p = NULL;
+    LTFAT_NAME(chzt_fac_init_batch)(K, L, 1, deltao, o, fftw_flags, hint, &p);
+    return p;
+}
 
-    ltfat_int Lfft = 2 * K - 1;
+LTFAT_API int
+LTFAT_NAME(chzt_fac_init_batch)(ltfat_int K, ltfat_int L, ltfat_int W,
+                                const LTFAT_REAL deltao, const LTFAT_REAL o,
+                                const unsigned fftw_flags, czt_ffthint hint,
+                                LTFAT_NAME(chzt_plan)* pout)
+{
+    LTFAT_NAME(chzt_plan) p = NULL;
+    ltfat_int Lfft, q;
+    LTFAT_REAL oneoverLfft;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, K > 0, "K (passed %td) must be positive.", K);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    Lfft = 2 * K - 1;
     if (hint == CZT_NEXTPOW2)
         Lfft = ltfat_nextpow2(Lfft);
     else
         Lfft = ltfat_nextfastfft(Lfft);
 
-    ltfat_int q = (ltfat_int) ceil(((double)L) / ((double)K));
-
-    LTFAT_COMPLEX* fbuffer = LTFAT_NAME_COMPLEX(malloc)(q * Lfft);
-
-    /* LTFAT_FFTW(iodim64) dims; */
-    /* dims.n = Lfft; dims.is = 1; dims.os = 1; */
-    /* LTFAT_FFTW(iodim64) howmany_dims; */
-    /* howmany_dims.n = (int)q; howmany_dims.is = Lfft; howmany_dims.os = Lfft; */
-    /* LTFAT_FFTW(plan) plan_f =  LTFAT_FFTW(plan_guru64_dft)(1, &dims, 1, */
-    /*                            &howmany_dims, */
-    /*                            (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                            (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                            FFTW_FORWARD, fftw_flags); */
-    /*  */
-    /* LTFAT_FFTW(plan) plan_fi =  LTFAT_FFTW(plan_guru64_dft)(1, &dims, 1, */
-    /*                             &howmany_dims, */
-    /*                             (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                             (LTFAT_FFTW(complex)*) fbuffer, */
-    /*                             FFTW_BACKWARD, fftw_flags); */
-
-    LTFAT_NAME_REAL(fft_plan)*   plan_f;
-    LTFAT_NAME_REAL(ifft_plan)* plan_fi;
-    LTFAT_NAME_REAL(fft_init)( Lfft, q, fbuffer, fbuffer, fftw_flags, &plan_f);
-    LTFAT_NAME_REAL(ifft_init)(Lfft, q, fbuffer, fbuffer, fftw_flags, &plan_fi);
-
-    LTFAT_COMPLEX* W2 = LTFAT_NAME_COMPLEX(malloc)(K);
-    LTFAT_COMPLEX* chirpF = LTFAT_NAME_COMPLEX(malloc)(Lfft);
-    LTFAT_COMPLEX* Wo = LTFAT_NAME_COMPLEX(malloc)(q * K);
-
-    /* LTFAT_FFTW(plan) plan_chirpF =  LTFAT_FFTW(plan_dft_1d)((int)Lfft, */
-    /*                                 (LTFAT_FFTW(complex)*) chirpF, */
-    /*                                 (LTFAT_FFTW(complex)*) chirpF, */
-    /*                                 FFTW_FORWARD, fftw_flags); */
+    q = ltfat_idivceil(L, K);
+
+    CHECKMEM( p = LTFAT_NEW(struct LTFAT_NAME(chzt_plan_struct)) );
+    p->L = L; p->K = K; p->Lfft = Lfft; p->q = q; p->Wbatch = W;
+
+    CHECKSTATUS( LTFAT_NAME(chzt_fftplans_init)(p, fftw_flags));
+
+    CHECKMEM( p->W2 = LTFAT_NAME_COMPLEX(malloc)(K) );
+    CHECKMEM( p->chirpF = LTFAT_NAME_COMPLEX(malloc)(Lfft) );
+    CHECKMEM( p->Wo = LTFAT_NAME_COMPLEX(malloc)(q * K) );
 
     for (ltfat_int k = 0; k < K; k++)
     {
-        W2[k] = exp(- I * (LTFAT_REAL)( q * deltao *  k * k  / 2.0));
+        p->W2[k] = exp(- I * (LTFAT_REAL)( q * deltao *  k * k  / 2.0));
     }
 
-    LTFAT_NAME_COMPLEX(conjugate_array)(W2, K, chirpF);
-    LTFAT_NAME_COMPLEX(conjugate_array)(W2 + 1, K - 1, chirpF + Lfft - K + 1);
-    LTFAT_NAME_COMPLEX(reverse_array)(chirpF + Lfft - K + 1, K - 1,
-                                      chirpF + Lfft - K + 1);
+    LTFAT_NAME_COMPLEX(conjugate_array)(p->W2, K, p->chirpF);
+    if (K > 1)
+    {
+        LTFAT_NAME_COMPLEX(conjugate_array)(p->W2 + 1, K - 1,
+                                            p->chirpF + Lfft - K + 1);
+        LTFAT_NAME_COMPLEX(reverse_array)(p->chirpF + Lfft - K + 1, K - 1,
+                                          p->chirpF + Lfft - K + 1);
+    }
 
-    LTFAT_NAME_COMPLEX(clear_array)( chirpF + K, Lfft - (2 * K - 1));
-    /* memset(chirpF + K, 0, (Lfft - (2 * K - 1))*sizeof * chirpF); */
-    /* LTFAT_FFTW(execute)(plan_chirpF); */
-    /* LTFAT_FFTW(destroy_plan)(plan_chirpF); */
+    LTFAT_NAME_COMPLEX(clear_array)( p->chirpF + K, Lfft - (2 * K - 1));
 
-    LTFAT_NAME_REAL(ifft)( chirpF, Lfft, 1, chirpF);
+    CHECKSTATUS( LTFAT_NAME_REAL(ifft)( p->chirpF, Lfft, 1, p->chirpF));
 
-    LTFAT_REAL oneoverLfft = (LTFAT_REAL) ( 1.0 / Lfft );
+    oneoverLfft = (LTFAT_REAL) ( 1.0 / Lfft );
 
     for (ltfat_int jj = 0; jj < q; jj++)
     {
-        LTFAT_COMPLEX* Wotmp = Wo + jj * K;
+        LTFAT_COMPLEX* Wotmp = p->Wo + jj * K;
         for (ltfat_int k = 0; k < K; k++)
         {
-            Wotmp[k] = exp(- I * (LTFAT_REAL)jj * ((LTFAT_REAL)k * deltao + o)) * W2[k] *
-                       oneoverLfft;
+            Wotmp[k] = exp(- I * (LTFAT_REAL)jj * ((LTFAT_REAL)k * deltao + o)) *
+                       p->W2[k] * oneoverLfft;
         }
     }
 
     for (ltfat_int k = 0; k < K; k++)
     {
-        W2[k] *= exp(- I * (LTFAT_REAL)(k * q) * o);
+        p->W2[k] *= exp(- I * (LTFAT_REAL)(k * q) * o);
     }
 
-    /* struct LTFAT_NAME(chzt_plan_struct) p_struct = */
-    /* { */
-    /*     .fbuffer = fbuffer, .plan = plan_f, .plan2 = plan_fi, .L = L, .K = K, .W2 = W2, */
-    /*     .Wo = Wo, .chirpF = chirpF, .Lfft = Lfft */
-    /* }; */
-
-    LTFAT_NAME(chzt_plan) p = (LTFAT_NAME(chzt_plan)) ltfat_malloc(sizeof * p);
-    p->fbuffer = fbuffer; p->plan = plan_f; p->plan2 = plan_fi;
-    p->L = L; p->K = K; p->W2 = W2; p->Wo = Wo; p->chirpF = chirpF;
-    p->Lfft = Lfft;
-    /* memcpy(p, &p_struct, sizeof * p); */
-    return  p;
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(chzt_done)(p);
+    return status;
 }
@@ -153,3 +153,149 @@ LTFAT_NAME_REAL(idwilt_fb)(const LTFAT_REAL* c, const LTFAT_REAL* g,
 #undef CH
 #undef PREPROC_REAL
 #undef PREPROC_COMPLEX
+
+#include "dwilt_private.h"
+
+struct LTFAT_NAME(idwilt_plan)
+{
+    LTFAT_NAME(wilson_fold) fo;
+    LTFAT_NAME(ifft_plan)* p_ifft;
+    LTFAT_REAL* y;     //!< Two folded columns, 2M x 2
+    LTFAT_REAL* sym;   //!< Symmetrized parts of the two columns, M x 4
+    LTFAT_COMPLEX* G;  //!< IFFT input, M
+    LTFAT_COMPLEX* s;  //!< IFFT output, M
+    LTFAT_COMPLEX* tw; //!< exp(-i*pi*k/M)
+};
+
+LTFAT_API int
+LTFAT_NAME(idwilt_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                        ltfat_int W, ltfat_int M, unsigned flags,
+                        LTFAT_NAME(idwilt_plan)** pout)
+{
+    LTFAT_NAME(idwilt_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(idwilt_plan)) );
+    CHECKSTATUS( LTFAT_NAME(wilson_fold_init)(g, gl, L, W, M, 0, &p->fo));
+
+    CHECKMEM( p->y   = LTFAT_NAME_REAL(malloc)(4 * M) );
+    CHECKMEM( p->sym = LTFAT_NAME_REAL(malloc)(4 * M) );
+    CHECKMEM( p->G   = LTFAT_NAME_COMPLEX(malloc)(M) );
+    CHECKMEM( p->s   = LTFAT_NAME_COMPLEX(malloc)(M) );
+    CHECKMEM( p->tw  = LTFAT_NAME_COMPLEX(malloc)(M) );
+
+    for (ltfat_int k = 0; k < M; k++)
+        p->tw[k] = exp(-I * (LTFAT_REAL) (M_PI * k / M));
+
+    CHECKSTATUS( LTFAT_NAME(ifft_init)(M, 1, p->G, p->s, flags, &p->p_ifft));
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(idwilt_done)(&p);
+    return status;
+}
+
+/* Transpose of dwilt_execute, step by step in reverse order */
+LTFAT_API int
+LTFAT_NAME(idwilt_execute)(LTFAT_NAME(idwilt_plan)* p, const LTFAT_REAL c[],
+                           LTFAT_REAL f[])
+{
+    ltfat_int M, L, N;
+    const LTFAT_REAL sqrt2h = (LTFAT_REAL) (sqrt(2.0) / 2.0);
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    M = p->fo.M; L = p->fo.L; N = p->fo.N;
+
+    memset(f, 0, L * p->fo.W * sizeof * f);
+
+    for (ltfat_int w = 0; w < p->fo.W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n += 2)
+        {
+            LTFAT_REAL* y0 = p->y;
+            LTFAT_REAL* y1 = p->y + 2 * M;
+            LTFAT_REAL* al0 = p->sym;
+            LTFAT_REAL* ga0 = p->sym + M;
+            LTFAT_REAL* al1 = p->sym + 2 * M;
+            LTFAT_REAL* ga1 = p->sym + 3 * M;
+            const LTFAT_REAL* c0 = c + n * M + w * M * N;
+            const LTFAT_REAL* c1 = c0 + M;
+            LTFAT_COMPLEX* G = p->G;
+
+            LTFAT_NAME_COMPLEX(clear_array)(G, M);
+
+            G[0] += c0[0];
+
+            if (M % 2)
+                G[(M - 1) / 2] -= I * c1[0];
+            else
+                G[M / 2] += c1[0];
+
+            for (ltfat_int m = 1; m < M; m += 2)
+            {
+                ltfat_int pp = m / 2;
+                LTFAT_REAL v0 = -sqrt2h * c0[m], v1 = -sqrt2h * c1[m];
+                G[pp] += I * (v0 + v1);
+                G[M - 1 - pp] += I * (v1 - v0);
+            }
+
+            for (ltfat_int m = 2; m < M; m += 2)
+            {
+                ltfat_int pp = m / 2;
+                LTFAT_REAL v0 = sqrt2h * c0[m], v1 = sqrt2h * c1[m];
+                G[pp] += v0 + v1;
+                G[M - pp] += v0 - v1;
+            }
+
+            LTFAT_NAME(ifft_execute)(p->p_ifft);
+
+            for (ltfat_int k = 0; k < M; k++)
+            {
+                LTFAT_COMPLEX st = p->s[k] * conj(p->tw[k]);
+                al0[k] = ltfat_real(p->s[k]);
+                ga0[k] = ltfat_real(st);
+                al1[k] = ltfat_imag(st);
+                ga1[k] = ltfat_imag(p->s[k]);
+            }
+
+            /* a = y(k) + y(k+M), d = y(k) - y(k+M) */
+            y0[0] = al0[0];      y0[M] = al0[0];
+            y1[0] = al1[0];      y1[M] = -al1[0];
+            for (ltfat_int k = 1; k < M; k++)
+            {
+                ltfat_int km = M - k;
+                LTFAT_REAL a0 = (al0[k] + al0[km]) / 2.0;
+                LTFAT_REAL d0 = (ga0[k] + ga0[km]) / 2.0;
+                LTFAT_REAL d1 = (al1[k] - al1[km]) / 2.0;
+                LTFAT_REAL a1 = (ga1[k] - ga1[km]) / 2.0;
+                y0[k] = a0 + d0; y0[k + M] = a0 - d0;
+                y1[k] = a1 + d1; y1[k + M] = a1 - d1;
+            }
+
+            LTFAT_NAME(wilson_unfold_execute)(&p->fo, y0, n, f + w * L);
+            LTFAT_NAME(wilson_unfold_execute)(&p->fo, y1, n + 1, f + w * L);
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(idwilt_done)(LTFAT_NAME(idwilt_plan)** p)
+{
+    LTFAT_NAME(idwilt_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->p_ifft) LTFAT_NAME(ifft_done)(&pp->p_ifft);
+    LTFAT_NAME(wilson_fold_done)(&pp->fo);
+    LTFAT_SAFEFREEALL(pp->y, pp->sym, pp->G, pp->s, pp->tw);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -4,6 +4,10 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 struct LTFAT_NAME(upconv_fft_plan_struct)
 {
     ltfat_int L;
@@ -150,6 +154,7 @@ LTFAT_NAME(upconv_fft_done)(LTFAT_NAME(upconv_fft_plan) p)
     /* LTFAT_FFTW(destroy_plan)(p->p_c); */
     LTFAT_NAME_REAL(fft_done)(&p->p_c);
     ltfat_free(p->buf);
+    ltfat_free(p);
 }
 
 
@@ -347,4 +352,354 @@ LTFAT_NAME(upconv_fftbl_done)(LTFAT_NAME(upconv_fftbl_plan) p)
     /* LTFAT_FFTW(destroy_plan)(p->p_c); */
     LTFAT_NAME_REAL(fft_done)(&p->p_c);
     if (p->buf) ltfat_free(p->buf);
+    ltfat_free(p);
+}
+
+
+/* Channels with the same number of coefficients are transformed together.
+ * A group is limited to IFILTERBANK_GROUPMAX channels so that even a bank
+ * with a single channel length gives several FFTs to run concurrently.
+ *
+ * A filter with realonly set is applied twice, the second time mirrored
+ * to the negative frequencies. Both are kept as segments with the
+ * conjugation already done, so that a channel contributes
+ *
+ * F[(off + k) mod L] += X[(off + k) mod N] * H[k],  k = 0, ..., len - 1
+ *
+ * for each of its segments, where X is the FFT of the channel.
+ * */
+#define IFILTERBANK_GROUPMAX 16
+#define IFILTERBANK_REDBLOCK 4096
+
+typedef struct
+{
+    ltfat_int N;
+    ltfat_int nchan;
+    LTFAT_COMPLEX* buf;      //!< N x W x nchan
+    LTFAT_NAME(fft_plan)* fwd;
+} LTFAT_NAME(ifilterbank_group);
+
+typedef struct
+{
+    ltfat_int off;
+    ltfat_int len;
+    LTFAT_COMPLEX* H;
+} LTFAT_NAME(ifilterbank_segment);
+
+struct LTFAT_NAME(ifilterbank_plan)
+{
+    ltfat_int M;
+    ltfat_int L;
+    ltfat_int W;
+    ltfat_int* N;            //!< Number of coefficients of each channel
+    ltfat_int* grp;          //!< Group of each channel
+    ltfat_int* slot;         //!< Position of the channel within its group
+    ltfat_int ngrp;
+    LTFAT_NAME(ifilterbank_group)* groups;
+    LTFAT_NAME(ifilterbank_segment)* seg; //!< 2 x M, unused have len 0
+    LTFAT_COMPLEX* F;        //!< Output spectrum, L x W
+    LTFAT_NAME(ifft_plan)* inv;
+    ltfat_int nthreads;
+    ltfat_int* chanstart;    //!< Channels of each thread, nthreads + 1
+    LTFAT_COMPLEX** part;    //!< Partial spectra, part[0] is F
+};
+
+static int
+LTFAT_NAME(ifilterbank_done_priv)(LTFAT_NAME(ifilterbank_plan)* p)
+{
+    if (p->groups)
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+        {
+            if (p->groups[k].fwd) LTFAT_NAME(fft_done)(&p->groups[k].fwd);
+            ltfat_safefree(p->groups[k].buf);
+        }
+
+    if (p->seg)
+        for (ltfat_int m = 0; m < 2 * p->M; m++)
+            ltfat_safefree(p->seg[m].H);
+
+    if (p->part)
+        for (ltfat_int t = 1; t < p->nthreads; t++)
+            ltfat_safefree(p->part[t]);
+
+    if (p->inv) LTFAT_NAME(ifft_done)(&p->inv);
+
+    LTFAT_SAFEFREEALL(p->N, p->grp, p->slot, p->groups, p->seg, p->F,
+                      p->chanstart, p->part);
+    ltfat_free(p);
+    return LTFATERR_SUCCESS;
+}
+
+/* Splits the channels to nthreads contiguous ranges of roughly the same
+ * amount of work */
+static void
+LTFAT_NAME(ifilterbank_partition)(LTFAT_NAME(ifilterbank_plan)* p)
+{
+    ltfat_int total = 0, acc = 0, t = 1;
+
+    for (ltfat_int m = 0; m < p->M; m++)
+        total += p->seg[2 * m].len + p->seg[2 * m + 1].len;
+
+    p->chanstart[0] = 0;
+    for (ltfat_int m = 0; m < p->M && t < p->nthreads; m++)
+    {
+        acc += p->seg[2 * m].len + p->seg[2 * m + 1].len;
+        while (t < p->nthreads && acc * p->nthreads >= total * t)
+            p->chanstart[t++] = m + 1;
+    }
+    while (t <= p->nthreads)
+        p->chanstart[t++] = p->M;
+}
+
+LTFAT_API int
+LTFAT_NAME(ifilterbank_init)(const LTFAT_COMPLEX* G[], const ltfat_int Gl[],
+                             const ltfat_int foff[], const int realonly[],
+                             const double a[], ltfat_int M, ltfat_int L,
+                             ltfat_int W, unsigned flags,
+                             LTFAT_NAME(ifilterbank_plan)** pout)
+{
+    LTFAT_NAME(ifilterbank_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(G); CHECKNULL(Gl); CHECKNULL(foff); CHECKNULL(realonly);
+    CHECKNULL(a); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_BADTRALEN, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(ifilterbank_plan)) );
+    p->M = M; p->L = L; p->W = W; p->nthreads = 1;
+
+    CHECKMEM( p->N = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->grp = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->slot = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->groups = LTFAT_NEWARRAY(LTFAT_NAME(ifilterbank_group), M) );
+    CHECKMEM( p->seg = LTFAT_NEWARRAY(LTFAT_NAME(ifilterbank_segment), 2 * M) );
+    CHECKMEM( p->chanstart = LTFAT_NEWARRAY(ltfat_int, 2) );
+    CHECKMEM( p->part = LTFAT_NEWARRAY(LTFAT_COMPLEX*, 1) );
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        LTFAT_NAME(ifilterbank_segment)* s = &p->seg[2 * m];
+        CHECK(LTFATERR_NOTPOSARG, a[m] > 0, "a[%td] (passed %f) must be positive.", m, a[m]);
+        CHECK(LTFATERR_BADSIZE, Gl[m] >= 0 && Gl[m] <= L,
+              "Gl[%td] (passed %td) must be in range [0,L].", m, Gl[m]);
+        CHECK(LTFATERR_BADSIZE, Gl[m] == 0 || G[m] != NULL, "G[%td] was NULL.", m);
+
+        p->N[m] = (ltfat_int) floor(L / a[m] + 0.5);
+        CHECK(LTFATERR_BADSIZE, p->N[m] > 0, "Channel %td has no coefficients.", m);
+
+        p->grp[m] = -1;
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+            if (p->groups[k].N == p->N[m] &&
+                p->groups[k].nchan < IFILTERBANK_GROUPMAX)
+            {
+                p->grp[m] = k; break;
+            }
+
+        if (p->grp[m] < 0)
+        {
+            p->grp[m] = p->ngrp;
+            p->groups[p->ngrp++].N = p->N[m];
+        }
+        p->slot[m] = p->groups[p->grp[m]].nchan++;
+
+        if (Gl[m] == 0) continue; // Zero bandwidth filter
+
+        s[0].off = foff[m]; s[0].len = Gl[m];
+        CHECKMEM( s[0].H = LTFAT_NAME_COMPLEX(malloc)(Gl[m]) );
+        LTFAT_NAME_COMPLEX(conjugate_array)(G[m], Gl[m], s[0].H);
+
+        if (realonly[m])
+        {
+            s[1].off = -L + ltfat_positiverem(L - foff[m] - Gl[m], L) + 1;
+            s[1].len = Gl[m];
+            CHECKMEM( s[1].H = LTFAT_NAME_COMPLEX(malloc)(Gl[m]) );
+            LTFAT_NAME_COMPLEX(reverse_array)(G[m], Gl[m], s[1].H);
+        }
+    }
+
+    for (ltfat_int k = 0; k < p->ngrp; k++)
+    {
+        LTFAT_NAME(ifilterbank_group)* gr = &p->groups[k];
+        CHECKMEM( gr->buf = LTFAT_NAME_COMPLEX(malloc)(gr->N * W * gr->nchan) );
+        CHECKSTATUS(
+            LTFAT_NAME(fft_init)(gr->N, W * gr->nchan, gr->buf, gr->buf,
+                                 flags, &gr->fwd));
+    }
+
+    CHECKMEM( p->F = LTFAT_NAME_COMPLEX(malloc)(L * W) );
+    CHECKSTATUS( LTFAT_NAME(ifft_init)(L, W, p->F, p->F, flags, &p->inv));
+    p->part[0] = p->F;
+    LTFAT_NAME(ifilterbank_partition)(p);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(ifilterbank_done_priv)(p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(ifilterbank_set_nthreads)(LTFAT_NAME(ifilterbank_plan)* p,
+                                     ltfat_int nthreads)
+{
+    ltfat_int* chanstart = NULL;
+    LTFAT_COMPLEX** part = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+    if (nthreads == p->nthreads) return status;
+
+    CHECKMEM( chanstart = LTFAT_NEWARRAY(ltfat_int, nthreads + 1) );
+    CHECKMEM( part = LTFAT_NEWARRAY(LTFAT_COMPLEX*, nthreads) );
+    part[0] = p->F;
+    for (ltfat_int t = 1; t < nthreads; t++)
+        CHECKMEM( part[t] = LTFAT_NAME_COMPLEX(malloc)(p->L * p->W) );
+
+    for (ltfat_int t = 1; t < p->nthreads; t++)
+        ltfat_free(p->part[t]);
+    LTFAT_SAFEFREEALL(p->chanstart, p->part);
+
+    p->chanstart = chanstart; p->part = part; p->nthreads = nthreads;
+    LTFAT_NAME(ifilterbank_partition)(p);
+    return status;
+error:
+    if (part)
+        for (ltfat_int t = 1; t < nthreads; t++)
+            ltfat_safefree(part[t]);
+    LTFAT_SAFEFREEALL(chanstart, part);
+    return status;
+}
+
+static void
+LTFAT_NAME(ifilterbank_accumulate)(const LTFAT_COMPLEX* X, ltfat_int N,
+                                   const LTFAT_NAME(ifilterbank_segment)* s,
+                                   ltfat_int L, LTFAT_COMPLEX* F)
+{
+    ltfat_int l = ltfat_positiverem(s->off, L);
+    ltfat_int n = ltfat_positiverem(s->off, N);
+
+    for (ltfat_int k = 0; k < s->len; k++)
+    {
+        F[l] += X[n] * s->H[k];
+        if (++l == L) l = 0;
+        if (++n == N) n = 0;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(ifilterbank_execute)(LTFAT_NAME(ifilterbank_plan)* p,
+                                const LTFAT_COMPLEX* c[], LTFAT_COMPLEX f[])
+{
+    ltfat_int M, L, W, T;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    M = p->M; L = p->L; W = p->W; T = p->nthreads;
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(T)
+#endif
+    {
+#ifdef _OPENMP
+        #pragma omp for
+#endif
+        for (ltfat_int m = 0; m < M; m++)
+        {
+            LTFAT_NAME(ifilterbank_group)* gr = &p->groups[p->grp[m]];
+            memcpy(gr->buf + p->slot[m] * W * gr->N, c[m],
+                   W * gr->N * sizeof * gr->buf);
+        }
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+            LTFAT_NAME(fft_execute)(p->groups[k].fwd);
+
+        // Every thread accumulates its channels into its partial spectrum
+#ifdef _OPENMP
+        #pragma omp for schedule(static, 1)
+#endif
+        for (ltfat_int t = 0; t < T; t++)
+        {
+            LTFAT_COMPLEX* Ft = p->part[t];
+            LTFAT_NAME_COMPLEX(clear_array)(Ft, L * W);
+
+            for (ltfat_int m = p->chanstart[t]; m < p->chanstart[t + 1]; m++)
+            {
+                LTFAT_NAME(ifilterbank_group)* gr = &p->groups[p->grp[m]];
+                for (ltfat_int w = 0; w < W; w++)
+                {
+                    const LTFAT_COMPLEX* X = gr->buf + (p->slot[m] * W + w) * gr->N;
+                    for (ltfat_int sidx = 2 * m; sidx < 2 * m + 2; sidx++)
+                        if (p->seg[sidx].len)
+                            LTFAT_NAME(ifilterbank_accumulate)(
+                                X, gr->N, &p->seg[sidx], L, Ft + w * L);
+                }
+            }
+        }
+
+        // Pairwise summation of the partial spectra into part[0]
+        for (ltfat_int s = 1; s < T; s *= 2)
+        {
+            ltfat_int npairs = (T - s + 2 * s - 1) / (2 * s);
+            ltfat_int nblk = (L * W + IFILTERBANK_REDBLOCK - 1) / IFILTERBANK_REDBLOCK;
+#ifdef _OPENMP
+            #pragma omp for
+#endif
+            for (ltfat_int k = 0; k < npairs * nblk; k++)
+            {
+                ltfat_int t = (k / nblk) * 2 * s;
+                ltfat_int lstart = (k % nblk) * IFILTERBANK_REDBLOCK;
+                ltfat_int lend = ltfat_imin(lstart + IFILTERBANK_REDBLOCK, L * W);
+                LTFAT_COMPLEX* Fdst = p->part[t];
+                const LTFAT_COMPLEX* Fsrc = p->part[t + s];
+
+                for (ltfat_int l = lstart; l < lend; l++)
+                    Fdst[l] += Fsrc[l];
+            }
+        }
+    }
+
+    LTFAT_NAME(ifft_execute)(p->inv);
+
+    for (ltfat_int l = 0; l < L * W; l++)
+        f[l] = p->F[l] / ((LTFAT_REAL) L);
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(ifilterbank_done)(LTFAT_NAME(ifilterbank_plan)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    LTFAT_NAME(ifilterbank_done_priv)(*p);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(ifilterbank)(const LTFAT_COMPLEX* c[], const LTFAT_COMPLEX* G[],
+                        const ltfat_int Gl[], const ltfat_int foff[],
+                        const int realonly[], const double a[], ltfat_int M,
+                        ltfat_int L, ltfat_int W, LTFAT_COMPLEX f[])
+{
+    LTFAT_NAME(ifilterbank_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(ifilterbank_init)(G, Gl, foff, realonly, a, M, L,
+                 W, FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(ifilterbank_execute)(p, c, f));
+
+error:
+    if (p) LTFAT_NAME(ifilterbank_done)(&p);
+    return status;
 }
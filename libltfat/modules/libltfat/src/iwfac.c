@@ -4,6 +4,10 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 struct LTFAT_NAME(iwfac_plan)
 {
     ltfat_int b;
@@ -15,11 +19,59 @@ struct LTFAT_NAME(iwfac_plan)
     ltfat_int M;
     ltfat_int L;
     LTFAT_REAL scaling;
-    LTFAT_REAL* sbuf;
+    unsigned flags;
+    ltfat_int nthreads;
+    LTFAT_REAL* sbuf; //!< 2d for every thread
     /* LTFAT_FFTW(plan) p_before; */
-    LTFAT_NAME_REAL(ifft_plan)* p_before;
+    LTFAT_NAME_REAL(ifft_plan)** p_before; //!< One plan per thread, working on its part of sbuf
 };
 
+static void
+LTFAT_NAME(iwfac_threads_done)(LTFAT_NAME(iwfac_plan)* plan)
+{
+    if (plan->p_before)
+    {
+        for (ltfat_int t = 0; t < plan->nthreads; t++)
+            if (plan->p_before[t]) LTFAT_NAME_REAL(ifft_done)(&plan->p_before[t]);
+    }
+    ltfat_safefree(plan->p_before);
+    ltfat_safefree(plan->sbuf);
+    plan->p_before = NULL; plan->sbuf = NULL;
+}
+
+static int
+LTFAT_NAME(iwfac_threads_init)(LTFAT_NAME(iwfac_plan)* plan, ltfat_int nthreads)
+{
+    ltfat_int d = plan->d;
+    int status = LTFATERR_SUCCESS;
+
+    LTFAT_NAME(iwfac_threads_done)(plan);
+    plan->nthreads = nthreads;
+
+    CHECKMEM(plan->sbuf = LTFAT_NAME_REAL(malloc)(2 * d * nthreads));
+    CHECKMEM(plan->p_before = LTFAT_NEWARRAY(LTFAT_NAME_REAL(ifft_plan)*, nthreads));
+
+    /* Create plans. In-place. */
+    /* plan->p_before = LTFAT_FFTW(plan_dft_1d)((int)plan->d, */
+    /*                  (LTFAT_FFTW(complex)*) plan->sbuf, */
+    /*                  (LTFAT_FFTW(complex)*) plan->sbuf, */
+    /*                  FFTW_BACKWARD, flags); */
+    for (ltfat_int t = 0; t < nthreads; t++)
+    {
+        LTFAT_COMPLEX* sbufTmp = (LTFAT_COMPLEX*) (plan->sbuf + 2 * d * t);
+        LTFAT_NAME_REAL(ifft_init)(d, 1, sbufTmp, sbufTmp, plan->flags,
+                                   &plan->p_before[t]);
+
+        CHECKINIT(plan->p_before[t], "FFTW plan creation failed.");
+    }
+
+    return status;
+error:
+    LTFAT_NAME(iwfac_threads_done)(plan);
+    plan->nthreads = 0;
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(iwfac)(const LTFAT_COMPLEX* gf, ltfat_int L, ltfat_int R,
                   ltfat_int a, ltfat_int M, LTFAT_TYPE* g)
@@ -31,6 +83,11 @@ LTFAT_NAME(iwfac)(const LTFAT_COMPLEX* gf, ltfat_int L, ltfat_int R,
     CHECKSTATUS(
         LTFAT_NAME(iwfac_init)( L, a, M, FFTW_MEASURE, &p));
 
+#ifdef _OPENMP
+    CHECKSTATUS(
+        LTFAT_NAME(iwfac_set_nthreads)(p, omp_get_max_threads()));
+#endif
+
     CHECKSTATUS(
         LTFAT_NAME(iwfac_execute)(p, gf, R, g));
 
@@ -66,46 +123,49 @@ LTFAT_NAME(iwfac_init)(ltfat_int L, ltfat_int a, ltfat_int M,
     plan->a = a; plan->M = M; plan->L = L;
     plan->scaling = (LTFAT_REAL)( 1.0 / sqrt((double)M) / plan->d );
 
-    CHECKMEM(plan->sbuf = LTFAT_NAME_REAL(malloc)(2 * plan->d));
+    plan->flags = flags;
 
-    /* Create plan. In-place. */
-    /* plan->p_before = LTFAT_FFTW(plan_dft_1d)((int)plan->d, */
-    /*                  (LTFAT_FFTW(complex)*) plan->sbuf, */
-    /*                  (LTFAT_FFTW(complex)*) plan->sbuf, */
-    /*                  FFTW_BACKWARD, flags); */
-    LTFAT_NAME_REAL(ifft_init)(plan->d, 1,
-                               (LTFAT_COMPLEX*) plan->sbuf,
-                               (LTFAT_COMPLEX*) plan->sbuf,
-                               flags, &plan->p_before);
-
-    CHECKINIT(plan->p_before, "FFTW plan creation failed.");
+    CHECKSTATUS( LTFAT_NAME(iwfac_threads_init)(plan, 1));
 
     *pout = plan;
     return status;
 error:
     if (plan)
     {
-        /* if (plan->p_before) LTFAT_FFTW(destroy_plan)(plan->p_before); */
-        if (plan->p_before) LTFAT_NAME_REAL(ifft_done)(&plan->p_before);
-        ltfat_free(plan->sbuf);
+        LTFAT_NAME(iwfac_threads_done)(plan);
         ltfat_free(plan);
     }
     *pout = NULL;
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(iwfac_set_nthreads)(LTFAT_NAME(iwfac_plan)* plan, ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(plan);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+#ifndef _OPENMP
+    nthreads = 1;
+#endif
+
+    if (nthreads != plan->nthreads)
+        CHECKSTATUS( LTFAT_NAME(iwfac_threads_init)(plan, nthreads));
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(iwfac_execute)(LTFAT_NAME(iwfac_plan)* plan, const LTFAT_COMPLEX* gf,
                           ltfat_int R, LTFAT_TYPE* g)
 {
-    ltfat_int rem, negrem, c, p, q, d, M, a, L, ld3;
+    ltfat_int c, p, q, d, M, a, L, ld3, nblocks, T;
     LTFAT_REAL scaling;
-    LTFAT_REAL* sbuf, *gfp;
-    /* LTFAT_FFTW(plan) p_before; */
-    LTFAT_NAME_REAL(ifft_plan)* p_before;
     int status = LTFATERR_SUCCESS;
     CHECKNULL(plan); CHECKNULL(g); CHECKNULL(gf);
     CHECK(LTFATERR_NOTPOSARG, R > 0, "R (passed %td) must be positive.", R);
+    CHECKNULL(plan->p_before);
 
     c = plan->c;
     p = plan->p;
@@ -114,45 +174,52 @@ LTFAT_NAME(iwfac_execute)(LTFAT_NAME(iwfac_plan)* plan, const LTFAT_COMPLEX* gf,
     M = plan->M;
     a = plan->a;
     L = plan->L;
+    T = plan->nthreads;
 
     scaling = plan->scaling;
-    sbuf = plan->sbuf;
-    p_before = plan->p_before;
 
     ld3 = c * p * q * R;
-    gfp = (LTFAT_REAL*)gf;
 
-    for (ltfat_int r = 0; r < c; r++)
+    /* The blocks, indexed as ((r*R + w)*q + l)*p + k, are independent.
+     * Every thread does a contiguous range of them. */
+    nblocks = c * R * q * p;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(T)
+#endif
+    for (ltfat_int t = 0; t < T; t++)
     {
-        for (ltfat_int w = 0; w < R; w++)
+        LTFAT_REAL* sbuf = plan->sbuf + 2 * d * t;
+        LTFAT_NAME_REAL(ifft_plan)* p_before = plan->p_before[t];
+
+        for (ltfat_int blk = t * nblocks / T; blk < (t + 1) * nblocks / T; blk++)
         {
-            for (ltfat_int l = 0; l < q; l++)
+            ltfat_int k = blk % p;
+            ltfat_int l = (blk / p) % q;
+            ltfat_int w = (blk / (p * q)) % R;
+            ltfat_int r = blk / (p * q * R);
+            const LTFAT_REAL* gfp = (const LTFAT_REAL*)gf + 2 * blk;
+
+            ltfat_int negrem = ltfat_positiverem(k * M - l * a, L);
+            for (ltfat_int s = 0; s < 2 * d; s += 2)
+            {
+                sbuf[s]   = gfp[s * ld3] * scaling;
+                sbuf[s + 1] = gfp[s * ld3 + 1] * scaling;
+            }
+
+            /* LTFAT_FFTW(execute)(p_before); */
+            LTFAT_NAME_REAL(ifft_execute)(p_before);
+
+            for (ltfat_int s = 0; s < d; s++)
             {
-                for (ltfat_int k = 0; k < p; k++)
-                {
-                    negrem = ltfat_positiverem(k * M - l * a, L);
-                    for (ltfat_int s = 0; s < 2 * d; s += 2)
-                    {
-                        sbuf[s]   = gfp[s * ld3] * scaling;
-                        sbuf[s + 1] = gfp[s * ld3 + 1] * scaling;
-                    }
-
-                    /* LTFAT_FFTW(execute)(p_before); */
-                    LTFAT_NAME_REAL(ifft_execute)(p_before);
-
-                    for (ltfat_int s = 0; s < d; s++)
-                    {
-                        rem = (negrem + s * p * M) % L;
+                ltfat_int rem = (negrem + s * p * M) % L;
 #ifdef LTFAT_COMPLEXTYPE
-                        LTFAT_REAL* gTmp = (LTFAT_REAL*) & (g[r + rem + L * w]);
-                        gTmp[0] = sbuf[2 * s];
-                        gTmp[1] = sbuf[2 * s + 1];
+                LTFAT_REAL* gTmp = (LTFAT_REAL*) & (g[r + rem + L * w]);
+                gTmp[0] = sbuf[2 * s];
+                gTmp[1] = sbuf[2 * s + 1];
 #else
-                        g[r + rem + L * w] = sbuf[2 * s];
+                g[r + rem + L * w] = sbuf[2 * s];
 #endif
-                    }
-                    gfp += 2;
-                }
             }
         }
     }
@@ -169,8 +236,7 @@ LTFAT_NAME(iwfac_done)(LTFAT_NAME(iwfac_plan)** pout)
     CHECKNULL(*pout);
 
     /* LTFAT_FFTW(destroy_plan)((*pout)->p_before); */
-    LTFAT_NAME_REAL(ifft_done)(&(*pout)->p_before);
-    ltfat_free((*pout)->sbuf);
+    LTFAT_NAME(iwfac_threads_done)(*pout);
     ltfat_free(*pout);
     *pout = NULL;
 error:
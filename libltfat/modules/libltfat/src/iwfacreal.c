@@ -4,6 +4,10 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 LTFAT_API void
 LTFAT_NAME(iwfacreal)(const LTFAT_COMPLEX* gf, ltfat_int L,
                       ltfat_int R,
@@ -13,7 +17,9 @@ LTFAT_NAME(iwfacreal)(const LTFAT_COMPLEX* gf, ltfat_int L,
     ltfat_int h_a, h_m;
 
     /* LTFAT_FFTW(plan) p_before; */
-    LTFAT_NAME_REAL(ifftreal_plan)* p_before;
+    LTFAT_NAME_REAL(ifftreal_plan)** p_before = NULL;
+    LTFAT_REAL*    sbuf = NULL;
+    LTFAT_COMPLEX* cbuf = NULL;
 
     ltfat_int b = L / M;
     ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
@@ -27,49 +33,69 @@ LTFAT_NAME(iwfacreal)(const LTFAT_COMPLEX* gf, ltfat_int L,
     /* division by d is because of the way FFTW normalizes the transform. */
     LTFAT_REAL scaling = (LTFAT_REAL) ( 1.0 / sqrt((double)M) / d );
 
-    LTFAT_REAL*    sbuf = LTFAT_NAME_REAL(malloc)( d);
-    LTFAT_COMPLEX* cbuf = LTFAT_NAME_COMPLEX(malloc)( d2);
+    ltfat_int ld3 = c * p * q * R;
 
-    /* Create plan. In-place. */
+    /* The blocks, indexed as ((r*R + w)*q + l)*p + k, are independent.
+     * Every thread does a contiguous range of them. */
+    ltfat_int nblocks = c * R * q * p;
+#ifdef _OPENMP
+    ltfat_int T = omp_get_max_threads();
+#else
+    ltfat_int T = 1;
+#endif
+
+    sbuf = LTFAT_NAME_REAL(malloc)(d * T);
+    cbuf = LTFAT_NAME_COMPLEX(malloc)(d2 * T);
+    p_before = LTFAT_NEWARRAY(LTFAT_NAME_REAL(ifftreal_plan)*, T);
+    if (!sbuf || !cbuf || !p_before) goto error;
+
+    /* Create plans. */
     /* p_before = LTFAT_FFTW(plan_dft_c2r_1d)((int)d, (LTFAT_FFTW(complex)*) cbuf, sbuf, */
     /*                                        FFTW_MEASURE); */
-    LTFAT_NAME_REAL(ifftreal_init)(d, 1, cbuf, sbuf, FFTW_MEASURE, &p_before);
+    for (ltfat_int t = 0; t < T; t++)
+        if (LTFAT_NAME_REAL(ifftreal_init)(d, 1, cbuf + t * d2, sbuf + t * d,
+                                           FFTW_MEASURE, &p_before[t]))
+            goto error;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(T)
+#endif
+    for (ltfat_int t = 0; t < T; t++)
+    {
+        LTFAT_REAL* sbufTmp = sbuf + t * d;
+        LTFAT_COMPLEX* cbufTmp = cbuf + t * d2;
 
-    ltfat_int ld3 = c * p * q * R;
+        for (ltfat_int blk = t * nblocks / T; blk < (t + 1) * nblocks / T; blk++)
+        {
+            ltfat_int k = blk % p;
+            ltfat_int l = (blk / p) % q;
+            ltfat_int w = (blk / (p * q)) % R;
+            ltfat_int r = blk / (p * q * R);
+            const LTFAT_COMPLEX* gfp = gf + blk;
+
+            ltfat_int negrem = ltfat_positiverem(k * M - l * a, L);
+            for (ltfat_int s = 0; s < d2; s++)
+            {
+                cbufTmp[s] = gfp[s * ld3] * scaling;
+            }
 
-    /* Advancing pointer: Runs through array pointing out the base for the strided operations. */
-    const LTFAT_COMPLEX* gfp = gf;
+            /* LTFAT_FFTW(execute)(p_before); */
+            LTFAT_NAME_REAL(ifftreal_execute)(p_before[t]);
 
-    for (ltfat_int r = 0; r < c; r++)
-    {
-        for (ltfat_int w = 0; w < R; w++)
-        {
-            for (ltfat_int l = 0; l < q; l++)
+            for (ltfat_int s = 0; s < d; s++)
             {
-                for (ltfat_int k = 0; k < p; k++)
-                {
-                    ltfat_int negrem = ltfat_positiverem(k * M - l * a, L);
-                    for (ltfat_int s = 0; s < d2; s++)
-                    {
-                        cbuf[s] = gfp[s * ld3] * scaling;
-                    }
-
-                    /* LTFAT_FFTW(execute)(p_before); */
-                    LTFAT_NAME_REAL(ifftreal_execute)(p_before);
-
-                    for (ltfat_int s = 0; s < d; s++)
-                    {
-                        g[r + (negrem + s * p * M) % L + L * w] = sbuf[s];
-                    }
-                    gfp++;
-                }
+                g[r + (negrem + s * p * M) % L + L * w] = sbufTmp[s];
             }
         }
     }
 
+error:
+    if (p_before)
+    {
+        /* LTFAT_FFTW(destroy_plan)(p_before); */
+        for (ltfat_int t = 0; t < T; t++)
+            if (p_before[t]) LTFAT_NAME_REAL(ifftreal_done)(&p_before[t]);
+    }
     /* Clear the work-arrays. */
-    LTFAT_SAFEFREEALL(cbuf, sbuf);
-
-    /* LTFAT_FFTW(destroy_plan)(p_before); */
-    LTFAT_NAME_REAL(ifftreal_done)(&p_before);
+    LTFAT_SAFEFREEALL(cbuf, sbuf, p_before);
 }
@@ -164,3 +164,111 @@ LTFAT_NAME_REAL(idwiltiii_fb)(const LTFAT_REAL* c, const LTFAT_REAL* g,
 #undef PREPROC_COMPLEX
 #undef POSTPROC_REAL
 #undef POSTPROC_COMPLEX
+
+#include "dwilt_private.h"
+
+struct LTFAT_NAME(iwmdct_plan)
+{
+    LTFAT_NAME(wilson_fold) fo;
+    LTFAT_NAME(fftreal_plan)* p_fft;
+    LTFAT_REAL* y;     //!< Folded column, 2M
+    LTFAT_REAL* v;     //!< FFT input, M
+    LTFAT_COMPLEX* V;  //!< FFT output, M/2 + 1
+    LTFAT_COMPLEX* tw; //!< exp(-i*pi*k/(2M))
+};
+
+LTFAT_API int
+LTFAT_NAME(iwmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                        ltfat_int W, ltfat_int M, unsigned flags,
+                        LTFAT_NAME(iwmdct_plan)** pout)
+{
+    LTFAT_NAME(iwmdct_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(iwmdct_plan)) );
+    CHECKSTATUS( LTFAT_NAME(wilson_fold_init)(g, gl, L, W, M, 1, &p->fo));
+
+    CHECKMEM( p->y  = LTFAT_NAME_REAL(malloc)(2 * M) );
+    CHECKMEM( p->v  = LTFAT_NAME_REAL(malloc)(M) );
+    CHECKMEM( p->V  = LTFAT_NAME_COMPLEX(malloc)(M / 2 + 1) );
+    CHECKMEM( p->tw = LTFAT_NAME_COMPLEX(malloc)(M) );
+
+    for (ltfat_int k = 0; k < M; k++)
+        p->tw[k] = exp(-I * (LTFAT_REAL) (M_PI * k / (2.0 * M)));
+
+    CHECKSTATUS( LTFAT_NAME(fftreal_init)(M, 1, p->v, p->V, flags, &p->p_fft));
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(iwmdct_done)(&p);
+    return status;
+}
+
+/* Transpose of wmdct_execute: a DCT-II of length M followed by unfolding */
+LTFAT_API int
+LTFAT_NAME(iwmdct_execute)(LTFAT_NAME(iwmdct_plan)* p, const LTFAT_REAL c[],
+                           LTFAT_REAL f[])
+{
+    ltfat_int M, L, N;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    M = p->fo.M; L = p->fo.L; N = p->fo.N;
+
+    memset(f, 0, L * p->fo.W * sizeof * f);
+
+    for (ltfat_int w = 0; w < p->fo.W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            LTFAT_REAL* y = p->y;
+            const LTFAT_REAL* cn = c + n * M + w * M * N;
+            LTFAT_REAL sgn = (n % 4) < 2 ? 1.0 : -1.0;
+
+            for (ltfat_int m = 0; 2 * m < M; m++)
+                p->v[m] = sgn * cn[2 * m];
+
+            for (ltfat_int m = 0; 2 * m + 1 < M; m++)
+                p->v[M - 1 - m] = sgn * cn[2 * m + 1];
+
+            LTFAT_NAME(fftreal_execute)(p->p_fft);
+
+            memset(y, 0, 2 * M * sizeof * y);
+            y[0] = ltfat_real(p->V[0]);
+            y[M] = -y[0];
+
+            for (ltfat_int k = 1; k < M; k++)
+            {
+                LTFAT_COMPLEX Vk = k <= M / 2 ? p->V[k] : conj(p->V[M - k]);
+                LTFAT_REAL rk = ltfat_real(Vk * p->tw[k]);
+                y[k] += rk;
+                y[2 * M - k] -= rk;
+                y[M - k] -= rk;
+                y[M + k] -= rk;
+            }
+
+            LTFAT_NAME(wilson_unfold_execute)(&p->fo, y, n, f + w * L);
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(iwmdct_done)(LTFAT_NAME(iwmdct_plan)** p)
+{
+    LTFAT_NAME(iwmdct_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->p_fft) LTFAT_NAME(fftreal_done)(&pp->p_fft);
+    LTFAT_NAME(wilson_fold_done)(&pp->fo);
+    LTFAT_SAFEFREEALL(pp->y, pp->v, pp->V, pp->tw);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
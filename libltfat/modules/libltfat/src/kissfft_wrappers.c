@@ -48,9 +48,8 @@ LTFAT_NAME(fft_init_common)(ltfat_int L, ltfat_int W,
     if (L != nextfastL)
     {
         DEBUG("Warning: L=%td is a \"slow\" FFT lengh. "
-              "Next fast FFT lenght is L=%td. See ltfat_nextfastfft. "
-              "Moreover, some dynamic memory allocation will occur "
-              "during execution.", L, nextfastL);
+              "Next fast FFT lenght is L=%td. See ltfat_nextfastfft.",
+              L, nextfastL);
     }
 
     CHECKMEM( fftwp = LTFAT_NEW(LTFAT_NAME(fft_plan)) );
@@ -232,9 +231,8 @@ LTFAT_NAME(fftreal_init_common)(ltfat_int L, ltfat_int W,
     if (L != nextfastL)
     {
         DEBUG("Warning: L=%td is a \"slow\" FFT lengh. "
-              "Next fast FFT lenght is L=%td. See ltfat_nextfastfft. "
-              "Moreover, some dynamic memory allocation will occur "
-              "during execution.", L, nextfastL);
+              "Next fast FFT lenght is L=%td. See ltfat_nextfastfft.",
+              L, nextfastL);
     }
 
     if (L % 2)
@@ -317,7 +315,7 @@ LTFAT_NAME(fftreal_execute_newarray)(LTFAT_NAME(fftreal_plan)* p,
 
             for (ltfat_int w = 0; w < p->W; w++)
             {
-                memcpy(p->tmp, in + w * 2 * M2, p->L * sizeof * p->in);
+                memcpy((LTFAT_REAL*) p->tmp, in + w * 2 * M2, p->L * sizeof * in);
                 LTFAT_KISS(fftr)(p->kiss_plan,
                                  (const kiss_fft_scalar*) p->tmp,
                                  (kiss_fft_cpx*) out + w * M2);
@@ -0,0 +1,502 @@
+/* Native replacements of the BLAS and LAPACK routines from ltfat_blaslapack.c
+ *
+ * This file is compiled instead of ltfat_blaslapack.c when libltfat is built
+ * with NOBLASLAPACK. The matrices occurring in libltfat are small: the p x p
+ * blocks of the Walnut factorization and the Gram matrices of LocOMP. The
+ * routines are therefore unblocked, except for gemm, and all inner loops run
+ * over contiguous memory. The complex arithmetic is written out on the
+ * interleaved real and imaginary parts so that the loops can be vectorized.
+ * */
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+#include "ltfat/blaslapack.h"
+#include <float.h>
+
+#ifdef LTFAT_DOUBLE
+#define LTFAT_NATIVE_EPS DBL_EPSILON
+#else
+#define LTFAT_NATIVE_EPS FLT_EPSILON
+#endif
+
+/* Number of columns of A kept in cache in gemm */
+#ifndef LTFAT_GEMM_KBLOCK
+#   define LTFAT_GEMM_KBLOCK 64
+#endif
+
+/* Maximum number of sweeps of the Jacobi SVD */
+#define LTFAT_JACOBI_MAXSWEEPS 60
+
+/* y += alpha*x */
+static inline void
+LTFAT_NAME(native_axpy)(ptrdiff_t n, LTFAT_COMPLEX alpha,
+                        const LTFAT_COMPLEX* x, LTFAT_COMPLEX* y)
+{
+    const LTFAT_REAL* xr = (const LTFAT_REAL*) x;
+    LTFAT_REAL* yr = (LTFAT_REAL*) y;
+    LTFAT_REAL ar = ltfat_real(alpha), ai = ltfat_imag(alpha);
+
+    for (ptrdiff_t i = 0; i < n; i++)
+    {
+        LTFAT_REAL re = xr[2 * i], im = xr[2 * i + 1];
+        yr[2 * i]     += ar * re - ai * im;
+        yr[2 * i + 1] += ar * im + ai * re;
+    }
+}
+
+/* sum conj(x)*y, two partial sums to shorten the dependency chain */
+static inline LTFAT_COMPLEX
+LTFAT_NAME(native_dotc)(ptrdiff_t n, const LTFAT_COMPLEX* x,
+                        const LTFAT_COMPLEX* y)
+{
+    const LTFAT_REAL* xr = (const LTFAT_REAL*) x;
+    const LTFAT_REAL* yr = (const LTFAT_REAL*) y;
+    LTFAT_REAL re0 = 0.0, im0 = 0.0, re1 = 0.0, im1 = 0.0;
+    ptrdiff_t i = 0;
+
+    for (; i + 1 < n; i += 2)
+    {
+        re0 += xr[2 * i] * yr[2 * i] + xr[2 * i + 1] * yr[2 * i + 1];
+        im0 += xr[2 * i] * yr[2 * i + 1] - xr[2 * i + 1] * yr[2 * i];
+        re1 += xr[2 * i + 2] * yr[2 * i + 2] + xr[2 * i + 3] * yr[2 * i + 3];
+        im1 += xr[2 * i + 2] * yr[2 * i + 3] - xr[2 * i + 3] * yr[2 * i + 2];
+    }
+
+    if (i < n)
+    {
+        re0 += xr[2 * i] * yr[2 * i] + xr[2 * i + 1] * yr[2 * i + 1];
+        im0 += xr[2 * i] * yr[2 * i + 1] - xr[2 * i + 1] * yr[2 * i];
+    }
+
+    return (re0 + re1) + I * (im0 + im1);
+}
+
+/* x <- c*x - s*ph*y, y <- s*x + c*ph*y */
+static inline void
+LTFAT_NAME(native_rot)(ptrdiff_t n, LTFAT_REAL c, LTFAT_REAL s,
+                       LTFAT_COMPLEX ph, LTFAT_COMPLEX* x, LTFAT_COMPLEX* y)
+{
+    LTFAT_REAL* xr = (LTFAT_REAL*) x;
+    LTFAT_REAL* yr = (LTFAT_REAL*) y;
+    LTFAT_REAL pr = ltfat_real(ph), pi = ltfat_imag(ph);
+
+    for (ptrdiff_t k = 0; k < n; k++)
+    {
+        LTFAT_REAL xre = xr[2 * k], xim = xr[2 * k + 1];
+        LTFAT_REAL yre = pr * yr[2 * k] - pi * yr[2 * k + 1];
+        LTFAT_REAL yim = pr * yr[2 * k + 1] + pi * yr[2 * k];
+        xr[2 * k]     = c * xre - s * yre;
+        xr[2 * k + 1] = c * xim - s * yim;
+        yr[2 * k]     = s * xre + c * yre;
+        yr[2 * k + 1] = s * xim + c * yim;
+    }
+}
+
+/* Element (l,j) of op(B) */
+static inline LTFAT_COMPLEX
+LTFAT_NAME(native_opel)(const enum CBLAS_TRANSPOSE Trans,
+                        const LTFAT_COMPLEX* B, ptrdiff_t ldb,
+                        ptrdiff_t l, ptrdiff_t j)
+{
+    if (Trans == CblasNoTrans) return B[l + j * ldb];
+    if (Trans == CblasConjTrans) return conj(B[j + l * ldb]);
+    return B[j + l * ldb];
+}
+
+/* ----- Solve A*X = B with Cholesky factorization ------------
+ *
+ * Same as ZPOSV/CPOSV with UPLO='U'. A = U**H * U, U is stored in the upper
+ * triangle of A and X overwrites B. Returns k > 0 if the leading minor of
+ * order k is not positive definite.
+ */
+ltfat_int
+LTFAT_NAME(posv)(const ptrdiff_t N, const ptrdiff_t NRHS,
+                 LTFAT_COMPLEX* A, const ptrdiff_t lda,
+                 LTFAT_COMPLEX* B, const ptrdiff_t ldb)
+{
+    for (ptrdiff_t j = 0; j < N; j++)
+    {
+        LTFAT_COMPLEX* Aj = A + j * lda;
+        LTFAT_REAL djj;
+
+        // Solve U(0:j,0:j)**H * u = A(0:j,j)
+        for (ptrdiff_t i = 0; i < j; i++)
+        {
+            const LTFAT_COMPLEX* Ai = A + i * lda;
+            Aj[i] = (Aj[i] - LTFAT_NAME(native_dotc)(i, Ai, Aj)) / ltfat_real(Ai[i]);
+        }
+
+        djj = ltfat_real(Aj[j]) - ltfat_real(LTFAT_NAME(native_dotc)(j, Aj, Aj));
+
+        if (!(djj > 0.0))
+            return j + 1;
+
+        Aj[j] = sqrt(djj);
+    }
+
+    for (ptrdiff_t r = 0; r < NRHS; r++)
+    {
+        LTFAT_COMPLEX* b = B + r * ldb;
+
+        // U**H * y = b
+        for (ptrdiff_t i = 0; i < N; i++)
+        {
+            const LTFAT_COMPLEX* Ai = A + i * lda;
+            b[i] = (b[i] - LTFAT_NAME(native_dotc)(i, Ai, b)) / ltfat_real(Ai[i]);
+        }
+
+        // U * x = y
+        for (ptrdiff_t j = N - 1; j >= 0; j--)
+        {
+            const LTFAT_COMPLEX* Aj = A + j * lda;
+            b[j] /= ltfat_real(Aj[j]);
+            LTFAT_NAME(native_axpy)(j, -b[j], Aj, b);
+        }
+    }
+
+    return 0;
+}
+
+/* ----- C = alpha*op(A)*op(B) + beta*C  ------------ */
+void
+LTFAT_NAME(gemm)(const enum CBLAS_TRANSPOSE TransA,
+                 const enum CBLAS_TRANSPOSE TransB,
+                 const ptrdiff_t M, const ptrdiff_t N, const ptrdiff_t K,
+                 const LTFAT_COMPLEX* alpha,
+                 const LTFAT_COMPLEX* A, const ptrdiff_t lda,
+                 const LTFAT_COMPLEX* B, const ptrdiff_t ldb,
+                 const LTFAT_COMPLEX* beta,
+                 LTFAT_COMPLEX* C, const ptrdiff_t ldc)
+{
+    for (ptrdiff_t j = 0; j < N; j++)
+    {
+        LTFAT_COMPLEX* Cj = C + j * ldc;
+        if (*beta == (LTFAT_COMPLEX) 0.0)
+            LTFAT_NAME_COMPLEX(clear_array)(Cj, M);
+        else if (*beta != (LTFAT_COMPLEX) 1.0)
+            for (ptrdiff_t i = 0; i < M; i++)
+                Cj[i] *= *beta;
+    }
+
+    if (TransA == CblasNoTrans)
+    {
+        // Columns of C are combinations of the columns of A. A block of
+        // columns of A is reused for all columns of C.
+        for (ptrdiff_t l0 = 0; l0 < K; l0 += LTFAT_GEMM_KBLOCK)
+        {
+            ptrdiff_t l1 = l0 + LTFAT_GEMM_KBLOCK < K ? l0 + LTFAT_GEMM_KBLOCK : K;
+
+            for (ptrdiff_t j = 0; j < N; j++)
+                for (ptrdiff_t l = l0; l < l1; l++)
+                    LTFAT_NAME(native_axpy)(M,
+                        *alpha * LTFAT_NAME(native_opel)(TransB, B, ldb, l, j),
+                        A + l * lda, C + j * ldc);
+        }
+    }
+    else
+    {
+        // Elements of C are dot products of the columns of A
+        for (ptrdiff_t j = 0; j < N; j++)
+        {
+            for (ptrdiff_t i = 0; i < M; i++)
+            {
+                const LTFAT_COMPLEX* Ai = A + i * lda;
+                LTFAT_COMPLEX acc = 0.0;
+
+                if (TransB == CblasNoTrans && TransA == CblasConjTrans)
+                    acc = LTFAT_NAME(native_dotc)(K, Ai, B + j * ldb);
+                else
+                    for (ptrdiff_t l = 0; l < K; l++)
+                        acc += (TransA == CblasConjTrans ? conj(Ai[l]) : Ai[l]) *
+                               LTFAT_NAME(native_opel)(TransB, B, ldb, l, j);
+
+                C[i + j * ldc] += *alpha * acc;
+            }
+        }
+    }
+}
+
+/* Orthogonalizes the m rows of X (row i is X + i*n, m <= n) by one-sided
+ * Jacobi rotations and accumulates them in the m x m unitary matrix U such that
+ * X_in = U * X_out. The squared row norms are kept in nrm. Rows with a norm
+ * below eps*||X||_F are numerically zero and are not rotated, otherwise the
+ * rounding errors of a rank deficient X are rotated forever. Returns 0 if the
+ * sweeps converged. */
+static ltfat_int
+LTFAT_NAME(native_jacobi_rows)(ptrdiff_t m, ptrdiff_t n, LTFAT_COMPLEX* X,
+                               LTFAT_COMPLEX* U, LTFAT_REAL* nrm)
+{
+    const LTFAT_REAL tol = LTFAT_NATIVE_EPS * sqrt((double) n);
+    LTFAT_REAL nrmzero = 0.0;
+    int rotated = 1;
+
+    LTFAT_NAME_COMPLEX(clear_array)(U, m * m);
+    for (ptrdiff_t i = 0; i < m; i++)
+    {
+        U[i + i * m] = 1.0;
+        nrm[i] = ltfat_real(LTFAT_NAME(native_dotc)(n, X + i * n, X + i * n));
+        nrmzero += nrm[i];
+    }
+    nrmzero *= LTFAT_NATIVE_EPS * LTFAT_NATIVE_EPS;
+
+    for (int sweep = 0; sweep < LTFAT_JACOBI_MAXSWEEPS && rotated; sweep++)
+    {
+        rotated = 0;
+
+        for (ptrdiff_t i = 0; i < m - 1; i++)
+        {
+            for (ptrdiff_t j = i + 1; j < m; j++)
+            {
+                // <x_i, x_j> = sum x_i*conj(x_j)
+                LTFAT_COMPLEX gamma =
+                    LTFAT_NAME(native_dotc)(n, X + j * n, X + i * n);
+                LTFAT_REAL absg = ltfat_abs(gamma);
+                LTFAT_REAL zeta, t, c, s;
+
+                if (nrm[i] <= nrmzero || nrm[j] <= nrmzero ||
+                    absg <= tol * sqrt(nrm[i] * nrm[j]))
+                    continue;
+
+                rotated = 1;
+                zeta = (nrm[j] - nrm[i]) / (2.0 * absg);
+                t = (zeta >= 0.0 ? 1.0 : -1.0) / (fabs(zeta) + sqrt(1.0 + zeta * zeta));
+                c = 1.0 / sqrt(1.0 + t * t);
+                s = c * t;
+
+                LTFAT_NAME(native_rot)(n, c, s, gamma / absg, X + i * n, X + j * n);
+                // U <- U * G**H
+                LTFAT_NAME(native_rot)(m, c, s, conj(gamma) / absg,
+                                       U + i * m, U + j * m);
+
+                // Updating the norms by -+t*absg would lose the small ones
+                // to cancellation
+                nrm[i] = ltfat_real(LTFAT_NAME(native_dotc)(n, X + i * n, X + i * n));
+                nrm[j] = ltfat_real(LTFAT_NAME(native_dotc)(n, X + j * n, X + j * n));
+            }
+        }
+    }
+
+    return rotated;
+}
+
+/* Orthonormalizes the m rows of X (m <= n) in place by Gram-Schmidt with
+ * reorthogonalization. The rows are expected to be orthogonal already, except
+ * for the rows belonging to the small singular values S, which are only
+ * accurate to eps*S[0] in absolute terms. Rows of numerically zero singular
+ * values are replaced by the unit vector least covered by the previous rows,
+ * so that X always has orthonormal rows like the VT of LAPACK. */
+static void
+LTFAT_NAME(native_orthonormalize_rows)(ptrdiff_t m, ptrdiff_t n,
+                                       const LTFAT_REAL* S, LTFAT_COMPLEX* X)
+{
+    for (ptrdiff_t i = 0; i < m; i++)
+    {
+        LTFAT_COMPLEX* Xi = X + i * n;
+        LTFAT_REAL nrmi;
+
+        if (!(S[i] > n * LTFAT_NATIVE_EPS * S[0]))
+        {
+            ptrdiff_t kmax = 0;
+            LTFAT_REAL resmax = -1.0;
+
+            for (ptrdiff_t k = 0; k < n; k++)
+            {
+                LTFAT_REAL res = 1.0;
+                for (ptrdiff_t j = 0; j < i; j++)
+                    res -= ltfat_real(X[j * n + k] * conj(X[j * n + k]));
+                if (res > resmax) { resmax = res; kmax = k; }
+            }
+
+            LTFAT_NAME_COMPLEX(clear_array)(Xi, n);
+            Xi[kmax] = 1.0;
+        }
+
+        for (int pass = 0; pass < 2; pass++)
+            for (ptrdiff_t j = 0; j < i; j++)
+                LTFAT_NAME(native_axpy)(n, -LTFAT_NAME(native_dotc)(n, X + j * n, Xi),
+                                        X + j * n, Xi);
+
+        nrmi = sqrt(ltfat_real(LTFAT_NAME(native_dotc)(n, Xi, Xi)));
+        for (ptrdiff_t k = 0; k < n; k++)
+            Xi[k] /= nrmi;
+    }
+}
+
+/* ----- Compute thin SVD ------------
+ *
+ * Same as ZGESVD/CGESVD with JOBU=JOBVT='S' using the one-sided Jacobi
+ * method. The singular values are sorted in descending order. Returns 1 if
+ * the Jacobi sweeps did not converge.
+ */
+ltfat_int
+LTFAT_NAME(gesvd)(const ptrdiff_t M, const ptrdiff_t N,
+                  LTFAT_COMPLEX* A, const ptrdiff_t lda,
+                  LTFAT_REAL* S, LTFAT_COMPLEX* U, const ptrdiff_t ldu,
+                  LTFAT_COMPLEX* VT, const ptrdiff_t ldvt)
+{
+    // Work on the rows of A if M <= N and on the rows of A**H otherwise
+    ptrdiff_t m = M <= N ? M : N, n = M <= N ? N : M;
+    LTFAT_COMPLEX* X = LTFAT_NAME_COMPLEX(malloc)(m * n);
+    LTFAT_COMPLEX* Uacc = LTFAT_NAME_COMPLEX(malloc)(m * m);
+    ltfat_int info;
+
+    if (!X || !Uacc)
+    {
+        LTFAT_SAFEFREEALL(X, Uacc);
+        return LTFATERR_NOMEM;
+    }
+
+    for (ptrdiff_t i = 0; i < m; i++)
+        for (ptrdiff_t k = 0; k < n; k++)
+            X[i * n + k] = M <= N ? A[i + k * lda] : conj(A[k + i * lda]);
+
+    info = LTFAT_NAME(native_jacobi_rows)(m, n, X, Uacc, S);
+
+    for (ptrdiff_t i = 0; i < m; i++)
+        S[i] = sqrt(S[i]);
+
+    // Selection sort of the singular values
+    for (ptrdiff_t i = 0; i < m - 1; i++)
+    {
+        ptrdiff_t imax = i;
+        for (ptrdiff_t j = i + 1; j < m; j++)
+            if (S[j] > S[imax]) imax = j;
+
+        if (imax != i)
+        {
+            LTFAT_REAL stmp = S[i]; S[i] = S[imax]; S[imax] = stmp;
+            for (ptrdiff_t k = 0; k < n; k++)
+            {
+                LTFAT_COMPLEX tmp = X[i * n + k];
+                X[i * n + k] = X[imax * n + k]; X[imax * n + k] = tmp;
+            }
+            for (ptrdiff_t k = 0; k < m; k++)
+            {
+                LTFAT_COMPLEX tmp = Uacc[k + i * m];
+                Uacc[k + i * m] = Uacc[k + imax * m]; Uacc[k + imax * m] = tmp;
+            }
+        }
+    }
+
+    // The rows of X are S times the singular vectors. Dividing them by S
+    // would amplify the errors of the small singular values.
+    LTFAT_NAME(native_orthonormalize_rows)(m, n, S, X);
+
+    for (ptrdiff_t i = 0; i < m; i++)
+    {
+        if (M <= N)
+        {
+            // A = Uacc * S * X
+            for (ptrdiff_t k = 0; k < m; k++)
+                U[k + i * ldu] = Uacc[k + i * m];
+            for (ptrdiff_t k = 0; k < n; k++)
+                VT[i + k * ldvt] = X[i * n + k];
+        }
+        else
+        {
+            // A**H = Uacc * S * X  =>  A = X**H * S * Uacc**H
+            for (ptrdiff_t k = 0; k < n; k++)
+                U[k + i * ldu] = conj(X[i * n + k]);
+            for (ptrdiff_t k = 0; k < m; k++)
+                VT[i + k * ldvt] = conj(Uacc[k + i * m]);
+        }
+    }
+
+    LTFAT_SAFEFREEALL(X, Uacc);
+    return info;
+}
+
+/* ----- Hermitian system solver used by LocOMP  ------------
+ *
+ * LDL**H factorization without pivoting of the lower triangle of A. The Gram
+ * matrices passed to it are positive definite unless the atoms are
+ * linearly dependent, in which case a pivot is not positive and the solver
+ * fails.
+ */
+struct LTFAT_NAME_COMPLEX(hermsystemsolver_plan)
+{
+    ltfat_int Mmax;
+    LTFAT_COMPLEX* work;
+};
+
+LTFAT_API int
+LTFAT_NAME_COMPLEX(hermsystemsolver_init)(ltfat_int M,
+        LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** pout)
+{
+    int status = LTFATERR_SUCCESS;
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* p = NULL;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME_COMPLEX(hermsystemsolver_plan)));
+    CHECKMEM( p->work = LTFAT_NAME_COMPLEX(malloc)(M * M) );
+    p->Mmax = M;
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* p,
+    const LTFAT_COMPLEX* A, ltfat_int M, LTFAT_COMPLEX* b)
+{
+    LTFAT_COMPLEX* W = p->work;
+
+    if (M > p->Mmax)
+        return LTFATERR_BADSIZE;
+
+    for (ltfat_int j = 0; j < M; j++)
+        memcpy(W + j + j * M, A + j + j * M, (M - j) * sizeof * W);
+
+    // W = L*D*L**H, the unit lower triangular L is stored below the
+    // diagonal and D on the diagonal
+    for (ltfat_int j = 0; j < M; j++)
+    {
+        LTFAT_COMPLEX* Wj = W + j * M;
+        LTFAT_REAL dj = ltfat_real(Wj[j]);
+
+        if (!(dj > 0.0))
+            return j + 1;
+
+        // Trailing update with the unscaled column, then scale it
+        for (ltfat_int c = j + 1; c < M; c++)
+            LTFAT_NAME(native_axpy)(M - c, -conj(Wj[c]) / dj, Wj + c, W + c + c * M);
+
+        for (ltfat_int i = j + 1; i < M; i++)
+            Wj[i] /= dj;
+    }
+
+    // L * z = b
+    for (ltfat_int j = 0; j < M; j++)
+        LTFAT_NAME(native_axpy)(M - j - 1, -b[j], W + j + 1 + j * M, b + j + 1);
+
+    // D * y = z
+    for (ltfat_int j = 0; j < M; j++)
+        b[j] /= ltfat_real(W[j + j * M]);
+
+    // L**H * x = y
+    for (ltfat_int j = M - 1; j >= 0; j--)
+        b[j] -= LTFAT_NAME(native_dotc)(M - j - 1, W + j + 1 + j * M, b + j + 1);
+
+    return 0;
+}
+
+LTFAT_API int
+LTFAT_NAME_COMPLEX(hermsystemsolver_done)(
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)** p)
+{
+    LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    ltfat_safefree(pp->work);
+
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
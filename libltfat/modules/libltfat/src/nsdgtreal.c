@@ -0,0 +1,469 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include "ltfat/thirdparty/fftw3.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Frames sharing the same number of channels share one FFT plan which
+ * transforms all of them and all signal channels at once. */
+typedef struct
+{
+    ltfat_int M;
+    ltfat_int N;             //!< Number of frames in the group
+    LTFAT_REAL* fbuf;        //!< M x N x W
+    LTFAT_COMPLEX* cbuf;     //!< (M/2 + 1) x N x W
+    LTFAT_NAME(fftreal_plan)* fwd;
+    LTFAT_NAME(ifftreal_plan)* inv;
+} LTFAT_NAME(nsdgtreal_group);
+
+struct LTFAT_NAME(nsdgtreal_plan)
+{
+    ltfat_int N;
+    ltfat_int L;
+    ltfat_int W;
+    const LTFAT_REAL** g;
+    ltfat_int* gl;
+    ltfat_int* M;
+    ltfat_int* timepos;
+    ltfat_int* coff;         //!< Offset of frame n in c
+    ltfat_int* grp;          //!< Group of frame n
+    ltfat_int* slot;         //!< Position of frame n within its group
+    ltfat_int ngrp;
+    LTFAT_NAME(nsdgtreal_group)* groups;
+    ltfat_int nthreads;
+};
+
+static int
+LTFAT_NAME(nsdgtreal_done_priv)(LTFAT_NAME(nsdgtreal_plan)* p)
+{
+    if (p->groups)
+    {
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+        {
+            LTFAT_NAME(nsdgtreal_group)* gr = &p->groups[k];
+            if (gr->fwd) LTFAT_NAME(fftreal_done)(&gr->fwd);
+            if (gr->inv) LTFAT_NAME(ifftreal_done)(&gr->inv);
+            LTFAT_SAFEFREEALL(gr->fbuf, gr->cbuf);
+        }
+    }
+
+    LTFAT_SAFEFREEALL(p->g, p->gl, p->M, p->timepos, p->coff, p->grp,
+                      p->slot, p->groups);
+    ltfat_free(p);
+    return LTFATERR_SUCCESS;
+}
+
+static int
+LTFAT_NAME(nsdgtreal_init_priv)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                                const ltfat_int a[], const ltfat_int M[],
+                                ltfat_int N, ltfat_int W, unsigned flags,
+                                ltfat_transformdirection tradir,
+                                LTFAT_NAME(nsdgtreal_plan)** pout)
+{
+    LTFAT_NAME(nsdgtreal_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a); CHECKNULL(M); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, N > 0, "N (passed %td) must be positive.", N);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(nsdgtreal_plan)) );
+    p->N = N; p->W = W; p->nthreads = 1;
+
+    CHECKMEM( p->g = LTFAT_NEWARRAY(const LTFAT_REAL*, N) );
+    CHECKMEM( p->gl = LTFAT_NEWARRAY(ltfat_int, N) );
+    CHECKMEM( p->M = LTFAT_NEWARRAY(ltfat_int, N) );
+    CHECKMEM( p->timepos = LTFAT_NEWARRAY(ltfat_int, N) );
+    CHECKMEM( p->coff = LTFAT_NEWARRAY(ltfat_int, N) );
+    CHECKMEM( p->grp = LTFAT_NEWARRAY(ltfat_int, N) );
+    CHECKMEM( p->slot = LTFAT_NEWARRAY(ltfat_int, N) );
+    CHECKMEM( p->groups = LTFAT_NEWARRAY(LTFAT_NAME(nsdgtreal_group), N) );
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECKNULL(g[n]);
+        CHECK(LTFATERR_BADSIZE, gl[n] > 0, "gl[%td] (passed %td) must be positive.", n, gl[n]);
+        CHECK(LTFATERR_NOTPOSARG, a[n] > 0, "a[%td] (passed %td) must be positive.", n, a[n]);
+        CHECK(LTFATERR_NOTPOSARG, M[n] > 0, "M[%td] (passed %td) must be positive.", n, M[n]);
+
+        p->g[n] = g[n]; p->gl[n] = gl[n]; p->M[n] = M[n];
+        // timepos = cumsum(a) - a(1) as in nsdgt.m
+        p->timepos[n] = n > 0 ? p->timepos[n - 1] + a[n] : 0;
+        p->L += a[n];
+        p->coff[n] = n > 0 ? p->coff[n - 1] + (M[n - 1] / 2 + 1) * W : 0;
+
+        p->grp[n] = -1;
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+            if (p->groups[k].M == M[n]) { p->grp[n] = k; break; }
+
+        if (p->grp[n] < 0)
+        {
+            p->grp[n] = p->ngrp;
+            p->groups[p->ngrp++].M = M[n];
+        }
+        p->slot[n] = p->groups[p->grp[n]].N++;
+    }
+
+    for (ltfat_int n = 0; n < N; n++)
+        CHECK(LTFATERR_BADREQSIZE, gl[n] <= p->L,
+              "Window %td is longer than L=sum(a) (passed gl=%td, L=%td).", n, gl[n], p->L);
+
+    for (ltfat_int k = 0; k < p->ngrp; k++)
+    {
+        LTFAT_NAME(nsdgtreal_group)* gr = &p->groups[k];
+        ltfat_int howmany = gr->N * W;
+
+        CHECKMEM( gr->fbuf = LTFAT_NAME_REAL(malloc)(gr->M * howmany) );
+        CHECKMEM( gr->cbuf = LTFAT_NAME_COMPLEX(malloc)((gr->M / 2 + 1) * howmany) );
+
+        if (tradir == LTFAT_FORWARD)
+            CHECKSTATUS(
+                LTFAT_NAME(fftreal_init)(gr->M, howmany, gr->fbuf, gr->cbuf,
+                                         flags, &gr->fwd));
+        else
+            CHECKSTATUS(
+                LTFAT_NAME(ifftreal_init)(gr->M, howmany, gr->cbuf, gr->fbuf,
+                                          flags, &gr->inv));
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(nsdgtreal_done_priv)(p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+/* Fold the windowed signal around the frame center into M samples.
+ * The window is stored with its center at index 0. */
+static void
+LTFAT_NAME(nsdgtreal_window)(const LTFAT_REAL f[], ltfat_int L,
+                             const LTFAT_REAL g[], ltfat_int gl,
+                             ltfat_int timepos, ltfat_int M, LTFAT_REAL out[])
+{
+    ltfat_int h = gl / 2;
+    ltfat_int fidx = ltfat_positiverem(timepos - h, L);
+    ltfat_int oidx = ltfat_positiverem(-h, M);
+    ltfat_int gidx = ltfat_positiverem(-h, gl);
+
+    LTFAT_NAME_REAL(clear_array)(out, M);
+
+    for (ltfat_int k = 0; k < gl; k++)
+    {
+        out[oidx] += f[fidx] * g[gidx];
+        if (++fidx == L) fidx = 0;
+        if (++oidx == M) oidx = 0;
+        if (++gidx == gl) gidx = 0;
+    }
+}
+
+static void
+LTFAT_NAME(nsdgtreal_overlapadd)(const LTFAT_REAL in[], ltfat_int M,
+                                 const LTFAT_REAL g[], ltfat_int gl,
+                                 ltfat_int timepos, ltfat_int L, LTFAT_REAL f[])
+{
+    ltfat_int h = gl / 2;
+    ltfat_int fidx = ltfat_positiverem(timepos - h, L);
+    ltfat_int iidx = ltfat_positiverem(-h, M);
+    ltfat_int gidx = ltfat_positiverem(-h, gl);
+
+    for (ltfat_int k = 0; k < gl; k++)
+    {
+        f[fidx] += in[iidx] * g[gidx];
+        if (++fidx == L) fidx = 0;
+        if (++iidx == M) iidx = 0;
+        if (++gidx == gl) gidx = 0;
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_init)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[],
+                           ltfat_int N, ltfat_int W, unsigned flags,
+                           LTFAT_NAME(nsdgtreal_plan)** p)
+{
+    return LTFAT_NAME(nsdgtreal_init_priv)(g, gl, a, M, N, W, flags,
+                                           LTFAT_FORWARD, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_execute)(LTFAT_NAME(nsdgtreal_plan)* p,
+                              const LTFAT_REAL f[], LTFAT_COMPLEX c[])
+{
+    ltfat_int N, W;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    CHECK(LTFATERR_BADARG, p->groups[0].fwd, "Not a nsdgtreal plan.");
+    N = p->N; W = p->W;
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(p->nthreads)
+#endif
+    {
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (ltfat_int nw = 0; nw < N * W; nw++)
+        {
+            ltfat_int n = nw / W, w = nw % W;
+            LTFAT_NAME(nsdgtreal_group)* gr = &p->groups[p->grp[n]];
+            LTFAT_NAME(nsdgtreal_window)(f + w * p->L, p->L, p->g[n], p->gl[n],
+                                         p->timepos[n], p->M[n],
+                                         gr->fbuf + (p->slot[n] * W + w) * gr->M);
+        }
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+            LTFAT_NAME(fftreal_execute)(p->groups[k].fwd);
+
+#ifdef _OPENMP
+        #pragma omp for
+#endif
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            LTFAT_NAME(nsdgtreal_group)* gr = &p->groups[p->grp[n]];
+            ltfat_int M2 = gr->M / 2 + 1;
+            memcpy(c + p->coff[n], gr->cbuf + p->slot[n] * W * M2,
+                   M2 * W * sizeof * c);
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal)(const LTFAT_REAL f[], const LTFAT_REAL* g[],
+                      const ltfat_int gl[], const ltfat_int a[],
+                      const ltfat_int M[], ltfat_int N, ltfat_int W,
+                      LTFAT_COMPLEX c[])
+{
+    LTFAT_NAME(nsdgtreal_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(nsdgtreal_init)(g, gl, a, M, N, W, FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(nsdgtreal_execute)(p, f, c));
+
+error:
+    if (p) LTFAT_NAME(nsdgtreal_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal_init)(const LTFAT_REAL* gd[], const ltfat_int gl[],
+                            const ltfat_int a[], const ltfat_int M[],
+                            ltfat_int N, ltfat_int W, unsigned flags,
+                            LTFAT_NAME(insdgtreal_plan)** p)
+{
+    return LTFAT_NAME(nsdgtreal_init_priv)(gd, gl, a, M, N, W, flags,
+                                           LTFAT_INVERSE, p);
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal_execute)(LTFAT_NAME(insdgtreal_plan)* p,
+                               const LTFAT_COMPLEX c[], LTFAT_REAL f[])
+{
+    ltfat_int N, W;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(f);
+    CHECK(LTFATERR_BADARG, p->groups[0].inv, "Not an insdgtreal plan.");
+    N = p->N; W = p->W;
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(p->nthreads)
+#endif
+    {
+#ifdef _OPENMP
+        #pragma omp for
+#endif
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            LTFAT_NAME(nsdgtreal_group)* gr = &p->groups[p->grp[n]];
+            ltfat_int M2 = gr->M / 2 + 1;
+            memcpy(gr->cbuf + p->slot[n] * W * M2, c + p->coff[n],
+                   M2 * W * sizeof * c);
+        }
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic)
+#endif
+        for (ltfat_int k = 0; k < p->ngrp; k++)
+            LTFAT_NAME(ifftreal_execute)(p->groups[k].inv);
+
+        // Frames overlap, the channels do not
+#ifdef _OPENMP
+        #pragma omp for
+#endif
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            LTFAT_NAME_REAL(clear_array)(f + w * p->L, p->L);
+
+            for (ltfat_int n = 0; n < N; n++)
+            {
+                LTFAT_NAME(nsdgtreal_group)* gr = &p->groups[p->grp[n]];
+                LTFAT_NAME(nsdgtreal_overlapadd)(
+                    gr->fbuf + (p->slot[n] * W + w) * gr->M, gr->M,
+                    p->g[n], p->gl[n], p->timepos[n], p->L, f + w * p->L);
+            }
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal)(const LTFAT_COMPLEX c[], const LTFAT_REAL* gd[],
+                       const ltfat_int gl[], const ltfat_int a[],
+                       const ltfat_int M[], ltfat_int N, ltfat_int W,
+                       LTFAT_REAL f[])
+{
+    LTFAT_NAME(insdgtreal_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+
+    CHECKSTATUS( LTFAT_NAME(insdgtreal_init)(gd, gl, a, M, N, W, FFTW_ESTIMATE, &p));
+    CHECKSTATUS( LTFAT_NAME(insdgtreal_execute)(p, c, f));
+
+error:
+    if (p) LTFAT_NAME(insdgtreal_done)(&p);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_set_nthreads)(LTFAT_NAME(nsdgtreal_plan)* p,
+                                   ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+    p->nthreads = nthreads;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(nsdgtreal_get_L)(LTFAT_NAME(nsdgtreal_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->L;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(nsdgtreal_get_coeflen)(LTFAT_NAME(nsdgtreal_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->coff[p->N - 1] + (p->M[p->N - 1] / 2 + 1) * p->W;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsdgtreal_done)(LTFAT_NAME(nsdgtreal_plan)** p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    LTFAT_NAME(nsdgtreal_done_priv)(*p);
+    *p = NULL;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(insdgtreal_done)(LTFAT_NAME(insdgtreal_plan)** p)
+{
+    return LTFAT_NAME(nsdgtreal_done)(p);
+}
+
+/* Painless case: the frame operator is a multiplication by
+ * d(x) = sum_n M[n]*|g_n(x - timepos[n])|^2 */
+static int
+LTFAT_NAME(nsgab_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                           const ltfat_int a[], const ltfat_int M[],
+                           ltfat_int N, int tight, LTFAT_REAL* gd[])
+{
+    LTFAT_REAL* d = NULL;
+    ltfat_int L = 0, timepos = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a); CHECKNULL(M); CHECKNULL(gd);
+    CHECK(LTFATERR_NOTPOSARG, N > 0, "N (passed %td) must be positive.", N);
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        CHECKNULL(g[n]); CHECKNULL(gd[n]);
+        CHECK(LTFATERR_BADSIZE, gl[n] > 0, "gl[%td] (passed %td) must be positive.", n, gl[n]);
+        CHECK(LTFATERR_NOTPOSARG, a[n] > 0, "a[%td] (passed %td) must be positive.", n, a[n]);
+        CHECK(LTFATERR_NOTPAINLESS, M[n] >= gl[n],
+              "Not painless. Check if M[%td]>=gl[%td] (passed M=%td, gl=%td)", n, n, M[n], gl[n]);
+        L += a[n];
+    }
+
+    CHECKMEM( d = LTFAT_NAME_REAL(calloc)(L) );
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        if (n > 0) timepos += a[n];
+        ltfat_int h = gl[n] / 2;
+        ltfat_int didx = ltfat_positiverem(timepos - h, L);
+        ltfat_int gidx = ltfat_positiverem(-h, gl[n]);
+
+        for (ltfat_int k = 0; k < gl[n]; k++)
+        {
+            d[didx] += M[n] * g[n][gidx] * g[n][gidx];
+            if (++didx == L) didx = 0;
+            if (++gidx == gl[n]) gidx = 0;
+        }
+    }
+
+    for (ltfat_int x = 0; x < L; x++)
+    {
+        CHECK(LTFATERR_NOTAFRAME, d[x] > 0,
+              "Not a frame. The windows do not cover sample %td.", x);
+        if (tight) d[x] = sqrt(d[x]);
+    }
+
+    timepos = 0;
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        if (n > 0) timepos += a[n];
+        ltfat_int h = gl[n] / 2;
+        ltfat_int didx = ltfat_positiverem(timepos - h, L);
+        ltfat_int gidx = ltfat_positiverem(-h, gl[n]);
+
+        for (ltfat_int k = 0; k < gl[n]; k++)
+        {
+            gd[n][gidx] = g[n][gidx] / d[didx];
+            if (++didx == L) didx = 0;
+            if (++gidx == gl[n]) gidx = 0;
+        }
+    }
+
+error:
+    LTFAT_SAFEFREEALL(d);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(nsgabdual_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                               const ltfat_int a[], const ltfat_int M[],
+                               ltfat_int N, LTFAT_REAL* gd[])
+{
+    return LTFAT_NAME(nsgab_painless)(g, gl, a, M, N, 0, gd);
+}
+
+LTFAT_API int
+LTFAT_NAME(nsgabtight_painless)(const LTFAT_REAL* g[], const ltfat_int gl[],
+                                const ltfat_int a[], const ltfat_int M[],
+                                ltfat_int N, LTFAT_REAL* gt[])
+{
+    return LTFAT_NAME(nsgab_painless)(g, gl, a, M, N, 1, gt);
+}
@@ -0,0 +1,401 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#include "ltfat/thirdparty/fftw3.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Scratch space of one thread. The FFT plans are not shared between
+ * threads because the FFT backends may use plan-owned buffers. */
+typedef struct
+{
+    LTFAT_NAME(fft_plan)* fft;
+    LTFAT_COMPLEX* buf;
+    LTFAT_COMPLEX* buf2;
+} LTFAT_NAME(quadtfdist_thread);
+
+struct LTFAT_NAME(quadtfdist_plan)
+{
+    ltfat_int L;
+    ltfat_quadtfdist_type type;
+    ltfat_int tilelen;
+    unsigned flags;
+    ltfat_int nthreads;
+    LTFAT_NAME(quadtfdist_thread)* th;
+    LTFAT_NAME(ifft_plan)* ifft;
+    LTFAT_COMPLEX* z1;
+    LTFAT_COMPLEX* z2;
+    LTFAT_COMPLEX* expt;     //!< exp(-2*pi*i*k/L), Rihaczek only
+    LTFAT_COMPLEX* tile;     //!< L x tilelen
+    LTFAT_NAME(quadtfdist_callback)* callback;
+    void* userdata;
+};
+
+static void
+LTFAT_NAME(quadtfdist_thread_done)(LTFAT_NAME(quadtfdist_thread)* th)
+{
+    if (th->fft) LTFAT_NAME(fft_done)(&th->fft);
+    LTFAT_SAFEFREEALL(th->buf, th->buf2);
+}
+
+static int
+LTFAT_NAME(quadtfdist_thread_init)(ltfat_int L, unsigned flags,
+                                   LTFAT_NAME(quadtfdist_thread)* th)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKMEM( th->buf = LTFAT_NAME_COMPLEX(malloc)(L) );
+    CHECKMEM( th->buf2 = LTFAT_NAME_COMPLEX(malloc)(L) );
+    CHECKSTATUS( LTFAT_NAME(fft_init)(L, 1, th->buf, th->buf2, flags, &th->fft));
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist_init)(ltfat_int L, ltfat_quadtfdist_type type,
+                            ltfat_int tilelen, unsigned flags,
+                            LTFAT_NAME(quadtfdist_plan)** pout)
+{
+    LTFAT_NAME(quadtfdist_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, tilelen > 0, "tilelen (passed %td) must be positive.", tilelen);
+    CHECK(LTFATERR_BADARG, type == LTFAT_WIGNERVILLE || type == LTFAT_RIHACZEK ||
+          type == LTFAT_AMBIGUITY, "Unknown distribution type.");
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(quadtfdist_plan)) );
+    p->L = L; p->type = type; p->tilelen = ltfat_imin(tilelen, L);
+    p->flags = flags; p->nthreads = 1;
+
+    CHECKMEM( p->th = LTFAT_NEW(LTFAT_NAME(quadtfdist_thread)) );
+    CHECKSTATUS( LTFAT_NAME(quadtfdist_thread_init)(L, flags, p->th));
+
+    CHECKMEM( p->z1 = LTFAT_NAME_COMPLEX(malloc)(L) );
+    CHECKMEM( p->z2 = LTFAT_NAME_COMPLEX(malloc)(L) );
+    CHECKMEM( p->tile = LTFAT_NAME_COMPLEX(malloc)(L * p->tilelen) );
+    CHECKSTATUS( LTFAT_NAME(ifft_init)(L, 1, p->z1, p->z1, flags, &p->ifft));
+
+    if (type == LTFAT_RIHACZEK)
+    {
+        CHECKMEM( p->expt = LTFAT_NAME_COMPLEX(malloc)(L) );
+        for (ltfat_int k = 0; k < L; k++)
+            p->expt[k] = exp(-I * (LTFAT_REAL) (2.0 * M_PI * k / L));
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(quadtfdist_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist_set_nthreads)(LTFAT_NAME(quadtfdist_plan)* p,
+                                    ltfat_int nthreads)
+{
+    LTFAT_NAME(quadtfdist_thread)* th = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+
+#ifdef _OPENMP
+    if (nthreads == p->nthreads) return status;
+
+    CHECKMEM( th = LTFAT_NEWARRAY(LTFAT_NAME(quadtfdist_thread), nthreads) );
+    for (ltfat_int t = 0; t < nthreads; t++)
+        CHECKSTATUS( LTFAT_NAME(quadtfdist_thread_init)(p->L, p->flags, &th[t]));
+
+    for (ltfat_int t = 0; t < p->nthreads; t++)
+        LTFAT_NAME(quadtfdist_thread_done)(&p->th[t]);
+    ltfat_free(p->th);
+
+    p->th = th;
+    p->nthreads = nthreads;
+#endif
+
+    return status;
+error:
+    if (th)
+    {
+        for (ltfat_int t = 0; t < nthreads; t++)
+            LTFAT_NAME(quadtfdist_thread_done)(&th[t]);
+        ltfat_free(th);
+    }
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist_setcallback)(LTFAT_NAME(quadtfdist_plan)* p,
+                                   LTFAT_NAME(quadtfdist_callback)* callback,
+                                   void* userdata)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    p->callback = callback;
+    p->userdata = userdata;
+error:
+    return status;
+}
+
+/* Lag m row of the instantaneous correlation matrix is nonzero at time l
+ * only for |m| <= min(L - l, l, round(L/2) - 1), see comp_instcorrmat. */
+static inline ltfat_int
+LTFAT_NAME(quadtfdist_maxlag)(ltfat_int L, ltfat_int l)
+{
+    return ltfat_imin(ltfat_imin(L - l, l), (L + 1) / 2 - 1);
+}
+
+/* Column l of the Wigner-Ville distribution */
+static void
+LTFAT_NAME(quadtfdist_wvslice)(LTFAT_NAME(quadtfdist_plan)* p,
+                               LTFAT_NAME(quadtfdist_thread)* th,
+                               ltfat_int l, int isauto, LTFAT_COMPLEX out[])
+{
+    ltfat_int L = p->L;
+    ltfat_int K = LTFAT_NAME(quadtfdist_maxlag)(L, l);
+    LTFAT_COMPLEX* R = th->buf;
+
+    LTFAT_NAME_COMPLEX(clear_array)(R, L);
+
+    R[0] = p->z1[l] * conj(p->z2[l]);
+    for (ltfat_int m = 1; m <= K; m++)
+    {
+        ltfat_int lp = l + m == L ? 0 : l + m;
+        R[m] = p->z1[lp] * conj(p->z2[l - m]);
+        R[L - m] = p->z1[l - m] * conj(p->z2[lp]);
+    }
+
+    LTFAT_NAME(fft_execute_newarray)(th->fft, R, th->buf2);
+
+    if (isauto)
+        for (ltfat_int k = 0; k < L; k++)
+            out[k] = ltfat_real(th->buf2[k]);
+    else
+        memcpy(out, th->buf2, L * sizeof * out);
+}
+
+/* Row i of the ambiguity function. It is the L-multiple of the DFT of
+ * lag row -u of the instantaneous correlation matrix, fftshifted in
+ * both dimensions. */
+static void
+LTFAT_NAME(quadtfdist_ambslice)(LTFAT_NAME(quadtfdist_plan)* p,
+                                LTFAT_NAME(quadtfdist_thread)* th,
+                                ltfat_int i, LTFAT_COMPLEX out[])
+{
+    ltfat_int L = p->L, H = L / 2;
+    ltfat_int jj = ltfat_positiverem(H - i, L);
+    ltfat_int m = jj <= (L + 1) / 2 - 1 ? jj : jj - L;
+    ltfat_int mabs = m < 0 ? -m : m;
+    LTFAT_COMPLEX* r = th->buf;
+
+    if (mabs > (L + 1) / 2 - 1)
+    {
+        LTFAT_NAME_COMPLEX(clear_array)(out, L);
+        return;
+    }
+
+    LTFAT_NAME_COMPLEX(clear_array)(r, L);
+
+    // |m| <= min(L - l, l)
+    for (ltfat_int l = mabs; l <= L - mabs && l < L; l++)
+    {
+        ltfat_int lp = ltfat_positiverem(l + m, L);
+        r[l] = (LTFAT_REAL) L * p->z1[lp] * conj(p->z2[l - m == L ? 0 : l - m]);
+    }
+
+    LTFAT_NAME(fft_execute_newarray)(th->fft, r, th->buf2);
+
+    for (ltfat_int k = 0; k < L; k++)
+        out[k] = th->buf2[ltfat_positiverem(k - H, L)];
+}
+
+/* Column n of the Rihaczek distribution, z2 holds conj(fft(g)) */
+static void
+LTFAT_NAME(quadtfdist_rihslice)(LTFAT_NAME(quadtfdist_plan)* p,
+                                ltfat_int n, LTFAT_COMPLEX out[])
+{
+    ltfat_int L = p->L, idx = 0;
+    LTFAT_COMPLEX fn = p->z1[n];
+
+    for (ltfat_int m = 0; m < L; m++)
+    {
+        out[m] = fn * p->z2[m] * p->expt[idx];
+        idx += n;
+        if (idx >= L) idx -= L;
+    }
+}
+
+static int
+LTFAT_NAME(quadtfdist_run)(LTFAT_NAME(quadtfdist_plan)* p, int isauto)
+{
+    ltfat_int L = p->L;
+
+    if (p->type == LTFAT_RIHACZEK)
+    {
+        LTFAT_NAME(fft_execute_newarray)(p->th->fft, p->z2, p->th->buf2);
+        LTFAT_NAME_COMPLEX(conjugate_array)(p->th->buf2, L, p->z2);
+    }
+
+    for (ltfat_int start = 0; start < L; start += p->tilelen)
+    {
+        ltfat_int len = ltfat_imin(p->tilelen, L - start);
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) num_threads(ltfat_imin(p->nthreads, len))
+#endif
+        for (ltfat_int s = 0; s < len; s++)
+        {
+#ifdef _OPENMP
+            LTFAT_NAME(quadtfdist_thread)* th = &p->th[omp_get_thread_num()];
+#else
+            LTFAT_NAME(quadtfdist_thread)* th = p->th;
+#endif
+            LTFAT_COMPLEX* out = p->tile + s * L;
+
+            switch (p->type)
+            {
+            case LTFAT_WIGNERVILLE:
+                LTFAT_NAME(quadtfdist_wvslice)(p, th, start + s, isauto, out);
+                break;
+            case LTFAT_AMBIGUITY:
+                LTFAT_NAME(quadtfdist_ambslice)(p, th, start + s, out);
+                break;
+            case LTFAT_RIHACZEK:
+                LTFAT_NAME(quadtfdist_rihslice)(p, start + s, out);
+                break;
+            }
+        }
+
+        if (p->callback)
+            p->callback(p->userdata, p->tile, L, start, len);
+    }
+
+    return LTFATERR_SUCCESS;
+}
+
+/* Analytic signal as in comp_fftanalytic */
+static void
+LTFAT_NAME(quadtfdist_analytic)(LTFAT_NAME(quadtfdist_plan)* p,
+                                const LTFAT_REAL f[], LTFAT_COMPLEX z[])
+{
+    ltfat_int L = p->L, H = L / 2;
+    LTFAT_COMPLEX* buf = p->th->buf;
+
+    for (ltfat_int l = 0; l < L; l++)
+        buf[l] = f[l];
+
+    LTFAT_NAME(fft_execute_newarray)(p->th->fft, buf, z);
+
+    for (ltfat_int k = 1; k < L - H; k++)
+        z[k] *= (LTFAT_REAL) 2.0 / (LTFAT_REAL) L;
+    z[0] /= (LTFAT_REAL) L;
+    if (H + 1 <= L - 1)
+        LTFAT_NAME_COMPLEX(clear_array)(z + H + 1, L - H - 1);
+    if (!(L % 2))
+        z[H] /= (LTFAT_REAL) L;
+
+    LTFAT_NAME(ifft_execute_newarray)(p->ifft, z, z);
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist_execute)(LTFAT_NAME(quadtfdist_plan)* p,
+                               const LTFAT_COMPLEX f[], const LTFAT_COMPLEX g[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f);
+
+    memcpy(p->z1, f, p->L * sizeof * p->z1);
+    memcpy(p->z2, g ? g : f, p->L * sizeof * p->z2);
+
+    status = LTFAT_NAME(quadtfdist_run)(p, g == NULL);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist_execute_real)(LTFAT_NAME(quadtfdist_plan)* p,
+                                    const LTFAT_REAL f[], const LTFAT_REAL g[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f);
+
+    if (p->type == LTFAT_RIHACZEK)
+    {
+        for (ltfat_int l = 0; l < p->L; l++)
+        {
+            p->z1[l] = f[l];
+            p->z2[l] = g ? g[l] : f[l];
+        }
+    }
+    else
+    {
+        LTFAT_NAME(quadtfdist_analytic)(p, f, p->z1);
+        if (g)
+            LTFAT_NAME(quadtfdist_analytic)(p, g, p->z2);
+        else
+            memcpy(p->z2, p->z1, p->L * sizeof * p->z2);
+    }
+
+    status = LTFAT_NAME(quadtfdist_run)(p, g == NULL);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist_done)(LTFAT_NAME(quadtfdist_plan)** p)
+{
+    LTFAT_NAME(quadtfdist_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->th)
+        for (ltfat_int t = 0; t < pp->nthreads; t++)
+            LTFAT_NAME(quadtfdist_thread_done)(&pp->th[t]);
+
+    if (pp->ifft) LTFAT_NAME(ifft_done)(&pp->ifft);
+    LTFAT_SAFEFREEALL(pp->th, pp->z1, pp->z2, pp->expt, pp->tile);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+typedef struct
+{
+    LTFAT_COMPLEX* out;
+} LTFAT_NAME(quadtfdist_collect);
+
+static void
+LTFAT_NAME(quadtfdist_collect_callback)(void* userdata, const LTFAT_COMPLEX tile[],
+                                        ltfat_int L, ltfat_int start, ltfat_int len)
+{
+    LTFAT_NAME(quadtfdist_collect)* c = (LTFAT_NAME(quadtfdist_collect)*) userdata;
+    memcpy(c->out + start * L, tile, L * len * sizeof * tile);
+}
+
+LTFAT_API int
+LTFAT_NAME(quadtfdist)(const LTFAT_COMPLEX f[], const LTFAT_COMPLEX g[],
+                       ltfat_int L, ltfat_quadtfdist_type type,
+                       LTFAT_COMPLEX out[])
+{
+    LTFAT_NAME(quadtfdist_plan)* p = NULL;
+    LTFAT_NAME(quadtfdist_collect) c;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(out);
+    c.out = out;
+
+    // The tile is copied to out so it can be small
+    CHECKSTATUS( LTFAT_NAME(quadtfdist_init)(L, type, 64, FFTW_ESTIMATE, &p));
+    LTFAT_NAME(quadtfdist_setcallback)(p, LTFAT_NAME(quadtfdist_collect_callback), &c);
+    CHECKSTATUS( LTFAT_NAME(quadtfdist_execute)(p, f, g));
+
+error:
+    if (p) LTFAT_NAME(quadtfdist_done)(&p);
+    return status;
+}
@@ -1,54 +1,262 @@
 #include "ltfat.h"
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
-#include "ltfat/reassign_typeconstant.h"
-
+#include "reassign_private.h"
+
+/* The coefficients are traversed in storage order. Since the reassigned
+ * positions are close to the original ones, the scatter targets then stay in
+ * a narrow band of columns which fits into the cache.
+ *
+ * With more threads, each thread gets a contiguous range of columns and
+ * accumulates into its own output tile spanning only the columns its
+ * coefficients were moved to. The tiles are summed at the end.
+ * */
+struct LTFAT_NAME(gabreassign_plan)
+{
+    ltfat_int a;
+    ltfat_int M;
+    ltfat_int N;
+    ltfat_int W;
+    ltfat_int b;
+    ltfat_int* timepos;
+    ltfat_int* freqpos;
+    ltfat_int nthreads;
+    ltfat_int* idx;      //!< Target position relative to the tile, M x N, only if nthreads > 1
+    LTFAT_TYPE** tiles;  //!< Per-thread output tiles
+    ltfat_int* tilecap;  //!< Allocated number of columns of each tile
+    ltfat_int* tilelo;   //!< First tile column relative to the first column of the thread
+    ltfat_int* tilehi;   //!< Last tile column relative to the first column of the thread
+};
 
 LTFAT_API void
 LTFAT_NAME(gabreassign)(const LTFAT_TYPE* s, const LTFAT_REAL* tgrad,
                         const LTFAT_REAL* fgrad, ltfat_int L, ltfat_int W,
                         ltfat_int a, ltfat_int M, LTFAT_TYPE* sr)
 {
+    LTFAT_NAME(gabreassign_plan)* p = NULL;
 
-    ltfat_int ii, posi, posj;
+    if (LTFAT_NAME(gabreassign_init)(L, W, a, M, 1, &p) == LTFATERR_SUCCESS)
+        LTFAT_NAME(gabreassign_execute)(p, s, tgrad, fgrad, sr);
 
+    if (p) LTFAT_NAME(gabreassign_done)(&p);
+}
+
+LTFAT_API int
+LTFAT_NAME(gabreassign_init)(ltfat_int L, ltfat_int W, ltfat_int a,
+                             ltfat_int M, ltfat_int nthreads,
+                             LTFAT_NAME(gabreassign_plan)** pout)
+{
+    LTFAT_NAME(gabreassign_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_NOTPOSARG, a > 0, "a (passed %td) must be positive.", a);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+    CHECK(LTFATERR_BADTRALEN, !(L % a) && !(L % M),
+          "L (passed %td) must be divisible by both a (passed %td) and M (passed %td).",
+          L, a, M);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(gabreassign_plan)) );
+    p->a = a; p->M = M; p->N = L / a; p->W = W; p->b = L / M;
+
+#ifdef _OPENMP
+    p->nthreads = ltfat_imin(nthreads, p->N);
+#else
+    p->nthreads = 1;
+#endif
+
+    CHECKMEM( p->timepos = LTFAT_NEWARRAY(ltfat_int, p->N) );
+    CHECKMEM( p->freqpos = LTFAT_NEWARRAY(ltfat_int, M) );
+    ltfat_fftindex(p->N, p->timepos);
+    ltfat_fftindex(M, p->freqpos);
+
+    if (p->nthreads > 1)
+    {
+        CHECKMEM( p->idx = LTFAT_NEWARRAY(ltfat_int, M * p->N) );
+        CHECKMEM( p->tiles = LTFAT_NEWARRAY(LTFAT_TYPE*, p->nthreads) );
+        CHECKMEM( p->tilecap = LTFAT_NEWARRAY(ltfat_int, p->nthreads) );
+        CHECKMEM( p->tilelo = LTFAT_NEWARRAY(ltfat_int, p->nthreads) );
+        CHECKMEM( p->tilehi = LTFAT_NEWARRAY(ltfat_int, p->nthreads) );
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(gabreassign_done)(&p);
+    return status;
+}
 
-    ltfat_int N = L / a;
-    ltfat_int b = L / M;
+static void
+LTFAT_NAME(gabreassign_execute_serial)(LTFAT_NAME(gabreassign_plan)* p,
+                                       const LTFAT_TYPE s[],
+                                       const LTFAT_REAL tgrad[],
+                                       const LTFAT_REAL fgrad[], LTFAT_TYPE sr[])
+{
+    ltfat_int M = p->M, N = p->N;
 
-    ltfat_int* timepos = (ltfat_int*) ltfat_malloc(N * sizeof * timepos);
-    ltfat_int* freqpos = (ltfat_int*) ltfat_malloc(M * sizeof * freqpos);
+    LTFAT_NAME(clear_array)(sr, M * N);
 
-    ltfat_fftindex(N, timepos);
-    ltfat_fftindex(M, freqpos);
+    for (ltfat_int jj = 0; jj < N; jj++)
+    {
+        for (ltfat_int ii = 0; ii < M; ii++)
+        {
+            ltfat_int pos = ii + jj * M;
+            ltfat_int posi = ltfat_positiverem(ltfat_round(tgrad[pos] / p->b + p->freqpos[ii]), M);
+            ltfat_int posj = ltfat_positiverem(ltfat_round(fgrad[pos] / p->a + p->timepos[jj]), N);
 
-    /* Zero the output array. */
-    LTFAT_NAME(clear_array)( sr, M * N * W);
-    //memset(sr, 0, M * N * W * sizeof * sr);
+            sr[posi + posj * M] += s[pos];
+        }
+    }
+}
 
-    for (ltfat_int w = 0; w < W; w++)
+static int
+LTFAT_NAME(gabreassign_execute_parallel)(LTFAT_NAME(gabreassign_plan)* p,
+                                         const LTFAT_TYPE s[],
+                                         const LTFAT_REAL tgrad[],
+                                         const LTFAT_REAL fgrad[], LTFAT_TYPE sr[])
+{
+    ltfat_int M = p->M, N = p->N, T = p->nthreads, Nhalf = N / 2;
+    int status = LTFATERR_SUCCESS;
+
+    // Target positions and the extent of the tiles
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(T)
+#endif
+    for (ltfat_int t = 0; t < T; t++)
     {
-        for (ii = 0; ii < M; ii++)
+        ltfat_int j0 = t * N / T, j1 = (t + 1) * N / T;
+        ltfat_int lo = N, hi = -N;
+
+        for (ltfat_int jj = j0; jj < j1; jj++)
         {
-            for (ltfat_int jj = 0; jj < N; jj++)
+            for (ltfat_int ii = 0; ii < M; ii++)
             {
-                /* Do a 'round' followed by a 'mod'. 'round' is not
-                 * present in all libraries, so use trunc(x+.5) instead */
-                /*posi=ltfat_positiverem((ltfat_int)trunc(tgrad[ii+jj*M]/b+freqpos[ii]+.5),M);
-                  posj=ltfat_positiverem((ltfat_int)trunc(fgrad[ii+jj*M]/a+timepos[jj]+.5),N);*/
-                posi = ltfat_positiverem(ltfat_round(tgrad[ii + jj * M] / b + freqpos[ii]), M);
-                posj = ltfat_positiverem(ltfat_round(fgrad[ii + jj * M] / a + timepos[jj]), N);
-
-                sr[posi + posj * M] += s[ii + jj * M];
+                ltfat_int pos = ii + jj * M;
+                ltfat_int posi = ltfat_positiverem(ltfat_round(tgrad[pos] / p->b + p->freqpos[ii]), M);
+                ltfat_int posj = ltfat_positiverem(ltfat_round(fgrad[pos] / p->a + p->timepos[jj]), N);
+                // Column relative to j0 in range [-N/2, N - N/2)
+                ltfat_int rel = ltfat_positiverem(posj - j0 + Nhalf, N) - Nhalf;
+
+                if (rel < lo) lo = rel;
+                if (rel > hi) hi = rel;
+                p->idx[pos] = posi + rel * M;
             }
         }
+        p->tilelo[t] = lo; p->tilehi[t] = hi;
     }
 
-    LTFAT_SAFEFREEALL(freqpos, timepos);
+    for (ltfat_int t = 0; t < T; t++)
+    {
+        ltfat_int ncols = p->tilehi[t] - p->tilelo[t] + 1;
+        if (ncols > p->tilecap[t])
+        {
+            ltfat_safefree(p->tiles[t]);
+            CHECKMEM( p->tiles[t] = LTFAT_NAME(malloc)(M * ncols) );
+            p->tilecap[t] = ncols;
+        }
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(T)
+#endif
+    {
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (ltfat_int t = 0; t < T; t++)
+        {
+            ltfat_int j0 = t * N / T, j1 = (t + 1) * N / T;
+            ltfat_int off = p->tilelo[t] * M;
+            LTFAT_TYPE* tile = p->tiles[t];
+
+            LTFAT_NAME(clear_array)(tile, M * (p->tilehi[t] - p->tilelo[t] + 1));
+
+            for (ltfat_int pos = j0 * M; pos < j1 * M; pos++)
+                tile[p->idx[pos] - off] += s[pos];
+        }
+
+        // Every output column collects the tiles covering it
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (ltfat_int jj = 0; jj < N; jj++)
+        {
+            LTFAT_TYPE* srcol = sr + jj * M;
+            LTFAT_NAME(clear_array)(srcol, M);
+
+            for (ltfat_int t = 0; t < T; t++)
+            {
+                ltfat_int j0 = t * N / T;
+                ltfat_int rel = ltfat_positiverem(jj - j0 + Nhalf, N) - Nhalf;
+
+                if (rel >= p->tilelo[t] && rel <= p->tilehi[t])
+                {
+                    const LTFAT_TYPE* tcol = p->tiles[t] + (rel - p->tilelo[t]) * M;
+                    for (ltfat_int ii = 0; ii < M; ii++)
+                        srcol[ii] += tcol[ii];
+                }
+            }
+        }
+    }
+
+error:
+    return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(gabreassign_execute)(LTFAT_NAME(gabreassign_plan)* p,
+                                const LTFAT_TYPE s[], const LTFAT_REAL tgrad[],
+                                const LTFAT_REAL fgrad[], LTFAT_TYPE sr[])
+{
+    ltfat_int MN;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(s); CHECKNULL(tgrad); CHECKNULL(fgrad); CHECKNULL(sr);
+    MN = p->M * p->N;
+
+    for (ltfat_int w = 0; w < p->W; w++)
+    {
+        if (p->nthreads > 1)
+            CHECKSTATUS(
+                LTFAT_NAME(gabreassign_execute_parallel)(p, s + w * MN, tgrad + w * MN,
+                        fgrad + w * MN, sr + w * MN));
+        else
+            LTFAT_NAME(gabreassign_execute_serial)(p, s + w * MN, tgrad + w * MN,
+                                                   fgrad + w * MN, sr + w * MN);
+    }
+
+error:
+    return status;
+}
 
+LTFAT_API int
+LTFAT_NAME(gabreassign_done)(LTFAT_NAME(gabreassign_plan)** p)
+{
+    LTFAT_NAME(gabreassign_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->tiles)
+        for (ltfat_int t = 0; t < pp->nthreads; t++)
+            ltfat_safefree(pp->tiles[t]);
+
+    LTFAT_SAFEFREEALL(pp->timepos, pp->freqpos, pp->idx, pp->tiles,
+                      pp->tilecap, pp->tilelo, pp->tilehi);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
 
+/* The expensive part of the filterbank reassignment is finding the channel
+ * for every coefficient. The target indices are computed for all channels
+ * at once (possibly in parallel) into index tables kept by the plan. The
+ * accumulation is done afterwards in the original order, so the results and
+ * the optional repos output do not depend on the number of threads.
+ * */
 LTFAT_API void
 LTFAT_NAME(filterbankreassign)(const LTFAT_TYPE* s[],
                                const LTFAT_REAL* tgrad[],
@@ -58,6 +266,73 @@ LTFAT_NAME(filterbankreassign)(const LTFAT_TYPE* s[],
                                LTFAT_TYPE* sr[],
                                fbreassHints hints,
                                fbreassOptOut*  repos)
+{
+    LTFAT_NAME(filterbankreassign_plan)* p = NULL;
+
+    if (LTFAT_NAME(filterbankreassign_init)(N, a, cfreq, M, hints, 1, &p)
+        == LTFATERR_SUCCESS)
+        LTFAT_NAME(filterbankreassign_execute)(p, s, tgrad, fgrad, sr, repos);
+
+    if (p) LTFAT_NAME(filterbankreassign_done)(&p);
+}
+
+LTFAT_API int
+LTFAT_NAME(filterbankreassign_init)(const ltfat_int N[], const double a[],
+                                    const double cfreq[], ltfat_int M,
+                                    fbreassHints hints, ltfat_int nthreads,
+                                    LTFAT_NAME(filterbankreassign_plan)** pout)
+{
+    LTFAT_NAME(filterbankreassign_plan)* p = NULL;
+    double oneover2 = 1.0 / 2.0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(N); CHECKNULL(a); CHECKNULL(cfreq); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, M > 0, "M (passed %td) must be positive.", M);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        CHECK(LTFATERR_BADSIZE, N[m] > 0, "N[%td] (passed %td) must be positive", m, N[m]);
+        CHECK(LTFATERR_NOTPOSARG, a[m] > 0, "a[%td] (passed %f) must be positive", m, a[m]);
+    }
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(filterbankreassign_plan)) );
+    p->M = M; p->hints = hints;
+#ifdef _OPENMP
+    p->nthreads = nthreads;
+#else
+    p->nthreads = 1;
+#endif
+
+    CHECKMEM( p->N = LTFAT_NEWARRAY(ltfat_int, M) );
+    CHECKMEM( p->a = LTFAT_NEWARRAY(double, M) );
+    CHECKMEM( p->cfreq2 = LTFAT_NAME_REAL(malloc)(M) );
+    CHECKMEM( p->chan_pos = LTFAT_NEWARRAY(ltfat_int, M + 1) );
+
+    p->chan_pos[0] = 0;
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        p->N[m] = N[m];
+        p->a[m] = a[m];
+        p->chan_pos[m + 1] = p->chan_pos[m] + N[m];
+        // This is effectivelly modulo by 2.0
+        p->cfreq2[m] = (LTFAT_REAL) ( cfreq[m] - floor(cfreq[m] * oneover2) * 2.0 );
+    }
+
+    CHECKMEM( p->tgradIdx = LTFAT_NEWARRAY(ltfat_int, p->chan_pos[M]) );
+    CHECKMEM( p->fgradIdx = LTFAT_NEWARRAY(ltfat_int, p->chan_pos[M]) );
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(filterbankreassign_done)(&p);
+    return status;
+}
+
+/* Channel whose center frequency is closest to the instantaneous frequency
+ * of coefficient in channel m */
+static ltfat_int
+LTFAT_NAME(fbreass_chanidx)(const LTFAT_REAL cfreq2[], ltfat_int M, ltfat_int m,
+                            LTFAT_REAL tgradmjj_orig)
 {
 #define CHECKZEROCROSSINGANDBREAK( CMP, SIGN) \
      { \
@@ -65,171 +340,148 @@ LTFAT_NAME(filterbankreassign)(const LTFAT_TYPE* s[],
         {\
            if (fabs(tmptgrad) < fabs(oldtgrad))\
            {\
-              tgradIdx[jj] = ii;\
+              idx = ii;\
            }\
            else\
            {\
-              tgradIdx[jj] = ii SIGN 1;\
+              idx = ii SIGN 1;\
            }\
            break;\
         }\
         oldtgrad = tmptgrad;\
      }
 
-    ltfat_int* chan_pos = NULL;
-
-    int doTimeWraparound = !(hints & REASS_NOTIMEWRAPAROUND);
+    LTFAT_REAL tmptgrad = 0.0;
+    LTFAT_REAL tgradmjj = tgradmjj_orig + cfreq2[m];
+    LTFAT_REAL oldtgrad = 10; // 10 seems to be big enough
+    // Zero this in case it falls trough, although it might not happen
+    ltfat_int idx = 0;
+    ltfat_int ii;
 
-    if (repos)
+    if (tgradmjj_orig > 0)
     {
-        chan_pos = (ltfat_int*) ltfat_malloc((M + 1) * sizeof * chan_pos);
+        // Search for zero crossing
 
-        chan_pos[0] = 0;
-        for (ltfat_int ii = 0; ii < M; ii++)
+        // If the gradient is bigger than 0, start from m upward....
+        for (ii = m; ii < M; ii++)
         {
-            chan_pos[ii + 1] = chan_pos[ii] + N[ii];
+            tmptgrad = cfreq2[ii] - tgradmjj;
+            CHECKZEROCROSSINGANDBREAK( >=, -)
         }
-    }
-
-    /* Limit tgrad? */
-
-    double oneover2 = 1.0 / 2.0;
-
-    // This will hold center frequencies modulo 2.0
-    LTFAT_REAL* cfreq2 = LTFAT_NAME_REAL(malloc)(M);
-
-    for (ltfat_int m = 0; m < M; m++)
-    {
-        // Zero the output arrays
-        /* memset(sr[m], 0, N[m]*sizeof * sr[m]); */
-        LTFAT_NAME(clear_array)(sr[m], N[m]);
-        // This is effectivelly modulo by 2.0
-        cfreq2[m] = (LTFAT_REAL) ( cfreq[m] - floor(cfreq[m] * oneover2) * 2.0 );
-    }
-
-    ltfat_int* tgradIdx = NULL;
-    ltfat_int* fgradIdx = NULL;
-    ltfat_int Nold = 0;
-    for (ltfat_int m = M - 1; m >= 0; m--)
-    {
-        // Ensure the temporary arrays have proper lengths
-        if (N[m] > Nold)
+        // If the previous for does not break, ii == M
+        if (ii == M  && tmptgrad < 0.0)
         {
-            if (tgradIdx)
+            for (ii = 0; ii < m ; ii++)
             {
-                ltfat_free(tgradIdx);
+                tmptgrad = (LTFAT_REAL)( cfreq2[ii] - tgradmjj + 2.0 );
+                CHECKZEROCROSSINGANDBREAK( >=, -)
             }
-            if (fgradIdx)
+        }
+        if (idx < 0)
+        {
+            idx = M - 1;
+        }
+    }
+    else
+    {
+        for (ii = m; ii >= 0; ii--)
+        {
+            tmptgrad = cfreq2[ii] - tgradmjj;
+            CHECKZEROCROSSINGANDBREAK( <=, +)
+        }
+        // If the previous for does not break, ii=-1
+        if (ii == -1 && tmptgrad > 0.0)
+        {
+            for (ii = M - 1; ii >= m; ii--)
             {
-                ltfat_free(fgradIdx);
+                tmptgrad = (LTFAT_REAL) ( cfreq2[ii] - tgradmjj - 2.0 );
+                CHECKZEROCROSSINGANDBREAK( <=, +)
             }
-
-            tgradIdx = (ltfat_int*) ltfat_malloc(N[m] * sizeof * tgradIdx);
-            fgradIdx = (ltfat_int*) ltfat_malloc(N[m] * sizeof * fgradIdx);
-            Nold = N[m];
         }
+        if (idx >= M)
+        {
+            idx = 0;
+        }
+    }
 
-        // We will use this repeatedly
-        LTFAT_REAL cfreqm = cfreq2[m];
+    return idx;
+#undef CHECKZEROCROSSINGANDBREAK
+}
 
-        /************************
-         *
-         * Calculating frequency reassignment
-         *
-         * **********************
-         */
-        for (ltfat_int jj = 0; jj < N[m]; jj++)
-        {
-            //
-            LTFAT_REAL tmptgrad = 0.0;
-            LTFAT_REAL tgradmjj = tgrad[m][jj] + cfreqm;
-            LTFAT_REAL oldtgrad = 10; // 10 seems to be big enough
-            // Zero this in case it falls trough, although it might not happen
-            tgradIdx[jj] = 0;
-
-            if (tgrad[m][jj] > 0)
-            {
-                ltfat_int ii;
-                // Search for zero crossing
+void
+LTFAT_NAME(filterbankreassign_chanidx)(LTFAT_NAME(filterbankreassign_plan)* p,
+                                       ltfat_int m, const LTFAT_REAL tgrad[],
+                                       const LTFAT_REAL fgrad[])
+{
+    ltfat_int* tgradIdx = p->tgradIdx + p->chan_pos[m];
+    ltfat_int* fgradIdx = p->fgradIdx + p->chan_pos[m];
+    int doTimeWraparound = !(p->hints & REASS_NOTIMEWRAPAROUND);
 
-                // If the gradient is bigger than 0, start from m upward....
-                for (ii = m; ii < M; ii++)
-                {
-                    tmptgrad = cfreq2[ii] - tgradmjj;
-                    CHECKZEROCROSSINGANDBREAK( >=, -)
-                }
-                // If the previous for does not break, ii == M
-                if (ii == M  && tmptgrad < 0.0)
-                {
-                    for (ii = 0; ii < m ; ii++)
-                    {
-                        tmptgrad = (LTFAT_REAL)( cfreq2[ii] - tgradmjj + 2.0 );
-                        CHECKZEROCROSSINGANDBREAK( >=, -)
-                    }
-                }
-                if (tgradIdx[jj] < 0)
-                {
-                    tgradIdx[jj] = M - 1;
-                }
-            }
-            else
-            {
-                ltfat_int ii;
-                for (ii = m; ii >= 0; ii--)
-                {
-                    tmptgrad = cfreq2[ii] - tgradmjj;
-                    CHECKZEROCROSSINGANDBREAK( <=, +)
-                }
-                // If the previous for does not break, ii=-1
-                if (ii == -1 && tmptgrad > 0.0)
-                {
-                    for (ii = M - 1; ii >= m; ii--)
-                    {
-                        tmptgrad = (LTFAT_REAL) ( cfreq2[ii] - tgradmjj - 2.0 );
-                        CHECKZEROCROSSINGANDBREAK( <=, +)
-                    }
-                }
-                if (tgradIdx[jj] >= M)
-                {
-                    tgradIdx[jj] = 0;
-                }
-            }
-        }
+    for (ltfat_int jj = 0; jj < p->N[m]; jj++)
+    {
+        ltfat_int tmpIdx = LTFAT_NAME(fbreass_chanidx)(p->cfreq2, p->M, m, tgrad[jj]);
+        ltfat_int fgradIdxTmp = ltfat_round( (fgrad[jj] + p->a[m] * jj) / p->a[tmpIdx]);
 
-        /**********************************
-         *                                *
-         * Calculating time-reassignment  *
-         *                                *
-         **********************************/
+        tgradIdx[jj] = tmpIdx;
 
-        for (ltfat_int jj = 0; jj < N[m]; jj++)
+        if (doTimeWraparound)
         {
-            ltfat_int tmpIdx = tgradIdx[jj];
-            ltfat_int fgradIdxTmp = ltfat_round( (fgrad[m][jj] + a[m] * jj) / a[tmpIdx]);
-
-            if (doTimeWraparound)
-            {
-                fgradIdx[jj] = ltfat_positiverem( fgradIdxTmp, N[tmpIdx]);
-            }
-            else
-            {
-                fgradIdx[jj] = ltfat_rangelimit( fgradIdxTmp, 0, N[tmpIdx] - 1);
-            }
+            fgradIdx[jj] = ltfat_positiverem( fgradIdxTmp, p->N[tmpIdx]);
         }
+        else
+        {
+            fgradIdx[jj] = ltfat_rangelimit( fgradIdxTmp, 0, p->N[tmpIdx] - 1);
+        }
+    }
+}
 
+LTFAT_API int
+LTFAT_NAME(filterbankreassign_execute)(LTFAT_NAME(filterbankreassign_plan)* p,
+                                       const LTFAT_TYPE* s[],
+                                       const LTFAT_REAL* tgrad[],
+                                       const LTFAT_REAL* fgrad[],
+                                       LTFAT_TYPE* sr[],
+                                       fbreassOptOut* repos)
+{
+    ltfat_int M;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(s); CHECKNULL(tgrad); CHECKNULL(fgrad); CHECKNULL(sr);
+    M = p->M;
+
+    /************************************************
+     *                                              *
+     * Calculating frequency and time reassignment  *
+     *                                              *
+     ************************************************/
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(p->nthreads)
+#endif
+    for (ltfat_int m = 0; m < M; m++)
+        LTFAT_NAME(filterbankreassign_chanidx)(p, m, tgrad[m], fgrad[m]);
 
-        for (ltfat_int jj = 0; jj < N[m]; jj++)
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        // Zero the output arrays
+        LTFAT_NAME(clear_array)(sr[m], p->N[m]);
+    }
+
+    for (ltfat_int m = M - 1; m >= 0; m--)
+    {
+        const ltfat_int* tgradIdx = p->tgradIdx + p->chan_pos[m];
+        const ltfat_int* fgradIdx = p->fgradIdx + p->chan_pos[m];
+
+        for (ltfat_int jj = 0; jj < p->N[m]; jj++)
         {
             sr[tgradIdx[jj]][fgradIdx[jj]] += s[m][jj];
         }
 
-        if (repos && chan_pos)
+        if (repos)
         {
-            for (ltfat_int jj = 0; jj < N[m]; jj++)
+            for (ltfat_int jj = 0; jj < p->N[m]; jj++)
             {
-                ltfat_int tmpIdx =  chan_pos[tgradIdx[jj]] + fgradIdx[jj] ;
+                ltfat_int tmpIdx =  p->chan_pos[tgradIdx[jj]] + fgradIdx[jj] ;
                 ltfat_int* tmpl = &repos->reposl[tmpIdx];
-                repos->repos[tmpIdx][*tmpl] = chan_pos[m] + jj;
+                repos->repos[tmpIdx][*tmpl] = p->chan_pos[m] + jj;
                 (*tmpl)++;
                 if (*tmpl >= repos->reposlmax[tmpIdx])
                 {
@@ -237,10 +489,23 @@ LTFAT_NAME(filterbankreassign)(const LTFAT_TYPE* s[],
                 }
             }
         }
-
     }
 
+error:
+    return status;
+}
 
-    LTFAT_SAFEFREEALL(tgradIdx, fgradIdx, cfreq2, chan_pos);
-#undef CHECKZEROCROSSINGANDBREAK
+LTFAT_API int
+LTFAT_NAME(filterbankreassign_done)(LTFAT_NAME(filterbankreassign_plan)** p)
+{
+    LTFAT_NAME(filterbankreassign_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->N, pp->a, pp->cfreq2, pp->chan_pos,
+                      pp->tgradIdx, pp->fgradIdx);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
 }
@@ -0,0 +1,25 @@
+#ifndef _ltfat_reassign_private_h
+#define _ltfat_reassign_private_h
+#include "ltfat/reassign_typeconstant.h"
+
+struct LTFAT_NAME(filterbankreassign_plan)
+{
+    ltfat_int M;
+    ltfat_int* N;
+    double* a;
+    LTFAT_REAL* cfreq2;  //!< Center frequencies modulo 2.0
+    ltfat_int* chan_pos; //!< Start of each channel in the index tables, M + 1
+    ltfat_int* tgradIdx; //!< Target channel of every coefficient
+    ltfat_int* fgradIdx; //!< Target position in the target channel
+    fbreassHints hints;
+    ltfat_int nthreads;
+};
+
+/* Fills the index tables for channel m. Different channels can be done
+ * concurrently. */
+void
+LTFAT_NAME(filterbankreassign_chanidx)(LTFAT_NAME(filterbankreassign_plan)* p,
+                                       ltfat_int m, const LTFAT_REAL tgrad[],
+                                       const LTFAT_REAL fgrad[]);
+
+#endif
@@ -1,8 +1,7 @@
 #include "ltfat.h"
 #include "ltfat/types.h"
 #include "ltfat/macros.h"
-
-
+#include "reassign_private.h"
 
 LTFAT_API void
 LTFAT_NAME(filterbankphasegrad)(const LTFAT_COMPLEX* c [],
@@ -23,12 +22,12 @@ LTFAT_NAME(filterbankphasegrad)(const LTFAT_COMPLEX* c [],
 #define ARRAYEL(c) ((c)[m][ii])
 #define ENDFOREACHCOEF }}
 
-    LTFAT_REAL minlvlAlt = ltfat_abs(c[0][0]);
+    LTFAT_REAL minlvlAlt = ltfat_energy(c[0][0]);
 
 // Compute spectrogram from coefficients
 // Keep max value
     FOREACHCOEF
-    LTFAT_REAL en = ltfat_abs(ARRAYEL(c)) * ltfat_abs(ARRAYEL( c));
+    LTFAT_REAL en = ltfat_energy(ARRAYEL(c));
     ARRAYEL(cs) = en;
     if (en > minlvlAlt)
         minlvlAlt = en;
@@ -60,3 +59,230 @@ LTFAT_NAME(filterbankphasegrad)(const LTFAT_COMPLEX* c [],
 #undef ENDFOREACHCOEF
 #undef ARRAYEL
 }
+
+/* The spectrogram floor depends on the maximum over all channels, so the
+ * channels are swept twice. The first sweep computes the spectrogram and the
+ * per-channel maxima, the second one computes the gradients and immediately
+ * the target indices while the gradients of the channel are still in cache.
+ * Both sweeps run in parallel over channels. The accumulation is serial and
+ * in the same order as in filterbankreassign.
+ *
+ * Every coefficient is moved to exactly one position, so the repositioning
+ * lists of all coefficients together have exactly Ntot entries. They are
+ * kept in the compressed form (reposstart, repos) allocated in init.
+ * */
+struct LTFAT_NAME(filterbankphasereassign_plan)
+{
+    LTFAT_NAME(filterbankreassign_plan)* reass;
+    ltfat_int L;
+    LTFAT_REAL minlvl;
+    LTFAT_REAL* tgrad;     //!< Time gradient, Ntot
+    LTFAT_REAL* fgrad;     //!< Frequency gradient, Ntot
+    LTFAT_REAL* cs;        //!< Spectrogram, Ntot
+    LTFAT_REAL* chanmax;   //!< Spectrogram maximum of each channel, M
+    ltfat_int* reposstart; //!< Start of each list in repos, Ntot + 1
+    ltfat_int* repos;      //!< Repositioning lists, Ntot
+};
+
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_init)(const ltfat_int N[], const double a[],
+        const double cfreq[], ltfat_int M, ltfat_int L, double minlvl,
+        fbreassHints hints, ltfat_int nthreads,
+        LTFAT_NAME(filterbankphasereassign_plan)** pout)
+{
+    LTFAT_NAME(filterbankphasereassign_plan)* p = NULL;
+    ltfat_int Ntot;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADTRALEN, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_BADARG, minlvl >= 0.0 && minlvl < 1.0,
+          "minlvl (passed %f) must be in range [0,1).", minlvl);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(filterbankphasereassign_plan)) );
+    p->L = L; p->minlvl = (LTFAT_REAL) minlvl;
+
+    CHECKSTATUS(
+        LTFAT_NAME(filterbankreassign_init)(N, a, cfreq, M, hints, nthreads,
+                                            &p->reass));
+
+    Ntot = p->reass->chan_pos[M];
+    CHECKMEM( p->tgrad = LTFAT_NAME_REAL(malloc)(Ntot) );
+    CHECKMEM( p->fgrad = LTFAT_NAME_REAL(malloc)(Ntot) );
+    CHECKMEM( p->cs = LTFAT_NAME_REAL(malloc)(Ntot) );
+    CHECKMEM( p->chanmax = LTFAT_NAME_REAL(malloc)(M) );
+
+    if (hints & REASS_KEEPREPOS)
+    {
+        CHECKMEM( p->reposstart = LTFAT_NEWARRAY(ltfat_int, Ntot + 1) );
+        CHECKMEM( p->repos = LTFAT_NEWARRAY(ltfat_int, Ntot) );
+    }
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(filterbankphasereassign_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_execute)(
+    LTFAT_NAME(filterbankphasereassign_plan)* p,
+    const LTFAT_COMPLEX* c[], const LTFAT_COMPLEX* ch[],
+    const LTFAT_COMPLEX* cd[], LTFAT_REAL* sr[])
+{
+    LTFAT_NAME(filterbankreassign_plan)* r;
+    ltfat_int M, Ntot;
+    LTFAT_REAL minlvlAlt = 0.0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(c); CHECKNULL(ch); CHECKNULL(cd); CHECKNULL(sr);
+    r = p->reass;
+    M = r->M;
+    Ntot = r->chan_pos[M];
+
+    // Spectrogram and its maximum
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(r->nthreads)
+#endif
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        LTFAT_REAL* cs = p->cs + r->chan_pos[m];
+        LTFAT_REAL chanmax = 0.0;
+
+        for (ltfat_int jj = 0; jj < r->N[m]; jj++)
+        {
+            cs[jj] = ltfat_energy(c[m][jj]);
+            if (cs[jj] > chanmax)
+                chanmax = cs[jj];
+        }
+        p->chanmax[m] = chanmax;
+    }
+
+    for (ltfat_int m = 0; m < M; m++)
+        if (p->chanmax[m] > minlvlAlt)
+            minlvlAlt = p->chanmax[m];
+
+    minlvlAlt *= p->minlvl;
+
+    // Gradients and the target indices
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(r->nthreads)
+#endif
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        LTFAT_REAL* cs = p->cs + r->chan_pos[m];
+        LTFAT_REAL* tgrad = p->tgrad + r->chan_pos[m];
+        LTFAT_REAL* fgrad = p->fgrad + r->chan_pos[m];
+        const LTFAT_COMPLEX* cm = c[m];
+        const LTFAT_COMPLEX* chm = ch[m];
+        const LTFAT_COMPLEX* cdm = cd[m];
+
+        for (ltfat_int jj = 0; jj < r->N[m]; jj++)
+        {
+            LTFAT_REAL tgradEl;
+            if (cs[jj] < minlvlAlt)
+                cs[jj] = minlvlAlt;
+
+            tgradEl = ltfat_real( cdm[jj] * conj(cm[jj]) / cs[jj] ) / p->L * 2;
+            tgrad[jj] = fabs(tgradEl) <= 2 ? tgradEl : 0.0f;
+            fgrad[jj] = ltfat_imag( chm[jj] * conj(cm[jj]) / cs[jj] );
+        }
+
+        LTFAT_NAME(filterbankreassign_chanidx)(r, m, tgrad, fgrad);
+    }
+
+    for (ltfat_int m = 0; m < M; m++)
+        LTFAT_NAME(clear_array)(sr[m], r->N[m]);
+
+    for (ltfat_int m = M - 1; m >= 0; m--)
+    {
+        const ltfat_int* tgradIdx = r->tgradIdx + r->chan_pos[m];
+        const ltfat_int* fgradIdx = r->fgradIdx + r->chan_pos[m];
+        const LTFAT_REAL* cs = p->cs + r->chan_pos[m];
+
+        for (ltfat_int jj = 0; jj < r->N[m]; jj++)
+            sr[tgradIdx[jj]][fgradIdx[jj]] += cs[jj];
+    }
+
+    if (p->repos)
+    {
+        // Count, cumulate and fill in the order of the accumulation
+        memset(p->reposstart, 0, (Ntot + 1) * sizeof * p->reposstart);
+
+        for (ltfat_int k = 0; k < Ntot; k++)
+            p->reposstart[r->chan_pos[r->tgradIdx[k]] + r->fgradIdx[k] + 1]++;
+
+        for (ltfat_int k = 0; k < Ntot; k++)
+            p->reposstart[k + 1] += p->reposstart[k];
+
+        for (ltfat_int m = M - 1; m >= 0; m--)
+        {
+            for (ltfat_int k = r->chan_pos[m]; k < r->chan_pos[m + 1]; k++)
+            {
+                ltfat_int tmpIdx = r->chan_pos[r->tgradIdx[k]] + r->fgradIdx[k];
+                p->repos[p->reposstart[tmpIdx]++] = k;
+            }
+        }
+
+        // The fill advanced every start to the start of the next list
+        for (ltfat_int k = Ntot; k > 0; k--)
+            p->reposstart[k] = p->reposstart[k - 1];
+        p->reposstart[0] = 0;
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_get_phasegrad)(
+    LTFAT_NAME(filterbankphasereassign_plan)* p,
+    const LTFAT_REAL* tgrad[], const LTFAT_REAL* fgrad[], const LTFAT_REAL* cs[])
+{
+    LTFAT_NAME(filterbankreassign_plan)* r;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    r = p->reass;
+
+    for (ltfat_int m = 0; m < r->M; m++)
+    {
+        if (tgrad) tgrad[m] = p->tgrad + r->chan_pos[m];
+        if (fgrad) fgrad[m] = p->fgrad + r->chan_pos[m];
+        if (cs)       cs[m] = p->cs + r->chan_pos[m];
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_get_repos)(
+    LTFAT_NAME(filterbankphasereassign_plan)* p,
+    const ltfat_int** reposstart, const ltfat_int** repos)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(reposstart); CHECKNULL(repos);
+    CHECK(LTFATERR_BADARG, p->repos != NULL,
+          "The plan was not initialized with REASS_KEEPREPOS.");
+
+    *reposstart = p->reposstart;
+    *repos = p->repos;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(filterbankphasereassign_done)(
+    LTFAT_NAME(filterbankphasereassign_plan)** p)
+{
+    LTFAT_NAME(filterbankphasereassign_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    if (pp->reass) LTFAT_NAME(filterbankreassign_done)(&pp->reass);
+    LTFAT_SAFEFREEALL(pp->tgrad, pp->fgrad, pp->cs, pp->chanmax,
+                      pp->reposstart, pp->repos);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -121,7 +121,7 @@ LTFAT_NAME(rtdgtreal_execute)(const LTFAT_NAME(rtdgtreal_plan)* p,
             memset(fftBuf + gl, 0, (M - gl) * sizeof * fftBuf);
 
         if (gl > M)
-            LTFAT_NAME_REAL(fold_array)(fftBuf, gl, M, 0, fftBuf);
+            LTFAT_NAME_REAL(fold_array)(fftBuf, gl, 0, M, fftBuf);
 
         if (p->ptype == LTFAT_RTDGTPHASE_ZERO)
             LTFAT_NAME_REAL(circshift)(fftBuf, M, -(gl / 2), fftBuf );
@@ -231,6 +231,8 @@ struct LTFAT_NAME(rtdgtreal_processor_state)
 {
     LTFAT_NAME(rtdgtreal_processor_callback)*
     processorCallback; //!< Custom processor callback
+    LTFAT_NAME(rtdgtreal_processor_activity)*
+    activityCallback; //!< Optional frame activity callback
     void* userdata; //!< Callback data
     LTFAT_NAME(analysis_fifo_state)* fwdfifo;
     LTFAT_NAME(synthesis_fifo_state)* backfifo;
@@ -407,6 +409,20 @@ error:
     return status;
 }
 
+LTFAT_API int
+LTFAT_NAME(rtdgtreal_processor_setactivitycallback)(
+    LTFAT_NAME( rtdgtreal_processor_state)* p,
+    LTFAT_NAME(rtdgtreal_processor_activity)* activity)
+{
+    int status = LTFATERR_FAILED;
+    CHECKNULL(p);
+    p->activityCallback = activity;
+
+    return LTFATERR_SUCCESS;
+error:
+    return status;
+}
+
 LTFAT_API int
 LTFAT_NAME(rtdgtreal_processor_execute_compact)(
     LTFAT_NAME(rtdgtreal_processor_state)* p, const LTFAT_REAL* in,
@@ -525,6 +541,15 @@ LTFAT_NAME(rtdgtreal_processor_execute_gen)(
     // While there is new data in the input fifo
     while ( LTFAT_NAME(analysis_fifo_read)(p->fwdfifo, p->buf) > 0 )
     {
+        // Inactive frames are not transformed, they contribute zeros
+        if (p->activityCallback && !p->activityCallback(p->userdata))
+        {
+            memset(p->buf, 0, p->fwdfifo->numChans * p->fwdfifo->winLen *
+                   sizeof * p->buf);
+            LTFAT_NAME(synthesis_fifo_write)(p->backfifo, p->buf);
+            continue;
+        }
+
         // Transform
         p->fwdtra((void*)p->fwdplan, p->buf, p->fwdfifo->numChans,
                   p->fftbufIn);
@@ -0,0 +1,507 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+struct LTFAT_NAME(spreadop_plan)
+{
+    ltfat_int L;
+    unsigned flags;
+    int sparse;               //!< Which of the representations is in use
+    LTFAT_COMPLEX* cf;        //!< Dense: L*ifft(coef), L x L
+    LTFAT_NAME(ifft_plan)* ifftplan;
+    ltfat_int nnz;            //!< Sparse: number of the nonzero elements
+    ltfat_int nnzmax;
+    ltfat_int* row;
+    ltfat_int* col;
+    LTFAT_COMPLEX* val;
+    LTFAT_COMPLEX* expt;      //!< exp(2*pi*i*k/L), k=0,...,L-1
+    LTFAT_COMPLEX* T;         //!< LU factors of the operator matrix
+    ltfat_int* piv;
+    int factorized;
+};
+
+static void
+LTFAT_NAME(spreadop_exptable)(ltfat_int L, LTFAT_COMPLEX expt[])
+{
+    for (ltfat_int k = 0; k < L; k++)
+        expt[k] = exp(I * (LTFAT_REAL) (2.0 * M_PI * k / L));
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_init)(ltfat_int L, unsigned flags,
+                          LTFAT_NAME(spreadop_plan)** pout)
+{
+    LTFAT_NAME(spreadop_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(spreadop_plan)) );
+    p->L = L; p->flags = flags; p->sparse = 1;
+
+    CHECKMEM( p->expt = LTFAT_NAME_COMPLEX(malloc)(L) );
+    LTFAT_NAME(spreadop_exptable)(L, p->expt);
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(spreadop_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_done)(LTFAT_NAME(spreadop_plan)** p)
+{
+    LTFAT_NAME(spreadop_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->ifftplan) LTFAT_NAME(ifft_done)(&pp->ifftplan);
+    LTFAT_SAFEFREEALL(pp->cf, pp->row, pp->col, pp->val, pp->expt, pp->T,
+                      pp->piv);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(spreadop_reserve)(LTFAT_NAME(spreadop_plan)* p, ltfat_int nnz)
+{
+    int status = LTFATERR_SUCCESS;
+
+    if (nnz > p->nnzmax)
+    {
+        LTFAT_SAFEFREEALL(p->row, p->col, p->val);
+        p->row = NULL; p->col = NULL; p->val = NULL; p->nnzmax = 0;
+        CHECKMEM( p->row = LTFAT_NEWARRAY(ltfat_int, nnz) );
+        CHECKMEM( p->col = LTFAT_NEWARRAY(ltfat_int, nnz) );
+        CHECKMEM( p->val = LTFAT_NAME_COMPLEX(malloc)(nnz) );
+        p->nnzmax = nnz;
+    }
+error:
+    return status;
+}
+
+static int
+LTFAT_NAME(spreadop_densify)(LTFAT_NAME(spreadop_plan)* p)
+{
+    ltfat_int L = p->L;
+    int status = LTFATERR_SUCCESS;
+
+    if (!p->cf)
+    {
+        CHECKMEM( p->cf = LTFAT_NAME_COMPLEX(malloc)(L * L) );
+        CHECKSTATUS(
+            LTFAT_NAME(ifft_init)(L, L, p->cf, p->cf, p->flags, &p->ifftplan));
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_set_coef)(LTFAT_NAME(spreadop_plan)* p,
+                              const LTFAT_COMPLEX coef[])
+{
+    ltfat_int L, nnz = 0;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(coef);
+    L = p->L;
+
+    for (ltfat_int ii = 0; ii < L * L; ii++)
+        if (coef[ii] != (LTFAT_REAL) 0.0) nnz++;
+
+    p->factorized = 0;
+
+    // The same rule as in spreadop.m
+    if (nnz < L)
+    {
+        CHECKSTATUS( LTFAT_NAME(spreadop_reserve)(p, nnz));
+        p->nnz = 0;
+        for (ltfat_int n = 0; n < L; n++)
+            for (ltfat_int m = 0; m < L; m++)
+                if (coef[m + n * L] != (LTFAT_REAL) 0.0)
+                {
+                    p->row[p->nnz] = m; p->col[p->nnz] = n;
+                    p->val[p->nnz] = coef[m + n * L];
+                    p->nnz++;
+                }
+        p->sparse = 1;
+    }
+    else
+    {
+        CHECKSTATUS( LTFAT_NAME(spreadop_densify)(p));
+
+        // The inverse FFT is not normalized, this gives L*ifft(coef)
+        memcpy(p->cf, coef, L * L * sizeof * coef);
+        CHECKSTATUS( LTFAT_NAME(ifft_execute)(p->ifftplan));
+        p->sparse = 0;
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_set_coef_sparse)(LTFAT_NAME(spreadop_plan)* p,
+                                     const ltfat_int row[], const ltfat_int col[],
+                                     const LTFAT_COMPLEX val[], ltfat_int nnz)
+{
+    ltfat_int L;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_BADSIZE, nnz >= 0, "nnz (passed %td) cannot be negative.", nnz);
+    if (nnz > 0) { CHECKNULL(row); CHECKNULL(col); CHECKNULL(val); }
+    L = p->L;
+
+    for (ltfat_int k = 0; k < nnz; k++)
+        CHECK(LTFATERR_NOTINRANGE, row[k] >= 0 && row[k] < L &&
+              col[k] >= 0 && col[k] < L,
+              "Element %td (%td, %td) is out of range.", k, row[k], col[k]);
+
+    p->factorized = 0;
+
+    // The same rule as in spreadop.m, the dense form is faster otherwise
+    if (nnz < L)
+    {
+        CHECKSTATUS( LTFAT_NAME(spreadop_reserve)(p, nnz));
+        if (nnz > 0)
+        {
+            memcpy(p->row, row, nnz * sizeof * row);
+            memcpy(p->col, col, nnz * sizeof * col);
+            memcpy(p->val, val, nnz * sizeof * val);
+        }
+        p->nnz = nnz;
+        p->sparse = 1;
+    }
+    else
+    {
+        CHECKSTATUS( LTFAT_NAME(spreadop_densify)(p));
+
+        LTFAT_NAME_COMPLEX(clear_array)(p->cf, L * L);
+        for (ltfat_int k = 0; k < nnz; k++)
+            p->cf[row[k] + col[k] * L] += val[k];
+
+        CHECKSTATUS( LTFAT_NAME(ifft_execute)(p->ifftplan));
+        p->sparse = 0;
+    }
+error:
+    return status;
+}
+
+/* h(l) = sum_n cf(l,n) f(l-n) */
+static void
+LTFAT_NAME(spreadop_dense)(const LTFAT_COMPLEX cf[], ltfat_int L,
+                           const LTFAT_COMPLEX f[], ltfat_int W,
+                           LTFAT_COMPLEX h[])
+{
+    for (ltfat_int n = 0; n < L; n++)
+    {
+        const LTFAT_COMPLEX* cfn = cf + n * L;
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            const LTFAT_COMPLEX* fw = f + w * L;
+            LTFAT_COMPLEX* hw = h + w * L;
+
+            for (ltfat_int l = 0; l < n; l++)
+                hw[l] += cfn[l] * fw[l - n + L];
+
+            for (ltfat_int l = n; l < L; l++)
+                hw[l] += cfn[l] * fw[l - n];
+        }
+    }
+}
+
+/* h(k) = sum_n conj(cf(k+n,n)) f(k+n) */
+static void
+LTFAT_NAME(spreadop_dense_adj)(const LTFAT_COMPLEX cf[], ltfat_int L,
+                               const LTFAT_COMPLEX f[], ltfat_int W,
+                               LTFAT_COMPLEX h[])
+{
+    for (ltfat_int n = 0; n < L; n++)
+    {
+        const LTFAT_COMPLEX* cfn = cf + n * L;
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            const LTFAT_COMPLEX* fw = f + w * L;
+            LTFAT_COMPLEX* hw = h + w * L;
+
+            for (ltfat_int k = 0; k < L - n; k++)
+                hw[k] += conj(cfn[k + n]) * fw[k + n];
+
+            for (ltfat_int k = L - n; k < L; k++)
+                hw[k] += conj(cfn[k + n - L]) * fw[k + n - L];
+        }
+    }
+}
+
+/* h(l) = sum_k val_k exp(2*pi*i*row_k*l/L) f(l-col_k) */
+static void
+LTFAT_NAME(spreadop_sparse)(const LTFAT_NAME(spreadop_plan)* p,
+                            const LTFAT_COMPLEX f[], ltfat_int W,
+                            LTFAT_COMPLEX h[], int adj)
+{
+    ltfat_int L = p->L;
+
+    for (ltfat_int k = 0; k < p->nnz; k++)
+    {
+        ltfat_int m = p->row[k], n = p->col[k];
+        LTFAT_COMPLEX v = adj ? conj(p->val[k]) : p->val[k];
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            const LTFAT_COMPLEX* fw = f + w * L;
+            LTFAT_COMPLEX* hw = h + w * L;
+
+            if (!adj)
+            {
+                ltfat_int fidx = ltfat_positiverem(-n, L);
+                for (ltfat_int l = 0, eidx = 0; l < L; l++)
+                {
+                    hw[l] += v * p->expt[eidx] * fw[fidx];
+                    if (++fidx == L) fidx = 0;
+                    eidx += m; if (eidx >= L) eidx -= L;
+                }
+            }
+            else
+            {
+                // h(l) = conj(val) exp(-2*pi*i*row*(l+col)/L) f(l+col)
+                ltfat_int fidx = n;
+                ltfat_int eidx = (ltfat_int) (((long long) m * n) % L);
+                for (ltfat_int l = 0; l < L; l++)
+                {
+                    hw[l] += v * conj(p->expt[eidx]) * fw[fidx];
+                    if (++fidx == L) fidx = 0;
+                    eidx += m; if (eidx >= L) eidx -= L;
+                }
+            }
+        }
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_execute)(LTFAT_NAME(spreadop_plan)* p,
+                             const LTFAT_COMPLEX f[], ltfat_int W,
+                             LTFAT_COMPLEX h[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(h);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_BADARG, f != h, "The operator cannot work inplace.");
+
+    LTFAT_NAME_COMPLEX(clear_array)(h, p->L * W);
+
+    if (p->sparse)
+        LTFAT_NAME(spreadop_sparse)(p, f, W, h, 0);
+    else
+        LTFAT_NAME(spreadop_dense)(p->cf, p->L, f, W, h);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_execute_adj)(LTFAT_NAME(spreadop_plan)* p,
+                                 const LTFAT_COMPLEX f[], ltfat_int W,
+                                 LTFAT_COMPLEX h[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(h);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_BADARG, f != h, "The operator cannot work inplace.");
+
+    LTFAT_NAME_COMPLEX(clear_array)(h, p->L * W);
+
+    if (p->sparse)
+        LTFAT_NAME(spreadop_sparse)(p, f, W, h, 1);
+    else
+        LTFAT_NAME(spreadop_dense_adj)(p->cf, p->L, f, W, h);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_prepare_inv)(LTFAT_NAME(spreadop_plan)* p)
+{
+    ltfat_int L;
+    LTFAT_COMPLEX* T;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    L = p->L;
+
+    if (!p->T)
+    {
+        CHECKMEM( p->T = LTFAT_NAME_COMPLEX(malloc)(L * L) );
+        CHECKMEM( p->piv = LTFAT_NEWARRAY(ltfat_int, L) );
+    }
+    T = p->T;
+    p->factorized = 0;
+
+    // The operator matrix T(l,j) = cf(l, l-j), column-major
+    if (p->sparse)
+    {
+        LTFAT_NAME_COMPLEX(clear_array)(T, L * L);
+        for (ltfat_int k = 0; k < p->nnz; k++)
+        {
+            ltfat_int m = p->row[k], n = p->col[k];
+            for (ltfat_int l = 0, eidx = 0; l < L; l++)
+            {
+                T[l + ltfat_positiverem(l - n, L) * L] += p->val[k] * p->expt[eidx];
+                eidx += m; if (eidx >= L) eidx -= L;
+            }
+        }
+    }
+    else
+    {
+        for (ltfat_int j = 0; j < L; j++)
+            for (ltfat_int l = 0; l < L; l++)
+                T[l + j * L] = p->cf[l + ltfat_positiverem(l - j, L) * L];
+    }
+
+    // LU factorization with partial pivoting
+    for (ltfat_int k = 0; k < L; k++)
+    {
+        ltfat_int pk = k;
+        LTFAT_REAL pmax = ltfat_energy(T[k + k * L]);
+        LTFAT_COMPLEX pinv;
+
+        for (ltfat_int i = k + 1; i < L; i++)
+            if (ltfat_energy(T[i + k * L]) > pmax)
+            {
+                pmax = ltfat_energy(T[i + k * L]);
+                pk = i;
+            }
+
+        CHECK(LTFATERR_NOTAFRAME, pmax > 0, "The operator is singular.");
+        p->piv[k] = pk;
+
+        if (pk != k)
+            for (ltfat_int j = 0; j < L; j++)
+            {
+                LTFAT_COMPLEX tmp = T[k + j * L];
+                T[k + j * L] = T[pk + j * L];
+                T[pk + j * L] = tmp;
+            }
+
+        pinv = (LTFAT_REAL) 1.0 / T[k + k * L];
+        for (ltfat_int i = k + 1; i < L; i++)
+            T[i + k * L] *= pinv;
+
+        for (ltfat_int j = k + 1; j < L; j++)
+        {
+            LTFAT_COMPLEX tkj = T[k + j * L];
+            if (tkj == (LTFAT_REAL) 0.0) continue;
+            for (ltfat_int i = k + 1; i < L; i++)
+                T[i + j * L] -= T[i + k * L] * tkj;
+        }
+    }
+
+    p->factorized = 1;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadop_execute_inv)(LTFAT_NAME(spreadop_plan)* p,
+                                 const LTFAT_COMPLEX f[], ltfat_int W,
+                                 LTFAT_COMPLEX h[])
+{
+    ltfat_int L;
+    const LTFAT_COMPLEX* T;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(h);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W must be positive");
+    CHECK(LTFATERR_BADARG, p->factorized,
+          "spreadop_prepare_inv must be called after setting the coefficients.");
+    L = p->L; T = p->T;
+
+    if (f != h)
+        memcpy(h, f, L * W * sizeof * f);
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        LTFAT_COMPLEX* b = h + w * L;
+
+        for (ltfat_int k = 0; k < L; k++)
+            if (p->piv[k] != k)
+            {
+                LTFAT_COMPLEX tmp = b[k];
+                b[k] = b[p->piv[k]];
+                b[p->piv[k]] = tmp;
+            }
+
+        // Forward substitution, unit lower triangular
+        for (ltfat_int j = 0; j < L; j++)
+            for (ltfat_int i = j + 1; i < L; i++)
+                b[i] -= T[i + j * L] * b[j];
+
+        // Back substitution
+        for (ltfat_int j = L - 1; j >= 0; j--)
+        {
+            b[j] /= T[j + j * L];
+            for (ltfat_int i = 0; i < j; i++)
+                b[i] -= T[i + j * L] * b[j];
+        }
+    }
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadadj)(const LTFAT_COMPLEX coef[], ltfat_int L,
+                      LTFAT_COMPLEX cadj[])
+{
+    LTFAT_COMPLEX* expt = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(coef); CHECKNULL(cadj);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_BADARG, coef != cadj, "The function cannot work inplace.");
+
+    CHECKMEM( expt = LTFAT_NAME_COMPLEX(malloc)(L) );
+    LTFAT_NAME(spreadop_exptable)(L, expt);
+
+    // cadj(ii,jj) = conj(coef(-ii,-jj))*exp(-2*pi*i*ii*jj/L)
+    for (ltfat_int jj = 0; jj < L; jj++)
+    {
+        const LTFAT_COMPLEX* ccol = coef + (jj ? L - jj : 0) * L;
+        LTFAT_COMPLEX* acol = cadj + jj * L;
+
+        acol[0] = conj(ccol[0]);
+        for (ltfat_int ii = 1, eidx = jj; ii < L; ii++)
+        {
+            acol[ii] = conj(ccol[L - ii] * expt[eidx]);
+            eidx += jj; if (eidx >= L) eidx -= L;
+        }
+    }
+
+error:
+    LTFAT_SAFEFREEALL(expt);
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(spreadadj_sparse)(const ltfat_int row[], const ltfat_int col[],
+                             const LTFAT_COMPLEX val[], ltfat_int nnz,
+                             ltfat_int L, ltfat_int rowadj[],
+                             ltfat_int coladj[], LTFAT_COMPLEX valadj[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(row); CHECKNULL(col); CHECKNULL(val);
+    CHECKNULL(rowadj); CHECKNULL(coladj); CHECKNULL(valadj);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_BADSIZE, nnz >= 0, "nnz (passed %td) cannot be negative.", nnz);
+
+    for (ltfat_int k = 0; k < nnz; k++)
+    {
+        ltfat_int ii = ltfat_positiverem(-row[k], L);
+        ltfat_int jj = ltfat_positiverem(-col[k], L);
+        ltfat_int eidx = (ltfat_int) (((long long) ii * jj) % L);
+
+        rowadj[k] = ii; coladj[k] = jj;
+        valadj[k] = conj(val[k]) * exp(-I * (LTFAT_REAL) (2.0 * M_PI * eidx / L));
+    }
+error:
+    return status;
+}
@@ -446,6 +446,8 @@ LTFAT_NAME(convsub_td)(const LTFAT_TYPE* f, const LTFAT_TYPE* g, ltfat_int L,
         for (ltfat_int ii = 0; ii < N - Nsafe; ii++)
         {
             ONEOUTSAMPLE
+            // Nothing more to read after the last output sample
+            if (ii == N - Nsafe - 1) break;
             READNEXTDATA(a, (righExtbuff + rightExtBuffIdx))
             rightExtBuffIdx = ltfat_modpow2(rightExtBuffIdx += a, bufgl);
         }
@@ -4,6 +4,10 @@
 
 #include "ltfat/thirdparty/fftw3.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* wfac for real valued input. Produces only half the output coefficients of wfac_r */
 LTFAT_API void
 LTFAT_NAME(wfacreal)(const LTFAT_REAL* g, ltfat_int L, ltfat_int R,
@@ -13,14 +17,10 @@ LTFAT_NAME(wfacreal)(const LTFAT_REAL* g, ltfat_int L, ltfat_int R,
 
     ltfat_int h_a, h_m;
 
-    //LTFAT_REAL *gfp;
-    LTFAT_COMPLEX* gfp = gf;
-
-    ltfat_int s;
-    ltfat_int rem, negrem;
-
     /* LTFAT_FFTW(plan) p_before; */
-    LTFAT_NAME(fftreal_plan)* p_before;
+    LTFAT_NAME(fftreal_plan)** p_before = NULL;
+    LTFAT_REAL* sbuf = NULL;
+    LTFAT_COMPLEX* cbuf = NULL;
 
     ltfat_int b = L / M;
     ltfat_int c = ltfat_gcd(a, M, &h_a, &h_m);
@@ -33,47 +33,70 @@ LTFAT_NAME(wfacreal)(const LTFAT_REAL* g, ltfat_int L, ltfat_int R,
 
     const LTFAT_REAL sqrtM = (LTFAT_REAL) sqrt((double)M);
 
-    LTFAT_REAL* sbuf = LTFAT_NAME_REAL(malloc)(d);
-    LTFAT_COMPLEX* cbuf = LTFAT_NAME_COMPLEX(malloc)(d2);
+    // ltfat_int ld3=2*c*p*q*R;
+    ltfat_int ld3 = c * p * q * R;
 
-    /* Create plan. In-place. */
+    /* The blocks, indexed as ((r*R + w)*q + l)*p + k, are independent.
+     * Every thread does a contiguous range of them. */
+    ltfat_int nblocks = c * R * q * p;
+#ifdef _OPENMP
+    ltfat_int T = omp_get_max_threads();
+#else
+    ltfat_int T = 1;
+#endif
+
+    sbuf = LTFAT_NAME_REAL(malloc)(d * T);
+    cbuf = LTFAT_NAME_COMPLEX(malloc)(d2 * T);
+    p_before = LTFAT_NEWARRAY(LTFAT_NAME(fftreal_plan)*, T);
+    if (!sbuf || !cbuf || !p_before) goto error;
+
+    /* Create plans. */
     /* p_before = LTFAT_FFTW(plan_dft_r2c_1d)((int) d, sbuf, */
     /*                                        (LTFAT_FFTW(complex)*) cbuf, FFTW_MEASURE); */
-    LTFAT_NAME(fftreal_init)(d, 1, sbuf, cbuf, FFTW_MEASURE, &p_before);
-
-
-    // ltfat_int ld3=2*c*p*q*R;
-    ltfat_int ld3 = c * p * q * R;
-    //gfp=(LTFAT_REAL*)gf;
-    for (ltfat_int r = 0; r < c; r++)
+    for (ltfat_int t = 0; t < T; t++)
+        if (LTFAT_NAME(fftreal_init)(d, 1, sbuf + t * d, cbuf + t * d2,
+                                     FFTW_MEASURE, &p_before[t]))
+            goto error;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(T)
+#endif
+    for (ltfat_int t = 0; t < T; t++)
     {
-        for (ltfat_int w = 0; w < R; w++)
+        LTFAT_REAL* sbufTmp = sbuf + t * d;
+        LTFAT_COMPLEX* cbufTmp = cbuf + t * d2;
+
+        for (ltfat_int blk = t * nblocks / T; blk < (t + 1) * nblocks / T; blk++)
         {
-            for (ltfat_int l = 0; l < q; l++)
+            ltfat_int k = blk % p;
+            ltfat_int l = (blk / p) % q;
+            ltfat_int w = (blk / (p * q)) % R;
+            ltfat_int r = blk / (p * q * R);
+            LTFAT_COMPLEX* gfp = gf + blk;
+
+            ltfat_int negrem = ltfat_positiverem(k * M - l * a, L);
+            for (ltfat_int s = 0; s < d; s++)
+            {
+                ltfat_int rem = (negrem + s * p * M) % L;
+                sbufTmp[s]   = sqrtM * g[r + rem + L * w];
+            }
+
+            /* LTFAT_FFTW(execute)(p_before); */
+            LTFAT_NAME(fftreal_execute)(p_before[t]);
+
+            for (ltfat_int s = 0; s < d2; s++)
             {
-                for (ltfat_int k = 0; k < p; k++)
-                {
-                    negrem = ltfat_positiverem(k * M - l * a, L);
-                    for (s = 0; s < d; s++)
-                    {
-                        rem = (negrem + s * p * M) % L;
-                        sbuf[s]   = sqrtM * g[r + rem + L * w];
-                    }
-
-                    /* LTFAT_FFTW(execute)(p_before); */
-                    LTFAT_NAME(fftreal_execute)(p_before);
-
-                    for (s = 0; s < d2; s++)
-                    {
-                        gfp[s * ld3] = cbuf[s];
-                    }
-                    gfp++;
-                }
+                gfp[s * ld3] = cbufTmp[s];
             }
         }
     }
 
-    LTFAT_SAFEFREEALL(sbuf, cbuf);
-    /* LTFAT_FFTW(destroy_plan)(p_before); */
-    LTFAT_NAME(fftreal_done)(&p_before);
+error:
+    if (p_before)
+    {
+        /* LTFAT_FFTW(destroy_plan)(p_before); */
+        for (ltfat_int t = 0; t < T; t++)
+            if (p_before[t]) LTFAT_NAME(fftreal_done)(&p_before[t]);
+    }
+    LTFAT_SAFEFREEALL(sbuf, cbuf, p_before);
 }
@@ -0,0 +1,313 @@
+#include "ltfat.h"
+#include "ltfat/types.h"
+#include "ltfat/macros.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+typedef struct
+{
+    ltfat_int M;     //!< Number of filters
+    ltfat_int filt0; //!< Index of the first filter in the flat arrays
+    ltfat_int Lin;   //!< Input length
+    ltfat_int Pl;    //!< Room for the left extension
+    ltfat_int Pr;    //!< Room for the right extension
+    ltfat_int xoff;  //!< Offset of the input buffer in the arena
+} LTFAT_NAME(wfbt_node);
+
+struct LTFAT_NAME(wfbt_plan)
+{
+    ltfat_int nodes;
+    ltfat_int nfilt;
+    ltfat_int nout;
+    ltfat_int L;
+    ltfat_int W;
+    ltfatExtType ext;
+    ltfat_int nthreads;
+    LTFAT_NAME(wfbt_node)* node;
+    ltfat_int* order;      //!< Nodes sorted by depth
+    ltfat_int* levelstart; //!< Start of each level in order, nlevels + 1
+    ltfat_int nlevels;
+    // Per filter
+    LTFAT_TYPE* grev;      //!< All filters, reversed
+    ltfat_int* goff;
+    ltfat_int* gl;
+    ltfat_int* a;
+    ltfat_int* offset;
+    ltfat_int* N;
+    ltfat_int* child;
+    ltfat_int* outidx;
+    // Per output
+    ltfat_int* outlen;
+    // Input buffers of all nodes for all channels
+    LTFAT_TYPE* arena;
+    ltfat_int arenalen;    //!< Length of the arena of one channel
+};
+
+/* Runs all filters of node k for channel w. The node input is in the
+ * arena, it is extended in place for every filter and the outputs go
+ * directly to the input buffers of the children or to c. */
+static void
+LTFAT_NAME(wfbt_node_execute)(LTFAT_NAME(wfbt_plan)* p, ltfat_int k,
+                              ltfat_int w, LTFAT_TYPE* c[])
+{
+    const LTFAT_NAME(wfbt_node)* nd = p->node + k;
+    LTFAT_TYPE* xbuf = p->arena + w * p->arenalen + nd->xoff;
+    LTFAT_TYPE* in = xbuf + nd->Pl;
+    ltfat_int Lin = nd->Lin;
+
+    for (ltfat_int m = nd->filt0; m < nd->filt0 + nd->M; m++)
+    {
+        ltfat_int gl = p->gl[m], a = p->a[m], N = p->N[m];
+        const LTFAT_TYPE* grev = p->grev + p->goff[m];
+        // x[0] is the first sample of the left extension
+        const LTFAT_TYPE* x = in - (gl - 1) - p->offset[m];
+        LTFAT_TYPE* out;
+
+        LTFAT_NAME(clear_array)(in - (gl - 1), gl - 1);
+        LTFAT_NAME(clear_array)(in + Lin, nd->Pr);
+        if (gl > 1)
+        {
+            LTFAT_NAME(extend_left)(in, Lin, in - (gl - 1), gl - 1, gl, p->ext, a);
+            LTFAT_NAME(extend_right)(in, Lin, in + Lin, gl, p->ext, a);
+        }
+
+        if (p->child[m] >= 0)
+        {
+            const LTFAT_NAME(wfbt_node)* ch = p->node + p->child[m];
+            out = p->arena + w * p->arenalen + ch->xoff + ch->Pl;
+        }
+        else
+            out = c[p->outidx[m]] + w * N;
+
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            const LTFAT_TYPE* xn = x + n * a;
+            LTFAT_TYPE acc = 0;
+
+            for (ltfat_int l = 0; l < gl; l++)
+                acc += xn[l] * grev[l];
+
+            out[n] = acc;
+        }
+
+        // Wavelet packets, the output is needed twice
+        if (p->child[m] >= 0 && p->outidx[m] >= 0)
+            memcpy(c[p->outidx[m]] + w * N, out, N * sizeof * out);
+    }
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_init)(ltfat_int nodes, const ltfat_int M[],
+                      const LTFAT_TYPE* g[], const ltfat_int gl[],
+                      const ltfat_int a[], const ltfat_int offset[],
+                      const ltfat_int child[], const ltfat_int outidx[],
+                      ltfat_int L, ltfat_int W, ltfatExtType ext,
+                      LTFAT_NAME(wfbt_plan)** pout)
+{
+    LTFAT_NAME(wfbt_plan)* p = NULL;
+    ltfat_int* depth = NULL;
+    ltfat_int* parent = NULL;
+    ltfat_int nfilt = 0, glsum = 0;
+
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(M); CHECKNULL(g); CHECKNULL(gl); CHECKNULL(a);
+    CHECKNULL(offset); CHECKNULL(child); CHECKNULL(outidx); CHECKNULL(pout);
+    CHECK(LTFATERR_NOTPOSARG, nodes > 0, "nodes (passed %td) must be positive.", nodes);
+    CHECK(LTFATERR_BADSIZE, L > 0, "L (passed %td) must be positive.", L);
+    CHECK(LTFATERR_NOTPOSARG, W > 0, "W (passed %td) must be positive.", W);
+    CHECK(LTFATERR_BADARG, ext < BAD_TYPE, "Unknown boundary extension type.");
+
+    for (ltfat_int k = 0; k < nodes; k++)
+    {
+        CHECK(LTFATERR_NOTPOSARG, M[k] > 0, "M[%td] (passed %td) must be positive.", k, M[k]);
+        nfilt += M[k];
+    }
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(wfbt_plan)) );
+    p->nodes = nodes; p->nfilt = nfilt; p->L = L; p->W = W; p->ext = ext;
+    p->nthreads = 1;
+
+    CHECKMEM( p->node = LTFAT_NEWARRAY(LTFAT_NAME(wfbt_node), nodes) );
+    CHECKMEM( p->order = LTFAT_NEWARRAY(ltfat_int, nodes) );
+    CHECKMEM( p->levelstart = LTFAT_NEWARRAY(ltfat_int, nodes + 1) );
+    CHECKMEM( p->goff = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( p->gl = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( p->a = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( p->offset = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( p->N = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( p->child = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( p->outidx = LTFAT_NEWARRAY(ltfat_int, nfilt) );
+    CHECKMEM( depth = LTFAT_NEWARRAY(ltfat_int, nodes) );
+    CHECKMEM( parent = LTFAT_NEWARRAY(ltfat_int, nodes) );
+
+    for (ltfat_int k = 0; k < nodes; k++)
+        parent[k] = -1;
+
+    depth[0] = 0;
+    p->node[0].Lin = L;
+    for (ltfat_int k = 0, m = 0; k < nodes; k++)
+    {
+        LTFAT_NAME(wfbt_node)* nd = p->node + k;
+        CHECK(LTFATERR_BADARG, k == 0 || parent[k] >= 0,
+              "Node %td is not connected to the tree.", k);
+        nd->M = M[k]; nd->filt0 = m;
+
+        for (ltfat_int mEnd = m + M[k]; m < mEnd; m++)
+        {
+            CHECKNULL(g[m]);
+            CHECK(LTFATERR_BADSIZE, gl[m] > 0, "gl[%td] (passed %td) must be positive.", m, gl[m]);
+            CHECK(LTFATERR_NOTPOSARG, a[m] > 0, "a[%td] (passed %td) must be positive.", m, a[m]);
+            CHECK(LTFATERR_BADARG, offset[m] <= 0 && offset[m] > -gl[m],
+                  "offset[%td] (passed %td) must be in range [%td,0].", m, offset[m], -gl[m] + 1);
+            CHECK(LTFATERR_BADARG, child[m] >= 0 || outidx[m] >= 0,
+                  "Output of filter %td goes nowhere.", m);
+
+            p->gl[m] = gl[m]; p->a[m] = a[m]; p->offset[m] = offset[m];
+            p->child[m] = child[m]; p->outidx[m] = outidx[m];
+            p->goff[m] = glsum; glsum += gl[m];
+            p->N[m] = filterbank_td_size(nd->Lin, a[m], gl[m], offset[m], ext);
+            CHECK(LTFATERR_BADREQSIZE, p->N[m] > 0,
+                  "Filter %td produces no output for input length %td.", m, nd->Lin);
+
+            if (child[m] >= 0)
+            {
+                CHECK(LTFATERR_BADARG, child[m] > k && child[m] < nodes && parent[child[m]] < 0,
+                      "child[%td] (passed %td) must be an unused node after node %td.",
+                      m, child[m], k);
+                parent[child[m]] = k;
+                depth[child[m]] = depth[k] + 1;
+                p->node[child[m]].Lin = p->N[m];
+            }
+
+            if (outidx[m] >= 0)
+                p->nout = ltfat_imax(p->nout, outidx[m] + 1);
+        }
+    }
+
+    // Every output must be written exactly once
+    CHECKMEM( p->outlen = LTFAT_NEWARRAY(ltfat_int, p->nout) );
+    for (ltfat_int m = 0; m < nfilt; m++)
+    {
+        if (outidx[m] < 0) continue;
+        CHECK(LTFATERR_BADARG, p->outlen[outidx[m]] == 0,
+              "Output %td is written by more than one filter.", outidx[m]);
+        p->outlen[outidx[m]] = p->N[m];
+    }
+    for (ltfat_int o = 0; o < p->nout; o++)
+        CHECK(LTFATERR_BADARG, p->outlen[o] > 0, "Output %td is not written.", o);
+
+    CHECKMEM( p->grev = LTFAT_NAME(malloc)(glsum) );
+    for (ltfat_int m = 0; m < nfilt; m++)
+        LTFAT_NAME(reverse_array)(g[m], gl[m], p->grev + p->goff[m]);
+
+    // Input buffers, each with room for the extensions
+    for (ltfat_int k = 0; k < nodes; k++)
+    {
+        LTFAT_NAME(wfbt_node)* nd = p->node + k;
+        for (ltfat_int m = nd->filt0; m < nd->filt0 + nd->M; m++)
+        {
+            nd->Pl = ltfat_imax(nd->Pl, gl[m] - 1);
+            nd->Pr = ltfat_imax(nd->Pr, gl[m]);
+        }
+        nd->xoff = p->arenalen;
+        p->arenalen += nd->Pl + nd->Lin + nd->Pr;
+    }
+    CHECKMEM( p->arena = LTFAT_NAME(calloc)(p->arenalen * W) );
+
+    // Nodes at the same depth are independent
+    for (ltfat_int d = 0, kk = 0; kk < nodes; d++)
+    {
+        p->levelstart[p->nlevels++] = kk;
+        for (ltfat_int k = 0; k < nodes; k++)
+            if (depth[k] == d) p->order[kk++] = k;
+    }
+    p->levelstart[p->nlevels] = nodes;
+
+    LTFAT_SAFEFREEALL(depth, parent);
+    *pout = p;
+    return status;
+error:
+    LTFAT_SAFEFREEALL(depth, parent);
+    if (p) LTFAT_NAME(wfbt_done)(&p);
+    if (pout) *pout = NULL;
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_set_nthreads)(LTFAT_NAME(wfbt_plan)* p, ltfat_int nthreads)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    CHECK(LTFATERR_NOTPOSARG, nthreads > 0,
+          "nthreads (passed %td) must be positive.", nthreads);
+    p->nthreads = nthreads;
+error:
+    return status;
+}
+
+LTFAT_API ltfat_int
+LTFAT_NAME(wfbt_get_nout)(LTFAT_NAME(wfbt_plan)* p)
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p);
+    return p->nout;
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_get_outlens)(LTFAT_NAME(wfbt_plan)* p, ltfat_int Lc[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(Lc);
+    memcpy(Lc, p->outlen, p->nout * sizeof * Lc);
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_execute)(LTFAT_NAME(wfbt_plan)* p, const LTFAT_TYPE f[],
+                         LTFAT_TYPE* c[])
+{
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    for (ltfat_int o = 0; o < p->nout; o++)
+        CHECKNULL(c[o]);
+
+    for (ltfat_int w = 0; w < p->W; w++)
+        memcpy(p->arena + w * p->arenalen + p->node[0].xoff + p->node[0].Pl,
+               f + w * p->L, p->L * sizeof * f);
+
+    for (ltfat_int lev = 0; lev < p->nlevels; lev++)
+    {
+        ltfat_int k0 = p->levelstart[lev];
+        ltfat_int nitems = (p->levelstart[lev + 1] - k0) * p->W;
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic) num_threads(ltfat_imin(p->nthreads, nitems))
+#endif
+        for (ltfat_int it = 0; it < nitems; it++)
+            LTFAT_NAME(wfbt_node_execute)(p, p->order[k0 + it / p->W], it % p->W, c);
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wfbt_done)(LTFAT_NAME(wfbt_plan)** p)
+{
+    LTFAT_NAME(wfbt_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+    LTFAT_SAFEFREEALL(pp->node, pp->order, pp->levelstart, pp->grev, pp->goff,
+                      pp->gl, pp->a, pp->offset, pp->N, pp->child, pp->outidx,
+                      pp->outlen, pp->arena);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -176,3 +176,115 @@ LTFAT_NAME_REAL(dwiltiii_fb)(const LTFAT_REAL* f, const LTFAT_REAL* g,
 #undef POSTPROC_REAL
 #undef POSTPROC_COMPLEX
 #undef PREPROC
+
+#include "dwilt_private.h"
+
+struct LTFAT_NAME(wmdct_plan)
+{
+    LTFAT_NAME(wilson_fold) fo;
+    LTFAT_NAME(ifftreal_plan)* p_ifft;
+    LTFAT_REAL* y;     //!< Folded column, 2M
+    LTFAT_COMPLEX* wh; //!< IFFT input, M/2 + 1
+    LTFAT_REAL* v;     //!< IFFT output, M
+    LTFAT_COMPLEX* tw; //!< exp(i*pi*k/(2M))
+};
+
+LTFAT_API int
+LTFAT_NAME(wmdct_init)(const LTFAT_REAL g[], ltfat_int gl, ltfat_int L,
+                       ltfat_int W, ltfat_int M, unsigned flags,
+                       LTFAT_NAME(wmdct_plan)** pout)
+{
+    LTFAT_NAME(wmdct_plan)* p = NULL;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(pout);
+
+    CHECKMEM( p = LTFAT_NEW(LTFAT_NAME(wmdct_plan)) );
+    CHECKSTATUS( LTFAT_NAME(wilson_fold_init)(g, gl, L, W, M, 1, &p->fo));
+
+    CHECKMEM( p->y  = LTFAT_NAME_REAL(malloc)(2 * M) );
+    CHECKMEM( p->wh = LTFAT_NAME_COMPLEX(malloc)(M / 2 + 1) );
+    CHECKMEM( p->v  = LTFAT_NAME_REAL(malloc)(M) );
+    CHECKMEM( p->tw = LTFAT_NAME_COMPLEX(malloc)(M) );
+
+    for (ltfat_int k = 0; k < M; k++)
+        p->tw[k] = exp(I * (LTFAT_REAL) (M_PI * k / (2.0 * M)));
+
+    CHECKSTATUS( LTFAT_NAME(ifftreal_init)(M, 1, p->wh, p->v, flags, &p->p_ifft));
+
+    *pout = p;
+    return status;
+error:
+    if (p) LTFAT_NAME(wmdct_done)(&p);
+    return status;
+}
+
+/*
+ * With y folded to 2M (every other 2M segment negated), the coefficients of
+ * column n are
+ *
+ *   c(m,n) = s_n sum_{k<M} r(k) cos(pi*(m+1/2)*k/M),  s_n = +1,+1,-1,-1,...
+ *
+ * with r(0) = y(0) - y(M) and r(k) = y(k) - y(2M-k) - y(M-k) - y(M+k), i.e.
+ * a DCT-III of length M. It is evaluated as an inverse real FFT followed by
+ * the even-odd interleaving.
+ * */
+LTFAT_API int
+LTFAT_NAME(wmdct_execute)(LTFAT_NAME(wmdct_plan)* p, const LTFAT_REAL f[],
+                          LTFAT_REAL c[])
+{
+    ltfat_int M, L, N;
+    const LTFAT_REAL half = (LTFAT_REAL) 0.5;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(f); CHECKNULL(c);
+    M = p->fo.M; L = p->fo.L; N = p->fo.N;
+
+    for (ltfat_int w = 0; w < p->fo.W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            const LTFAT_REAL* y = p->y;
+            LTFAT_REAL* cn = c + n * M + w * M * N;
+            LTFAT_REAL sgn = (n % 4) < 2 ? 1.0 : -1.0;
+
+            LTFAT_NAME(wilson_fold_execute)(&p->fo, f + w * L, n, p->y);
+
+            /* Hermitian part of r(k)*exp(i*pi*k/(2M)) */
+            p->wh[0] = y[0] - y[M];
+            for (ltfat_int k = 1; k <= M / 2; k++)
+            {
+                ltfat_int km = M - k;
+                LTFAT_REAL rk  = y[k]  - y[2 * M - k]  - y[M - k]  - y[M + k];
+                LTFAT_REAL rkm = y[km] - y[2 * M - km] - y[M - km] - y[M + km];
+                p->wh[k] = half * (rk * p->tw[k] + rkm * conj(p->tw[km]));
+            }
+
+            LTFAT_NAME(ifftreal_execute)(p->p_ifft);
+
+            for (ltfat_int m = 0; 2 * m < M; m++)
+                cn[2 * m] = sgn * p->v[m];
+
+            for (ltfat_int m = 0; 2 * m + 1 < M; m++)
+                cn[2 * m + 1] = sgn * p->v[M - 1 - m];
+        }
+    }
+
+error:
+    return status;
+}
+
+LTFAT_API int
+LTFAT_NAME(wmdct_done)(LTFAT_NAME(wmdct_plan)** p)
+{
+    LTFAT_NAME(wmdct_plan)* pp;
+    int status = LTFATERR_SUCCESS;
+    CHECKNULL(p); CHECKNULL(*p);
+    pp = *p;
+
+    if (pp->p_ifft) LTFAT_NAME(ifftreal_done)(&pp->p_ifft);
+    LTFAT_NAME(wilson_fold_done)(&pp->fo);
+    LTFAT_SAFEFREEALL(pp->y, pp->wh, pp->v, pp->tw);
+    ltfat_free(pp);
+    *p = NULL;
+error:
+    return status;
+}
@@ -21,6 +21,16 @@ void all_tests()
     mu_run_test_singledoublecomplex(test_idgt_fb);
     mu_run_test_singledoublecomplex(test_dgt_long);
     mu_run_test_singledoublecomplex(test_idgt_long);
+    mu_run_test_singledoublecomplex(test_dctdst);
+    mu_run_test_singledoublecomplex(test_gabreassign_plan);
+    mu_run_test_singledoublecomplex(test_filterbankreassign_plan);
+    mu_run_test_singledoublecomplex(test_gga);
+    mu_run_test_singledoublecomplex(test_chzt);
+    mu_run_test_singledoublecomplex(test_wfac);
+    mu_run_test_singledoublecomplex(test_gabtight_long);
+    mu_run_test_singledoublecomplex(test_gabdual_batch);
+    mu_run_test_singledoublecomplex(test_wfbt);
+    mu_run_test_singledoublecomplex(test_pfilt);
     mu_run_test_singledouble(test_dgtreal_fb);
     mu_run_test_singledouble(test_idgtreal_fb);
     mu_run_test_singledouble(test_dgtreal_long);
@@ -32,6 +42,23 @@ void all_tests()
     mu_run_test_singledouble(test_fftrealcircshift);
     mu_run_test_singledouble(test_fftrealfftshift);
     mu_run_test_singledouble(test_fftrealifftshift);
+    mu_run_test_singledouble(test_dgtrealmp_atoms);
+    mu_run_test_singledouble(test_dgtrealmp_kernbank);
+    mu_run_test_singledouble(test_dgtrealmp_errresync);
+    mu_run_test_singledouble(test_dgtreal_strided);
+    mu_run_test_singledouble(test_dgtreal_olastream);
+    mu_run_test_singledouble(test_dwilt_plan);
+    mu_run_test_singledouble(test_fft_primes);
+    mu_run_test_singledouble(test_dgtreal_shear);
+    mu_run_test_singledouble(test_fwt_processor);
+    mu_run_test_singledouble(test_nsdgtreal);
+    mu_run_test_singledouble(test_quadtfdist);
+    mu_run_test_singledouble(test_dgtreal_lasso);
+    mu_run_test_singledouble(test_gabmulreal);
+    mu_run_test_singledouble(test_spreadop);
+    mu_run_test_singledouble(test_filterbankphasereassign);
+    mu_run_test_singledouble(test_ifilterbank);
+    mu_run_test_singledouble(test_nativelinalg);
 
     mu_suite_stop();
 }
@@ -0,0 +1,99 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+int TEST_NAME(test_chzt)()
+{
+    ltfat_int L[] = { 1, 16, 100, 333};
+    ltfat_int K[] = { 3,  7, 100,  40};
+    ltfat_int W[] = { 1,  3,   2,   5};
+    ltfat_int Wbatch[] = { 1, 2 };
+    czt_ffthint hint[] = { CZT_NEXTFASTFFT, CZT_NEXTPOW2 };
+    LTFAT_REAL deltao = (LTFAT_REAL) (2.0 * M_PI / 150.0);
+    LTFAT_REAL o = (LTFAT_REAL) 0.3;
+    // Relative tolerance, the chirps lose precision in single for large L
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-3;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int KW = K[id] * W[id];
+        LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id] * W[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(KW);
+        LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(KW);
+        double nrm = 0.0;
+
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+
+        for (ltfat_int w = 0; w < W[id]; w++)
+            for (ltfat_int k = 0; k < K[id]; k++)
+            {
+                LTFAT_COMPLEX acc = 0.0;
+                for (ltfat_int l = 0; l < L[id]; l++)
+                {
+                    double ph = -((double) o + k * (double) deltao) * l;
+                    acc += f[l + w * L[id]] * ((LTFAT_REAL) cos(ph) + I * (LTFAT_REAL) sin(ph));
+                }
+                cref[k + w * K[id]] = acc;
+                nrm = fmax(nrm, ltfat_abs(acc));
+            }
+
+        for (ltfat_int bId = 0; bId < (ltfat_int) ARRAYLEN(Wbatch); bId++)
+        {
+            LTFAT_NAME(chzt_plan) p = NULL, pfac = NULL;
+            double err = 0.0, errfac = 0.0;
+
+            mu_assert( LTFAT_NAME(chzt_init_batch)(K[id], L[id], Wbatch[bId], deltao, o,
+                       FFTW_ESTIMATE, hint[bId], &p) == LTFATERR_SUCCESS, "chzt_init_batch");
+            mu_assert( LTFAT_NAME(chzt_fac_init_batch)(K[id], L[id], Wbatch[bId], deltao, o,
+                       FFTW_ESTIMATE, hint[bId], &pfac) == LTFATERR_SUCCESS,
+                       "chzt_fac_init_batch");
+
+            // W need not be a multiple of the batch size
+            LTFAT_NAME(chzt_execute)(p, f, W[id], c);
+            for (ltfat_int l = 0; l < KW; l++)
+                err = fmax(err, ltfat_abs(c[l] - cref[l]));
+
+            LTFAT_NAME(chzt_fac_execute)(pfac, f, W[id], c);
+            for (ltfat_int l = 0; l < KW; l++)
+                errfac = fmax(errfac, ltfat_abs(c[l] - cref[l]));
+
+            mu_assert( err < tol * nrm, "chzt, L=%d, K=%d, Wbatch=%d, err=%g",
+                       (int) L[id], (int) K[id], (int) Wbatch[bId], err);
+            mu_assert( errfac < tol * nrm, "chzt_fac, L=%d, K=%d, Wbatch=%d, err=%g",
+                       (int) L[id], (int) K[id], (int) Wbatch[bId], errfac);
+
+            LTFAT_NAME(chzt_done)(p);
+            LTFAT_NAME(chzt_done)(pfac);
+        }
+
+        // One-shot functions
+        {
+            double err = 0.0;
+            LTFAT_NAME(chzt)(f, L[id], W[id], K[id], deltao, o, c);
+            for (ltfat_int l = 0; l < KW; l++)
+                err = fmax(err, ltfat_abs(c[l] - cref[l]));
+            mu_assert( err < tol * nrm, "chzt one-shot, L=%d, err=%g", (int) L[id], err);
+
+            err = 0.0;
+            LTFAT_NAME(chzt_fac)(f, L[id], W[id], K[id], deltao, o, c);
+            for (ltfat_int l = 0; l < KW; l++)
+                err = fmax(err, ltfat_abs(c[l] - cref[l]));
+            mu_assert( err < tol * nrm, "chzt_fac one-shot, L=%d, err=%g", (int) L[id], err);
+        }
+
+        ltfat_free(f); ltfat_free(c); ltfat_free(cref);
+    }
+
+    {
+        LTFAT_NAME(chzt_plan) p = NULL;
+        mu_assert( LTFAT_NAME(chzt_init_batch)(4, 0, 1, deltao, o, FFTW_ESTIMATE,
+                   CZT_NEXTFASTFFT, &p) == LTFATERR_BADSIZE, "chzt_init_batch: L is not positive");
+        mu_assert( LTFAT_NAME(chzt_init_batch)(4, 8, 0, deltao, o, FFTW_ESTIMATE,
+                   CZT_NEXTFASTFFT, &p) == LTFATERR_NOTPOSARG, "chzt_init_batch: W is not positive");
+        mu_assert( LTFAT_NAME(chzt_fac_init_batch)(0, 8, 1, deltao, o, FFTW_ESTIMATE,
+                   CZT_NEXTFASTFFT, &p) == LTFATERR_NOTPOSARG,
+                   "chzt_fac_init_batch: K is not positive");
+        mu_assert( LTFAT_NAME(chzt_fac_init_batch)(4, 8, 1, deltao, o, FFTW_ESTIMATE,
+                   CZT_NEXTFASTFFT, NULL) == LTFATERR_NULLPOINTER, "chzt_fac_init_batch: NULL");
+    }
+
+    return 0;
+}
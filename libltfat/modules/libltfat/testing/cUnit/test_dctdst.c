@@ -0,0 +1,134 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* Element (k,l) of the orthonormal DCT (dst == 0) or DST (dst == 1) matrix
+ * of the given type 1-4 */
+double TEST_NAME(dctdst_coef)(int dst, int type, ltfat_int L, ltfat_int k, ltfat_int l)
+{
+    double s2 = 1.0 / sqrt(2.0);
+
+    if (!dst)
+    {
+        switch (type)
+        {
+        case 1:
+            return sqrt(2.0 / (L - 1)) * (k == 0 || k == L - 1 ? s2 : 1.0) *
+                   (l == 0 || l == L - 1 ? s2 : 1.0) * cos(M_PI * l * k / (L - 1));
+        case 2:
+            return sqrt(2.0 / L) * (k == 0 ? s2 : 1.0) * cos(M_PI * (l + 0.5) * k / L);
+        case 3:
+            return sqrt(2.0 / L) * (l == 0 ? s2 : 1.0) * cos(M_PI * l * (k + 0.5) / L);
+        default:
+            return sqrt(2.0 / L) * cos(M_PI * (l + 0.5) * (k + 0.5) / L);
+        }
+    }
+
+    switch (type)
+    {
+    case 1:
+        return sqrt(2.0 / (L + 1)) * sin(M_PI * (l + 1) * (k + 1) / (L + 1));
+    case 2:
+        return sqrt(2.0 / L) * (k == L - 1 ? s2 : 1.0) * sin(M_PI * (l + 0.5) * (k + 1) / L);
+    case 3:
+        return sqrt(2.0 / L) * (l == L - 1 ? s2 : 1.0) * sin(M_PI * (l + 1) * (k + 0.5) / L);
+    default:
+        return sqrt(2.0 / L) * sin(M_PI * (l + 0.5) * (k + 0.5) / L);
+    }
+}
+
+int TEST_NAME(test_dctdst)()
+{
+    ltfat_int L[] = { 2, 7, 8, 15, 64, 99};
+    ltfat_int W = 2;
+    dct_kind dctkinds[] = { DCTI, DCTII, DCTIII, DCTIV };
+    dst_kind dstkinds[] = { DSTI, DSTII, DSTIII, DSTIV };
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id] * W);
+        LTFAT_TYPE* c = LTFAT_NAME(malloc)(L[id] * W);
+        LTFAT_TYPE* cref = LTFAT_NAME(malloc)(L[id] * W);
+        TEST_NAME(fillRand)(f, L[id] * W);
+
+        for (int dst = 0; dst < 2; dst++)
+        {
+            for (int type = 1; type <= 4; type++)
+            {
+                LTFAT_NAME(dct_plan)* pc = NULL;
+                LTFAT_NAME(dst_plan)* ps = NULL;
+                double err = 0.0;
+
+                for (ltfat_int w = 0; w < W; w++)
+                    for (ltfat_int k = 0; k < L[id]; k++)
+                    {
+                        LTFAT_TYPE acc = 0.0;
+                        for (ltfat_int l = 0; l < L[id]; l++)
+                            acc += (LTFAT_REAL) TEST_NAME(dctdst_coef)(dst, type, L[id], k, l) *
+                                   f[l + w * L[id]];
+                        cref[k + w * L[id]] = acc;
+                    }
+
+                if (dst)
+                {
+                    mu_assert( LTFAT_NAME(dst_init)(L[id], W, dstkinds[type - 1],
+                                                    FFTW_ESTIMATE, &ps) == LTFATERR_SUCCESS, "dst_init");
+                    LTFAT_NAME(dst_execute)(ps, f, c);
+                }
+                else
+                {
+                    mu_assert( LTFAT_NAME(dct_init)(L[id], W, dctkinds[type - 1],
+                                                    FFTW_ESTIMATE, &pc) == LTFATERR_SUCCESS, "dct_init");
+                    LTFAT_NAME(dct_execute)(pc, f, c);
+                }
+
+                for (ltfat_int l = 0; l < L[id] * W; l++)
+                    err = fmax(err, ltfat_abs(c[l] - cref[l]));
+                mu_assert( err < tol, "%s-%d, L=%d, err=%g", dst ? "DST" : "DCT", type,
+                           (int) L[id], err);
+
+                // In place, reusing the plan
+                memcpy(c, f, L[id] * W * sizeof * c);
+                if (dst)
+                    LTFAT_NAME(dst_execute)(ps, c, c);
+                else
+                    LTFAT_NAME(dct_execute)(pc, c, c);
+
+                err = 0.0;
+                for (ltfat_int l = 0; l < L[id] * W; l++)
+                    err = fmax(err, ltfat_abs(c[l] - cref[l]));
+                mu_assert( err < tol, "%s-%d in place, L=%d, err=%g", dst ? "DST" : "DCT",
+                           type, (int) L[id], err);
+
+                // One-shot functions
+                if (dst)
+                    mu_assert( LTFAT_NAME(dst)(f, L[id], W, c, dstkinds[type - 1])
+                               == LTFATERR_SUCCESS, "dst");
+                else
+                    mu_assert( LTFAT_NAME(dct)(f, L[id], W, c, dctkinds[type - 1])
+                               == LTFATERR_SUCCESS, "dct");
+
+                err = 0.0;
+                for (ltfat_int l = 0; l < L[id] * W; l++)
+                    err = fmax(err, ltfat_abs(c[l] - cref[l]));
+                mu_assert( err < tol, "%s-%d one-shot, L=%d, err=%g", dst ? "DST" : "DCT",
+                           type, (int) L[id], err);
+
+                if (pc) LTFAT_NAME(dct_done)(&pc);
+                if (ps) LTFAT_NAME(dst_done)(&ps);
+            }
+        }
+
+        ltfat_free(f); ltfat_free(c); ltfat_free(cref);
+    }
+
+    {
+        LTFAT_NAME(dct_plan)* pc = NULL;
+        mu_assert( LTFAT_NAME(dct_init)(0, 1, DCTII, FFTW_ESTIMATE, &pc) != LTFATERR_SUCCESS,
+                   "dct_init: L is not positive");
+        mu_assert( LTFAT_NAME(dct_init)(8, 1, DCTII, FFTW_ESTIMATE, NULL)
+                   == LTFATERR_NULLPOINTER, "dct_init: NULL");
+        mu_assert( LTFAT_NAME(dct_done)(NULL) == LTFATERR_NULLPOINTER, "dct_done: NULL");
+    }
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* Plain ISTA/FISTA of franalasso and franagrouplasso on the long DGTREAL */
+void TEST_NAME(dgtreal_lasso_ref)(const LTFAT_REAL* f, const LTFAT_REAL* g,
+                                  ltfat_int L, ltfat_int W, ltfat_int a, ltfat_int M,
+                                  ltfat_lasso_type type, ltfat_lasso_alg alg,
+                                  double C, double lambda, ltfat_int maxit,
+                                  LTFAT_COMPLEX* c)
+{
+    ltfat_int M2 = M / 2 + 1, N = L / a, ncoef = M2 * N * W;
+    LTFAT_COMPLEX* c0 = LTFAT_NAME_COMPLEX(malloc)(ncoef);
+    LTFAT_COMPLEX* z = LTFAT_NAME_COMPLEX(malloc)(ncoef);
+    LTFAT_COMPLEX* v = LTFAT_NAME_COMPLEX(malloc)(ncoef);
+    LTFAT_REAL* fs = LTFAT_NAME_REAL(malloc)(L * W);
+    double tau0 = 1.0;
+
+    LTFAT_NAME(dgtreal_long)(f, g, L, W, a, M, LTFAT_FREQINV, c0);
+    for (ltfat_int k = 0; k < ncoef; k++)
+        c[k] = z[k] = c0[k];
+
+    for (ltfat_int it = 0; it < maxit; it++)
+    {
+        const LTFAT_COMPLEX* x = alg == LTFAT_FISTA ? z : c;
+        double beta = 0.0;
+
+        LTFAT_NAME(idgtreal_long)(x, g, L, W, a, M, LTFAT_FREQINV, fs);
+        LTFAT_NAME(dgtreal_long)(fs, g, L, W, a, M, LTFAT_FREQINV, v);
+        for (ltfat_int k = 0; k < ncoef; k++)
+            v[k] = x[k] + (c0[k] - v[k]) / (LTFAT_REAL) C;
+
+        if (alg == LTFAT_FISTA)
+        {
+            double tau = 0.5 * (1.0 + sqrt(1.0 + 4.0 * tau0 * tau0));
+            beta = (tau0 - 1.0) / tau;
+            tau0 = tau;
+        }
+
+        for (ltfat_int w = 0; w < W; w++)
+        {
+            for (ltfat_int n = 0; n < N; n++)
+            {
+                for (ltfat_int m = 0; m < M2; m++)
+                {
+                    ltfat_int k = m + n * M2 + w * M2 * N;
+                    double nrm = 0.0, gain;
+
+                    if (type == LTFAT_LASSO)
+                        nrm = ltfat_abs(v[k]);
+                    else if (type == LTFAT_GROUPLASSO_TIME)
+                        for (ltfat_int mm = 0; mm < M2; mm++)
+                            nrm += ltfat_energy(v[mm + n * M2 + w * M2 * N]);
+                    else
+                        for (ltfat_int nn = 0; nn < N; nn++)
+                            nrm += ltfat_energy(v[m + nn * M2 + w * M2 * N]);
+
+                    if (type != LTFAT_LASSO)
+                        nrm = sqrt(nrm);
+
+                    gain = nrm > lambda / C ? 1.0 - lambda / C / nrm : 0.0;
+                    z[k] = v[k] * (LTFAT_REAL) gain;
+                }
+            }
+        }
+
+        // z holds the new coefficients
+        for (ltfat_int k = 0; k < ncoef; k++)
+        {
+            LTFAT_COMPLEX cnew = z[k];
+            z[k] = cnew + (LTFAT_REAL) beta * (cnew - c[k]);
+            c[k] = cnew;
+        }
+    }
+
+    ltfat_free(c0); ltfat_free(z); ltfat_free(v); ltfat_free(fs);
+}
+
+int TEST_NAME(dgtreal_lasso_stop)(LTFAT_NAME(dgtreal_plan)* UNUSED(p),
+                                  void* UNUSED(userdata), LTFAT_COMPLEX UNUSED(c[]),
+                                  ltfat_int UNUSED(L), ltfat_int UNUSED(W),
+                                  ltfat_int UNUSED(a), ltfat_int UNUSED(M),
+                                  double* UNUSED(lambda), double UNUSED(relres),
+                                  ltfat_int iter)
+{
+    return iter >= 3;
+}
+
+int TEST_NAME(test_dgtreal_lasso)()
+{
+    ltfat_int L = 96, W = 2, a = 8, M = 16, M2 = M / 2 + 1, N = L / a;
+    ltfat_int ncoef = M2 * N * W, maxit = 25;
+    // Painless and not painless window lengths
+    ltfat_int gl[] = { 16, 40};
+    ltfat_lasso_type type[] = { LTFAT_LASSO, LTFAT_GROUPLASSO_TIME, LTFAT_GROUPLASSO_FREQ};
+    ltfat_lasso_alg alg[] = { LTFAT_ISTA, LTFAT_FISTA};
+    double lambda = 0.1;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(40);
+    LTFAT_REAL* glong = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* x = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* y = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_COMPLEX* cx = LTFAT_NAME_COMPLEX(malloc)(M2 * N);
+    LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(ncoef);
+    LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(ncoef);
+    LTFAT_NAME(dgtreal_lasso_plan)* p = NULL;
+
+    TEST_NAME(fillRand)(f, L * W);
+    TEST_NAME(fillRand)(g, 40);
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(gl); id++)
+    {
+        double B = 0.0, C;
+
+        LTFAT_NAME(fir2long)(g, gl[id], L, glong);
+        if (gl[id] <= M)
+        {
+            // The frame operator is diagonal, M*sum_n |g(l-na)|^2
+            for (ltfat_int l = 0; l < a; l++)
+            {
+                double d = 0.0;
+                for (ltfat_int n = 0; n < N; n++)
+                    d += glong[ltfat_positiverem(l - n * a, L)] *
+                         glong[ltfat_positiverem(l - n * a, L)];
+                B = fmax(B, M * d);
+            }
+        }
+        else
+        {
+            // Largest eigenvalue of the frame operator by a long power iteration
+            for (ltfat_int l = 0; l < L; l++)
+                x[l] = 1.0;
+            for (ltfat_int it = 0; it < 2000; it++)
+            {
+                double nrm = 0.0, xy = 0.0;
+                for (ltfat_int l = 0; l < L; l++)
+                    nrm += x[l] * x[l];
+                for (ltfat_int l = 0; l < L; l++)
+                    x[l] /= (LTFAT_REAL) sqrt(nrm);
+                LTFAT_NAME(dgtreal_long)(x, glong, L, 1, a, M, LTFAT_FREQINV, cx);
+                LTFAT_NAME(idgtreal_long)(cx, glong, L, 1, a, M, LTFAT_FREQINV, y);
+                for (ltfat_int l = 0; l < L; l++)
+                {
+                    xy += x[l] * y[l];
+                    x[l] = y[l];
+                }
+                B = xy;
+            }
+        }
+
+        mu_assert( LTFAT_NAME(dgtreal_lasso_init)(g, gl[id], L, W, a, M, LTFAT_LASSO,
+                   LTFAT_ISTA, 0.0, NULL, &p) == LTFATERR_SUCCESS, "dgtreal_lasso_init");
+        C = LTFAT_NAME(dgtreal_lasso_get_C)(p);
+        if (gl[id] <= M)
+            mu_assert( fabs(C - B) < tol * B, "dgtreal_lasso painless C=%g, B=%g", C, B);
+        else
+            mu_assert( C >= B && C <= 1.06 * B, "dgtreal_lasso C=%g, B=%g", C, B);
+        LTFAT_NAME(dgtreal_lasso_done)(&p);
+
+        for (ltfat_int t = 0; t < (ltfat_int) ARRAYLEN(type); t++)
+        {
+            for (ltfat_int al = 0; al < (ltfat_int) ARRAYLEN(alg); al++)
+            {
+                double err = 0.0, nrm = 0.0;
+
+                mu_assert( LTFAT_NAME(dgtreal_lasso_init)(g, gl[id], L, W, a, M, type[t],
+                           alg[al], 0.0, NULL, &p) == LTFATERR_SUCCESS,
+                           "dgtreal_lasso_init");
+                mu_assert( LTFAT_NAME(dgtreal_lasso_execute)(p, f, lambda, maxit, 0.0, c)
+                           == LTFATERR_SUCCESS, "dgtreal_lasso_execute");
+                mu_assert( LTFAT_NAME(dgtreal_lasso_get_iter)(p) == maxit,
+                           "dgtreal_lasso_get_iter");
+
+                TEST_NAME(dgtreal_lasso_ref)(f, glong, L, W, a, M, type[t], alg[al],
+                                             LTFAT_NAME(dgtreal_lasso_get_C)(p),
+                                             lambda, maxit, cref);
+                for (ltfat_int k = 0; k < ncoef; k++)
+                {
+                    err = fmax(err, ltfat_abs(c[k] - cref[k]));
+                    nrm = fmax(nrm, ltfat_abs(cref[k]));
+                }
+                mu_assert( err < tol * nrm, "dgtreal_lasso gl=%d, type=%d, alg=%d, err=%g",
+                           (int) gl[id], (int) type[t], (int) alg[al], err);
+
+                LTFAT_NAME(dgtreal_lasso_done)(&p);
+            }
+        }
+    }
+
+    // The callback can stop the iterations
+    mu_assert( LTFAT_NAME(dgtreal_lasso_init)(g, gl[0], L, W, a, M, LTFAT_LASSO,
+               LTFAT_FISTA, 0.0, NULL, &p) == LTFATERR_SUCCESS, "dgtreal_lasso_init");
+    mu_assert( LTFAT_NAME(dgtreal_lasso_set_status_callback)(p,
+               &TEST_NAME(dgtreal_lasso_stop), NULL) == LTFATERR_SUCCESS,
+               "dgtreal_lasso_set_status_callback");
+    mu_assert( LTFAT_NAME(dgtreal_lasso_execute)(p, f, lambda, maxit, 0.0, c)
+               == LTFATERR_SUCCESS, "dgtreal_lasso_execute");
+    mu_assert( LTFAT_NAME(dgtreal_lasso_get_iter)(p) == 3, "dgtreal_lasso callback stop");
+    mu_assert( LTFAT_NAME(dgtreal_lasso_execute)(p, f, -1.0, maxit, 0.0, c)
+               == LTFATERR_BADARG, "dgtreal_lasso_execute negative lambda");
+    LTFAT_NAME(dgtreal_lasso_done)(&p);
+
+    p = (LTFAT_NAME(dgtreal_lasso_plan)*) g;
+    mu_assert( LTFAT_NAME(dgtreal_lasso_init)(g, gl[0], L, W, a, M, (ltfat_lasso_type) 7,
+               LTFAT_ISTA, 0.0, NULL, &p) == LTFATERR_BADARG, "dgtreal_lasso_init bad type");
+    mu_assert( p == NULL, "dgtreal_lasso_init should set the plan to NULL on failure");
+
+    ltfat_free(f); ltfat_free(g); ltfat_free(glong); ltfat_free(x); ltfat_free(y);
+    ltfat_free(cx); ltfat_free(c); ltfat_free(cref);
+    return 0;
+}
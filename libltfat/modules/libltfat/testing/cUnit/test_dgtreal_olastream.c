@@ -0,0 +1,152 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+int TEST_NAME(test_dgtreal_olastream)()
+{
+    ltfat_int L[]  = { 480, 720, 960};
+    ltfat_int gl[] = {  48,  96, 120};
+    ltfat_int a[]  = {  12,  24,  30};
+    ltfat_int M[]  = {  48,  96, 120};
+    ltfat_int bl[] = {  48, 120, 240};
+    ltfat_int W[]  = {   1,   2,   1};
+    ltfat_int chunks[] = { 7, 0, 61, 1, 130 };
+    ltfat_phaseconvention ptype[] = { LTFAT_FREQINV, LTFAT_TIMEINV };
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int N = L[id] / a[id], M2 = M[id] / 2 + 1;
+        ltfat_int glh = gl[id] / 2;
+        // Long transform of the zero-padded signal as a reference
+        ltfat_int Lpad = ltfat_idivceil(L[id] + gl[id], ltfat_lcm(a[id], M[id])) *
+                         ltfat_lcm(a[id], M[id]);
+        ltfat_int Npad = Lpad / a[id];
+        LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(gl[id]);
+        LTFAT_REAL* gd = LTFAT_NAME_REAL(malloc)(gl[id]);
+        LTFAT_REAL* glong = LTFAT_NAME_REAL(malloc)(Lpad);
+        LTFAT_REAL* f = LTFAT_NAME_REAL(calloc)(L[id] * W[id]);
+        LTFAT_REAL* fpad = LTFAT_NAME_REAL(calloc)(Lpad * W[id]);
+        LTFAT_REAL* fr = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+        LTFAT_COMPLEX* cpad = LTFAT_NAME_COMPLEX(malloc)(M2 * Npad * W[id]);
+        LTFAT_REAL* fchunk = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_COMPLEX* cchunk = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[id], g);
+        LTFAT_NAME_REAL(gabdual_painless)(g, gl[id], a[id], M[id], gd);
+        LTFAT_NAME_REAL(fir2long)(g, gl[id], Lpad, glong);
+
+        // The signal is surrounded by gl/2 zeros, so it is reconstructed exactly
+        for (ltfat_int w = 0; w < W[id]; w++)
+        {
+            TEST_NAME(fillRand)(f + w * L[id] + glh, L[id] - 2 * glh);
+            memcpy(fpad + w * Lpad, f + w * L[id], L[id] * sizeof * f);
+        }
+
+        for (ltfat_int pId = 0; pId < (ltfat_int) ARRAYLEN(ptype); pId++)
+        {
+            LTFAT_NAME(dgtreal_olastream_state)* fwd = NULL;
+            LTFAT_NAME(idgtreal_olastream_state)* back = NULL;
+            ltfat_int done = 0, ncols = 0, nout, pos;
+            double err = 0.0;
+
+            mu_assert( LTFAT_NAME(dgtreal_olastream_init)(g, gl[id], W[id], a[id], M[id],
+                       bl[id], ptype[pId], FFTW_ESTIMATE, &fwd) == LTFATERR_SUCCESS,
+                       "dgtreal_olastream_init");
+            mu_assert( LTFAT_NAME(idgtreal_olastream_init)(gd, gl[id], W[id], a[id], M[id],
+                       bl[id], ptype[pId], FFTW_ESTIMATE, &back) == LTFATERR_SUCCESS,
+                       "idgtreal_olastream_init");
+
+            // Forward: push the signal in chunks of varying length
+            for (ltfat_int k = 0; done < L[id]; k++)
+            {
+                ltfat_int Lin = ltfat_imin(chunks[k % ARRAYLEN(chunks)], L[id] - done);
+                ltfat_int expcols = LTFAT_NAME(dgtreal_olastream_get_outcols)(fwd, Lin);
+
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    memcpy(fchunk + w * Lin, f + w * L[id] + done, Lin * sizeof * f);
+
+                mu_assert( LTFAT_NAME(dgtreal_olastream_execute)(fwd, fchunk, Lin,
+                           cchunk, &nout) == LTFATERR_SUCCESS, "dgtreal_olastream_execute");
+                mu_assert( nout == expcols, "get_outcols");
+
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    memcpy(c + M2 * (ncols + w * N), cchunk + w * M2 * nout,
+                           M2 * nout * sizeof * c);
+                ncols += nout; done += Lin;
+            }
+
+            nout = LTFAT_NAME(dgtreal_olastream_get_flushcols)(fwd);
+            mu_assert( ncols + nout == N, "all columns are produced");
+            LTFAT_NAME(dgtreal_olastream_flush)(fwd, cchunk, &nout);
+            for (ltfat_int w = 0; w < W[id]; w++)
+                memcpy(c + M2 * (ncols + w * N), cchunk + w * M2 * nout,
+                       M2 * nout * sizeof * c);
+
+            LTFAT_NAME(dgtreal_long)(fpad, glong, Lpad, W[id], a[id], M[id],
+                                     ptype[pId], cpad);
+
+            for (ltfat_int w = 0; w < W[id]; w++)
+                for (ltfat_int l = 0; l < M2 * N; l++)
+                    err = fmax(err, ltfat_abs(c[l + w * M2 * N] - cpad[l + w * M2 * Npad]));
+            mu_assert( err < tol, "olastream equals dgtreal_long, L=%d, ptype=%d, err=%g",
+                       (int) L[id], (int) pId, err);
+
+            // Inverse: push the columns in chunks of varying length
+            done = 0; pos = 0;
+            for (ltfat_int k = 0; done < N; k++)
+            {
+                ltfat_int Nin = ltfat_imin(chunks[(k + 2) % ARRAYLEN(chunks)] / 4, N - done);
+                ltfat_int explen = LTFAT_NAME(idgtreal_olastream_get_outlen)(back, Nin);
+
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    memcpy(cchunk + w * M2 * Nin, c + M2 * (done + w * N),
+                           M2 * Nin * sizeof * c);
+
+                mu_assert( LTFAT_NAME(idgtreal_olastream_execute)(back, cchunk, Nin,
+                           fchunk, &nout) == LTFATERR_SUCCESS, "idgtreal_olastream_execute");
+                mu_assert( nout == explen, "get_outlen");
+
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    memcpy(fr + w * L[id] + pos, fchunk + w * nout, nout * sizeof * fr);
+                pos += nout; done += Nin;
+            }
+
+            nout = LTFAT_NAME(idgtreal_olastream_get_flushlen)(back);
+            mu_assert( pos + nout == L[id], "all samples are produced");
+            LTFAT_NAME(idgtreal_olastream_flush)(back, fchunk, &nout);
+            for (ltfat_int w = 0; w < W[id]; w++)
+                memcpy(fr + w * L[id] + pos, fchunk + w * nout, nout * sizeof * fr);
+
+            err = 0.0;
+            for (ltfat_int l = 0; l < L[id] * W[id]; l++)
+                err = fmax(err, ltfat_abs(f[l] - fr[l]));
+            mu_assert( err < tol, "olastream reconstruction, L=%d, ptype=%d, err=%g",
+                       (int) L[id], (int) pId, err);
+
+            if (id == 0 && pId == 0)
+            {
+                LTFAT_NAME(dgtreal_olastream_state)* fbad = NULL;
+                mu_assert( LTFAT_NAME(dgtreal_olastream_init)(g, gl[id], W[id], a[id],
+                           M[id], bl[id] + 1, ptype[pId], FFTW_ESTIMATE, &fbad)
+                           == LTFATERR_BADARG, "bl not divisible by a");
+                mu_assert( LTFAT_NAME(dgtreal_olastream_init)(NULL, gl[id], W[id], a[id],
+                           M[id], bl[id], ptype[pId], FFTW_ESTIMATE, &fbad)
+                           == LTFATERR_NULLPOINTER, "window is NULL");
+                mu_assert( LTFAT_NAME(dgtreal_olastream_execute)(fwd, f, -1, c, NULL)
+                           == LTFATERR_BADSIZE, "negative chunk length");
+                mu_assert( LTFAT_NAME(idgtreal_olastream_execute)(back, c, -1, f, NULL)
+                           == LTFATERR_BADSIZE, "negative column count");
+            }
+
+            LTFAT_NAME(dgtreal_olastream_done)(&fwd);
+            LTFAT_NAME(idgtreal_olastream_done)(&back);
+            mu_assert( fwd == NULL && back == NULL, "olastream_done sets NULL");
+        }
+
+        ltfat_free(g); ltfat_free(gd); ltfat_free(glong);
+        ltfat_free(f); ltfat_free(fpad); ltfat_free(fr);
+        ltfat_free(c); ltfat_free(cpad); ltfat_free(fchunk); ltfat_free(cchunk);
+    }
+
+    return 0;
+}
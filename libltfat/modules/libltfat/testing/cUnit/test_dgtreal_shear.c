@@ -0,0 +1,72 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+int TEST_NAME(test_dgtreal_shear)()
+{
+    ltfat_int L = 480, a = 20, M = 24, W = 2;
+    ltfat_int N = L / a;
+    ltfat_int s0[] = { 0, 0, 0, 1,  2, 1,  3, -1,  2};
+    ltfat_int s1[] = { 0, 1, 3, 0,  0, 1,  2,  2, -3};
+    ltfat_int br[] = {20, 20, 20, 20, 10, 20, 20, 20, 20};
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_COMPLEX* fc = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* gc = LTFAT_NAME_COMPLEX(malloc)(L);
+    LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(M * N * W);
+    LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M * N * W);
+    LTFAT_NAME(dgtreal_shear_plan)* p = NULL;
+
+    TEST_NAME(fillRand)(f, L * W);
+    LTFAT_NAME(pgauss)(L, a * M / (double) L, 0.0, g);
+    for (ltfat_int l = 0; l < L * W; l++)
+        fc[l] = f[l];
+    for (ltfat_int l = 0; l < L; l++)
+        gc[l] = g[l];
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(s0); id++)
+    {
+        double err = 0.0;
+
+        // The complex sheared DGT of the complexified signal is the reference
+        LTFAT_NAME(dgt_shear)(fc, gc, L, W, a, M, s0[id], s1[id], br[id], cref);
+
+        mu_assert( LTFAT_NAME(dgtreal_shear)(f, g, L, W, a, M, s0[id], s1[id], br[id], c)
+                   == LTFATERR_SUCCESS, "dgtreal_shear");
+        for (ltfat_int l = 0; l < M * N * W; l++)
+            err = fmax(err, ltfat_abs(c[l] - cref[l]));
+        mu_assert( err < tol, "dgtreal_shear, s0=%d, s1=%d, br=%d, err=%g",
+                   (int) s0[id], (int) s1[id], (int) br[id], err);
+
+        // The plan can be reused with new arrays and executed again
+        mu_assert( LTFAT_NAME(dgtreal_shear_init)(g, L, W, a, M, s0[id], s1[id], br[id],
+                   NULL, NULL, FFTW_ESTIMATE, &p) == LTFATERR_SUCCESS,
+                   "dgtreal_shear_init");
+        mu_assert( LTFAT_NAME(dgtreal_shear_execute)(p) == LTFATERR_NULLPOINTER,
+                   "dgtreal_shear_execute without arrays");
+        for (ltfat_int rep = 0; rep < 2; rep++)
+        {
+            LTFAT_NAME_COMPLEX(clear_array)(c, M * N * W);
+            mu_assert( LTFAT_NAME(dgtreal_shear_execute_newarray)(p, f, c)
+                       == LTFATERR_SUCCESS, "dgtreal_shear_execute_newarray");
+            err = 0.0;
+            for (ltfat_int l = 0; l < M * N * W; l++)
+                err = fmax(err, ltfat_abs(c[l] - cref[l]));
+            mu_assert( err < tol, "dgtreal_shear plan, s0=%d, s1=%d, br=%d, err=%g",
+                       (int) s0[id], (int) s1[id], (int) br[id], err);
+        }
+        mu_assert( LTFAT_NAME(dgtreal_shear_done)(&p) == LTFATERR_SUCCESS,
+                   "dgtreal_shear_done");
+        mu_assert( p == NULL, "dgtreal_shear_done should set the plan to NULL");
+    }
+
+    // br must divide b = L/M
+    mu_assert( LTFAT_NAME(dgtreal_shear_init)(g, L, W, a, M, 1, 0, 40, f, c,
+               FFTW_ESTIMATE, &p) == LTFATERR_BADARG, "dgtreal_shear_init bad br");
+    mu_assert( LTFAT_NAME(dgtreal_shear_init)(g, L, W, a, 25, 1, 0, 20, f, c,
+               FFTW_ESTIMATE, &p) == LTFATERR_BADTRALEN, "dgtreal_shear_init bad M");
+
+    ltfat_free(f); ltfat_free(g); ltfat_free(fc); ltfat_free(gc);
+    ltfat_free(cref); ltfat_free(c);
+    return 0;
+}
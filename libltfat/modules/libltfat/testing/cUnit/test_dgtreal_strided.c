@@ -0,0 +1,82 @@
+int TEST_NAME(test_dgtreal_strided)()
+{
+    ltfat_int L[]  = { 120, 144, 480};
+    ltfat_int gl[] = {  40, 144,  96};
+    ltfat_int a[]  = {   6,  12,  24};
+    ltfat_int M[]  = {  20,  18,  96};
+    ltfat_int W[]  = {   2,   3,   1};
+    ltfat_dgt_hint hint[] = { ltfat_dgt_long, ltfat_dgt_fb };
+    ltfat_phaseconvention ptype[] = { LTFAT_FREQINV, LTFAT_TIMEINV };
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int N = L[id] / a[id], M2 = M[id] / 2 + 1;
+        // Odd stride makes the coefficient columns misaligned
+        ltfat_int cstride = M2 * W[id] + 1;
+        ltfat_dgt_layout flayout = { W[id], 1 };
+        ltfat_dgt_layout clayout = { cstride, M2 };
+        LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(gl[id]);
+        LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_REAL* fi = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W[id]);
+        LTFAT_COMPLEX* ci = LTFAT_NAME_COMPLEX(calloc)(cstride * N);
+
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[id], g);
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+
+        for (ltfat_int w = 0; w < W[id]; w++)
+            for (ltfat_int l = 0; l < L[id]; l++)
+                fi[l * W[id] + w] = f[l + w * L[id]];
+
+        for (ltfat_int hId = 0; hId < (ltfat_int) ARRAYLEN(hint); hId++)
+        {
+            for (ltfat_int pId = 0; pId < (ltfat_int) ARRAYLEN(ptype); pId++)
+            {
+                LTFAT_NAME(dgtreal_plan)* p = NULL;
+                ltfat_dgt_params* params = ltfat_dgt_params_allocdef();
+                double err = 0.0;
+
+                ltfat_dgt_setpar_hint(params, hint[hId]);
+                ltfat_dgt_setpar_phaseconv(params, ptype[pId]);
+
+                mu_assert( LTFAT_NAME(dgtreal_init)(g, gl[id], L[id], W[id], a[id],
+                                                    M[id], f, c, params, &p)
+                           == LTFATERR_SUCCESS, "dgtreal_init");
+
+                LTFAT_NAME(dgtreal_execute_ana)(p);
+                mu_assert( LTFAT_NAME(dgtreal_execute_ana_strided)(p, fi, flayout,
+                           ci, clayout) == LTFATERR_SUCCESS, "execute_ana_strided");
+
+                for (ltfat_int w = 0; w < W[id]; w++)
+                    for (ltfat_int n = 0; n < N; n++)
+                        for (ltfat_int m = 0; m < M2; m++)
+                            err = fmax(err, ltfat_abs( c[m + n * M2 + w * M2 * N] -
+                                       ci[m + n * cstride + w * M2]));
+
+                mu_assert( err < tol, "interleaved equals contiguous, L=%d, hint=%d, ptype=%d, err=%g",
+                           (int) L[id], (int) hId, (int) pId, err);
+
+                if (id == 0)
+                {
+                    ltfat_dgt_layout badc = { M2 - 1, M2 };
+                    ltfat_dgt_layout badf = { 0, 1 };
+                    mu_assert( LTFAT_NAME(dgtreal_execute_ana_strided)(p, fi, flayout,
+                               ci, badc) == LTFATERR_BADARG, "coefficient stride too small");
+                    mu_assert( LTFAT_NAME(dgtreal_execute_ana_strided)(p, fi, badf,
+                               ci, clayout) == LTFATERR_BADARG, "zero input stride");
+                    mu_assert( LTFAT_NAME(dgtreal_execute_ana_strided)(p, NULL, flayout,
+                               ci, clayout) == LTFATERR_NULLPOINTER, "input is NULL");
+                }
+
+                LTFAT_NAME(dgtreal_done)(&p);
+                ltfat_dgt_params_free(params);
+            }
+        }
+
+        ltfat_free(g); ltfat_free(f); ltfat_free(fi);
+        ltfat_free(c); ltfat_free(ci);
+    }
+
+    return 0;
+}
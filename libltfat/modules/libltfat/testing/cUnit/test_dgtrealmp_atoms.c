@@ -0,0 +1,122 @@
+int TEST_NAME(test_dgtrealmp_atoms)()
+{
+    ltfat_int L = 480, P = 2;
+    ltfat_int gl[] = { 96, 48};
+    ltfat_int a[]  = { 24, 12};
+    ltfat_int M[]  = { 96, 48};
+    ltfat_int M2[2], N[2];
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+    LTFAT_REAL* g[2];
+    LTFAT_COMPLEX* c[2];
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* fdense = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* fatoms = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_NAME(dgtrealmp_state)* p = NULL;
+    LTFAT_NAME(dgtrealmp_atoms)* atoms = NULL, *atoms2 = NULL;
+    ltfat_dgtmp_params* params = ltfat_dgtmp_params_allocdef();
+    size_t atNo = 0, atNo2 = 0, nnz = 0, buflen = 0;
+    unsigned char* buf = NULL;
+    double err = 0.0;
+    int status;
+
+    TEST_NAME(fillRand)(f, L);
+    ltfat_dgtmp_setpar_maxatoms(params, 100);
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        g[k] = LTFAT_NAME_REAL(malloc)(gl[k]);
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[k], g[k]);
+        LTFAT_NAME_REAL(normalize)(g[k], gl[k], LTFAT_NORM_ENERGY, g[k]);
+        M2[k] = M[k] / 2 + 1; N[k] = L / a[k];
+        c[k] = LTFAT_NAME_COMPLEX(calloc)(M2[k] * N[k]);
+    }
+
+    mu_assert( LTFAT_NAME(dgtrealmp_init_gen)((const LTFAT_REAL**) g, gl, L, P,
+               a, M, params, &p) == LTFATERR_SUCCESS, "dgtrealmp_init_gen");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_init)(0, &atoms) == LTFATERR_SUCCESS,
+               "atoms_init");
+
+    // The same decomposition into dense coefficients and into an atom list
+    status = LTFAT_NAME(dgtrealmp_execute_decompose)(p, f, c);
+    mu_assert( status >= 0, "execute_decompose");
+    status = LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(p, f, atoms);
+    mu_assert( status >= 0, "execute_decompose_atoms");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_compact)(atoms) == LTFATERR_SUCCESS,
+               "atoms_compact");
+    LTFAT_NAME(dgtrealmp_atoms_get_count)(atoms, &atNo);
+
+    for (ltfat_int k = 0; k < P; k++)
+        for (ltfat_int l = 0; l < M2[k] * N[k]; l++)
+            if (ltfat_abs(c[k][l]) > 0) nnz++;
+
+    mu_assert( atNo == nnz && atNo > 0, "atom count equals the dense support");
+
+    for (size_t ii = 0; ii < atNo; ii++)
+    {
+        ltfat_int dictid, m, n;
+        LTFAT_COMPLEX cval;
+        LTFAT_NAME(dgtrealmp_atoms_get)(atoms, ii, &dictid, &m, &n, &cval);
+        err = fmax(err, ltfat_abs(cval - c[dictid][m + n * M2[dictid]]));
+    }
+    mu_assert( err < tol, "atoms equal dense coefficients, err=%g", err);
+
+    // Synthesis from both
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_synthesize)(p, (const LTFAT_COMPLEX**) c,
+               NULL, fdense) == LTFATERR_SUCCESS, "execute_synthesize");
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(p, atoms, NULL,
+               fatoms) == LTFATERR_SUCCESS, "execute_synthesize_atoms");
+    err = 0.0;
+    for (ltfat_int l = 0; l < L; l++)
+        err = fmax(err, ltfat_abs(fdense[l] - fatoms[l]));
+    mu_assert( err < tol, "synthesis from atoms, err=%g", err);
+
+    // Serialization round trip
+    LTFAT_NAME(dgtrealmp_atoms_get_serializedsize)(atoms, &buflen);
+    buf = (unsigned char*) ltfat_malloc(buflen);
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_serialize)(atoms, buflen, buf)
+               == LTFATERR_SUCCESS, "atoms_serialize");
+    LTFAT_NAME(dgtrealmp_atoms_init)(1, &atoms2);
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(atoms2, buflen, buf)
+               == LTFATERR_SUCCESS, "atoms_deserialize");
+    LTFAT_NAME(dgtrealmp_atoms_get_count)(atoms2, &atNo2);
+    err = atNo2 == atNo ? 0.0 : 1.0;
+    for (size_t ii = 0; ii < atNo && ii < atNo2; ii++)
+    {
+        ltfat_int d1, m1, n1, d2, m2, n2;
+        LTFAT_COMPLEX c1, c2;
+        LTFAT_NAME(dgtrealmp_atoms_get)(atoms, ii, &d1, &m1, &n1, &c1);
+        LTFAT_NAME(dgtrealmp_atoms_get)(atoms2, ii, &d2, &m2, &n2, &c2);
+        if (d1 != d2 || m1 != m2 || n1 != n2 || c1 != c2) err = 1.0;
+    }
+    mu_assert( err == 0.0, "serialized atoms are equal");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_deserialize)(atoms2, buflen - 1, buf)
+               != LTFATERR_SUCCESS, "truncated buffer is rejected");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_reset)(atoms) == LTFATERR_SUCCESS,
+               "atoms_reset");
+    LTFAT_NAME(dgtrealmp_atoms_get_count)(atoms, &atNo);
+    mu_assert( atNo == 0, "reset list is empty");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_atoms_init)(0, NULL) == LTFATERR_NULLPOINTER,
+               "atoms_init: NULL");
+    mu_assert( LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(p, f, NULL)
+               == LTFATERR_NULLPOINTER, "execute_decompose_atoms: NULL");
+    {
+        ltfat_int dictid, m, n;
+        LTFAT_COMPLEX cval;
+        mu_assert( LTFAT_NAME(dgtrealmp_atoms_get)(atoms, 0, &dictid, &m, &n, &cval)
+                   != LTFATERR_SUCCESS, "atoms_get: out of range");
+    }
+
+    LTFAT_NAME(dgtrealmp_atoms_done)(&atoms);
+    LTFAT_NAME(dgtrealmp_atoms_done)(&atoms2);
+    mu_assert( atoms == NULL, "atoms_done sets NULL");
+    LTFAT_NAME(dgtrealmp_done)(&p);
+    ltfat_dgtmp_params_free(params);
+    for (ltfat_int k = 0; k < P; k++) { ltfat_free(g[k]); ltfat_free(c[k]); }
+    ltfat_free(f); ltfat_free(fdense); ltfat_free(fatoms); ltfat_free(buf);
+    return 0;
+}
@@ -0,0 +1,93 @@
+int TEST_NAME(test_dgtrealmp_errresync)()
+{
+    ltfat_int L = 480, P = 2;
+    ltfat_int gl[] = { 96, 48};
+    ltfat_int a[]  = { 24, 12};
+    ltfat_int M[]  = { 96, 48};
+    size_t resync[] = { 1, 7 };
+    ltfat_int M2[2], N[2];
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-6 : 1e-2;
+    LTFAT_REAL* g[2];
+    LTFAT_COMPLEX* c[2];
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_NAME(dgtrealmp_atoms)* atoms = NULL;
+    ltfat_dgtmp_params* params = ltfat_dgtmp_params_allocdef();
+
+    TEST_NAME(fillRand)(f, L);
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        g[k] = LTFAT_NAME_REAL(malloc)(gl[k]);
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[k], g[k]);
+        LTFAT_NAME_REAL(normalize)(g[k], gl[k], LTFAT_NORM_ENERGY, g[k]);
+        M2[k] = M[k] / 2 + 1; N[k] = L / a[k];
+        c[k] = LTFAT_NAME_COMPLEX(malloc)(M2[k] * N[k]);
+    }
+
+    LTFAT_NAME(dgtrealmp_atoms_init)(0, &atoms);
+
+    for (ltfat_int rId = 0; rId < (ltfat_int) ARRAYLEN(resync); rId++)
+    {
+        for (int useatoms = 0; useatoms < 2; useatoms++)
+        {
+            LTFAT_NAME(dgtrealmp_state)* p = NULL;
+            double errdb, truedb, fnorm2 = 0.0, rnorm2 = 0.0;
+            size_t iters;
+            int status;
+
+            ltfat_dgtmp_setpar_maxatoms(params, 100);
+            ltfat_dgtmp_setpar_errresync(params, resync[rId]);
+
+            mu_assert( LTFAT_NAME(dgtrealmp_init_gen)((const LTFAT_REAL**) g, gl,
+                       L, P, a, M, params, &p) == LTFATERR_SUCCESS, "init_gen");
+
+            if (useatoms)
+            {
+                status = LTFAT_NAME(dgtrealmp_execute_decompose_atoms)(p, f, atoms);
+                mu_assert( status >= 0, "execute_decompose_atoms");
+                LTFAT_NAME(dgtrealmp_execute_synthesize_atoms)(p, atoms, NULL, fout);
+            }
+            else
+            {
+                status = LTFAT_NAME(dgtrealmp_execute_decompose)(p, f, c);
+                mu_assert( status >= 0, "execute_decompose");
+                LTFAT_NAME(dgtrealmp_execute_synthesize)(p, (const LTFAT_COMPLEX**) c,
+                        NULL, fout);
+            }
+
+            LTFAT_NAME(dgtrealmp_get_numiters)(p, &iters);
+            LTFAT_NAME(dgtrealmp_get_errdb)(p, &errdb);
+
+            for (ltfat_int l = 0; l < L; l++)
+            {
+                fnorm2 += (double) f[l] * f[l];
+                rnorm2 += (double) (f[l] - fout[l]) * (f[l] - fout[l]);
+            }
+            truedb = 10.0 * log10(rnorm2 / fnorm2);
+
+            // The error is exact right after a recomputation
+            if (iters % resync[rId] == 0)
+                mu_assert( fabs(errdb - truedb) < tol,
+                           "errresync=%zu, atoms=%d: err=%g dB, true=%g dB",
+                           resync[rId], useatoms, errdb, truedb);
+            else
+                mu_assert( fabs(errdb - truedb) < 1e-1,
+                           "errresync=%zu, atoms=%d: err=%g dB, true=%g dB",
+                           resync[rId], useatoms, errdb, truedb);
+
+            LTFAT_NAME(dgtrealmp_done)(&p);
+        }
+    }
+
+    mu_assert( ltfat_dgtmp_setpar_errresync(NULL, 1) == LTFATERR_NULLPOINTER,
+               "setpar_errresync: NULL");
+    mu_assert( LTFAT_NAME(dgtrealmp_setparbuf_errresync)(NULL, 1)
+               == LTFATERR_NULLPOINTER, "setparbuf_errresync: NULL");
+
+    LTFAT_NAME(dgtrealmp_atoms_done)(&atoms);
+    ltfat_dgtmp_params_free(params);
+    for (ltfat_int k = 0; k < P; k++) { ltfat_free(g[k]); ltfat_free(c[k]); }
+    ltfat_free(f); ltfat_free(fout);
+    return 0;
+}
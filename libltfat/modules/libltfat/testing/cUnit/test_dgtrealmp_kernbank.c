@@ -0,0 +1,98 @@
+int TEST_NAME(test_dgtrealmp_kernbank)()
+{
+    ltfat_int L = 480, P = 2;
+    ltfat_int gl[] = { 96, 48};
+    ltfat_int a[]  = { 24, 12};
+    ltfat_int M[]  = { 96, 48};
+    ltfat_int M2[2], N[2];
+    LTFAT_REAL* g[2];
+    LTFAT_COMPLEX* c1[2], *c2[2];
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_NAME(dgtrealmp_state)* p1 = NULL, *p2 = NULL;
+    LTFAT_NAME(dgtrealmp_kernbank)* kb = NULL, *kb2 = NULL;
+    ltfat_dgtmp_params* params = ltfat_dgtmp_params_allocdef();
+    ltfat_int aother[] = { 12, 12};
+    int status, same = 1;
+
+    TEST_NAME(fillRand)(f, L);
+    ltfat_dgtmp_setpar_maxatoms(params, 100);
+
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        g[k] = LTFAT_NAME_REAL(malloc)(gl[k]);
+        LTFAT_NAME_REAL(firwin)(LTFAT_BLACKMAN, gl[k], g[k]);
+        LTFAT_NAME_REAL(normalize)(g[k], gl[k], LTFAT_NORM_ENERGY, g[k]);
+        M2[k] = M[k] / 2 + 1; N[k] = L / a[k];
+        c1[k] = LTFAT_NAME_COMPLEX(malloc)(M2[k] * N[k]);
+        c2[k] = LTFAT_NAME_COMPLEX(malloc)(M2[k] * N[k]);
+    }
+
+    mu_assert( LTFAT_NAME(dgtrealmp_kernbank_init)((const LTFAT_REAL**) g, gl,
+               L, P, a, M, params, &kb) == LTFATERR_SUCCESS, "kernbank_init");
+
+    // A state with its own kernels and a state using the bank
+    mu_assert( LTFAT_NAME(dgtrealmp_init_gen)((const LTFAT_REAL**) g, gl, L, P,
+               a, M, params, &p1) == LTFATERR_SUCCESS, "init_gen");
+    mu_assert( LTFAT_NAME(dgtrealmp_init_gen_kernbank)((const LTFAT_REAL**) g,
+               gl, L, P, a, M, params, kb, &p2) == LTFATERR_SUCCESS,
+               "init_gen_kernbank");
+
+    // The state keeps the bank alive
+    LTFAT_NAME(dgtrealmp_kernbank_done)(&kb);
+    mu_assert( kb == NULL, "kernbank_done sets NULL");
+
+    status = LTFAT_NAME(dgtrealmp_execute_decompose)(p1, f, c1);
+    mu_assert( status >= 0, "decompose with own kernels");
+    status = LTFAT_NAME(dgtrealmp_execute_decompose)(p2, f, c2);
+    mu_assert( status >= 0, "decompose with shared kernels");
+
+    for (ltfat_int k = 0; k < P; k++)
+        for (ltfat_int l = 0; l < M2[k] * N[k]; l++)
+            if (c1[k][l] != c2[k][l]) same = 0;
+    mu_assert( same, "shared kernels give the same decomposition");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_get_kernbank)(p2, &kb) == LTFATERR_SUCCESS,
+               "get_kernbank");
+    mu_assert( kb != NULL, "get_kernbank returns the bank");
+
+    // The bank is used only with the parameters it was computed for
+    LTFAT_NAME(dgtrealmp_done)(&p1);
+    mu_assert( LTFAT_NAME(dgtrealmp_init_gen_kernbank)((const LTFAT_REAL**) g,
+               gl, L, P, aother, M, params, kb, &p1) == LTFATERR_BADARG,
+               "incompatible bank is rejected");
+
+    // Releasing the state first leaves the bank usable
+    LTFAT_NAME(dgtrealmp_done)(&p2);
+    mu_assert( LTFAT_NAME(dgtrealmp_init_gen_kernbank)((const LTFAT_REAL**) g,
+               gl, L, P, a, M, params, kb, &p2) == LTFATERR_SUCCESS,
+               "bank outlives a state");
+    status = LTFAT_NAME(dgtrealmp_execute_decompose)(p2, f, c2);
+    same = 1;
+    for (ltfat_int k = 0; k < P; k++)
+        for (ltfat_int l = 0; l < M2[k] * N[k]; l++)
+            if (c1[k][l] != c2[k][l]) same = 0;
+    mu_assert( status >= 0 && same, "decompose after releasing a state");
+
+    mu_assert( LTFAT_NAME(dgtrealmp_kernbank_init)((const LTFAT_REAL**) g, gl,
+               L, P, a, M, params, NULL) == LTFATERR_NULLPOINTER,
+               "kernbank_init: NULL");
+    mu_assert( LTFAT_NAME(dgtrealmp_kernbank_init)((const LTFAT_REAL**) g, gl,
+               L + 1, P, a, M, params, &kb2) == LTFATERR_BADTRALEN,
+               "kernbank_init: bad L");
+    mu_assert( kb2 == NULL, "kernbank_init: NULL on error");
+    mu_assert( LTFAT_NAME(dgtrealmp_kernbank_init_cached)((const LTFAT_REAL**) g,
+               gl, L, P, a, M, params, NULL, &kb2) == LTFATERR_NULLPOINTER,
+               "kernbank_init_cached: NULL cachedir");
+    mu_assert( LTFAT_NAME(dgtrealmp_kernbank_done)(NULL) == LTFATERR_NULLPOINTER,
+               "kernbank_done: NULL");
+
+    LTFAT_NAME(dgtrealmp_done)(&p2);
+    LTFAT_NAME(dgtrealmp_kernbank_done)(&kb);
+    ltfat_dgtmp_params_free(params);
+    for (ltfat_int k = 0; k < P; k++)
+    {
+        ltfat_free(g[k]); ltfat_free(c1[k]); ltfat_free(c2[k]);
+    }
+    ltfat_free(f);
+    return 0;
+}
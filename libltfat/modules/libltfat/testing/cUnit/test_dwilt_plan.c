@@ -0,0 +1,105 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+int TEST_NAME(test_dwilt_plan)()
+{
+    ltfat_int L[]  = { 240, 126, 480, 360};
+    ltfat_int gl[] = {  40,  42,  96, 360};
+    ltfat_int M[]  = {  10,   7,  24,  12};
+    ltfat_int W[]  = {   1,   2,   1,   3};
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        LTFAT_REAL* g = LTFAT_NAME_REAL(malloc)(gl[id]);
+        LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_REAL* fref = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_REAL* c = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_REAL* cref = LTFAT_NAME_REAL(malloc)(L[id] * W[id]);
+        LTFAT_NAME(dwilt_plan)* pdw = NULL;
+        LTFAT_NAME(idwilt_plan)* pidw = NULL;
+        LTFAT_NAME(wmdct_plan)* pwm = NULL;
+        LTFAT_NAME(iwmdct_plan)* piwm = NULL;
+        double err;
+
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[id], g);
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+        TEST_NAME(fillRand)(c, L[id] * W[id]);
+
+        mu_assert( LTFAT_NAME(dwilt_init)(g, gl[id], L[id], W[id], M[id],
+                                          FFTW_ESTIMATE, &pdw) == LTFATERR_SUCCESS, "dwilt_init");
+        mu_assert( LTFAT_NAME(idwilt_init)(g, gl[id], L[id], W[id], M[id],
+                                           FFTW_ESTIMATE, &pidw) == LTFATERR_SUCCESS, "idwilt_init");
+        mu_assert( LTFAT_NAME(wmdct_init)(g, gl[id], L[id], W[id], M[id],
+                                          FFTW_ESTIMATE, &pwm) == LTFATERR_SUCCESS, "wmdct_init");
+        mu_assert( LTFAT_NAME(iwmdct_init)(g, gl[id], L[id], W[id], M[id],
+                                           FFTW_ESTIMATE, &piwm) == LTFATERR_SUCCESS, "iwmdct_init");
+
+        // DWILT
+        LTFAT_NAME_REAL(dwilt_fb)(f, g, L[id], gl[id], W[id], M[id], cref);
+        mu_assert( LTFAT_NAME(dwilt_execute)(pdw, f, fout) == LTFATERR_SUCCESS,
+                   "dwilt_execute");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W[id]; l++)
+            err = fmax(err, ltfat_abs(fout[l] - cref[l]));
+        mu_assert( err < tol, "dwilt equals dwilt_fb, L=%d, M=%d, err=%g",
+                   (int) L[id], (int) M[id], err);
+
+        // IDWILT
+        LTFAT_NAME_REAL(idwilt_fb)(c, g, L[id], gl[id], W[id], M[id], fref);
+        mu_assert( LTFAT_NAME(idwilt_execute)(pidw, c, fout) == LTFATERR_SUCCESS,
+                   "idwilt_execute");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W[id]; l++)
+            err = fmax(err, ltfat_abs(fout[l] - fref[l]));
+        mu_assert( err < tol, "idwilt equals idwilt_fb, L=%d, M=%d, err=%g",
+                   (int) L[id], (int) M[id], err);
+
+        // WMDCT
+        LTFAT_NAME_REAL(dwiltiii_fb)(f, g, L[id], gl[id], W[id], M[id], cref);
+        mu_assert( LTFAT_NAME(wmdct_execute)(pwm, f, fout) == LTFATERR_SUCCESS,
+                   "wmdct_execute");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W[id]; l++)
+            err = fmax(err, ltfat_abs(fout[l] - cref[l]));
+        mu_assert( err < tol, "wmdct equals dwiltiii_fb, L=%d, M=%d, err=%g",
+                   (int) L[id], (int) M[id], err);
+
+        // IWMDCT
+        LTFAT_NAME_REAL(idwiltiii_fb)(c, g, L[id], gl[id], W[id], M[id], fref);
+        mu_assert( LTFAT_NAME(iwmdct_execute)(piwm, c, fout) == LTFATERR_SUCCESS,
+                   "iwmdct_execute");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W[id]; l++)
+            err = fmax(err, ltfat_abs(fout[l] - fref[l]));
+        mu_assert( err < tol, "iwmdct equals idwiltiii_fb, L=%d, M=%d, err=%g",
+                   (int) L[id], (int) M[id], err);
+
+        if (id == 0)
+        {
+            LTFAT_NAME(dwilt_plan)* pbad = NULL;
+            mu_assert( LTFAT_NAME(dwilt_init)(g, gl[id], L[id] + M[id], W[id], M[id],
+                                              FFTW_ESTIMATE, &pbad) == LTFATERR_BADTRALEN,
+                       "L not divisible by 2M");
+            mu_assert( LTFAT_NAME(dwilt_init)(g, L[id] + 2 * M[id], L[id], W[id], M[id],
+                                              FFTW_ESTIMATE, &pbad) == LTFATERR_BADREQSIZE,
+                       "gl greater than L");
+            mu_assert( LTFAT_NAME(dwilt_init)(NULL, gl[id], L[id], W[id], M[id],
+                                              FFTW_ESTIMATE, &pbad) == LTFATERR_NULLPOINTER,
+                       "window is NULL");
+            mu_assert( LTFAT_NAME(wmdct_execute)(pwm, NULL, fout) == LTFATERR_NULLPOINTER,
+                       "wmdct_execute: NULL");
+        }
+
+        LTFAT_NAME(dwilt_done)(&pdw);
+        LTFAT_NAME(idwilt_done)(&pidw);
+        LTFAT_NAME(wmdct_done)(&pwm);
+        LTFAT_NAME(iwmdct_done)(&piwm);
+        mu_assert( !pdw && !pidw && !pwm && !piwm, "done sets NULL");
+
+        ltfat_free(g); ltfat_free(f); ltfat_free(fref); ltfat_free(fout);
+        ltfat_free(c); ltfat_free(cref);
+    }
+
+    return 0;
+}
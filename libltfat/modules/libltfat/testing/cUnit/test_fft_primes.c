@@ -0,0 +1,110 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* Direct DFT of W channels of length L, accumulated in double. The phase
+ * index k*l is reduced modulo L to keep the argument of cos and sin small. */
+void TEST_NAME(fft_primes_dft)(const LTFAT_COMPLEX* in, ltfat_int L, ltfat_int W,
+                               LTFAT_COMPLEX* out)
+{
+    for (ltfat_int w = 0; w < W; w++)
+        for (ltfat_int k = 0; k < L; k++)
+        {
+            double re = 0.0, im = 0.0;
+            for (ltfat_int l = 0; l < L; l++)
+            {
+                double ph = -2.0 * M_PI * ((k * l) % L) / L;
+                double xr = ltfat_real(in[l + w * L]), xi = ltfat_imag(in[l + w * L]);
+                re += xr * cos(ph) - xi * sin(ph);
+                im += xr * sin(ph) + xi * cos(ph);
+            }
+            out[k + w * L] = (LTFAT_REAL) re + I * (LTFAT_REAL) im;
+        }
+}
+
+int TEST_NAME(test_fft_primes)()
+{
+    // Small primes use the generic butterfly, the large ones Bluestein
+    ltfat_int L[] = { 1, 2, 7, 131, 257, 2 * 1009, 3 * 131, 4099};
+    ltfat_int W = 2;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-12 : 1e-5;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int M2 = L[id] / 2 + 1;
+        LTFAT_COMPLEX* f = LTFAT_NAME_COMPLEX(malloc)(L[id] * W);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(L[id] * W);
+        LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(L[id] * W);
+        LTFAT_COMPLEX* buf = LTFAT_NAME_COMPLEX(malloc)(M2 * W);
+        LTFAT_REAL* fr = LTFAT_NAME_REAL(malloc)(L[id] * W);
+        LTFAT_REAL* frr = LTFAT_NAME_REAL(malloc)(L[id] * W);
+        LTFAT_NAME(fft_plan)* p = NULL;
+        double err = 0.0, nrm = 0.0;
+
+        TEST_NAME_COMPLEX(fillRand)(f, L[id] * W);
+        TEST_NAME(fillRand)(fr, L[id] * W);
+
+        // Complex FFT
+        TEST_NAME(fft_primes_dft)(f, L[id], W, cref);
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            nrm = fmax(nrm, ltfat_abs(cref[l]));
+
+        mu_assert( LTFAT_NAME(fft_init)(L[id], W, f, c, FFTW_ESTIMATE, &p)
+                   == LTFATERR_SUCCESS, "fft_init");
+        mu_assert( LTFAT_NAME(fft_execute)(p) == LTFATERR_SUCCESS, "fft_execute");
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            err = fmax(err, ltfat_abs(c[l] - cref[l]));
+        mu_assert( err < tol * nrm, "fft, L=%d, err=%g", (int) L[id], err);
+        LTFAT_NAME(fft_done)(&p);
+
+        // In place and back, the inverse is not normalized
+        memcpy(c, f, L[id] * W * sizeof * c);
+        mu_assert( LTFAT_NAME(fft)(c, L[id], W, c) == LTFATERR_SUCCESS, "fft in place");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            err = fmax(err, ltfat_abs(c[l] - cref[l]));
+        mu_assert( err < tol * nrm, "fft in place, L=%d, err=%g", (int) L[id], err);
+
+        mu_assert( LTFAT_NAME(ifft)(c, L[id], W, c) == LTFATERR_SUCCESS, "ifft");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            err = fmax(err, ltfat_abs(c[l] / (LTFAT_REAL) L[id] - f[l]));
+        mu_assert( err < tol * nrm, "fft/ifft round trip, L=%d, err=%g", (int) L[id], err);
+
+        // Real FFT
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            f[l] = fr[l];
+        TEST_NAME(fft_primes_dft)(f, L[id], W, cref);
+        nrm = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            nrm = fmax(nrm, ltfat_abs(cref[l]));
+
+        mu_assert( LTFAT_NAME(fftreal)(fr, L[id], W, buf) == LTFATERR_SUCCESS, "fftreal");
+        err = 0.0;
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int m = 0; m < M2; m++)
+                err = fmax(err, ltfat_abs(buf[m + w * M2] - cref[m + w * L[id]]));
+        mu_assert( err < tol * nrm, "fftreal, L=%d, err=%g", (int) L[id], err);
+
+        mu_assert( LTFAT_NAME(ifftreal)(buf, L[id], W, frr) == LTFATERR_SUCCESS, "ifftreal");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id] * W; l++)
+            err = fmax(err, ltfat_abs(frr[l] / L[id] - fr[l]));
+        mu_assert( err < tol * nrm, "fftreal/ifftreal round trip, L=%d, err=%g",
+                   (int) L[id], err);
+
+        // Real FFT in place, every channel occupies M2 complex numbers
+        for (ltfat_int w = 0; w < W; w++)
+            memcpy((LTFAT_REAL*) (buf + w * M2), fr + w * L[id], L[id] * sizeof * fr);
+        mu_assert( LTFAT_NAME(fftreal)((LTFAT_REAL*) buf, L[id], W, buf)
+                   == LTFATERR_SUCCESS, "fftreal in place");
+        err = 0.0;
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int m = 0; m < M2; m++)
+                err = fmax(err, ltfat_abs(buf[m + w * M2] - cref[m + w * L[id]]));
+        mu_assert( err < tol * nrm, "fftreal in place, L=%d, err=%g", (int) L[id], err);
+
+        ltfat_free(f); ltfat_free(c); ltfat_free(cref); ltfat_free(buf);
+        ltfat_free(fr); ltfat_free(frr);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+int TEST_NAME(test_filterbankphasereassign)()
+{
+    ltfat_int L = 60, M = 5;
+    ltfat_int N[] = { 60, 30, 20, 15, 12};
+    double a[] = { 1.0, 2.0, 3.0, 4.0, 5.0};
+    double cfreq[] = { 0.0, 0.25, 0.5, 1.0, 1.5};
+    ltfat_int nthreads[] = { 1, 3};
+    double minlvl = 0.05;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+    ltfat_int Ntot = 0;
+
+    const LTFAT_COMPLEX* c[5], *ch[5], *cd[5];
+    LTFAT_REAL* tgrad[5], *fgrad[5], *cs[5], *sr[5], *srref[5];
+    const LTFAT_REAL* ptgrad[5], *pfgrad[5], *pcs[5];
+    LTFAT_COMPLEX* cbuf, *chbuf, *cdbuf;
+    LTFAT_REAL* rbuf;
+    fbreassOptOut* optout;
+    LTFAT_NAME(filterbankphasereassign_plan)* p = NULL;
+
+    for (ltfat_int m = 0; m < M; m++)
+        Ntot += N[m];
+    // fillRand reseeds with the time, one call keeps the arrays different
+    cbuf = LTFAT_NAME_COMPLEX(malloc)(3 * Ntot);
+    chbuf = cbuf + Ntot;
+    cdbuf = cbuf + 2 * Ntot;
+    rbuf = LTFAT_NAME_REAL(malloc)(5 * Ntot);
+    TEST_NAME_COMPLEX(fillRand)(cbuf, 3 * Ntot);
+    // Time shifts of several samples
+    for (ltfat_int k = 0; k < Ntot; k++)
+        chbuf[k] *= (LTFAT_REAL) 20.0;
+
+    for (ltfat_int m = 0, off = 0; m < M; off += N[m], m++)
+    {
+        c[m] = cbuf + off; ch[m] = chbuf + off; cd[m] = cdbuf + off;
+        tgrad[m] = rbuf + off; fgrad[m] = rbuf + Ntot + off;
+        cs[m] = rbuf + 2 * Ntot + off; sr[m] = rbuf + 3 * Ntot + off;
+        srref[m] = rbuf + 4 * Ntot + off;
+    }
+
+    // Reference: the phase gradient and the reassignment one after the other
+    LTFAT_NAME(filterbankphasegrad)(c, ch, cd, M, N, L, (LTFAT_REAL) minlvl,
+                                    tgrad, fgrad, cs);
+    optout = fbreassOptOut_init(Ntot, 4);
+    LTFAT_NAME(filterbankreassign)((const LTFAT_REAL**) cs, (const LTFAT_REAL**) tgrad,
+                                   (const LTFAT_REAL**) fgrad, N, a, cfreq, M, srref,
+                                   REASS_DEFAULT, optout);
+    {
+        ltfat_int moved = 0;
+        for (ltfat_int k = 0; k < Ntot; k++)
+            moved += optout->reposl[k] != 1 || optout->repos[k][0] != k;
+        mu_assert( moved > 0, "filterbankreassign should move some coefficients");
+    }
+
+    for (ltfat_int tId = 0; tId < (ltfat_int) ARRAYLEN(nthreads); tId++)
+    {
+        const ltfat_int* reposstart, *repos;
+        double err = 0.0;
+
+        mu_assert( LTFAT_NAME(filterbankphasereassign_init)(N, a, cfreq, M, L, minlvl,
+                   REASS_KEEPREPOS, nthreads[tId], &p) == LTFATERR_SUCCESS,
+                   "filterbankphasereassign_init");
+        mu_assert( LTFAT_NAME(filterbankphasereassign_execute)(p, c, ch, cd, sr)
+                   == LTFATERR_SUCCESS, "filterbankphasereassign_execute");
+        mu_assert( LTFAT_NAME(filterbankphasereassign_get_phasegrad)(p, ptgrad, pfgrad, pcs)
+                   == LTFATERR_SUCCESS, "filterbankphasereassign_get_phasegrad");
+
+        for (ltfat_int m = 0; m < M; m++)
+        {
+            for (ltfat_int n = 0; n < N[m]; n++)
+            {
+                err = fmax(err, ltfat_abs(ptgrad[m][n] - tgrad[m][n]));
+                err = fmax(err, ltfat_abs(pfgrad[m][n] - fgrad[m][n]));
+                err = fmax(err, ltfat_abs(pcs[m][n] - cs[m][n]));
+                err = fmax(err, ltfat_abs(sr[m][n] - srref[m][n]));
+            }
+        }
+        mu_assert( err < tol, "filterbankphasereassign, nthreads=%d, err=%g",
+                   (int) nthreads[tId], err);
+
+        // The same lists in the same order as the fbreassOptOut output
+        mu_assert( LTFAT_NAME(filterbankphasereassign_get_repos)(p, &reposstart, &repos)
+                   == LTFATERR_SUCCESS, "filterbankphasereassign_get_repos");
+        mu_assert( reposstart[0] == 0 && reposstart[Ntot] == Ntot,
+                   "filterbankphasereassign repos length");
+        for (ltfat_int k = 0; k < Ntot; k++)
+        {
+            mu_assert( reposstart[k + 1] - reposstart[k] == optout->reposl[k],
+                       "filterbankphasereassign repos list %d length", (int) k);
+            for (ltfat_int j = 0; j < optout->reposl[k]; j++)
+                mu_assert( repos[reposstart[k] + j] == optout->repos[k][j],
+                           "filterbankphasereassign repos list %d", (int) k);
+        }
+
+        LTFAT_NAME(filterbankphasereassign_done)(&p);
+        mu_assert( p == NULL, "filterbankphasereassign_done should set the plan to NULL");
+    }
+
+    // The positions are kept only on request
+    {
+        const ltfat_int* reposstart, *repos;
+        mu_assert( LTFAT_NAME(filterbankphasereassign_init)(N, a, cfreq, M, L, minlvl,
+                   REASS_DEFAULT, 1, &p) == LTFATERR_SUCCESS, "filterbankphasereassign_init");
+        mu_assert( LTFAT_NAME(filterbankphasereassign_get_repos)(p, &reposstart, &repos)
+                   == LTFATERR_BADARG, "filterbankphasereassign_get_repos without the hint");
+        LTFAT_NAME(filterbankphasereassign_done)(&p);
+    }
+
+    p = (LTFAT_NAME(filterbankphasereassign_plan)*) rbuf;
+    mu_assert( LTFAT_NAME(filterbankphasereassign_init)(N, a, cfreq, M, L, 1.0,
+               REASS_DEFAULT, 1, &p) == LTFATERR_BADARG,
+               "filterbankphasereassign_init minlvl=1");
+    mu_assert( p == NULL, "filterbankphasereassign_init should set the plan to NULL on failure");
+
+    fbreassOptOut_destroy(optout);
+    ltfat_free(cbuf); ltfat_free(rbuf);
+    return 0;
+}
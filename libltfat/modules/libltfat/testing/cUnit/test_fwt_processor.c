@@ -0,0 +1,140 @@
+typedef struct
+{
+    LTFAT_REAL** c;  // Concatenated subbands, cap x W each
+    ltfat_int* len;  // Samples collected so far per subband
+    ltfat_int cap;
+} TEST_NAME(fwt_processor_acc);
+
+void TEST_NAME(fwt_processor_collect)(void* userdata, const LTFAT_REAL* c[],
+                                      const ltfat_int clen[], int nout, int W)
+{
+    TEST_NAME(fwt_processor_acc)* acc = (TEST_NAME(fwt_processor_acc)*) userdata;
+
+    for (int k = 0; k < nout; k++)
+    {
+        for (int w = 0; w < W; w++)
+            for (ltfat_int n = 0; n < clen[k] && acc->len[k] + n < acc->cap; n++)
+                acc->c[k][acc->len[k] + n + w * acc->cap] = c[k][n + w * clen[k]];
+
+        acc->len[k] += clen[k];
+    }
+}
+
+int TEST_NAME(test_fwt_processor)()
+{
+    ltfat_int L = 200, W = 2, J = 3, M = 2, bufLenMax = 64;
+    ltfat_int gl[] = { 6, 6};
+    ltfat_int a[] = { 2, 2};
+    ltfat_int offset[] = { 0, -2};
+    ltfat_int chunks[] = { 1, 17, 64, 5, 33, 2};
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    // The same DWT as a wavelet filterbank tree, outputs in fwt order
+    ltfat_int tM[] = { 2, 2, 2};
+    ltfat_int tgl[] = { 6, 6, 6, 6, 6, 6};
+    ltfat_int ta[] = { 2, 2, 2, 2, 2, 2};
+    ltfat_int toff[] = { 0, -2, 0, -2, 0, -2};
+    ltfat_int tchild[] = { 1, -1, 2, -1, -1, -1};
+    ltfat_int toutidx[] = { -1, 3, -1, 2, 0, 1};
+
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* gbuf = LTFAT_NAME_REAL(malloc)(2 * 6);
+    const LTFAT_REAL* g[2];
+    const LTFAT_REAL* tg[6];
+    const LTFAT_REAL* in[2];
+    LTFAT_REAL* cref[4];
+    LTFAT_REAL* c[4];
+    ltfat_int Lc[4], len[4], delay[4];
+    TEST_NAME(fwt_processor_acc) acc;
+    LTFAT_NAME(wfbt_plan)* tp = NULL;
+    LTFAT_NAME(fwt_processor_state)* p = NULL;
+
+    TEST_NAME(fillRand)(f, L * W);
+    TEST_NAME(fillRand)(gbuf, 2 * 6);
+    g[0] = gbuf; g[1] = gbuf + 6;
+    for (ltfat_int m = 0; m < 6; m++)
+        tg[m] = g[m % 2];
+    for (ltfat_int k = 0; k < 4; k++)
+    {
+        cref[k] = LTFAT_NAME_REAL(malloc)(L * W);
+        c[k] = LTFAT_NAME_REAL(malloc)(L * W);
+        len[k] = 0;
+    }
+    acc.c = c; acc.len = len; acc.cap = L;
+
+    mu_assert( LTFAT_NAME(wfbt_init)(J, tM, tg, tgl, ta, toff, tchild, toutidx,
+                                     L, W, ZERO, &tp) == LTFATERR_SUCCESS, "wfbt_init");
+    mu_assert( LTFAT_NAME(wfbt_get_outlens)(tp, Lc) == LTFATERR_SUCCESS,
+               "wfbt_get_outlens");
+    mu_assert( LTFAT_NAME(wfbt_execute)(tp, f, cref) == LTFATERR_SUCCESS,
+               "wfbt_execute");
+
+    mu_assert( LTFAT_NAME(fwt_processor_init)(g, gl, a, offset, M, J, W, bufLenMax, &p)
+               == LTFATERR_SUCCESS, "fwt_processor_init");
+    mu_assert( LTFAT_NAME(fwt_processor_getnout)(p) == 4, "fwt_processor_getnout");
+    mu_assert( LTFAT_NAME(fwt_processor_getdelay)(p, delay) == LTFATERR_SUCCESS,
+               "fwt_processor_getdelay");
+    mu_assert( LTFAT_NAME(fwt_processor_setcallback)(p, &TEST_NAME(fwt_processor_collect),
+               &acc) == LTFATERR_SUCCESS, "fwt_processor_setcallback");
+
+    // Stream the signal in chunks of varying length
+    for (ltfat_int l = 0, id = 0; l < L; id++)
+    {
+        ltfat_int chunk = ltfat_imin(chunks[id % ARRAYLEN(chunks)], L - l);
+        for (ltfat_int w = 0; w < W; w++)
+            in[w] = f + l + w * L;
+        mu_assert( LTFAT_NAME(fwt_processor_execute)(p, in, chunk, W)
+                   == LTFATERR_SUCCESS, "fwt_processor_execute");
+        l += chunk;
+    }
+
+    // The outputs the seen samples determine match the block transform
+    for (ltfat_int k = 0, ak; k < 4; k++)
+    {
+        double err = 0.0;
+        ak = k == 0 ? 8 : 1 << (J + 1 - k);
+        ltfat_int expected = (L - 1 - delay[k]) / ak + 1;
+        mu_assert( len[k] == expected, "fwt_processor subband %d has %d samples, expected %d",
+                   (int) k, (int) len[k], (int) expected);
+        mu_assert( len[k] <= Lc[k], "fwt_processor subband %d is too long", (int) k);
+
+        for (ltfat_int w = 0; w < W; w++)
+            for (ltfat_int n = 0; n < len[k]; n++)
+                err = fmax(err, ltfat_abs(c[k][n + w * L] - cref[k][n + w * Lc[k]]));
+        mu_assert( err < tol, "fwt_processor subband %d, err=%g", (int) k, err);
+    }
+
+    // Reset restarts the stream
+    for (ltfat_int k = 0; k < 4; k++)
+        len[k] = 0;
+    mu_assert( LTFAT_NAME(fwt_processor_reset)(p) == LTFATERR_SUCCESS,
+               "fwt_processor_reset");
+    mu_assert( LTFAT_NAME(fwt_processor_execute_compact)(p, f, bufLenMax, 1)
+               == LTFATERR_SUCCESS, "fwt_processor_execute_compact");
+    for (ltfat_int n = 0; n < len[3]; n++)
+        mu_assert( ltfat_abs(c[3][n] - cref[3][n]) < tol, "fwt_processor after reset");
+
+    mu_assert( LTFAT_NAME(fwt_processor_done)(&p) == LTFATERR_SUCCESS,
+               "fwt_processor_done");
+    mu_assert( p == NULL, "fwt_processor_done should set the state to NULL");
+
+    // Failed init leaves no state behind
+    p = (LTFAT_NAME(fwt_processor_state)*) gbuf;
+    mu_assert( LTFAT_NAME(fwt_processor_init)(g, gl, a, offset, 1, J, W, bufLenMax, &p)
+               == LTFATERR_NOTPOSARG, "fwt_processor_init M=1");
+    mu_assert( p == NULL, "fwt_processor_init should set the state to NULL on failure");
+
+    offset[1] = -6;
+    p = (LTFAT_NAME(fwt_processor_state)*) gbuf;
+    mu_assert( LTFAT_NAME(fwt_processor_init)(g, gl, a, offset, M, J, W, bufLenMax, &p)
+               == LTFATERR_BADARG, "fwt_processor_init bad offset");
+    mu_assert( p == NULL, "fwt_processor_init should set the state to NULL on failure");
+
+    LTFAT_NAME(wfbt_done)(&tp);
+    for (ltfat_int k = 0; k < 4; k++)
+    {
+        ltfat_free(cref[k]); ltfat_free(c[k]);
+    }
+    ltfat_free(f); ltfat_free(gbuf);
+    return 0;
+}
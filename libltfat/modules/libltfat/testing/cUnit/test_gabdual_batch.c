@@ -0,0 +1,75 @@
+int TEST_NAME(test_gabdual_batch)()
+{
+    // The first request is painless, the third repeats the second and
+    // the last one has the parameters of the second but another window
+    ltfat_int L[]  = { 240, 240, 240, 480, 240};
+    ltfat_int a[]  = {  10,  10,  10,  20,  10};
+    ltfat_int M[]  = {  24,  24,  24,  24,  24};
+    ltfat_int gl[] = {  24,  48,  48,  96,  48};
+    ltfat_int K = ARRAYLEN(L);
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    LTFAT_TYPE* g[ARRAYLEN(L)];
+    LTFAT_TYPE* gd[ARRAYLEN(L)];
+    LTFAT_TYPE* gt[ARRAYLEN(L)];
+    LTFAT_TYPE* glong = LTFAT_NAME(malloc)(480);
+    LTFAT_TYPE* gref = LTFAT_NAME(malloc)(480);
+    LTFAT_REAL* gr = LTFAT_NAME_REAL(malloc)(96);
+
+    for (ltfat_int k = 0; k < K; k++)
+    {
+        g[k] = LTFAT_NAME(malloc)(gl[k]);
+        gd[k] = LTFAT_NAME(malloc)(L[k]);
+        gt[k] = LTFAT_NAME(malloc)(L[k]);
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[k], gr);
+        for (ltfat_int l = 0; l < gl[k]; l++)
+            g[k][l] = gr[l];
+    }
+    TEST_NAME(fillRand)(g[K - 1], gl[K - 1]);
+
+    mu_assert( LTFAT_NAME(gabdual_batch)((const LTFAT_TYPE * const*) g, gl, L, a, M,
+                                         K, gd) == LTFATERR_SUCCESS, "gabdual_batch");
+    mu_assert( LTFAT_NAME(gabtight_batch)((const LTFAT_TYPE * const*) g, gl, L, a, M,
+                                          K, gt) == LTFATERR_SUCCESS, "gabtight_batch");
+
+    // Each request matches the single window computation
+    for (ltfat_int k = 0; k < K; k++)
+    {
+        double err = 0.0;
+        LTFAT_NAME(fir2long)(g[k], gl[k], L[k], glong);
+
+        mu_assert( LTFAT_NAME(gabdual_long)(glong, L[k], a[k], M[k], gref)
+                   == LTFATERR_SUCCESS, "gabdual_long");
+        for (ltfat_int l = 0; l < L[k]; l++)
+            err = fmax(err, ltfat_abs(gd[k][l] - gref[l]));
+        mu_assert( err < tol, "gabdual_batch, k=%d, err=%g", (int) k, err);
+
+        mu_assert( LTFAT_NAME(gabtight_long)(glong, L[k], a[k], M[k], gref)
+                   == LTFATERR_SUCCESS, "gabtight_long");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[k]; l++)
+            err = fmax(err, ltfat_abs(gt[k][l] - gref[l]));
+        mu_assert( err < tol, "gabtight_batch, k=%d, err=%g", (int) k, err);
+    }
+
+    mu_assert( LTFAT_NAME(gabdual_batch)(NULL, gl, L, a, M, K, gd)
+               == LTFATERR_NULLPOINTER, "gabdual_batch: Input is null");
+    mu_assert( LTFAT_NAME(gabtight_batch)((const LTFAT_TYPE * const*) g, gl, L, a, M,
+                                          K, NULL)
+               == LTFATERR_NULLPOINTER, "gabtight_batch: Output is null");
+    mu_assert( LTFAT_NAME(gabdual_batch)((const LTFAT_TYPE * const*) g, gl, L, a, M,
+                                         0, gd)
+               == LTFATERR_NOTPOSARG, "gabdual_batch: K is zero");
+
+    L[1] = 250;
+    mu_assert( LTFAT_NAME(gabdual_batch)((const LTFAT_TYPE * const*) g, gl, L, a, M,
+                                         K, gd)
+               == LTFATERR_BADTRALEN, "gabdual_batch: bad L");
+
+    for (ltfat_int k = 0; k < K; k++)
+    {
+        ltfat_free(g[k]); ltfat_free(gd[k]); ltfat_free(gt[k]);
+    }
+    ltfat_free(glong); ltfat_free(gref); ltfat_free(gr);
+    return 0;
+}
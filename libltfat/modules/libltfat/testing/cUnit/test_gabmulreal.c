@@ -0,0 +1,172 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+// Reference for the streaming, a plain processor callback applying the dense
+// symbol to every frame
+typedef struct
+{
+    const LTFAT_REAL* s;
+    ltfat_int N;
+    ltfat_int n;
+} TEST_NAME(gabmulreal_rtref);
+
+static void
+TEST_NAME(gabmulreal_rtrefcallback)(void* userdata, const LTFAT_COMPLEX in[],
+                                   int M2, int W, LTFAT_COMPLEX out[])
+{
+    TEST_NAME(gabmulreal_rtref)* r = (TEST_NAME(gabmulreal_rtref)*) userdata;
+    const LTFAT_REAL* scol = r->s + r->n * M2;
+
+    for (int w = 0; w < W; w++)
+        for (int m = 0; m < M2; m++)
+            out[m + w * M2] = in[m + w * M2] * scol[m];
+
+    r->n = (r->n + 1) % r->N;
+}
+
+int TEST_NAME(test_gabmulreal)()
+{
+    ltfat_int L = 120, W = 2, a = 10, M = 24, M2 = M / 2 + 1, N = L / a;
+    // Even analysis and odd synthesis window length
+    ltfat_int gal = 30, gsl = 25;
+    ltfat_int cols[] = { 7, 2, 11};
+    ltfat_int ncols = ARRAYLEN(cols), nactive = 0, computed, skipped;
+    double err, tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* ga = LTFAT_NAME_REAL(malloc)(gal);
+    LTFAT_REAL* gs = LTFAT_NAME_REAL(malloc)(gsl);
+    LTFAT_REAL* galong = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* gslong = LTFAT_NAME_REAL(malloc)(L);
+    LTFAT_REAL* s = LTFAT_NAME_REAL(malloc)(M2 * N);
+    LTFAT_REAL* ssparse = LTFAT_NAME_REAL(malloc)(M2 * ncols);
+    LTFAT_REAL* out = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_REAL* outref = LTFAT_NAME_REAL(malloc)(L * W);
+    LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M2 * N * W);
+    LTFAT_NAME(gabmulreal_plan)* p = NULL;
+    LTFAT_NAME(rtdgtreal_processor_state)* proc = NULL;
+    LTFAT_NAME(rtdgtreal_processor_state)* procref = NULL;
+    TEST_NAME(gabmulreal_rtref) rtref = { s, N, 0 };
+
+    TEST_NAME(fillRand)(f, L * W);
+    TEST_NAME(fillRand)(ga, gal);
+    TEST_NAME(fillRand)(gs, gsl);
+    TEST_NAME(fillRand)(s, M2 * N);
+    LTFAT_NAME(fir2long)(ga, gal, L, galong);
+    LTFAT_NAME(fir2long)(gs, gsl, L, gslong);
+
+    // Every third symbol column is zero
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        if (n % 3 == 1)
+            LTFAT_NAME(clear_array)(s + n * M2, M2);
+        else
+            nactive++;
+    }
+
+    // idgtreal(s.*dgtreal(f, ga), gs) on the full lattice
+    LTFAT_NAME(dgtreal_long)(f, galong, L, W, a, M, LTFAT_FREQINV, c);
+    for (ltfat_int w = 0; w < W; w++)
+        for (ltfat_int k = 0; k < M2 * N; k++)
+            c[k + w * M2 * N] *= s[k];
+    LTFAT_NAME(idgtreal_long)(c, gslong, L, W, a, M, LTFAT_FREQINV, outref);
+
+    mu_assert( LTFAT_NAME(gabmulreal)(f, ga, gal, gs, gsl, s, L, W, a, M, out)
+               == LTFATERR_SUCCESS, "gabmulreal");
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(out[l] - outref[l]));
+    mu_assert( err < tol, "gabmulreal, err=%g", err);
+
+    // The plan skips the zero columns
+    mu_assert( LTFAT_NAME(gabmulreal_init)(ga, gal, gs, gsl, L, a, M, FFTW_ESTIMATE, &p)
+               == LTFATERR_SUCCESS, "gabmulreal_init");
+    mu_assert( LTFAT_NAME(gabmulreal_set_symbol)(p, s) == LTFATERR_SUCCESS,
+               "gabmulreal_set_symbol");
+    mu_assert( LTFAT_NAME(gabmulreal_get_nactive)(p) == nactive, "gabmulreal_get_nactive");
+    mu_assert( LTFAT_NAME(gabmulreal_execute)(p, f, W, out) == LTFATERR_SUCCESS,
+               "gabmulreal_execute");
+    mu_assert( LTFAT_NAME(gabmulreal_get_framestats)(p, &computed, &skipped)
+               == LTFATERR_SUCCESS, "gabmulreal_get_framestats");
+    mu_assert( computed == nactive * W && skipped == (N - nactive) * W,
+               "gabmulreal computed %d and skipped %d frames", (int) computed, (int) skipped);
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(out[l] - outref[l]));
+    mu_assert( err < tol, "gabmulreal_execute, err=%g", err);
+
+    // The sparse symbol is the same as the dense one with the other columns zero
+    for (ltfat_int k = 0; k < ncols; k++)
+        memcpy(ssparse + k * M2, s + cols[k] * M2, M2 * sizeof * s);
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        ltfat_int k = 0;
+        while (k < ncols && cols[k] != n) k++;
+        if (k == ncols)
+            LTFAT_NAME(clear_array)(s + n * M2, M2);
+    }
+    mu_assert( LTFAT_NAME(gabmulreal_set_symbol_sparse)(p, ssparse, cols, ncols)
+               == LTFATERR_SUCCESS, "gabmulreal_set_symbol_sparse");
+    mu_assert( LTFAT_NAME(gabmulreal_get_nactive)(p) == ncols, "gabmulreal_get_nactive");
+    mu_assert( LTFAT_NAME(gabmulreal_execute)(p, f, W, out) == LTFATERR_SUCCESS,
+               "gabmulreal_execute");
+    mu_assert( LTFAT_NAME(gabmulreal)(f, ga, gal, gs, gsl, s, L, W, a, M, outref)
+               == LTFATERR_SUCCESS, "gabmulreal");
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(out[l] - outref[l]));
+    mu_assert( err < tol, "gabmulreal sparse symbol, err=%g", err);
+
+    // Streaming, the symbol columns are applied cyclically to the frames.
+    // Setting the symbol resets the frame statistics.
+    mu_assert( LTFAT_NAME(gabmulreal_set_symbol_sparse)(p, ssparse, cols, ncols)
+               == LTFATERR_SUCCESS, "gabmulreal_set_symbol_sparse");
+    mu_assert( LTFAT_NAME(rtdgtreal_processor_init)(ga, gal, gs, gsl, a, M, W, L, gal, &proc)
+               == LTFATERR_SUCCESS, "rtdgtreal_processor_init");
+    mu_assert( LTFAT_NAME(gabmulreal_attach_processor)(p, proc) == LTFATERR_SUCCESS,
+               "gabmulreal_attach_processor");
+    mu_assert( LTFAT_NAME(rtdgtreal_processor_execute_compact)(proc, f, L, W, out)
+               == LTFATERR_SUCCESS, "rtdgtreal_processor_execute_compact");
+    LTFAT_NAME(gabmulreal_get_framestats)(p, &computed, &skipped);
+    nactive = 0;
+    for (ltfat_int n = 0; n < computed + skipped; n++)
+        for (ltfat_int k = 0; k < ncols; k++)
+            nactive += cols[k] == n % N;
+    mu_assert( computed + skipped >= L / a && computed == nactive,
+               "gabmulreal streamed computed %d and skipped %d frames",
+               (int) computed, (int) skipped);
+
+    // The skipped frames must look like frames multiplied by a zero column
+    mu_assert( LTFAT_NAME(rtdgtreal_processor_init)(ga, gal, gs, gsl, a, M, W, L, gal,
+               &procref) == LTFATERR_SUCCESS, "rtdgtreal_processor_init");
+    mu_assert( LTFAT_NAME(rtdgtreal_processor_setcallback)(procref,
+               &TEST_NAME(gabmulreal_rtrefcallback), &rtref) == LTFATERR_SUCCESS,
+               "rtdgtreal_processor_setcallback");
+    mu_assert( LTFAT_NAME(rtdgtreal_processor_execute_compact)(procref, f, L, W, outref)
+               == LTFATERR_SUCCESS, "rtdgtreal_processor_execute_compact");
+    mu_assert( rtref.n == (computed + skipped) % N,
+               "reference streamed %d frames", (int) rtref.n);
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(out[l] - outref[l]));
+    mu_assert( err < tol, "gabmulreal streamed, err=%g", err);
+    LTFAT_NAME(rtdgtreal_processor_done)(&procref);
+    LTFAT_NAME(rtdgtreal_processor_done)(&proc);
+
+    mu_assert( LTFAT_NAME(gabmulreal_set_symbol_sparse)(p, ssparse, cols, N + 1)
+               == LTFATERR_BADSIZE, "gabmulreal_set_symbol_sparse too many columns");
+    cols[0] = N;
+    mu_assert( LTFAT_NAME(gabmulreal_set_symbol_sparse)(p, ssparse, cols, ncols)
+               == LTFATERR_BADARG, "gabmulreal_set_symbol_sparse bad column");
+    mu_assert( LTFAT_NAME(gabmulreal_execute)(p, f, W, f) == LTFATERR_BADARG,
+               "gabmulreal_execute inplace");
+    LTFAT_NAME(gabmulreal_done)(&p);
+
+    p = (LTFAT_NAME(gabmulreal_plan)*) f;
+    mu_assert( LTFAT_NAME(gabmulreal_init)(ga, gal, gs, gsl, L + 1, a, M, FFTW_ESTIMATE, &p)
+               == LTFATERR_BADTRALEN, "gabmulreal_init bad L");
+    mu_assert( p == NULL, "gabmulreal_init should set the plan to NULL on failure");
+
+    ltfat_free(f); ltfat_free(ga); ltfat_free(gs); ltfat_free(galong); ltfat_free(gslong);
+    ltfat_free(s); ltfat_free(ssparse); ltfat_free(out); ltfat_free(outref); ltfat_free(c);
+    return 0;
+}
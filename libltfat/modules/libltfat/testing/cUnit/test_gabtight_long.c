@@ -0,0 +1,69 @@
+int TEST_NAME(test_gabtight_long)()
+{
+    // The first one has singular factorization blocks
+    ltfat_int L[]  = { 240, 240, 480, 240};
+    ltfat_int a[]  = {  10,  10,  20,  10};
+    ltfat_int M[]  = {  24,  12,  24,  24};
+    ltfat_int gl[] = { 240,  48,  96,  24};
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int N = L[id] / a[id];
+        LTFAT_REAL* gr = LTFAT_NAME_REAL(malloc)(gl[id]);
+        LTFAT_TYPE* g = LTFAT_NAME(malloc)(gl[id]);
+        LTFAT_TYPE* glong = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_TYPE* gt = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_TYPE* gtt = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id]);
+        LTFAT_COMPLEX* fr = LTFAT_NAME_COMPLEX(malloc)(L[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M[id] * N);
+        double err = 0.0;
+
+        LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[id], gr);
+        for (ltfat_int l = 0; l < gl[id]; l++)
+            g[l] = gr[l];
+        LTFAT_NAME(fir2long)(g, gl[id], L[id], glong);
+        TEST_NAME(fillRand)(f, L[id]);
+
+        mu_assert( LTFAT_NAME(gabtight_long)(glong, L[id], a[id], M[id], gt)
+                   == LTFATERR_SUCCESS, "gabtight_long");
+
+        // Analysis and synthesis with the tight window reconstructs
+        LTFAT_NAME(dgt_long)(f, gt, L[id], 1, a[id], M[id], LTFAT_FREQINV, c);
+        LTFAT_NAME(idgt_long)(c, gt, L[id], 1, a[id], M[id], LTFAT_FREQINV, fr);
+        for (ltfat_int l = 0; l < L[id]; l++)
+            err = fmax(err, ltfat_abs(fr[l] - f[l]));
+        mu_assert( err < tol, "gabtight_long reconstruction, L=%d, a=%d, M=%d, gl=%d, err=%g",
+                   (int) L[id], (int) a[id], (int) M[id], (int) gl[id], err);
+
+        // The canonical tight window of a tight window is the window itself
+        mu_assert( LTFAT_NAME(gabtight_long)(gt, L[id], a[id], M[id], gtt)
+                   == LTFATERR_SUCCESS, "gabtight_long of gt");
+        err = 0.0;
+        for (ltfat_int l = 0; l < L[id]; l++)
+            err = fmax(err, ltfat_abs(gtt[l] - gt[l]));
+        mu_assert( err < tol, "gabtight_long is idempotent, L=%d, err=%g",
+                   (int) L[id], err);
+
+        // Same as the painless formula if the window is short enough
+        if (gl[id] <= M[id])
+        {
+            LTFAT_TYPE* gtp = LTFAT_NAME(malloc)(gl[id]);
+            mu_assert( LTFAT_NAME(gabtight_painless)(g, gl[id], a[id], M[id], gtp)
+                       == LTFATERR_SUCCESS, "gabtight_painless");
+            LTFAT_NAME(fir2long)(gtp, gl[id], L[id], gtt);
+            err = 0.0;
+            for (ltfat_int l = 0; l < L[id]; l++)
+                err = fmax(err, ltfat_abs(gtt[l] - gt[l]));
+            mu_assert( err < tol, "gabtight_long equals gabtight_painless, L=%d, err=%g",
+                       (int) L[id], err);
+            ltfat_free(gtp);
+        }
+
+        ltfat_free(gr); ltfat_free(g); ltfat_free(glong); ltfat_free(gt);
+        ltfat_free(gtt); ltfat_free(f); ltfat_free(fr); ltfat_free(c);
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+int TEST_NAME(test_gga)()
+{
+    ltfat_int L[] = { 1, 17, 100, 300};
+    ltfat_int M[] = { 3, 40,  33,   70};
+    ltfat_int W[] = { 1,  2,   3,    1};
+    ltfat_int nthreads[] = { 1, 4 };
+    // The error of the Goertzel recursion grows with L, relative tolerance
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-3;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id] * W[id]);
+        LTFAT_REAL* ind = LTFAT_NAME_REAL(malloc)(M[id]);
+        LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M[id] * W[id]);
+        LTFAT_COMPLEX* cref = LTFAT_NAME_COMPLEX(malloc)(M[id] * W[id]);
+        LTFAT_COMPLEX* c2 = LTFAT_NAME_COMPLEX(malloc)(M[id] * W[id]);
+
+        TEST_NAME(fillRand)(f, L[id] * W[id]);
+
+        // Arbitrary, also fractional and negative, frequency indices
+        for (ltfat_int m = 0; m < M[id]; m++)
+            ind[m] = (LTFAT_REAL) (0.37 * m - 0.25 * M[id]);
+
+        for (ltfat_int w = 0; w < W[id]; w++)
+            for (ltfat_int m = 0; m < M[id]; m++)
+            {
+                LTFAT_COMPLEX acc = 0.0;
+                for (ltfat_int l = 0; l < L[id]; l++)
+                {
+                    double ph = -2.0 * M_PI * ind[m] * l / L[id];
+                    acc += f[l + w * L[id]] * ((LTFAT_REAL) cos(ph) + I * (LTFAT_REAL) sin(ph));
+                }
+                cref[m + w * M[id]] = acc;
+            }
+
+        for (ltfat_int tId = 0; tId < (ltfat_int) ARRAYLEN(nthreads); tId++)
+        {
+            LTFAT_NAME(gga_plan) p = LTFAT_NAME(gga_init)(ind, M[id], L[id]);
+            double err = 0.0, nrm = 0.0;
+
+            mu_assert( p != NULL, "gga_init");
+            mu_assert( LTFAT_NAME(gga_set_nthreads)(p, nthreads[tId]) == LTFATERR_SUCCESS,
+                       "gga_set_nthreads");
+
+            LTFAT_NAME(gga_execute)(p, f, W[id], c);
+
+            for (ltfat_int l = 0; l < M[id] * W[id]; l++)
+            {
+                err = fmax(err, ltfat_abs(c[l] - cref[l]));
+                nrm = fmax(nrm, ltfat_abs(cref[l]));
+            }
+            mu_assert( err < tol * nrm, "gga, L=%d, nthreads=%d, err=%g",
+                       (int) L[id], (int) nthreads[tId], err);
+
+            // Executing the plan again gives the same result
+            LTFAT_NAME(gga_execute)(p, f, W[id], c2);
+            err = 0.0;
+            for (ltfat_int l = 0; l < M[id] * W[id]; l++)
+                err = fmax(err, ltfat_abs(c[l] - c2[l]));
+            mu_assert( err == 0.0, "gga plan is reusable");
+
+            if (id == 0)
+                mu_assert( LTFAT_NAME(gga_set_nthreads)(p, 0) == LTFATERR_NOTPOSARG,
+                           "nthreads is not positive");
+
+            LTFAT_NAME(gga_done)(p);
+        }
+
+        ltfat_free(f); ltfat_free(ind); ltfat_free(c); ltfat_free(cref);
+        ltfat_free(c2);
+    }
+
+    {
+        LTFAT_REAL ind = 1.0;
+        mu_assert( LTFAT_NAME(gga_init)(NULL, 1, 10) == NULL, "gga_init: NULL");
+        mu_assert( LTFAT_NAME(gga_init)(&ind, 0, 10) == NULL, "gga_init: M is not positive");
+        mu_assert( LTFAT_NAME(gga_init)(&ind, 1, 0) == NULL, "gga_init: L is not positive");
+        mu_assert( LTFAT_NAME(gga_set_nthreads)(NULL, 1) == LTFATERR_NULLPOINTER,
+                   "gga_set_nthreads: NULL");
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* f = ifft(F) accumulated in double */
+void TEST_NAME(ifilterbank_idft)(const LTFAT_COMPLEX* F, ltfat_int L, ltfat_int W,
+                                 LTFAT_COMPLEX* f)
+{
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        for (ltfat_int l = 0; l < L; l++)
+        {
+            double re = 0.0, im = 0.0;
+            for (ltfat_int k = 0; k < L; k++)
+            {
+                double ph = 2.0 * M_PI * ltfat_positiverem(k * l, L) / L;
+                double xr = ltfat_real(F[k + w * L]), xi = ltfat_imag(F[k + w * L]);
+                re += xr * cos(ph) - xi * sin(ph);
+                im += xr * sin(ph) + xi * cos(ph);
+            }
+            f[l + w * L] = (LTFAT_REAL) (re / L) + I * (LTFAT_REAL) (im / L);
+        }
+    }
+}
+
+int TEST_NAME(test_ifilterbank)()
+{
+    ltfat_int L = 48, W = 2, M = 6;
+    // A full length filter, band-limited filters sharing the number of
+    // coefficients, negative and wrapping offsets and a zero bandwidth one
+    ltfat_int Gl[] = { 48, 12, 12, 7, 0, 9};
+    ltfat_int foff[] = { 0, 5, -3, 44, 0, -20};
+    int realonly[] = { 0, 1, 0, 1, 0, 1};
+    double a[] = { 1.0, 4.0, 4.0, 6.0, 8.0, 3.2};
+    ltfat_int nthreads[] = { 1, 3};
+    ltfat_int Ntot = 0, Gtot = 0;
+    double err, nrm, tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    const LTFAT_COMPLEX* c[6], *G[6];
+    LTFAT_COMPLEX* cbuf, *Gbuf;
+    LTFAT_COMPLEX* F = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* f = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* fref = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_NAME(ifilterbank_plan)* p = NULL;
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        Ntot += (ltfat_int) floor(L / a[m] + 0.5);
+        Gtot += Gl[m];
+    }
+    // fillRand reseeds with the time, one call keeps the arrays different
+    cbuf = LTFAT_NAME_COMPLEX(malloc)(Ntot * W + Gtot);
+    Gbuf = cbuf + Ntot * W;
+    TEST_NAME_COMPLEX(fillRand)(cbuf, Ntot * W + Gtot);
+
+    for (ltfat_int m = 0, coff = 0, goff = 0; m < M; m++)
+    {
+        c[m] = cbuf + coff; G[m] = Gbuf + goff;
+        coff += (ltfat_int) floor(L / a[m] + 0.5) * W;
+        goff += Gl[m];
+    }
+
+    LTFAT_NAME(ifilterbank_fftbl)(c, G, L, Gl, W, a, M, foff, realonly, F);
+    TEST_NAME(ifilterbank_idft)(F, L, W, fref);
+    nrm = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        nrm = fmax(nrm, ltfat_abs(fref[l]));
+
+    mu_assert( LTFAT_NAME(ifilterbank)(c, G, Gl, foff, realonly, a, M, L, W, f)
+               == LTFATERR_SUCCESS, "ifilterbank");
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(f[l] - fref[l]));
+    mu_assert( err < tol * nrm, "ifilterbank, err=%g", err);
+
+    for (ltfat_int tId = 0; tId < (ltfat_int) ARRAYLEN(nthreads); tId++)
+    {
+        mu_assert( LTFAT_NAME(ifilterbank_init)(G, Gl, foff, realonly, a, M, L, W,
+                   FFTW_ESTIMATE, &p) == LTFATERR_SUCCESS, "ifilterbank_init");
+        mu_assert( LTFAT_NAME(ifilterbank_set_nthreads)(p, nthreads[tId])
+                   == LTFATERR_SUCCESS, "ifilterbank_set_nthreads");
+
+        // The plan is reusable
+        for (ltfat_int rep = 0; rep < 2; rep++)
+        {
+            mu_assert( LTFAT_NAME(ifilterbank_execute)(p, c, f) == LTFATERR_SUCCESS,
+                       "ifilterbank_execute");
+            err = 0.0;
+            for (ltfat_int l = 0; l < L * W; l++)
+                err = fmax(err, ltfat_abs(f[l] - fref[l]));
+            mu_assert( err < tol * nrm, "ifilterbank_execute, nthreads=%d, err=%g",
+                       (int) nthreads[tId], err);
+        }
+
+        mu_assert( LTFAT_NAME(ifilterbank_set_nthreads)(p, 0) == LTFATERR_NOTPOSARG,
+                   "ifilterbank_set_nthreads 0");
+        mu_assert( LTFAT_NAME(ifilterbank_done)(&p) == LTFATERR_SUCCESS,
+                   "ifilterbank_done");
+        mu_assert( p == NULL, "ifilterbank_done should set the plan to NULL");
+    }
+
+    p = (LTFAT_NAME(ifilterbank_plan)*) f;
+    Gl[1] = L + 1;
+    mu_assert( LTFAT_NAME(ifilterbank_init)(G, Gl, foff, realonly, a, M, L, W,
+               FFTW_ESTIMATE, &p) == LTFATERR_BADSIZE, "ifilterbank_init Gl > L");
+    mu_assert( p == NULL, "ifilterbank_init should set the plan to NULL on failure");
+    Gl[1] = 12;
+    a[4] = 2.0 * L + 1.0;
+    mu_assert( LTFAT_NAME(ifilterbank_init)(G, Gl, foff, realonly, a, M, L, W,
+               FFTW_ESTIMATE, &p) == LTFATERR_BADSIZE, "ifilterbank_init no coefficients");
+    a[4] = -1.0;
+    mu_assert( LTFAT_NAME(ifilterbank_init)(G, Gl, foff, realonly, a, M, L, W,
+               FFTW_ESTIMATE, &p) == LTFATERR_NOTPOSARG, "ifilterbank_init negative a");
+    mu_assert( LTFAT_NAME(ifilterbank_init)(G, Gl, foff, realonly, a, M, L, W,
+               FFTW_ESTIMATE, NULL) == LTFATERR_NULLPOINTER, "ifilterbank_init NULL plan");
+
+    ltfat_free(cbuf); ltfat_free(F); ltfat_free(f); ltfat_free(fref);
+    return 0;
+}
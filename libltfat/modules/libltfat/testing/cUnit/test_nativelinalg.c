@@ -0,0 +1,362 @@
+#include "ltfat/blaslapack.h"
+
+/* Max abs difference of two M x N column major matrices */
+double TEST_NAME(nativelinalg_maxdiff)(const LTFAT_COMPLEX* A, ltfat_int lda,
+                                       const LTFAT_COMPLEX* B, ltfat_int ldb,
+                                       ltfat_int M, ltfat_int N)
+{
+    double err = 0.0;
+    for (ltfat_int j = 0; j < N; j++)
+        for (ltfat_int i = 0; i < M; i++)
+            err = fmax(err, ltfat_abs(A[i + j * lda] - B[i + j * ldb]));
+    return err;
+}
+
+/* A = G**H * G + delta*I, G is K x N, the upper triangle of A is filled
+ * with garbage if lowonly */
+void TEST_NAME(nativelinalg_gram)(const LTFAT_COMPLEX* G, ltfat_int K, ltfat_int N,
+                                  double delta, int lowonly, LTFAT_COMPLEX* A,
+                                  ltfat_int lda)
+{
+    for (ltfat_int j = 0; j < N; j++)
+    {
+        for (ltfat_int i = 0; i < N; i++)
+        {
+            LTFAT_COMPLEX acc = 0.0;
+            for (ltfat_int k = 0; k < K; k++)
+                acc += conj(G[k + i * K]) * G[k + j * K];
+            if (i == j)
+                acc += (LTFAT_REAL) delta;
+            A[i + j * lda] = lowonly && i < j ? (LTFAT_COMPLEX) 1e3 : acc;
+        }
+    }
+}
+
+/* max |A*x - b| for the Hermitian A given by its lower triangle */
+double TEST_NAME(nativelinalg_hermres)(const LTFAT_COMPLEX* A, ltfat_int lda,
+                                       ltfat_int N, const LTFAT_COMPLEX* x,
+                                       const LTFAT_COMPLEX* b)
+{
+    double err = 0.0;
+    for (ltfat_int i = 0; i < N; i++)
+    {
+        LTFAT_COMPLEX acc = 0.0;
+        for (ltfat_int j = 0; j < N; j++)
+            acc += (i >= j ? A[i + j * lda] : conj(A[j + i * lda])) * x[j];
+        err = fmax(err, ltfat_abs(acc - b[i]));
+    }
+    return err;
+}
+
+int TEST_NAME(test_nativelinalg)()
+{
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-3;
+    // fillRand reseeds with the time, all the random data come from one call
+    ltfat_int nrand = 4096;
+    LTFAT_COMPLEX* rnd = LTFAT_NAME_COMPLEX(malloc)(nrand);
+    TEST_NAME_COMPLEX(fillRand)(rnd, nrand);
+
+    // posv, A*X = B with a positive definite A
+    {
+        ltfat_int N = 9, K = 14, NRHS = 3, lda = N + 2, ldb = N + 1;
+        const LTFAT_COMPLEX* G = rnd, *Bin = rnd + K * N;
+        LTFAT_COMPLEX* A = LTFAT_NAME_COMPLEX(malloc)(lda * N);
+        LTFAT_COMPLEX* A0 = LTFAT_NAME_COMPLEX(malloc)(lda * N);
+        LTFAT_COMPLEX* B = LTFAT_NAME_COMPLEX(malloc)(ldb * NRHS);
+        double err = 0.0;
+
+        TEST_NAME(nativelinalg_gram)(G, K, N, 0.0, 0, A0, lda);
+        memcpy(A, A0, lda * N * sizeof * A);
+        for (ltfat_int r = 0; r < NRHS; r++)
+            memcpy(B + r * ldb, Bin + r * N, N * sizeof * B);
+
+        mu_assert( LTFAT_NAME(posv)(N, NRHS, A, lda, B, ldb) == 0, "posv");
+        for (ltfat_int r = 0; r < NRHS; r++)
+            err = fmax(err, TEST_NAME(nativelinalg_hermres)(A0, lda, N, B + r * ldb,
+                       Bin + r * N));
+        mu_assert( err < tol * N, "posv residual %g", err);
+
+        // Zero column 4, the leading minor of order 5 is singular
+        TEST_NAME(nativelinalg_gram)(G, K, N, 0.0, 0, A, lda);
+        for (ltfat_int k = 0; k < N; k++)
+            A[k + 4 * lda] = A[4 + k * lda] = 0.0;
+        mu_assert( LTFAT_NAME(posv)(N, NRHS, A, lda, B, ldb) == 5,
+                   "posv should fail on a singular matrix");
+
+        ltfat_free(A); ltfat_free(A0); ltfat_free(B);
+    }
+
+    // gemm against the triple loop, K spans several column blocks of A
+    {
+        ltfat_int M = 7, N = 5, K = 133, lda = K + 1, ldb = K + 2, ldc = M + 3;
+        enum CBLAS_TRANSPOSE tr[] = { CblasNoTrans, CblasTrans, CblasConjTrans};
+        LTFAT_COMPLEX alpha = (LTFAT_REAL) 0.5 - I * (LTFAT_REAL) 1.5;
+        LTFAT_COMPLEX beta[] = { 0.0, 1.0, (LTFAT_REAL) -0.25 + I * (LTFAT_REAL) 2.0 };
+        const LTFAT_COMPLEX* A = rnd, *B = rnd + 1100, *C0 = rnd + 3000;
+        LTFAT_COMPLEX* C = LTFAT_NAME_COMPLEX(malloc)(ldc * N);
+        LTFAT_COMPLEX* Cref = LTFAT_NAME_COMPLEX(malloc)(ldc * N);
+
+        // A and B are big enough for both M x K and K x M, K x N and N x K
+        mu_assert( lda * M <= 1100 && (M + 1) * K <= 1100 && 1100 + ldb * N <= 3000 &&
+                   1100 + (N + 2) * K <= 3000 && 3000 + ldc * N <= nrand, "gemm sizes");
+
+        for (int ta = 0; ta < 3; ta++)
+        {
+            for (int tb = 0; tb < 3; tb++)
+            {
+                for (int be = 0; be < (int) ARRAYLEN(beta); be++)
+                {
+                    ltfat_int lda_ = tr[ta] == CblasNoTrans ? M + 1 : lda;
+                    ltfat_int ldb_ = tr[tb] == CblasNoTrans ? ldb : N + 2;
+                    double err;
+
+                    for (ltfat_int j = 0; j < N; j++)
+                    {
+                        for (ltfat_int i = 0; i < M; i++)
+                        {
+                            double re = 0.0, im = 0.0;
+                            LTFAT_COMPLEX v;
+                            for (ltfat_int l = 0; l < K; l++)
+                            {
+                                LTFAT_COMPLEX av = tr[ta] == CblasNoTrans ?
+                                                   A[i + l * lda_] : A[l + i * lda_];
+                                LTFAT_COMPLEX bv = tr[tb] == CblasNoTrans ?
+                                                   B[l + j * ldb_] : B[j + l * ldb_];
+                                if (tr[ta] == CblasConjTrans) av = conj(av);
+                                if (tr[tb] == CblasConjTrans) bv = conj(bv);
+                                re += ltfat_real(av) * ltfat_real(bv) - ltfat_imag(av) * ltfat_imag(bv);
+                                im += ltfat_real(av) * ltfat_imag(bv) + ltfat_imag(av) * ltfat_real(bv);
+                            }
+                            v = (LTFAT_REAL) re + I * (LTFAT_REAL) im;
+                            Cref[i + j * ldc] = alpha * v + beta[be] * C0[i + j * ldc];
+                        }
+                    }
+
+                    memcpy(C, C0, ldc * N * sizeof * C);
+                    LTFAT_NAME(gemm)(tr[ta], tr[tb], M, N, K, &alpha, A, lda_, B, ldb_,
+                                     &beta[be], C, ldc);
+                    err = TEST_NAME(nativelinalg_maxdiff)(C, ldc, Cref, ldc, M, N);
+                    mu_assert( err < tol * K, "gemm transa=%d, transb=%d, beta=%d, err=%g",
+                               ta, tb, be, err);
+                    // The padding of C is left alone
+                    mu_assert( C[M + ldc * (N - 1)] == C0[M + ldc * (N - 1)],
+                               "gemm wrote outside of C");
+                }
+            }
+        }
+
+        ltfat_free(C); ltfat_free(Cref);
+    }
+
+    // gesvd, wide, tall, square and rank deficient
+    {
+        ltfat_int Ms[] = { 6, 9, 7, 8 };
+        ltfat_int Ns[] = { 9, 6, 7, 5 };
+        ltfat_int rank[] = { 6, 6, 7, 2 };
+
+        for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(Ms); id++)
+        {
+            ltfat_int M = Ms[id], N = Ns[id], m = M < N ? M : N;
+            ltfat_int lda = M + 1, ldu = M + 2, ldvt = m + 1;
+            LTFAT_COMPLEX* A = LTFAT_NAME_COMPLEX(malloc)(lda * N);
+            LTFAT_COMPLEX* A0 = LTFAT_NAME_COMPLEX(malloc)(lda * N);
+            LTFAT_COMPLEX* U = LTFAT_NAME_COMPLEX(malloc)(ldu * m);
+            LTFAT_COMPLEX* VT = LTFAT_NAME_COMPLEX(malloc)(ldvt * N);
+            LTFAT_REAL* S = LTFAT_NAME_REAL(malloc)(m);
+            double err = 0.0, errU = 0.0, errV = 0.0;
+
+            // A = X*Y with X M x rank and Y rank x N
+            for (ltfat_int j = 0; j < N; j++)
+            {
+                for (ltfat_int i = 0; i < M; i++)
+                {
+                    LTFAT_COMPLEX acc = 0.0;
+                    if (rank[id] == m)
+                        acc = rnd[i + j * M];
+                    else
+                        for (ltfat_int k = 0; k < rank[id]; k++)
+                            acc += rnd[i + k * M] * rnd[1000 + k + j * rank[id]];
+                    A0[i + j * lda] = acc;
+                }
+            }
+            memcpy(A, A0, lda * N * sizeof * A);
+
+            mu_assert( LTFAT_NAME(gesvd)(M, N, A, lda, S, U, ldu, VT, ldvt) == 0,
+                       "gesvd M=%d, N=%d", (int) M, (int) N);
+
+            for (ltfat_int k = 0; k < m; k++)
+                mu_assert( S[k] >= 0.0 && (k == 0 || S[k] <= S[k - 1]),
+                           "gesvd singular values are not sorted");
+            for (ltfat_int k = rank[id]; k < m; k++)
+                mu_assert( S[k] < tol * S[0], "gesvd rank %d, S[%d]=%g",
+                           (int) rank[id], (int) k, (double) S[k]);
+
+            // U*S*VT = A
+            for (ltfat_int j = 0; j < N; j++)
+            {
+                for (ltfat_int i = 0; i < M; i++)
+                {
+                    LTFAT_COMPLEX acc = 0.0;
+                    for (ltfat_int k = 0; k < m; k++)
+                        acc += U[i + k * ldu] * S[k] * VT[k + j * ldvt];
+                    err = fmax(err, ltfat_abs(acc - A0[i + j * lda]));
+                }
+            }
+
+            // U**H*U = I and VT*VT**H = I, also for the null space vectors
+            for (ltfat_int k1 = 0; k1 < m; k1++)
+            {
+                for (ltfat_int k2 = 0; k2 < m; k2++)
+                {
+                    LTFAT_COMPLEX uu = 0.0, vv = 0.0;
+                    for (ltfat_int i = 0; i < M; i++)
+                        uu += conj(U[i + k1 * ldu]) * U[i + k2 * ldu];
+                    for (ltfat_int j = 0; j < N; j++)
+                        vv += VT[k1 + j * ldvt] * conj(VT[k2 + j * ldvt]);
+                    errU = fmax(errU, ltfat_abs(uu - (LTFAT_REAL) (k1 == k2)));
+                    errV = fmax(errV, ltfat_abs(vv - (LTFAT_REAL) (k1 == k2)));
+                }
+            }
+
+            mu_assert( err < tol * S[0], "gesvd M=%d, N=%d, rank=%d: ||USVT - A||=%g",
+                       (int) M, (int) N, (int) rank[id], err);
+            mu_assert( errU < tol && errV < tol,
+                       "gesvd M=%d, N=%d, rank=%d: orthonormality of U %g, of VT %g",
+                       (int) M, (int) N, (int) rank[id], errU, errV);
+
+            ltfat_free(A); ltfat_free(A0); ltfat_free(U); ltfat_free(VT); ltfat_free(S);
+        }
+    }
+
+    // hermsystemsolver reads only the lower triangle
+    {
+        ltfat_int Mmax = 12, Mtest[] = { 12, 4 }, K = 20;
+        LTFAT_COMPLEX* A = LTFAT_NAME_COMPLEX(malloc)(Mmax * Mmax);
+        LTFAT_COMPLEX* b = LTFAT_NAME_COMPLEX(malloc)(Mmax);
+        LTFAT_NAME_COMPLEX(hermsystemsolver_plan)* p = NULL;
+
+        mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_init)(Mmax, &p) == LTFATERR_SUCCESS,
+                   "hermsystemsolver_init");
+
+        for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(Mtest); id++)
+        {
+            ltfat_int M = Mtest[id];
+            const LTFAT_COMPLEX* bin = rnd + 2000;
+            double err;
+
+            TEST_NAME(nativelinalg_gram)(rnd, K, M, 0.0, 1, A, M);
+            memcpy(b, bin, M * sizeof * b);
+            mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(p, A, M, b) == 0,
+                       "hermsystemsolver_execute M=%d", (int) M);
+            err = TEST_NAME(nativelinalg_hermres)(A, M, M, b, bin);
+            mu_assert( err < tol * M, "hermsystemsolver M=%d, residual %g", (int) M, err);
+        }
+
+        // A zero pivot is reported
+        TEST_NAME(nativelinalg_gram)(rnd, K, Mmax, 0.0, 1, A, Mmax);
+        for (ltfat_int k = 0; k < Mmax; k++)
+            A[k + 3 * Mmax] = A[3 + k * Mmax] = 0.0;
+        mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_execute)(p, A, Mmax, b) > 0,
+                   "hermsystemsolver_execute should fail on a singular matrix");
+
+        mu_assert( LTFAT_NAME_COMPLEX(hermsystemsolver_done)(&p) == LTFATERR_SUCCESS,
+                   "hermsystemsolver_done");
+        ltfat_free(A); ltfat_free(b);
+    }
+
+    // LocOMP runs on top of hermsystemsolver
+    {
+        ltfat_int L = 480, P = 2;
+        ltfat_int gl[] = { 96, 48};
+        ltfat_int a[]  = { 24, 12};
+        ltfat_int M[]  = { 96, 48};
+        size_t maxatoms[] = { 10, 40, 160 };
+        double errdb[3];
+        LTFAT_REAL* g[2];
+        LTFAT_COMPLEX* c[2];
+        LTFAT_REAL* f = LTFAT_NAME_REAL(malloc)(L);
+        LTFAT_REAL* fout = LTFAT_NAME_REAL(malloc)(L);
+        ltfat_dgtmp_params* params = ltfat_dgtmp_params_allocdef();
+
+        // Two stationary tones away from DC and Nyquist. The atoms along time
+        // overlap, so LocOMP solves Gram systems of the neighbors.
+        for (ltfat_int l = 0; l < L; l++)
+            f[l] = (LTFAT_REAL) (cos(2.0 * M_PI * 0.2 * l) + 0.5 * cos(2.0 * M_PI * 0.27 * l) +
+                                 0.1 * (ltfat_real(rnd[l]) - 0.5));
+
+        for (ltfat_int k = 0; k < P; k++)
+        {
+            g[k] = LTFAT_NAME_REAL(malloc)(gl[k]);
+            LTFAT_NAME_REAL(firwin)(LTFAT_HANN, gl[k], g[k]);
+            LTFAT_NAME_REAL(normalize)(g[k], gl[k], LTFAT_NORM_ENERGY, g[k]);
+            c[k] = LTFAT_NAME_COMPLEX(malloc)((M[k] / 2 + 1) * (L / a[k]));
+        }
+
+        ltfat_dgtmp_setpar_alg(params, ltfat_dgtmp_alg_locomp);
+        // LocOMP only looks for neighbors one kernel height away from DC
+        // and Nyquist, the kernels must be shorter than the default ones
+        ltfat_dgtmp_setpar_kernrelthr(params, 1e-3);
+        // The error update of LocOMP is only approximate
+        ltfat_dgtmp_setpar_errresync(params, 1);
+        // Stop on the number of atoms only
+        ltfat_dgtmp_setpar_errtoldb(params, -200.0);
+
+        for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(maxatoms); id++)
+        {
+            LTFAT_NAME(dgtrealmp_state)* p = NULL;
+            double fnorm2 = 0.0, rnorm2 = 0.0, truedb;
+            int status;
+
+            ltfat_dgtmp_setpar_maxatoms(params, maxatoms[id]);
+            // Not limited by the number of iterations
+            ltfat_dgtmp_setpar_maxit(params, 100 * maxatoms[id]);
+            mu_assert( LTFAT_NAME(dgtrealmp_init_gen)((const LTFAT_REAL**) g, gl,
+                       L, P, a, M, params, &p) == LTFATERR_SUCCESS, "dgtrealmp_init_gen");
+
+            status = LTFAT_NAME(dgtrealmp_execute_decompose)(p, f, c);
+            mu_assert( status == LTFAT_DGTREALMP_STATUS_MAXATOMS,
+                       "locomp with %zu atoms, status=%d", maxatoms[id], status);
+            LTFAT_NAME(dgtrealmp_get_errdb)(p, &errdb[id]);
+
+            LTFAT_NAME(dgtrealmp_execute_synthesize)(p, (const LTFAT_COMPLEX**) c, NULL, fout);
+            for (ltfat_int l = 0; l < L; l++)
+            {
+                fnorm2 += (double) f[l] * f[l];
+                rnorm2 += (double) (f[l] - fout[l]) * (f[l] - fout[l]);
+            }
+            truedb = 10.0 * log10(rnorm2 / fnorm2);
+            mu_assert( fabs(errdb[id] - truedb) < 1e-1,
+                       "locomp with %zu atoms: err=%g dB, true=%g dB",
+                       maxatoms[id], errdb[id], truedb);
+            mu_assert( id == 0 || errdb[id] < errdb[id - 1],
+                       "locomp residual did not decrease: %g dB with %zu atoms",
+                       errdb[id], maxatoms[id]);
+
+            LTFAT_NAME(dgtrealmp_done)(&p);
+        }
+
+        // The projections make LocOMP better than MP with the same atoms
+        {
+            LTFAT_NAME(dgtrealmp_state)* p = NULL;
+            double mpdb;
+
+            ltfat_dgtmp_setpar_alg(params, ltfat_dgtmp_alg_mp);
+            mu_assert( LTFAT_NAME(dgtrealmp_init_gen)((const LTFAT_REAL**) g, gl,
+                       L, P, a, M, params, &p) == LTFATERR_SUCCESS, "dgtrealmp_init_gen");
+            LTFAT_NAME(dgtrealmp_execute_decompose)(p, f, c);
+            LTFAT_NAME(dgtrealmp_get_errdb)(p, &mpdb);
+            mu_assert( errdb[2] < mpdb, "locomp %g dB, mp %g dB", errdb[2], mpdb);
+            LTFAT_NAME(dgtrealmp_done)(&p);
+        }
+
+        for (ltfat_int k = 0; k < P; k++)
+        {
+            ltfat_free(g[k]); ltfat_free(c[k]);
+        }
+        ltfat_free(f); ltfat_free(fout);
+        ltfat_dgtmp_params_free(params);
+    }
+
+    ltfat_free(rnd);
+    return 0;
+}
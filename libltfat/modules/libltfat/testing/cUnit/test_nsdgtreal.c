@@ -0,0 +1,128 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* Direct evaluation of nsdgt.m for one frame and one channel:
+ * c[m] = sum_j f(timepos+j)*g(j)*exp(-2*pi*i*m*j/M), j=-floor(gl/2)..ceil(gl/2)-1 */
+void TEST_NAME(nsdgtreal_frame)(const LTFAT_REAL* f, ltfat_int L, const LTFAT_REAL* g,
+                                ltfat_int gl, ltfat_int timepos, ltfat_int M,
+                                LTFAT_COMPLEX* c)
+{
+    ltfat_int h = gl / 2;
+    for (ltfat_int m = 0; m < M / 2 + 1; m++)
+    {
+        double re = 0.0, im = 0.0;
+        for (ltfat_int j = -h; j < gl - h; j++)
+        {
+            double x = f[ltfat_positiverem(timepos + j, L)] * g[ltfat_positiverem(j, gl)];
+            double ph = -2.0 * M_PI * ltfat_positiverem(m * j, M) / M;
+            re += x * cos(ph);
+            im += x * sin(ph);
+        }
+        c[m] = (LTFAT_REAL) re + I * (LTFAT_REAL) im;
+    }
+}
+
+int TEST_NAME(test_nsdgtreal)()
+{
+    // Frame 1 has a single sample window and frame 2 is folded (M < gl)
+    ltfat_int a[]  = {  4,  6,  5, 3,  6};
+    ltfat_int gl[] = {  8,  1,  9, 6, 12};
+    ltfat_int M[]  = {  8,  4,  6, 6, 12};
+    // Painless system for the reconstruction
+    ltfat_int glp[] = { 8, 12,  9, 6, 12};
+    ltfat_int Mp[]  = { 8, 12, 10, 6, 12};
+    ltfat_int N = ARRAYLEN(a), W = 2, L = 0, clen = 0;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    const LTFAT_REAL* g[ARRAYLEN(a)];
+    LTFAT_REAL* gd[ARRAYLEN(a)];
+    LTFAT_REAL* gbuf = LTFAT_NAME_REAL(malloc)(N * 12);
+    LTFAT_REAL* gdbuf = LTFAT_NAME_REAL(malloc)(N * 12);
+    LTFAT_REAL* f, *fr;
+    LTFAT_COMPLEX* c, *cref;
+    LTFAT_NAME(nsdgtreal_plan)* p = NULL;
+    double err = 0.0;
+
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        L += a[n];
+        clen += (ltfat_imax(M[n], Mp[n]) / 2 + 1) * W;
+        g[n] = gbuf + 12 * n;
+        gd[n] = gdbuf + 12 * n;
+    }
+    f = LTFAT_NAME_REAL(malloc)(L * W);
+    fr = LTFAT_NAME_REAL(malloc)(L * W);
+    c = LTFAT_NAME_COMPLEX(malloc)(clen);
+    cref = LTFAT_NAME_COMPLEX(malloc)(clen);
+    TEST_NAME(fillRand)(f, L * W);
+    TEST_NAME(fillRand)(gbuf, N * 12);
+
+    // The plan against the direct formula, frame centers are cumsum(a)-a(1)
+    mu_assert( LTFAT_NAME(nsdgtreal_init)(g, gl, a, M, N, W, FFTW_ESTIMATE, &p)
+               == LTFATERR_SUCCESS, "nsdgtreal_init");
+    mu_assert( LTFAT_NAME(nsdgtreal_get_L)(p) == L, "nsdgtreal_get_L");
+    mu_assert( LTFAT_NAME(nsdgtreal_set_nthreads)(p, 2) == LTFATERR_SUCCESS,
+               "nsdgtreal_set_nthreads");
+    mu_assert( LTFAT_NAME(nsdgtreal_execute)(p, f, c) == LTFATERR_SUCCESS,
+               "nsdgtreal_execute");
+
+    ltfat_int timepos = 0, coff = 0;
+    for (ltfat_int n = 0; n < N; n++)
+    {
+        ltfat_int M2 = M[n] / 2 + 1;
+        if (n > 0) timepos += a[n];
+        for (ltfat_int w = 0; w < W; w++)
+            TEST_NAME(nsdgtreal_frame)(f + w * L, L, g[n], gl[n], timepos, M[n],
+                                       cref + coff + w * M2);
+        coff += M2 * W;
+    }
+    mu_assert( LTFAT_NAME(nsdgtreal_get_coeflen)(p) == coff, "nsdgtreal_get_coeflen");
+    for (ltfat_int l = 0; l < coff; l++)
+        err = fmax(err, ltfat_abs(c[l] - cref[l]));
+    mu_assert( err < tol, "nsdgtreal, err=%g", err);
+    LTFAT_NAME(nsdgtreal_done)(&p);
+
+    // Analysis with a painless system and synthesis with its dual
+    mu_assert( LTFAT_NAME(nsgabdual_painless)(g, glp, a, Mp, N, gd)
+               == LTFATERR_SUCCESS, "nsgabdual_painless");
+    mu_assert( LTFAT_NAME(nsdgtreal)(f, g, glp, a, Mp, N, W, c) == LTFATERR_SUCCESS,
+               "nsdgtreal");
+    mu_assert( LTFAT_NAME(insdgtreal)(c, (const LTFAT_REAL**) gd, glp, a, Mp, N, W, fr)
+               == LTFATERR_SUCCESS, "insdgtreal");
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(fr[l] - f[l]));
+    mu_assert( err < tol, "nsdgtreal/insdgtreal with the dual windows, err=%g", err);
+
+    // Same with the tight windows
+    mu_assert( LTFAT_NAME(nsgabtight_painless)(g, glp, a, Mp, N, gd)
+               == LTFATERR_SUCCESS, "nsgabtight_painless");
+    mu_assert( LTFAT_NAME(nsdgtreal)(f, (const LTFAT_REAL**) gd, glp, a, Mp, N, W, c)
+               == LTFATERR_SUCCESS, "nsdgtreal");
+    mu_assert( LTFAT_NAME(insdgtreal)(c, (const LTFAT_REAL**) gd, glp, a, Mp, N, W, fr)
+               == LTFATERR_SUCCESS, "insdgtreal");
+    err = 0.0;
+    for (ltfat_int l = 0; l < L * W; l++)
+        err = fmax(err, ltfat_abs(fr[l] - f[l]));
+    mu_assert( err < tol, "nsdgtreal/insdgtreal with the tight windows, err=%g", err);
+
+    // The frames must cover the signal and the plans are not interchangeable
+    mu_assert( LTFAT_NAME(nsgabdual_painless)(g, gl, a, Mp, N, gd)
+               == LTFATERR_NOTAFRAME, "nsgabdual_painless not a frame");
+    mu_assert( LTFAT_NAME(nsgabdual_painless)(g, glp, a, M, N, gd)
+               == LTFATERR_NOTPAINLESS, "nsgabdual_painless not painless");
+    mu_assert( LTFAT_NAME(insdgtreal_init)(g, gl, a, M, N, W, FFTW_ESTIMATE, &p)
+               == LTFATERR_SUCCESS, "insdgtreal_init");
+    mu_assert( LTFAT_NAME(nsdgtreal_execute)(p, f, c) == LTFATERR_BADARG,
+               "nsdgtreal_execute with an inverse plan");
+    LTFAT_NAME(insdgtreal_done)(&p);
+
+    a[0] = 0;
+    p = (LTFAT_NAME(nsdgtreal_plan)*) gbuf;
+    mu_assert( LTFAT_NAME(nsdgtreal_init)(g, gl, a, M, N, W, FFTW_ESTIMATE, &p)
+               == LTFATERR_NOTPOSARG, "nsdgtreal_init a=0");
+    mu_assert( p == NULL, "nsdgtreal_init should set the plan to NULL on failure");
+
+    ltfat_free(gbuf); ltfat_free(gdbuf); ltfat_free(f); ltfat_free(fr);
+    ltfat_free(c); ltfat_free(cref);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* c(n) = sum_k f(n*a + k) conj(g(k)) accumulated in double, g(k) for k < 0
+ * is at g[gl + k] */
+void TEST_NAME(pfilt_ref)(const LTFAT_TYPE* f, const LTFAT_TYPE* g, ltfat_int gl,
+                          ltfat_int L, ltfat_int W, ltfat_int a, LTFAT_TYPE* c)
+{
+    ltfat_int N = L / a, glh = gl / 2;
+
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        for (ltfat_int n = 0; n < N; n++)
+        {
+            double re = 0.0, im = 0.0;
+            for (ltfat_int k = -glh; k < gl - glh; k++)
+            {
+                LTFAT_TYPE fv = f[ltfat_positiverem(n * a + k, L) + w * L];
+                LTFAT_TYPE gv = g[ltfat_positiverem(k, gl)];
+                re += ltfat_real(fv) * ltfat_real(gv) + ltfat_imag(fv) * ltfat_imag(gv);
+                im += ltfat_imag(fv) * ltfat_real(gv) - ltfat_real(fv) * ltfat_imag(gv);
+            }
+            c[n + w * N] = (LTFAT_REAL) re + I * (LTFAT_REAL) im;
+        }
+    }
+}
+
+int TEST_NAME(test_pfilt)()
+{
+    ltfat_int L = 240, W = 3;
+    // Odd W leaves a half used FFT column in the real case
+    ltfat_int gl[] = { 1, 6, 15, 33, 240};
+    ltfat_int a[] = { 1, 3, 4};
+    ltfat_pfilt_hint hint[] = { ltfat_pfilt_direct, ltfat_pfilt_fft, ltfat_pfilt_fftpart,
+                                ltfat_pfilt_auto
+                              };
+    ltfat_int noverlapsave = 0, npartitioned = 0;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    LTFAT_TYPE* f = LTFAT_NAME(malloc)(L * W);
+    LTFAT_TYPE* g = LTFAT_NAME(malloc)(L);
+    LTFAT_TYPE* c = LTFAT_NAME(malloc)(L * W);
+    LTFAT_TYPE* cref = LTFAT_NAME(malloc)(L * W);
+    LTFAT_NAME(pfilt_plan)* p = NULL;
+
+    TEST_NAME(fillRand)(f, L * W);
+    TEST_NAME(fillRand)(g, L);
+
+    for (ltfat_int gId = 0; gId < (ltfat_int) ARRAYLEN(gl); gId++)
+    {
+        for (ltfat_int aId = 0; aId < (ltfat_int) ARRAYLEN(a); aId++)
+        {
+            ltfat_int N = L / a[aId];
+            double nrm = 0.0;
+
+            TEST_NAME(pfilt_ref)(f, g, gl[gId], L, W, a[aId], cref);
+            for (ltfat_int n = 0; n < N * W; n++)
+                nrm = fmax(nrm, ltfat_abs(cref[n]));
+
+            for (ltfat_int hId = 0; hId < (ltfat_int) ARRAYLEN(hint); hId++)
+            {
+                ltfat_int fftlen;
+                double err = 0.0;
+
+                mu_assert( LTFAT_NAME(pfilt_init)(g, gl[gId], L, W, a[aId], hint[hId],
+                                                  FFTW_ESTIMATE, &p) == LTFATERR_SUCCESS,
+                           "pfilt_init");
+                fftlen = LTFAT_NAME(pfilt_get_fftlen)(p);
+                if (hint[hId] != ltfat_pfilt_auto)
+                    mu_assert( LTFAT_NAME(pfilt_get_method)(p) == (int) hint[hId],
+                               "pfilt_get_method");
+                if (LTFAT_NAME(pfilt_get_method)(p) == ltfat_pfilt_direct)
+                    mu_assert( fftlen == 0, "pfilt_get_fftlen direct");
+                else if (LTFAT_NAME(pfilt_get_method)(p) == ltfat_pfilt_fftpart)
+                    mu_assert( ltfat_ispow2(fftlen) && fftlen <= 2 * ltfat_nextpow2(gl[gId]),
+                               "pfilt_get_fftlen partitioned %d", (int) fftlen);
+                else
+                    mu_assert( fftlen == L || (fftlen < L && fftlen >= 2 * gl[gId] &&
+                               ltfat_ispow2(fftlen)), "pfilt_get_fftlen %d", (int) fftlen);
+                noverlapsave += LTFAT_NAME(pfilt_get_method)(p) == ltfat_pfilt_fft &&
+                                fftlen > 0 && fftlen < L;
+                npartitioned += LTFAT_NAME(pfilt_get_method)(p) == ltfat_pfilt_fftpart &&
+                                fftlen < 2 * gl[gId];
+
+                mu_assert( LTFAT_NAME(pfilt_execute)(p, f, c) == LTFATERR_SUCCESS,
+                           "pfilt_execute");
+                for (ltfat_int n = 0; n < N * W; n++)
+                    err = fmax(err, ltfat_abs(c[n] - cref[n]));
+                mu_assert( err < tol * nrm, "pfilt_execute gl=%d, a=%d, hint=%d, err=%g",
+                           (int) gl[gId], (int) a[aId], (int) hint[hId], err);
+
+                mu_assert( LTFAT_NAME(pfilt_done)(&p) == LTFATERR_SUCCESS, "pfilt_done");
+                mu_assert( p == NULL, "pfilt_done should set the plan to NULL");
+            }
+
+            mu_assert( LTFAT_NAME(pfilt)(f, g, gl[gId], L, W, a[aId], c)
+                       == LTFATERR_SUCCESS, "pfilt");
+            for (ltfat_int n = 0; n < N * W; n++)
+                mu_assert( ltfat_abs(c[n] - cref[n]) < tol * nrm, "pfilt");
+        }
+    }
+    mu_assert( noverlapsave > 0, "pfilt should use overlap-save for some filters");
+    mu_assert( npartitioned > 0, "pfilt should split some filters into several partitions");
+
+    mu_assert( LTFAT_NAME(pfilt_init)(g, gl[1], L, W, 1, ltfat_pfilt_auto,
+                                      FFTW_ESTIMATE, &p) == LTFATERR_SUCCESS, "pfilt_init");
+    mu_assert( LTFAT_NAME(pfilt_execute)(p, f, f) == LTFATERR_BADARG, "pfilt_execute inplace");
+    LTFAT_NAME(pfilt_done)(&p);
+    mu_assert( LTFAT_NAME(pfilt_get_method)(NULL) == LTFATERR_NULLPOINTER,
+               "pfilt_get_method NULL");
+
+    p = (LTFAT_NAME(pfilt_plan)*) f;
+    mu_assert( LTFAT_NAME(pfilt_init)(g, gl[1], L, W, 7, ltfat_pfilt_auto,
+                                      FFTW_ESTIMATE, &p) == LTFATERR_BADTRALEN,
+               "pfilt_init L not divisible by a");
+    mu_assert( p == NULL, "pfilt_init should set the plan to NULL on failure");
+    mu_assert( LTFAT_NAME(pfilt_init)(g, L + 1, L, W, 1, ltfat_pfilt_auto,
+                                      FFTW_ESTIMATE, &p) == LTFATERR_BADTRALEN,
+               "pfilt_init gl > L");
+    mu_assert( LTFAT_NAME(pfilt_init)(g, gl[1], L, W, 1, (ltfat_pfilt_hint) 7,
+                                      FFTW_ESTIMATE, &p) == LTFATERR_CANNOTHAPPEN,
+               "pfilt_init bad hint");
+
+    ltfat_free(f); ltfat_free(g); ltfat_free(c); ltfat_free(cref);
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* sum_j x[j*stride]*exp(-2*pi*i*j*k/L) accumulated in double */
+LTFAT_COMPLEX TEST_NAME(quadtfdist_dft)(const LTFAT_COMPLEX* x, ltfat_int stride,
+                                        ltfat_int L, ltfat_int k)
+{
+    double re = 0.0, im = 0.0;
+    for (ltfat_int j = 0; j < L; j++)
+    {
+        double ph = -2.0 * M_PI * ltfat_positiverem(j * k, L) / L;
+        double xr = ltfat_real(x[j * stride]), xi = ltfat_imag(x[j * stride]);
+        re += xr * cos(ph) - xi * sin(ph);
+        im += xr * sin(ph) + xi * cos(ph);
+    }
+    return (LTFAT_REAL) re + I * (LTFAT_REAL) im;
+}
+
+/* Analytic signal as in comp_fftanalytic */
+void TEST_NAME(quadtfdist_analytic)(const LTFAT_REAL* f, ltfat_int L, LTFAT_COMPLEX* z)
+{
+    ltfat_int H = L / 2;
+    LTFAT_COMPLEX* F = LTFAT_NAME_COMPLEX(malloc)(L);
+    LTFAT_COMPLEX* x = LTFAT_NAME_COMPLEX(malloc)(L);
+
+    for (ltfat_int l = 0; l < L; l++)
+        x[l] = f[l];
+    for (ltfat_int k = 0; k < L; k++)
+        F[k] = TEST_NAME(quadtfdist_dft)(x, 1, L, k);
+    for (ltfat_int k = 1; k < L - H; k++)
+        F[k] *= (LTFAT_REAL) 2.0;
+    for (ltfat_int k = H + 1; k < L; k++)
+        F[k] = (LTFAT_REAL) 0.0;
+
+    // Inverse DFT via the forward one, z = conj(dft(conj(F)))/L
+    for (ltfat_int k = 0; k < L; k++)
+        x[k] = conj(F[k]);
+    for (ltfat_int l = 0; l < L; l++)
+        z[l] = conj(TEST_NAME(quadtfdist_dft)(x, 1, L, l)) / (LTFAT_REAL) L;
+
+    ltfat_free(F); ltfat_free(x);
+}
+
+/* The distributions from the formulas of wignervilledist, drihaczekdist
+ * and ambiguityfunction, out is L x L with the slice index being the slow
+ * one as in the tiles. */
+void TEST_NAME(quadtfdist_ref)(ltfat_quadtfdist_type type, const LTFAT_COMPLEX* z1,
+                               const LTFAT_COMPLEX* z2, ltfat_int L, LTFAT_COMPLEX* out)
+{
+    ltfat_int H = L / 2;
+    LTFAT_COMPLEX* R = LTFAT_NAME_COMPLEX(calloc)(L * L);
+    LTFAT_COMPLEX* x = LTFAT_NAME_COMPLEX(malloc)(L);
+
+    // comp_instcorrmat, R[m + l*L] is lag m at time l
+    for (ltfat_int l = 0; l < L; l++)
+    {
+        ltfat_int K = ltfat_imin(ltfat_imin(L - l, l), (L + 1) / 2 - 1);
+        for (ltfat_int m = -K; m <= K; m++)
+            R[ltfat_positiverem(m, L) + l * L] =
+                z1[ltfat_positiverem(l + m, L)] * conj(z2[ltfat_positiverem(l - m, L)]);
+    }
+
+    if (type == LTFAT_WIGNERVILLE)
+    {
+        for (ltfat_int l = 0; l < L; l++)
+            for (ltfat_int k = 0; k < L; k++)
+                out[k + l * L] = TEST_NAME(quadtfdist_dft)(R + l * L, 1, L, k);
+    }
+    else if (type == LTFAT_RIHACZEK)
+    {
+        for (ltfat_int m = 0; m < L; m++)
+            x[m] = conj(TEST_NAME(quadtfdist_dft)(z2, 1, L, m));
+        for (ltfat_int n = 0; n < L; n++)
+            for (ltfat_int m = 0; m < L; m++)
+                out[m + n * L] = z1[n] * x[m] *
+                                 exp(-I * (LTFAT_REAL) (2.0 * M_PI * ltfat_positiverem(m * n, L) / L));
+    }
+    else
+    {
+        // fftshift(fft2(fft(R))), fft(fft(.)) along the lags is L times a flip
+        for (ltfat_int i = 0; i < L; i++)
+        {
+            ltfat_int j = ltfat_positiverem(H - i, L);
+            for (ltfat_int k = 0; k < L; k++)
+                out[k + i * L] = (LTFAT_REAL) L *
+                                 TEST_NAME(quadtfdist_dft)(R + j, L, L, ltfat_positiverem(k - H, L));
+        }
+    }
+
+    ltfat_free(R); ltfat_free(x);
+}
+
+typedef struct
+{
+    LTFAT_COMPLEX* out;
+    ltfat_int calls;
+} TEST_NAME(quadtfdist_acc);
+
+void TEST_NAME(quadtfdist_collect)(void* userdata, const LTFAT_COMPLEX tile[],
+                                   ltfat_int L, ltfat_int start, ltfat_int len)
+{
+    TEST_NAME(quadtfdist_acc)* acc = (TEST_NAME(quadtfdist_acc)*) userdata;
+    memcpy(acc->out + start * L, tile, L * len * sizeof * tile);
+    acc->calls++;
+}
+
+double TEST_NAME(quadtfdist_relerr)(const LTFAT_COMPLEX* c, const LTFAT_COMPLEX* cref,
+                                    ltfat_int len)
+{
+    double err = 0.0, nrm = 0.0;
+    for (ltfat_int l = 0; l < len; l++)
+    {
+        err = fmax(err, ltfat_abs(c[l] - cref[l]));
+        nrm = fmax(nrm, ltfat_abs(cref[l]));
+    }
+    return err / nrm;
+}
+
+int TEST_NAME(test_quadtfdist)()
+{
+    ltfat_int L[] = { 32, 33};
+    ltfat_quadtfdist_type type[] = { LTFAT_WIGNERVILLE, LTFAT_RIHACZEK, LTFAT_AMBIGUITY};
+    ltfat_int tilelen = 5;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        // fillRand reseeds with the time, one call keeps f and g different
+        LTFAT_COMPLEX* f = LTFAT_NAME_COMPLEX(malloc)(2 * L[id]);
+        LTFAT_COMPLEX* g = f + L[id];
+        LTFAT_REAL* fr = LTFAT_NAME_REAL(malloc)(2 * L[id]);
+        LTFAT_REAL* gr = fr + L[id];
+        LTFAT_COMPLEX* za = LTFAT_NAME_COMPLEX(malloc)(L[id]);
+        LTFAT_COMPLEX* zb = LTFAT_NAME_COMPLEX(malloc)(L[id]);
+        LTFAT_COMPLEX* out = LTFAT_NAME_COMPLEX(malloc)(L[id] * L[id]);
+        LTFAT_COMPLEX* ref = LTFAT_NAME_COMPLEX(malloc)(L[id] * L[id]);
+        LTFAT_NAME(quadtfdist_plan)* p = NULL;
+        TEST_NAME(quadtfdist_acc) acc;
+        double err;
+
+        TEST_NAME_COMPLEX(fillRand)(f, 2 * L[id]);
+        TEST_NAME(fillRand)(fr, 2 * L[id]);
+        acc.out = out;
+
+        for (ltfat_int t = 0; t < (ltfat_int) ARRAYLEN(type); t++)
+        {
+            // Cross and auto distribution of complex signals
+            mu_assert( LTFAT_NAME(quadtfdist)(f, g, L[id], type[t], out)
+                       == LTFATERR_SUCCESS, "quadtfdist");
+            TEST_NAME(quadtfdist_ref)(type[t], f, g, L[id], ref);
+            err = TEST_NAME(quadtfdist_relerr)(out, ref, L[id] * L[id]);
+            mu_assert( err < tol, "quadtfdist cross, L=%d, type=%d, err=%g",
+                       (int) L[id], (int) type[t], err);
+
+            mu_assert( LTFAT_NAME(quadtfdist)(f, NULL, L[id], type[t], out)
+                       == LTFATERR_SUCCESS, "quadtfdist");
+            TEST_NAME(quadtfdist_ref)(type[t], f, f, L[id], ref);
+            err = TEST_NAME(quadtfdist_relerr)(out, ref, L[id] * L[id]);
+            mu_assert( err < tol, "quadtfdist auto, L=%d, type=%d, err=%g",
+                       (int) L[id], (int) type[t], err);
+
+            // Real signals through a tiled, threaded plan
+            mu_assert( LTFAT_NAME(quadtfdist_init)(L[id], type[t], tilelen,
+                                                   FFTW_ESTIMATE, &p)
+                       == LTFATERR_SUCCESS, "quadtfdist_init");
+            mu_assert( LTFAT_NAME(quadtfdist_set_nthreads)(p, 2) == LTFATERR_SUCCESS,
+                       "quadtfdist_set_nthreads");
+            mu_assert( LTFAT_NAME(quadtfdist_setcallback)(p, &TEST_NAME(quadtfdist_collect),
+                       &acc) == LTFATERR_SUCCESS, "quadtfdist_setcallback");
+            acc.calls = 0;
+            mu_assert( LTFAT_NAME(quadtfdist_execute_real)(p, fr, gr) == LTFATERR_SUCCESS,
+                       "quadtfdist_execute_real");
+            mu_assert( acc.calls == (L[id] + tilelen - 1) / tilelen,
+                       "quadtfdist callback called %d times", (int) acc.calls);
+
+            if (type[t] == LTFAT_RIHACZEK)
+            {
+                for (ltfat_int l = 0; l < L[id]; l++)
+                {
+                    za[l] = fr[l];
+                    zb[l] = gr[l];
+                }
+            }
+            else
+            {
+                TEST_NAME(quadtfdist_analytic)(fr, L[id], za);
+                TEST_NAME(quadtfdist_analytic)(gr, L[id], zb);
+            }
+            TEST_NAME(quadtfdist_ref)(type[t], za, zb, L[id], ref);
+            err = TEST_NAME(quadtfdist_relerr)(out, ref, L[id] * L[id]);
+            mu_assert( err < tol, "quadtfdist_execute_real, L=%d, type=%d, err=%g",
+                       (int) L[id], (int) type[t], err);
+
+            mu_assert( LTFAT_NAME(quadtfdist_done)(&p) == LTFATERR_SUCCESS,
+                       "quadtfdist_done");
+            mu_assert( p == NULL, "quadtfdist_done should set the plan to NULL");
+        }
+
+        ltfat_free(f); ltfat_free(fr);
+        ltfat_free(za); ltfat_free(zb); ltfat_free(out); ltfat_free(ref);
+    }
+
+    {
+        LTFAT_NAME(quadtfdist_plan)* p = (LTFAT_NAME(quadtfdist_plan)*) L;
+        mu_assert( LTFAT_NAME(quadtfdist_init)(32, (ltfat_quadtfdist_type) 7, 4,
+                                               FFTW_ESTIMATE, &p)
+                   == LTFATERR_BADARG, "quadtfdist_init bad type");
+        mu_assert( p == NULL, "quadtfdist_init should set the plan to NULL on failure");
+        mu_assert( LTFAT_NAME(quadtfdist_init)(32, LTFAT_RIHACZEK, 0, FFTW_ESTIMATE, &p)
+                   == LTFATERR_NOTPOSARG, "quadtfdist_init bad tilelen");
+    }
+
+    return 0;
+}
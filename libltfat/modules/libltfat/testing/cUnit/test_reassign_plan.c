@@ -0,0 +1,193 @@
+/* Uniformly distributed values in [-scale/2, scale/2] */
+void TEST_NAME(reassign_fillgrad)(LTFAT_REAL* grad, ltfat_int L, double scale)
+{
+    for (ltfat_int l = 0; l < L; l++)
+        grad[l] = (LTFAT_REAL) ((((double) rand()) / RAND_MAX - 0.5) * scale);
+}
+
+int TEST_NAME(test_gabreassign_plan)()
+{
+    ltfat_int L[] = { 120, 480, 96};
+    ltfat_int a[] = {  10,  24,  4};
+    ltfat_int M[] = {  20,  96, 48};
+    ltfat_int W[] = {   1,   2,  3};
+    ltfat_int nthreads[] = { 1, 3 };
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int N = L[id] / a[id], b = L[id] / M[id];
+        ltfat_int MNW = M[id] * N * W[id];
+        LTFAT_TYPE* s = LTFAT_NAME(malloc)(MNW);
+        LTFAT_TYPE* sr = LTFAT_NAME(malloc)(MNW);
+        LTFAT_TYPE* srref = LTFAT_NAME(calloc)(MNW);
+        LTFAT_REAL* tgrad = LTFAT_NAME_REAL(malloc)(MNW);
+        LTFAT_REAL* fgrad = LTFAT_NAME_REAL(malloc)(MNW);
+
+        TEST_NAME(fillRand)(s, MNW);
+        // Move the coefficients by up to +-3 bins in both directions
+        TEST_NAME(reassign_fillgrad)(tgrad, MNW, 6.0 * b);
+        TEST_NAME(reassign_fillgrad)(fgrad, MNW, 6.0 * a[id]);
+
+        // Reference: round to the nearest grid point and wrap around
+        for (ltfat_int w = 0; w < W[id]; w++)
+            for (ltfat_int n = 0; n < N; n++)
+                for (ltfat_int m = 0; m < M[id]; m++)
+                {
+                    ltfat_int idx = m + n * M[id] + w * M[id] * N;
+                    ltfat_int fpos = m <= M[id] / 2 ? m : m - M[id];
+                    ltfat_int tpos = n <= N / 2 ? n : n - N;
+                    ltfat_int posi = ltfat_positiverem(
+                                         ltfat_round(tgrad[idx] / b + fpos), M[id]);
+                    ltfat_int posj = ltfat_positiverem(
+                                         ltfat_round(fgrad[idx] / a[id] + tpos), N);
+                    srref[posi + posj * M[id] + w * M[id] * N] += s[idx];
+                }
+
+        for (ltfat_int tId = 0; tId < (ltfat_int) ARRAYLEN(nthreads); tId++)
+        {
+            LTFAT_NAME(gabreassign_plan)* p = NULL;
+            double err = 0.0;
+
+            mu_assert( LTFAT_NAME(gabreassign_init)(L[id], W[id], a[id], M[id],
+                       nthreads[tId], &p) == LTFATERR_SUCCESS, "gabreassign_init");
+
+            TEST_NAME(fillRand)(sr, MNW);
+            mu_assert( LTFAT_NAME(gabreassign_execute)(p, s, tgrad, fgrad, sr)
+                       == LTFATERR_SUCCESS, "gabreassign_execute");
+
+            for (ltfat_int l = 0; l < MNW; l++)
+                err = fmax(err, ltfat_abs(sr[l] - srref[l]));
+            mu_assert( err < tol, "gabreassign plan, L=%d, nthreads=%d, err=%g",
+                       (int) L[id], (int) nthreads[tId], err);
+
+            LTFAT_NAME(gabreassign_done)(&p);
+            mu_assert( p == NULL, "gabreassign_done sets NULL");
+        }
+
+        // The old interface runs the same plan
+        LTFAT_NAME(gabreassign)(s, tgrad, fgrad, L[id], W[id], a[id], M[id], sr);
+        {
+            double err = 0.0;
+            for (ltfat_int l = 0; l < MNW; l++)
+                err = fmax(err, ltfat_abs(sr[l] - srref[l]));
+            mu_assert( err < tol, "gabreassign, L=%d, err=%g", (int) L[id], err);
+        }
+
+        ltfat_free(s); ltfat_free(sr); ltfat_free(srref);
+        ltfat_free(tgrad); ltfat_free(fgrad);
+    }
+
+    {
+        LTFAT_NAME(gabreassign_plan)* p = NULL;
+        mu_assert( LTFAT_NAME(gabreassign_init)(L[0] + 1, W[0], a[0], M[0], 1, &p)
+                   == LTFATERR_BADTRALEN, "L not divisible by a and M");
+        mu_assert( LTFAT_NAME(gabreassign_init)(L[0], W[0], a[0], M[0], 0, &p)
+                   == LTFATERR_NOTPOSARG, "nthreads is not positive");
+        mu_assert( LTFAT_NAME(gabreassign_init)(L[0], W[0], a[0], M[0], 1, NULL)
+                   == LTFATERR_NULLPOINTER, "gabreassign_init: NULL");
+        mu_assert( LTFAT_NAME(gabreassign_done)(NULL) == LTFATERR_NULLPOINTER,
+                   "gabreassign_done: NULL");
+    }
+
+    return 0;
+}
+
+int TEST_NAME(test_filterbankreassign_plan)()
+{
+    ltfat_int M = 12;
+    ltfat_int N[12];
+    double a[12], cfreq[12];
+    ltfat_int nthreads[] = { 1, 4 };
+    ltfat_int Ntot = 0;
+    LTFAT_TYPE* s[12], *sr[12], *sr1[12];
+    LTFAT_REAL* tgrad[12], *fgrad[12], *zeros[12];
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        // Non-uniform filterbank covering the whole circle
+        a[m] = m < M / 2 ? 4.0 : 8.0;
+        N[m] = 480 / (ltfat_int) a[m];
+        cfreq[m] = -1.0 + 2.0 * m / M;
+        Ntot += N[m];
+
+        s[m] = LTFAT_NAME(malloc)(N[m]);
+        sr[m] = LTFAT_NAME(malloc)(N[m]);
+        sr1[m] = LTFAT_NAME(malloc)(N[m]);
+        tgrad[m] = LTFAT_NAME_REAL(malloc)(N[m]);
+        fgrad[m] = LTFAT_NAME_REAL(malloc)(N[m]);
+        zeros[m] = LTFAT_NAME_REAL(calloc)(N[m]);
+        TEST_NAME(fillRand)(s[m], N[m]);
+        TEST_NAME(reassign_fillgrad)(tgrad[m], N[m], 0.5);
+        TEST_NAME(reassign_fillgrad)(fgrad[m], N[m], 6.0 * a[m]);
+    }
+
+    for (ltfat_int tId = 0; tId < (ltfat_int) ARRAYLEN(nthreads); tId++)
+    {
+        LTFAT_NAME(filterbankreassign_plan)* p = NULL;
+        fbreassOptOut* repos = fbreassOptOut_init(Ntot, 4);
+        ltfat_int reposcount = 0;
+        int same = 1, inplace = 1;
+        LTFAT_TYPE ssum = 0.0, srsum = 0.0;
+
+        mu_assert( LTFAT_NAME(filterbankreassign_init)(N, a, cfreq, M, REASS_DEFAULT,
+                   nthreads[tId], &p) == LTFATERR_SUCCESS, "filterbankreassign_init");
+
+        // Zero gradients leave every coefficient where it is
+        LTFAT_NAME(filterbankreassign_execute)(p, (const LTFAT_TYPE**) s,
+                (const LTFAT_REAL**) zeros, (const LTFAT_REAL**) zeros, sr, NULL);
+        for (ltfat_int m = 0; m < M; m++)
+            for (ltfat_int n = 0; n < N[m]; n++)
+                if (sr[m][n] != s[m][n]) inplace = 0;
+        mu_assert( inplace, "zero gradients, nthreads=%d", (int) nthreads[tId]);
+
+        mu_assert( LTFAT_NAME(filterbankreassign_execute)(p, (const LTFAT_TYPE**) s,
+                   (const LTFAT_REAL**) tgrad, (const LTFAT_REAL**) fgrad, sr, repos)
+                   == LTFATERR_SUCCESS, "filterbankreassign_execute");
+
+        // The coefficients are only moved, every one exactly once
+        for (ltfat_int m = 0; m < M; m++)
+            for (ltfat_int n = 0; n < N[m]; n++)
+            {
+                ssum += s[m][n]; srsum += sr[m][n];
+            }
+        for (ltfat_int l = 0; l < Ntot; l++)
+            reposcount += repos->reposl[l];
+        mu_assert( ltfat_abs(ssum - srsum) < 1e-3 * ltfat_abs(ssum), "energy is moved, not lost");
+        mu_assert( reposcount == Ntot, "repos lists every coefficient once");
+
+        // The result does not depend on the number of threads
+        if (tId == 0)
+        {
+            for (ltfat_int m = 0; m < M; m++)
+                memcpy(sr1[m], sr[m], N[m] * sizeof * sr[m]);
+        }
+        else
+        {
+            for (ltfat_int m = 0; m < M; m++)
+                for (ltfat_int n = 0; n < N[m]; n++)
+                    if (sr[m][n] != sr1[m][n]) same = 0;
+            mu_assert( same, "nthreads=%d equals nthreads=1", (int) nthreads[tId]);
+        }
+
+        fbreassOptOut_destroy(repos);
+        LTFAT_NAME(filterbankreassign_done)(&p);
+        mu_assert( p == NULL, "filterbankreassign_done sets NULL");
+    }
+
+    {
+        LTFAT_NAME(filterbankreassign_plan)* p = NULL;
+        mu_assert( LTFAT_NAME(filterbankreassign_init)(N, a, NULL, M, REASS_DEFAULT, 1, &p)
+                   == LTFATERR_NULLPOINTER, "cfreq is NULL");
+        mu_assert( LTFAT_NAME(filterbankreassign_init)(N, a, cfreq, M, REASS_DEFAULT, 0, &p)
+                   == LTFATERR_NOTPOSARG, "nthreads is not positive");
+    }
+
+    for (ltfat_int m = 0; m < M; m++)
+    {
+        ltfat_free(s[m]); ltfat_free(sr[m]); ltfat_free(sr1[m]);
+        ltfat_free(tgrad[m]); ltfat_free(fgrad[m]); ltfat_free(zeros[m]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+/* spreadop.m: h(l) = sum_{m,n} coef(m,n) exp(2*pi*i*m*l/L) f(l-n) */
+void TEST_NAME(spreadop_ref)(const LTFAT_COMPLEX* coef, ltfat_int L,
+                             const LTFAT_COMPLEX* f, ltfat_int W, LTFAT_COMPLEX* h)
+{
+    for (ltfat_int w = 0; w < W; w++)
+    {
+        for (ltfat_int l = 0; l < L; l++)
+        {
+            double re = 0.0, im = 0.0;
+            for (ltfat_int n = 0; n < L; n++)
+            {
+                for (ltfat_int m = 0; m < L; m++)
+                {
+                    LTFAT_COMPLEX x = coef[m + n * L] * f[ltfat_positiverem(l - n, L) + w * L];
+                    double ph = 2.0 * M_PI * ltfat_positiverem(m * l, L) / L;
+                    re += ltfat_real(x) * cos(ph) - ltfat_imag(x) * sin(ph);
+                    im += ltfat_real(x) * sin(ph) + ltfat_imag(x) * cos(ph);
+                }
+            }
+            h[l + w * L] = (LTFAT_REAL) re + I * (LTFAT_REAL) im;
+        }
+    }
+}
+
+double TEST_NAME(spreadop_err)(const LTFAT_COMPLEX* h, const LTFAT_COMPLEX* href,
+                               ltfat_int len)
+{
+    double err = 0.0;
+    for (ltfat_int l = 0; l < len; l++)
+        err = fmax(err, ltfat_abs(h[l] - href[l]));
+    return err;
+}
+
+int TEST_NAME(test_spreadop)()
+{
+    ltfat_int L = 12, W = 2;
+    // Fewer than L nonzeros give the sparse representation
+    ltfat_int row[] = { 0, 3, 11, 5};
+    ltfat_int col[] = { 0, 1, 4, 11};
+    ltfat_int nnz = ARRAYLEN(row);
+    ltfat_int rowadj[ARRAYLEN(row)], coladj[ARRAYLEN(row)];
+    LTFAT_COMPLEX val[ARRAYLEN(row)], valadj[ARRAYLEN(row)];
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    // fillRand reseeds with the time, one call keeps f and g different
+    LTFAT_COMPLEX* f = LTFAT_NAME_COMPLEX(malloc)(2 * L * W);
+    LTFAT_COMPLEX* g = f + L * W;
+    LTFAT_COMPLEX* h = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* href = LTFAT_NAME_COMPLEX(malloc)(L * W);
+    LTFAT_COMPLEX* coef[2];
+    LTFAT_COMPLEX* cadj = LTFAT_NAME_COMPLEX(malloc)(L * L);
+    LTFAT_NAME(spreadop_plan)* p = NULL;
+
+    TEST_NAME_COMPLEX(fillRand)(f, 2 * L * W);
+    TEST_NAME_COMPLEX(fillRand)(val, nnz);
+    // Dominant identity part keeps the sparse operator invertible
+    val[0] = (LTFAT_REAL) 4.0;
+
+    coef[0] = LTFAT_NAME_COMPLEX(malloc)(L * L);
+    coef[1] = LTFAT_NAME_COMPLEX(calloc)(L * L);
+    TEST_NAME_COMPLEX(fillRand)(coef[0], L * L);
+    for (ltfat_int k = 0; k < nnz; k++)
+        coef[1][row[k] + col[k] * L] = val[k];
+
+    mu_assert( LTFAT_NAME(spreadop_init)(L, FFTW_ESTIMATE, &p) == LTFATERR_SUCCESS,
+               "spreadop_init");
+
+    // Dense and sparse representation
+    for (ltfat_int id = 0; id < 2; id++)
+    {
+        double err, ip1re = 0.0, ip1im = 0.0, ip2re = 0.0, ip2im = 0.0;
+
+        TEST_NAME(spreadop_ref)(coef[id], L, f, W, href);
+
+        mu_assert( LTFAT_NAME(spreadop_set_coef)(p, coef[id]) == LTFATERR_SUCCESS,
+                   "spreadop_set_coef");
+        mu_assert( LTFAT_NAME(spreadop_execute)(p, f, W, h) == LTFATERR_SUCCESS,
+                   "spreadop_execute");
+        err = TEST_NAME(spreadop_err)(h, href, L * W);
+        mu_assert( err < tol, "spreadop_execute %d, err=%g", (int) id, err);
+
+        // The inverse undoes the operator
+        mu_assert( LTFAT_NAME(spreadop_prepare_inv)(p) == LTFATERR_SUCCESS,
+                   "spreadop_prepare_inv");
+        mu_assert( LTFAT_NAME(spreadop_execute_inv)(p, href, W, h) == LTFATERR_SUCCESS,
+                   "spreadop_execute_inv");
+        err = TEST_NAME(spreadop_err)(h, f, L * W);
+        mu_assert( err < 100 * tol, "spreadop_execute_inv %d, err=%g", (int) id, err);
+        mu_assert( LTFAT_NAME(spreadop_execute_inv)(p, href, W, href) == LTFATERR_SUCCESS,
+                   "spreadop_execute_inv inplace");
+        err = TEST_NAME(spreadop_err)(href, f, L * W);
+        mu_assert( err < 100 * tol, "spreadop_execute_inv inplace %d, err=%g", (int) id, err);
+
+        // <T f, g> = <f, T* g>
+        mu_assert( LTFAT_NAME(spreadop_execute)(p, f, W, h) == LTFATERR_SUCCESS,
+                   "spreadop_execute");
+        mu_assert( LTFAT_NAME(spreadop_execute_adj)(p, g, W, href) == LTFATERR_SUCCESS,
+                   "spreadop_execute_adj");
+        for (ltfat_int l = 0; l < L * W; l++)
+        {
+            LTFAT_COMPLEX ip1 = h[l] * conj(g[l]), ip2 = f[l] * conj(href[l]);
+            ip1re += ltfat_real(ip1); ip1im += ltfat_imag(ip1);
+            ip2re += ltfat_real(ip2); ip2im += ltfat_imag(ip2);
+        }
+        mu_assert( fabs(ip1re - ip2re) + fabs(ip1im - ip2im) < 100 * tol,
+                   "spreadop_execute_adj %d", (int) id);
+
+        // The coefficients of the adjoint give the same operator
+        mu_assert( LTFAT_NAME(spreadadj)(coef[id], L, cadj) == LTFATERR_SUCCESS,
+                   "spreadadj");
+        TEST_NAME(spreadop_ref)(cadj, L, g, W, h);
+        err = TEST_NAME(spreadop_err)(h, href, L * W);
+        mu_assert( err < tol, "spreadadj %d, err=%g", (int) id, err);
+    }
+
+    // The same sparse operator from the triplets
+    mu_assert( LTFAT_NAME(spreadop_set_coef_sparse)(p, row, col, val, nnz)
+               == LTFATERR_SUCCESS, "spreadop_set_coef_sparse");
+    mu_assert( LTFAT_NAME(spreadop_execute_inv)(p, f, W, h) == LTFATERR_BADARG,
+               "spreadop_execute_inv without prepare_inv");
+    mu_assert( LTFAT_NAME(spreadop_execute)(p, f, W, h) == LTFATERR_SUCCESS,
+               "spreadop_execute");
+    TEST_NAME(spreadop_ref)(coef[1], L, f, W, href);
+    mu_assert( TEST_NAME(spreadop_err)(h, href, L * W) < tol, "spreadop_set_coef_sparse");
+
+    mu_assert( LTFAT_NAME(spreadadj_sparse)(row, col, val, nnz, L, rowadj, coladj, valadj)
+               == LTFATERR_SUCCESS, "spreadadj_sparse");
+    mu_assert( LTFAT_NAME(spreadop_set_coef_sparse)(p, rowadj, coladj, valadj, nnz)
+               == LTFATERR_SUCCESS, "spreadop_set_coef_sparse");
+    mu_assert( LTFAT_NAME(spreadop_execute)(p, g, W, h) == LTFATERR_SUCCESS,
+               "spreadop_execute");
+    mu_assert( LTFAT_NAME(spreadop_set_coef_sparse)(p, row, col, val, nnz)
+               == LTFATERR_SUCCESS, "spreadop_set_coef_sparse");
+    mu_assert( LTFAT_NAME(spreadop_execute_adj)(p, g, W, href) == LTFATERR_SUCCESS,
+               "spreadop_execute_adj");
+    mu_assert( TEST_NAME(spreadop_err)(h, href, L * W) < tol, "spreadadj_sparse");
+
+    row[1] = L;
+    mu_assert( LTFAT_NAME(spreadop_set_coef_sparse)(p, row, col, val, nnz)
+               == LTFATERR_NOTINRANGE, "spreadop_set_coef_sparse out of range");
+    mu_assert( LTFAT_NAME(spreadop_execute)(p, f, W, f) == LTFATERR_BADARG,
+               "spreadop_execute inplace");
+    LTFAT_NAME(spreadop_done)(&p);
+
+    p = (LTFAT_NAME(spreadop_plan)*) f;
+    mu_assert( LTFAT_NAME(spreadop_init)(0, FFTW_ESTIMATE, &p) == LTFATERR_BADSIZE,
+               "spreadop_init L=0");
+    mu_assert( p == NULL, "spreadop_init should set the plan to NULL on failure");
+
+    ltfat_free(f); ltfat_free(h); ltfat_free(href);
+    ltfat_free(coef[0]); ltfat_free(coef[1]); ltfat_free(cadj);
+    return 0;
+}
@@ -12,3 +12,12 @@
 #include "test_gabdual_painless.c"
 #include "test_gabdual_long.c"
 
+#include "test_dctdst.c"
+#include "test_reassign_plan.c"
+#include "test_gga.c"
+#include "test_chzt.c"
+#include "test_wfac.c"
+#include "test_gabtight_long.c"
+#include "test_gabdual_batch.c"
+#include "test_wfbt.c"
+#include "test_pfilt.c"
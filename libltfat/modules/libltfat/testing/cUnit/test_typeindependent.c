@@ -9,3 +9,20 @@
 #include "test_idgtreal_fb.c"
 #include "test_dgtreal_long.c"
 #include "test_idgtreal_long.c"
+#include "test_dgtrealmp_atoms.c"
+#include "test_dgtrealmp_kernbank.c"
+#include "test_dgtrealmp_errresync.c"
+#include "test_dgtreal_strided.c"
+#include "test_dgtreal_olastream.c"
+#include "test_dwilt_plan.c"
+#include "test_fft_primes.c"
+#include "test_dgtreal_shear.c"
+#include "test_fwt_processor.c"
+#include "test_nsdgtreal.c"
+#include "test_quadtfdist.c"
+#include "test_dgtreal_lasso.c"
+#include "test_gabmulreal.c"
+#include "test_spreadop.c"
+#include "test_filterbankphasereassign.c"
+#include "test_ifilterbank.c"
+#include "test_nativelinalg.c"
@@ -0,0 +1,120 @@
+#include "ltfat/thirdparty/fftw3.h"
+
+int TEST_NAME(test_wfac)()
+{
+    ltfat_int L[] = { 24, 120, 90, 144};
+    ltfat_int a[] = {  4,  10,  6,  12};
+    ltfat_int M[] = {  8,  20, 18,  24};
+    ltfat_int R[] = {  1,   2,  3,   1};
+    ltfat_int nthreads[] = { 1, 3 };
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    for (ltfat_int id = 0; id < (ltfat_int) ARRAYLEN(L); id++)
+    {
+        ltfat_int LR = L[id] * R[id];
+        LTFAT_TYPE* g = LTFAT_NAME(malloc)(LR);
+        LTFAT_TYPE* gr = LTFAT_NAME(malloc)(LR);
+        LTFAT_COMPLEX* gf = LTFAT_NAME_COMPLEX(malloc)(LR);
+        LTFAT_COMPLEX* gf1 = LTFAT_NAME_COMPLEX(malloc)(LR);
+
+        TEST_NAME(fillRand)(g, LR);
+
+        for (ltfat_int tId = 0; tId < (ltfat_int) ARRAYLEN(nthreads); tId++)
+        {
+            LTFAT_NAME(wfac_plan)* pw = NULL;
+            LTFAT_NAME(iwfac_plan)* piw = NULL;
+            double err = 0.0;
+            int same = 1;
+
+            mu_assert( LTFAT_NAME(wfac_init)(L[id], a[id], M[id], FFTW_ESTIMATE, &pw)
+                       == LTFATERR_SUCCESS, "wfac_init");
+            mu_assert( LTFAT_NAME(iwfac_init)(L[id], a[id], M[id], FFTW_ESTIMATE, &piw)
+                       == LTFATERR_SUCCESS, "iwfac_init");
+            mu_assert( LTFAT_NAME(wfac_set_nthreads)(pw, nthreads[tId])
+                       == LTFATERR_SUCCESS, "wfac_set_nthreads");
+            mu_assert( LTFAT_NAME(iwfac_set_nthreads)(piw, nthreads[tId])
+                       == LTFATERR_SUCCESS, "iwfac_set_nthreads");
+
+            mu_assert( LTFAT_NAME(wfac_execute)(pw, g, R[id], gf) == LTFATERR_SUCCESS,
+                       "wfac_execute");
+
+            // The blocks are independent, the threads do not change the result
+            if (tId == 0)
+                memcpy(gf1, gf, LR * sizeof * gf);
+            else
+                for (ltfat_int l = 0; l < LR; l++)
+                    if (gf[l] != gf1[l]) same = 0;
+            mu_assert( same, "wfac, L=%d, nthreads=%d equals nthreads=1",
+                       (int) L[id], (int) nthreads[tId]);
+
+            mu_assert( LTFAT_NAME(iwfac_execute)(piw, gf, R[id], gr) == LTFATERR_SUCCESS,
+                       "iwfac_execute");
+            for (ltfat_int l = 0; l < LR; l++)
+                err = fmax(err, ltfat_abs(gr[l] - g[l]));
+            mu_assert( err < tol, "wfac/iwfac round trip, L=%d, nthreads=%d, err=%g",
+                       (int) L[id], (int) nthreads[tId], err);
+
+            LTFAT_NAME(wfac_done)(&pw);
+            LTFAT_NAME(iwfac_done)(&piw);
+            mu_assert( pw == NULL && piw == NULL, "done sets NULL");
+        }
+
+        // One-shot functions
+        {
+            double err = 0.0;
+            mu_assert( LTFAT_NAME(wfac)(g, L[id], R[id], a[id], M[id], gf)
+                       == LTFATERR_SUCCESS, "wfac");
+            for (ltfat_int l = 0; l < LR; l++)
+                err = fmax(err, ltfat_abs(gf[l] - gf1[l]));
+            mu_assert( err < tol, "wfac one-shot, L=%d, err=%g", (int) L[id], err);
+
+            mu_assert( LTFAT_NAME(iwfac)(gf, L[id], R[id], a[id], M[id], gr)
+                       == LTFATERR_SUCCESS, "iwfac");
+            err = 0.0;
+            for (ltfat_int l = 0; l < LR; l++)
+                err = fmax(err, ltfat_abs(gr[l] - g[l]));
+            mu_assert( err < tol, "iwfac one-shot, L=%d, err=%g", (int) L[id], err);
+        }
+
+        // The canonical dual from the threaded block solves reconstructs
+        {
+            ltfat_int N = L[id] / a[id];
+            LTFAT_TYPE* f = LTFAT_NAME(malloc)(L[id]);
+            LTFAT_COMPLEX* fr = LTFAT_NAME_COMPLEX(malloc)(L[id]);
+            LTFAT_COMPLEX* c = LTFAT_NAME_COMPLEX(malloc)(M[id] * N);
+            double err = 0.0;
+
+            TEST_NAME(fillRand)(f, L[id]);
+            mu_assert( LTFAT_NAME(gabdual_long)(g, L[id], a[id], M[id], gr)
+                       == LTFATERR_SUCCESS, "gabdual_long");
+            LTFAT_NAME(dgt_long)(f, g, L[id], 1, a[id], M[id], LTFAT_FREQINV, c);
+            LTFAT_NAME(idgt_long)(c, gr, L[id], 1, a[id], M[id], LTFAT_FREQINV, fr);
+
+            for (ltfat_int l = 0; l < L[id]; l++)
+                err = fmax(err, ltfat_abs(fr[l] - f[l]));
+            mu_assert( err < 1e2 * tol, "gabdual_long reconstruction, L=%d, err=%g",
+                       (int) L[id], err);
+
+            ltfat_free(f); ltfat_free(fr); ltfat_free(c);
+        }
+
+        ltfat_free(g); ltfat_free(gr); ltfat_free(gf); ltfat_free(gf1);
+    }
+
+    {
+        LTFAT_NAME(wfac_plan)* pw = NULL;
+        mu_assert( LTFAT_NAME(wfac_init)(L[0] + 1, a[0], M[0], FFTW_ESTIMATE, &pw)
+                   == LTFATERR_BADARG, "L not divisible by lcm(a,M)");
+        mu_assert( LTFAT_NAME(wfac_init)(L[0], a[0], M[0], FFTW_ESTIMATE, &pw)
+                   == LTFATERR_SUCCESS, "wfac_init");
+        mu_assert( LTFAT_NAME(wfac_set_nthreads)(pw, 0) == LTFATERR_NOTPOSARG,
+                   "nthreads is not positive");
+        mu_assert( LTFAT_NAME(wfac_set_nthreads)(NULL, 1) == LTFATERR_NULLPOINTER,
+                   "wfac_set_nthreads: NULL");
+        mu_assert( LTFAT_NAME(iwfac_set_nthreads)(NULL, 1) == LTFATERR_NULLPOINTER,
+                   "iwfac_set_nthreads: NULL");
+        LTFAT_NAME(wfac_done)(&pw);
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+int TEST_NAME(test_wfbt)()
+{
+    ltfatExtType ext[] = { PER, ZPD, SYM, PERDEC};
+    ltfat_int L = 101, W = 2, J = 3;
+    double tol = sizeof(LTFAT_REAL) == sizeof(double) ? 1e-10 : 1e-4;
+
+    // Filters h, g of a 3 level DWT
+    ltfat_int dM[] = { 2, 2, 2};
+    ltfat_int dgl[] = { 8, 8, 8, 8, 8, 8};
+    ltfat_int da[] = { 2, 2, 2, 2, 2, 2};
+    ltfat_int doff[] = { 0, -3, 0, -3, 0, -3};
+    ltfat_int dchild[] = { 1, -1, 2, -1, -1, -1};
+    ltfat_int doutidx[] = { -1, 3, -1, 2, 0, 1};
+
+    // Wavelet packet, the output of the first filter of the root is both
+    // an output and the input of node 1
+    ltfat_int wM[] = { 3, 3};
+    ltfat_int wgl[] = { 6, 5, 4, 6, 5, 4};
+    ltfat_int wa[] = { 3, 3, 3, 3, 3, 3};
+    ltfat_int woff[] = { -5, -2, 0, -5, -2, 0};
+    ltfat_int wchild[] = { 1, -1, -1, -1, -1, -1};
+    ltfat_int woutidx[] = { 0, 1, 2, 3, 4, 5};
+
+    LTFAT_TYPE* f = LTFAT_NAME(malloc)(L * W);
+    LTFAT_TYPE* gbuf = LTFAT_NAME(malloc)(6 * 8);
+    const LTFAT_TYPE* g[6];
+    LTFAT_TYPE* c[6];
+    LTFAT_TYPE* cref[6];
+    LTFAT_TYPE* x = LTFAT_NAME(malloc)(L * W);
+    LTFAT_NAME(wfbt_plan)* p = NULL;
+
+    TEST_NAME(fillRand)(f, L * W);
+    TEST_NAME(fillRand)(gbuf, 6 * 8);
+    for (ltfat_int m = 0; m < 6; m++)
+    {
+        g[m] = gbuf + 8 * (m % 2);
+        c[m] = LTFAT_NAME(malloc)(L * W);
+        cref[m] = LTFAT_NAME(malloc)(L * W);
+    }
+
+    for (ltfat_int eid = 0; eid < (ltfat_int) ARRAYLEN(ext); eid++)
+    {
+        ltfat_int Lc[6], Lin = L;
+        ltfat_int nout;
+        double err = 0.0;
+
+        // DWT, each level is a two channel filterbank_td
+        mu_assert( LTFAT_NAME(wfbt_init)(J, dM, g, dgl, da, doff, dchild, doutidx,
+                                         L, W, ext[eid], &p) == LTFATERR_SUCCESS,
+                   "wfbt_init DWT");
+        nout = LTFAT_NAME(wfbt_get_nout)(p);
+        mu_assert( nout == J + 1, "wfbt_get_nout DWT, nout=%d", (int) nout);
+        mu_assert( LTFAT_NAME(wfbt_get_outlens)(p, Lc) == LTFATERR_SUCCESS,
+                   "wfbt_get_outlens");
+        mu_assert( LTFAT_NAME(wfbt_execute)(p, f, c) == LTFATERR_SUCCESS,
+                   "wfbt_execute DWT");
+
+        memcpy(x, f, L * W * sizeof * x);
+        for (ltfat_int j = 0; j < J; j++)
+        {
+            LTFAT_TYPE* cj[2];
+            ltfat_int Lout = filterbank_td_size(Lin, da[0], dgl[0], doff[0], ext[eid]);
+            cj[0] = cref[0]; cj[1] = cref[J - j];
+            LTFAT_NAME(filterbank_td)(x, g, Lin, dgl, W, da, doff, 2, cj, ext[eid]);
+            if (j < J - 1)
+                memcpy(x, cref[0], Lout * W * sizeof * x);
+            Lin = Lout;
+        }
+
+        for (ltfat_int k = 0; k < nout; k++)
+            for (ltfat_int l = 0; l < Lc[k] * W; l++)
+                err = fmax(err, ltfat_abs(c[k][l] - cref[k][l]));
+        mu_assert( err < tol, "wfbt DWT, ext=%d, err=%g", (int) ext[eid], err);
+
+        // Executing again gives the same result
+        mu_assert( LTFAT_NAME(wfbt_set_nthreads)(p, 2) == LTFATERR_SUCCESS,
+                   "wfbt_set_nthreads");
+        mu_assert( LTFAT_NAME(wfbt_execute)(p, f, c) == LTFATERR_SUCCESS,
+                   "wfbt_execute DWT again");
+        err = 0.0;
+        for (ltfat_int k = 0; k < nout; k++)
+            for (ltfat_int l = 0; l < Lc[k] * W; l++)
+                err = fmax(err, ltfat_abs(c[k][l] - cref[k][l]));
+        mu_assert( err < tol, "wfbt DWT again, ext=%d, err=%g", (int) ext[eid], err);
+        LTFAT_NAME(wfbt_done)(&p);
+        mu_assert( p == NULL, "wfbt_done should set the plan to NULL");
+
+        // Wavelet packet
+        for (ltfat_int m = 0; m < 6; m++)
+            g[m] = gbuf + 8 * m;
+        mu_assert( LTFAT_NAME(wfbt_init)(2, wM, g, wgl, wa, woff, wchild, woutidx,
+                                         L, W, ext[eid], &p) == LTFATERR_SUCCESS,
+                   "wfbt_init packet");
+        mu_assert( LTFAT_NAME(wfbt_get_outlens)(p, Lc) == LTFATERR_SUCCESS,
+                   "wfbt_get_outlens");
+        mu_assert( LTFAT_NAME(wfbt_execute)(p, f, c) == LTFATERR_SUCCESS,
+                   "wfbt_execute packet");
+
+        LTFAT_NAME(filterbank_td)(f, g, L, wgl, W, wa, woff, 3, cref, ext[eid]);
+        LTFAT_NAME(filterbank_td)(cref[0], g + 3, Lc[0], wgl + 3, W, wa + 3, woff + 3,
+                                  3, cref + 3, ext[eid]);
+
+        err = 0.0;
+        for (ltfat_int k = 0; k < 6; k++)
+            for (ltfat_int l = 0; l < Lc[k] * W; l++)
+                err = fmax(err, ltfat_abs(c[k][l] - cref[k][l]));
+        mu_assert( err < tol, "wfbt packet, ext=%d, err=%g", (int) ext[eid], err);
+        LTFAT_NAME(wfbt_done)(&p);
+
+        for (ltfat_int m = 0; m < 6; m++)
+            g[m] = gbuf + 8 * (m % 2);
+    }
+
+    // A child must have a higher index than its parent
+    dchild[0] = 0;
+    mu_assert( LTFAT_NAME(wfbt_init)(J, dM, g, dgl, da, doff, dchild, doutidx,
+                                     L, W, PER, &p) == LTFATERR_BADARG,
+               "wfbt_init bad tree");
+    mu_assert( p == NULL, "wfbt_init should set the plan to NULL on failure");
+    dchild[0] = 1;
+
+    doff[0] = 1;
+    mu_assert( LTFAT_NAME(wfbt_init)(J, dM, g, dgl, da, doff, dchild, doutidx,
+                                     L, W, PER, &p) == LTFATERR_BADARG,
+               "wfbt_init bad offset");
+    doff[0] = 0;
+
+    mu_assert( LTFAT_NAME(wfbt_init)(J, dM, NULL, dgl, da, doff, dchild, doutidx,
+                                     L, W, PER, &p) == LTFATERR_NULLPOINTER,
+               "wfbt_init: Filters are null");
+
+    for (ltfat_int m = 0; m < 6; m++)
+    {
+        ltfat_free(c[m]); ltfat_free(cref[m]);
+    }
+    ltfat_free(f); ltfat_free(gbuf); ltfat_free(x);
+    return 0;
+}
@@ -15,10 +15,23 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 #include "_kiss_fft_guts.h"
 
+/* Lengths with a prime factor p larger than this are always computed using
+ * Bluestein's algorithm instead of the O(p^2) generic butterfly */
+#ifndef KISS_FFT_GENERIC_MAXP
+#define KISS_FFT_GENERIC_MAXP 128
+#endif
+
 struct LTFAT_KISS(fft_plan){
     int nfft;
     int inverse;
     int factors[2*MAXFACTORS];
+    /* Bluestein: forward plan of the fast length >= 2*nfft-1, the chirp,
+     * the FFT of the convolution kernel and a work buffer. NULL for the
+     * other lengths. */
+    LTFAT_KISS(fft_plan)* bluesub;
+    kiss_fft_cpx* bluechirp;
+    kiss_fft_cpx* bluefilt;
+    kiss_fft_cpx* bluebuf;
     kiss_fft_cpx twiddles[1];
 };
 
@@ -27,21 +40,21 @@ struct LTFAT_KISS(fft_plan){
  */
 
 
-/* static int  */
-/* kiss_fft_next_fast_size(int n) */
-/* { */
-/*     while (1) */
-/*     { */
-/*         int m = n; */
-/*         while ( (m % 2) == 0 ) m /= 2; */
-/*         while ( (m % 3) == 0 ) m /= 3; */
-/*         while ( (m % 5) == 0 ) m /= 5; */
-/*         if (m <= 1) */
-/*             break; #<{(| n is completely factorable by twos, threes, and fives |)}># */
-/*         n++; */
-/*     } */
-/*     return n; */
-/* } */
+static int
+kiss_fft_next_fast_size(int n)
+{
+    while (1)
+    {
+        int m = n;
+        while ( (m % 2) == 0 ) m /= 2;
+        while ( (m % 3) == 0 ) m /= 3;
+        while ( (m % 5) == 0 ) m /= 5;
+        if (m <= 1)
+            break; /* n is completely factorable by twos, threes, and fives */
+        n++;
+    }
+    return n;
+}
 
 static void kf_bfly2(
     kiss_fft_cpx* Fout,
@@ -248,9 +261,8 @@ static void kf_bfly_generic(
     const kiss_fft_cpx* twiddles = st->twiddles;
     kiss_fft_cpx t;
     int Norig = st->nfft;
-
-    kiss_fft_cpx* scratch = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(
-                                kiss_fft_cpx) * p);
+    /* Larger p are handled by Bluestein's algorithm */
+    kiss_fft_cpx scratch[KISS_FFT_GENERIC_MAXP];
 
     for ( u = 0; u < m; ++u )
     {
@@ -277,7 +289,6 @@ static void kf_bfly_generic(
             k += m;
         }
     }
-    KISS_FFT_TMP_FREE(scratch);
 }
 
 static
@@ -298,7 +309,7 @@ void kf_work(
 #ifdef _OPENMP
     // use openmp extensions at the
     // top-level (not recursive)
-    if (fstride == 1 && p <= 5)
+    if (fstride == 1 && p <= 5 && m != 1)
     {
         int k;
 
@@ -400,8 +411,43 @@ LTFAT_KISS(fft_plan)*
 LTFAT_KISS(fft_alloc)(int nfft, int inverse_fft, void* mem, size_t* lenmem )
 {
     LTFAT_KISS(fft_plan)* st = NULL;
-    size_t memneeded = sizeof(struct LTFAT_KISS(fft_plan))
-                       + sizeof(kiss_fft_cpx) * (nfft - 1); /* twiddle factors*/
+    int factors[2 * MAXFACTORS];
+    int maxp = 1, nblue = 0;
+    size_t subsize = 0;
+    size_t memneeded;
+
+    kf_factor(nfft, factors);
+    for (int i = 0; ; i++)
+    {
+        if (factors[2 * i] > maxp) maxp = factors[2 * i];
+        if (factors[2 * i + 1] <= 1) break;
+    }
+
+    if (maxp > 5)
+    {
+        /* The generic butterfly costs about nfft*p, Bluestein two FFTs of
+         * length nblue >= 2*nfft-1. The constant was found by timing. */
+        int log2nblue = 0;
+        nblue = kiss_fft_next_fast_size(2 * nfft - 1);
+        while ((nblue >> log2nblue) > 1) log2nblue++;
+
+        if (maxp <= KISS_FFT_GENERIC_MAXP && maxp <= 4 * log2nblue)
+            nblue = 0;
+    }
+
+    if (nblue)
+    {
+        /* Bluestein: the sub-plan, the chirp, the kernel and the work
+         * buffer follow the struct, no twiddle factors are needed. */
+        LTFAT_KISS(fft_alloc)(nblue, 0, NULL, &subsize);
+        memneeded = sizeof(struct LTFAT_KISS(fft_plan)) + subsize
+                    + sizeof(kiss_fft_cpx) * (nfft + 3 * nblue);
+    }
+    else
+    {
+        memneeded = sizeof(struct LTFAT_KISS(fft_plan))
+                    + sizeof(kiss_fft_cpx) * (nfft - 1); /* twiddle factors*/
+    }
 
     if ( lenmem == NULL )
     {
@@ -416,30 +462,114 @@ LTFAT_KISS(fft_alloc)(int nfft, int inverse_fft, void* mem, size_t* lenmem )
     if (st)
     {
         int i;
+        const double pi =
+            3.141592653589793238462643383279502884197169399375105820974944;
         st->nfft = nfft;
         st->inverse = inverse_fft;
+        memcpy(st->factors, factors, sizeof factors);
+        st->bluesub = NULL;
+        st->bluechirp = NULL;
+        st->bluefilt = NULL;
+        st->bluebuf = NULL;
 
-        for (i = 0; i < nfft; ++i)
+        if (nblue)
         {
-            const double pi =
-                3.141592653589793238462643383279502884197169399375105820974944;
-            double phase = -2 * pi * i / nfft;
-            if (st->inverse)
-                phase *= -1;
-            kf_cexp(st->twiddles + i, phase );
-        }
+            kiss_fft_cpx* b;
+            st->bluesub = (LTFAT_KISS(fft_plan)*)
+                          ((char*) st + sizeof(struct LTFAT_KISS(fft_plan)));
+            LTFAT_KISS(fft_alloc)(nblue, 0, st->bluesub, &subsize);
+            st->bluechirp = (kiss_fft_cpx*) ((char*) st->bluesub + subsize);
+            st->bluefilt = st->bluechirp + nfft;
+            st->bluebuf = st->bluefilt + nblue;
+
+            /* chirp[n] = exp(-+i*pi*n^2/nfft), n^2 is reduced mod 2*nfft to
+             * keep the phase accurate */
+            for (i = 0; i < nfft; ++i)
+            {
+                long long nsq = ((long long) i * i) % (2 * (long long) nfft);
+                double phase = -pi * (double) nsq / nfft;
+                if (st->inverse)
+                    phase *= -1;
+                kf_cexp(st->bluechirp + i, phase );
+            }
 
-        kf_factor(nfft, st->factors);
+            /* The kernel conj(chirp) wrapped around nblue, transformed and
+             * scaled by 1/nblue to normalize the inverse transform */
+            b = st->bluebuf;
+            memset(b, 0, sizeof(kiss_fft_cpx) * nblue);
+            for (i = 0; i < nfft; ++i)
+            {
+                b[i].r = st->bluechirp[i].r;
+                b[i].i = -st->bluechirp[i].i;
+                if (i > 0)
+                    b[nblue - i] = b[i];
+            }
+            kf_work(st->bluefilt, b, 1, 1, st->bluesub->factors, st->bluesub);
+            for (i = 0; i < nblue; ++i)
+                C_MULBYSCALAR(st->bluefilt[i], (kiss_fft_scalar) (1.0 / nblue));
+        }
+        else
+        {
+            for (i = 0; i < nfft; ++i)
+            {
+                double phase = -2 * pi * i / nfft;
+                if (st->inverse)
+                    phase *= -1;
+                kf_cexp(st->twiddles + i, phase );
+            }
+        }
     }
     return st;
 }
 
+/* X = chirp .* ifft( fft(chirp .* x) .* fft(conj(chirp)) )
+ *
+ * The inverse FFT is done with the forward plan by conjugating the input and
+ * the output. fin is read completely before fout is written. Like the real
+ * FFT, the plan holds the work buffer and must not be used by several
+ * threads at once. */
+static void
+kf_bluestein(const LTFAT_KISS(fft_plan)* st, const kiss_fft_cpx* fin,
+             kiss_fft_cpx* fout, int in_stride)
+{
+    const LTFAT_KISS(fft_plan)* sub = st->bluesub;
+    int n = st->nfft, nblue = sub->nfft, k;
+    kiss_fft_cpx t;
+    kiss_fft_cpx* a = st->bluebuf;
+    kiss_fft_cpx* A = a + nblue;
+
+    for (k = 0; k < n; ++k)
+        C_MUL(a[k], fin[k * in_stride], st->bluechirp[k]);
+    memset(a + n, 0, sizeof(kiss_fft_cpx) * (nblue - n));
+
+    kf_work(A, a, 1, 1, (int*) sub->factors, sub);
+
+    for (k = 0; k < nblue; ++k)
+    {
+        C_MUL(t, A[k], st->bluefilt[k]);
+        a[k].r = t.r;
+        a[k].i = -t.i;
+    }
+
+    kf_work(A, a, 1, 1, (int*) sub->factors, sub);
+
+    for (k = 0; k < n; ++k)
+    {
+        t.r = A[k].r;
+        t.i = -A[k].i;
+        C_MUL(fout[k], t, st->bluechirp[k]);
+    }
+}
 
 void
 LTFAT_KISS(fft_stride)(LTFAT_KISS(fft_plan)* st, const kiss_fft_cpx* fin,
                        kiss_fft_cpx* fout, int in_stride)
 {
-    if (fin == fout)
+    if (st->bluesub)
+    {
+        kf_bluestein(st, fin, fout, in_stride);
+    }
+    else if (fin == fout)
     {
         //NOTE: this is not really an in-place FFT algorithm.
         //It just performs an out-of-place FFT into a temp buffer
@@ -37,9 +37,7 @@ LTFAT_NAME(ltfatMexFnc)( int UNUSED(nlhs), mxArray *plhs[],
     default: mexErrMsgTxt("Unknown type.");
     }
 
-    LTFAT_NAME(dct_plan)* p = LTFAT_NAME(dct_init)( L, W, mxGetData(plhs[0]), kind);
-    LTFAT_NAME(dct_execute)(p, mxGetData(prhs[0]), L, W, mxGetData(plhs[0]), kind);
-    LTFAT_NAME(dct_done)(p);
+    LTFAT_NAME(dct)(mxGetData(prhs[0]), L, W, mxGetData(plhs[0]), kind);
 }
 #endif
 